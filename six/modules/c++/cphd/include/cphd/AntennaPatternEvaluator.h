@@ -0,0 +1,210 @@
+/* =========================================================================
+ * This file is part of cphd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * cphd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CPHD_ANTENNA_PATTERN_EVALUATOR_H__
+#define __CPHD_ANTENNA_PATTERN_EVALUATOR_H__
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <cphd/Antenna.h>
+#include <cphd/Metadata.h>
+#include <cphd/PVPBlock.h>
+#include <cphd/SupportBlock.h>
+#include <cphd/Types.h>
+
+namespace cphd
+{
+/*
+ *  \class AntennaPatternEvaluator
+ *  \brief Computes antenna gain and phase from the Antenna block
+ *
+ *  For a pattern at time t and frequency f, with ACF direction cosines
+ *  (DCX, DCY) and the EB steering direction (DCX_EB, DCY_EB) = EB(t):
+ *    - If EBFreqShift is set, the EB direction is scaled by f_0 / f.
+ *    - The array pattern is evaluated at (DCX - DCX_EB, DCY - DCY_EB),
+ *      scaled by f / f_0 if MLFreqDilation is set.
+ *    - The element pattern is evaluated at (DCX, DCY).
+ *    - Gain (dB) = G_0 + GainBSPoly(f / f_0 - 1) + array gain + element gain,
+ *      leaving out G_0 and GainBSPoly if they're absent.
+ *    - Phase (cycles) = array phase + element phase.
+ *
+ *  If the pattern has GainPhaseArrays and a support block is provided,
+ *  the sampled arrays replace the array polynomials, and the element
+ *  polynomials too where an ElementId is given.  The grids are bilinearly
+ *  interpolated, and linearly interpolated in frequency between the two
+ *  nearest arrays, or taken from the nearest one outside of their span.
+ *  Sampled patterns are already at their own frequency so MLFreqDilation
+ *  doesn't apply to them.  Points outside of a grid are NaN.
+ *
+ *  The work is split over vectors, and the polynomials are evaluated with
+ *  Horner's method across all the points of a vector at once so the inner
+ *  loops vectorize.  All arrays are laid out with the point index fastest,
+ *  so value [v * numPoints + p] is for vector v and point p.
+ */
+class AntennaPatternEvaluator
+{
+public:
+    /*
+     *  \func AntennaPatternEvaluator
+     *  \brief Constructor
+     *
+     *  \param metadata CPHD metadata with an Antenna block
+     *  \param supportBlock (Optional) Support block to read sampled gain and
+     *  phase arrays from
+     *  \param numThreads Number of threads to use
+     *
+     *  \throws except::Exception If the metadata has no Antenna block, or
+     *  a pattern references an ACF or support array that doesn't exist
+     */
+    AntennaPatternEvaluator(const Metadata& metadata,
+                            const SupportBlock* supportBlock = nullptr,
+                            size_t numThreads = 1);
+
+    /*
+     *  \func getDirectionCosines
+     *  \brief Computes the ACF direction cosines of scene points
+     *
+     *  \param apcId Antenna phase center (APC_ID)
+     *  \param times APC time of each vector
+     *  \param apcPositions APC position of each vector (ECF)
+     *  \param numVectors Number of vectors
+     *  \param points Scene points (ECF)
+     *  \param numPoints Number of points
+     *  \param[out] dcx DCX of each point for each vector
+     *  \param[out] dcy DCY of each point for each vector
+     */
+    void getDirectionCosines(const std::string& apcId,
+                             const double* times,
+                             const Vector3* apcPositions,
+                             size_t numVectors,
+                             const Vector3* points,
+                             size_t numPoints,
+                             double* dcx,
+                             double* dcy) const;
+
+    /*
+     *  \func evaluate
+     *  \brief Computes the one way gain and phase of a pattern
+     *
+     *  \param apatId Antenna pattern (APAT_ID)
+     *  \param times Time of each vector
+     *  \param frequencies Frequency of each vector (Hz)
+     *  \param numVectors Number of vectors
+     *  \param dcx DCX of each point for each vector
+     *  \param dcy DCY of each point for each vector
+     *  \param numPoints Number of points
+     *  \param[out] gain Gain (dB) of each point for each vector
+     *  \param[out] phase Phase (cycles) of each point for each vector
+     */
+    void evaluate(const std::string& apatId,
+                  const double* times,
+                  const double* frequencies,
+                  size_t numVectors,
+                  const double* dcx,
+                  const double* dcy,
+                  size_t numPoints,
+                  double* gain,
+                  double* phase) const;
+
+    /*
+     *  \func evaluateTwoWay
+     *  \brief Computes the two way gain and phase of a span of a channel's
+     *  vectors
+     *
+     *  The transmit pattern is evaluated from TxPos at TxTime and the
+     *  receive pattern from RcvPos at RcvTime, both at the vector's center
+     *  frequency (FX1 + FX2) / 2.  The gains and phases are summed.
+     *
+     *  \param pvpBlock PVPs of the channel
+     *  \param channel Channel number
+     *  \param firstVector First vector
+     *  \param numVectors Number of vectors
+     *  \param points Scene points (ECF)
+     *  \param numPoints Number of points
+     *  \param[out] gain Gain (dB) of each point for each vector
+     *  \param[out] phase Phase (cycles) of each point for each vector
+     *
+     *  \throws except::Exception If the channel has no antenna identifiers
+     *  or the span is out of bounds
+     */
+    void evaluateTwoWay(const PVPBlock& pvpBlock,
+                        size_t channel,
+                        size_t firstVector,
+                        size_t numVectors,
+                        const Vector3* points,
+                        size_t numPoints,
+                        double* gain,
+                        double* phase) const;
+
+private:
+    // Sampled gain and phase at one frequency
+    struct SampledGrid
+    {
+        double x0;
+        double y0;
+        double xSS;
+        double ySS;
+        size_t numRows;
+        size_t numCols;
+        std::vector<double> gain;
+        std::vector<double> phase;
+    };
+
+    struct SampledPattern
+    {
+        double freq;
+        SampledGrid array;
+        bool hasElement;
+        SampledGrid element;
+    };
+
+    struct Pattern
+    {
+        AntPattern pattern;
+        std::vector<SampledPattern> sampled;
+    };
+
+    class EvaluateVectors;
+    class DirectionCosineVectors;
+
+    SampledGrid readGrid(const Metadata& metadata,
+                         const SupportBlock& supportBlock,
+                         const std::string& id) const;
+
+    const AntCoordFrame& getACF(const std::string& apcId) const;
+
+    const Pattern& getPattern(const std::string& apatId) const;
+
+    size_t getNumThreads(size_t numVectors) const;
+
+    const size_t mNumThreads;
+    std::unordered_map<std::string, AntCoordFrame> mACFs;
+    std::unordered_map<std::string, std::string> mAPCToACF;
+    std::unordered_map<std::string, Pattern> mPatterns;
+    std::vector<ChannelParameter::Antenna> mChannelAntennas;
+    std::vector<size_t> mNumVectors;
+};
+}
+
+#endif
@@ -0,0 +1,249 @@
+/* =========================================================================
+ * This file is part of cphd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * cphd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef __CPHD_CPHD_COMPARATOR_H__
+#define __CPHD_CPHD_COMPARATOR_H__
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <sys/Conf.h>
+#include <cphd/CPHDReader.h>
+#include <cphd/Data.h>
+#include <cphd/PVP.h>
+#include <cphd/PVPBlock.h>
+#include <cphd/SupportBlock.h>
+#include <cphd/Wideband.h>
+
+namespace cphd
+{
+/*
+ *  \struct CompareTolerance
+ *
+ *  \brief How far apart two values may be and still match
+ *
+ *  Two values match if they're equal, or if they're within any one of the
+ *  absolute, relative or ULP tolerances.  A tolerance of 0 is not used, so
+ *  the default is an exact comparison.  Two NaNs match each other.
+ *  For integer data a ULP is 1.
+ */
+struct CompareTolerance
+{
+    CompareTolerance(double absolute = 0.0,
+                     double relative = 0.0,
+                     size_t ulps = 0);
+
+    //! True if only exactly equal values match
+    bool isExact() const
+    {
+        return absolute <= 0.0 && relative <= 0.0 && ulps == 0;
+    }
+
+    //! Largest allowed absolute difference
+    double absolute;
+
+    //! Largest allowed difference relative to the larger magnitude value
+    double relative;
+
+    //! Largest allowed number of representable values between the two
+    size_t ulps;
+};
+
+/*
+ *  \struct MismatchStats
+ *
+ *  \brief Summary of the mismatches found in one array
+ *
+ *  What an index means depends on the array: for signal data it's
+ *  vector * numSamples + sample, for a PVP it's the vector and for a
+ *  support array it's row * numCols + col.
+ */
+struct MismatchStats
+{
+    MismatchStats();
+
+    //! True if nothing mismatched
+    bool matches() const
+    {
+        return numMismatches == 0;
+    }
+
+    //! Record a mismatch at index with the given absolute error
+    void addMismatch(size_t index, double error);
+
+    //! Combine with the stats for a different part of the same array
+    void merge(const MismatchStats& other);
+
+    //! Number of elements compared
+    size_t numCompared;
+
+    //! Number of elements that didn't match
+    size_t numMismatches;
+
+    //! Largest absolute difference of the mismatches.  Arrays that are
+    //! compared byte for byte leave this at 0.
+    double maxError;
+
+    //! First and last index that didn't match.  Only meaningful if there
+    //! was a mismatch.
+    size_t firstIndex;
+    size_t lastIndex;
+};
+
+/*
+ *  \struct CPHDComparison
+ *
+ *  \brief Everything that was found comparing two CPHDs
+ */
+struct CPHDComparison
+{
+    //! True if nothing differed
+    bool matches() const;
+
+    //! Differences that stopped part of the comparison from being made,
+    //! like different metadata or channel sizes
+    std::vector<std::string> differences;
+
+    //! Signal data stats, per channel
+    std::vector<MismatchStats> signal;
+
+    //! PVP stats, per channel, keyed by parameter name
+    std::vector<std::map<std::string, MismatchStats> > pvp;
+
+    //! Support array stats, keyed by identifier
+    std::map<std::string, MismatchStats> support;
+};
+
+//! Write a human readable summary of a comparison
+std::ostream& operator<<(std::ostream& os, const CPHDComparison& comparison);
+
+/*
+ *  \class CPHDComparator
+ *
+ *  \brief Compares two CPHDs
+ *
+ *  Signal data is streamed through a block of vectors at a time, so memory
+ *  use is bounded no matter how large the files are, and each block is
+ *  compared on multiple threads.  Rather than stopping at the first
+ *  mismatch, everything is compared and the mismatches are summarized.
+ *
+ *  PVPs are compared one parameter at a time, so if TxPos differs it shows
+ *  up as TxPos.  Parameters with a floating point format use the PVP
+ *  tolerance; all others must match exactly, as must support arrays and
+ *  compressed signal data.
+ */
+class CPHDComparator
+{
+public:
+    //! Default number of bytes of signal data to read per file at once
+    static const size_t DEFAULT_BLOCK_SIZE;
+
+    /*
+     *  \func CPHDComparator constructor
+     *
+     *  \param signalTolerance Tolerance for signal samples.  Real and
+     *  imaginary parts are checked separately.
+     *  \param pvpTolerance Tolerance for floating point PVPs
+     *  \param numThreads Number of threads to use
+     *  \param blockSize Approximate number of bytes of signal data to read
+     *  from each file at once.  At least one vector is always read.
+     */
+    CPHDComparator(const CompareTolerance& signalTolerance =
+                           CompareTolerance(),
+                   const CompareTolerance& pvpTolerance = CompareTolerance(),
+                   size_t numThreads = 1,
+                   size_t blockSize = DEFAULT_BLOCK_SIZE);
+
+    /*
+     *  \func compare
+     *  \brief Compares metadata, PVPs, support arrays and signal data
+     *
+     *  Parts that can't be compared because of differences in the metadata
+     *  (e.g. the channel sizes differ) are skipped and noted in the
+     *  differences.
+     *
+     *  \param lhs First CPHD
+     *  \param rhs Second CPHD
+     *
+     *  \return What was found
+     */
+    CPHDComparison compare(const CPHDReader& lhs,
+                           const CPHDReader& rhs) const;
+
+    /*
+     *  \func compareSignal
+     *  \brief Compares one channel of signal data
+     *
+     *  \param lhs First signal block
+     *  \param rhs Second signal block
+     *  \param data Data section, which must match for the channel in both
+     *  \param channel 0-based channel
+     *
+     *  \return Mismatch stats, indexed by vector * numSamples + sample, or
+     *  by byte for compressed data
+     */
+    MismatchStats compareSignal(const Wideband& lhs,
+                                const Wideband& rhs,
+                                const Data& data,
+                                size_t channel) const;
+
+    /*
+     *  \func comparePVP
+     *  \brief Compares one channel of PVPs, a parameter at a time
+     *
+     *  \param lhs First PVP block
+     *  \param rhs Second PVP block
+     *  \param pvp PVP layout, which must match in both
+     *  \param channel 0-based channel
+     *
+     *  \return Mismatch stats for each parameter, indexed by vector
+     */
+    std::map<std::string, MismatchStats> comparePVP(const PVPBlock& lhs,
+                                                    const PVPBlock& rhs,
+                                                    const Pvp& pvp,
+                                                    size_t channel) const;
+
+    /*
+     *  \func compareSupportArray
+     *  \brief Compares one support array, element by element
+     *
+     *  \param lhs First support block
+     *  \param rhs Second support block
+     *  \param supportArray The array, which must match in both
+     *
+     *  \return Mismatch stats, indexed by element
+     */
+    MismatchStats compareSupportArray(
+            const SupportBlock& lhs,
+            const SupportBlock& rhs,
+            const Data::SupportArray& supportArray) const;
+
+private:
+    const CompareTolerance mSignalTolerance;
+    const CompareTolerance mPVPTolerance;
+    const size_t mNumThreads;
+    const size_t mBlockSize;
+};
+}
+
+#endif
@@ -0,0 +1,119 @@
+/* =========================================================================
+ * This file is part of cphd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * cphd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef __CPHD_CPHD_METADATA_READER_H__
+#define __CPHD_CPHD_METADATA_READER_H__
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <io/SeekableStreams.h>
+#include <logging/Logger.h>
+#include <xml/lite/Document.h>
+#include <cphd/FileHeader.h>
+#include <cphd/Metadata.h>
+
+namespace cphd
+{
+/*
+ *  \class CPHDMetadataReader
+ *
+ *  \brief Reads the header and XML of a CPHD file and nothing else
+ *
+ *  Unlike CPHDReader, the support arrays and PVPs are not loaded and
+ *  nothing is set up for reading wideband.  The XML block is only read
+ *  when it's asked for, and can be parsed into a Metadata object or into
+ *  a DOM holding just the top-level elements that are needed.
+ *
+ *  Reads share the one stream, so an object must not be used by multiple
+ *  threads at once.
+ */
+class CPHDMetadataReader
+{
+public:
+    /*
+     *  \func CPHDMetadataReader constructor
+     *  \brief Reads the file header from an input stream
+     *
+     *  \param inStream Input stream containing CPHD file
+     */
+    CPHDMetadataReader(std::shared_ptr<io::SeekableInputStream> inStream);
+
+    /*
+     *  \func CPHDMetadataReader constructor
+     *  \brief Reads the file header from a file
+     *
+     *  \param fromFile File path of CPHD file
+     */
+    CPHDMetadataReader(const std::string& fromFile);
+
+    //! Get file header object
+    const FileHeader& getFileHeader() const
+    {
+        return mFileHeader;
+    }
+
+    /*
+     *  \func getXML
+     *  \brief Reads the XML block
+     *
+     *  \return The raw XML
+     */
+    std::string getXML() const;
+
+    /*
+     *  \func getXMLDocument
+     *  \brief Reads and parses the XML block, keeping only some of the
+     *  top-level elements
+     *
+     *  \param elementNames Local names of the root's children to keep (e.g.
+     *  "CollectionID", "SceneCoordinates").  If empty, the whole document
+     *  is kept.
+     *
+     *  \return The document
+     */
+    std::unique_ptr<xml::lite::Document> getXMLDocument(
+            const std::vector<std::string>& elementNames =
+                    std::vector<std::string>()) const;
+
+    /*
+     *  \func getMetadata
+     *  \brief Reads and parses the XML block into a Metadata object
+     *
+     *  \param schemaPaths (Optional) XML schemas for validation
+     *  \param logger (Optional) Provide custom log
+     *
+     *  \return The metadata
+     */
+    std::unique_ptr<Metadata> getMetadata(
+            const std::vector<std::string>& schemaPaths =
+                    std::vector<std::string>(),
+            std::shared_ptr<logging::Logger> logger =
+                    std::shared_ptr<logging::Logger>()) const;
+
+private:
+    const std::shared_ptr<io::SeekableInputStream> mInStream;
+    FileHeader mFileHeader;
+};
+}
+
+#endif
@@ -0,0 +1,198 @@
+/* =========================================================================
+ * This file is part of cphd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * cphd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef __CPHD_CPHD_SUBSET_WRITER_H__
+#define __CPHD_CPHD_SUBSET_WRITER_H__
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <io/SeekableStreams.h>
+#include <sys/Conf.h>
+#include <cphd/FileHeader.h>
+#include <cphd/Metadata.h>
+
+namespace cphd
+{
+/*
+ *  \struct ChannelSubset
+ *
+ *  \brief The part of one channel to keep
+ *
+ *  Ranges are 0-based and inclusive.  Use ALL for the last vector or
+ *  sample to go to the end of the channel.
+ */
+struct ChannelSubset
+{
+    static const size_t ALL;
+
+    /*
+     *  \func ChannelSubset constructor
+     *
+     *  \param channel 0-based channel in the input file
+     *  \param firstVector First vector to keep
+     *  \param lastVector Last vector to keep
+     *  \param firstSample First sample to keep
+     *  \param lastSample Last sample to keep
+     */
+    ChannelSubset(size_t channel,
+                  size_t firstVector = 0,
+                  size_t lastVector = ALL,
+                  size_t firstSample = 0,
+                  size_t lastSample = ALL);
+
+    size_t channel;
+    size_t firstVector;
+    size_t lastVector;
+    size_t firstSample;
+    size_t lastSample;
+};
+
+/*
+ *  \class CPHDSubsetWriter
+ *
+ *  \brief Writes part of a CPHD file to a new CPHD file
+ *
+ *  The output has the chosen channels, in the order given, each cut down
+ *  to a range of vectors and samples.  Signal arrays and PVPs are copied
+ *  from the input a block at a time, still in big endian, so memory use is
+ *  bounded by the block size and nothing is decoded.  The only PVPs that
+ *  are modified are the ones that describe the samples: SC0 is moved to
+ *  the first kept sample, and FX1/FX2 (FX domain) or TOA1/TOA2 (TOA
+ *  domain) are clipped to the kept samples.
+ *
+ *  The metadata is rewritten to match: the Data channel sizes and
+ *  offsets, the Channel parameters (reference channel and vector, FxC,
+ *  FxBW and TOASaved) and the Global timeline, FX band and TOA swath.
+ *  Support arrays are copied unchanged.  The ReferenceGeometry isn't
+ *  recomputed, so it's only still right if the reference vector of the
+ *  reference channel is kept.
+ *
+ *  Compressed signal arrays can only be subset by channel.
+ */
+class CPHDSubsetWriter
+{
+public:
+    //! Default number of bytes to copy at once
+    static const size_t DEFAULT_BLOCK_SIZE;
+
+    /*
+     *  \func CPHDSubsetWriter constructor
+     *  \brief Reads the header and metadata of the input
+     *
+     *  \param inStream Input CPHD
+     *  \param schemaPaths (Optional) XML schemas for validation
+     *  \param blockSize (Optional) Number of bytes to copy at once.  At
+     *  least one vector is always copied.
+     */
+    CPHDSubsetWriter(std::shared_ptr<io::SeekableInputStream> inStream,
+                     const std::vector<std::string>& schemaPaths =
+                             std::vector<std::string>(),
+                     size_t blockSize = DEFAULT_BLOCK_SIZE);
+
+    /*
+     *  \func CPHDSubsetWriter constructor
+     *  \brief Same as above but opens the input file
+     *
+     *  \param inPathname Input CPHD pathname
+     *  \param schemaPaths (Optional) XML schemas for validation
+     *  \param blockSize (Optional) Number of bytes to copy at once
+     */
+    CPHDSubsetWriter(const std::string& inPathname,
+                     const std::vector<std::string>& schemaPaths =
+                             std::vector<std::string>(),
+                     size_t blockSize = DEFAULT_BLOCK_SIZE);
+
+    //! Get the input metadata
+    const Metadata& getMetadata() const
+    {
+        return *mMetadata;
+    }
+
+    /*
+     *  \func getSubsetMetadata
+     *  \brief Works out the metadata of a subset.  This reads the kept
+     *  PVPs.
+     *
+     *  \param subsets The channels to keep
+     *
+     *  \throw except::Exception If a subset is out of bounds, a channel is
+     *  repeated, or compressed data is subset other than by channel
+     *
+     *  \return The output metadata
+     */
+    std::unique_ptr<Metadata> getSubsetMetadata(
+            const std::vector<ChannelSubset>& subsets) const;
+
+    /*
+     *  \func write
+     *  \brief Writes a subset to a stream
+     *
+     *  \param subsets The channels to keep
+     *  \param outStream Output stream
+     */
+    void write(const std::vector<ChannelSubset>& subsets,
+               io::OutputStream& outStream) const;
+
+    /*
+     *  \func write
+     *  \brief Writes a subset to a file
+     *
+     *  \param subsets The channels to keep
+     *  \param outPathname Output CPHD pathname
+     */
+    void write(const std::vector<ChannelSubset>& subsets,
+               const std::string& outPathname) const;
+
+private:
+    struct ChannelSummary;
+
+    std::vector<ChannelSubset> resolve(
+            const std::vector<ChannelSubset>& subsets) const;
+
+    std::unique_ptr<Metadata> createMetadata(
+            const std::vector<ChannelSubset>& subsets) const;
+
+    ChannelSummary updatePVPs(const ChannelSubset& subset,
+                              io::OutputStream* outStream) const;
+
+    void copy(sys::Off_T offset,
+              sys::Off_T numBytes,
+              std::vector<sys::ubyte>& buffer,
+              io::OutputStream& outStream) const;
+
+    void writeSignal(const ChannelSubset& subset,
+                     std::vector<sys::ubyte>& buffer,
+                     io::OutputStream& outStream) const;
+
+    sys::Off_T getPVPOffset(size_t channel) const;
+    sys::Off_T getSignalOffset(size_t channel) const;
+
+    const std::shared_ptr<io::SeekableInputStream> mInStream;
+    const std::vector<std::string> mSchemaPaths;
+    const size_t mBlockSize;
+    FileHeader mHeader;
+    std::unique_ptr<Metadata> mMetadata;
+};
+}
+
+#endif
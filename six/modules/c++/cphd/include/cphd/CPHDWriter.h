@@ -30,6 +30,7 @@
 #include <io/FileOutputStream.h>
 #include <sys/OS.h>
 #include <sys/Conf.h>
+#include <cphd/CompressedSignal.h>
 #include <cphd/FileHeader.h>
 #include <cphd/Metadata.h>
 #include <cphd/PVP.h>
@@ -239,6 +240,39 @@ public:
             const T* widebandData,
             const sys::ubyte* supportData = nullptr);
 
+    /*
+     *  \func writeCompressed
+     *  \brief Compresses the signal arrays and writes the complete CPHD
+     *
+     *  The codec is the one the SignalCodecFactory has for
+     *  data.signalCompressionID.  Each channel is compressed in blocks of
+     *  vectors, in parallel, and the channels' CompressedSignalSizes are
+     *  filled in internally.  The header needs those sizes, so all of the
+     *  compressed channels are held in memory until they're written.
+     *
+     *  This only works with valid CPHDWriter sample types:
+     *      std::complex<float>
+     *      std::complex<sys::Int16_T>
+     *      std::complex<sys::Int8_T>
+     *
+     *  \param pvpBlock The vector based metadata to write.
+     *  \param widebandData The uncompressed signal arrays of every channel,
+     *  one after the other
+     *  \param supportData (Optional) The support array data to write to disk.
+     *  \param vectorsPerBlock (Optional) Number of vectors compressed
+     *  together.  Smaller blocks make partial reads cheaper.
+     *
+     *  \throws except::Exception If no codec is registered for the
+     *  signal compression ID
+     */
+    template<typename T>
+    void writeCompressed(
+            const PVPBlock& pvpBlock,
+            const T* widebandData,
+            const sys::ubyte* supportData = nullptr,
+            size_t vectorsPerBlock =
+                    CompressedSignal::DEFAULT_VECTORS_PER_BLOCK);
+
     /*
      *  \func writeMetadata
      *  \brief Writes the header, and metadata into the file.
@@ -332,9 +366,12 @@ public:
 
 private:
     /*
-     *  Write metadata helper
+     *  Write metadata helpers
      */
+    void writeMetadata(const Metadata& metadata, const PVPBlock& pvpBlock);
+
     void writeMetadata(
+        const Metadata& metadata,
         size_t supportSize, // Optional
         size_t pvpSize,
         size_t cphdSize);
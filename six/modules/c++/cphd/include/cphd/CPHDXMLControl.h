@@ -133,6 +133,16 @@ private:
      */
     virtual std::unique_ptr<xml::lite::Document> toXMLImpl(const Metadata& metadata);
 
+    /*!
+     *  This function writes a Metadata object out as XML as the parser
+     *  creates each element, without holding a DOM.
+     *
+     *  \param metadata A Metadata object
+     *  \param writer Writer to send the XML to
+     */
+    virtual void toXMLImpl(const Metadata& metadata,
+                           six::XMLStreamWriter& writer);
+
     /*!
      *  Function takes a DOM Document* node and creates a new-allocated
      *  ComplexData* populated by the DOM.
@@ -150,6 +160,9 @@ private:
     std::unique_ptr<CPHDXMLParser>
     getParser(const std::string& uri) const;
 
+    // Given the version get associated URI
+    std::string versionToURI(const std::string& version) const;
+
     // Given the URI get associated version
     std::string uriToVersion(const std::string& uri) const;
 };
@@ -89,6 +89,15 @@ public:
     std::unique_ptr<Metadata> fromXML(
             const xml::lite::Document* doc);
 
+    /*!
+     *  \func setXMLWriter
+     *
+     *  \brief Write elements to a stream as toXML() creates them
+     *
+     *  \param writer Writer to use, or nullptr to build a DOM
+     */
+    void setXMLWriter(six::XMLStreamWriter* writer) override;
+
 private:
     typedef xml::lite::Element*  XMLElem;
 
@@ -0,0 +1,134 @@
+/* =========================================================================
+ * This file is part of cphd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * cphd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CPHD_COMPRESSED_SIGNAL_H__
+#define __CPHD_COMPRESSED_SIGNAL_H__
+
+#include <vector>
+
+#include <cphd/SignalCodec.h>
+#include <io/SeekableStreams.h>
+#include <sys/Conf.h>
+
+namespace cphd
+{
+/*
+ *  \class CompressedSignal
+ *  \brief Block index of a channel's signal array compressed in
+ *  independent blocks of vectors
+ *
+ *  The compressed array starts with big endian 64 bit words: the number of
+ *  vectors per block, the number of blocks, then the byte offset of each
+ *  block from the start of the array and the offset of the end of the last
+ *  one.  The blocks follow.  Each decompresses to the samples of its
+ *  vectors as they'd be stored uncompressed, big endian.
+ */
+class CompressedSignal
+{
+public:
+    //! Default number of vectors compressed together
+    static const size_t DEFAULT_VECTORS_PER_BLOCK;
+
+    /*
+     *  \func compress
+     *  \brief Compresses a channel's signal array
+     *
+     *  \param codec Codec for the blocks
+     *  \param signal Big endian samples of the channel
+     *  \param numVectors Number of vectors
+     *  \param numSamples Number of samples per vector
+     *  \param elementSize Bytes per complex sample
+     *  \param vectorsPerBlock Number of vectors per block
+     *  \param numThreads Number of threads to compress blocks with
+     *  \param[out] compressed The compressed signal array
+     */
+    static void compress(const SignalCodec& codec,
+                         const sys::ubyte* signal,
+                         size_t numVectors,
+                         size_t numSamples,
+                         size_t elementSize,
+                         size_t vectorsPerBlock,
+                         size_t numThreads,
+                         std::vector<sys::ubyte>& compressed);
+
+    /*
+     *  \func CompressedSignal
+     *  \brief Reads the block index of a compressed signal array
+     *
+     *  \param stream Input stream
+     *  \param offset Offset of the compressed signal array in the stream
+     *  \param compressedSize Size of the compressed signal array
+     *  \param numVectors Number of vectors in the channel
+     *
+     *  \throws except::Exception If the index doesn't fit the channel
+     */
+    CompressedSignal(io::SeekableInputStream& stream,
+                     sys::Off_T offset,
+                     size_t compressedSize,
+                     size_t numVectors);
+
+    size_t getVectorsPerBlock() const
+    {
+        return mVectorsPerBlock;
+    }
+
+    size_t getNumBlocks() const
+    {
+        return mBlockOffsets.size() - 1;
+    }
+
+    /*
+     *  \func decompress
+     *  \brief Reads and decompresses the blocks that overlap a range of
+     *  vectors, and copies out the requested samples
+     *
+     *  \param codec Codec the blocks were compressed with
+     *  \param stream Input stream
+     *  \param firstVector First vector (inclusive)
+     *  \param lastVector Last vector (inclusive)
+     *  \param firstSample First sample (inclusive)
+     *  \param lastSample Last sample (inclusive)
+     *  \param numSamples Number of samples per vector
+     *  \param elementSize Bytes per complex sample
+     *  \param numThreads Number of threads to decompress blocks with
+     *  \param[out] output Big endian samples, one row per vector
+     */
+    void decompress(const SignalCodec& codec,
+                    io::SeekableInputStream& stream,
+                    size_t firstVector,
+                    size_t lastVector,
+                    size_t firstSample,
+                    size_t lastSample,
+                    size_t numSamples,
+                    size_t elementSize,
+                    size_t numThreads,
+                    sys::ubyte* output) const;
+
+private:
+    sys::Off_T mOffset;
+    size_t mNumVectors;
+    size_t mVectorsPerBlock;
+    std::vector<sys::Uint64_T> mBlockOffsets;
+};
+}
+
+#endif
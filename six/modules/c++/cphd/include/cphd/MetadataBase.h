@@ -24,6 +24,7 @@
 #define __CPHD_METADATA_BASE_H__
 
 #include <ostream>
+#include <string>
 #include <six/Init.h>
 #include <cphd/Enums.h>
 
@@ -87,6 +88,20 @@ struct MetadataBase
         return false;
     }
 
+    /*
+     * \func getSignalCompressionID
+     * \brief Gets the identifier of the signal compression method
+     *
+     * This function returns default value. Can be overridden
+     * if required (Ex: CPHD::Metadata)
+     *
+     * \return empty string by default
+     */
+    virtual std::string getSignalCompressionID() const
+    {
+        return std::string();
+    }
+
     /*!
      * Get domain type
      * FX for frequency domain,
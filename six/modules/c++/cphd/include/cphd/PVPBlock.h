@@ -181,11 +181,11 @@ struct PVPBlock
     T getAddedPVP(size_t channel, size_t set, const std::string& name) const
     {
         verifyChannelVector(channel, set);
-        if(mData[channel][set].addedPVP.count(name) == 1)
+        const auto it = mData[channel][set].addedPVP.find(name);
+        if(it != mData[channel][set].addedPVP.end())
         {
             AddedPVP<T> aP;
-            return aP.getAddedPVP(mData[channel][set].addedPVP.find(name)->second);
-            // return AddPVPNamespace::getAddedPVP<T>(mData[channel][set].addedPVP.find(name)->second);
+            return aP.getAddedPVP(it->second);
         }
         throw except::Exception(Ctxt(
                 "Parameter was not set"));
@@ -223,10 +223,11 @@ struct PVPBlock
         verifyChannelVector(channel, set);
         if(mPvp.addedPVP.count(name) != 0)
         {
-            if(mData[channel][set].addedPVP.count(name) == 0)
+            const auto result = mData[channel][set].addedPVP.insert(
+                    std::make_pair(name, six::Parameter()));
+            if(result.second)
             {
-                mData[channel][set].addedPVP[name] = six::Parameter();
-                mData[channel][set].addedPVP.find(name)->second.setValue(value);
+                result.first->second.setValue(value);
                 return;
             }
             throw except::Exception(Ctxt(
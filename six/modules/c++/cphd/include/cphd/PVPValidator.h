@@ -0,0 +1,197 @@
+/* =========================================================================
+ * This file is part of cphd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * cphd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CPHD_PVP_VALIDATOR_H__
+#define __CPHD_PVP_VALIDATOR_H__
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <io/SeekableStreams.h>
+#include <sys/Conf.h>
+#include <cphd/Metadata.h>
+#include <cphd/PVPBlock.h>
+
+namespace cphd
+{
+/*
+ *  \struct VectorRanges
+ *
+ *  \brief The vectors that broke a rule, as runs of consecutive vectors
+ *
+ *  Only the first MAX_RANGES runs are kept, but every vector is counted.
+ */
+struct VectorRanges
+{
+    //! Most runs that are kept
+    static const size_t MAX_RANGES;
+
+    VectorRanges();
+
+    //! Add a vector.  Vectors must be added in increasing order.
+    void add(size_t vector);
+
+    //! Append the ranges for later vectors
+    void append(const VectorRanges& other);
+
+    //! Number of vectors that broke the rule
+    size_t numVectors;
+
+    //! First and last vector (inclusive) of each run
+    std::vector<std::pair<size_t, size_t> > ranges;
+
+    //! True if there were more than MAX_RANGES runs
+    bool truncated;
+};
+
+/*
+ *  \struct PVPValidation
+ *
+ *  \brief Everything that was found validating the PVPs of a CPHD
+ */
+struct PVPValidation
+{
+    //! True if no rule was broken
+    bool isValid() const;
+
+    //! Rules that hold for a channel as a whole, like FxC and FxBW
+    //! matching the FX1 and FX2 extents, that were broken
+    std::vector<std::string> errors;
+
+    //! Per channel, keyed by rule name, the vectors that broke the rule.
+    //! Rules that every vector kept aren't present.
+    std::vector<std::map<std::string, VectorRanges> > channels;
+};
+
+//! Write a human readable summary of a validation
+std::ostream& operator<<(std::ostream& os, const PVPValidation& validation);
+
+/*
+ *  \class PVPValidator
+ *
+ *  \brief Checks the PVPs against the CPHD 1.0 consistency rules
+ *
+ *  Per vector rules:
+ *    FiniteValues       Every floating point PVP is finite
+ *    TxTimeIncreasing   TxTime is strictly increasing
+ *    RcvTimeIncreasing  RcvTime is strictly increasing
+ *    RcvAfterTx         RcvTime > TxTime
+ *    Timeline           Global.Timeline TxTime1 <= TxTime <= TxTime2
+ *    FXOrder            FX1 < FX2
+ *    GlobalFxBand       Global.FxBand FxMin <= FX1 and FX2 <= FxMax
+ *    ChannelFxBand      FxC - FxBW / 2 <= FX1 and FX2 <= FxC + FxBW / 2
+ *    FXFixed            FX1 and FX2 match vector 0 if FXFixed
+ *    TOAOrder           TOA1 < TOA2
+ *    TOASwath           Global.TOASwath TOAMin <= TOA1 and TOA2 <= TOAMax
+ *    TOAFixed           TOA1 and TOA2 match vector 0 if TOAFixed
+ *    TOAExtended        TOAE1 <= TOA1 and TOA2 <= TOAE2
+ *    SRPFixed           SRPPos matches vector 0 if SRPFixed
+ *    SampleSpacing      SCSS > 0
+ *    SampledExtent      The samples SC0 ... SC0 + (NumSamples - 1) * SCSS
+ *                       cover FX1 to FX2 (FX domain) or TOA1 to TOA2 (TOA
+ *                       domain), to within half a sample
+ *    AmpSF              AmpSF > 0
+ *    SignalValues       SIGNAL is 0 or 1
+ *    SignalNormal       SIGNAL is 1 if SignalNormal
+ *
+ *  Per channel rules, reported as errors: FxC and FxBW are the centre and
+ *  width of the FX1 to FX2 extent, TOASaved and TOAExtSaved are the widths
+ *  of the TOA1 to TOA2 and TOAE1 to TOAE2 extents, FXFixed, TOAFixed and
+ *  SRPFixed are set exactly when the parameters are constant, and
+ *  SignalNormal is given exactly when SIGNAL is, and is false only if some
+ *  SIGNAL is 0.
+ *
+ *  The PVPs are scanned a block of vectors at a time.  Each block is
+ *  gathered into one array per parameter and the vectors are split among
+ *  threads, so a file never has to fit in memory.
+ */
+class PVPValidator
+{
+public:
+    //! Default number of bytes of PVPs to read at once
+    static const size_t DEFAULT_BLOCK_SIZE;
+
+    /*
+     *  \func PVPValidator constructor
+     *
+     *  \param metadata Metadata of the CPHD.  It's referenced, not copied,
+     *  so it must outlive the validator.
+     *  \param numThreads Number of threads to use
+     *  \param blockSize Approximate number of bytes of PVPs to scan at
+     *  once.  At least one vector is always scanned.
+     */
+    PVPValidator(const Metadata& metadata,
+                 size_t numThreads = 1,
+                 size_t blockSize = DEFAULT_BLOCK_SIZE);
+
+    /*
+     *  \func validate
+     *  \brief Validates PVPs that are already in memory
+     *
+     *  \param pvpBlock PVPs for the metadata
+     *
+     *  \return What was found
+     */
+    PVPValidation validate(const PVPBlock& pvpBlock) const;
+
+    /*
+     *  \func validate
+     *  \brief Validates PVPs streamed from a CPHD
+     *
+     *  \param inStream Stream with the CPHD
+     *  \param pvpBlockOffset Offset of the PVP block, from the file header
+     *
+     *  \return What was found
+     */
+    PVPValidation validate(io::SeekableInputStream& inStream,
+                           sys::Off_T pvpBlockOffset) const;
+
+private:
+    struct Columns;
+    struct ChannelState;
+
+    size_t getVectorsPerBlock() const;
+
+    void validateBlock(size_t channel,
+                       size_t firstVector,
+                       size_t numVectors,
+                       const sys::ubyte* pvpData,
+                       Columns& columns,
+                       ChannelState& state,
+                       std::map<std::string, VectorRanges>& results) const;
+
+    void validateChannel(size_t channel,
+                         const ChannelState& state,
+                         std::vector<std::string>& errors) const;
+
+    void validateMetadata(std::vector<std::string>& errors) const;
+
+    const Metadata& mMetadata;
+    const size_t mNumThreads;
+    const size_t mBlockSize;
+};
+}
+
+#endif
@@ -0,0 +1,150 @@
+/* =========================================================================
+ * This file is part of cphd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * cphd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CPHD_SIGNAL_CODEC_H__
+#define __CPHD_SIGNAL_CODEC_H__
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <mt/Singleton.h>
+#include <sys/Conf.h>
+
+namespace cphd
+{
+/*
+ *  \class SignalCodec
+ *  \brief Lossless compression of a block of signal array bytes
+ *
+ *  Blocks are compressed and decompressed independently and in parallel,
+ *  so implementations must be thread safe.
+ */
+class SignalCodec
+{
+public:
+    virtual ~SignalCodec();
+
+    /*
+     *  \func compress
+     *  \brief Compresses a block
+     *
+     *  \param input Bytes to compress
+     *  \param numBytes Number of bytes
+     *  \param typeSize Size of the scalars in the block, for codecs that
+     *  can make use of it
+     *  \param[out] output Compressed bytes.  Replaces any contents.
+     */
+    virtual void compress(const sys::ubyte* input,
+                          size_t numBytes,
+                          size_t typeSize,
+                          std::vector<sys::ubyte>& output) const = 0;
+
+    /*
+     *  \func decompress
+     *  \brief Decompresses a block
+     *
+     *  \param input Compressed bytes
+     *  \param inputSize Number of compressed bytes
+     *  \param typeSize The typeSize the block was compressed with
+     *  \param[out] output Decompressed bytes
+     *  \param outputSize Number of bytes the block decompresses to
+     *
+     *  \throws except::Exception If the block is corrupt
+     */
+    virtual void decompress(const sys::ubyte* input,
+                            size_t inputSize,
+                            size_t typeSize,
+                            sys::ubyte* output,
+                            size_t outputSize) const = 0;
+};
+
+/*
+ *  \class ShuffleLZCodec
+ *  \brief Byte shuffle followed by LZ77 compression
+ *
+ *  The shuffle gathers byte k of every scalar together, which turns the
+ *  slowly varying high order bytes of the samples into long runs for the
+ *  LZ stage.  Blocks that don't compress are stored as they are.
+ */
+class ShuffleLZCodec : public SignalCodec
+{
+public:
+    //! Data.SignalCompressionID that selects this codec
+    static const char IDENTIFIER[];
+
+    void compress(const sys::ubyte* input,
+                  size_t numBytes,
+                  size_t typeSize,
+                  std::vector<sys::ubyte>& output) const override;
+
+    void decompress(const sys::ubyte* input,
+                    size_t inputSize,
+                    size_t typeSize,
+                    sys::ubyte* output,
+                    size_t outputSize) const override;
+};
+
+/*
+ *  \class SignalCodecRegistry
+ *  \brief Maps a Data.SignalCompressionID to the codec that handles it
+ *
+ *  ShuffleLZCodec is registered on construction.  Signal arrays with an
+ *  identifier that isn't registered are passed through as opaque bytes.
+ *  Register codecs before reading or writing with them: readers and
+ *  writers hold on to the codec they were constructed with.
+ */
+class SignalCodecRegistry
+{
+public:
+    SignalCodecRegistry();
+
+    /*
+     *  \func addCodec
+     *  \brief Registers a codec, replacing any with the same identifier
+     *
+     *  \param identifier Data.SignalCompressionID
+     *  \param codec Codec to register
+     */
+    void addCodec(const std::string& identifier,
+                  std::unique_ptr<SignalCodec>&& codec);
+
+    /*
+     *  \func getCodec
+     *  \brief Gets a registered codec
+     *
+     *  \param identifier Data.SignalCompressionID
+     *
+     *  \return The codec, or nullptr if none is registered
+     */
+    const SignalCodec* getCodec(const std::string& identifier) const;
+
+private:
+    std::map<std::string, std::unique_ptr<SignalCodec> > mRegistry;
+};
+
+//! Singleton declaration of our SignalCodecRegistry
+typedef mt::Singleton<SignalCodecRegistry, true> SignalCodecFactory;
+}
+
+#endif
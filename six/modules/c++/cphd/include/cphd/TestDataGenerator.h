@@ -90,6 +90,62 @@ void setVectorParameters(size_t channel,
  */
 void setUpMetadata(Metadata& metadata);
 
+/*
+ *  \func setUpSyntheticMetadata
+ *  \brief Sets up metadata for a synthetic CPHD of any size, e.g. for
+ *  benchmarks
+ *
+ *  Every channel has the same dimensions.  The required PVPs are followed
+ *  by F8 added PVPs named "Added0", "Added1", ... and the support arrays,
+ *  named "Support0", "Support1", ..., have 4 byte elements.
+ *
+ *  \param numChannels Number of channels
+ *  \param dims Number of vectors and samples of each channel
+ *  \param format Signal array format
+ *  \param numAddedPVPs Number of added PVPs
+ *  \param numSupportArrays Number of support arrays
+ *  \param supportDims Number of rows and columns of each support array
+ *  \param[out] metadata Filled metadata object
+ */
+void setUpSyntheticMetadata(size_t numChannels,
+                            const types::RowCol<size_t>& dims,
+                            SignalArrayFormat format,
+                            size_t numAddedPVPs,
+                            size_t numSupportArrays,
+                            const types::RowCol<size_t>& supportDims,
+                            Metadata& metadata);
+
+/*
+ *  \func setSyntheticVectorParameters
+ *  \brief Sets random values for every PVP, added ones included, of every
+ *  vector
+ *
+ *  \param metadata Metadata from setUpSyntheticMetadata
+ *  \param[in,out] pvpBlock An initialized pvpBlock object
+ */
+void setSyntheticVectorParameters(const Metadata& metadata,
+                                  PVPBlock& pvpBlock);
+
+/*
+ *  \func writeSyntheticCPHD
+ *  \brief Writes a CPHD with random support arrays and signal arrays
+ *
+ *  The signal arrays are written a chunk at a time, repeating one random
+ *  chunk, so files much larger than memory can be made.  The support
+ *  arrays are held in memory.
+ *
+ *  \param metadata Metadata from setUpSyntheticMetadata
+ *  \param pvpBlock PVPs to write
+ *  \param pathname Pathname of the CPHD to write
+ *  \param numThreads Number of threads to byte swap with
+ *  \param chunkSize Approximate number of bytes of signal to write at once
+ */
+void writeSyntheticCPHD(const Metadata& metadata,
+                        const PVPBlock& pvpBlock,
+                        const std::string& pathname,
+                        size_t numThreads,
+                        size_t chunkSize = 64 * 1024 * 1024);
+
 /*
  *  \func setUpData
  *  \brief Sets up data metadata, as well as rest of metadata
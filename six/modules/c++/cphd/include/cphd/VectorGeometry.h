@@ -0,0 +1,200 @@
+/* =========================================================================
+ * This file is part of cphd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * cphd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CPHD_VECTOR_GEOMETRY_H__
+#define __CPHD_VECTOR_GEOMETRY_H__
+
+#include <vector>
+
+#include <six/Enums.h>
+#include <cphd/Metadata.h>
+#include <cphd/PVPBlock.h>
+#include <cphd/ReferenceGeometry.h>
+#include <cphd/Types.h>
+
+namespace cphd
+{
+/*
+ *  \struct VectorGeometry
+ *  \brief Collection geometry for a run of vectors, one array per parameter
+ *
+ *  The parameters are the Monostatic ones of the ReferenceGeometry, with
+ *  the ARP at the midpoint of the transmit and receive APCs.  The target
+ *  is the SRP, or a scene point.  Angles are in degrees.
+ */
+struct VectorGeometry
+{
+    //! Number of entries
+    size_t size() const
+    {
+        return time.size();
+    }
+
+    //! Resize all the arrays
+    void resize(size_t size);
+
+    //! ARP time, (TxTime + RcvTime) / 2
+    std::vector<double> time;
+
+    //! ARP position, (TxPos + RcvPos) / 2
+    std::vector<Vector3> arpPos;
+
+    //! ARP velocity, (TxVel + RcvVel) / 2
+    std::vector<Vector3> arpVel;
+
+    //! SRP or scene point
+    std::vector<Vector3> targetPos;
+
+    //! Unit line of sight from the ARP to the target
+    std::vector<Vector3> uLOS;
+
+    std::vector<six::SideOfTrackType> sideOfTrack;
+    std::vector<double> slantRange;
+    std::vector<double> groundRange;
+    std::vector<double> dopplerConeAngle;
+    std::vector<double> grazeAngle;
+    std::vector<double> incidenceAngle;
+    std::vector<double> azimuthAngle;
+    std::vector<double> twistAngle;
+    std::vector<double> slopeAngle;
+    std::vector<double> layoverAngle;
+
+    //! Angle between the lines of sight from the target to the transmit
+    //! and receive APCs.  Zero if they're in the same place.
+    std::vector<double> bistaticAngle;
+};
+
+/*
+ *  \class VectorGeometryCalculator
+ *  \brief Derives the collection geometry of every vector from the PVPs
+ *
+ *  The angles are defined as in ReferenceGeometry, and match what
+ *  six::sicd::SCPCOA derives for a single point.  The Earth tangent plane
+ *  at a target is only recomputed when the target moves, so a fixed SRP
+ *  costs one geodetic conversion per thread.
+ */
+class VectorGeometryCalculator
+{
+public:
+    /*
+     *  \func VectorGeometryCalculator
+     *  \brief Constructor
+     *
+     *  \param metadata CPHD metadata
+     *  \param pvpBlock PVPs for the metadata.  Both are referenced, not
+     *  copied, so they must outlive the calculator.
+     *  \param numThreads Number of threads to use
+     */
+    VectorGeometryCalculator(const Metadata& metadata,
+                             const PVPBlock& pvpBlock,
+                             size_t numThreads = 1);
+
+    /*
+     *  \func getChannelGeometry
+     *  \brief Computes the geometry to the SRP for all of a channel's
+     *  vectors
+     *
+     *  \param channel Channel number
+     *  \param[out] geometry Geometry of each vector
+     */
+    void getChannelGeometry(size_t channel, VectorGeometry& geometry) const;
+
+    /*
+     *  \func getGeometry
+     *  \brief Computes the geometry to the SRP for a span of vectors
+     *
+     *  \param channel Channel number
+     *  \param firstVector First vector
+     *  \param numVectors Number of vectors
+     *  \param[out] geometry Geometry of each vector
+     */
+    void getGeometry(size_t channel,
+                     size_t firstVector,
+                     size_t numVectors,
+                     VectorGeometry& geometry) const;
+
+    /*
+     *  \func getGeometry
+     *  \brief Computes the geometry to scene points for a span of vectors
+     *
+     *  \param channel Channel number
+     *  \param firstVector First vector
+     *  \param numVectors Number of vectors
+     *  \param points Scene points (ECF)
+     *  \param numPoints Number of points
+     *  \param[out] geometry Geometry of each point for each vector, at
+     *  [v * numPoints + p]
+     */
+    void getGeometry(size_t channel,
+                     size_t firstVector,
+                     size_t numVectors,
+                     const Vector3* points,
+                     size_t numPoints,
+                     VectorGeometry& geometry) const;
+
+    /*
+     *  \func getReferenceGeometry
+     *  \brief Regenerates the ReferenceGeometry for a span of vectors
+     *
+     *  The reference vector is the middle of the span.  Monostatic or
+     *  Bistatic is filled according to the collect type.  The SRP image
+     *  area coordinates and COD and dwell times need a planar reference
+     *  surface and the channel's COD and dwell polynomials.
+     *
+     *  \param channel Channel number
+     *  \param firstVector First vector
+     *  \param numVectors Number of vectors
+     *
+     *  \return The reference geometry
+     *
+     *  \throws except::Exception If the span is empty or out of bounds,
+     *  the reference surface isn't planar, or the dwell polynomials can't
+     *  be found
+     */
+    ReferenceGeometry getReferenceGeometry(size_t channel,
+                                           size_t firstVector,
+                                           size_t numVectors) const;
+
+private:
+    struct Platforms;
+    class ComputeVectors;
+
+    void checkSpan(size_t channel,
+                   size_t firstVector,
+                   size_t numVectors) const;
+
+    void getPlatforms(size_t channel,
+                      size_t firstVector,
+                      size_t numVectors,
+                      Platforms& platforms) const;
+
+    void getBistatic(size_t channel,
+                     size_t vector,
+                     ReferenceGeometry& geometry) const;
+
+    const Metadata& mMetadata;
+    const PVPBlock& mPVPBlock;
+    const size_t mNumThreads;
+};
+}
+
+#endif
@@ -24,8 +24,11 @@
 
 #include <complex>
 #include <string>
+#include <vector>
 
+#include <cphd/CompressedSignal.h>
 #include <cphd/MetadataBase.h>
+#include <cphd/SignalCodec.h>
 #include <cphd/Utilities.h>
 
 #include <io/SeekableStreams.h>
@@ -42,6 +45,10 @@ namespace cphd
  */
 //  It contains the cphd::Data structure (for channel and vector sizes).
 //  Provides methods read wideband data from CPHD file/stream
+//  Compressed signal arrays whose SignalCompressionID has a codec in the
+//  SignalCodecFactory are read like uncompressed ones, decompressing only
+//  the blocks that overlap the requested vectors.  Others can only be read
+//  whole, as opaque bytes.
 class Wideband
 {
 public:
@@ -136,7 +143,8 @@ public:
      *  \throw except::Exception If invalid channel, firstVector, lastVector,
      *   firstSample or lastSample
      *  \throw except::Exception If BufferView memory allocated is insufficient
-     *  \throw except::Exception If wideband data is compressed
+     *  \throw except::Exception If wideband data is compressed without a
+     *   registered codec and this is a partial read
      */
     void read(size_t channel,
               size_t firstVector,
@@ -182,7 +190,8 @@ public:
      *
      *  \throw except::Exception If invalid channel, firstVector, lastVector,
      *   firstSample or lastSample
-     *  \throw except::Exception If wideband data is compressed
+     *  \throw except::Exception If wideband data is compressed without a
+     *   registered codec and this is a partial read
      */
     // Same as above but allocates the memory
     void read(size_t channel,
@@ -235,7 +244,8 @@ public:
      * number of samples
      *  \throw except::Exception If scratch size is not
      * at least the bytes size of one signal array
-     *  \throw except::Exception If wideband data is compressed
+     *  \throw except::Exception If wideband data is compressed without a
+     *   registered codec and this is a partial read
      */
     // Same as above but also applies a per-vector scale factor
     void read(size_t channel,
@@ -268,7 +278,8 @@ public:
      *
      *  \throw except::Exception If invalid channel, firstVector, lastVector,
      *   firstSample or lastSample
-     *  \throw except::Exception If wideband data is compressed
+     *  \throw except::Exception If wideband data is compressed without a
+     *   registered codec and this is a partial read
      */
     // Same as above but for a raw pointer
     // The pointer needs to be preallocated. Use getBufferDims for this.
@@ -309,7 +320,8 @@ public:
      * \param firstSample 0-based first sample of read request (inclusive)
      * \param lastSample 0-based last sample of read request(inclusive)
      * \return Number of bytes in area
-     * \throw except::Exception If wideband data is compressed
+     * \throw except::Exception If wideband data is compressed without a
+     *  registered codec and this is a partial read
      */
     size_t getBytesRequiredForRead(size_t channel,
                                    size_t firstVector,
@@ -380,7 +392,7 @@ private:
     void checkChannelInput(size_t channel) const;
 
     /*
-     *  Just performs the read
+     *  Just performs the read, decompressing if necessary
      *  No allocation, endian swapping or scaling
      */
     void readImpl(size_t channel,
@@ -388,6 +400,7 @@ private:
                   size_t lastVector,
                   size_t firstSample,
                   size_t lastSample,
+                  size_t numThreads,
                   void* data) const;
 
     /*
@@ -417,6 +430,11 @@ private:
 
     std::vector<sys::Off_T> mOffsets;  // Offset to start of each channel
 
+    // Codec for compressed signal arrays, if there's one registered,
+    // and the block index of each channel
+    const SignalCodec* mCodec;
+    std::vector<CompressedSignal> mCompressedSignals;
+
     friend std::ostream& operator<<(std::ostream& os, const Wideband& d);
 };
 }
@@ -27,6 +27,7 @@
 
 #include "cphd/Antenna.h"
 #include "cphd/Channel.h"
+#include "cphd/CPHDMetadataReader.h"
 #include "cphd/CPHDReader.h"
 #include "cphd/CPHDWriter.h"
 #include "cphd/CPHDXMLControl.h"
@@ -0,0 +1,648 @@
+/* =========================================================================
+ * This file is part of cphd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * cphd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <except/Exception.h>
+#include <mem/ScopedArray.h>
+#include <mt/Runnable1D.h>
+#include <sys/Conf.h>
+#include <six/Init.h>
+#include <cphd/AntennaPatternEvaluator.h>
+#include <cphd/ByteSwap.h>
+
+namespace
+{
+// Gain=F4;Phase=F4;
+const size_t GAIN_PHASE_BYTES = 8;
+
+bool isSet(six::BooleanType value)
+{
+    return value == six::BooleanType::IS_TRUE;
+}
+
+bool isSet(const std::string& value)
+{
+    return !value.empty() && !six::Init::isUndefined(value);
+}
+
+// out[p] += poly(x[p], y[p])
+// Horner's method in y for each power of x, then in x, one coefficient at a
+// time across all the points
+void addPoly2D(const cphd::Poly2D& poly,
+               const double* x,
+               const double* y,
+               size_t numPoints,
+               std::vector<double>& rowValues,
+               std::vector<double>& values,
+               double* out)
+{
+    if (poly.empty())
+    {
+        return;
+    }
+
+    const size_t orderX = poly.orderX();
+    const size_t orderY = poly.orderY();
+    std::fill(values.begin(), values.begin() + numPoints, 0.0);
+    for (size_t ii = orderX + 1; ii-- > 0; )
+    {
+        const cphd::Poly1D row = poly[ii];
+        std::fill(rowValues.begin(), rowValues.begin() + numPoints,
+                  row[orderY]);
+        for (size_t jj = orderY; jj-- > 0; )
+        {
+            const double coefficient = row[jj];
+            for (size_t pp = 0; pp < numPoints; ++pp)
+            {
+                rowValues[pp] = rowValues[pp] * y[pp] + coefficient;
+            }
+        }
+        for (size_t pp = 0; pp < numPoints; ++pp)
+        {
+            values[pp] = values[pp] * x[pp] + rowValues[pp];
+        }
+    }
+
+    for (size_t pp = 0; pp < numPoints; ++pp)
+    {
+        out[pp] += values[pp];
+    }
+}
+
+// Finds the sample at or before a coordinate and how far past it the
+// coordinate is.  False outside of the samples.
+bool getSample(double coordinate,
+               double first,
+               double spacing,
+               size_t numSamples,
+               size_t& index,
+               size_t& next,
+               double& fraction)
+{
+    const double position = (coordinate - first) / spacing;
+    if (!(position >= 0.0) || position > numSamples - 1)
+    {
+        return false;
+    }
+    if (numSamples == 1)
+    {
+        index = next = 0;
+        fraction = 0.0;
+        return true;
+    }
+    index = std::min(static_cast<size_t>(position), numSamples - 2);
+    next = index + 1;
+    fraction = position - index;
+    return true;
+}
+}
+
+namespace cphd
+{
+// Evaluates a pattern for one vector at a time.  Each thread gets its own
+// copy for scratch space.
+class AntennaPatternEvaluator::EvaluateVectors
+{
+public:
+    EvaluateVectors(const Pattern& pattern,
+                    const double* times,
+                    const double* frequencies,
+                    const double* dcx,
+                    const double* dcy,
+                    size_t numPoints,
+                    double* gain,
+                    double* phase) :
+        mPattern(pattern),
+        mTimes(times),
+        mFrequencies(frequencies),
+        mDCX(dcx),
+        mDCY(dcy),
+        mNumPoints(numPoints),
+        mGain(gain),
+        mPhase(phase),
+        mDX(numPoints),
+        mDY(numPoints),
+        mRowValues(numPoints),
+        mValues(numPoints)
+    {
+    }
+
+    void operator()(size_t vector) const
+    {
+        const AntPattern& pattern = mPattern.pattern;
+        const double time = mTimes[vector];
+        const double frequency = mFrequencies[vector];
+        const double freqZero = pattern.freqZero;
+        const size_t offset = vector * mNumPoints;
+        const double* const dcx = mDCX + offset;
+        const double* const dcy = mDCY + offset;
+        double* const gain = mGain + offset;
+        double* const phase = mPhase + offset;
+
+        double ebDCX = pattern.eb.dcxPoly.empty() ?
+                0.0 : pattern.eb.dcxPoly(time);
+        double ebDCY = pattern.eb.dcyPoly.empty() ?
+                0.0 : pattern.eb.dcyPoly(time);
+        if (isSet(pattern.ebFreqShift))
+        {
+            ebDCX *= freqZero / frequency;
+            ebDCY *= freqZero / frequency;
+        }
+
+        double boresightGain = 0.0;
+        if (!six::Init::isUndefined(pattern.gainZero))
+        {
+            boresightGain += pattern.gainZero;
+        }
+        if (!pattern.gainBSPoly.empty())
+        {
+            // The polynomial is in terms of the frequency ratio
+            boresightGain += pattern.gainBSPoly(frequency / freqZero - 1.0);
+        }
+
+        std::fill(gain, gain + mNumPoints, boresightGain);
+        std::fill(phase, phase + mNumPoints, 0.0);
+        for (size_t pp = 0; pp < mNumPoints; ++pp)
+        {
+            mDX[pp] = dcx[pp] - ebDCX;
+            mDY[pp] = dcy[pp] - ebDCY;
+        }
+
+        const std::vector<SampledPattern>& sampled = mPattern.sampled;
+        bool sampledElement = false;
+        if (sampled.empty())
+        {
+            if (isSet(pattern.mlFreqDilation))
+            {
+                const double dilation = frequency / freqZero;
+                for (size_t pp = 0; pp < mNumPoints; ++pp)
+                {
+                    mDX[pp] *= dilation;
+                    mDY[pp] *= dilation;
+                }
+            }
+            addPoly2D(pattern.array.gainPoly, &mDX[0], &mDY[0], mNumPoints,
+                      mRowValues, mValues, gain);
+            addPoly2D(pattern.array.phasePoly, &mDX[0], &mDY[0], mNumPoints,
+                      mRowValues, mValues, phase);
+        }
+        else
+        {
+            // Interpolate between the nearest frequencies, or hold the
+            // nearest one past either end
+            size_t upper = 0;
+            while (upper < sampled.size() && sampled[upper].freq < frequency)
+            {
+                ++upper;
+            }
+            size_t lower = upper;
+            double weight = 0.0;
+            if (upper == sampled.size())
+            {
+                lower = upper = sampled.size() - 1;
+            }
+            else if (upper > 0)
+            {
+                lower = upper - 1;
+                weight = (frequency - sampled[lower].freq) /
+                        (sampled[upper].freq - sampled[lower].freq);
+            }
+
+            addSampled(sampled[lower].array, sampled[upper].array, weight,
+                       &mDX[0], &mDY[0], gain, phase);
+            if (sampled[lower].hasElement && sampled[upper].hasElement)
+            {
+                addSampled(sampled[lower].element, sampled[upper].element,
+                           weight, dcx, dcy, gain, phase);
+                sampledElement = true;
+            }
+        }
+
+        if (!sampledElement)
+        {
+            addPoly2D(pattern.element.gainPoly, dcx, dcy, mNumPoints,
+                      mRowValues, mValues, gain);
+            addPoly2D(pattern.element.phasePoly, dcx, dcy, mNumPoints,
+                      mRowValues, mValues, phase);
+        }
+    }
+
+private:
+    static bool interpolate(const SampledGrid& grid,
+                            double x,
+                            double y,
+                            double& gain,
+                            double& phase)
+    {
+        size_t row;
+        size_t nextRow;
+        double rowFraction;
+        size_t col;
+        size_t nextCol;
+        double colFraction;
+        if (!getSample(x, grid.x0, grid.xSS, grid.numRows,
+                       row, nextRow, rowFraction) ||
+            !getSample(y, grid.y0, grid.ySS, grid.numCols,
+                       col, nextCol, colFraction))
+        {
+            return false;
+        }
+
+        const size_t index00 = row * grid.numCols + col;
+        const size_t index01 = row * grid.numCols + nextCol;
+        const size_t index10 = nextRow * grid.numCols + col;
+        const size_t index11 = nextRow * grid.numCols + nextCol;
+        gain = (1 - rowFraction) * ((1 - colFraction) * grid.gain[index00] +
+                                    colFraction * grid.gain[index01]) +
+                rowFraction * ((1 - colFraction) * grid.gain[index10] +
+                               colFraction * grid.gain[index11]);
+        phase = (1 - rowFraction) * ((1 - colFraction) * grid.phase[index00] +
+                                     colFraction * grid.phase[index01]) +
+                rowFraction * ((1 - colFraction) * grid.phase[index10] +
+                               colFraction * grid.phase[index11]);
+        return true;
+    }
+
+    void addSampled(const SampledGrid& lower,
+                    const SampledGrid& upper,
+                    double weight,
+                    const double* x,
+                    const double* y,
+                    double* gain,
+                    double* phase) const
+    {
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        for (size_t pp = 0; pp < mNumPoints; ++pp)
+        {
+            double lowerGain;
+            double lowerPhase;
+            if (!interpolate(lower, x[pp], y[pp], lowerGain, lowerPhase))
+            {
+                gain[pp] = phase[pp] = nan;
+                continue;
+            }
+            if (weight == 0.0)
+            {
+                gain[pp] += lowerGain;
+                phase[pp] += lowerPhase;
+                continue;
+            }
+
+            double upperGain;
+            double upperPhase;
+            if (!interpolate(upper, x[pp], y[pp], upperGain, upperPhase))
+            {
+                gain[pp] = phase[pp] = nan;
+                continue;
+            }
+            gain[pp] += (1 - weight) * lowerGain + weight * upperGain;
+            phase[pp] += (1 - weight) * lowerPhase + weight * upperPhase;
+        }
+    }
+
+    const Pattern& mPattern;
+    const double* const mTimes;
+    const double* const mFrequencies;
+    const double* const mDCX;
+    const double* const mDCY;
+    const size_t mNumPoints;
+    double* const mGain;
+    double* const mPhase;
+
+    mutable std::vector<double> mDX;
+    mutable std::vector<double> mDY;
+    mutable std::vector<double> mRowValues;
+    mutable std::vector<double> mValues;
+};
+
+class AntennaPatternEvaluator::DirectionCosineVectors
+{
+public:
+    DirectionCosineVectors(const AntCoordFrame& acf,
+                           const double* times,
+                           const Vector3* apcPositions,
+                           const Vector3* points,
+                           size_t numPoints,
+                           double* dcx,
+                           double* dcy) :
+        mACF(acf),
+        mTimes(times),
+        mAPCPositions(apcPositions),
+        mPoints(points),
+        mNumPoints(numPoints),
+        mDCX(dcx),
+        mDCY(dcy)
+    {
+    }
+
+    void operator()(size_t vector) const
+    {
+        const Vector3 xAxis = mACF.xAxisPoly(mTimes[vector]).unit();
+        const Vector3 yAxis = mACF.yAxisPoly(mTimes[vector]).unit();
+        const Vector3& apcPosition = mAPCPositions[vector];
+        double* const dcx = mDCX + vector * mNumPoints;
+        double* const dcy = mDCY + vector * mNumPoints;
+        for (size_t pp = 0; pp < mNumPoints; ++pp)
+        {
+            const Vector3 lineOfSight = mPoints[pp] - apcPosition;
+            const double range = lineOfSight.norm();
+            dcx[pp] = lineOfSight.dot(xAxis) / range;
+            dcy[pp] = lineOfSight.dot(yAxis) / range;
+        }
+    }
+
+private:
+    const AntCoordFrame& mACF;
+    const double* const mTimes;
+    const Vector3* const mAPCPositions;
+    const Vector3* const mPoints;
+    const size_t mNumPoints;
+    double* const mDCX;
+    double* const mDCY;
+};
+
+AntennaPatternEvaluator::AntennaPatternEvaluator(
+        const Metadata& metadata,
+        const SupportBlock* supportBlock,
+        size_t numThreads) :
+    mNumThreads(std::max<size_t>(numThreads, 1))
+{
+    if (metadata.antenna.get() == nullptr)
+    {
+        throw except::Exception(Ctxt("Metadata has no Antenna block"));
+    }
+    const Antenna& antenna = *metadata.antenna;
+
+    for (size_t ii = 0; ii < antenna.antCoordFrame.size(); ++ii)
+    {
+        mACFs[antenna.antCoordFrame[ii].identifier] =
+                antenna.antCoordFrame[ii];
+    }
+    for (size_t ii = 0; ii < antenna.antPhaseCenter.size(); ++ii)
+    {
+        const AntPhaseCenter& apc = antenna.antPhaseCenter[ii];
+        if (mACFs.count(apc.acfId) == 0)
+        {
+            throw except::Exception(Ctxt(
+                    "APC " + apc.identifier + " references unknown ACF " +
+                    apc.acfId));
+        }
+        mAPCToACF[apc.identifier] = apc.acfId;
+    }
+
+    for (size_t ii = 0; ii < antenna.antPattern.size(); ++ii)
+    {
+        const AntPattern& antPattern = antenna.antPattern[ii];
+        Pattern& pattern = mPatterns[antPattern.identifier];
+        pattern.pattern = antPattern;
+        if (supportBlock == nullptr)
+        {
+            continue;
+        }
+
+        for (size_t jj = 0; jj < antPattern.gainPhaseArray.size(); ++jj)
+        {
+            const AntPattern::GainPhaseArray& array =
+                    antPattern.gainPhaseArray[jj];
+            SampledPattern sampled;
+            sampled.freq = array.freq;
+            sampled.array = readGrid(metadata, *supportBlock, array.arrayId);
+            sampled.hasElement = isSet(array.elementId);
+            if (sampled.hasElement)
+            {
+                sampled.element =
+                        readGrid(metadata, *supportBlock, array.elementId);
+            }
+            pattern.sampled.push_back(sampled);
+        }
+        std::sort(pattern.sampled.begin(), pattern.sampled.end(),
+                  [](const SampledPattern& lhs, const SampledPattern& rhs)
+                  {
+                      return lhs.freq < rhs.freq;
+                  });
+    }
+
+    const size_t numChannels = metadata.data.getNumChannels();
+    mChannelAntennas.resize(numChannels);
+    mNumVectors.resize(numChannels);
+    for (size_t ii = 0; ii < numChannels; ++ii)
+    {
+        mNumVectors[ii] = metadata.data.getNumVectors(ii);
+        if (ii < metadata.channel.parameters.size() &&
+            metadata.channel.parameters[ii].antenna.get())
+        {
+            mChannelAntennas[ii] = *metadata.channel.parameters[ii].antenna;
+        }
+    }
+}
+
+AntennaPatternEvaluator::SampledGrid
+AntennaPatternEvaluator::readGrid(const Metadata& metadata,
+                                  const SupportBlock& supportBlock,
+                                  const std::string& id) const
+{
+    if (metadata.supportArray.get() == nullptr)
+    {
+        throw except::Exception(Ctxt(
+                "Gain and phase array " + id + " has no SupportArray"));
+    }
+    const SupportArrayParameter parameter =
+            metadata.supportArray->getAGPSupportArray(id);
+    const Data::SupportArray array = metadata.data.getSupportArrayById(id);
+    if (array.bytesPerElement != GAIN_PHASE_BYTES)
+    {
+        throw except::Exception(Ctxt(
+                "Gain and phase array " + id + " isn't Gain=F4;Phase=F4;"));
+    }
+
+    SampledGrid grid;
+    grid.x0 = parameter.x0;
+    grid.y0 = parameter.y0;
+    grid.xSS = parameter.xSS;
+    grid.ySS = parameter.ySS;
+    grid.numRows = array.numRows;
+    grid.numCols = array.numCols;
+
+    const size_t numElements = array.numRows * array.numCols;
+    mem::ScopedArray<sys::ubyte> data;
+    supportBlock.read(id, mNumThreads, data);
+    if (!sys::isBigEndianSystem())
+    {
+        // SupportBlock swaps the whole 8 byte element, but it's two 4 byte
+        // floats.  Put it back in file order and swap them one at a time.
+        byteSwap(data.get(), GAIN_PHASE_BYTES, numElements, mNumThreads);
+        byteSwap(data.get(), sizeof(float), numElements * 2, mNumThreads);
+    }
+
+    grid.gain.resize(numElements);
+    grid.phase.resize(numElements);
+    for (size_t ii = 0; ii < numElements; ++ii)
+    {
+        float values[2];
+        std::memcpy(values, data.get() + ii * GAIN_PHASE_BYTES,
+                    GAIN_PHASE_BYTES);
+        grid.gain[ii] = values[0];
+        grid.phase[ii] = values[1];
+    }
+    return grid;
+}
+
+const AntCoordFrame&
+AntennaPatternEvaluator::getACF(const std::string& apcId) const
+{
+    const auto apc = mAPCToACF.find(apcId);
+    if (apc == mAPCToACF.end())
+    {
+        throw except::Exception(Ctxt("Unknown APC " + apcId));
+    }
+    return mACFs.find(apc->second)->second;
+}
+
+const AntennaPatternEvaluator::Pattern&
+AntennaPatternEvaluator::getPattern(const std::string& apatId) const
+{
+    const auto pattern = mPatterns.find(apatId);
+    if (pattern == mPatterns.end())
+    {
+        throw except::Exception(Ctxt("Unknown antenna pattern " + apatId));
+    }
+    return pattern->second;
+}
+
+size_t AntennaPatternEvaluator::getNumThreads(size_t numVectors) const
+{
+    return std::max<size_t>(std::min(mNumThreads, numVectors), 1);
+}
+
+void AntennaPatternEvaluator::getDirectionCosines(
+        const std::string& apcId,
+        const double* times,
+        const Vector3* apcPositions,
+        size_t numVectors,
+        const Vector3* points,
+        size_t numPoints,
+        double* dcx,
+        double* dcy) const
+{
+    const DirectionCosineVectors op(getACF(apcId), times, apcPositions,
+                                    points, numPoints, dcx, dcy);
+    mt::run1D(numVectors, getNumThreads(numVectors), op);
+}
+
+void AntennaPatternEvaluator::evaluate(const std::string& apatId,
+                                       const double* times,
+                                       const double* frequencies,
+                                       size_t numVectors,
+                                       const double* dcx,
+                                       const double* dcy,
+                                       size_t numPoints,
+                                       double* gain,
+                                       double* phase) const
+{
+    if (numVectors == 0 || numPoints == 0)
+    {
+        return;
+    }
+
+    const size_t numThreads = getNumThreads(numVectors);
+    const std::vector<EvaluateVectors> ops(
+            numThreads,
+            EvaluateVectors(getPattern(apatId), times, frequencies,
+                            dcx, dcy, numPoints, gain, phase));
+    mt::run1D(numVectors, numThreads, ops);
+}
+
+void AntennaPatternEvaluator::evaluateTwoWay(const PVPBlock& pvpBlock,
+                                             size_t channel,
+                                             size_t firstVector,
+                                             size_t numVectors,
+                                             const Vector3* points,
+                                             size_t numPoints,
+                                             double* gain,
+                                             double* phase) const
+{
+    if (channel >= mChannelAntennas.size())
+    {
+        std::ostringstream ostr;
+        ostr << "Channel " << channel << " is out of bounds";
+        throw except::Exception(Ctxt(ostr.str()));
+    }
+    if (firstVector + numVectors > mNumVectors[channel])
+    {
+        std::ostringstream ostr;
+        ostr << "Vectors [" << firstVector << ", "
+             << firstVector + numVectors << ") are out of bounds for channel "
+             << channel << " with " << mNumVectors[channel] << " vectors";
+        throw except::Exception(Ctxt(ostr.str()));
+    }
+    const ChannelParameter::Antenna& antenna = mChannelAntennas[channel];
+    if (!isSet(antenna.txAPCId) || !isSet(antenna.rcvAPCId))
+    {
+        std::ostringstream ostr;
+        ostr << "Channel " << channel << " has no antenna identifiers";
+        throw except::Exception(Ctxt(ostr.str()));
+    }
+
+    std::vector<double> txTimes(numVectors);
+    std::vector<Vector3> txPositions(numVectors);
+    std::vector<double> rcvTimes(numVectors);
+    std::vector<Vector3> rcvPositions(numVectors);
+    std::vector<double> frequencies(numVectors);
+    for (size_t ii = 0; ii < numVectors; ++ii)
+    {
+        const size_t vector = firstVector + ii;
+        txTimes[ii] = pvpBlock.getTxTime(channel, vector);
+        txPositions[ii] = pvpBlock.getTxPos(channel, vector);
+        rcvTimes[ii] = pvpBlock.getRcvTime(channel, vector);
+        rcvPositions[ii] = pvpBlock.getRcvPos(channel, vector);
+        frequencies[ii] = (pvpBlock.getFx1(channel, vector) +
+                           pvpBlock.getFx2(channel, vector)) / 2;
+    }
+
+    const size_t numValues = numVectors * numPoints;
+    std::vector<double> dcx(numValues);
+    std::vector<double> dcy(numValues);
+    getDirectionCosines(antenna.txAPCId, txTimes.data(), txPositions.data(),
+                        numVectors, points, numPoints, dcx.data(), dcy.data());
+    evaluate(antenna.txAPATId, txTimes.data(), frequencies.data(), numVectors,
+             dcx.data(), dcy.data(), numPoints, gain, phase);
+
+    std::vector<double> rcvGain(numValues);
+    std::vector<double> rcvPhase(numValues);
+    getDirectionCosines(antenna.rcvAPCId, rcvTimes.data(),
+                        rcvPositions.data(), numVectors, points, numPoints,
+                        dcx.data(), dcy.data());
+    evaluate(antenna.rcvAPATId, rcvTimes.data(), frequencies.data(),
+             numVectors, dcx.data(), dcy.data(), numPoints,
+             rcvGain.data(), rcvPhase.data());
+
+    for (size_t ii = 0; ii < numValues; ++ii)
+    {
+        gain[ii] += rcvGain[ii];
+        phase[ii] += rcvPhase[ii];
+    }
+}
+}
@@ -22,10 +22,14 @@
 #include <sys/Conf.h>
 #include <mt/ThreadPlanner.h>
 #include <mt/ThreadGroup.h>
+#include <six/Instrumentation.h>
 #include <cphd/ByteSwap.h>
 
 namespace
 {
+const size_t BYTE_SWAP_POINT =
+        six::Instrumentation::registerPoint("cphd::byteSwap");
+
 // TODO: Maybe this should go in sys/Conf.h
 //       It's more flexible in that it properly handles float's - you can't
 //       just call sys::byteSwap(floatVal) because the compiler may change the
@@ -251,6 +255,7 @@ void byteSwap(void* buffer,
               size_t numElements,
               size_t numThreads)
 {
+    six::InstrumentationTimer timer(BYTE_SWAP_POINT, elemSize * numElements);
     if (numThreads <= 1)
     {
         sys::byteSwap(buffer,
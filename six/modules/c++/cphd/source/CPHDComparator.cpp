@@ -0,0 +1,845 @@
+/* =========================================================================
+ * This file is part of cphd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * cphd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <type_traits>
+#include <utility>
+
+#include <except/Exception.h>
+#include <mem/BufferView.h>
+#include <mem/ScopedArray.h>
+#include <mt/Runnable1D.h>
+#include <str/Convert.h>
+#include <six/Init.h>
+#include <cphd/CPHDComparator.h>
+
+namespace
+{
+// Number of elements a thread compares at a time
+const size_t CHUNK_SIZE = 64 * 1024;
+
+// Map the bits of a float onto integers that are in the same order as the
+// floats, so the distance between them is the number of floats in between
+sys::Int64_T orderedBits(float value)
+{
+    sys::Int32_T bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits < 0 ?
+            static_cast<sys::Int64_T>(
+                    std::numeric_limits<sys::Int32_T>::min()) - bits :
+            bits;
+}
+
+sys::Int64_T orderedBits(double value)
+{
+    sys::Int64_T bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits < 0 ? std::numeric_limits<sys::Int64_T>::min() - bits : bits;
+}
+
+template <typename T>
+sys::Uint64_T ulpDistance(T lhs, T rhs, std::true_type /*isFloatingPoint*/)
+{
+    const sys::Int64_T lhsBits = orderedBits(lhs);
+    const sys::Int64_T rhsBits = orderedBits(rhs);
+
+    // Unsigned so this can't overflow
+    return lhsBits > rhsBits ?
+            static_cast<sys::Uint64_T>(lhsBits) -
+                    static_cast<sys::Uint64_T>(rhsBits) :
+            static_cast<sys::Uint64_T>(rhsBits) -
+                    static_cast<sys::Uint64_T>(lhsBits);
+}
+
+template <typename T>
+sys::Uint64_T ulpDistance(T lhs, T rhs, std::false_type /*isFloatingPoint*/)
+{
+    const sys::Int64_T diff =
+            static_cast<sys::Int64_T>(lhs) - static_cast<sys::Int64_T>(rhs);
+    return static_cast<sys::Uint64_T>(diff < 0 ? -diff : diff);
+}
+
+template <typename T>
+bool isNaN(T value)
+{
+    return value != value;
+}
+
+// Returns true if the values match.  error is set to their absolute
+// difference.
+template <typename T>
+bool withinTolerance(T lhs,
+                     T rhs,
+                     const cphd::CompareTolerance& tolerance,
+                     double& error)
+{
+    if (lhs == rhs || (isNaN(lhs) && isNaN(rhs)))
+    {
+        error = 0.0;
+        return true;
+    }
+
+    const double lhsValue = static_cast<double>(lhs);
+    const double rhsValue = static_cast<double>(rhs);
+    error = std::abs(lhsValue - rhsValue);
+    if (isNaN(error))
+    {
+        error = std::numeric_limits<double>::infinity();
+        return false;
+    }
+
+    return error <= tolerance.absolute ||
+           error <= tolerance.relative *
+                    std::max(std::abs(lhsValue), std::abs(rhsValue)) ||
+           ulpDistance(lhs, rhs, std::is_floating_point<T>()) <=
+                   tolerance.ulps;
+}
+
+template <typename T>
+struct ElementCompare
+{
+    static bool matches(T lhs,
+                        T rhs,
+                        const cphd::CompareTolerance& tolerance,
+                        double& error)
+    {
+        return withinTolerance(lhs, rhs, tolerance, error);
+    }
+};
+
+template <typename T>
+struct ElementCompare<std::complex<T> >
+{
+    static bool matches(const std::complex<T>& lhs,
+                        const std::complex<T>& rhs,
+                        const cphd::CompareTolerance& tolerance,
+                        double& error)
+    {
+        double realError;
+        double imagError;
+        const bool realMatches =
+                withinTolerance(lhs.real(), rhs.real(), tolerance, realError);
+        const bool imagMatches =
+                withinTolerance(lhs.imag(), rhs.imag(), tolerance, imagError);
+        error = std::max(realError, imagError);
+        return realMatches && imagMatches;
+    }
+};
+
+template <typename T>
+void compareRange(const T* lhs,
+                  const T* rhs,
+                  size_t numElements,
+                  size_t startIndex,
+                  const cphd::CompareTolerance& tolerance,
+                  cphd::MismatchStats& stats)
+{
+    stats.numCompared += numElements;
+
+    // Identical is the common case, and memcmp is the quickest way to
+    // find that out
+    if (std::memcmp(lhs, rhs, numElements * sizeof(T)) == 0)
+    {
+        return;
+    }
+
+    for (size_t ii = 0; ii < numElements; ++ii)
+    {
+        double error;
+        if (!ElementCompare<T>::matches(lhs[ii], rhs[ii], tolerance, error))
+        {
+            stats.addMismatch(startIndex + ii, error);
+        }
+    }
+}
+
+// Each thread gets its own copy so it can keep its own stats
+template <typename T>
+class CompareChunks
+{
+public:
+    CompareChunks(const T* lhs,
+                  const T* rhs,
+                  size_t numElements,
+                  size_t startIndex,
+                  const cphd::CompareTolerance& tolerance) :
+        mLhs(lhs),
+        mRhs(rhs),
+        mNumElements(numElements),
+        mStartIndex(startIndex),
+        mTolerance(tolerance)
+    {
+    }
+
+    void operator()(size_t chunk) const
+    {
+        const size_t offset = chunk * CHUNK_SIZE;
+        compareRange(mLhs + offset,
+                     mRhs + offset,
+                     std::min(CHUNK_SIZE, mNumElements - offset),
+                     mStartIndex + offset,
+                     mTolerance,
+                     mStats);
+    }
+
+    const cphd::MismatchStats& getStats() const
+    {
+        return mStats;
+    }
+
+private:
+    const T* mLhs;
+    const T* mRhs;
+    size_t mNumElements;
+    size_t mStartIndex;
+    cphd::CompareTolerance mTolerance;
+    mutable cphd::MismatchStats mStats;
+};
+
+template <typename T>
+void compareArrays(const void* lhs,
+                   const void* rhs,
+                   size_t numElements,
+                   size_t startIndex,
+                   const cphd::CompareTolerance& tolerance,
+                   size_t numThreads,
+                   cphd::MismatchStats& stats)
+{
+    const size_t numChunks = (numElements + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    const size_t numChunkThreads =
+            std::max<size_t>(std::min(numThreads, numChunks), 1);
+
+    const std::vector<CompareChunks<T> > ops(
+            numChunkThreads,
+            CompareChunks<T>(static_cast<const T*>(lhs),
+                             static_cast<const T*>(rhs),
+                             numElements,
+                             startIndex,
+                             tolerance));
+    mt::run1D(numChunks, numChunkThreads, ops);
+
+    for (size_t ii = 0; ii < ops.size(); ++ii)
+    {
+        stats.merge(ops[ii].getStats());
+    }
+}
+
+void compareSamples(const cphd::SignalArrayFormat& format,
+                    const void* lhs,
+                    const void* rhs,
+                    size_t numElements,
+                    size_t startIndex,
+                    const cphd::CompareTolerance& tolerance,
+                    size_t numThreads,
+                    cphd::MismatchStats& stats)
+{
+    switch (format.value)
+    {
+    case cphd::SignalArrayFormat::CI2:
+        compareArrays<std::complex<sys::Int8_T> >(
+                lhs, rhs, numElements, startIndex,
+                tolerance, numThreads, stats);
+        break;
+    case cphd::SignalArrayFormat::CI4:
+        compareArrays<std::complex<sys::Int16_T> >(
+                lhs, rhs, numElements, startIndex,
+                tolerance, numThreads, stats);
+        break;
+    case cphd::SignalArrayFormat::CF8:
+        compareArrays<std::complex<float> >(
+                lhs, rhs, numElements, startIndex,
+                tolerance, numThreads, stats);
+        break;
+    default:
+        throw except::Exception(Ctxt(
+                "Unknown signal array format " + str::toString(format.value)));
+    }
+}
+
+typedef std::pair<std::string, cphd::PVPType> Parameter;
+
+void addParameter(const std::string& name,
+                  const cphd::PVPType& type,
+                  std::vector<Parameter>& parameters)
+{
+    // Optional parameters that aren't present have no offset
+    if (!six::Init::isUndefined<size_t>(type.getOffset()))
+    {
+        parameters.push_back(Parameter(name, type));
+    }
+}
+
+std::vector<Parameter> getParameters(const cphd::Pvp& pvp)
+{
+    std::vector<Parameter> parameters;
+    addParameter("TxTime", pvp.txTime, parameters);
+    addParameter("TxPos", pvp.txPos, parameters);
+    addParameter("TxVel", pvp.txVel, parameters);
+    addParameter("RcvTime", pvp.rcvTime, parameters);
+    addParameter("RcvPos", pvp.rcvPos, parameters);
+    addParameter("RcvVel", pvp.rcvVel, parameters);
+    addParameter("SRPPos", pvp.srpPos, parameters);
+    addParameter("AmpSF", pvp.ampSF, parameters);
+    addParameter("aFDOP", pvp.aFDOP, parameters);
+    addParameter("aFRR1", pvp.aFRR1, parameters);
+    addParameter("aFRR2", pvp.aFRR2, parameters);
+    addParameter("FX1", pvp.fx1, parameters);
+    addParameter("FX2", pvp.fx2, parameters);
+    addParameter("FXN1", pvp.fxN1, parameters);
+    addParameter("FXN2", pvp.fxN2, parameters);
+    addParameter("TOA1", pvp.toa1, parameters);
+    addParameter("TOA2", pvp.toa2, parameters);
+    addParameter("TOAE1", pvp.toaE1, parameters);
+    addParameter("TOAE2", pvp.toaE2, parameters);
+    addParameter("TDTropoSRP", pvp.tdTropoSRP, parameters);
+    addParameter("TDIonoSRP", pvp.tdIonoSRP, parameters);
+    addParameter("SC0", pvp.sc0, parameters);
+    addParameter("SCSS", pvp.scss, parameters);
+    addParameter("SIGNAL", pvp.signal, parameters);
+
+    for (auto it = pvp.addedPVP.begin(); it != pvp.addedPVP.end(); ++it)
+    {
+        addParameter(it->first, it->second, parameters);
+    }
+    return parameters;
+}
+
+// Compares one parameter of every vector.  Each parameter has its own
+// stats, so the parameters can be compared in parallel.
+class CompareParameter
+{
+public:
+    CompareParameter(const std::vector<Parameter>& parameters,
+                     const std::vector<sys::ubyte>& lhs,
+                     const std::vector<sys::ubyte>& rhs,
+                     size_t numBytesPerVector,
+                     const cphd::CompareTolerance& tolerance,
+                     std::vector<cphd::MismatchStats>& stats) :
+        mParameters(parameters),
+        mLhs(lhs),
+        mRhs(rhs),
+        mNumBytesPerVector(numBytesPerVector),
+        mTolerance(tolerance),
+        mStats(stats)
+    {
+    }
+
+    void operator()(size_t index) const
+    {
+        const cphd::PVPType& type = mParameters[index].second;
+        const std::string format = type.getFormat();
+
+        // The library writes every numeric parameter into 8 byte words.
+        // Floating point ones (including XYZ and complex ones) can use the
+        // tolerance; everything else has to be identical.
+        const bool isFloatingPoint = !format.empty() && format[0] != 'S' &&
+                format.find('F') != std::string::npos;
+        const cphd::CompareTolerance tolerance = isFloatingPoint ?
+                mTolerance : cphd::CompareTolerance();
+
+        cphd::MismatchStats& stats = mStats[index];
+        const size_t numVectors = mLhs.size() / mNumBytesPerVector;
+        for (size_t vector = 0; vector < numVectors; ++vector)
+        {
+            const size_t offset =
+                    vector * mNumBytesPerVector + type.getByteOffset();
+            bool matches = true;
+            double maxError = 0.0;
+            for (size_t word = 0; word < type.getSize(); ++word)
+            {
+                const size_t wordOffset =
+                        offset + word * cphd::PVPType::WORD_BYTE_SIZE;
+                double error;
+                const bool wordMatches = isFloatingPoint ?
+                        wordWithinTolerance<double>(wordOffset, tolerance,
+                                                    error) :
+                        wordWithinTolerance<sys::Int64_T>(wordOffset,
+                                                          tolerance, error);
+                matches = matches && wordMatches;
+                maxError = std::max(maxError, error);
+            }
+
+            ++stats.numCompared;
+            if (!matches)
+            {
+                stats.addMismatch(vector, maxError);
+            }
+        }
+    }
+
+private:
+    template <typename T>
+    bool wordWithinTolerance(size_t offset,
+                             const cphd::CompareTolerance& tolerance,
+                             double& error) const
+    {
+        T lhsValue;
+        T rhsValue;
+        std::memcpy(&lhsValue, &mLhs[offset], sizeof(T));
+        std::memcpy(&rhsValue, &mRhs[offset], sizeof(T));
+        return withinTolerance(lhsValue, rhsValue, tolerance, error);
+    }
+
+    const std::vector<Parameter>& mParameters;
+    const std::vector<sys::ubyte>& mLhs;
+    const std::vector<sys::ubyte>& mRhs;
+    const size_t mNumBytesPerVector;
+    const cphd::CompareTolerance mTolerance;
+    std::vector<cphd::MismatchStats>& mStats;
+};
+
+void printStats(std::ostream& os,
+                const std::string& name,
+                const cphd::MismatchStats& stats)
+{
+    os << name << ": ";
+    if (stats.matches())
+    {
+        os << stats.numCompared << " elements match\n";
+    }
+    else
+    {
+        os << stats.numMismatches << " of " << stats.numCompared
+           << " elements differ, max error " << stats.maxError
+           << ", first at " << stats.firstIndex
+           << ", last at " << stats.lastIndex << "\n";
+    }
+}
+}
+
+namespace cphd
+{
+CompareTolerance::CompareTolerance(double absolute_,
+                                   double relative_,
+                                   size_t ulps_) :
+    absolute(absolute_),
+    relative(relative_),
+    ulps(ulps_)
+{
+}
+
+MismatchStats::MismatchStats() :
+    numCompared(0),
+    numMismatches(0),
+    maxError(0.0),
+    firstIndex(0),
+    lastIndex(0)
+{
+}
+
+void MismatchStats::addMismatch(size_t index, double error)
+{
+    if (numMismatches == 0)
+    {
+        firstIndex = lastIndex = index;
+    }
+    else
+    {
+        firstIndex = std::min(firstIndex, index);
+        lastIndex = std::max(lastIndex, index);
+    }
+    ++numMismatches;
+    maxError = std::max(maxError, error);
+}
+
+void MismatchStats::merge(const MismatchStats& other)
+{
+    numCompared += other.numCompared;
+    if (other.numMismatches == 0)
+    {
+        return;
+    }
+
+    if (numMismatches == 0)
+    {
+        firstIndex = other.firstIndex;
+        lastIndex = other.lastIndex;
+    }
+    else
+    {
+        firstIndex = std::min(firstIndex, other.firstIndex);
+        lastIndex = std::max(lastIndex, other.lastIndex);
+    }
+    numMismatches += other.numMismatches;
+    maxError = std::max(maxError, other.maxError);
+}
+
+bool CPHDComparison::matches() const
+{
+    if (!differences.empty())
+    {
+        return false;
+    }
+
+    for (size_t ii = 0; ii < signal.size(); ++ii)
+    {
+        if (!signal[ii].matches())
+        {
+            return false;
+        }
+    }
+
+    for (size_t ii = 0; ii < pvp.size(); ++ii)
+    {
+        for (auto it = pvp[ii].begin(); it != pvp[ii].end(); ++it)
+        {
+            if (!it->second.matches())
+            {
+                return false;
+            }
+        }
+    }
+
+    for (auto it = support.begin(); it != support.end(); ++it)
+    {
+        if (!it->second.matches())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::ostream& operator<<(std::ostream& os, const CPHDComparison& comparison)
+{
+    for (size_t ii = 0; ii < comparison.differences.size(); ++ii)
+    {
+        os << comparison.differences[ii] << "\n";
+    }
+
+    for (size_t ii = 0; ii < comparison.pvp.size(); ++ii)
+    {
+        for (auto it = comparison.pvp[ii].begin();
+             it != comparison.pvp[ii].end();
+             ++it)
+        {
+            std::ostringstream name;
+            name << "Channel " << ii << " PVP " << it->first;
+            printStats(os, name.str(), it->second);
+        }
+    }
+
+    for (auto it = comparison.support.begin();
+         it != comparison.support.end();
+         ++it)
+    {
+        printStats(os, "Support array " + it->first, it->second);
+    }
+
+    for (size_t ii = 0; ii < comparison.signal.size(); ++ii)
+    {
+        std::ostringstream name;
+        name << "Channel " << ii << " signal";
+        printStats(os, name.str(), comparison.signal[ii]);
+    }
+    return os;
+}
+
+const size_t CPHDComparator::DEFAULT_BLOCK_SIZE = 64 * 1024 * 1024;
+
+CPHDComparator::CPHDComparator(const CompareTolerance& signalTolerance,
+                               const CompareTolerance& pvpTolerance,
+                               size_t numThreads,
+                               size_t blockSize) :
+    mSignalTolerance(signalTolerance),
+    mPVPTolerance(pvpTolerance),
+    mNumThreads(std::max<size_t>(numThreads, 1)),
+    mBlockSize(blockSize)
+{
+}
+
+CPHDComparison CPHDComparator::compare(const CPHDReader& lhs,
+                                       const CPHDReader& rhs) const
+{
+    CPHDComparison comparison;
+    const Metadata& lhsMetadata = lhs.getMetadata();
+    const Metadata& rhsMetadata = rhs.getMetadata();
+    if (lhsMetadata != rhsMetadata)
+    {
+        comparison.differences.push_back("Metadata differs");
+    }
+
+    const Data& lhsData = lhsMetadata.data;
+    const Data& rhsData = rhsMetadata.data;
+    const size_t numChannels =
+            std::min(lhsData.getNumChannels(), rhsData.getNumChannels());
+    if (lhsData.getNumChannels() != rhsData.getNumChannels())
+    {
+        std::ostringstream ostr;
+        ostr << "Files have " << lhsData.getNumChannels() << " and "
+             << rhsData.getNumChannels() << " channels. Only the first "
+             << numChannels << " are compared.";
+        comparison.differences.push_back(ostr.str());
+    }
+
+    // Channels whose vectors line up
+    std::vector<bool> sameNumVectors(numChannels);
+    for (size_t ii = 0; ii < numChannels; ++ii)
+    {
+        sameNumVectors[ii] =
+                lhsData.getNumVectors(ii) == rhsData.getNumVectors(ii);
+        if (!sameNumVectors[ii])
+        {
+            std::ostringstream ostr;
+            ostr << "Channel " << ii << " has " << lhsData.getNumVectors(ii)
+                 << " and " << rhsData.getNumVectors(ii) << " vectors";
+            comparison.differences.push_back(ostr.str());
+        }
+    }
+
+    // PVPs
+    comparison.pvp.resize(numChannels);
+    if (lhsMetadata.pvp != rhsMetadata.pvp)
+    {
+        comparison.differences.push_back(
+                "PVP layouts differ. PVPs are not compared.");
+    }
+    else
+    {
+        for (size_t ii = 0; ii < numChannels; ++ii)
+        {
+            if (sameNumVectors[ii])
+            {
+                comparison.pvp[ii] = comparePVP(lhs.getPVPBlock(),
+                                                rhs.getPVPBlock(),
+                                                lhsMetadata.pvp,
+                                                ii);
+            }
+        }
+    }
+
+    // Support arrays
+    for (auto it = lhsData.supportArrayMap.begin();
+         it != lhsData.supportArrayMap.end();
+         ++it)
+    {
+        const auto rhsIt = rhsData.supportArrayMap.find(it->first);
+        if (rhsIt == rhsData.supportArrayMap.end())
+        {
+            comparison.differences.push_back(
+                    "Support array " + it->first + " is only in the first file");
+        }
+        else if (it->second.numRows != rhsIt->second.numRows ||
+                 it->second.numCols != rhsIt->second.numCols ||
+                 it->second.bytesPerElement != rhsIt->second.bytesPerElement)
+        {
+            comparison.differences.push_back(
+                    "Support array " + it->first + " has different sizes");
+        }
+        else
+        {
+            comparison.support[it->first] = compareSupportArray(
+                    lhs.getSupportBlock(), rhs.getSupportBlock(), it->second);
+        }
+    }
+    for (auto it = rhsData.supportArrayMap.begin();
+         it != rhsData.supportArrayMap.end();
+         ++it)
+    {
+        if (lhsData.supportArrayMap.find(it->first) ==
+            lhsData.supportArrayMap.end())
+        {
+            comparison.differences.push_back(
+                    "Support array " + it->first +
+                    " is only in the second file");
+        }
+    }
+
+    // Signal data
+    if (lhsData.getSampleType() != rhsData.getSampleType())
+    {
+        comparison.differences.push_back(
+                "Signal array formats differ. Signal data is not compared.");
+        return comparison;
+    }
+    if (lhsData.getCompressionID() != rhsData.getCompressionID())
+    {
+        comparison.differences.push_back(
+                "Signal compression differs. Signal data is not compared.");
+        return comparison;
+    }
+
+    comparison.signal.resize(numChannels);
+    for (size_t ii = 0; ii < numChannels; ++ii)
+    {
+        const bool sameSize = lhsData.isCompressed() ?
+                lhsData.getCompressedSignalSize(ii) ==
+                        rhsData.getCompressedSignalSize(ii) :
+                sameNumVectors[ii] &&
+                        lhsData.getNumSamples(ii) ==
+                                rhsData.getNumSamples(ii);
+        if (sameSize)
+        {
+            comparison.signal[ii] = compareSignal(
+                    lhs.getWideband(), rhs.getWideband(), lhsData, ii);
+        }
+        else
+        {
+            std::ostringstream ostr;
+            ostr << "Channel " << ii << " signal arrays are different sizes";
+            comparison.differences.push_back(ostr.str());
+        }
+    }
+    return comparison;
+}
+
+MismatchStats CPHDComparator::compareSignal(const Wideband& lhs,
+                                            const Wideband& rhs,
+                                            const Data& data,
+                                            size_t channel) const
+{
+    MismatchStats stats;
+    if (data.isCompressed())
+    {
+        // There's no way to read part of a compressed channel
+        mem::ScopedArray<sys::ubyte> lhsData;
+        mem::ScopedArray<sys::ubyte> rhsData;
+        lhs.read(channel, lhsData);
+        rhs.read(channel, rhsData);
+        compareArrays<sys::ubyte>(lhsData.get(),
+                                  rhsData.get(),
+                                  data.getCompressedSignalSize(channel),
+                                  0,
+                                  CompareTolerance(),
+                                  mNumThreads,
+                                  stats);
+        return stats;
+    }
+
+    const size_t numVectors = data.getNumVectors(channel);
+    const size_t numSamples = data.getNumSamples(channel);
+    const size_t bytesPerVector = numSamples * data.getNumBytesPerSample();
+    if (numVectors == 0 || bytesPerVector == 0)
+    {
+        return stats;
+    }
+
+    const size_t vectorsPerBlock = std::min(
+            numVectors, std::max<size_t>(mBlockSize / bytesPerVector, 1));
+    std::vector<sys::ubyte> lhsData(vectorsPerBlock * bytesPerVector);
+    std::vector<sys::ubyte> rhsData(lhsData.size());
+
+    for (size_t firstVector = 0;
+         firstVector < numVectors;
+         firstVector += vectorsPerBlock)
+    {
+        const size_t lastVector =
+                std::min(firstVector + vectorsPerBlock, numVectors) - 1;
+        const size_t numBlockVectors = lastVector - firstVector + 1;
+        const size_t numBytes = numBlockVectors * bytesPerVector;
+
+        lhs.read(channel, firstVector, lastVector, 0, Wideband::ALL,
+                 mNumThreads,
+                 mem::BufferView<sys::ubyte>(&lhsData[0], numBytes));
+        rhs.read(channel, firstVector, lastVector, 0, Wideband::ALL,
+                 mNumThreads,
+                 mem::BufferView<sys::ubyte>(&rhsData[0], numBytes));
+
+        compareSamples(data.getSampleType(),
+                       &lhsData[0],
+                       &rhsData[0],
+                       numBlockVectors * numSamples,
+                       firstVector * numSamples,
+                       mSignalTolerance,
+                       mNumThreads,
+                       stats);
+    }
+    return stats;
+}
+
+std::map<std::string, MismatchStats>
+CPHDComparator::comparePVP(const PVPBlock& lhs,
+                           const PVPBlock& rhs,
+                           const Pvp& pvp,
+                           size_t channel) const
+{
+    std::vector<sys::ubyte> lhsData;
+    std::vector<sys::ubyte> rhsData;
+    lhs.getPVPdata(channel, lhsData);
+    rhs.getPVPdata(channel, rhsData);
+    if (lhsData.size() != rhsData.size() ||
+        lhs.getNumBytesPVPSet() != rhs.getNumBytesPVPSet())
+    {
+        throw except::Exception(Ctxt("PVP blocks are different sizes"));
+    }
+
+    const std::vector<Parameter> parameters = getParameters(pvp);
+    std::vector<MismatchStats> stats(parameters.size());
+    if (!lhsData.empty())
+    {
+        mt::run1D(parameters.size(),
+                  std::min(mNumThreads, parameters.size()),
+                  CompareParameter(parameters,
+                                   lhsData,
+                                   rhsData,
+                                   lhs.getNumBytesPVPSet(),
+                                   mPVPTolerance,
+                                   stats));
+    }
+
+    std::map<std::string, MismatchStats> results;
+    for (size_t ii = 0; ii < parameters.size(); ++ii)
+    {
+        results[parameters[ii].first] = stats[ii];
+    }
+    return results;
+}
+
+MismatchStats CPHDComparator::compareSupportArray(
+        const SupportBlock& lhs,
+        const SupportBlock& rhs,
+        const Data::SupportArray& supportArray) const
+{
+    mem::ScopedArray<sys::ubyte> lhsData;
+    mem::ScopedArray<sys::ubyte> rhsData;
+    lhs.read(supportArray.identifier, mNumThreads, lhsData);
+    rhs.read(supportArray.identifier, mNumThreads, rhsData);
+
+    // The element format isn't known here, so elements have to be
+    // identical
+    MismatchStats stats;
+    const size_t numElements = supportArray.numRows * supportArray.numCols;
+    const size_t elementSize = supportArray.bytesPerElement;
+    stats.numCompared = numElements;
+    if (std::memcmp(lhsData.get(), rhsData.get(), numElements * elementSize)
+            == 0)
+    {
+        return stats;
+    }
+
+    for (size_t ii = 0; ii < numElements; ++ii)
+    {
+        if (std::memcmp(lhsData.get() + ii * elementSize,
+                        rhsData.get() + ii * elementSize,
+                        elementSize) != 0)
+        {
+            stats.addMismatch(ii, 0.0);
+        }
+    }
+    return stats;
+}
+}
@@ -0,0 +1,83 @@
+/* =========================================================================
+ * This file is part of cphd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * cphd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <except/Exception.h>
+#include <io/FileInputStream.h>
+#include <logging/NullLogger.h>
+#include <six/XMLSubsetParser.h>
+#include <cphd/CPHDMetadataReader.h>
+#include <cphd/CPHDXMLControl.h>
+
+namespace cphd
+{
+CPHDMetadataReader::CPHDMetadataReader(
+        std::shared_ptr<io::SeekableInputStream> inStream) :
+    mInStream(inStream)
+{
+    mFileHeader.read(*mInStream);
+}
+
+CPHDMetadataReader::CPHDMetadataReader(const std::string& fromFile) :
+    mInStream(new io::FileInputStream(fromFile))
+{
+    mFileHeader.read(*mInStream);
+}
+
+std::string CPHDMetadataReader::getXML() const
+{
+    const size_t xmlSize = static_cast<size_t>(mFileHeader.getXMLBlockSize());
+    if (xmlSize == 0)
+    {
+        return std::string();
+    }
+
+    std::string xml(xmlSize, '\0');
+    mInStream->seek(mFileHeader.getXMLBlockByteOffset(), io::Seekable::START);
+    mInStream->read(&xml[0], xmlSize, true);
+    return xml;
+}
+
+std::unique_ptr<xml::lite::Document> CPHDMetadataReader::getXMLDocument(
+        const std::vector<std::string>& elementNames) const
+{
+    mInStream->seek(mFileHeader.getXMLBlockByteOffset(), io::Seekable::START);
+
+    six::XMLSubsetParser xmlParser(elementNames);
+    xmlParser.parse(*mInStream,
+                    static_cast<int>(mFileHeader.getXMLBlockSize()));
+    return std::unique_ptr<xml::lite::Document>(
+            xmlParser.releaseDocument().release());
+}
+
+std::unique_ptr<Metadata> CPHDMetadataReader::getMetadata(
+        const std::vector<std::string>& schemaPaths,
+        std::shared_ptr<logging::Logger> logger) const
+{
+    if (logger.get() == NULL)
+    {
+        logger.reset(new logging::NullLogger());
+    }
+
+    const std::unique_ptr<xml::lite::Document> doc(getXMLDocument());
+    return CPHDXMLControl(logger.get(), false).fromXML(doc.get(),
+                                                       schemaPaths);
+}
+}
@@ -21,13 +21,9 @@
  */
 #include <sys/Conf.h>
 #include <except/Exception.h>
-#include <io/StringStream.h>
 #include <io/FileInputStream.h>
-#include <logging/NullLogger.h>
-#include <mem/ScopedArray.h>
-#include <xml/lite/MinidomParser.h>
+#include <cphd/CPHDMetadataReader.h>
 #include <cphd/CPHDReader.h>
-#include <cphd/CPHDXMLControl.h>
 
 namespace cphd
 {
@@ -53,21 +49,9 @@ void CPHDReader::initialize(std::shared_ptr<io::SeekableInputStream> inStream,
                             std::shared_ptr<logging::Logger> logger,
                             const std::vector<std::string>& schemaPaths)
 {
-    mFileHeader.read(*inStream);
-
-    // Read in the XML string
-    inStream->seek(mFileHeader.getXMLBlockByteOffset(), io::Seekable::START);
-
-    xml::lite::MinidomParser xmlParser;
-    xmlParser.preserveCharacterData(true);
-    xmlParser.parse(*inStream, mFileHeader.getXMLBlockSize());
-
-    if (logger.get() == NULL)
-    {
-        logger.reset(new logging::NullLogger());
-    }
-
-    mMetadata = CPHDXMLControl(logger.get(), false).fromXML(xmlParser.getDocument(), schemaPaths);
+    const CPHDMetadataReader metadataReader(inStream);
+    mFileHeader = metadataReader.getFileHeader();
+    mMetadata = metadataReader.getMetadata(schemaPaths, logger);
 
     mSupportBlock.reset(new SupportBlock(inStream, mMetadata->data,
                         mFileHeader.getSupportBlockByteOffset(),
@@ -0,0 +1,539 @@
+/* =========================================================================
+ * This file is part of cphd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * cphd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <set>
+#include <sstream>
+
+#include <except/Exception.h>
+#include <io/FileInputStream.h>
+#include <io/FileOutputStream.h>
+#include <cphd/CPHDMetadataReader.h>
+#include <cphd/CPHDSubsetWriter.h>
+#include <cphd/CPHDXMLControl.h>
+
+namespace
+{
+// PVPs are big endian doubles in the file
+double getWord(const sys::ubyte* data)
+{
+    double value;
+    std::memcpy(&value, data, sizeof(value));
+    return sys::isBigEndianSystem() ? value : sys::byteSwap(value);
+}
+
+void setWord(double value, sys::ubyte* data)
+{
+    if (!sys::isBigEndianSystem())
+    {
+        value = sys::byteSwap(value);
+    }
+    std::memcpy(data, &value, sizeof(value));
+}
+
+void readFully(io::SeekableInputStream& inStream,
+               sys::ubyte* data,
+               size_t numBytes)
+{
+    inStream.read(reinterpret_cast<sys::byte*>(data), numBytes, true);
+}
+}
+
+namespace cphd
+{
+const size_t ChannelSubset::ALL = std::numeric_limits<size_t>::max();
+
+ChannelSubset::ChannelSubset(size_t channel_,
+                             size_t firstVector_,
+                             size_t lastVector_,
+                             size_t firstSample_,
+                             size_t lastSample_) :
+    channel(channel_),
+    firstVector(firstVector_),
+    lastVector(lastVector_),
+    firstSample(firstSample_),
+    lastSample(lastSample_)
+{
+}
+
+// What the kept PVPs of a channel span
+struct CPHDSubsetWriter::ChannelSummary
+{
+    ChannelSummary() :
+        fx1(std::numeric_limits<double>::max()),
+        fx2(-std::numeric_limits<double>::max()),
+        toa1(std::numeric_limits<double>::max()),
+        toa2(-std::numeric_limits<double>::max()),
+        txTime1(std::numeric_limits<double>::max()),
+        txTime2(-std::numeric_limits<double>::max())
+    {
+    }
+
+    void merge(const ChannelSummary& other)
+    {
+        fx1 = std::min(fx1, other.fx1);
+        fx2 = std::max(fx2, other.fx2);
+        toa1 = std::min(toa1, other.toa1);
+        toa2 = std::max(toa2, other.toa2);
+        txTime1 = std::min(txTime1, other.txTime1);
+        txTime2 = std::max(txTime2, other.txTime2);
+    }
+
+    double fx1;
+    double fx2;
+    double toa1;
+    double toa2;
+    double txTime1;
+    double txTime2;
+};
+
+const size_t CPHDSubsetWriter::DEFAULT_BLOCK_SIZE = 64 * 1024 * 1024;
+
+CPHDSubsetWriter::CPHDSubsetWriter(
+        std::shared_ptr<io::SeekableInputStream> inStream,
+        const std::vector<std::string>& schemaPaths,
+        size_t blockSize) :
+    mInStream(inStream),
+    mSchemaPaths(schemaPaths),
+    mBlockSize(std::max<size_t>(blockSize, 1))
+{
+    const CPHDMetadataReader reader(mInStream);
+    mHeader = reader.getFileHeader();
+    mMetadata = reader.getMetadata(mSchemaPaths);
+}
+
+CPHDSubsetWriter::CPHDSubsetWriter(
+        const std::string& inPathname,
+        const std::vector<std::string>& schemaPaths,
+        size_t blockSize) :
+    mInStream(new io::FileInputStream(inPathname)),
+    mSchemaPaths(schemaPaths),
+    mBlockSize(std::max<size_t>(blockSize, 1))
+{
+    const CPHDMetadataReader reader(mInStream);
+    mHeader = reader.getFileHeader();
+    mMetadata = reader.getMetadata(mSchemaPaths);
+}
+
+std::vector<ChannelSubset> CPHDSubsetWriter::resolve(
+        const std::vector<ChannelSubset>& subsets) const
+{
+    if (subsets.empty())
+    {
+        throw except::Exception(Ctxt("No channels to keep"));
+    }
+
+    const Data& data = mMetadata->data;
+    std::vector<ChannelSubset> resolved(subsets);
+    std::set<size_t> channels;
+    for (size_t ii = 0; ii < resolved.size(); ++ii)
+    {
+        ChannelSubset& subset = resolved[ii];
+        if (subset.channel >= data.getNumChannels())
+        {
+            std::ostringstream ostr;
+            ostr << "Invalid channel " << subset.channel;
+            throw except::Exception(Ctxt(ostr.str()));
+        }
+        if (!channels.insert(subset.channel).second)
+        {
+            std::ostringstream ostr;
+            ostr << "Channel " << subset.channel << " is repeated";
+            throw except::Exception(Ctxt(ostr.str()));
+        }
+
+        const size_t numVectors = data.getNumVectors(subset.channel);
+        const size_t numSamples = data.getNumSamples(subset.channel);
+        if (subset.lastVector == ChannelSubset::ALL)
+        {
+            subset.lastVector = numVectors - 1;
+        }
+        if (subset.lastSample == ChannelSubset::ALL)
+        {
+            subset.lastSample = numSamples - 1;
+        }
+
+        if (subset.firstVector > subset.lastVector ||
+            subset.lastVector >= numVectors ||
+            subset.firstSample > subset.lastSample ||
+            subset.lastSample >= numSamples)
+        {
+            std::ostringstream ostr;
+            ostr << "Invalid vector or sample range for channel "
+                 << subset.channel;
+            throw except::Exception(Ctxt(ostr.str()));
+        }
+
+        if (data.isCompressed() &&
+            (subset.firstVector != 0 || subset.lastVector != numVectors - 1 ||
+             subset.firstSample != 0 || subset.lastSample != numSamples - 1))
+        {
+            throw except::Exception(Ctxt(
+                    "Compressed signal arrays can only be subset by channel"));
+        }
+    }
+    return resolved;
+}
+
+sys::Off_T CPHDSubsetWriter::getPVPOffset(size_t channel) const
+{
+    // Arrays are stored in channel order, as CPHDWriter writes them
+    sys::Off_T offset = mHeader.getPvpBlockByteOffset();
+    for (size_t ii = 0; ii < channel; ++ii)
+    {
+        offset += static_cast<sys::Off_T>(mMetadata->data.getNumVectors(ii)) *
+                mMetadata->data.getNumBytesPVPSet();
+    }
+    return offset;
+}
+
+sys::Off_T CPHDSubsetWriter::getSignalOffset(size_t channel) const
+{
+    const Data& data = mMetadata->data;
+    sys::Off_T offset = mHeader.getSignalBlockByteOffset();
+    for (size_t ii = 0; ii < channel; ++ii)
+    {
+        offset += data.isCompressed() ?
+                static_cast<sys::Off_T>(data.getCompressedSignalSize(ii)) :
+                static_cast<sys::Off_T>(data.getNumVectors(ii)) *
+                        data.getNumSamples(ii) * data.getNumBytesPerSample();
+    }
+    return offset;
+}
+
+CPHDSubsetWriter::ChannelSummary
+CPHDSubsetWriter::updatePVPs(const ChannelSubset& subset,
+                             io::OutputStream* outStream) const
+{
+    const Pvp& pvp = mMetadata->pvp;
+    const bool isFX = mMetadata->global.getDomainType() == DomainType::FX;
+    const size_t numBytesPerVector = mMetadata->data.getNumBytesPVPSet();
+    const size_t numVectors = subset.lastVector - subset.firstVector + 1;
+    const size_t numSamples = subset.lastSample - subset.firstSample + 1;
+    const bool subsetSamples = subset.firstSample != 0 ||
+            numSamples != mMetadata->data.getNumSamples(subset.channel);
+
+    const size_t vectorsPerBlock = std::min(
+            numVectors,
+            std::max<size_t>(mBlockSize / numBytesPerVector, 1));
+    std::vector<sys::ubyte> buffer(vectorsPerBlock * numBytesPerVector);
+
+    mInStream->seek(getPVPOffset(subset.channel) +
+                            static_cast<sys::Off_T>(subset.firstVector) *
+                                    numBytesPerVector,
+                    io::Seekable::START);
+
+    ChannelSummary summary;
+    for (size_t done = 0; done < numVectors; done += vectorsPerBlock)
+    {
+        const size_t numBlockVectors =
+                std::min(vectorsPerBlock, numVectors - done);
+        readFully(*mInStream, &buffer[0], numBlockVectors * numBytesPerVector);
+
+        for (size_t ii = 0; ii < numBlockVectors; ++ii)
+        {
+            sys::ubyte* const vector = &buffer[ii * numBytesPerVector];
+            double fx1 = getWord(vector + pvp.fx1.getByteOffset());
+            double fx2 = getWord(vector + pvp.fx2.getByteOffset());
+            double toa1 = getWord(vector + pvp.toa1.getByteOffset());
+            double toa2 = getWord(vector + pvp.toa2.getByteOffset());
+
+            if (subsetSamples)
+            {
+                // Move the first sample and clip the saved band or swath
+                // to the samples that are left
+                const double scss = getWord(vector + pvp.scss.getByteOffset());
+                const double sc0 = getWord(vector + pvp.sc0.getByteOffset()) +
+                        subset.firstSample * scss;
+                const double scEnd = sc0 + (numSamples - 1) * scss;
+                const double low = std::min(sc0, scEnd);
+                const double high = std::max(sc0, scEnd);
+                setWord(sc0, vector + pvp.sc0.getByteOffset());
+
+                if (isFX)
+                {
+                    fx1 = std::max(fx1, low);
+                    fx2 = std::min(fx2, high);
+                    setWord(fx1, vector + pvp.fx1.getByteOffset());
+                    setWord(fx2, vector + pvp.fx2.getByteOffset());
+                }
+                else
+                {
+                    toa1 = std::max(toa1, low);
+                    toa2 = std::min(toa2, high);
+                    setWord(toa1, vector + pvp.toa1.getByteOffset());
+                    setWord(toa2, vector + pvp.toa2.getByteOffset());
+                }
+            }
+
+            const double txTime = getWord(vector + pvp.txTime.getByteOffset());
+            summary.fx1 = std::min(summary.fx1, fx1);
+            summary.fx2 = std::max(summary.fx2, fx2);
+            summary.toa1 = std::min(summary.toa1, toa1);
+            summary.toa2 = std::max(summary.toa2, toa2);
+            summary.txTime1 = std::min(summary.txTime1, txTime);
+            summary.txTime2 = std::max(summary.txTime2, txTime);
+        }
+
+        if (outStream)
+        {
+            outStream->write(reinterpret_cast<const sys::byte*>(&buffer[0]),
+                             numBlockVectors * numBytesPerVector);
+        }
+    }
+    return summary;
+}
+
+std::unique_ptr<Metadata> CPHDSubsetWriter::createMetadata(
+        const std::vector<ChannelSubset>& subsets) const
+{
+    const Data& inData = mMetadata->data;
+    const std::vector<ChannelParameter>& inParameters =
+            mMetadata->channel.parameters;
+
+    std::unique_ptr<Metadata> metadata(new Metadata(*mMetadata));
+    Data& data = metadata->data;
+    data.channels.clear();
+    metadata->channel.parameters.clear();
+
+    bool isChanged = subsets.size() != inData.getNumChannels();
+    ChannelSummary globalSummary;
+    size_t signalOffset = 0;
+    size_t pvpOffset = 0;
+    for (size_t ii = 0; ii < subsets.size(); ++ii)
+    {
+        const ChannelSubset& subset = subsets[ii];
+        const Data::Channel& inChannel = inData.channels[subset.channel];
+        const size_t numVectors = subset.lastVector - subset.firstVector + 1;
+        const size_t numSamples = subset.lastSample - subset.firstSample + 1;
+
+        Data::Channel channel(numVectors, numSamples, signalOffset, pvpOffset,
+                              inChannel.compressedSignalSize);
+        channel.identifier = inChannel.identifier;
+        data.channels.push_back(channel);
+        signalOffset += data.isCompressed() ?
+                inChannel.compressedSignalSize :
+                numVectors * numSamples * data.getNumBytesPerSample();
+        pvpOffset += numVectors * data.getNumBytesPVPSet();
+
+        const ChannelSummary summary = updatePVPs(subset, NULL);
+        globalSummary.merge(summary);
+
+        if (subset.channel >= inParameters.size())
+        {
+            continue;
+        }
+        ChannelParameter parameter = inParameters[subset.channel];
+
+        // The values computed from all vectors only need to change if
+        // vectors or samples were dropped
+        if (numVectors != inChannel.getNumVectors() ||
+            numSamples != inChannel.getNumSamples())
+        {
+            isChanged = true;
+            parameter.refVectorIndex = std::min(
+                    std::max(parameter.refVectorIndex, subset.firstVector),
+                    subset.lastVector) - subset.firstVector;
+            parameter.fxC = (summary.fx1 + summary.fx2) / 2;
+            parameter.fxBW = summary.fx2 - summary.fx1;
+            parameter.toaSaved = summary.toa2 - summary.toa1;
+        }
+        metadata->channel.parameters.push_back(parameter);
+    }
+
+    // The reference channel has to be one that's kept
+    const std::vector<ChannelParameter>& parameters =
+            metadata->channel.parameters;
+    bool hasRefChannel = false;
+    for (size_t ii = 0; ii < parameters.size(); ++ii)
+    {
+        hasRefChannel = hasRefChannel ||
+                parameters[ii].identifier == metadata->channel.refChId;
+    }
+    if (!hasRefChannel && !parameters.empty())
+    {
+        metadata->channel.refChId = parameters[0].identifier;
+    }
+
+    if (isChanged)
+    {
+        Global& global = metadata->global;
+        global.timeline.txTime1 = globalSummary.txTime1;
+        global.timeline.txTime2 = globalSummary.txTime2;
+        global.fxBand.fxMin = globalSummary.fx1;
+        global.fxBand.fxMax = globalSummary.fx2;
+        global.toaSwath.toaMin = globalSummary.toa1;
+        global.toaSwath.toaMax = globalSummary.toa2;
+    }
+    return metadata;
+}
+
+std::unique_ptr<Metadata> CPHDSubsetWriter::getSubsetMetadata(
+        const std::vector<ChannelSubset>& subsets) const
+{
+    return createMetadata(resolve(subsets));
+}
+
+void CPHDSubsetWriter::copy(sys::Off_T offset,
+                            sys::Off_T numBytes,
+                            std::vector<sys::ubyte>& buffer,
+                            io::OutputStream& outStream) const
+{
+    buffer.resize(static_cast<size_t>(
+            std::min<sys::Off_T>(numBytes, mBlockSize)));
+    mInStream->seek(offset, io::Seekable::START);
+    while (numBytes > 0)
+    {
+        const size_t numBlockBytes = static_cast<size_t>(
+                std::min<sys::Off_T>(numBytes, buffer.size()));
+        readFully(*mInStream, &buffer[0], numBlockBytes);
+        outStream.write(reinterpret_cast<const sys::byte*>(&buffer[0]),
+                        numBlockBytes);
+        numBytes -= numBlockBytes;
+    }
+}
+
+void CPHDSubsetWriter::writeSignal(const ChannelSubset& subset,
+                                   std::vector<sys::ubyte>& buffer,
+                                   io::OutputStream& outStream) const
+{
+    const Data& data = mMetadata->data;
+    const sys::Off_T channelOffset = getSignalOffset(subset.channel);
+    if (data.isCompressed())
+    {
+        copy(channelOffset, data.getCompressedSignalSize(subset.channel),
+             buffer, outStream);
+        return;
+    }
+
+    const size_t elementSize = data.getNumBytesPerSample();
+    const size_t numVectors = subset.lastVector - subset.firstVector + 1;
+    const size_t inBytesPerVector =
+            data.getNumSamples(subset.channel) * elementSize;
+    const size_t outBytesPerVector =
+            (subset.lastSample - subset.firstSample + 1) * elementSize;
+    const sys::Off_T offset = channelOffset +
+            static_cast<sys::Off_T>(subset.firstVector) * inBytesPerVector;
+
+    if (inBytesPerVector == outBytesPerVector)
+    {
+        // The vectors are contiguous
+        copy(offset, static_cast<sys::Off_T>(numVectors) * inBytesPerVector,
+             buffer, outStream);
+        return;
+    }
+
+    // Read whole vectors so the reads stay sequential, then pack the kept
+    // samples together in place
+    const size_t vectorsPerBlock = std::min(
+            numVectors, std::max<size_t>(mBlockSize / inBytesPerVector, 1));
+    buffer.resize(vectorsPerBlock * inBytesPerVector);
+    mInStream->seek(offset, io::Seekable::START);
+    for (size_t done = 0; done < numVectors; done += vectorsPerBlock)
+    {
+        const size_t numBlockVectors =
+                std::min(vectorsPerBlock, numVectors - done);
+        readFully(*mInStream, &buffer[0], numBlockVectors * inBytesPerVector);
+        for (size_t ii = 0; ii < numBlockVectors; ++ii)
+        {
+            std::memmove(&buffer[ii * outBytesPerVector],
+                         &buffer[ii * inBytesPerVector +
+                                 subset.firstSample * elementSize],
+                         outBytesPerVector);
+        }
+        outStream.write(reinterpret_cast<const sys::byte*>(&buffer[0]),
+                        numBlockVectors * outBytesPerVector);
+    }
+}
+
+void CPHDSubsetWriter::write(const std::vector<ChannelSubset>& subsets,
+                             io::OutputStream& outStream) const
+{
+    const std::vector<ChannelSubset> resolved = resolve(subsets);
+    const std::unique_ptr<Metadata> metadata = createMetadata(resolved);
+    const Data& data = metadata->data;
+
+    sys::Off_T pvpSize = 0;
+    sys::Off_T signalSize = 0;
+    for (size_t ii = 0; ii < data.getNumChannels(); ++ii)
+    {
+        pvpSize += static_cast<sys::Off_T>(data.getNumVectors(ii)) *
+                data.getNumBytesPVPSet();
+        signalSize += data.isCompressed() ?
+                static_cast<sys::Off_T>(data.getCompressedSignalSize(ii)) :
+                static_cast<sys::Off_T>(data.getNumVectors(ii)) *
+                        data.getNumSamples(ii) * data.getNumBytesPerSample();
+    }
+
+    const std::string xml =
+            CPHDXMLControl().toXMLString(*metadata, mSchemaPaths);
+    FileHeader header;
+    header.setVersion(mHeader.getVersion());
+    header.setClassification(mHeader.getClassification());
+    header.setReleaseInfo(mHeader.getReleaseInfo());
+    header.set(xml.size(), mHeader.getSupportBlockSize(), pvpSize,
+               signalSize);
+
+    const std::string headerString = header.toString();
+    outStream.write(headerString.c_str(), headerString.size());
+    outStream.write("\f\n", 2);
+    outStream.write(xml.c_str(), xml.size());
+    outStream.write("\f\n", 2);
+
+    // The support block is kept as is
+    std::vector<sys::ubyte> buffer;
+    if (mHeader.getSupportBlockSize() > 0)
+    {
+        copy(mHeader.getSupportBlockByteOffset(),
+             mHeader.getSupportBlockSize(),
+             buffer,
+             outStream);
+    }
+
+    const std::vector<sys::byte> padding(
+            static_cast<size_t>(header.getPvpPadBytes()), 0);
+    if (!padding.empty())
+    {
+        outStream.write(&padding[0], padding.size());
+    }
+
+    for (size_t ii = 0; ii < resolved.size(); ++ii)
+    {
+        updatePVPs(resolved[ii], &outStream);
+    }
+
+    for (size_t ii = 0; ii < resolved.size(); ++ii)
+    {
+        writeSignal(resolved[ii], buffer, outStream);
+    }
+}
+
+void CPHDSubsetWriter::write(const std::vector<ChannelSubset>& subsets,
+                             const std::string& outPathname) const
+{
+    io::FileOutputStream outStream(outPathname);
+    write(subsets, outStream);
+    outStream.close();
+}
+}
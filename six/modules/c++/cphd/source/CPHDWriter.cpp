@@ -23,9 +23,17 @@
 #include <cphd/CPHDWriter.h>
 #include <cphd/CPHDXMLControl.h>
 #include <cphd/FileHeader.h>
+#include <cphd/SignalCodec.h>
 #include <cphd/Utilities.h>
 #include <cphd/Wideband.h>
 #include <except/Exception.h>
+#include <six/Instrumentation.h>
+
+namespace
+{
+const size_t WRITE_POINT =
+        six::Instrumentation::registerPoint("cphd::DataWriter");
+}
 
 namespace cphd
 {
@@ -56,6 +64,7 @@ void DataWriterLittleEndian::operator()(const sys::ubyte* data,
 {
     size_t dataProcessed = 0;
     const size_t dataSize = numElements * elementSize;
+    six::InstrumentationTimer timer(WRITE_POINT, dataSize);
     while (dataProcessed < dataSize)
     {
         const size_t dataToProcess =
@@ -84,6 +93,7 @@ void DataWriterBigEndian::operator()(const sys::ubyte* data,
                                      size_t numElements,
                                      size_t elementSize)
 {
+    six::InstrumentationTimer timer(WRITE_POINT, numElements * elementSize);
     mStream->write(reinterpret_cast<const sys::byte*>(data),
                    numElements * elementSize);
 }
@@ -142,24 +152,25 @@ CPHDWriter::CPHDWriter(const Metadata& metadata,
     }
 }
 
-void CPHDWriter::writeMetadata(size_t supportSize,
+void CPHDWriter::writeMetadata(const Metadata& metadata,
+                               size_t supportSize,
                                size_t pvpSize,
                                size_t cphdSize)
 {
     const std::string xmlMetadata(
-            CPHDXMLControl().toXMLString(mMetadata, mSchemaPaths));
+            CPHDXMLControl().toXMLString(metadata, mSchemaPaths));
 
     // update header version, or remains default if unset
-    mHeader.setVersion(mMetadata.getVersion());
+    mHeader.setVersion(metadata.getVersion());
 
     // update classification and release info
     if (!six::Init::isUndefined(
-                mMetadata.collectionID.getClassificationLevel()) &&
-        !six::Init::isUndefined(mMetadata.collectionID.releaseInfo))
+                metadata.collectionID.getClassificationLevel()) &&
+        !six::Init::isUndefined(metadata.collectionID.releaseInfo))
     {
         mHeader.setClassification(
-                mMetadata.collectionID.getClassificationLevel());
-        mHeader.setReleaseInfo(mMetadata.collectionID.releaseInfo);
+                metadata.collectionID.getClassificationLevel());
+        mHeader.setReleaseInfo(metadata.collectionID.releaseInfo);
     }
     else
     {
@@ -261,26 +272,122 @@ template void CPHDWriter::write<std::complex<float>>(
         const std::complex<float>* widebandData,
         const sys::ubyte* supportData);
 
+template <typename T>
+void CPHDWriter::writeCompressed(const PVPBlock& pvpBlock,
+                                 const T* widebandData,
+                                 const sys::ubyte* supportData,
+                                 size_t vectorsPerBlock)
+{
+    const SignalCodec* const codec =
+            SignalCodecFactory::getInstance().getCodec(
+                    mMetadata.data.signalCompressionID);
+    if (codec == nullptr)
+    {
+        throw except::Exception(Ctxt(
+                "No codec is registered for signal compression ID '" +
+                mMetadata.data.signalCompressionID + "'"));
+    }
+    if (mElementSize != sizeof(T))
+    {
+        throw except::Exception(
+                Ctxt("Incorrect buffer data type used for metadata!"));
+    }
+
+    // The header and XML need the compressed sizes, so compress every
+    // channel before writing anything.  The blocks hold the file's big
+    // endian samples.
+    const size_t numThreads =
+            mNumThreads == 0 ? sys::OS().getNumCPUs() : mNumThreads;
+    const bool swap = !sys::isBigEndianSystem() && mElementSize > 2;
+    Metadata metadata(mMetadata);
+    const size_t numChannels = metadata.data.getNumChannels();
+    std::vector<std::vector<sys::ubyte> > compressed(numChannels);
+    std::vector<sys::ubyte> swapped;
+    const sys::ubyte* signal =
+            reinterpret_cast<const sys::ubyte*>(widebandData);
+    for (size_t ii = 0; ii < numChannels; ++ii)
+    {
+        const size_t numVectors = metadata.data.getNumVectors(ii);
+        const size_t numSamples = metadata.data.getNumSamples(ii);
+        const size_t numBytes = numVectors * numSamples * mElementSize;
+        const sys::ubyte* channelSignal = signal;
+        if (swap && numBytes != 0)
+        {
+            swapped.assign(signal, signal + numBytes);
+            cphd::byteSwap(&swapped[0], mElementSize / 2,
+                           numVectors * numSamples * 2, numThreads);
+            channelSignal = &swapped[0];
+        }
+        CompressedSignal::compress(*codec, channelSignal, numVectors,
+                                   numSamples, mElementSize, vectorsPerBlock,
+                                   numThreads, compressed[ii]);
+        metadata.data.channels[ii].compressedSignalSize =
+                compressed[ii].size();
+        signal += numBytes;
+    }
+
+    writeMetadata(metadata, pvpBlock);
+    if (metadata.data.getNumSupportArrays() != 0)
+    {
+        if (supportData == nullptr)
+        {
+            throw except::Exception(Ctxt("SupportData is not provided"));
+        }
+        writeSupportData(supportData);
+    }
+    writePVPData(pvpBlock);
+
+    for (size_t ii = 0; ii < numChannels; ++ii)
+    {
+        mStream->write(reinterpret_cast<const sys::byte*>(&compressed[ii][0]),
+                       compressed[ii].size());
+    }
+}
+
+template void CPHDWriter::writeCompressed<std::complex<sys::Int8_T>>(
+        const PVPBlock& pvpBlock,
+        const std::complex<sys::Int8_T>* widebandData,
+        const sys::ubyte* supportData,
+        size_t vectorsPerBlock);
+
+template void CPHDWriter::writeCompressed<std::complex<sys::Int16_T>>(
+        const PVPBlock& pvpBlock,
+        const std::complex<sys::Int16_T>* widebandData,
+        const sys::ubyte* supportData,
+        size_t vectorsPerBlock);
+
+template void CPHDWriter::writeCompressed<std::complex<float>>(
+        const PVPBlock& pvpBlock,
+        const std::complex<float>* widebandData,
+        const sys::ubyte* supportData,
+        size_t vectorsPerBlock);
+
 void CPHDWriter::writeMetadata(const PVPBlock& pvpBlock)
+{
+    writeMetadata(mMetadata, pvpBlock);
+}
+
+void CPHDWriter::writeMetadata(const Metadata& metadata,
+                               const PVPBlock& pvpBlock)
 {
     // Update the number of bytes per PVP
-    if (mMetadata.data.numBytesPVP != pvpBlock.getNumBytesPVPSet())
+    if (metadata.data.numBytesPVP != pvpBlock.getNumBytesPVPSet())
     {
         std::ostringstream ostr;
         ostr << "Number of pvp block bytes in metadata: "
-             << mMetadata.data.numBytesPVP
+             << metadata.data.numBytesPVP
              << " does not match calculated size of pvp block: "
              << pvpBlock.getNumBytesPVPSet();
         throw except::Exception(ostr.str());
     }
 
-    const size_t numChannels = mMetadata.data.getNumChannels();
+    const size_t numChannels = metadata.data.getNumChannels();
     size_t totalSupportSize = 0;
     size_t totalPVPSize = 0;
     size_t totalCPHDSize = 0;
 
-    for (auto it = mMetadata.data.supportArrayMap.begin();
-         it != mMetadata.data.supportArrayMap.end();
+    for (auto it = metadata.data.supportArrayMap.begin();
+         it != metadata.data.supportArrayMap.end();
          ++it)
     {
         totalSupportSize += it->second.getSize();
@@ -289,11 +396,13 @@ void CPHDWriter::writeMetadata(const PVPBlock& pvpBlock)
     for (size_t ii = 0; ii < numChannels; ++ii)
     {
         totalPVPSize += pvpBlock.getPVPsize(ii);
-        totalCPHDSize += mMetadata.data.getNumVectors(ii) *
-                mMetadata.data.getNumSamples(ii) * mElementSize;
+        totalCPHDSize += metadata.data.isCompressed() ?
+                metadata.data.getCompressedSignalSize(ii) :
+                metadata.data.getNumVectors(ii) *
+                        metadata.data.getNumSamples(ii) * mElementSize;
     }
 
-    writeMetadata(totalSupportSize, totalPVPSize, totalCPHDSize);
+    writeMetadata(metadata, totalSupportSize, totalPVPSize, totalCPHDSize);
 }
 
 void CPHDWriter::writePVPData(const PVPBlock& pvpBlock)
@@ -85,12 +85,28 @@ std::string CPHDXMLControl::toXMLString(
         const std::vector<std::string>& schemaPaths,
         bool prettyPrint)
 {
-    std::unique_ptr<xml::lite::Document> doc(toXML(metadata, schemaPaths));
+    const std::string prettyFormatter = "    ";
     io::StringStream ss;
-    (prettyPrint) ?
-            doc->getRootElement()->prettyPrint(ss) :
-            doc->getRootElement()->print(ss);
-    return ss.stream().str();
+    six::XMLStreamWriter writer(ss, prettyPrint ? prettyFormatter : "");
+
+    // Validate a pretty-printed copy, as six::XMLControl::validate() does
+    io::StringStream prettyStream;
+    const bool validate = !schemaPaths.empty();
+    if (validate && !prettyPrint)
+    {
+        writer.addOutput(prettyStream, prettyFormatter);
+    }
+
+    toXMLImpl(metadata, writer);
+    const std::string xml = ss.stream().str();
+
+    if (validate)
+    {
+        six::XMLControl::validate(
+                prettyPrint ? xml : prettyStream.stream().str(),
+                writer.getRootURI(), schemaPaths, mLog);
+    }
+    return xml;
 }
 
 std::unique_ptr<xml::lite::Document> CPHDXMLControl::toXML(
@@ -107,15 +123,20 @@ std::unique_ptr<xml::lite::Document> CPHDXMLControl::toXML(
 
 std::unique_ptr<xml::lite::Document> CPHDXMLControl::toXMLImpl(const Metadata& metadata)
 {
-    if (VERSION_URI_MAP.find(metadata.getVersion()) != VERSION_URI_MAP.end())
-    {
-        return getParser(VERSION_URI_MAP.find(metadata.getVersion())->second)->toXML(metadata);
-    }
-    std::ostringstream ostr;
-    ostr << "The version " << metadata.getVersion() << " is invalid. "
-         << "Check if version is valid or "
-         << "add a <version, URI> entry to VERSION_URI_MAP";
-    throw except::Exception(Ctxt(ostr.str()));
+    return getParser(versionToURI(metadata.getVersion()))->toXML(metadata);
+}
+
+void CPHDXMLControl::toXMLImpl(const Metadata& metadata,
+                               six::XMLStreamWriter& writer)
+{
+    std::unique_ptr<CPHDXMLParser> parser =
+            getParser(versionToURI(metadata.getVersion()));
+    parser->setXMLWriter(&writer);
+
+    // The document only holds the root, which the writer needs until it's
+    // closed
+    const std::unique_ptr<xml::lite::Document> doc = parser->toXML(metadata);
+    writer.close();
 }
 
 /* FROM XML */
@@ -154,6 +175,20 @@ CPHDXMLControl::getParser(const std::string& uri) const
     return parser;
 }
 
+std::string CPHDXMLControl::versionToURI(const std::string& version) const
+{
+    const auto it = VERSION_URI_MAP.find(version);
+    if (it != VERSION_URI_MAP.end())
+    {
+        return it->second;
+    }
+    std::ostringstream ostr;
+    ostr << "The version " << version << " is invalid. "
+         << "Check if version is valid or "
+         << "add a <version, URI> entry to VERSION_URI_MAP";
+    throw except::Exception(Ctxt(ostr.str()));
+}
+
 std::string CPHDXMLControl::uriToVersion(const std::string& uri) const
 {
     for (auto it = VERSION_URI_MAP.begin(); it != VERSION_URI_MAP.end(); ++it)
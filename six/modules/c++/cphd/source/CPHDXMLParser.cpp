@@ -52,6 +52,12 @@ CPHDXMLParser::CPHDXMLParser(
 {
 }
 
+void CPHDXMLParser::setXMLWriter(six::XMLStreamWriter* writer)
+{
+    six::XMLParser::setXMLWriter(writer);
+    mCommon.setXMLWriter(writer);
+}
+
 /*
  * TO XML
  */
@@ -60,7 +66,7 @@ std::unique_ptr<xml::lite::Document> CPHDXMLParser::toXML(
 {
     std::unique_ptr<xml::lite::Document> doc(new xml::lite::Document());
 
-    XMLElem root = newElement("CPHD");
+    XMLElem root = createElement("CPHD");
     doc->setRootElement(root);
 
     toXML(metadata.collectionID, root);
@@ -100,14 +106,14 @@ std::unique_ptr<xml::lite::Document> CPHDXMLParser::toXML(
         toXML(*(metadata.matchInfo), root);
     }
     //set the XMLNS
-    root->setNamespacePrefix("", getDefaultURI());
+    setNamespacePrefixes(root);
 
     return doc;
 }
 
 XMLElem CPHDXMLParser::toXML(const CollectionInformation& collectionID, XMLElem parent)
 {
-    XMLElem collectionXML = newElement("CollectionID", parent);
+    XMLElem collectionXML = createElement("CollectionID", parent);
 
     createString("CollectorName", collectionID.collectorName, collectionXML);
     if(!six::Init::isUndefined(collectionID.illuminatorName))
@@ -118,7 +124,7 @@ XMLElem CPHDXMLParser::toXML(const CollectionInformation& collectionID, XMLElem
     createString("CollectType", collectionID.collectType, collectionXML);
 
     // RadarMode
-    XMLElem radarModeXML = newElement("RadarMode", collectionXML);
+    XMLElem radarModeXML = createElement("RadarMode", collectionXML);
     createString("ModeType", collectionID.radarMode.toString(), radarModeXML);
     if(!six::Init::isUndefined(collectionID.radarModeID))
     {
@@ -137,12 +143,12 @@ XMLElem CPHDXMLParser::toXML(const CollectionInformation& collectionID, XMLElem
 
 XMLElem CPHDXMLParser::toXML(const Global& global, XMLElem parent)
 {
-    XMLElem globalXML = newElement("Global", parent);
+    XMLElem globalXML = createElement("Global", parent);
     createString("DomainType", global.domainType, globalXML);
     createString("SGN", global.sgn.toString(), globalXML);
 
     //Timeline
-    XMLElem timelineXML = newElement("Timeline", globalXML);
+    XMLElem timelineXML = createElement("Timeline", globalXML);
     createDateTime("CollectionStart", global.timeline.collectionStart, timelineXML);
     if (!six::Init::isUndefined(global.timeline.rcvCollectionStart))
     {
@@ -151,23 +157,23 @@ XMLElem CPHDXMLParser::toXML(const Global& global, XMLElem parent)
     createDouble("TxTime1", global.timeline.txTime1, timelineXML);
     createDouble("TxTime2", global.timeline.txTime2, timelineXML);
 
-    XMLElem fxBandXML = newElement("FxBand", globalXML);
+    XMLElem fxBandXML = createElement("FxBand", globalXML);
     createDouble("FxMin", global.fxBand.fxMin, fxBandXML);
     createDouble("FxMax", global.fxBand.fxMax, fxBandXML);
 
-    XMLElem toaSwathXML = newElement("TOASwath", globalXML);
+    XMLElem toaSwathXML = createElement("TOASwath", globalXML);
     createDouble("TOAMin", global.toaSwath.toaMin, toaSwathXML);
     createDouble("TOAMax", global.toaSwath.toaMax, toaSwathXML);
 
     if (global.tropoParameters.get())
     {
-        XMLElem tropoXML = newElement("TropoParameters", globalXML);
+        XMLElem tropoXML = createElement("TropoParameters", globalXML);
         createDouble("N0", global.tropoParameters->n0, tropoXML);
         createString("RefHeight", global.tropoParameters->refHeight, tropoXML);
     }
     if (global.ionoParameters.get())
     {
-        XMLElem ionoXML = newElement("IonoParameters", globalXML);
+        XMLElem ionoXML = createElement("IonoParameters", globalXML);
         createDouble("TECV", global.ionoParameters->tecv, ionoXML);
         if (!six::Init::isUndefined(global.ionoParameters->f2Height))
         {
@@ -179,23 +185,23 @@ XMLElem CPHDXMLParser::toXML(const Global& global, XMLElem parent)
 
 XMLElem CPHDXMLParser::toXML(const SceneCoordinates& sceneCoords, XMLElem parent)
 {
-    XMLElem sceneCoordsXML = newElement("SceneCoordinates", parent);
+    XMLElem sceneCoordsXML = createElement("SceneCoordinates", parent);
     createString("EarthModel", sceneCoords.earthModel, sceneCoordsXML);
 
-    XMLElem iarpXML = newElement("IARP", sceneCoordsXML);
+    XMLElem iarpXML = createElement("IARP", sceneCoordsXML);
     mCommon.createVector3D("ECF", sceneCoords.iarp.ecf, iarpXML);
     mCommon.createLatLonAlt("LLH", sceneCoords.iarp.llh, iarpXML);
 
-    XMLElem refSurfXML = newElement("ReferenceSurface", sceneCoordsXML);
+    XMLElem refSurfXML = createElement("ReferenceSurface", sceneCoordsXML);
     if (sceneCoords.referenceSurface.planar.get())
     {
-        XMLElem planarXML = newElement("Planar", refSurfXML);
+        XMLElem planarXML = createElement("Planar", refSurfXML);
         mCommon.createVector3D("uIAX", sceneCoords.referenceSurface.planar->uIax, planarXML);
         mCommon.createVector3D("uIAY", sceneCoords.referenceSurface.planar->uIay, planarXML);
     }
     else if (sceneCoords.referenceSurface.hae.get())
     {
-        XMLElem haeXML = newElement("HAE", refSurfXML);
+        XMLElem haeXML = createElement("HAE", refSurfXML);
         mCommon.createLatLon("uIAXLL", sceneCoords.referenceSurface.hae->uIax, haeXML);
         mCommon.createLatLon("uIAYLL", sceneCoords.referenceSurface.hae->uIay, haeXML);
     }
@@ -205,13 +211,13 @@ XMLElem CPHDXMLParser::toXML(const SceneCoordinates& sceneCoords, XMLElem parent
                 "Reference Surface must be one of two types"));
     }
 
-    XMLElem imageAreaXML = newElement("ImageArea", sceneCoordsXML);
+    XMLElem imageAreaXML = createElement("ImageArea", sceneCoordsXML);
     mCommon.createVector2D("X1Y1", sceneCoords.imageArea.x1y1, imageAreaXML);
     mCommon.createVector2D("X2Y2", sceneCoords.imageArea.x2y2, imageAreaXML);
 
     if (!sceneCoords.imageArea.polygon.empty())
     {
-        XMLElem polygonXML = newElement("Polygon", imageAreaXML);
+        XMLElem polygonXML = createElement("Polygon", imageAreaXML);
         setAttribute(polygonXML, "size", six::toString(sceneCoords.imageArea.polygon.size()));
         for (size_t ii = 0; ii < sceneCoords.imageArea.polygon.size(); ++ii)
         {
@@ -224,13 +230,13 @@ XMLElem CPHDXMLParser::toXML(const SceneCoordinates& sceneCoords, XMLElem parent
     // Extended Area (Optional)
     if(sceneCoords.extendedArea.get())
     {
-        XMLElem extendedAreaXML = newElement("ExtendedArea", sceneCoordsXML);
+        XMLElem extendedAreaXML = createElement("ExtendedArea", sceneCoordsXML);
         mCommon.createVector2D("X1Y1", sceneCoords.extendedArea->x1y1, extendedAreaXML);
         mCommon.createVector2D("X2Y2", sceneCoords.extendedArea->x2y2, extendedAreaXML);
 
         if (!sceneCoords.extendedArea->polygon.empty())
         {
-            XMLElem polygonXML = newElement("Polygon", sceneCoordsXML);
+            XMLElem polygonXML = createElement("Polygon", sceneCoordsXML);
             setAttribute(polygonXML, "size", six::toString(sceneCoords.extendedArea->polygon.size()));
             for (size_t ii = 0; ii < sceneCoords.extendedArea->polygon.size(); ++ii)
             {
@@ -243,33 +249,33 @@ XMLElem CPHDXMLParser::toXML(const SceneCoordinates& sceneCoords, XMLElem parent
     // ImageGrid (Optional)
     if(sceneCoords.imageGrid.get())
     {
-        XMLElem imageGridXML = newElement("ImageGrid", sceneCoordsXML);
+        XMLElem imageGridXML = createElement("ImageGrid", sceneCoordsXML);
         if(!six::Init::isUndefined(sceneCoords.imageGrid->identifier))
         {
             createString("Identifier", sceneCoords.imageGrid->identifier, imageGridXML);
         }
-        XMLElem iarpLocationXML = newElement("IARPLocation", imageGridXML);
+        XMLElem iarpLocationXML = createElement("IARPLocation", imageGridXML);
         createDouble("Line", sceneCoords.imageGrid->iarpLocation.line, iarpLocationXML);
         createDouble("Sample", sceneCoords.imageGrid->iarpLocation.sample, iarpLocationXML);
 
-        XMLElem iaxExtentXML = newElement("IAXExtent", imageGridXML);
+        XMLElem iaxExtentXML = createElement("IAXExtent", imageGridXML);
         createDouble("LineSpacing", sceneCoords.imageGrid->xExtent.lineSpacing, iaxExtentXML);
         createInt("FirstLine", sceneCoords.imageGrid->xExtent.firstLine, iaxExtentXML);
         createInt("NumLines", sceneCoords.imageGrid->xExtent.numLines, iaxExtentXML);
 
-        XMLElem iayExtentXML = newElement("IAYExtent", imageGridXML);
+        XMLElem iayExtentXML = createElement("IAYExtent", imageGridXML);
         createDouble("SampleSpacing", sceneCoords.imageGrid->yExtent.sampleSpacing, iayExtentXML);
         createInt("FirstSample", sceneCoords.imageGrid->yExtent.firstSample, iayExtentXML);
         createInt("NumSamples", sceneCoords.imageGrid->yExtent.numSamples, iayExtentXML);
 
         if (!sceneCoords.imageGrid->segments.empty())
         {
-            XMLElem segmentListXML = newElement("SegmentList", imageGridXML);
+            XMLElem segmentListXML = createElement("SegmentList", imageGridXML);
             createInt("NumSegments", sceneCoords.imageGrid->segments.size(), segmentListXML);
 
             for (size_t ii = 0; ii < sceneCoords.imageGrid->segments.size(); ++ii)
             {
-                XMLElem segmentXML = newElement("Segment", segmentListXML);
+                XMLElem segmentXML = createElement("Segment", segmentListXML);
                 createString("Identifier", sceneCoords.imageGrid->segments[ii].identifier, segmentXML);
                 createInt("StartLine", sceneCoords.imageGrid->segments[ii].startLine, segmentXML);
                 createInt("StartSample", sceneCoords.imageGrid->segments[ii].startSample, segmentXML);
@@ -278,11 +284,11 @@ XMLElem CPHDXMLParser::toXML(const SceneCoordinates& sceneCoords, XMLElem parent
 
                 if (!sceneCoords.imageGrid->segments[ii].polygon.empty())
                 {
-                    XMLElem polygonXML = newElement("SegmentPolygon", segmentXML);
+                    XMLElem polygonXML = createElement("SegmentPolygon", segmentXML);
                     setAttribute(polygonXML, "size", six::toString(sceneCoords.imageGrid->segments[ii].polygon.size()));
                     for (size_t jj = 0; jj < sceneCoords.imageGrid->segments[ii].polygon.size(); ++jj)
                     {
-                        XMLElem svXML = newElement("SV", polygonXML);
+                        XMLElem svXML = createElement("SV", polygonXML);
                         setAttribute(svXML, "index", six::toString(sceneCoords.imageGrid->segments[ii].polygon[jj].getIndex()));
                         createDouble("Line", sceneCoords.imageGrid->segments[ii].polygon[jj].line, svXML);
                         createDouble("Sample", sceneCoords.imageGrid->segments[ii].polygon[jj].sample, svXML);
@@ -296,7 +302,7 @@ XMLElem CPHDXMLParser::toXML(const SceneCoordinates& sceneCoords, XMLElem parent
 
 XMLElem CPHDXMLParser::toXML(const Data& data, XMLElem parent)
 {
-    XMLElem dataXML = newElement("Data", parent);
+    XMLElem dataXML = createElement("Data", parent);
     createString("SignalArrayFormat", data.signalArrayFormat, dataXML);
     createInt("NumBytesPVP", data.numBytesPVP, dataXML);
     createInt("NumCPHDChannels", data.channels.size(), dataXML);
@@ -307,7 +313,7 @@ XMLElem CPHDXMLParser::toXML(const Data& data, XMLElem parent)
 
     for (size_t ii = 0; ii < data.channels.size(); ++ii)
     {
-        XMLElem channelXML = newElement("Channel", dataXML);
+        XMLElem channelXML = createElement("Channel", dataXML);
         createString("Identifier", data.channels[ii].identifier, channelXML);
         createInt("NumVectors", data.channels[ii].numVectors, channelXML);
         createInt("NumSamples", data.channels[ii].numSamples, channelXML);
@@ -321,7 +327,7 @@ XMLElem CPHDXMLParser::toXML(const Data& data, XMLElem parent)
     createInt("NumSupportArrays", data.supportArrayMap.size(), dataXML);
     for (auto it = data.supportArrayMap.begin(); it != data.supportArrayMap.end(); ++it)
     {
-        XMLElem supportArrayXML = newElement("SupportArray", dataXML);
+        XMLElem supportArrayXML = createElement("SupportArray", dataXML);
         createString("Identifier", it->second.identifier, supportArrayXML);
         createInt("NumRows", it->second.numRows, supportArrayXML);
         createInt("NumCols", it->second.numCols, supportArrayXML);
@@ -333,7 +339,7 @@ XMLElem CPHDXMLParser::toXML(const Data& data, XMLElem parent)
 
 XMLElem CPHDXMLParser::toXML(const Channel& channel, XMLElem parent)
 {
-    XMLElem channelXML = newElement("Channel", parent);
+    XMLElem channelXML = createElement("Channel", parent);
     createString("RefChId", channel.refChId, channelXML);
     createBooleanType("FXFixedCPHD", channel.fxFixedCphd, channelXML);
     createBooleanType("TOAFixedCPHD", channel.toaFixedCphd, channelXML);
@@ -341,7 +347,7 @@ XMLElem CPHDXMLParser::toXML(const Channel& channel, XMLElem parent)
 
     for (size_t ii = 0; ii < channel.parameters.size(); ++ii)
     {
-        XMLElem parametersXML = newElement("Parameters", channelXML);
+        XMLElem parametersXML = createElement("Parameters", channelXML);
         createString("Identifier", channel.parameters[ii].identifier, parametersXML);
         createInt("RefVectorIndex", channel.parameters[ii].refVectorIndex, parametersXML);
         createBooleanType("FXFixed", channel.parameters[ii].fxFixed, parametersXML);
@@ -351,7 +357,7 @@ XMLElem CPHDXMLParser::toXML(const Channel& channel, XMLElem parent)
         {
             createBooleanType("SignalNormal", channel.parameters[ii].signalNormal, parametersXML);
         }
-        XMLElem polXML = newElement("Polarization", parametersXML);
+        XMLElem polXML = createElement("Polarization", parametersXML);
         createString("TxPol", channel.parameters[ii].polarization.txPol.toString(), polXML);
         createString("RcvPol", channel.parameters[ii].polarization.rcvPol.toString(), polXML);
         createDouble("FxC", channel.parameters[ii].fxC, parametersXML);
@@ -364,28 +370,28 @@ XMLElem CPHDXMLParser::toXML(const Channel& channel, XMLElem parent)
 
         if(channel.parameters[ii].toaExtended.get())
         {
-            XMLElem toaExtendedXML = newElement("TOAExtended", parametersXML);
+            XMLElem toaExtendedXML = createElement("TOAExtended", parametersXML);
             createDouble("TOAExtSaved", channel.parameters[ii].toaExtended->toaExtSaved, toaExtendedXML);
             if(channel.parameters[ii].toaExtended->lfmEclipse.get())
             {
-                XMLElem lfmEclipseXML = newElement("LFMEclipse", toaExtendedXML);
+                XMLElem lfmEclipseXML = createElement("LFMEclipse", toaExtendedXML);
                 createDouble("FxEarlyLow", channel.parameters[ii].toaExtended->lfmEclipse->fxEarlyLow, lfmEclipseXML);
                 createDouble("FxEarlyHigh", channel.parameters[ii].toaExtended->lfmEclipse->fxEarlyHigh, lfmEclipseXML);
                 createDouble("FxLateLow", channel.parameters[ii].toaExtended->lfmEclipse->fxLateLow, lfmEclipseXML);
                 createDouble("FxLateHigh", channel.parameters[ii].toaExtended->lfmEclipse->fxLateHigh, lfmEclipseXML);
             }
         }
-        XMLElem dwellTimesXML = newElement("DwellTimes", parametersXML);
+        XMLElem dwellTimesXML = createElement("DwellTimes", parametersXML);
         createString("CODId", channel.parameters[ii].dwellTimes.codId, dwellTimesXML);
         createString("DwellId", channel.parameters[ii].dwellTimes.dwellId, dwellTimesXML);
         if(!six::Init::isUndefined(channel.parameters[ii].imageArea))
         {
-            XMLElem imageAreaXML = newElement("ImageArea", parametersXML);
+            XMLElem imageAreaXML = createElement("ImageArea", parametersXML);
             mCommon.createVector2D("X1Y1", channel.parameters[ii].imageArea.x1y1, imageAreaXML);
             mCommon.createVector2D("X2Y2", channel.parameters[ii].imageArea.x2y2, imageAreaXML);
             if(!channel.parameters[ii].imageArea.polygon.empty())
             {
-                XMLElem polygonXML = newElement("Polygon", imageAreaXML);
+                XMLElem polygonXML = createElement("Polygon", imageAreaXML);
                 setAttribute(polygonXML, "size", six::toString(channel.parameters[ii].imageArea.polygon.size()));
                 for (size_t jj = 0; jj < channel.parameters[ii].imageArea.polygon.size(); ++jj)
                 {
@@ -396,7 +402,7 @@ XMLElem CPHDXMLParser::toXML(const Channel& channel, XMLElem parent)
         }
         if(channel.parameters[ii].antenna.get())
         {
-            XMLElem antennaXML = newElement("Antenna", parametersXML);
+            XMLElem antennaXML = createElement("Antenna", parametersXML);
             createString("TxAPCId", channel.parameters[ii].antenna->txAPCId, antennaXML);
             createString("TxAPATId", channel.parameters[ii].antenna->txAPATId, antennaXML);
             createString("RcvAPCId", channel.parameters[ii].antenna->rcvAPCId, antennaXML);
@@ -404,7 +410,7 @@ XMLElem CPHDXMLParser::toXML(const Channel& channel, XMLElem parent)
         }
         if(channel.parameters[ii].txRcv.get())
         {
-            XMLElem txRcvXML = newElement("TxRcv", parametersXML);
+            XMLElem txRcvXML = createElement("TxRcv", parametersXML);
             for (size_t jj = 0; jj < channel.parameters[ii].txRcv->txWFId.size(); ++jj)
             {
                 createString("TxWFId", channel.parameters[ii].txRcv->txWFId[jj], txRcvXML);
@@ -416,20 +422,20 @@ XMLElem CPHDXMLParser::toXML(const Channel& channel, XMLElem parent)
         }
         if(channel.parameters[ii].tgtRefLevel.get())
         {
-            XMLElem tgtRefXML = newElement("TgtRefLevel", parametersXML);
+            XMLElem tgtRefXML = createElement("TgtRefLevel", parametersXML);
             createDouble("PTRef", channel.parameters[ii].tgtRefLevel->ptRef, tgtRefXML);
         }
         if(channel.parameters[ii].noiseLevel.get())
         {
-            XMLElem noiseLevelXML = newElement("NoiseLevel", parametersXML);
+            XMLElem noiseLevelXML = createElement("NoiseLevel", parametersXML);
             createDouble("PNRef", channel.parameters[ii].noiseLevel->pnRef, noiseLevelXML);
             createDouble("BNRef", channel.parameters[ii].noiseLevel->bnRef, noiseLevelXML);
             if(channel.parameters[ii].noiseLevel->fxNoiseProfile.get())
             {
-                XMLElem fxNoiseProfileXML = newElement("FxNoiseProfile", noiseLevelXML);
+                XMLElem fxNoiseProfileXML = createElement("FxNoiseProfile", noiseLevelXML);
                 for (size_t jj = 0; jj < channel.parameters[ii].noiseLevel->fxNoiseProfile->point.size(); ++jj)
                 {
-                    XMLElem pointXML = newElement("Point", fxNoiseProfileXML);
+                    XMLElem pointXML = createElement("Point", fxNoiseProfileXML);
                     createDouble("Fx", channel.parameters[ii].noiseLevel->fxNoiseProfile->point[jj].fx, pointXML);
                     createDouble("PN", channel.parameters[ii].noiseLevel->fxNoiseProfile->point[jj].pn, pointXML);
                 }
@@ -438,7 +444,7 @@ XMLElem CPHDXMLParser::toXML(const Channel& channel, XMLElem parent)
     }
     if(!channel.addedParameters.empty())
     {
-        XMLElem addedParamsXML = newElement("AddedParameters", channelXML);
+        XMLElem addedParamsXML = createElement("AddedParameters", channelXML);
         mCommon.addParameters("Parameter", getDefaultURI(), channel.addedParameters, addedParamsXML);
     }
     return channelXML;
@@ -446,7 +452,7 @@ XMLElem CPHDXMLParser::toXML(const Channel& channel, XMLElem parent)
 
 XMLElem CPHDXMLParser::toXML(const Pvp& pvp, XMLElem parent)
 {
-    XMLElem pvpXML = newElement("PVP", parent);
+    XMLElem pvpXML = createElement("PVP", parent);
     createPVPType("TxTime", pvp.txTime, pvpXML);
     createPVPType("TxPos", pvp.txPos, pvpXML);
     createPVPType("TxVel", pvp.txVel, pvpXML);
@@ -503,12 +509,12 @@ XMLElem CPHDXMLParser::toXML(const Pvp& pvp, XMLElem parent)
 //Assumes optional handled by caller
 XMLElem CPHDXMLParser::toXML(const SupportArray& supports, XMLElem parent)
 {
-    XMLElem supportsXML = newElement("SupportArray", parent);
+    XMLElem supportsXML = createElement("SupportArray", parent);
     if (!supports.iazArray.empty())
     {
         for (size_t ii = 0; ii < supports.iazArray.size(); ++ii)
         {
-            XMLElem iazArrayXML = newElement("IAZArray", supportsXML);
+            XMLElem iazArrayXML = createElement("IAZArray", supportsXML);
             createInt("Identifier", supports.iazArray[ii].getIdentifier(), iazArrayXML);
             createString("ElementFormat", supports.iazArray[ii].elementFormat, iazArrayXML);
             createDouble("X0", supports.iazArray[ii].x0, iazArrayXML);
@@ -521,7 +527,7 @@ XMLElem CPHDXMLParser::toXML(const SupportArray& supports, XMLElem parent)
     {
         for (size_t ii = 0; ii < supports.antGainPhase.size(); ++ii)
         {
-            XMLElem antGainPhaseXML = newElement("AntGainPhase", supportsXML);
+            XMLElem antGainPhaseXML = createElement("AntGainPhase", supportsXML);
             createInt("Identifier", supports.antGainPhase[ii].getIdentifier(), antGainPhaseXML);
             createString("ElementFormat", supports.antGainPhase[ii].elementFormat, antGainPhaseXML);
             createDouble("X0", supports.antGainPhase[ii].x0, antGainPhaseXML);
@@ -534,7 +540,7 @@ XMLElem CPHDXMLParser::toXML(const SupportArray& supports, XMLElem parent)
     {
         for (auto it = supports.addedSupportArray.begin(); it != supports.addedSupportArray.end(); ++it)
         {
-            XMLElem addedSupportArrayXML = newElement("AddedSupportArray", supportsXML);
+            XMLElem addedSupportArrayXML = createElement("AddedSupportArray", supportsXML);
             createString("Identifier", it->first, addedSupportArrayXML);
             createString("ElementFormat", it->second.elementFormat, addedSupportArrayXML);
             createDouble("X0", it->second.x0, addedSupportArrayXML);
@@ -552,19 +558,19 @@ XMLElem CPHDXMLParser::toXML(const SupportArray& supports, XMLElem parent)
 
 XMLElem CPHDXMLParser::toXML(const Dwell& dwell, XMLElem parent)
 {
-    XMLElem dwellXML = newElement("Dwell", parent);
+    XMLElem dwellXML = createElement("Dwell", parent);
     createInt("NumCODTimes", dwell.cod.size(), dwellXML);
 
     for (size_t ii = 0; ii < dwell.cod.size(); ++ii)
     {
-        XMLElem codTimeXML = newElement("CODTime", dwellXML);
+        XMLElem codTimeXML = createElement("CODTime", dwellXML);
         createString("Identifier", dwell.cod[ii].identifier, codTimeXML);
         mCommon.createPoly2D("CODTimePoly", dwell.cod[ii].codTimePoly, codTimeXML);
     }
     createInt("NumDwellTimes", dwell.dtime.size(), dwellXML);
     for (size_t ii = 0; ii < dwell.dtime.size(); ++ii)
     {
-        XMLElem dwellTimeXML = newElement("DwellTime", dwellXML);
+        XMLElem dwellTimeXML = createElement("DwellTime", dwellXML);
         createString("Identifier", dwell.dtime[ii].identifier, dwellTimeXML);
         mCommon.createPoly2D("DwellTimePoly", dwell.dtime[ii].dwellTimePoly, dwellTimeXML);
     }
@@ -573,8 +579,8 @@ XMLElem CPHDXMLParser::toXML(const Dwell& dwell, XMLElem parent)
 
 XMLElem CPHDXMLParser::toXML(const ReferenceGeometry& refGeo, XMLElem parent)
 {
-    XMLElem refGeoXML = newElement("ReferenceGeometry", parent);
-    XMLElem srpXML = newElement("SRP", refGeoXML);
+    XMLElem refGeoXML = createElement("ReferenceGeometry", parent);
+    XMLElem srpXML = createElement("SRP", refGeoXML);
     mCommon.createVector3D("ECF", refGeo.srp.ecf, srpXML);
     mCommon.createVector3D("IAC", refGeo.srp.iac, srpXML);
     createDouble("ReferenceTime", refGeo.referenceTime, refGeoXML);
@@ -583,7 +589,7 @@ XMLElem CPHDXMLParser::toXML(const ReferenceGeometry& refGeo, XMLElem parent)
 
     if (refGeo.monostatic.get())
     {
-        XMLElem monoXML = newElement("Monostatic", refGeoXML);
+        XMLElem monoXML = createElement("Monostatic", refGeoXML);
         mCommon.createVector3D("ARPPos", refGeo.monostatic->arpPos, monoXML);
         mCommon.createVector3D("ARPVel", refGeo.monostatic->arpVel, monoXML);
         std::string side = refGeo.monostatic->sideOfTrack.toString();
@@ -600,7 +606,7 @@ XMLElem CPHDXMLParser::toXML(const ReferenceGeometry& refGeo, XMLElem parent)
     }
     else if(refGeo.bistatic.get())
     {
-        XMLElem biXML = newElement("Bistatic", refGeoXML);
+        XMLElem biXML = createElement("Bistatic", refGeoXML);
         createDouble("AzimuthAngle", refGeo.bistatic->azimuthAngle, biXML);
         createDouble("AzimuthAngleRate", refGeo.bistatic->azimuthAngleRate, biXML);
         createDouble("BistaticAngle", refGeo.bistatic->bistaticAngle, biXML);
@@ -609,7 +615,7 @@ XMLElem CPHDXMLParser::toXML(const ReferenceGeometry& refGeo, XMLElem parent)
         createDouble("TwistAngle", refGeo.bistatic->twistAngle, biXML);
         createDouble("SlopeAngle", refGeo.bistatic->slopeAngle, biXML);
         createDouble("LayoverAngle", refGeo.bistatic->layoverAngle, biXML);
-        XMLElem txPlatXML = newElement("TxPlatform", biXML);
+        XMLElem txPlatXML = createElement("TxPlatform", biXML);
         createDouble("Time", refGeo.bistatic->txPlatform.time, txPlatXML);
         mCommon.createVector3D("Pos", refGeo.bistatic->txPlatform.pos, txPlatXML);
         mCommon.createVector3D("Vel", refGeo.bistatic->txPlatform.vel, txPlatXML);
@@ -622,7 +628,7 @@ XMLElem CPHDXMLParser::toXML(const ReferenceGeometry& refGeo, XMLElem parent)
         createDouble("GrazeAngle", refGeo.bistatic->txPlatform.grazeAngle, txPlatXML);
         createDouble("IncidenceAngle", refGeo.bistatic->txPlatform.incidenceAngle, txPlatXML);
         createDouble("AzimuthAngle", refGeo.bistatic->txPlatform.azimuthAngle, txPlatXML);
-        XMLElem rcvPlatXML = newElement("RcvPlatform", biXML);
+        XMLElem rcvPlatXML = createElement("RcvPlatform", biXML);
         createDouble("Time", refGeo.bistatic->rcvPlatform.time, rcvPlatXML);
         mCommon.createVector3D("Pos", refGeo.bistatic->rcvPlatform.pos, rcvPlatXML);
         mCommon.createVector3D("Vel", refGeo.bistatic->rcvPlatform.vel, rcvPlatXML);
@@ -641,27 +647,27 @@ XMLElem CPHDXMLParser::toXML(const ReferenceGeometry& refGeo, XMLElem parent)
 
 XMLElem CPHDXMLParser::toXML(const Antenna& antenna, XMLElem parent)
 {
-    XMLElem antennaXML = newElement("Antenna", parent);
+    XMLElem antennaXML = createElement("Antenna", parent);
     createInt("NumACFs", antenna.antCoordFrame.size(), antennaXML);
     createInt("NumAPCs", antenna.antPhaseCenter.size(), antennaXML);
     createInt("NumAntPats", antenna.antPattern.size(), antennaXML);
     for (size_t ii = 0; ii < antenna.antCoordFrame.size(); ++ii)
     {
-        XMLElem antCoordFrameXML = newElement("AntCoordFrame", antennaXML);
+        XMLElem antCoordFrameXML = createElement("AntCoordFrame", antennaXML);
         createString("Identifier", antenna.antCoordFrame[ii].identifier, antCoordFrameXML);
         mCommon.createPolyXYZ("XAxisPoly", antenna.antCoordFrame[ii].xAxisPoly, antCoordFrameXML);
         mCommon.createPolyXYZ("YAxisPoly", antenna.antCoordFrame[ii].yAxisPoly, antCoordFrameXML);
     }
     for (size_t ii = 0; ii < antenna.antPhaseCenter.size(); ++ii)
     {
-        XMLElem antPhaseCenterXML = newElement("AntPhaseCenter", antennaXML);
+        XMLElem antPhaseCenterXML = createElement("AntPhaseCenter", antennaXML);
         createString("Identifier", antenna.antPhaseCenter[ii].identifier, antPhaseCenterXML);
         createString("ACFId", antenna.antPhaseCenter[ii].acfId, antPhaseCenterXML);
         mCommon.createVector3D("APCXYZ", antenna.antPhaseCenter[ii].apcXYZ, antPhaseCenterXML);
     }
     for (size_t ii = 0; ii < antenna.antPattern.size(); ++ii)
     {
-        XMLElem antPatternXML = newElement("AntPattern", antennaXML);
+        XMLElem antPatternXML = createElement("AntPattern", antennaXML);
         createString("Identifier", antenna.antPattern[ii].identifier, antPatternXML);
         createDouble("FreqZero", antenna.antPattern[ii].freqZero, antPatternXML);
         if (!six::Init::isUndefined(antenna.antPattern[ii].gainZero))
@@ -680,18 +686,18 @@ XMLElem CPHDXMLParser::toXML(const Antenna& antenna, XMLElem parent)
         {
             mCommon.createPoly1D("GainBSPoly", antenna.antPattern[ii].gainBSPoly, antPatternXML);
         }
-        XMLElem ebXML = newElement("EB", antPatternXML);
+        XMLElem ebXML = createElement("EB", antPatternXML);
         mCommon.createPoly1D("DCXPoly", antenna.antPattern[ii].eb.dcxPoly, ebXML);
         mCommon.createPoly1D("DCYPoly", antenna.antPattern[ii].eb.dcyPoly, ebXML);
-        XMLElem arrayXML = newElement("Array", antPatternXML);
+        XMLElem arrayXML = createElement("Array", antPatternXML);
         mCommon.createPoly2D("GainPoly", antenna.antPattern[ii].array.gainPoly, arrayXML);
         mCommon.createPoly2D("PhasePoly", antenna.antPattern[ii].array.phasePoly, arrayXML);
-        XMLElem elementXML = newElement("Element", antPatternXML);
+        XMLElem elementXML = createElement("Element", antPatternXML);
         mCommon.createPoly2D("GainPoly", antenna.antPattern[ii].element.gainPoly, elementXML);
         mCommon.createPoly2D("PhasePoly", antenna.antPattern[ii].element.phasePoly, elementXML);
         for (size_t jj = 0; jj < antenna.antPattern[ii].gainPhaseArray.size(); ++jj)
         {
-            XMLElem gainPhaseArrayXML = newElement("GainPhaseArray", antPatternXML);
+            XMLElem gainPhaseArrayXML = createElement("GainPhaseArray", antPatternXML);
             createDouble("Freq", antenna.antPattern[ii].gainPhaseArray[jj].freq, gainPhaseArrayXML);
             createString("ArrayId", antenna.antPattern[ii].gainPhaseArray[jj].arrayId, gainPhaseArrayXML);
             if (!six::Init::isUndefined(antenna.antPattern[ii].gainPhaseArray[jj].elementId))
@@ -705,11 +711,11 @@ XMLElem CPHDXMLParser::toXML(const Antenna& antenna, XMLElem parent)
 
 XMLElem CPHDXMLParser::toXML(const TxRcv& txRcv, XMLElem parent)
 {
-    XMLElem txRcvXML = newElement("TxRcv", parent);
+    XMLElem txRcvXML = createElement("TxRcv", parent);
     createInt("NumTxWFs", txRcv.txWFParameters.size(), txRcvXML);
     for (size_t ii = 0; ii < txRcv.txWFParameters.size(); ++ii)
     {
-        XMLElem txWFParamsXML = newElement("TxWFParameters", txRcvXML);
+        XMLElem txWFParamsXML = createElement("TxWFParameters", txRcvXML);
         createString("Identifier", txRcv.txWFParameters[ii].identifier, txWFParamsXML);
         createDouble("PulseLength", txRcv.txWFParameters[ii].pulseLength, txWFParamsXML);
         createDouble("RFBandwidth", txRcv.txWFParameters[ii].rfBandwidth, txWFParamsXML);
@@ -727,7 +733,7 @@ XMLElem CPHDXMLParser::toXML(const TxRcv& txRcv, XMLElem parent)
     createInt("NumRcvs", txRcv.rcvParameters.size(), txRcvXML);
     for (size_t ii = 0; ii < txRcv.rcvParameters.size(); ++ii)
     {
-        XMLElem rcvParamsXML = newElement("RcvParameters", txRcvXML);
+        XMLElem rcvParamsXML = createElement("RcvParameters", txRcvXML);
         createString("Identifier", txRcv.rcvParameters[ii].identifier, rcvParamsXML);
         createDouble("WindowLength", txRcv.rcvParameters[ii].windowLength, rcvParamsXML);
         createDouble("SampleRate", txRcv.rcvParameters[ii].sampleRate, rcvParamsXML);
@@ -748,11 +754,11 @@ XMLElem CPHDXMLParser::toXML(const TxRcv& txRcv, XMLElem parent)
 
 XMLElem CPHDXMLParser::toXML(const ErrorParameters& errParams, XMLElem parent)
 {
-    XMLElem errParamsXML = newElement("ErrorParameters", parent);
+    XMLElem errParamsXML = createElement("ErrorParameters", parent);
     if (errParams.monostatic.get())
     {
-        XMLElem monoXML = newElement("Monostatic", errParamsXML);
-        XMLElem posVelErrXML = newElement("PosVelErr", monoXML);
+        XMLElem monoXML = createElement("Monostatic", errParamsXML);
+        XMLElem posVelErrXML = createElement("PosVelErr", monoXML);
         createString("Frame", errParams.monostatic->posVelErr.frame.toString(), posVelErrXML);
         createDouble("P1", errParams.monostatic->posVelErr.p1, posVelErrXML);
         createDouble("P2", errParams.monostatic->posVelErr.p2, posVelErrXML);
@@ -762,7 +768,7 @@ XMLElem CPHDXMLParser::toXML(const ErrorParameters& errParams, XMLElem parent)
         createDouble("V3", errParams.monostatic->posVelErr.v3, posVelErrXML);
         if(errParams.monostatic->posVelErr.corrCoefs.get())
         {
-            XMLElem corrCoefsXML = newElement("CorrCoefs", posVelErrXML);
+            XMLElem corrCoefsXML = createElement("CorrCoefs", posVelErrXML);
             createDouble("P1P2", errParams.monostatic->posVelErr.corrCoefs->p1p2, corrCoefsXML);
             createDouble("P1P3", errParams.monostatic->posVelErr.corrCoefs->p1p3, corrCoefsXML);
             createDouble("P1V1", errParams.monostatic->posVelErr.corrCoefs->p1v1, corrCoefsXML);
@@ -781,12 +787,12 @@ XMLElem CPHDXMLParser::toXML(const ErrorParameters& errParams, XMLElem parent)
         }
         if(!six::Init::isUndefined(errParams.monostatic->posVelErr.positionDecorr))
         {
-            XMLElem positionDecorrXML = newElement("PositionDecorr", posVelErrXML);
+            XMLElem positionDecorrXML = createElement("PositionDecorr", posVelErrXML);
             createDouble("CorrCoefZero", errParams.monostatic->posVelErr.positionDecorr.corrCoefZero, positionDecorrXML);
             createDouble("DecorrRate", errParams.monostatic->posVelErr.positionDecorr.decorrRate, positionDecorrXML);
         }
         // RadarSensor
-        XMLElem radarXML = newElement("RadarSensor", monoXML);
+        XMLElem radarXML = createElement("RadarSensor", monoXML);
         createDouble("RangeBias", errParams.monostatic->radarSensor.rangeBias, radarXML);
         if (!six::Init::isUndefined(errParams.monostatic->radarSensor.clockFreqSF))
         {
@@ -798,14 +804,14 @@ XMLElem CPHDXMLParser::toXML(const ErrorParameters& errParams, XMLElem parent)
         }
         if (errParams.monostatic->radarSensor.rangeBiasDecorr.get())
         {
-            XMLElem rangeBiasDecorrXML = newElement("RangeBiasDecorr", radarXML);
+            XMLElem rangeBiasDecorrXML = createElement("RangeBiasDecorr", radarXML);
             createDouble("CorrCoefZero", errParams.monostatic->radarSensor.rangeBiasDecorr->corrCoefZero, rangeBiasDecorrXML);
             createDouble("DecorrRate", errParams.monostatic->radarSensor.rangeBiasDecorr->decorrRate, rangeBiasDecorrXML);
         }
 
         if (errParams.monostatic->tropoError.get())
         {
-            XMLElem tropoXML = newElement("TropoError", monoXML);
+            XMLElem tropoXML = createElement("TropoError", monoXML);
             if (!six::Init::isUndefined(errParams.monostatic->tropoError->tropoRangeVertical))
             {
                 createDouble("TropoRangeVertical", errParams.monostatic->tropoError->tropoRangeVertical, tropoXML);
@@ -816,14 +822,14 @@ XMLElem CPHDXMLParser::toXML(const ErrorParameters& errParams, XMLElem parent)
             }
             if (!six::Init::isUndefined(errParams.monostatic->tropoError->tropoRangeDecorr))
             {
-                XMLElem tropoDecorrXML = newElement("TropoRangeDecorr", tropoXML);
+                XMLElem tropoDecorrXML = createElement("TropoRangeDecorr", tropoXML);
                 createDouble("CorrCoefZero", errParams.monostatic->tropoError->tropoRangeDecorr.corrCoefZero, tropoDecorrXML);
                 createDouble("DecorrRate", errParams.monostatic->tropoError->tropoRangeDecorr.decorrRate, tropoDecorrXML);
             }
         }
         if (errParams.monostatic->ionoError.get())
         {
-            XMLElem ionoXML = newElement("IonoError", monoXML);
+            XMLElem ionoXML = createElement("IonoError", monoXML);
             createDouble("IonoRangeVertical", errParams.monostatic->ionoError->ionoRangeVertical, ionoXML);
             if (!six::Init::isUndefined(errParams.monostatic->ionoError->ionoRangeRateVertical))
             {
@@ -835,32 +841,32 @@ XMLElem CPHDXMLParser::toXML(const ErrorParameters& errParams, XMLElem parent)
             }
             if (!six::Init::isUndefined(errParams.monostatic->ionoError->ionoRangeVertDecorr))
             {
-                XMLElem ionoDecorrXML = newElement("IonoRangeVertDecorr", ionoXML);
+                XMLElem ionoDecorrXML = createElement("IonoRangeVertDecorr", ionoXML);
                 createDouble("CorrCoefZero", errParams.monostatic->ionoError->ionoRangeVertDecorr.corrCoefZero, ionoDecorrXML);
                 createDouble("DecorrRate", errParams.monostatic->ionoError->ionoRangeVertDecorr.decorrRate, ionoDecorrXML);
             }
         }
         if (errParams.monostatic->parameter.size() > 0)
         {
-            XMLElem addedParamsXML = newElement("AddedParameters", monoXML);
+            XMLElem addedParamsXML = createElement("AddedParameters", monoXML);
             mCommon.addParameters("Parameter", getDefaultURI(), errParams.monostatic->parameter, addedParamsXML);
         }
     }
     else if (errParams.bistatic.get())
     {
-        XMLElem biXML = newElement("Bistatic", errParamsXML);
-        XMLElem txPlatXML = newElement("TxPlatform", biXML);
+        XMLElem biXML = createElement("Bistatic", errParamsXML);
+        XMLElem txPlatXML = createElement("TxPlatform", biXML);
         createErrorParamPlatform("TxPlatform", errParams.bistatic->txPlatform, txPlatXML);
-        XMLElem radarTxXML = newElement("RadarSensor", txPlatXML);
+        XMLElem radarTxXML = createElement("RadarSensor", txPlatXML);
         if(!six::Init::isUndefined(errParams.bistatic->txPlatform.radarSensor.clockFreqSF))
         {
             createDouble("ClockFreqSF", errParams.bistatic->txPlatform.radarSensor.clockFreqSF, radarTxXML);
         }
         createDouble("CollectionStartTime", errParams.bistatic->txPlatform.radarSensor.collectionStartTime, radarTxXML);
 
-        XMLElem rcvPlatXML = newElement("RcvPlatform", biXML);
+        XMLElem rcvPlatXML = createElement("RcvPlatform", biXML);
         createErrorParamPlatform("RcvPlatform", errParams.bistatic->rcvPlatform, rcvPlatXML);
-        XMLElem radarRcvXML = newElement("RadarSensor", rcvPlatXML);
+        XMLElem radarRcvXML = createElement("RadarSensor", rcvPlatXML);
         if(!six::Init::isUndefined(errParams.bistatic->rcvPlatform.radarSensor.clockFreqSF))
         {
             createDouble("ClockFreqSF", errParams.bistatic->rcvPlatform.radarSensor.clockFreqSF, radarRcvXML);
@@ -869,7 +875,7 @@ XMLElem CPHDXMLParser::toXML(const ErrorParameters& errParams, XMLElem parent)
 
         if (errParams.bistatic->parameter.size() > 0)
         {
-            XMLElem addedParamsXML = newElement("AddedParameters", biXML);
+            XMLElem addedParamsXML = createElement("AddedParameters", biXML);
             mCommon.addParameters("Parameter",  getDefaultURI(), errParams.bistatic->parameter, addedParamsXML);
         }
     }
@@ -879,14 +885,14 @@ XMLElem CPHDXMLParser::toXML(const ErrorParameters& errParams, XMLElem parent)
 
 XMLElem CPHDXMLParser::toXML(const ProductInfo& productInfo, XMLElem parent)
 {
-    XMLElem productInfoXML = newElement("ProductInfo", parent);
+    XMLElem productInfoXML = createElement("ProductInfo", parent);
     if(!six::Init::isUndefined(productInfo.profile))
     {
         createString("Profile", productInfo.profile, productInfoXML);
     }
     for (size_t ii = 0; ii < productInfo.creationInfo.size(); ++ii)
     {
-        XMLElem creationInfoXML = newElement("CreationInfo", productInfoXML);
+        XMLElem creationInfoXML = createElement("CreationInfo", productInfoXML);
         if(!six::Init::isUndefined(productInfo.creationInfo[ii].application))
         {
             createString("Application", productInfo.creationInfo[ii].application, creationInfoXML);
@@ -904,7 +910,7 @@ XMLElem CPHDXMLParser::toXML(const ProductInfo& productInfo, XMLElem parent)
 
 XMLElem CPHDXMLParser::toXML(const GeoInfo& geoInfo, XMLElem parent)
 {
-    XMLElem geoInfoXML = newElement("GeoInfo", parent);
+    XMLElem geoInfoXML = createElement("GeoInfo", parent);
 
     mCommon.addParameters("Desc", geoInfo.desc, geoInfoXML);
 
@@ -915,8 +921,8 @@ XMLElem CPHDXMLParser::toXML(const GeoInfo& geoInfo, XMLElem parent)
     }
     else if (numLatLons >= 2)
     {
-        XMLElem linePolyXML = newElement(numLatLons == 2 ? "Line" : "Polygon",
-                                         geoInfoXML);
+        XMLElem linePolyXML = createElement(numLatLons == 2 ? "Line" : "Polygon",
+                                            geoInfoXML);
         setAttribute(linePolyXML, "size", str::toString(numLatLons));
 
         for (size_t ii = 0; ii < numLatLons; ++ii)
@@ -1891,7 +1897,7 @@ XMLElem CPHDXMLParser::createLatLonFootprint(const std::string& name,
                                               const cphd::LatLonCorners& corners,
                                               XMLElem parent) const
 {
-    XMLElem footprint = newElement(name, parent);
+    XMLElem footprint = createElement(name, parent);
 
     // Write the corners in CW order
     XMLElem vertex =
@@ -1914,7 +1920,7 @@ XMLElem CPHDXMLParser::createPVPType(const std::string& name,
                                       const PVPType& p,
                                       XMLElem parent) const
 {
-    XMLElem pvpXML = newElement(name, parent);
+    XMLElem pvpXML = createElement(name, parent);
     createInt("Offset", p.getOffset(), pvpXML);
     createInt("Size", p.getSize(), pvpXML);
     createString("Format", p.getFormat(), pvpXML);
@@ -1925,7 +1931,7 @@ XMLElem CPHDXMLParser::createAPVPType(const std::string& name,
                                        const APVPType& p,
                                        XMLElem parent) const
 {
-    XMLElem apvpXML = newElement(name, parent);
+    XMLElem apvpXML = createElement(name, parent);
     createString("Name", p.getName(), apvpXML);
     createInt("Offset", p.getOffset(), apvpXML);
     createInt("Size", p.getSize(), apvpXML);
@@ -1938,7 +1944,7 @@ XMLElem CPHDXMLParser::createErrorParamPlatform(
         const ErrorParameters::Bistatic::Platform p,
         XMLElem parent) const
 {
-    XMLElem posVelErrXML = newElement("PosVelErr", parent);
+    XMLElem posVelErrXML = createElement("PosVelErr", parent);
     createString("Frame", p.posVelErr.frame.toString(), posVelErrXML);
     createDouble("P1", p.posVelErr.p1, posVelErrXML);
     createDouble("P2", p.posVelErr.p2, posVelErrXML);
@@ -1948,7 +1954,7 @@ XMLElem CPHDXMLParser::createErrorParamPlatform(
     createDouble("V3", p.posVelErr.v3, posVelErrXML);
     if(p.posVelErr.corrCoefs.get())
     {
-        XMLElem corrCoefsXML = newElement("CorrCoefs", posVelErrXML);
+        XMLElem corrCoefsXML = createElement("CorrCoefs", posVelErrXML);
         createDouble("P1P2", p.posVelErr.corrCoefs->p1p2, corrCoefsXML);
         createDouble("P1P3", p.posVelErr.corrCoefs->p1p3, corrCoefsXML);
         createDouble("P1V1", p.posVelErr.corrCoefs->p1v1, corrCoefsXML);
@@ -1967,7 +1973,7 @@ XMLElem CPHDXMLParser::createErrorParamPlatform(
     }
     if(!six::Init::isUndefined(p.posVelErr.positionDecorr))
     {
-        XMLElem positionDecorrXML = newElement("PositionDecorr", posVelErrXML);
+        XMLElem positionDecorrXML = createElement("PositionDecorr", posVelErrXML);
         createDouble("CorrCoefZero", p.posVelErr.positionDecorr.corrCoefZero, positionDecorrXML);
         createDouble("DecorrRate", p.posVelErr.positionDecorr.decorrRate, positionDecorrXML);
     }
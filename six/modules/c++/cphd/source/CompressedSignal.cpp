@@ -0,0 +1,334 @@
+/* =========================================================================
+ * This file is part of cphd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * cphd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+#include <cphd/CompressedSignal.h>
+#include <except/Exception.h>
+#include <mt/Runnable1D.h>
+
+namespace
+{
+const size_t WORD_SIZE = 8;
+
+void writeWord(sys::Uint64_T value, sys::ubyte* output)
+{
+    for (size_t ii = WORD_SIZE; ii > 0; --ii)
+    {
+        output[ii - 1] = static_cast<sys::ubyte>(value & 0xFF);
+        value >>= 8;
+    }
+}
+
+sys::Uint64_T readWord(const sys::ubyte* input)
+{
+    sys::Uint64_T value = 0;
+    for (size_t ii = 0; ii < WORD_SIZE; ++ii)
+    {
+        value = (value << 8) | input[ii];
+    }
+    return value;
+}
+
+size_t getNumThreads(size_t numThreads, size_t numBlocks)
+{
+    return std::max<size_t>(std::min(numThreads, numBlocks), 1);
+}
+
+class CompressBlocks
+{
+public:
+    CompressBlocks(const cphd::SignalCodec& codec,
+                   const sys::ubyte* signal,
+                   size_t numVectors,
+                   size_t bytesPerVector,
+                   size_t typeSize,
+                   size_t vectorsPerBlock,
+                   std::vector<std::vector<sys::ubyte> >& blocks) :
+        mCodec(codec),
+        mSignal(signal),
+        mNumVectors(numVectors),
+        mBytesPerVector(bytesPerVector),
+        mTypeSize(typeSize),
+        mVectorsPerBlock(vectorsPerBlock),
+        mBlocks(blocks)
+    {
+    }
+
+    void operator()(size_t block) const
+    {
+        const size_t firstVector = block * mVectorsPerBlock;
+        const size_t numVectors =
+                std::min(mVectorsPerBlock, mNumVectors - firstVector);
+        mCodec.compress(mSignal + firstVector * mBytesPerVector,
+                        numVectors * mBytesPerVector,
+                        mTypeSize,
+                        mBlocks[block]);
+    }
+
+private:
+    const cphd::SignalCodec& mCodec;
+    const sys::ubyte* const mSignal;
+    const size_t mNumVectors;
+    const size_t mBytesPerVector;
+    const size_t mTypeSize;
+    const size_t mVectorsPerBlock;
+    std::vector<std::vector<sys::ubyte> >& mBlocks;
+};
+
+// Decompresses each block that overlaps the requested vectors.  Blocks
+// that are wholly wanted go straight to the output, the others through
+// per-thread scratch.
+class DecompressBlocks
+{
+public:
+    DecompressBlocks(const cphd::SignalCodec& codec,
+                     const sys::ubyte* compressed,
+                     const sys::Uint64_T* blockOffsets,
+                     size_t firstBlock,
+                     size_t numVectors,
+                     size_t vectorsPerBlock,
+                     size_t firstVector,
+                     size_t lastVector,
+                     size_t firstSample,
+                     size_t lastSample,
+                     size_t numSamples,
+                     size_t elementSize,
+                     sys::ubyte* output) :
+        mCodec(codec),
+        mCompressed(compressed),
+        mBlockOffsets(blockOffsets),
+        mFirstBlock(firstBlock),
+        mNumVectors(numVectors),
+        mVectorsPerBlock(vectorsPerBlock),
+        mFirstVector(firstVector),
+        mLastVector(lastVector),
+        mFirstSample(firstSample),
+        mNumOutputSamples(lastSample - firstSample + 1),
+        mNumSamples(numSamples),
+        mElementSize(elementSize),
+        mOutput(output)
+    {
+    }
+
+    void operator()(size_t ii) const
+    {
+        const size_t block = mFirstBlock + ii;
+        const size_t blockStart = block * mVectorsPerBlock;
+        const size_t blockVectors =
+                std::min(mVectorsPerBlock, mNumVectors - blockStart);
+        const size_t blockEnd = blockStart + blockVectors - 1;
+        const size_t bytesPerVector = mNumSamples * mElementSize;
+        const size_t blockSize = blockVectors * bytesPerVector;
+        const sys::ubyte* const input = mCompressed +
+                (mBlockOffsets[block] - mBlockOffsets[mFirstBlock]);
+        const size_t inputSize = static_cast<size_t>(
+                mBlockOffsets[block + 1] - mBlockOffsets[block]);
+        const size_t typeSize = mElementSize / 2;
+
+        const size_t startVector = std::max(blockStart, mFirstVector);
+        const size_t endVector = std::min(blockEnd, mLastVector);
+        const size_t outputBytesPerVector = mNumOutputSamples * mElementSize;
+        sys::ubyte* const output =
+                mOutput + (startVector - mFirstVector) * outputBytesPerVector;
+
+        if (startVector == blockStart && endVector == blockEnd &&
+            mNumOutputSamples == mNumSamples)
+        {
+            mCodec.decompress(input, inputSize, typeSize, output, blockSize);
+            return;
+        }
+
+        mScratch.resize(blockSize);
+        mCodec.decompress(input, inputSize, typeSize, &mScratch[0],
+                          blockSize);
+        for (size_t vector = startVector; vector <= endVector; ++vector)
+        {
+            std::memcpy(output + (vector - startVector) * outputBytesPerVector,
+                        &mScratch[(vector - blockStart) * bytesPerVector +
+                                  mFirstSample * mElementSize],
+                        outputBytesPerVector);
+        }
+    }
+
+private:
+    const cphd::SignalCodec& mCodec;
+    const sys::ubyte* const mCompressed;
+    const sys::Uint64_T* const mBlockOffsets;
+    const size_t mFirstBlock;
+    const size_t mNumVectors;
+    const size_t mVectorsPerBlock;
+    const size_t mFirstVector;
+    const size_t mLastVector;
+    const size_t mFirstSample;
+    const size_t mNumOutputSamples;
+    const size_t mNumSamples;
+    const size_t mElementSize;
+    sys::ubyte* const mOutput;
+    mutable std::vector<sys::ubyte> mScratch;
+};
+}
+
+namespace cphd
+{
+const size_t CompressedSignal::DEFAULT_VECTORS_PER_BLOCK = 64;
+
+void CompressedSignal::compress(const SignalCodec& codec,
+                                const sys::ubyte* signal,
+                                size_t numVectors,
+                                size_t numSamples,
+                                size_t elementSize,
+                                size_t vectorsPerBlock,
+                                size_t numThreads,
+                                std::vector<sys::ubyte>& compressed)
+{
+    if (vectorsPerBlock == 0)
+    {
+        throw except::Exception(Ctxt("Need at least one vector per block"));
+    }
+
+    const size_t numBlocks =
+            (numVectors + vectorsPerBlock - 1) / vectorsPerBlock;
+    std::vector<std::vector<sys::ubyte> > blocks(numBlocks);
+    const CompressBlocks op(codec, signal, numVectors,
+                            numSamples * elementSize, elementSize / 2,
+                            vectorsPerBlock, blocks);
+    mt::run1D(numBlocks, getNumThreads(numThreads, numBlocks), op);
+
+    const size_t headerSize = (numBlocks + 3) * WORD_SIZE;
+    size_t size = headerSize;
+    for (size_t ii = 0; ii < numBlocks; ++ii)
+    {
+        size += blocks[ii].size();
+    }
+
+    compressed.resize(size);
+    writeWord(vectorsPerBlock, &compressed[0]);
+    writeWord(numBlocks, &compressed[WORD_SIZE]);
+    size_t offset = headerSize;
+    for (size_t ii = 0; ii < numBlocks; ++ii)
+    {
+        writeWord(offset, &compressed[(ii + 2) * WORD_SIZE]);
+        if (!blocks[ii].empty())
+        {
+            std::memcpy(&compressed[offset], &blocks[ii][0],
+                        blocks[ii].size());
+        }
+        offset += blocks[ii].size();
+    }
+    writeWord(offset, &compressed[(numBlocks + 2) * WORD_SIZE]);
+}
+
+CompressedSignal::CompressedSignal(io::SeekableInputStream& stream,
+                                   sys::Off_T offset,
+                                   size_t compressedSize,
+                                   size_t numVectors) :
+    mOffset(offset),
+    mNumVectors(numVectors),
+    mVectorsPerBlock(0)
+{
+    if (compressedSize < 2 * WORD_SIZE)
+    {
+        throw except::Exception(Ctxt(
+                "Compressed signal array is too small for a block index"));
+    }
+
+    sys::ubyte words[2 * WORD_SIZE];
+    stream.seek(offset, io::Seekable::START);
+    stream.read(words, sizeof(words));
+    const sys::Uint64_T vectorsPerBlock = readWord(words);
+    const sys::Uint64_T numBlocks = readWord(words + WORD_SIZE);
+    if (vectorsPerBlock == 0 ||
+        numBlocks != (numVectors + vectorsPerBlock - 1) / vectorsPerBlock ||
+        (numBlocks + 3) * WORD_SIZE > compressedSize)
+    {
+        std::ostringstream ostr;
+        ostr << "Block index of " << numBlocks << " blocks of "
+             << vectorsPerBlock << " vectors doesn't fit a compressed "
+             << "signal array of " << numVectors << " vectors and "
+             << compressedSize << " bytes";
+        throw except::Exception(Ctxt(ostr.str()));
+    }
+    mVectorsPerBlock = static_cast<size_t>(vectorsPerBlock);
+
+    std::vector<sys::ubyte> index((numBlocks + 1) * WORD_SIZE);
+    stream.read(&index[0], index.size());
+    mBlockOffsets.resize(numBlocks + 1);
+    for (size_t ii = 0; ii < mBlockOffsets.size(); ++ii)
+    {
+        mBlockOffsets[ii] = readWord(&index[ii * WORD_SIZE]);
+        const sys::Uint64_T previous =
+                ii == 0 ? (numBlocks + 3) * WORD_SIZE : mBlockOffsets[ii - 1];
+        if (mBlockOffsets[ii] < previous || mBlockOffsets[ii] > compressedSize)
+        {
+            throw except::Exception(Ctxt(
+                    "Compressed signal block offsets are out of order"));
+        }
+    }
+}
+
+void CompressedSignal::decompress(const SignalCodec& codec,
+                                  io::SeekableInputStream& stream,
+                                  size_t firstVector,
+                                  size_t lastVector,
+                                  size_t firstSample,
+                                  size_t lastSample,
+                                  size_t numSamples,
+                                  size_t elementSize,
+                                  size_t numThreads,
+                                  sys::ubyte* output) const
+{
+    const size_t firstBlock = firstVector / mVectorsPerBlock;
+    const size_t lastBlock = lastVector / mVectorsPerBlock;
+    const size_t numBlocks = lastBlock - firstBlock + 1;
+
+    // The blocks are contiguous, so this is a single read
+    std::vector<sys::ubyte> compressed(static_cast<size_t>(
+            mBlockOffsets[lastBlock + 1] - mBlockOffsets[firstBlock]));
+    stream.seek(mOffset + static_cast<sys::Off_T>(mBlockOffsets[firstBlock]),
+                io::Seekable::START);
+    if (!compressed.empty())
+    {
+        stream.read(&compressed[0], compressed.size());
+    }
+
+    const size_t threads = getNumThreads(numThreads, numBlocks);
+    const std::vector<DecompressBlocks> ops(
+            threads,
+            DecompressBlocks(codec,
+                             compressed.empty() ? nullptr : &compressed[0],
+                             &mBlockOffsets[0],
+                             firstBlock,
+                             mNumVectors,
+                             mVectorsPerBlock,
+                             firstVector,
+                             lastVector,
+                             firstSample,
+                             lastSample,
+                             numSamples,
+                             elementSize,
+                             output));
+    mt::run1D(numBlocks, threads, ops);
+}
+}
@@ -60,6 +60,11 @@ bool Metadata::isCompressed() const
     return data.isCompressed();
 }
 
+std::string Metadata::getSignalCompressionID() const
+{
+    return data.getCompressionID();
+}
+
 DomainType Metadata::getDomainType() const
 {
     return global.getDomainType();
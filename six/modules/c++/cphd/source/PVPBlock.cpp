@@ -26,6 +26,7 @@
 #include <typeinfo>
 
 #include <six/Init.h>
+#include <six/Instrumentation.h>
 #include <sys/Conf.h>
 #include <cphd/Types.h>
 #include <cphd/PVPBlock.h>
@@ -34,6 +35,9 @@
 
 namespace
 {
+const size_t LOAD_POINT =
+        six::Instrumentation::registerPoint("cphd::PVPBlock::load");
+
 // Set data from data block into data struct
 template <typename T> inline void setData(const sys::byte* data,
                     T& dest)
@@ -152,50 +156,46 @@ void PVPBlock::PVPSet::write(const PVPBlock& pvpBlock, const Pvp& p, const sys::
     }
     for (auto it = p.addedPVP.begin(); it != p.addedPVP.end(); ++it)
     {
-        if (it->second.getFormat() == "F4" || it->second.getFormat() == "F8")
+        const std::string format = it->second.getFormat();
+        six::Parameter& param = addedPVP[it->first];
+        if (format == "F4" || format == "F8")
         {
             double val;
             ::setData(input + it->second.getByteOffset(), val);
-            addedPVP[it->first] = six::Parameter();
-            addedPVP.find(it->first)->second.setValue(val);
+            param.setValue(val);
         }
-        else if (it->second.getFormat() == "U1" || it->second.getFormat() == "U2" ||
-                 it->second.getFormat() == "U4" || it->second.getFormat() == "U8")
+        else if (format == "U1" || format == "U2" ||
+                 format == "U4" || format == "U8")
         {
             unsigned int val;
             ::setData(input + it->second.getByteOffset(), val);
-            addedPVP[it->first] = six::Parameter();
-            addedPVP.find(it->first)->second.setValue(val);
+            param.setValue(val);
         }
-        else if (it->second.getFormat() == "I1" || it->second.getFormat() == "I2" ||
-                 it->second.getFormat() == "I4" || it->second.getFormat() == "I8")
+        else if (format == "I1" || format == "I2" ||
+                 format == "I4" || format == "I8")
         {
             int val;
             ::setData(input + it->second.getByteOffset(), val);
-            addedPVP[it->first] = six::Parameter();
-            addedPVP.find(it->first)->second.setValue(val);
+            param.setValue(val);
         }
-        else if (it->second.getFormat() == "CI2" || it->second.getFormat() == "CI4" ||
-                 it->second.getFormat() == "CI8" || it->second.getFormat() == "CI16")
+        else if (format == "CI2" || format == "CI4" ||
+                 format == "CI8" || format == "CI16")
         {
             std::complex<int> val;
             ::setData(input + it->second.getByteOffset(), val);
-            addedPVP[it->first] = six::Parameter();
-            addedPVP.find(it->first)->second.setValue(val);
+            param.setValue(val);
         }
-        else if (it->second.getFormat() == "CF8" || it->second.getFormat() == "CF16")
+        else if (format == "CF8" || format == "CF16")
         {
             std::complex<double> val;
             ::setData(input + it->second.getByteOffset(), val);
-            addedPVP[it->first] = six::Parameter();
-            addedPVP.find(it->first)->second.setValue(val);
+            param.setValue(val);
         }
         else
         {
             std::string val;
             val.assign(input + it->second.getByteOffset(), it->second.getByteSize());
-            addedPVP[it->first] = six::Parameter();
-            addedPVP.find(it->first)->second.setValue(val);
+            param.setValue(val);
         }
     }
 }
@@ -255,32 +255,34 @@ void PVPBlock::PVPSet::read(const Pvp& p, sys::ubyte* dest) const
     }
     for (auto it = p.addedPVP.begin(); it != p.addedPVP.end(); ++it)
     {
-        if (it->second.getFormat() == "F4" || it->second.getFormat() == "F8")
+        const std::string format = it->second.getFormat();
+        const six::Parameter& param = addedPVP.find(it->first)->second;
+        if (format == "F4" || format == "F8")
         {
-            ::getData(dest + it->second.getByteOffset(), static_cast<double>(addedPVP.find(it->first)->second));
+            ::getData(dest + it->second.getByteOffset(), static_cast<double>(param));
         }
-        else if (it->second.getFormat() == "U1" || it->second.getFormat() == "U2" ||
-                 it->second.getFormat() == "U4" || it->second.getFormat() == "U8")
+        else if (format == "U1" || format == "U2" ||
+                 format == "U4" || format == "U8")
         {
-            ::getData(dest + it->second.getByteOffset(), static_cast<unsigned int>(addedPVP.find(it->first)->second));
+            ::getData(dest + it->second.getByteOffset(), static_cast<unsigned int>(param));
         }
-        else if (it->second.getFormat() == "I1" || it->second.getFormat() == "I2" ||
-                 it->second.getFormat() == "I4" || it->second.getFormat() == "I8")
+        else if (format == "I1" || format == "I2" ||
+                 format == "I4" || format == "I8")
         {
-            ::getData(dest + it->second.getByteOffset(), static_cast<int>(addedPVP.find(it->first)->second));
+            ::getData(dest + it->second.getByteOffset(), static_cast<int>(param));
         }
-        else if (it->second.getFormat() == "CI2" || it->second.getFormat() == "CI4" ||
-                 it->second.getFormat() == "CI8" || it->second.getFormat() == "CI16")
+        else if (format == "CI2" || format == "CI4" ||
+                 format == "CI8" || format == "CI16")
         {
-            ::getData(dest + it->second.getByteOffset(), addedPVP.find(it->first)->second.getComplex<int>());
+            ::getData(dest + it->second.getByteOffset(), param.getComplex<int>());
         }
-        else if (it->second.getFormat() == "CF8" || it->second.getFormat() == "CF16")
+        else if (format == "CF8" || format == "CF16")
         {
-            ::getData(dest + it->second.getByteOffset(), addedPVP.find(it->first)->second.getComplex<double>());
+            ::getData(dest + it->second.getByteOffset(), param.getComplex<double>());
         }
         else
         {
-            ::getData(dest + it->second.getByteOffset(), addedPVP.find(it->first)->second.str().c_str(), it->second.getByteSize());
+            ::getData(dest + it->second.getByteOffset(), param.str().c_str(), it->second.getByteSize());
         }
     }
 }
@@ -449,6 +451,8 @@ sys::Off_T PVPBlock::load(io::SeekableInputStream& inStream,
     }
 
     const bool swapToLittleEndian = !(sys::isBigEndianSystem());
+    six::InstrumentationTimer timer(LOAD_POINT, numBytesIn);
+    timer.addSeeks(1);
 
     // Seek to start of PVPBlock
     size_t totalBytesRead(0);
@@ -0,0 +1,1068 @@
+/* =========================================================================
+ * This file is part of cphd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * cphd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <sstream>
+
+#include <except/Exception.h>
+#include <mt/ThreadGroup.h>
+#include <mt/ThreadPlanner.h>
+#include <sys/Runnable.h>
+#include <six/Init.h>
+#include <cphd/ByteSwap.h>
+#include <cphd/PVPValidator.h>
+
+namespace
+{
+enum Rule
+{
+    FINITE_VALUES,
+    TX_TIME_INCREASING,
+    RCV_TIME_INCREASING,
+    RCV_AFTER_TX,
+    TIMELINE,
+    FX_ORDER,
+    GLOBAL_FX_BAND,
+    CHANNEL_FX_BAND,
+    FX_FIXED,
+    TOA_ORDER,
+    TOA_SWATH,
+    TOA_FIXED,
+    TOA_EXTENDED,
+    SRP_FIXED,
+    SAMPLE_SPACING,
+    SAMPLED_EXTENT,
+    AMP_SF,
+    SIGNAL_VALUES,
+    SIGNAL_NORMAL,
+    NUM_RULES
+};
+
+const char* const RULE_NAMES[NUM_RULES] =
+{
+    "FiniteValues",
+    "TxTimeIncreasing",
+    "RcvTimeIncreasing",
+    "RcvAfterTx",
+    "Timeline",
+    "FXOrder",
+    "GlobalFxBand",
+    "ChannelFxBand",
+    "FXFixed",
+    "TOAOrder",
+    "TOASwath",
+    "TOAFixed",
+    "TOAExtended",
+    "SRPFixed",
+    "SampleSpacing",
+    "SampledExtent",
+    "AmpSF",
+    "SignalValues",
+    "SignalNormal"
+};
+
+// Metadata is written with limited precision, so bounds from it are only
+// good to about this relative to the values being bounded
+const double TOLERANCE = 1e-9;
+
+bool isSet(const cphd::PVPType& type)
+{
+    return !six::Init::isUndefined<size_t>(type.getOffset());
+}
+
+bool isTrue(six::BooleanType value)
+{
+    return value == six::BooleanType::IS_TRUE;
+}
+
+bool isAtMost(double lhs, double rhs)
+{
+    return lhs <= rhs + TOLERANCE * std::max(std::abs(lhs), std::abs(rhs));
+}
+
+bool isClose(double lhs, double rhs, double scale)
+{
+    return std::abs(lhs - rhs) <= TOLERANCE * scale;
+}
+
+double getDouble(const sys::ubyte* data)
+{
+    double value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+// SIGNAL may be an integer
+double getSignal(const sys::ubyte* data, const std::string& format)
+{
+    if (!format.empty() && format[0] == 'F')
+    {
+        return getDouble(data);
+    }
+    if (!format.empty() && format[0] == 'U')
+    {
+        sys::Uint64_T value;
+        std::memcpy(&value, data, sizeof(value));
+        return static_cast<double>(value);
+    }
+    sys::Int64_T value;
+    std::memcpy(&value, data, sizeof(value));
+    return static_cast<double>(value);
+}
+
+void checkPositive(const std::vector<double>& values,
+                   size_t start,
+                   size_t end,
+                   size_t firstVector,
+                   cphd::VectorRanges& ranges)
+{
+    for (size_t ii = start; ii < end; ++ii)
+    {
+        if (!(values[ii] > 0))
+        {
+            ranges.add(firstVector + ii);
+        }
+    }
+}
+
+void checkOrder(const std::vector<double>& lower,
+                const std::vector<double>& upper,
+                size_t start,
+                size_t end,
+                size_t firstVector,
+                cphd::VectorRanges& ranges)
+{
+    for (size_t ii = start; ii < end; ++ii)
+    {
+        if (!(lower[ii] < upper[ii]))
+        {
+            ranges.add(firstVector + ii);
+        }
+    }
+}
+
+// lowerBound <= lower and upper <= upperBound
+void checkWithin(const std::vector<double>& lower,
+                 const std::vector<double>& upper,
+                 double lowerBound,
+                 double upperBound,
+                 size_t start,
+                 size_t end,
+                 size_t firstVector,
+                 cphd::VectorRanges& ranges)
+{
+    for (size_t ii = start; ii < end; ++ii)
+    {
+        if (!isAtMost(lowerBound, lower[ii]) ||
+            !isAtMost(upper[ii], upperBound))
+        {
+            ranges.add(firstVector + ii);
+        }
+    }
+}
+
+void checkFixed(const std::vector<double>& first,
+                const std::vector<double>& second,
+                double firstReference,
+                double secondReference,
+                size_t start,
+                size_t end,
+                size_t firstVector,
+                cphd::VectorRanges& ranges)
+{
+    for (size_t ii = start; ii < end; ++ii)
+    {
+        if (first[ii] != firstReference || second[ii] != secondReference)
+        {
+            ranges.add(firstVector + ii);
+        }
+    }
+}
+
+void checkIncreasing(const std::vector<double>& values,
+                     bool hasPrevious,
+                     double previous,
+                     size_t start,
+                     size_t end,
+                     size_t firstVector,
+                     cphd::VectorRanges& ranges)
+{
+    for (size_t ii = start; ii < end; ++ii)
+    {
+        if (ii == 0 && !hasPrevious)
+        {
+            continue;
+        }
+        const double last = ii == 0 ? previous : values[ii - 1];
+        if (!(values[ii] > last))
+        {
+            ranges.add(firstVector + ii);
+        }
+    }
+}
+}
+
+namespace cphd
+{
+const size_t VectorRanges::MAX_RANGES = 100;
+
+VectorRanges::VectorRanges() :
+    numVectors(0),
+    truncated(false)
+{
+}
+
+void VectorRanges::add(size_t vector)
+{
+    ++numVectors;
+    if (!ranges.empty() && ranges.back().second + 1 == vector)
+    {
+        ranges.back().second = vector;
+    }
+    else if (ranges.size() < MAX_RANGES)
+    {
+        ranges.push_back(std::make_pair(vector, vector));
+    }
+    else
+    {
+        truncated = true;
+    }
+}
+
+void VectorRanges::append(const VectorRanges& other)
+{
+    numVectors += other.numVectors;
+    truncated = truncated || other.truncated;
+    for (size_t ii = 0; ii < other.ranges.size(); ++ii)
+    {
+        if (!ranges.empty() &&
+            ranges.back().second + 1 == other.ranges[ii].first)
+        {
+            ranges.back().second = other.ranges[ii].second;
+        }
+        else if (ranges.size() < MAX_RANGES)
+        {
+            ranges.push_back(other.ranges[ii]);
+        }
+        else
+        {
+            truncated = true;
+        }
+    }
+}
+
+bool PVPValidation::isValid() const
+{
+    if (!errors.empty())
+    {
+        return false;
+    }
+    for (size_t ii = 0; ii < channels.size(); ++ii)
+    {
+        if (!channels[ii].empty())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::ostream& operator<<(std::ostream& os, const PVPValidation& validation)
+{
+    for (size_t ii = 0; ii < validation.errors.size(); ++ii)
+    {
+        os << validation.errors[ii] << "\n";
+    }
+
+    for (size_t ii = 0; ii < validation.channels.size(); ++ii)
+    {
+        for (auto it = validation.channels[ii].begin();
+             it != validation.channels[ii].end();
+             ++it)
+        {
+            const VectorRanges& ranges = it->second;
+            os << "Channel " << ii << " " << it->first << ": "
+               << ranges.numVectors << " vectors";
+            for (size_t jj = 0; jj < ranges.ranges.size(); ++jj)
+            {
+                os << (jj == 0 ? " [" : ", ") << ranges.ranges[jj].first;
+                if (ranges.ranges[jj].second != ranges.ranges[jj].first)
+                {
+                    os << "-" << ranges.ranges[jj].second;
+                }
+            }
+            if (!ranges.ranges.empty())
+            {
+                os << (ranges.truncated ? ", ...]" : "]");
+            }
+            os << "\n";
+        }
+    }
+
+    if (validation.isValid())
+    {
+        os << "PVPs are consistent\n";
+    }
+    return os;
+}
+
+// One array per parameter, for a block of vectors
+struct PVPValidator::Columns
+{
+    void resize(size_t size)
+    {
+        txTime.resize(size);
+        rcvTime.resize(size);
+        fx1.resize(size);
+        fx2.resize(size);
+        toa1.resize(size);
+        toa2.resize(size);
+        toaE1.resize(size);
+        toaE2.resize(size);
+        sc0.resize(size);
+        scss.resize(size);
+        ampSF.resize(size);
+        signal.resize(size);
+        srpPos.resize(size);
+        finite.resize(size);
+    }
+
+    std::vector<double> txTime;
+    std::vector<double> rcvTime;
+    std::vector<double> fx1;
+    std::vector<double> fx2;
+    std::vector<double> toa1;
+    std::vector<double> toa2;
+    std::vector<double> toaE1;
+    std::vector<double> toaE2;
+    std::vector<double> sc0;
+    std::vector<double> scss;
+    std::vector<double> ampSF;
+    std::vector<double> signal;
+    std::vector<Vector3> srpPos;
+    std::vector<sys::ubyte> finite;
+};
+
+// What's carried from block to block of a channel
+struct PVPValidator::ChannelState
+{
+    ChannelState() :
+        numVectors(0),
+        minFx1(std::numeric_limits<double>::infinity()),
+        maxFx2(-std::numeric_limits<double>::infinity()),
+        minToa1(std::numeric_limits<double>::infinity()),
+        maxToa2(-std::numeric_limits<double>::infinity()),
+        minToaE1(std::numeric_limits<double>::infinity()),
+        maxToaE2(-std::numeric_limits<double>::infinity()),
+        fxConstant(true),
+        toaConstant(true),
+        srpConstant(true),
+        anySignalZero(false),
+        previousTxTime(0),
+        previousRcvTime(0),
+        firstFx1(0),
+        firstFx2(0),
+        firstToa1(0),
+        firstToa2(0)
+    {
+    }
+
+    void update(const Columns& columns, size_t size, bool hasToaE,
+                bool hasSignal)
+    {
+        if (numVectors == 0)
+        {
+            firstFx1 = columns.fx1[0];
+            firstFx2 = columns.fx2[0];
+            firstToa1 = columns.toa1[0];
+            firstToa2 = columns.toa2[0];
+            firstSRPPos = columns.srpPos[0];
+        }
+
+        for (size_t ii = 0; ii < size; ++ii)
+        {
+            minFx1 = std::min(minFx1, columns.fx1[ii]);
+            maxFx2 = std::max(maxFx2, columns.fx2[ii]);
+            minToa1 = std::min(minToa1, columns.toa1[ii]);
+            maxToa2 = std::max(maxToa2, columns.toa2[ii]);
+            fxConstant = fxConstant && columns.fx1[ii] == firstFx1 &&
+                    columns.fx2[ii] == firstFx2;
+            toaConstant = toaConstant && columns.toa1[ii] == firstToa1 &&
+                    columns.toa2[ii] == firstToa2;
+            srpConstant = srpConstant && columns.srpPos[ii] == firstSRPPos;
+        }
+        if (hasToaE)
+        {
+            for (size_t ii = 0; ii < size; ++ii)
+            {
+                minToaE1 = std::min(minToaE1, columns.toaE1[ii]);
+                maxToaE2 = std::max(maxToaE2, columns.toaE2[ii]);
+            }
+        }
+        if (hasSignal)
+        {
+            for (size_t ii = 0; ii < size && !anySignalZero; ++ii)
+            {
+                anySignalZero = columns.signal[ii] == 0;
+            }
+        }
+
+        numVectors += size;
+        previousTxTime = columns.txTime[size - 1];
+        previousRcvTime = columns.rcvTime[size - 1];
+    }
+
+    size_t numVectors;
+    double minFx1;
+    double maxFx2;
+    double minToa1;
+    double maxToa2;
+    double minToaE1;
+    double maxToaE2;
+    bool fxConstant;
+    bool toaConstant;
+    bool srpConstant;
+    bool anySignalZero;
+    double previousTxTime;
+    double previousRcvTime;
+    double firstFx1;
+    double firstFx2;
+    double firstToa1;
+    double firstToa2;
+    Vector3 firstSRPPos;
+};
+}
+
+namespace
+{
+// Pulls each parameter of a range of vectors out of the PVP sets
+class GatherColumns : public sys::Runnable
+{
+public:
+    GatherColumns(const cphd::Pvp& pvp,
+                  const std::vector<size_t>& floatOffsets,
+                  const sys::ubyte* pvpData,
+                  size_t numBytesPerVector,
+                  size_t start,
+                  size_t numVectors,
+                  std::vector<double>* const* columns,
+                  const size_t* columnOffsets,
+                  size_t numColumns,
+                  std::vector<cphd::Vector3>& srpPos,
+                  std::vector<double>& signal,
+                  std::vector<sys::ubyte>& finite) :
+        mPvp(pvp),
+        mFloatOffsets(floatOffsets),
+        mPVPData(pvpData),
+        mNumBytesPerVector(numBytesPerVector),
+        mStart(start),
+        mEnd(start + numVectors),
+        mColumns(columns),
+        mColumnOffsets(columnOffsets),
+        mNumColumns(numColumns),
+        mSRPPos(srpPos),
+        mSignal(signal),
+        mFinite(finite)
+    {
+    }
+
+    void run() override
+    {
+        for (size_t column = 0; column < mNumColumns; ++column)
+        {
+            std::vector<double>& values = *mColumns[column];
+            const sys::ubyte* data = mPVPData + mColumnOffsets[column] +
+                    mStart * mNumBytesPerVector;
+            for (size_t ii = mStart; ii < mEnd;
+                 ++ii, data += mNumBytesPerVector)
+            {
+                values[ii] = getDouble(data);
+            }
+        }
+
+        const sys::ubyte* vector = mPVPData + mStart * mNumBytesPerVector;
+        const size_t srpOffset = mPvp.srpPos.getByteOffset();
+        const bool hasSignal = isSet(mPvp.signal);
+        const std::string signalFormat = mPvp.signal.getFormat();
+        for (size_t ii = mStart; ii < mEnd;
+             ++ii, vector += mNumBytesPerVector)
+        {
+            for (size_t jj = 0; jj < 3; ++jj)
+            {
+                mSRPPos[ii][jj] =
+                        getDouble(vector + srpOffset + jj * sizeof(double));
+            }
+            if (hasSignal)
+            {
+                mSignal[ii] = getSignal(
+                        vector + mPvp.signal.getByteOffset(), signalFormat);
+            }
+
+            bool finite = true;
+            for (size_t jj = 0; jj < mFloatOffsets.size() && finite; ++jj)
+            {
+                finite = std::isfinite(
+                        getDouble(vector + mFloatOffsets[jj]));
+            }
+            mFinite[ii] = finite;
+        }
+    }
+
+private:
+    const cphd::Pvp& mPvp;
+    const std::vector<size_t>& mFloatOffsets;
+    const sys::ubyte* const mPVPData;
+    const size_t mNumBytesPerVector;
+    const size_t mStart;
+    const size_t mEnd;
+    std::vector<double>* const* const mColumns;
+    const size_t* const mColumnOffsets;
+    const size_t mNumColumns;
+    std::vector<cphd::Vector3>& mSRPPos;
+    std::vector<double>& mSignal;
+    std::vector<sys::ubyte>& mFinite;
+};
+
+// The information the checks need besides the columns
+struct CheckContext
+{
+    const cphd::Metadata* metadata;
+    const cphd::ChannelParameter* parameter;
+    size_t numSamples;
+    size_t firstVector;
+    bool hasPrevious;
+    double previousTxTime;
+    double previousRcvTime;
+    double firstFx1;
+    double firstFx2;
+    double firstToa1;
+    double firstToa2;
+    cphd::Vector3 firstSRPPos;
+    bool hasAmpSF;
+    bool hasToaE;
+    bool hasSignal;
+};
+
+// Runs every rule over a range of vectors, one column scan at a time
+template <typename ColumnsT>
+class CheckVectors : public sys::Runnable
+{
+public:
+    CheckVectors(const ColumnsT& columns,
+                 const CheckContext& context,
+                 size_t start,
+                 size_t numVectors,
+                 std::vector<cphd::VectorRanges>& results) :
+        mColumns(columns),
+        mContext(context),
+        mStart(start),
+        mEnd(start + numVectors),
+        mResults(results)
+    {
+    }
+
+    void run() override
+    {
+        const cphd::Metadata& metadata = *mContext.metadata;
+        const cphd::ChannelParameter& parameter = *mContext.parameter;
+        const size_t first = mContext.firstVector;
+
+        for (size_t ii = mStart; ii < mEnd; ++ii)
+        {
+            if (!mColumns.finite[ii])
+            {
+                mResults[FINITE_VALUES].add(first + ii);
+            }
+        }
+
+        // Timing
+        checkIncreasing(mColumns.txTime, mContext.hasPrevious,
+                        mContext.previousTxTime, mStart, mEnd, first,
+                        mResults[TX_TIME_INCREASING]);
+        checkIncreasing(mColumns.rcvTime, mContext.hasPrevious,
+                        mContext.previousRcvTime, mStart, mEnd, first,
+                        mResults[RCV_TIME_INCREASING]);
+        checkOrder(mColumns.txTime, mColumns.rcvTime, mStart, mEnd, first,
+                   mResults[RCV_AFTER_TX]);
+        checkWithin(mColumns.txTime, mColumns.txTime,
+                    metadata.global.timeline.txTime1,
+                    metadata.global.timeline.txTime2,
+                    mStart, mEnd, first, mResults[TIMELINE]);
+
+        // Frequency extent
+        checkOrder(mColumns.fx1, mColumns.fx2, mStart, mEnd, first,
+                   mResults[FX_ORDER]);
+        checkWithin(mColumns.fx1, mColumns.fx2,
+                    metadata.global.fxBand.fxMin,
+                    metadata.global.fxBand.fxMax,
+                    mStart, mEnd, first, mResults[GLOBAL_FX_BAND]);
+        checkWithin(mColumns.fx1, mColumns.fx2,
+                    parameter.fxC - parameter.fxBW / 2,
+                    parameter.fxC + parameter.fxBW / 2,
+                    mStart, mEnd, first, mResults[CHANNEL_FX_BAND]);
+        if (isTrue(parameter.fxFixed))
+        {
+            checkFixed(mColumns.fx1, mColumns.fx2, mContext.firstFx1,
+                       mContext.firstFx2, mStart, mEnd, first,
+                       mResults[FX_FIXED]);
+        }
+
+        // TOA extent
+        checkOrder(mColumns.toa1, mColumns.toa2, mStart, mEnd, first,
+                   mResults[TOA_ORDER]);
+        checkWithin(mColumns.toa1, mColumns.toa2,
+                    metadata.global.toaSwath.toaMin,
+                    metadata.global.toaSwath.toaMax,
+                    mStart, mEnd, first, mResults[TOA_SWATH]);
+        if (isTrue(parameter.toaFixed))
+        {
+            checkFixed(mColumns.toa1, mColumns.toa2, mContext.firstToa1,
+                       mContext.firstToa2, mStart, mEnd, first,
+                       mResults[TOA_FIXED]);
+        }
+        if (mContext.hasToaE)
+        {
+            for (size_t ii = mStart; ii < mEnd; ++ii)
+            {
+                if (!isAtMost(mColumns.toaE1[ii], mColumns.toa1[ii]) ||
+                    !isAtMost(mColumns.toa2[ii], mColumns.toaE2[ii]))
+                {
+                    mResults[TOA_EXTENDED].add(first + ii);
+                }
+            }
+        }
+
+        if (isTrue(parameter.srpFixed))
+        {
+            for (size_t ii = mStart; ii < mEnd; ++ii)
+            {
+                if (mColumns.srpPos[ii] != mContext.firstSRPPos)
+                {
+                    mResults[SRP_FIXED].add(first + ii);
+                }
+            }
+        }
+
+        // Sampling
+        checkPositive(mColumns.scss, mStart, mEnd, first,
+                      mResults[SAMPLE_SPACING]);
+        const bool isFX = metadata.global.getDomainType() ==
+                cphd::DomainType::FX;
+        const std::vector<double>& lower = isFX ? mColumns.fx1 : mColumns.toa1;
+        const std::vector<double>& upper = isFX ? mColumns.fx2 : mColumns.toa2;
+        const double lastSample =
+                static_cast<double>(mContext.numSamples - 1);
+        for (size_t ii = mStart; ii < mEnd; ++ii)
+        {
+            const double halfSample = std::abs(mColumns.scss[ii]) / 2;
+            const double sampledLower = mColumns.sc0[ii] - halfSample;
+            const double sampledUpper =
+                    mColumns.sc0[ii] + lastSample * mColumns.scss[ii] +
+                    halfSample;
+            if (!isAtMost(sampledLower, lower[ii]) ||
+                !isAtMost(upper[ii], sampledUpper))
+            {
+                mResults[SAMPLED_EXTENT].add(first + ii);
+            }
+        }
+
+        if (mContext.hasAmpSF)
+        {
+            checkPositive(mColumns.ampSF, mStart, mEnd, first,
+                          mResults[AMP_SF]);
+        }
+
+        if (mContext.hasSignal)
+        {
+            const bool normal = isTrue(parameter.signalNormal);
+            for (size_t ii = mStart; ii < mEnd; ++ii)
+            {
+                const double signal = mColumns.signal[ii];
+                if (signal != 0 && signal != 1)
+                {
+                    mResults[SIGNAL_VALUES].add(first + ii);
+                }
+                if (normal && signal != 1)
+                {
+                    mResults[SIGNAL_NORMAL].add(first + ii);
+                }
+            }
+        }
+    }
+
+private:
+    const ColumnsT& mColumns;
+    const CheckContext& mContext;
+    const size_t mStart;
+    const size_t mEnd;
+    std::vector<cphd::VectorRanges>& mResults;
+};
+
+template <typename RunnableT, typename MakeT>
+void runThreads(size_t numElements, size_t numThreads, const MakeT& make)
+{
+    if (numThreads <= 1)
+    {
+        std::unique_ptr<RunnableT> runnable(make(0, 0, numElements));
+        runnable->run();
+        return;
+    }
+
+    mt::ThreadGroup threads;
+    const mt::ThreadPlanner planner(numElements, numThreads);
+    size_t threadNum(0);
+    size_t startElement(0);
+    size_t numElementsThisThread(0);
+    while (planner.getThreadInfo(threadNum, startElement,
+                                 numElementsThisThread))
+    {
+        threads.createThread(
+                make(threadNum, startElement, numElementsThisThread));
+        ++threadNum;
+    }
+    threads.joinAll();
+}
+}
+
+namespace cphd
+{
+const size_t PVPValidator::DEFAULT_BLOCK_SIZE = 4 * 1024 * 1024;
+
+PVPValidator::PVPValidator(const Metadata& metadata,
+                           size_t numThreads,
+                           size_t blockSize) :
+    mMetadata(metadata),
+    mNumThreads(std::max<size_t>(numThreads, 1)),
+    mBlockSize(blockSize)
+{
+    if (mMetadata.channel.parameters.size() !=
+        mMetadata.data.getNumChannels())
+    {
+        throw except::Exception(Ctxt(
+                "Channel parameters don't match the data channels"));
+    }
+}
+
+size_t PVPValidator::getVectorsPerBlock() const
+{
+    return std::max<size_t>(
+            mBlockSize / mMetadata.data.getNumBytesPVPSet(), 1);
+}
+
+void PVPValidator::validateBlock(
+        size_t channel,
+        size_t firstVector,
+        size_t numVectors,
+        const sys::ubyte* pvpData,
+        Columns& columns,
+        ChannelState& state,
+        std::map<std::string, VectorRanges>& results) const
+{
+    const Pvp& pvp = mMetadata.pvp;
+    const bool hasAmpSF = isSet(pvp.ampSF);
+    const bool hasToaE = isSet(pvp.toaE1) && isSet(pvp.toaE2);
+    const bool hasSignal = isSet(pvp.signal);
+
+    // Every floating point word, for FiniteValues
+    std::vector<size_t> floatOffsets;
+    const PVPType* const floats[] =
+    {
+        &pvp.txTime, &pvp.txPos, &pvp.txVel, &pvp.rcvTime, &pvp.rcvPos,
+        &pvp.rcvVel, &pvp.srpPos, &pvp.aFDOP, &pvp.aFRR1, &pvp.aFRR2,
+        &pvp.fx1, &pvp.fx2, &pvp.toa1, &pvp.toa2, &pvp.tdTropoSRP,
+        &pvp.sc0, &pvp.scss, &pvp.ampSF, &pvp.fxN1, &pvp.fxN2, &pvp.toaE1,
+        &pvp.toaE2, &pvp.tdIonoSRP
+    };
+    for (size_t ii = 0; ii < sizeof(floats) / sizeof(floats[0]); ++ii)
+    {
+        if (isSet(*floats[ii]))
+        {
+            for (size_t jj = 0; jj < floats[ii]->getSize(); ++jj)
+            {
+                floatOffsets.push_back(floats[ii]->getByteOffset() +
+                                       jj * PVPType::WORD_BYTE_SIZE);
+            }
+        }
+    }
+
+    std::vector<std::vector<double>*> columnPointers;
+    std::vector<size_t> columnOffsets;
+    const std::pair<std::vector<double>*, const PVPType*> scalars[] =
+    {
+        std::make_pair(&columns.txTime, &pvp.txTime),
+        std::make_pair(&columns.rcvTime, &pvp.rcvTime),
+        std::make_pair(&columns.fx1, &pvp.fx1),
+        std::make_pair(&columns.fx2, &pvp.fx2),
+        std::make_pair(&columns.toa1, &pvp.toa1),
+        std::make_pair(&columns.toa2, &pvp.toa2),
+        std::make_pair(&columns.sc0, &pvp.sc0),
+        std::make_pair(&columns.scss, &pvp.scss),
+        std::make_pair(&columns.ampSF, &pvp.ampSF),
+        std::make_pair(&columns.toaE1, &pvp.toaE1),
+        std::make_pair(&columns.toaE2, &pvp.toaE2)
+    };
+    for (size_t ii = 0; ii < sizeof(scalars) / sizeof(scalars[0]); ++ii)
+    {
+        if (isSet(*scalars[ii].second))
+        {
+            columnPointers.push_back(scalars[ii].first);
+            columnOffsets.push_back(scalars[ii].second->getByteOffset());
+        }
+    }
+
+    columns.resize(numVectors);
+    const size_t numBytesPerVector = mMetadata.data.getNumBytesPVPSet();
+    runThreads<GatherColumns>(
+            numVectors, mNumThreads,
+            [&](size_t , size_t start, size_t count)
+            {
+                return new GatherColumns(pvp, floatOffsets, pvpData,
+                                         numBytesPerVector, start, count,
+                                         &columnPointers[0],
+                                         &columnOffsets[0],
+                                         columnPointers.size(),
+                                         columns.srpPos, columns.signal,
+                                         columns.finite);
+            });
+
+    CheckContext context;
+    context.metadata = &mMetadata;
+    context.parameter = &mMetadata.channel.parameters[channel];
+    context.numSamples = mMetadata.data.getNumSamples(channel);
+    context.firstVector = firstVector;
+    context.hasPrevious = state.numVectors != 0;
+    context.previousTxTime = state.previousTxTime;
+    context.previousRcvTime = state.previousRcvTime;
+    const bool isFirst = state.numVectors == 0;
+    context.firstFx1 = isFirst ? columns.fx1[0] : state.firstFx1;
+    context.firstFx2 = isFirst ? columns.fx2[0] : state.firstFx2;
+    context.firstToa1 = isFirst ? columns.toa1[0] : state.firstToa1;
+    context.firstToa2 = isFirst ? columns.toa2[0] : state.firstToa2;
+    context.firstSRPPos = isFirst ? columns.srpPos[0] : state.firstSRPPos;
+    context.hasAmpSF = hasAmpSF;
+    context.hasToaE = hasToaE;
+    context.hasSignal = hasSignal;
+
+    std::vector<std::vector<VectorRanges> > threadResults(
+            mNumThreads, std::vector<VectorRanges>(NUM_RULES));
+    runThreads<CheckVectors<Columns> >(
+            numVectors, mNumThreads,
+            [&](size_t thread, size_t start, size_t count)
+            {
+                return new CheckVectors<Columns>(columns, context, start,
+                                                 count,
+                                                 threadResults[thread]);
+            });
+
+    // Threads got consecutive ranges, so this keeps the vectors in order
+    for (size_t ii = 0; ii < threadResults.size(); ++ii)
+    {
+        for (size_t rule = 0; rule < NUM_RULES; ++rule)
+        {
+            if (threadResults[ii][rule].numVectors != 0)
+            {
+                results[RULE_NAMES[rule]].append(threadResults[ii][rule]);
+            }
+        }
+    }
+
+    state.update(columns, numVectors, hasToaE, hasSignal);
+}
+
+void PVPValidator::validateChannel(size_t channel,
+                                   const ChannelState& state,
+                                   std::vector<std::string>& errors) const
+{
+    if (state.numVectors == 0)
+    {
+        return;
+    }
+
+    const ChannelParameter& parameter = mMetadata.channel.parameters[channel];
+    std::ostringstream prefix;
+    prefix << "Channel " << channel << ": ";
+
+    const double fxScale =
+            std::max(std::abs(state.minFx1), std::abs(state.maxFx2));
+    if (!isClose(parameter.fxC, (state.minFx1 + state.maxFx2) / 2, fxScale) ||
+        !isClose(parameter.fxBW, state.maxFx2 - state.minFx1, fxScale))
+    {
+        std::ostringstream ostr;
+        ostr << prefix.str() << "FxC " << parameter.fxC << " and FxBW "
+             << parameter.fxBW << " don't match the FX1 to FX2 extent "
+             << state.minFx1 << " to " << state.maxFx2;
+        errors.push_back(ostr.str());
+    }
+
+    const double toaScale =
+            std::max(std::abs(state.minToa1), std::abs(state.maxToa2));
+    if (!isClose(parameter.toaSaved, state.maxToa2 - state.minToa1, toaScale))
+    {
+        std::ostringstream ostr;
+        ostr << prefix.str() << "TOASaved " << parameter.toaSaved
+             << " isn't the width of the TOA1 to TOA2 extent "
+             << state.minToa1 << " to " << state.maxToa2;
+        errors.push_back(ostr.str());
+    }
+
+    if (parameter.toaExtended.get() &&
+        isSet(mMetadata.pvp.toaE1) && isSet(mMetadata.pvp.toaE2))
+    {
+        const double scale =
+                std::max(std::abs(state.minToaE1), std::abs(state.maxToaE2));
+        if (!isClose(parameter.toaExtended->toaExtSaved,
+                     state.maxToaE2 - state.minToaE1, scale))
+        {
+            std::ostringstream ostr;
+            ostr << prefix.str() << "TOAExtSaved "
+                 << parameter.toaExtended->toaExtSaved
+                 << " isn't the width of the TOAE1 to TOAE2 extent "
+                 << state.minToaE1 << " to " << state.maxToaE2;
+            errors.push_back(ostr.str());
+        }
+    }
+
+    if (!isTrue(parameter.fxFixed) && state.fxConstant)
+    {
+        errors.push_back(prefix.str() +
+                         "FXFixed is false but FX1 and FX2 are constant");
+    }
+    if (!isTrue(parameter.toaFixed) && state.toaConstant)
+    {
+        errors.push_back(prefix.str() +
+                         "TOAFixed is false but TOA1 and TOA2 are constant");
+    }
+    if (!isTrue(parameter.srpFixed) && state.srpConstant)
+    {
+        errors.push_back(prefix.str() +
+                         "SRPFixed is false but SRPPos is constant");
+    }
+    if (isSet(mMetadata.pvp.signal) &&
+        parameter.signalNormal == six::BooleanType::IS_FALSE &&
+        !state.anySignalZero)
+    {
+        errors.push_back(prefix.str() +
+                         "SignalNormal is false but no SIGNAL is 0");
+    }
+}
+
+void PVPValidator::validateMetadata(std::vector<std::string>& errors) const
+{
+    const bool hasSignal = isSet(mMetadata.pvp.signal);
+    for (size_t ii = 0; ii < mMetadata.channel.parameters.size(); ++ii)
+    {
+        const bool hasSignalNormal = !six::Init::isUndefined(
+                mMetadata.channel.parameters[ii].signalNormal);
+        if (hasSignal != hasSignalNormal)
+        {
+            std::ostringstream ostr;
+            ostr << "Channel " << ii << ": SignalNormal is "
+                 << (hasSignalNormal ? "given" : "missing")
+                 << " but the SIGNAL PVP is "
+                 << (hasSignal ? "present" : "absent");
+            errors.push_back(ostr.str());
+        }
+    }
+}
+
+PVPValidation PVPValidator::validate(const PVPBlock& pvpBlock) const
+{
+    PVPValidation validation;
+    validateMetadata(validation.errors);
+
+    const size_t numChannels = mMetadata.data.getNumChannels();
+    const size_t numBytesPerVector = mMetadata.data.getNumBytesPVPSet();
+    const size_t vectorsPerBlock = getVectorsPerBlock();
+    validation.channels.resize(numChannels);
+    std::vector<sys::ubyte> pvpData;
+    Columns columns;
+    for (size_t ii = 0; ii < numChannels; ++ii)
+    {
+        const size_t numVectors = mMetadata.data.getNumVectors(ii);
+        if (numVectors == 0)
+        {
+            continue;
+        }
+        pvpBlock.getPVPdata(ii, pvpData);
+
+        ChannelState state;
+        for (size_t done = 0; done < numVectors; done += vectorsPerBlock)
+        {
+            validateBlock(ii, done,
+                          std::min(vectorsPerBlock, numVectors - done),
+                          &pvpData[done * numBytesPerVector],
+                          columns, state, validation.channels[ii]);
+        }
+        validateChannel(ii, state, validation.errors);
+    }
+    return validation;
+}
+
+PVPValidation PVPValidator::validate(io::SeekableInputStream& inStream,
+                                     sys::Off_T pvpBlockOffset) const
+{
+    PVPValidation validation;
+    validateMetadata(validation.errors);
+
+    const size_t numChannels = mMetadata.data.getNumChannels();
+    const size_t numBytesPerVector = mMetadata.data.getNumBytesPVPSet();
+    const size_t vectorsPerBlock = getVectorsPerBlock();
+    validation.channels.resize(numChannels);
+    std::vector<sys::ubyte> pvpData;
+    Columns columns;
+    for (size_t ii = 0; ii < numChannels; ++ii)
+    {
+        const size_t numVectors = mMetadata.data.getNumVectors(ii);
+        if (numVectors == 0)
+        {
+            continue;
+        }
+        inStream.seek(pvpBlockOffset + static_cast<sys::Off_T>(
+                              mMetadata.data.channels[ii].pvpArrayByteOffset),
+                      io::Seekable::START);
+
+        ChannelState state;
+        for (size_t done = 0; done < numVectors; done += vectorsPerBlock)
+        {
+            const size_t numBlockVectors =
+                    std::min(vectorsPerBlock, numVectors - done);
+            const size_t numBytes = numBlockVectors * numBytesPerVector;
+            pvpData.resize(numBytes);
+            inStream.read(&pvpData[0], numBytes, true);
+
+            // PVPs are big endian 8 byte words in the file
+            if (!sys::isBigEndianSystem())
+            {
+                byteSwap(&pvpData[0], PVPType::WORD_BYTE_SIZE,
+                         numBytes / PVPType::WORD_BYTE_SIZE, mNumThreads);
+            }
+            validateBlock(ii, done, numBlockVectors, &pvpData[0], columns,
+                          state, validation.channels[ii]);
+        }
+        validateChannel(ii, state, validation.errors);
+    }
+    return validation;
+}
+}
@@ -0,0 +1,380 @@
+/* =========================================================================
+ * This file is part of cphd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * cphd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include <cphd/SignalCodec.h>
+#include <except/Exception.h>
+
+namespace
+{
+// Block modes, stored in the first byte of each compressed block
+const sys::ubyte STORED = 0;
+const sys::ubyte SHUFFLE_LZ = 1;
+
+// LZ sequences are a token, whose high and low nibbles are the literal
+// length and the match length less MIN_MATCH, the literals, a two byte
+// little endian match offset and any extra match length.  A nibble of
+// 15 is followed by extra length bytes, which continue while they're 255.
+// The final sequence is just literals.
+const size_t MIN_MATCH = 4;
+const size_t MAX_OFFSET = 65535;
+const size_t NIBBLE_MAX = 15;
+const size_t HASH_BITS = 14;
+const size_t NO_POSITION = std::numeric_limits<size_t>::max();
+
+void throwCorrupt()
+{
+    throw except::Exception(Ctxt("Compressed signal block is corrupt"));
+}
+
+sys::Uint32_T read32(const sys::ubyte* input)
+{
+    sys::Uint32_T value;
+    std::memcpy(&value, input, sizeof(value));
+    return value;
+}
+
+size_t hash(sys::Uint32_T value)
+{
+    return static_cast<sys::Uint32_T>(value * 2654435761U) >>
+            (32 - HASH_BITS);
+}
+
+void writeLength(size_t length, std::vector<sys::ubyte>& output)
+{
+    for (; length >= 255; length -= 255)
+    {
+        output.push_back(255);
+    }
+    output.push_back(static_cast<sys::ubyte>(length));
+}
+
+void writeSequence(const sys::ubyte* literals,
+                   size_t numLiterals,
+                   size_t offset,
+                   size_t matchLength,
+                   std::vector<sys::ubyte>& output)
+{
+    const size_t extraMatch = matchLength - MIN_MATCH;
+    output.push_back(static_cast<sys::ubyte>(
+            (std::min(numLiterals, NIBBLE_MAX) << 4) |
+            std::min(extraMatch, NIBBLE_MAX)));
+    if (numLiterals >= NIBBLE_MAX)
+    {
+        writeLength(numLiterals - NIBBLE_MAX, output);
+    }
+    output.insert(output.end(), literals, literals + numLiterals);
+    output.push_back(static_cast<sys::ubyte>(offset & 0xFF));
+    output.push_back(static_cast<sys::ubyte>(offset >> 8));
+    if (extraMatch >= NIBBLE_MAX)
+    {
+        writeLength(extraMatch - NIBBLE_MAX, output);
+    }
+}
+
+void writeLiterals(const sys::ubyte* literals,
+                   size_t numLiterals,
+                   std::vector<sys::ubyte>& output)
+{
+    output.push_back(static_cast<sys::ubyte>(
+            std::min(numLiterals, NIBBLE_MAX) << 4));
+    if (numLiterals >= NIBBLE_MAX)
+    {
+        writeLength(numLiterals - NIBBLE_MAX, output);
+    }
+    output.insert(output.end(), literals, literals + numLiterals);
+}
+
+// Greedy LZ77 with a single entry hash table
+void lzCompress(const sys::ubyte* input,
+                size_t numBytes,
+                std::vector<sys::ubyte>& output)
+{
+    size_t anchor = 0;
+    if (numBytes >= MIN_MATCH)
+    {
+        std::vector<size_t> table(static_cast<size_t>(1) << HASH_BITS,
+                                  NO_POSITION);
+        const size_t lastMatchStart = numBytes - MIN_MATCH;
+        size_t pos = 0;
+        while (pos <= lastMatchStart)
+        {
+            const sys::Uint32_T value = read32(input + pos);
+            size_t& entry = table[hash(value)];
+            const size_t candidate = entry;
+            entry = pos;
+            if (candidate == NO_POSITION ||
+                pos - candidate > MAX_OFFSET ||
+                read32(input + candidate) != value)
+            {
+                ++pos;
+                continue;
+            }
+
+            size_t length = MIN_MATCH;
+            while (pos + length < numBytes &&
+                   input[candidate + length] == input[pos + length])
+            {
+                ++length;
+            }
+            writeSequence(input + anchor, pos - anchor, pos - candidate,
+                          length, output);
+            pos += length;
+            anchor = pos;
+        }
+    }
+    writeLiterals(input + anchor, numBytes - anchor, output);
+}
+
+size_t readLength(const sys::ubyte* input,
+                  size_t inputSize,
+                  size_t maxLength,
+                  size_t& pos)
+{
+    size_t length = 0;
+    sys::ubyte byte;
+    do
+    {
+        if (pos >= inputSize)
+        {
+            throwCorrupt();
+        }
+        byte = input[pos++];
+        length += byte;
+        if (length > maxLength)
+        {
+            throwCorrupt();
+        }
+    }
+    while (byte == 255);
+    return length;
+}
+
+void lzDecompress(const sys::ubyte* input,
+                  size_t inputSize,
+                  sys::ubyte* output,
+                  size_t outputSize)
+{
+    size_t in = 0;
+    size_t out = 0;
+    while (true)
+    {
+        if (in >= inputSize)
+        {
+            throwCorrupt();
+        }
+        const size_t token = input[in++];
+
+        size_t numLiterals = token >> 4;
+        if (numLiterals == NIBBLE_MAX)
+        {
+            numLiterals += readLength(input, inputSize, outputSize, in);
+        }
+        if (numLiterals > inputSize - in || numLiterals > outputSize - out)
+        {
+            throwCorrupt();
+        }
+        std::memcpy(output + out, input + in, numLiterals);
+        in += numLiterals;
+        out += numLiterals;
+
+        if (in == inputSize)
+        {
+            break;
+        }
+
+        if (inputSize - in < 2)
+        {
+            throwCorrupt();
+        }
+        const size_t offset = input[in] | (input[in + 1] << 8);
+        in += 2;
+        if (offset == 0 || offset > out)
+        {
+            throwCorrupt();
+        }
+
+        size_t matchLength = (token & NIBBLE_MAX) + MIN_MATCH;
+        if ((token & NIBBLE_MAX) == NIBBLE_MAX)
+        {
+            matchLength += readLength(input, inputSize, outputSize, in);
+        }
+        if (matchLength > outputSize - out)
+        {
+            throwCorrupt();
+        }
+
+        // Matches can overlap what they're producing, so go a byte at a time
+        const sys::ubyte* match = output + out - offset;
+        for (size_t ii = 0; ii < matchLength; ++ii)
+        {
+            output[out + ii] = match[ii];
+        }
+        out += matchLength;
+    }
+
+    if (out != outputSize)
+    {
+        throwCorrupt();
+    }
+}
+
+void shuffle(const sys::ubyte* input,
+             size_t numBytes,
+             size_t typeSize,
+             sys::ubyte* output)
+{
+    const size_t numElements = numBytes / typeSize;
+    for (size_t byte = 0; byte < typeSize; ++byte)
+    {
+        sys::ubyte* const dest = output + byte * numElements;
+        for (size_t ii = 0; ii < numElements; ++ii)
+        {
+            dest[ii] = input[ii * typeSize + byte];
+        }
+    }
+    const size_t shuffled = numElements * typeSize;
+    std::memcpy(output + shuffled, input + shuffled, numBytes - shuffled);
+}
+
+void unshuffle(const sys::ubyte* input,
+               size_t numBytes,
+               size_t typeSize,
+               sys::ubyte* output)
+{
+    const size_t numElements = numBytes / typeSize;
+    for (size_t byte = 0; byte < typeSize; ++byte)
+    {
+        const sys::ubyte* const src = input + byte * numElements;
+        for (size_t ii = 0; ii < numElements; ++ii)
+        {
+            output[ii * typeSize + byte] = src[ii];
+        }
+    }
+    const size_t shuffled = numElements * typeSize;
+    std::memcpy(output + shuffled, input + shuffled, numBytes - shuffled);
+}
+}
+
+namespace cphd
+{
+SignalCodec::~SignalCodec()
+{
+}
+
+const char ShuffleLZCodec::IDENTIFIER[] = "SIX_SHUFFLE_LZ";
+
+void ShuffleLZCodec::compress(const sys::ubyte* input,
+                              size_t numBytes,
+                              size_t typeSize,
+                              std::vector<sys::ubyte>& output) const
+{
+    output.clear();
+    output.reserve(numBytes + 1);
+    output.push_back(SHUFFLE_LZ);
+    if (typeSize > 1)
+    {
+        std::vector<sys::ubyte> shuffled(numBytes);
+        if (numBytes != 0)
+        {
+            shuffle(input, numBytes, typeSize, &shuffled[0]);
+        }
+        lzCompress(shuffled.empty() ? nullptr : &shuffled[0], numBytes,
+                   output);
+    }
+    else
+    {
+        lzCompress(input, numBytes, output);
+    }
+
+    if (output.size() > numBytes + 1)
+    {
+        output.resize(1);
+        output[0] = STORED;
+        output.insert(output.end(), input, input + numBytes);
+    }
+}
+
+void ShuffleLZCodec::decompress(const sys::ubyte* input,
+                                size_t inputSize,
+                                size_t typeSize,
+                                sys::ubyte* output,
+                                size_t outputSize) const
+{
+    if (inputSize == 0)
+    {
+        throwCorrupt();
+    }
+
+    switch (input[0])
+    {
+    case STORED:
+        if (inputSize - 1 != outputSize)
+        {
+            throwCorrupt();
+        }
+        std::memcpy(output, input + 1, outputSize);
+        break;
+    case SHUFFLE_LZ:
+        if (typeSize > 1)
+        {
+            std::vector<sys::ubyte> shuffled(outputSize);
+            lzDecompress(input + 1, inputSize - 1,
+                         shuffled.empty() ? nullptr : &shuffled[0],
+                         outputSize);
+            if (outputSize != 0)
+            {
+                unshuffle(&shuffled[0], outputSize, typeSize, output);
+            }
+        }
+        else
+        {
+            lzDecompress(input + 1, inputSize - 1, output, outputSize);
+        }
+        break;
+    default:
+        throwCorrupt();
+    }
+}
+
+SignalCodecRegistry::SignalCodecRegistry()
+{
+    addCodec(ShuffleLZCodec::IDENTIFIER,
+             std::unique_ptr<SignalCodec>(new ShuffleLZCodec()));
+}
+
+void SignalCodecRegistry::addCodec(const std::string& identifier,
+                                   std::unique_ptr<SignalCodec>&& codec)
+{
+    mRegistry[identifier] = std::move(codec);
+}
+
+const SignalCodec*
+SignalCodecRegistry::getCodec(const std::string& identifier) const
+{
+    const auto iter = mRegistry.find(identifier);
+    return iter == mRegistry.end() ? nullptr : iter->second.get();
+}
+}
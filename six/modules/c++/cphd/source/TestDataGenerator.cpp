@@ -20,18 +20,57 @@
  *
  */
 
+#include <algorithm>
+#include <complex>
 #include <iostream>
 #include <stdlib.h>
 #include <string>
 #include <vector>
 #include <map>
 
+#include <except/Exception.h>
+#include <str/Convert.h>
 #include <sys/Conf.h>
 #include <cphd/Enums.h>
 #include <cphd/Types.h>
 #include <cphd/PVP.h>
 #include <cphd/PVPBlock.h>
 #include <cphd/Metadata.h>
+#include <cphd/CPHDWriter.h>
+#include <cphd/TestDataGenerator.h>
+#include <cphd/Utilities.h>
+
+namespace
+{
+template <typename T>
+void writeSignal(const cphd::Metadata& metadata,
+                 size_t chunkSize,
+                 cphd::CPHDWriter& writer)
+{
+    const size_t numSamples = metadata.data.getNumSamples(0);
+    const size_t vectorsPerChunk = std::max<size_t>(
+            chunkSize / (numSamples * sizeof(T)), 1);
+    std::vector<T> chunk(std::min(vectorsPerChunk,
+                                  metadata.data.getNumVectors(0)) *
+                         numSamples);
+    for (size_t ii = 0; ii < chunk.size(); ++ii)
+    {
+        chunk[ii] = T(static_cast<typename T::value_type>(rand() % 100),
+                      static_cast<typename T::value_type>(rand() % 100));
+    }
+
+    for (size_t ii = 0; ii < metadata.data.getNumChannels(); ++ii)
+    {
+        const size_t numElements = metadata.data.getNumVectors(ii) * numSamples;
+        for (size_t done = 0; done < numElements; done += chunk.size())
+        {
+            writer.writeCPHDData(&chunk[0],
+                                 std::min(chunk.size(), numElements - done),
+                                 ii);
+        }
+    }
+}
+}
 
 namespace cphd
 {
@@ -162,4 +201,116 @@ void setUpMetadata(Metadata& metadata)
     metadata.referenceGeometry.monostatic->arpPos = getRandomVector3();
     metadata.referenceGeometry.monostatic->arpVel = getRandomVector3();
 }
+
+void setUpSyntheticMetadata(size_t numChannels,
+                            const types::RowCol<size_t>& dims,
+                            SignalArrayFormat format,
+                            size_t numAddedPVPs,
+                            size_t numSupportArrays,
+                            const types::RowCol<size_t>& supportDims,
+                            Metadata& metadata)
+{
+    setUpMetadata(metadata);
+    metadata.data.signalArrayFormat = format;
+    metadata.global.domainType = DomainType::FX;
+
+    setPVPXML(metadata.pvp);
+    const size_t numRequired = metadata.pvp.getReqSetSize();
+    for (size_t ii = 0; ii < numAddedPVPs; ++ii)
+    {
+        metadata.pvp.setCustomParameter(1, numRequired + ii, "F8",
+                                        "Added" + str::toString(ii));
+    }
+    metadata.data.numBytesPVP = (numRequired + numAddedPVPs) * 8;
+
+    const size_t supportSize = supportDims.area() * 4;
+    for (size_t ii = 0; ii < numSupportArrays; ++ii)
+    {
+        metadata.data.setSupportArray("Support" + str::toString(ii),
+                                      supportDims.row, supportDims.col, 4,
+                                      ii * supportSize);
+    }
+
+    // The arrays are written one after another
+    const size_t signalSize = dims.area() * getNumBytesPerSample(format);
+    metadata.channel.refChId = "CH0";
+    for (size_t ii = 0; ii < numChannels; ++ii)
+    {
+        Data::Channel channel(dims.row, dims.col, ii * signalSize,
+                              ii * dims.row * metadata.data.numBytesPVP);
+        channel.identifier = "CH" + str::toString(ii);
+        metadata.data.channels.push_back(channel);
+
+        ChannelParameter parameter;
+        parameter.identifier = channel.identifier;
+        parameter.refVectorIndex = 0;
+        parameter.fxFixed = six::BooleanType::IS_FALSE;
+        parameter.toaFixed = six::BooleanType::IS_FALSE;
+        parameter.srpFixed = six::BooleanType::IS_FALSE;
+        parameter.polarization.txPol = PolarizationType::V;
+        parameter.polarization.rcvPol = PolarizationType::V;
+        parameter.fxC = 0.0;
+        parameter.fxBW = 0.0;
+        parameter.toaSaved = 0.0;
+        parameter.dwellTimes.codId = "COD";
+        parameter.dwellTimes.dwellId = "Dwell";
+        metadata.channel.parameters.push_back(parameter);
+    }
+}
+
+void setSyntheticVectorParameters(const Metadata& metadata,
+                                  PVPBlock& pvpBlock)
+{
+    for (size_t ii = 0; ii < metadata.data.getNumChannels(); ++ii)
+    {
+        for (size_t jj = 0; jj < metadata.data.getNumVectors(ii); ++jj)
+        {
+            setVectorParameters(ii, jj, pvpBlock);
+            for (auto it = metadata.pvp.addedPVP.begin();
+                 it != metadata.pvp.addedPVP.end();
+                 ++it)
+            {
+                pvpBlock.setAddedPVP(getRandom(), ii, jj, it->first);
+            }
+        }
+    }
+}
+
+void writeSyntheticCPHD(const Metadata& metadata,
+                        const PVPBlock& pvpBlock,
+                        const std::string& pathname,
+                        size_t numThreads,
+                        size_t chunkSize)
+{
+    std::vector<sys::ubyte> supportData(metadata.data.getAllSupportSize());
+    for (size_t ii = 0; ii < supportData.size(); ++ii)
+    {
+        supportData[ii] = static_cast<sys::ubyte>(rand());
+    }
+
+    CPHDWriter writer(metadata, pathname, std::vector<std::string>(),
+                      numThreads);
+    writer.writeMetadata(pvpBlock);
+    if (!supportData.empty())
+    {
+        writer.writeSupportData(&supportData[0]);
+    }
+    writer.writePVPData(pvpBlock);
+
+    switch (metadata.data.signalArrayFormat)
+    {
+    case SignalArrayFormat::CI2:
+        writeSignal<std::complex<sys::Int8_T> >(metadata, chunkSize, writer);
+        break;
+    case SignalArrayFormat::CI4:
+        writeSignal<std::complex<sys::Int16_T> >(metadata, chunkSize, writer);
+        break;
+    case SignalArrayFormat::CF8:
+        writeSignal<std::complex<float> >(metadata, chunkSize, writer);
+        break;
+    default:
+        throw except::Exception(Ctxt("Invalid signal array format"));
+    }
+    writer.close();
+}
 }
@@ -0,0 +1,571 @@
+/* =========================================================================
+ * This file is part of cphd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * cphd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <except/Exception.h>
+#include <math/Constants.h>
+#include <math/linear/VectorN.h>
+#include <mt/Runnable1D.h>
+#include <scene/Utilities.h>
+#include <cphd/VectorGeometry.h>
+
+namespace
+{
+double toDegrees(double radians)
+{
+    return radians * math::Constants::RADIANS_TO_DEGREES;
+}
+
+double clampedAcos(double value)
+{
+    return std::acos(std::max(-1.0, std::min(1.0, value)));
+}
+
+// Measured clockwise from +North toward +East
+double getNorthAngle(const cphd::Vector3& vector,
+                     const cphd::Vector3& north,
+                     const cphd::Vector3& east)
+{
+    return scene::Utilities::remapZeroTo360(
+            toDegrees(std::atan2(east.dot(vector), north.dot(vector))));
+}
+
+struct EarthTangentPlane
+{
+    EarthTangentPlane()
+    {
+    }
+
+    explicit EarthTangentPlane(const cphd::Vector3& point)
+    {
+        const scene::LatLonAlt lla = scene::Utilities::ecefToLatLon(point);
+        const double sinLat = std::sin(lla.getLatRadians());
+        const double cosLat = std::cos(lla.getLatRadians());
+        const double sinLon = std::sin(lla.getLonRadians());
+        const double cosLon = std::cos(lla.getLonRadians());
+
+        up[0] = cosLat * cosLon;
+        up[1] = cosLat * sinLon;
+        up[2] = sinLat;
+
+        north[0] = -sinLat * cosLon;
+        north[1] = -sinLat * sinLon;
+        north[2] = cosLat;
+
+        east = math::linear::cross(north, up);
+    }
+
+    cphd::Vector3 up;
+    cphd::Vector3 north;
+    cphd::Vector3 east;
+};
+
+// The slant plane normal for the line of sight and its rate of change,
+// pointing away from the Earth at the target
+cphd::Vector3 getSlantPlaneNormal(const cphd::Vector3& targetToARP,
+                                  const cphd::Vector3& rate,
+                                  const cphd::Vector3& target,
+                                  int& sideOfTrack)
+{
+    cphd::Vector3 normal = math::linear::cross(targetToARP, rate);
+    normal.normalize();
+    sideOfTrack = normal.dot(target) < 0 ? -1 : 1;
+    return normal * static_cast<double>(sideOfTrack);
+}
+
+// ImagingType angles for a unit vector from the target toward the ARP and
+// the slant plane normal
+void getImagingAngles(const cphd::Vector3& uARP,
+                      const cphd::Vector3& uSPN,
+                      const EarthTangentPlane& etp,
+                      double& azimuthAngle,
+                      double& grazeAngle,
+                      double& twistAngle,
+                      double& slopeAngle,
+                      double& layoverAngle)
+{
+    const double sinGraze = uARP.dot(etp.up);
+    grazeAngle = std::abs(toDegrees(std::asin(sinGraze)));
+    azimuthAngle = getNorthAngle(uARP, etp.north, etp.east);
+
+    // Angle from +GPY to +SPY in the plane of incidence
+    const cphd::Vector3 uGPX = (uARP - etp.up * sinGraze).unit();
+    const cphd::Vector3 uGPY = math::linear::cross(etp.up, uGPX);
+    twistAngle = -toDegrees(std::asin(uGPY.dot(uSPN)));
+
+    const double cosSlope = uSPN.dot(etp.up);
+    slopeAngle = toDegrees(clampedAcos(cosSlope));
+    layoverAngle = getNorthAngle(etp.up - uSPN / cosSlope,
+                                 etp.north, etp.east);
+}
+
+// Monostatic parameters of one ARP and target
+void fillEntry(const cphd::Vector3& arpPos,
+               const cphd::Vector3& arpVel,
+               const cphd::Vector3& target,
+               const EarthTangentPlane& etp,
+               size_t index,
+               cphd::VectorGeometry& geometry)
+{
+    cphd::Vector3 uARP = arpPos - target;
+    const double slantRange = uARP.norm();
+    uARP /= slantRange;
+
+    int side;
+    const cphd::Vector3 uSPN =
+            getSlantPlaneNormal(uARP, arpVel, target, side);
+
+    geometry.targetPos[index] = target;
+    geometry.uLOS[index] = uARP * -1.0;
+    geometry.sideOfTrack[index] = six::SideOfTrackType(side);
+    geometry.slantRange[index] = slantRange;
+    geometry.groundRange[index] = target.norm() *
+            clampedAcos(arpPos.unit().dot(target.unit()));
+    geometry.dopplerConeAngle[index] =
+            toDegrees(clampedAcos(-uARP.dot(arpVel.unit())));
+
+    getImagingAngles(uARP, uSPN, etp,
+                     geometry.azimuthAngle[index],
+                     geometry.grazeAngle[index],
+                     geometry.twistAngle[index],
+                     geometry.slopeAngle[index],
+                     geometry.layoverAngle[index]);
+    geometry.incidenceAngle[index] = 90 - geometry.grazeAngle[index];
+}
+
+// Angle between unit vectors, in radians.  Unlike acos, this stays
+// accurate when they're nearly parallel.
+double getAngleBetween(const cphd::Vector3& u1, const cphd::Vector3& u2)
+{
+    return std::atan2(math::linear::cross(u1, u2).norm(), u1.dot(u2));
+}
+
+double getBistaticAngle(const cphd::Vector3& txPos,
+                        const cphd::Vector3& rcvPos,
+                        const cphd::Vector3& target)
+{
+    return toDegrees(getAngleBetween((txPos - target).unit(),
+                                     (rcvPos - target).unit()));
+}
+
+// Unit vector from the target to a platform and its rate of change
+void getLineOfSight(const cphd::Vector3& pos,
+                    const cphd::Vector3& vel,
+                    const cphd::Vector3& target,
+                    cphd::Vector3& unit,
+                    cphd::Vector3& rate)
+{
+    unit = pos - target;
+    const double range = unit.norm();
+    unit /= range;
+    rate = (vel - unit * vel.dot(unit)) / range;
+}
+
+void fillPlatform(double time,
+                  const cphd::Vector3& pos,
+                  const cphd::Vector3& vel,
+                  const cphd::Vector3& target,
+                  const EarthTangentPlane& etp,
+                  cphd::Bistatic::PlatformParams& platform)
+{
+    cphd::VectorGeometry geometry;
+    geometry.resize(1);
+    fillEntry(pos, vel, target, etp, 0, geometry);
+
+    platform.sideOfTrack = geometry.sideOfTrack[0];
+    platform.time = time;
+    platform.azimuthAngle = geometry.azimuthAngle[0];
+    platform.grazeAngle = geometry.grazeAngle[0];
+    platform.incidenceAngle = geometry.incidenceAngle[0];
+    platform.dopplerConeAngle = geometry.dopplerConeAngle[0];
+    platform.groundRange = geometry.groundRange[0];
+    platform.slantRange = geometry.slantRange[0];
+    platform.pos = pos;
+    platform.vel = vel;
+}
+
+template <typename T>
+const T* findByIdentifier(const std::vector<T>& values,
+                          const std::string& identifier)
+{
+    for (size_t ii = 0; ii < values.size(); ++ii)
+    {
+        if (values[ii].identifier == identifier)
+        {
+            return &values[ii];
+        }
+    }
+    return nullptr;
+}
+}
+
+namespace cphd
+{
+void VectorGeometry::resize(size_t size)
+{
+    time.resize(size);
+    arpPos.resize(size);
+    arpVel.resize(size);
+    targetPos.resize(size);
+    uLOS.resize(size);
+    sideOfTrack.resize(size);
+    slantRange.resize(size);
+    groundRange.resize(size);
+    dopplerConeAngle.resize(size);
+    grazeAngle.resize(size);
+    incidenceAngle.resize(size);
+    azimuthAngle.resize(size);
+    twistAngle.resize(size);
+    slopeAngle.resize(size);
+    layoverAngle.resize(size);
+    bistaticAngle.resize(size);
+}
+
+struct VectorGeometryCalculator::Platforms
+{
+    std::vector<double> time;
+    std::vector<Vector3> arpPos;
+    std::vector<Vector3> arpVel;
+    std::vector<Vector3> txPos;
+    std::vector<Vector3> rcvPos;
+    std::vector<Vector3> srpPos;
+};
+
+// Fills the entries of one vector.  Each thread gets its own copy so it can
+// hold on to the last Earth tangent plane.
+class VectorGeometryCalculator::ComputeVectors
+{
+public:
+    ComputeVectors(const Platforms& platforms,
+                   const Vector3* points,
+                   const std::vector<EarthTangentPlane>& pointPlanes,
+                   size_t numPoints,
+                   VectorGeometry& geometry) :
+        mPlatforms(platforms),
+        mPoints(points),
+        mPointPlanes(pointPlanes),
+        mNumPoints(numPoints),
+        mGeometry(geometry),
+        mHavePlane(false)
+    {
+    }
+
+    void operator()(size_t vector) const
+    {
+        const Vector3& arpPos = mPlatforms.arpPos[vector];
+        const Vector3& arpVel = mPlatforms.arpVel[vector];
+        const Vector3& txPos = mPlatforms.txPos[vector];
+        const Vector3& rcvPos = mPlatforms.rcvPos[vector];
+
+        if (mPoints == nullptr)
+        {
+            const Vector3& srpPos = mPlatforms.srpPos[vector];
+            if (!mHavePlane || srpPos != mLastSRP)
+            {
+                mPlane = EarthTangentPlane(srpPos);
+                mLastSRP = srpPos;
+                mHavePlane = true;
+            }
+            setPlatform(vector, vector);
+            fillEntry(arpPos, arpVel, srpPos, mPlane, vector, mGeometry);
+            mGeometry.bistaticAngle[vector] =
+                    getBistaticAngle(txPos, rcvPos, srpPos);
+            return;
+        }
+
+        for (size_t pp = 0; pp < mNumPoints; ++pp)
+        {
+            const size_t index = vector * mNumPoints + pp;
+            setPlatform(vector, index);
+            fillEntry(arpPos, arpVel, mPoints[pp], mPointPlanes[pp],
+                      index, mGeometry);
+            mGeometry.bistaticAngle[index] =
+                    getBistaticAngle(txPos, rcvPos, mPoints[pp]);
+        }
+    }
+
+private:
+    void setPlatform(size_t vector, size_t index) const
+    {
+        mGeometry.time[index] = mPlatforms.time[vector];
+        mGeometry.arpPos[index] = mPlatforms.arpPos[vector];
+        mGeometry.arpVel[index] = mPlatforms.arpVel[vector];
+    }
+
+    const Platforms& mPlatforms;
+    const Vector3* const mPoints;
+    const std::vector<EarthTangentPlane>& mPointPlanes;
+    const size_t mNumPoints;
+    VectorGeometry& mGeometry;
+
+    mutable bool mHavePlane;
+    mutable Vector3 mLastSRP;
+    mutable EarthTangentPlane mPlane;
+};
+
+VectorGeometryCalculator::VectorGeometryCalculator(const Metadata& metadata,
+                                                   const PVPBlock& pvpBlock,
+                                                   size_t numThreads) :
+    mMetadata(metadata),
+    mPVPBlock(pvpBlock),
+    mNumThreads(std::max<size_t>(numThreads, 1))
+{
+}
+
+void VectorGeometryCalculator::checkSpan(size_t channel,
+                                         size_t firstVector,
+                                         size_t numVectors) const
+{
+    if (channel >= mMetadata.data.getNumChannels())
+    {
+        std::ostringstream ostr;
+        ostr << "Channel " << channel << " is out of bounds";
+        throw except::Exception(Ctxt(ostr.str()));
+    }
+    const size_t channelVectors = mMetadata.data.getNumVectors(channel);
+    if (firstVector + numVectors > channelVectors)
+    {
+        std::ostringstream ostr;
+        ostr << "Vectors [" << firstVector << ", "
+             << firstVector + numVectors << ") are out of bounds for channel "
+             << channel << " with " << channelVectors << " vectors";
+        throw except::Exception(Ctxt(ostr.str()));
+    }
+}
+
+void VectorGeometryCalculator::getPlatforms(size_t channel,
+                                            size_t firstVector,
+                                            size_t numVectors,
+                                            Platforms& platforms) const
+{
+    platforms.time.resize(numVectors);
+    platforms.arpPos.resize(numVectors);
+    platforms.arpVel.resize(numVectors);
+    platforms.txPos.resize(numVectors);
+    platforms.rcvPos.resize(numVectors);
+    platforms.srpPos.resize(numVectors);
+    for (size_t ii = 0; ii < numVectors; ++ii)
+    {
+        const size_t vector = firstVector + ii;
+        platforms.txPos[ii] = mPVPBlock.getTxPos(channel, vector);
+        platforms.rcvPos[ii] = mPVPBlock.getRcvPos(channel, vector);
+        platforms.time[ii] = (mPVPBlock.getTxTime(channel, vector) +
+                              mPVPBlock.getRcvTime(channel, vector)) / 2;
+        platforms.arpPos[ii] = (platforms.txPos[ii] + platforms.rcvPos[ii]) / 2;
+        platforms.arpVel[ii] = (mPVPBlock.getTxVel(channel, vector) +
+                                mPVPBlock.getRcvVel(channel, vector)) / 2;
+        platforms.srpPos[ii] = mPVPBlock.getSRPPos(channel, vector);
+    }
+}
+
+void VectorGeometryCalculator::getChannelGeometry(
+        size_t channel, VectorGeometry& geometry) const
+{
+    checkSpan(channel, 0, 0);
+    getGeometry(channel, 0, mMetadata.data.getNumVectors(channel), geometry);
+}
+
+void VectorGeometryCalculator::getGeometry(size_t channel,
+                                           size_t firstVector,
+                                           size_t numVectors,
+                                           VectorGeometry& geometry) const
+{
+    checkSpan(channel, firstVector, numVectors);
+    Platforms platforms;
+    getPlatforms(channel, firstVector, numVectors, platforms);
+    geometry.resize(numVectors);
+
+    const size_t numThreads =
+            std::max<size_t>(std::min(mNumThreads, numVectors), 1);
+    const std::vector<EarthTangentPlane> noPlanes;
+    const std::vector<ComputeVectors> ops(
+            numThreads,
+            ComputeVectors(platforms, nullptr, noPlanes, 0, geometry));
+    mt::run1D(numVectors, numThreads, ops);
+}
+
+void VectorGeometryCalculator::getGeometry(size_t channel,
+                                           size_t firstVector,
+                                           size_t numVectors,
+                                           const Vector3* points,
+                                           size_t numPoints,
+                                           VectorGeometry& geometry) const
+{
+    checkSpan(channel, firstVector, numVectors);
+    Platforms platforms;
+    getPlatforms(channel, firstVector, numVectors, platforms);
+    geometry.resize(numVectors * numPoints);
+
+    std::vector<EarthTangentPlane> pointPlanes;
+    pointPlanes.reserve(numPoints);
+    for (size_t ii = 0; ii < numPoints; ++ii)
+    {
+        pointPlanes.push_back(EarthTangentPlane(points[ii]));
+    }
+
+    const size_t numThreads =
+            std::max<size_t>(std::min(mNumThreads, numVectors), 1);
+    const std::vector<ComputeVectors> ops(
+            numThreads,
+            ComputeVectors(platforms, points, pointPlanes, numPoints,
+                           geometry));
+    mt::run1D(numVectors, numThreads, ops);
+}
+
+ReferenceGeometry VectorGeometryCalculator::getReferenceGeometry(
+        size_t channel,
+        size_t firstVector,
+        size_t numVectors) const
+{
+    checkSpan(channel, firstVector, numVectors);
+    if (numVectors == 0)
+    {
+        throw except::Exception(Ctxt(
+                "Need at least one vector for a reference geometry"));
+    }
+    const size_t refVector = firstVector + numVectors / 2;
+
+    VectorGeometry reference;
+    getGeometry(channel, refVector, 1, reference);
+
+    ReferenceGeometry geometry;
+    geometry.referenceTime = reference.time[0];
+    geometry.srp.ecf = reference.targetPos[0];
+
+    // Image area coordinates, and the COD and dwell times there
+    const Planar* const planar =
+            mMetadata.sceneCoordinates.referenceSurface.planar.get();
+    if (planar == nullptr)
+    {
+        throw except::Exception(Ctxt(
+                "Reference geometry needs a planar reference surface"));
+    }
+    const Vector3 uIaz = math::linear::cross(planar->uIax, planar->uIay);
+    const Vector3 offset =
+            geometry.srp.ecf - mMetadata.sceneCoordinates.iarp.ecf;
+    geometry.srp.iac[0] = offset.dot(planar->uIax);
+    geometry.srp.iac[1] = offset.dot(planar->uIay);
+    geometry.srp.iac[2] = offset.dot(uIaz);
+
+    if (channel >= mMetadata.channel.parameters.size())
+    {
+        std::ostringstream ostr;
+        ostr << "Channel " << channel << " has no parameters";
+        throw except::Exception(Ctxt(ostr.str()));
+    }
+    const DwellTimes& dwellTimes =
+            mMetadata.channel.parameters[channel].dwellTimes;
+    const COD* const cod =
+            findByIdentifier(mMetadata.dwell.cod, dwellTimes.codId);
+    const DwellTime* const dwell =
+            findByIdentifier(mMetadata.dwell.dtime, dwellTimes.dwellId);
+    if (cod == nullptr || dwell == nullptr)
+    {
+        throw except::Exception(Ctxt(
+                "COD " + dwellTimes.codId + " or dwell " +
+                dwellTimes.dwellId + " polynomial not found"));
+    }
+    geometry.srpCODTime =
+            cod->codTimePoly(geometry.srp.iac[0], geometry.srp.iac[1]);
+    geometry.srpDwellTime =
+            dwell->dwellTimePoly(geometry.srp.iac[0], geometry.srp.iac[1]);
+
+    if (mMetadata.collectionID.collectType == CollectType::BISTATIC)
+    {
+        getBistatic(channel, refVector, geometry);
+        return geometry;
+    }
+
+    geometry.monostatic.reset(new Monostatic());
+    Monostatic& monostatic = *geometry.monostatic;
+    monostatic.arpPos = reference.arpPos[0];
+    monostatic.arpVel = reference.arpVel[0];
+    monostatic.sideOfTrack = reference.sideOfTrack[0];
+    monostatic.slantRange = reference.slantRange[0];
+    monostatic.groundRange = reference.groundRange[0];
+    monostatic.dopplerConeAngle = reference.dopplerConeAngle[0];
+    monostatic.grazeAngle = reference.grazeAngle[0];
+    monostatic.incidenceAngle = reference.incidenceAngle[0];
+    monostatic.azimuthAngle = reference.azimuthAngle[0];
+    monostatic.twistAngle = reference.twistAngle[0];
+    monostatic.slopeAngle = reference.slopeAngle[0];
+    monostatic.layoverAngle = reference.layoverAngle[0];
+    return geometry;
+}
+
+void VectorGeometryCalculator::getBistatic(size_t channel,
+                                           size_t vector,
+                                           ReferenceGeometry& geometry) const
+{
+    const Vector3 txPos = mPVPBlock.getTxPos(channel, vector);
+    const Vector3 txVel = mPVPBlock.getTxVel(channel, vector);
+    const Vector3 rcvPos = mPVPBlock.getRcvPos(channel, vector);
+    const Vector3 rcvVel = mPVPBlock.getRcvVel(channel, vector);
+    const Vector3& srp = geometry.srp.ecf;
+    const EarthTangentPlane etp(srp);
+
+    geometry.bistatic.reset(new Bistatic());
+    Bistatic& bistatic = *geometry.bistatic;
+    fillPlatform(mPVPBlock.getTxTime(channel, vector), txPos, txVel, srp, etp,
+                 bistatic.txPlatform);
+    fillPlatform(mPVPBlock.getRcvTime(channel, vector), rcvPos, rcvVel, srp,
+                 etp, bistatic.rcvPlatform);
+
+    Vector3 uTx;
+    Vector3 uTxRate;
+    getLineOfSight(txPos, txVel, srp, uTx, uTxRate);
+    Vector3 uRcv;
+    Vector3 uRcvRate;
+    getLineOfSight(rcvPos, rcvVel, srp, uRcv, uRcvRate);
+
+    const double bistaticAngle = getAngleBetween(uTx, uRcv);
+    const double sinBistatic = std::sin(bistaticAngle);
+    bistatic.bistaticAngle = toDegrees(bistaticAngle);
+    bistatic.bistaticAngleRate = sinBistatic == 0.0 ? 0.0 :
+            toDegrees(-(uTxRate.dot(uRcv) + uTx.dot(uRcvRate)) / sinBistatic);
+
+    // The bistatic pointing vector plays the part of the ARP line of sight
+    const Vector3 pointing = (uTx + uRcv) / 2;
+    const Vector3 pointingRate = (uTxRate + uRcvRate) / 2;
+    int side;
+    const Vector3 uSPN =
+            getSlantPlaneNormal(pointing, pointingRate, srp, side);
+    getImagingAngles(pointing.unit(), uSPN, etp,
+                     bistatic.azimuthAngle,
+                     bistatic.grazeAngle,
+                     bistatic.twistAngle,
+                     bistatic.slopeAngle,
+                     bistatic.layoverAngle);
+
+    const Vector3 ground = pointing - etp.up * pointing.dot(etp.up);
+    const Vector3 groundRate =
+            pointingRate - etp.up * pointingRate.dot(etp.up);
+    const double north = ground.dot(etp.north);
+    const double east = ground.dot(etp.east);
+    bistatic.azimuthAngleRate = toDegrees(
+            (north * groundRate.dot(etp.east) -
+             east * groundRate.dot(etp.north)) /
+            (north * north + east * east));
+}
+}
@@ -30,10 +30,16 @@
 #include <mt/ThreadGroup.h>
 #include <mt/ThreadPlanner.h>
 #include <six/Init.h>
+#include <six/Instrumentation.h>
 #include <sys/Conf.h>
 
 namespace
 {
+const size_t READ_POINT =
+        six::Instrumentation::registerPoint("cphd::Wideband::readImpl");
+const size_t CONVERT_POINT =
+        six::Instrumentation::registerPoint("cphd::Wideband::convert");
+
 template <typename InT>
 class PromoteRunnable : public sys::Runnable
 {
@@ -244,7 +250,8 @@ Wideband::Wideband(const std::string& pathname,
     mWBOffset(startWB),
     mWBSize(sizeWB),
     mElementSize(mMetadata.getNumBytesPerSample()),
-    mOffsets(mMetadata.getNumChannels())
+    mOffsets(mMetadata.getNumChannels()),
+    mCodec(nullptr)
 {
     initialize();
 }
@@ -258,7 +265,8 @@ Wideband::Wideband(std::shared_ptr<io::SeekableInputStream> inStream,
     mWBOffset(startWB),
     mWBSize(sizeWB),
     mElementSize(mMetadata.getNumBytesPerSample()),
-    mOffsets(mMetadata.getNumChannels())
+    mOffsets(mMetadata.getNumChannels()),
+    mCodec(nullptr)
 {
     initialize();
 }
@@ -283,8 +291,23 @@ void Wideband::initialize()
         // Signal Array is Compressed
         for (size_t ii = 1; ii < mMetadata.getNumChannels(); ++ii)
         {
-            mOffsets[ii] =
-                    mOffsets[ii - 1] + mMetadata.getCompressedSignalSize(ii);
+            mOffsets[ii] = mOffsets[ii - 1] +
+                    mMetadata.getCompressedSignalSize(ii - 1);
+        }
+
+        // Without a codec the arrays are opaque bytes
+        mCodec = SignalCodecFactory::getInstance().getCodec(
+                mMetadata.getSignalCompressionID());
+        if (mCodec)
+        {
+            for (size_t ii = 0; ii < mMetadata.getNumChannels(); ++ii)
+            {
+                mCompressedSignals.push_back(CompressedSignal(
+                        *mInStream,
+                        mOffsets[ii],
+                        mMetadata.getCompressedSignalSize(ii),
+                        mMetadata.getNumVectors(ii)));
+            }
         }
     }
 }
@@ -369,7 +392,8 @@ void Wideband::checkReadInputs(size_t channel,
     dims.row = lastVector - firstVector + 1;
     dims.col = lastSample - firstSample + 1;
 
-    if (isPartialRead(channel, dims) && mMetadata.isCompressed())
+    if (isPartialRead(channel, dims) && mMetadata.isCompressed() &&
+        !mCodec)
     {
         throw except::Exception(
                 Ctxt("Cannot do partial read of compressed channel"));
@@ -396,11 +420,30 @@ void Wideband::readImpl(size_t channel,
                         size_t lastVector,
                         size_t firstSample,
                         size_t lastSample,
+                        size_t numThreads,
                         void* data) const
 {
     types::RowCol<size_t> dims;
     checkReadInputs(
             channel, firstVector, lastVector, firstSample, lastSample, dims);
+    six::InstrumentationTimer timer(READ_POINT, dims.area() * mElementSize);
+
+    if (mCodec)
+    {
+        timer.addSeeks(1);
+        mCompressedSignals[channel].decompress(
+                *mCodec,
+                *mInStream,
+                firstVector,
+                lastVector,
+                firstSample,
+                lastSample,
+                mMetadata.getNumSamples(channel),
+                mElementSize,
+                numThreads,
+                static_cast<sys::ubyte*>(data));
+        return;
+    }
 
     // Compute the byte offset into this channel's wideband in the CPHD file
     // First to the start of the first pulse we're going to read
@@ -410,6 +453,7 @@ void Wideband::readImpl(size_t channel,
     if (dims.col == mMetadata.getNumSamples(channel))
     {
         // Life is easy - can do a single seek and read
+        timer.addSeeks(1);
         mInStream->seek(inOffset, io::FileInputStream::START);
         mInStream->read(dataPtr, dims.row * dims.col * mElementSize);
     }
@@ -421,6 +465,7 @@ void Wideband::readImpl(size_t channel,
         const size_t bytesPerVectorFile =
                 mMetadata.getNumSamples(channel) * mElementSize;
 
+        timer.addSeeks(dims.row);
         for (size_t row = 0; row < dims.row; ++row)
         {
             mInStream->seek(inOffset, io::FileInputStream::START);
@@ -436,6 +481,9 @@ void Wideband::readImpl(size_t channel, void* data) const
     // Compute the byte offset into this channel's wideband in the CPHD file
     // First to the start of the first pulse we're going to read
     sys::Off_T inOffset = getFileOffset(channel);
+    six::InstrumentationTimer timer(READ_POINT,
+                                    getBytesRequiredForRead(channel));
+    timer.addSeeks(1);
 
     sys::byte* dataPtr = static_cast<sys::byte*>(data);
     mInStream->seek(inOffset, io::FileInputStream::START);
@@ -471,6 +519,7 @@ void Wideband::read(size_t channel,
              lastVector,
              firstSample,
              lastSample,
+             numThreads,
              data.data);
 
     // Byte swap to little endian if necessary
@@ -524,7 +573,8 @@ void Wideband::read(size_t channel,
     // Perform the read
     readImpl(channel, data.data);
 
-    if (shouldByteSwap())
+    // Compressed bytes aren't samples
+    if (!mMetadata.isCompressed() && shouldByteSwap())
     {
         // TODO: Would be nice to have a way to test this without
         // logging onto Solaris...
@@ -538,8 +588,8 @@ void Wideband::read(size_t channel,
 
 bool Wideband::shouldByteSwap() const
 {
-    return !sys::isBigEndianSystem() && !mMetadata.isCompressed() &&
-            mElementSize > 2;
+    return !sys::isBigEndianSystem() &&
+            (!mMetadata.isCompressed() || mCodec) && mElementSize > 2;
 }
 
 void Wideband::read(size_t channel,
@@ -645,8 +695,11 @@ void Wideband::read(size_t channel,
                  lastVector,
                  firstSample,
                  lastSample,
+                 numThreads,
                  scratch.data);
 
+        six::InstrumentationTimer timer(CONVERT_POINT, minScratchSize);
+
         // Byte swap to little endian if necessary
         if (!sys::isBigEndianSystem() && mElementSize > 2)
         {
@@ -678,8 +731,11 @@ void Wideband::read(size_t channel,
                  lastVector,
                  firstSample,
                  lastSample,
+                 numThreads,
                  scratch.data);
 
+        six::InstrumentationTimer timer(CONVERT_POINT,
+                                        numPixels * mElementSize);
         if (!sys::isBigEndianSystem() && mElementSize > 2)
         {
             cphd::byteSwapAndPromote(
@@ -698,6 +754,7 @@ void Wideband::read(size_t channel,
                  lastVector,
                  firstSample,
                  lastSample,
+                 numThreads,
                  data.data);
 
         // Byte swap to little endian if necessary
@@ -0,0 +1,143 @@
+/* =========================================================================
+ * This file is part of cphd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * cphd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <iostream>
+#include <memory>
+#include <cli/Value.h>
+#include <cli/ArgumentParser.h>
+#include <cphd/CPHDSubsetWriter.h>
+
+/*!
+ * Writes some of the channels, vectors and samples of a CPHD to a new CPHD
+ */
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        // Parse the command line
+        cli::ArgumentParser parser;
+        parser.setDescription(
+                "Write a subset of a CPHD's channels, vectors and samples.");
+        parser.addArgument("-c --channels",
+                           "0-based channels to keep (default: all)",
+                           cli::STORE,
+                           "channels",
+                           "CHANNEL",
+                           1);
+        parser.addArgument("-v --vectors",
+                           "0-based first and last vectors to keep",
+                           cli::STORE,
+                           "vectors",
+                           "VECTOR",
+                           2, 2);
+        parser.addArgument("-s --samples",
+                           "0-based first and last samples to keep",
+                           cli::STORE,
+                           "samples",
+                           "SAMPLE",
+                           2, 2);
+        parser.addArgument("-b --block-size",
+                           "Megabytes to copy at once",
+                           cli::STORE,
+                           "blockSize",
+                           "MB")->setDefault(64);
+        parser.addArgument("--schema",
+                           "Schema pathname",
+                           cli::STORE,
+                           "schema",
+                           "XSD",
+                           1);
+        parser.addArgument("input", "Input pathname", cli::STORE, "input",
+                           "CPHD", 1, 1);
+        parser.addArgument("output", "Output pathname", cli::STORE, "output",
+                           "CPHD", 1, 1);
+        const std::unique_ptr<cli::Results> options(parser.parse(argc, argv));
+
+        std::vector<std::string> schemaPathnames;
+        if (options->hasValue("schema"))
+        {
+            const cli::Value* value = options->getValue("schema");
+            for (size_t ii = 0; ii < value->size(); ++ii)
+            {
+                schemaPathnames.push_back(value->get<std::string>(ii));
+            }
+        }
+
+        const cphd::CPHDSubsetWriter writer(
+                options->get<std::string>("input"),
+                schemaPathnames,
+                options->get<size_t>("blockSize") * 1024 * 1024);
+
+        std::vector<size_t> channels;
+        if (options->hasValue("channels"))
+        {
+            const cli::Value* value = options->getValue("channels");
+            for (size_t ii = 0; ii < value->size(); ++ii)
+            {
+                channels.push_back(value->get<size_t>(ii));
+            }
+        }
+        else
+        {
+            for (size_t ii = 0;
+                 ii < writer.getMetadata().data.getNumChannels();
+                 ++ii)
+            {
+                channels.push_back(ii);
+            }
+        }
+
+        std::vector<cphd::ChannelSubset> subsets;
+        for (size_t ii = 0; ii < channels.size(); ++ii)
+        {
+            cphd::ChannelSubset subset(channels[ii]);
+            if (options->hasValue("vectors"))
+            {
+                subset.firstVector = options->getValue("vectors")->get<size_t>(0);
+                subset.lastVector = options->getValue("vectors")->get<size_t>(1);
+            }
+            if (options->hasValue("samples"))
+            {
+                subset.firstSample = options->getValue("samples")->get<size_t>(0);
+                subset.lastSample = options->getValue("samples")->get<size_t>(1);
+            }
+            subsets.push_back(subset);
+        }
+
+        writer.write(subsets, options->get<std::string>("output"));
+        return 0;
+    }
+    catch (const except::Exception& ex)
+    {
+        std::cerr << ex.toString() << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+    }
+    catch (...)
+    {
+        std::cerr << "Unknown exception\n";
+    }
+    return 1;
+}
@@ -21,216 +21,65 @@
  */
 
 #include <iostream>
-#include <fstream>
 #include <memory>
-#include <logging/NullLogger.h>
 #include <cli/Value.h>
 #include <cli/ArgumentParser.h>
-#include <io/FileInputStream.h>
-#include <io/FileOutputStream.h>
-#include <cphd/Metadata.h>
-#include <cphd/PVPBlock.h>
+#include <cphd/CPHDComparator.h>
 #include <cphd/CPHDReader.h>
-#include <str/Convert.h>
 
 /*!
  * Compares two CPHD files
- * Returns true if they do, false if not
+ * Returns 0 if they match within the tolerances, 1 if not
  */
 
-template <typename T>
-bool compareCPHDData(const sys::ubyte* data1,
-                     const sys::ubyte* data2,
-                     size_t size,
-                     size_t channel)
-{
-    const T* castData1 = reinterpret_cast<const T*>(data1);
-    const T* castData2 = reinterpret_cast<const T*>(data2);
-
-    for (size_t ii = 0; ii < size; ++ii)
-    {
-        if (castData1[ii] != castData2[ii])
-        {
-            std::cerr << "Wideband data at channel " << channel
-                      << " has differing data starting at"
-                      << " index " << ii << "\n";
-            return false;
-        }
-    }
-    return true;
-}
-
-bool compareSupportData(const mem::ScopedArray<sys::ubyte>& data1,
-                     const mem::ScopedArray<sys::ubyte>& data2,
-                     size_t size)
-{
-    for (size_t ii = 0; ii < size; ++ii)
-    {
-        if (data1[ii] != data2[ii])
-        {
-            std::cerr <<  "Support data has differing data starting at"
-                      << " index " << ii << "\n";
-            return false;
-        }
-    }
-    return true;
-}
-
-bool compareWideband(cphd::CPHDReader& reader1,
-                     cphd::CPHDReader& reader2,
-                     size_t channelsToProcess,
-                     size_t numThreads)
-{
-    bool dataMatches = true;
-
-    const cphd::Wideband& wideband1 = reader1.getWideband();
-    const cphd::Wideband& wideband2 = reader2.getWideband();
-
-    mem::ScopedArray<sys::ubyte> cphdData1;
-    mem::ScopedArray<sys::ubyte> cphdData2;
-
-    for (size_t ii = 0; ii < channelsToProcess; ++ii)
-    {
-        const types::RowCol<size_t> dims1(
-                reader1.getMetadata().data.getNumVectors(ii),
-                reader1.getMetadata().data.getNumSamples(ii));
-        const types::RowCol<size_t> dims2(
-                reader2.getMetadata().data.getNumVectors(ii),
-                reader2.getMetadata().data.getNumSamples(ii));
-
-        if (dims1 == dims2)
-        {
-            wideband1.read(ii,
-                           0, cphd::Wideband::ALL, 0,
-                           cphd::Wideband::ALL,
-                           numThreads, cphdData1);
-
-            wideband2.read(ii,
-                           0, cphd::Wideband::ALL, 0,
-                           cphd::Wideband::ALL,
-                           numThreads, cphdData2);
-
-            switch (reader1.getMetadata().data.getSampleType())
-            {
-            case cphd::SampleType::RE08I_IM08I:
-                if (!compareCPHDData<std::complex<sys::Int8_T> >(
-                        cphdData1.get(),
-                        cphdData2.get(),
-                        dims1.area(),
-                        ii))
-                {
-                    dataMatches = false;
-                }
-                break;
-            case cphd::SampleType::RE16I_IM16I:
-                if (!compareCPHDData<std::complex<sys::Int16_T> >(
-                        cphdData1.get(),
-                        cphdData2.get(),
-                        dims1.area(),
-                        ii))
-                {
-                    dataMatches = false;
-                }
-                break;
-            case cphd::SampleType::RE32F_IM32F:
-                if (!compareCPHDData<std::complex<float> >(
-                        cphdData1.get(),
-                        cphdData2.get(),
-                        dims1.area(),
-                        ii))
-                {
-                    dataMatches = false;
-                }
-                break;
-            }
-        }
-        else
-        {
-            std::cerr << "Data at channel " << ii
-                      << " has differing dimensions\n";
-            dataMatches = false;
-        }
-    }
-
-    return dataMatches;
-}
-
-bool checkCPHD(const std::string& pathname1, const std::string& pathname2, size_t numThreads, const std::vector<std::string>& schemaPathname)
-{
-    cphd::CPHDReader reader1(pathname1, numThreads, schemaPathname);
-    cphd::CPHDReader reader2(pathname2, numThreads, schemaPathname);
-
-    // Check metadata
-    if (reader1.getMetadata() != reader2.getMetadata())
-    {
-        std::cerr << "Metadata does not match \n";
-        return false;
-    }
-
-    // Check pvp block
-    if (reader1.getPVPBlock() != reader2.getPVPBlock())
-    {
-        std::cerr << "PVPBlock does not match \n";
-        return false;
-    }
-
-    // Check support block
-    mem::ScopedArray<sys::ubyte> readPtr1;
-    reader1.getSupportBlock().readAll(numThreads, readPtr1);
-    mem::ScopedArray<sys::ubyte> readPtr2;
-    reader2.getSupportBlock().readAll(numThreads, readPtr2);
-    if (!compareSupportData(readPtr1, readPtr2, reader1.getMetadata().data.getAllSupportSize()))
-    {
-        std::cerr << "SupportBlock does not match \n";
-        return false;
-    }
-
-    // // Check wideband
-    const size_t channelsToProcess = std::min(
-            reader1.getMetadata().data.getNumChannels(),
-            reader2.getMetadata().data.getNumChannels());
-    if (reader1.getMetadata().data.getNumChannels() !=
-        reader2.getMetadata().data.getNumChannels())
-    {
-        std::cerr << "Files contain a differing number of channels "
-                  << "comparison will continue but will only look at "
-                  << "the first " << channelsToProcess << " channels\n";
-        return false;
-    }
-    //! Only process wideband data if the data types are the same
-    if (reader1.getMetadata().data.getSampleType() ==
-        reader2.getMetadata().data.getSampleType())
-    {
-        const bool cphdDataMatches = compareWideband(reader1,
-                                                     reader2,
-                                                     channelsToProcess,
-                                                     numThreads);
-        if (!cphdDataMatches)
-        {
-            std::cerr << "Wideband data does not match \n";
-            return false;
-        }
-    }
-    else
-    {
-        std::cerr << "Data has differing sample type\n";
-        return false;
-    }
-    return true;
-}
-
 int main(int argc, char** argv)
 {
     try
     {
         // Parse the command line
         cli::ArgumentParser parser;
-        parser.setDescription("Round trip for a CPHD file.");
+        parser.setDescription("Compare two CPHD files.");
         parser.addArgument("-t --threads",
                            "Specify the number of threads to use",
                            cli::STORE,
                            "threads",
                            "NUM")->setDefault(sys::OS().getNumCPUs());
+        parser.addArgument("--abs",
+                           "Absolute tolerance for signal samples",
+                           cli::STORE,
+                           "abs",
+                           "VAL")->setDefault(0.0);
+        parser.addArgument("--rel",
+                           "Relative tolerance for signal samples",
+                           cli::STORE,
+                           "rel",
+                           "VAL")->setDefault(0.0);
+        parser.addArgument("--ulps",
+                           "Tolerance in ULPs for signal samples",
+                           cli::STORE,
+                           "ulps",
+                           "NUM")->setDefault(0);
+        parser.addArgument("--pvp-abs",
+                           "Absolute tolerance for floating point PVPs",
+                           cli::STORE,
+                           "pvpAbs",
+                           "VAL")->setDefault(0.0);
+        parser.addArgument("--pvp-rel",
+                           "Relative tolerance for floating point PVPs",
+                           cli::STORE,
+                           "pvpRel",
+                           "VAL")->setDefault(0.0);
+        parser.addArgument("--pvp-ulps",
+                           "Tolerance in ULPs for floating point PVPs",
+                           cli::STORE,
+                           "pvpUlps",
+                           "NUM")->setDefault(0);
+        parser.addArgument("-b --block-size",
+                           "Megabytes of signal data to read from each file "
+                           "at once",
+                           cli::STORE,
+                           "blockSize",
+                           "MB")->setDefault(64);
         parser.addArgument("file1", "First pathname", cli::STORE, "file1",
                            "CPHD", 1, 1);
         parser.addArgument("file2", "Second pathname", cli::STORE, "file2",
@@ -241,6 +90,16 @@ int main(int argc, char** argv)
         const std::string pathname1(options->get<std::string>("file1"));
         const std::string pathname2(options->get<std::string>("file2"));
         const size_t numThreads(options->get<size_t>("threads"));
+        const cphd::CompareTolerance signalTolerance(
+                options->get<double>("abs"),
+                options->get<double>("rel"),
+                options->get<size_t>("ulps"));
+        const cphd::CompareTolerance pvpTolerance(
+                options->get<double>("pvpAbs"),
+                options->get<double>("pvpRel"),
+                options->get<size_t>("pvpUlps"));
+        const size_t blockSize =
+                options->get<size_t>("blockSize") * 1024 * 1024;
         const cli::Value* value = options->getValue("schema");
 
         std::vector<std::string> schemaPathnames;
@@ -249,8 +108,19 @@ int main(int argc, char** argv)
             schemaPathnames.push_back(value->get<std::string>(ii));
         }
 
-        const bool isMatch = checkCPHD(pathname1, pathname2, numThreads, schemaPathnames);
-        if (!isMatch)
+        const cphd::CPHDReader reader1(pathname1, numThreads,
+                                       schemaPathnames);
+        const cphd::CPHDReader reader2(pathname2, numThreads,
+                                       schemaPathnames);
+
+        const cphd::CPHDComparator comparator(signalTolerance,
+                                              pvpTolerance,
+                                              numThreads,
+                                              blockSize);
+        const cphd::CPHDComparison comparison =
+                comparator.compare(reader1, reader2);
+        std::cout << comparison;
+        if (!comparison.matches())
         {
             std::cerr << "CPHD Files do not match \n";
             return 1;
@@ -0,0 +1,103 @@
+/* =========================================================================
+ * This file is part of cphd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * cphd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <iostream>
+#include <memory>
+#include <cli/Value.h>
+#include <cli/ArgumentParser.h>
+#include <io/FileInputStream.h>
+#include <sys/OS.h>
+#include <cphd/CPHDMetadataReader.h>
+#include <cphd/PVPValidator.h>
+
+/*!
+ * Checks a CPHD's PVPs against its metadata, streaming them from the file
+ */
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        // Parse the command line
+        cli::ArgumentParser parser;
+        parser.setDescription(
+                "Check a CPHD's per vector parameters against its metadata. "
+                "Exits with 2 if any rule is broken.");
+        parser.addArgument("-t --threads",
+                           "Number of threads to use",
+                           cli::STORE,
+                           "threads",
+                           "NUM")->setDefault(sys::OS().getNumCPUs());
+        parser.addArgument("-b --block-size",
+                           "Megabytes of PVPs to read at once",
+                           cli::STORE,
+                           "blockSize",
+                           "MB")->setDefault(4);
+        parser.addArgument("--schema",
+                           "Schema pathname",
+                           cli::STORE,
+                           "schema",
+                           "XSD",
+                           1);
+        parser.addArgument("input", "Input pathname", cli::STORE, "input",
+                           "CPHD", 1, 1);
+        const std::unique_ptr<cli::Results> options(parser.parse(argc, argv));
+
+        std::vector<std::string> schemaPathnames;
+        if (options->hasValue("schema"))
+        {
+            const cli::Value* value = options->getValue("schema");
+            for (size_t ii = 0; ii < value->size(); ++ii)
+            {
+                schemaPathnames.push_back(value->get<std::string>(ii));
+            }
+        }
+
+        std::shared_ptr<io::SeekableInputStream> inStream(
+                new io::FileInputStream(options->get<std::string>("input")));
+        const cphd::CPHDMetadataReader reader(inStream);
+        const std::unique_ptr<cphd::Metadata> metadata =
+                reader.getMetadata(schemaPathnames);
+
+        const cphd::PVPValidator validator(
+                *metadata,
+                options->get<size_t>("threads"),
+                options->get<size_t>("blockSize") * 1024 * 1024);
+        const cphd::PVPValidation validation = validator.validate(
+                *inStream, reader.getFileHeader().getPvpBlockByteOffset());
+        std::cout << validation;
+        return validation.isValid() ? 0 : 2;
+    }
+    catch (const except::Exception& ex)
+    {
+        std::cerr << ex.toString() << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+    }
+    catch (...)
+    {
+        std::cerr << "Unknown exception\n";
+    }
+    return 1;
+}
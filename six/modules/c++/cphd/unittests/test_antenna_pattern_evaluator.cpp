@@ -0,0 +1,456 @@
+/* =========================================================================
+ * This file is part of cphd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * cphd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include <io/ByteStream.h>
+#include <str/Convert.h>
+#include <sys/Conf.h>
+#include <six/Init.h>
+#include <cphd/AntennaPatternEvaluator.h>
+#include <cphd/Metadata.h>
+#include <cphd/PVPBlock.h>
+#include <cphd/SupportBlock.h>
+#include <cphd/TestDataGenerator.h>
+#include "TestCase.h"
+
+namespace
+{
+const size_t NUM_VECTORS = 8;
+const size_t NUM_SAMPLES = 4;
+const double FREQ_ZERO = 10e9;
+
+// Sampled grid
+const size_t NUM_ROWS = 3;
+const size_t NUM_COLS = 4;
+const double X0 = -0.1;
+const double Y0 = -0.15;
+const double SPACING = 0.1;
+
+cphd::Vector3 makeVector(double x, double y, double z)
+{
+    cphd::Vector3 vector;
+    vector[0] = x;
+    vector[1] = y;
+    vector[2] = z;
+    return vector;
+}
+
+cphd::Poly2D makePoly2D(double c01, double c10, double c11, double c20)
+{
+    cphd::Poly2D poly(2, 1);
+    poly[0][1] = c01;
+    poly[1][0] = c10;
+    poly[1][1] = c11;
+    poly[2][0] = c20;
+    return poly;
+}
+
+cphd::Metadata createMetadata()
+{
+    cphd::Metadata metadata;
+    cphd::setUpData(metadata,
+                    types::RowCol<size_t>(NUM_VECTORS, NUM_SAMPLES),
+                    std::vector<std::complex<float> >());
+    cphd::setPVPXML(metadata.pvp);
+
+    metadata.antenna.reset(new cphd::Antenna());
+    cphd::Antenna& antenna = *metadata.antenna;
+
+    // Rotating about Z, and not quite unit length
+    cphd::AntCoordFrame acf;
+    acf.identifier = "ACF";
+    acf.xAxisPoly = cphd::PolyXYZ(1);
+    acf.xAxisPoly[0] = makeVector(2.0, 0.0, 0.0);
+    acf.xAxisPoly[1] = makeVector(0.0, 0.2, 0.0);
+    acf.yAxisPoly = cphd::PolyXYZ(1);
+    acf.yAxisPoly[0] = makeVector(0.0, 2.0, 0.0);
+    acf.yAxisPoly[1] = makeVector(-0.2, 0.0, 0.0);
+    antenna.antCoordFrame.push_back(acf);
+
+    cphd::AntPhaseCenter apc;
+    apc.identifier = "APC";
+    apc.acfId = "ACF";
+    antenna.antPhaseCenter.push_back(apc);
+
+    cphd::AntPattern pattern;
+    pattern.identifier = "APAT";
+    pattern.freqZero = FREQ_ZERO;
+    pattern.gainZero = 30.0;
+    pattern.ebFreqShift = six::BooleanType::IS_TRUE;
+    pattern.mlFreqDilation = six::BooleanType::IS_TRUE;
+    pattern.gainBSPoly = cphd::Poly1D(2);
+    pattern.gainBSPoly[1] = -4.0;
+    pattern.gainBSPoly[2] = 50.0;
+    pattern.eb.dcxPoly = cphd::Poly1D(1);
+    pattern.eb.dcxPoly[0] = 0.01;
+    pattern.eb.dcxPoly[1] = 0.002;
+    pattern.eb.dcyPoly = cphd::Poly1D(0);
+    pattern.eb.dcyPoly[0] = -0.02;
+    pattern.array.gainPoly = makePoly2D(-3.0, 2.0, -40.0, -100.0);
+    pattern.array.phasePoly = makePoly2D(0.5, -0.25, 1.0, 0.0);
+    pattern.element.gainPoly = makePoly2D(-1.0, 0.0, 0.0, -5.0);
+    pattern.element.phasePoly = makePoly2D(0.0, 0.1, 0.0, 0.0);
+    antenna.antPattern.push_back(pattern);
+
+    metadata.channel.parameters.resize(1);
+    metadata.channel.parameters[0].antenna.reset(
+            new cphd::ChannelParameter::Antenna());
+    cphd::ChannelParameter::Antenna& ids =
+            *metadata.channel.parameters[0].antenna;
+    ids.txAPCId = ids.rcvAPCId = "APC";
+    ids.txAPATId = ids.rcvAPATId = "APAT";
+    return metadata;
+}
+
+// The reference, one point at a time
+void evaluatePoint(const cphd::AntPattern& pattern,
+                   double time,
+                   double frequency,
+                   double dcx,
+                   double dcy,
+                   double& gain,
+                   double& phase)
+{
+    const double shift = pattern.freqZero / frequency;
+    const double dilation = frequency / pattern.freqZero;
+    const double dx = (dcx - pattern.eb.dcxPoly(time) * shift) * dilation;
+    const double dy = (dcy - pattern.eb.dcyPoly(time) * shift) * dilation;
+    gain = pattern.gainZero +
+            pattern.gainBSPoly(frequency / pattern.freqZero - 1.0) +
+            pattern.array.gainPoly(dx, dy) +
+            pattern.element.gainPoly(dcx, dcy);
+    phase = pattern.array.phasePoly(dx, dy) +
+            pattern.element.phasePoly(dcx, dcy);
+}
+
+TEST_CASE(testPolynomials)
+{
+    const cphd::Metadata metadata = createMetadata();
+    const cphd::AntennaPatternEvaluator evaluator(metadata, nullptr, 3);
+
+    const size_t numPoints = 5;
+    std::vector<double> times;
+    std::vector<double> frequencies;
+    std::vector<double> dcx;
+    std::vector<double> dcy;
+    for (size_t ii = 0; ii < NUM_VECTORS; ++ii)
+    {
+        times.push_back(ii * 0.5);
+        frequencies.push_back(FREQ_ZERO + (ii - 4.0) * 1e8);
+        for (size_t jj = 0; jj < numPoints; ++jj)
+        {
+            dcx.push_back(-0.05 + 0.02 * jj + 0.001 * ii);
+            dcy.push_back(0.03 - 0.015 * jj);
+        }
+    }
+
+    std::vector<double> gain(dcx.size());
+    std::vector<double> phase(dcx.size());
+    evaluator.evaluate("APAT", times.data(), frequencies.data(), NUM_VECTORS,
+                       dcx.data(), dcy.data(), numPoints,
+                       gain.data(), phase.data());
+
+    const cphd::AntPattern& pattern = metadata.antenna->antPattern[0];
+    for (size_t ii = 0; ii < NUM_VECTORS; ++ii)
+    {
+        for (size_t jj = 0; jj < numPoints; ++jj)
+        {
+            const size_t index = ii * numPoints + jj;
+            double expectedGain;
+            double expectedPhase;
+            evaluatePoint(pattern, times[ii], frequencies[ii],
+                          dcx[index], dcy[index],
+                          expectedGain, expectedPhase);
+            TEST_ASSERT_ALMOST_EQ_EPS(gain[index], expectedGain, 1e-9);
+            TEST_ASSERT_ALMOST_EQ_EPS(phase[index], expectedPhase, 1e-12);
+        }
+    }
+
+    TEST_EXCEPTION(evaluator.evaluate("Unknown", times.data(),
+                                      frequencies.data(), NUM_VECTORS,
+                                      dcx.data(), dcy.data(), numPoints,
+                                      gain.data(), phase.data()));
+}
+
+TEST_CASE(testDirectionCosines)
+{
+    const cphd::AntennaPatternEvaluator evaluator(createMetadata());
+
+    // At time 0 the ACF is aligned with ECF.  At time 10 it's turned 45
+    // degrees about Z.
+    const double times[] = {0.0, 10.0};
+    const cphd::Vector3 apcPositions[] =
+    {
+        makeVector(1000.0, 2000.0, 3000.0),
+        makeVector(-500.0, 0.0, 100.0)
+    };
+    const cphd::Vector3 points[] =
+    {
+        apcPositions[0] + makeVector(60.0, 80.0, 0.0),
+        apcPositions[0] + makeVector(0.0, 0.0, -50.0),
+        apcPositions[1] + makeVector(1.0, 1.0, 0.0),
+    };
+    std::vector<double> dcx(6);
+    std::vector<double> dcy(6);
+    evaluator.getDirectionCosines("APC", times, apcPositions, 2, points, 3,
+                                  dcx.data(), dcy.data());
+
+    TEST_ASSERT_ALMOST_EQ(dcx[0], 0.6);
+    TEST_ASSERT_ALMOST_EQ(dcy[0], 0.8);
+    TEST_ASSERT_ALMOST_EQ(dcx[1], 0.0);
+    TEST_ASSERT_ALMOST_EQ(dcy[1], 0.0);
+    TEST_ASSERT_ALMOST_EQ(dcx[5], 1.0);
+    TEST_ASSERT_ALMOST_EQ(dcy[5], 0.0);
+
+    TEST_EXCEPTION(evaluator.getDirectionCosines("Unknown", times,
+                                                 apcPositions, 2, points, 3,
+                                                 dcx.data(), dcy.data()));
+}
+
+TEST_CASE(testTwoWay)
+{
+    const cphd::Metadata metadata = createMetadata();
+    cphd::PVPBlock pvpBlock(metadata.pvp, metadata.data);
+    for (size_t ii = 0; ii < NUM_VECTORS; ++ii)
+    {
+        pvpBlock.setTxTime(ii * 0.1, 0, ii);
+        pvpBlock.setTxPos(makeVector(7e6, ii * 100.0, 1e4), 0, ii);
+        pvpBlock.setRcvTime(ii * 0.1 + 0.05, 0, ii);
+        pvpBlock.setRcvPos(makeVector(7e6, ii * 100.0 + 50.0, 1e4), 0, ii);
+        pvpBlock.setFx1(FREQ_ZERO - 1e8 + ii * 1e7, 0, ii);
+        pvpBlock.setFx2(FREQ_ZERO + 1e8 + ii * 1e7, 0, ii);
+    }
+
+    const size_t numPoints = 4;
+    std::vector<cphd::Vector3> points;
+    for (size_t ii = 0; ii < numPoints; ++ii)
+    {
+        points.push_back(makeVector(7e6 + 1e5, -500.0 + ii * 400.0, 1e3));
+    }
+
+    const size_t firstVector = 2;
+    const size_t numVectors = 5;
+    const size_t numValues = numVectors * numPoints;
+    const cphd::AntennaPatternEvaluator evaluator(metadata);
+    std::vector<double> gain(numValues);
+    std::vector<double> phase(numValues);
+    evaluator.evaluateTwoWay(pvpBlock, 0, firstVector, numVectors,
+                             points.data(), numPoints,
+                             gain.data(), phase.data());
+
+    // Matches the one way patterns added up
+    const cphd::AntPattern& pattern = metadata.antenna->antPattern[0];
+    std::vector<double> times(2);
+    std::vector<cphd::Vector3> positions(2);
+    std::vector<double> dcx(2 * numPoints);
+    std::vector<double> dcy(2 * numPoints);
+    for (size_t ii = 0; ii < numVectors; ++ii)
+    {
+        const size_t vector = firstVector + ii;
+        times[0] = pvpBlock.getTxTime(0, vector);
+        times[1] = pvpBlock.getRcvTime(0, vector);
+        positions[0] = pvpBlock.getTxPos(0, vector);
+        positions[1] = pvpBlock.getRcvPos(0, vector);
+        const double frequency = FREQ_ZERO + vector * 1e7;
+        evaluator.getDirectionCosines("APC", times.data(), positions.data(),
+                                      2, points.data(), numPoints,
+                                      dcx.data(), dcy.data());
+        for (size_t jj = 0; jj < numPoints; ++jj)
+        {
+            double txGain;
+            double txPhase;
+            evaluatePoint(pattern, times[0], frequency, dcx[jj], dcy[jj],
+                          txGain, txPhase);
+            double rcvGain;
+            double rcvPhase;
+            evaluatePoint(pattern, times[1], frequency,
+                          dcx[numPoints + jj], dcy[numPoints + jj],
+                          rcvGain, rcvPhase);
+            TEST_ASSERT_ALMOST_EQ_EPS(gain[ii * numPoints + jj],
+                                      txGain + rcvGain, 1e-9);
+            TEST_ASSERT_ALMOST_EQ_EPS(phase[ii * numPoints + jj],
+                                      txPhase + rcvPhase, 1e-12);
+        }
+    }
+
+    // Threads don't change anything
+    const cphd::AntennaPatternEvaluator threadedEvaluator(metadata, nullptr, 4);
+    std::vector<double> threadedGain(numValues);
+    std::vector<double> threadedPhase(numValues);
+    threadedEvaluator.evaluateTwoWay(pvpBlock, 0, firstVector, numVectors,
+                                     points.data(), numPoints,
+                                     threadedGain.data(),
+                                     threadedPhase.data());
+    TEST_ASSERT(threadedGain == gain);
+    TEST_ASSERT(threadedPhase == phase);
+
+    TEST_EXCEPTION(evaluator.evaluateTwoWay(pvpBlock, 0, 4, numVectors,
+                                            points.data(), numPoints,
+                                            gain.data(), phase.data()));
+    TEST_EXCEPTION(evaluator.evaluateTwoWay(pvpBlock, 1, 0, 1,
+                                            points.data(), numPoints,
+                                            gain.data(), phase.data()));
+}
+
+TEST_CASE(testBoresightGain)
+{
+    // Only G_0 and GainBSPoly, so the gain is the same in every direction
+    cphd::Metadata metadata = createMetadata();
+    cphd::AntPattern& pattern = metadata.antenna->antPattern[0];
+    pattern.array.gainPoly = cphd::Poly2D();
+    pattern.array.phasePoly = cphd::Poly2D();
+    pattern.element.gainPoly = cphd::Poly2D();
+    pattern.element.phasePoly = cphd::Poly2D();
+    pattern.gainZero = 30.0;
+    pattern.gainBSPoly = cphd::Poly1D(2);
+    pattern.gainBSPoly[0] = 1.0;
+    pattern.gainBSPoly[1] = -4.0;
+    pattern.gainBSPoly[2] = 50.0;
+    const cphd::AntennaPatternEvaluator evaluator(metadata);
+
+    // 10% above, at, and 20% below f_0
+    const double times[] = {0.0, 0.0, 0.0};
+    const double frequencies[] = {1.1 * FREQ_ZERO, FREQ_ZERO, 0.8 * FREQ_ZERO};
+    const double dcx[] = {0.01, -0.02, 0.03};
+    const double dcy[] = {0.0, 0.01, -0.01};
+    double gain[3];
+    double phase[3];
+    evaluator.evaluate("APAT", times, frequencies, 3, dcx, dcy, 1,
+                       gain, phase);
+    TEST_ASSERT_ALMOST_EQ(gain[0], 30.0 + 1.0 - 0.4 + 0.5);
+    TEST_ASSERT_ALMOST_EQ(gain[1], 30.0 + 1.0);
+    TEST_ASSERT_ALMOST_EQ(gain[2], 30.0 + 1.0 + 0.8 + 2.0);
+    TEST_ASSERT_ALMOST_EQ(phase[0], 0.0);
+}
+
+// Gain and phase of the sampled array for support array 'id'
+double getGridGain(size_t id, size_t row, size_t col)
+{
+    return -10.0 * row + 2.0 * col - id;
+}
+
+double getGridPhase(size_t id, size_t row, size_t col)
+{
+    return 0.1 * row * col + 0.5 * id;
+}
+
+void appendBigEndian(float value, std::vector<sys::ubyte>& bytes)
+{
+    sys::ubyte buffer[sizeof(float)];
+    std::memcpy(buffer, &value, sizeof(float));
+    if (!sys::isBigEndianSystem())
+    {
+        std::reverse(buffer, buffer + sizeof(float));
+    }
+    bytes.insert(bytes.end(), buffer, buffer + sizeof(float));
+}
+
+TEST_CASE(testSampled)
+{
+    cphd::Metadata metadata = createMetadata();
+    cphd::AntPattern& pattern = metadata.antenna->antPattern[0];
+    pattern.gainZero = six::Init::undefined<double>();
+    pattern.gainBSPoly = cphd::Poly1D();
+    pattern.eb.dcxPoly = cphd::Poly1D();
+    pattern.eb.dcyPoly = cphd::Poly1D();
+    pattern.element.gainPoly = cphd::Poly2D();
+    pattern.element.phasePoly = cphd::Poly2D();
+    pattern.gainPhaseArray.resize(2);
+    pattern.gainPhaseArray[0].freq = FREQ_ZERO + 1e9;
+    pattern.gainPhaseArray[0].arrayId = "1";
+    pattern.gainPhaseArray[1].freq = FREQ_ZERO - 1e9;
+    pattern.gainPhaseArray[1].arrayId = "0";
+
+    // Big endian Gain=F4;Phase=F4;, as it is on disk
+    metadata.supportArray.reset(new cphd::SupportArray());
+    std::vector<sys::ubyte> supportBytes;
+    for (size_t ii = 0; ii < 2; ++ii)
+    {
+        metadata.supportArray->antGainPhase.push_back(
+                cphd::SupportArrayParameter("Gain=F4;Phase=F4;", ii,
+                                            X0, Y0, SPACING, SPACING));
+        metadata.data.setSupportArray(str::toString(ii), NUM_ROWS, NUM_COLS,
+                                      8, supportBytes.size());
+        for (size_t row = 0; row < NUM_ROWS; ++row)
+        {
+            for (size_t col = 0; col < NUM_COLS; ++col)
+            {
+                appendBigEndian(getGridGain(ii, row, col), supportBytes);
+                appendBigEndian(getGridPhase(ii, row, col), supportBytes);
+            }
+        }
+    }
+    std::shared_ptr<io::ByteStream> stream(new io::ByteStream());
+    stream->write(supportBytes.data(), supportBytes.size());
+    stream->seek(0, io::Seekable::START);
+    const cphd::SupportBlock supportBlock(stream, metadata.data,
+                                          0, supportBytes.size());
+    const cphd::AntennaPatternEvaluator evaluator(metadata, &supportBlock);
+
+    // On a sample, halfway between samples and off the grid
+    const double dcx[] = {X0 + SPACING, X0 + 0.5 * SPACING, X0 - 0.01};
+    const double dcy[] = {Y0 + 2 * SPACING, Y0 + 1.5 * SPACING, Y0};
+    const double times[] = {0.0};
+    double gain[3];
+    double phase[3];
+
+    // Between the two arrays
+    const double midFrequency[] = {FREQ_ZERO};
+    evaluator.evaluate("APAT", times, midFrequency, 1, dcx, dcy, 3,
+                       gain, phase);
+    TEST_ASSERT_ALMOST_EQ(gain[0], -10.0 + 4.0 - 0.5);
+    TEST_ASSERT_ALMOST_EQ(phase[0], 0.2 + 0.25);
+    TEST_ASSERT_ALMOST_EQ(gain[1], -5.0 + 3.0 - 0.5);
+    TEST_ASSERT_ALMOST_EQ(phase[1],
+                          (0.0 + 0.0 + 0.1 + 0.2) / 4 + 0.25);
+    TEST_ASSERT_TRUE(std::isnan(gain[2]));
+    TEST_ASSERT_TRUE(std::isnan(phase[2]));
+
+    // Above both arrays takes the upper one
+    const double highFrequency[] = {FREQ_ZERO + 5e9};
+    evaluator.evaluate("APAT", times, highFrequency, 1, dcx, dcy, 3,
+                       gain, phase);
+    TEST_ASSERT_ALMOST_EQ(gain[0], getGridGain(1, 1, 2));
+    TEST_ASSERT_ALMOST_EQ(phase[0], getGridPhase(1, 1, 2));
+
+    // Without the support block it's back to the polynomials
+    const cphd::AntennaPatternEvaluator polyEvaluator(metadata);
+    polyEvaluator.evaluate("APAT", times, highFrequency, 1, dcx, dcy, 3,
+                           gain, phase);
+    TEST_ASSERT_FALSE(std::isnan(gain[2]));
+}
+}
+
+int main(int, char**)
+{
+    TEST_CHECK(testPolynomials);
+    TEST_CHECK(testDirectionCosines);
+    TEST_CHECK(testTwoWay);
+    TEST_CHECK(testBoresightGain);
+    TEST_CHECK(testSampled);
+    return 0;
+}
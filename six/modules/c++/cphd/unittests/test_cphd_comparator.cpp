@@ -0,0 +1,232 @@
+/* =========================================================================
+ * This file is part of cphd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * cphd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cmath>
+#include <complex>
+#include <string>
+#include <vector>
+#include <io/TempFile.h>
+#include <types/RowCol.h>
+#include <cphd/CPHDComparator.h>
+#include <cphd/CPHDReader.h>
+#include <cphd/CPHDWriter.h>
+#include <cphd/Metadata.h>
+#include <cphd/PVPBlock.h>
+#include <cphd/TestDataGenerator.h>
+#include "TestCase.h"
+
+namespace
+{
+const types::RowCol<size_t> DIMS(64, 32);
+const size_t NUM_THREADS = 4;
+
+// One vector at a time, so the streaming gets exercised
+const size_t BLOCK_SIZE = 1;
+
+std::vector<std::complex<float> > generateData()
+{
+    std::vector<std::complex<float> > data(DIMS.area());
+    for (size_t ii = 0; ii < data.size(); ++ii)
+    {
+        data[ii] = std::complex<float>(ii * 0.5f, -1.0f * ii);
+    }
+    return data;
+}
+
+class TestFiles
+{
+public:
+    TestFiles() :
+        mData(generateData())
+    {
+        cphd::setUpData(mMetadata, DIMS, mData);
+        cphd::setPVPXML(mMetadata.pvp);
+        mPVPBlock.reset(new cphd::PVPBlock(mMetadata.pvp, mMetadata.data));
+        for (size_t ii = 0; ii < DIMS.row; ++ii)
+        {
+            cphd::setVectorParameters(0, ii, *mPVPBlock);
+        }
+    }
+
+    std::vector<std::complex<float> >& getData()
+    {
+        return mData;
+    }
+
+    cphd::PVPBlock& getPVPBlock()
+    {
+        return *mPVPBlock;
+    }
+
+    void write(const std::string& pathname)
+    {
+        cphd::CPHDWriter writer(mMetadata, pathname);
+        writer.writeMetadata(*mPVPBlock);
+        writer.writePVPData(*mPVPBlock);
+        writer.writeCPHDData(mData.data(), mData.size());
+    }
+
+private:
+    cphd::Metadata mMetadata;
+    std::unique_ptr<cphd::PVPBlock> mPVPBlock;
+    std::vector<std::complex<float> > mData;
+};
+
+cphd::CPHDComparison compareFiles(
+        const std::string& pathname1,
+        const std::string& pathname2,
+        const cphd::CompareTolerance& signalTolerance =
+                cphd::CompareTolerance(),
+        const cphd::CompareTolerance& pvpTolerance =
+                cphd::CompareTolerance())
+{
+    const cphd::CPHDReader reader1(pathname1, NUM_THREADS);
+    const cphd::CPHDReader reader2(pathname2, NUM_THREADS);
+    const cphd::CPHDComparator comparator(signalTolerance, pvpTolerance,
+                                          NUM_THREADS, BLOCK_SIZE);
+    return comparator.compare(reader1, reader2);
+}
+
+TEST_CASE(testIdentical)
+{
+    io::TempFile file1;
+    io::TempFile file2;
+    TestFiles files;
+    files.write(file1.pathname());
+    files.write(file2.pathname());
+
+    const cphd::CPHDComparison comparison =
+            compareFiles(file1.pathname(), file2.pathname());
+    TEST_ASSERT_TRUE(comparison.matches());
+    TEST_ASSERT_EQ(comparison.signal.size(), static_cast<size_t>(1));
+    TEST_ASSERT_EQ(comparison.signal[0].numCompared, DIMS.area());
+    TEST_ASSERT_EQ(comparison.pvp.size(), static_cast<size_t>(1));
+    TEST_ASSERT_EQ(comparison.pvp[0].at("TxTime").numCompared, DIMS.row);
+}
+
+TEST_CASE(testSignalMismatches)
+{
+    io::TempFile file1;
+    io::TempFile file2;
+    TestFiles files;
+    files.write(file1.pathname());
+
+    const size_t first = 3 * DIMS.col + 5;
+    const size_t last = 60 * DIMS.col + 1;
+    files.getData()[first] += std::complex<float>(0.25f, 0.0f);
+    files.getData()[last] += std::complex<float>(0.0f, -0.125f);
+    files.write(file2.pathname());
+
+    cphd::CPHDComparison comparison =
+            compareFiles(file1.pathname(), file2.pathname());
+    TEST_ASSERT_FALSE(comparison.matches());
+    TEST_ASSERT_TRUE(comparison.differences.empty());
+    TEST_ASSERT_TRUE(comparison.pvp[0].at("TxPos").matches());
+
+    const cphd::MismatchStats& stats = comparison.signal[0];
+    TEST_ASSERT_EQ(stats.numCompared, DIMS.area());
+    TEST_ASSERT_EQ(stats.numMismatches, static_cast<size_t>(2));
+    TEST_ASSERT_EQ(stats.firstIndex, first);
+    TEST_ASSERT_EQ(stats.lastIndex, last);
+    TEST_ASSERT_ALMOST_EQ(stats.maxError, 0.25);
+
+    // Loose enough for the first and not the second
+    comparison = compareFiles(file1.pathname(), file2.pathname(),
+                              cphd::CompareTolerance(0.2));
+    TEST_ASSERT_EQ(comparison.signal[0].numMismatches,
+                   static_cast<size_t>(1));
+    TEST_ASSERT_EQ(comparison.signal[0].firstIndex, first);
+
+    comparison = compareFiles(file1.pathname(), file2.pathname(),
+                              cphd::CompareTolerance(0.25));
+    TEST_ASSERT_TRUE(comparison.matches());
+}
+
+TEST_CASE(testRelativeAndULPTolerances)
+{
+    io::TempFile file1;
+    io::TempFile file2;
+    TestFiles files;
+    files.write(file1.pathname());
+
+    std::complex<float>& value = files.getData()[100];
+    const float real = value.real();
+    const float nextReal = std::nextafter(real, 2 * real);
+    value = std::complex<float>(nextReal, value.imag());
+    files.write(file2.pathname());
+
+    TEST_ASSERT_FALSE(compareFiles(file1.pathname(),
+                                   file2.pathname()).matches());
+    TEST_ASSERT_TRUE(compareFiles(
+            file1.pathname(), file2.pathname(),
+            cphd::CompareTolerance(0.0, 0.0, 1)).matches());
+    TEST_ASSERT_TRUE(compareFiles(
+            file1.pathname(), file2.pathname(),
+            cphd::CompareTolerance(0.0, 1e-6)).matches());
+    TEST_ASSERT_FALSE(compareFiles(
+            file1.pathname(), file2.pathname(),
+            cphd::CompareTolerance(0.0, 1e-9)).matches());
+}
+
+TEST_CASE(testPVPMismatches)
+{
+    io::TempFile file1;
+    io::TempFile file2;
+    TestFiles files;
+    files.write(file1.pathname());
+
+    const size_t vector = 17;
+    const double txTime = files.getPVPBlock().getTxTime(0, vector);
+    files.getPVPBlock().setTxTime(txTime + 1e-3, 0, vector);
+    files.write(file2.pathname());
+
+    cphd::CPHDComparison comparison =
+            compareFiles(file1.pathname(), file2.pathname());
+    TEST_ASSERT_FALSE(comparison.matches());
+    TEST_ASSERT_TRUE(comparison.signal[0].matches());
+
+    const cphd::MismatchStats& stats = comparison.pvp[0].at("TxTime");
+    TEST_ASSERT_EQ(stats.numMismatches, static_cast<size_t>(1));
+    TEST_ASSERT_EQ(stats.firstIndex, vector);
+    TEST_ASSERT_EQ(stats.lastIndex, vector);
+    TEST_ASSERT_ALMOST_EQ_EPS(stats.maxError, 1e-3, 1e-9);
+    TEST_ASSERT_TRUE(comparison.pvp[0].at("RcvTime").matches());
+
+    // The signal tolerance doesn't apply to PVPs
+    comparison = compareFiles(file1.pathname(), file2.pathname(),
+                              cphd::CompareTolerance(1.0));
+    TEST_ASSERT_FALSE(comparison.matches());
+    comparison = compareFiles(file1.pathname(), file2.pathname(),
+                              cphd::CompareTolerance(),
+                              cphd::CompareTolerance(2e-3));
+    TEST_ASSERT_TRUE(comparison.matches());
+}
+}
+
+int main(int, char**)
+{
+    TEST_CHECK(testIdentical);
+    TEST_CHECK(testSignalMismatches);
+    TEST_CHECK(testRelativeAndULPTolerances);
+    TEST_CHECK(testPVPMismatches);
+    return 0;
+}
@@ -0,0 +1,111 @@
+/* =========================================================================
+ * This file is part of cphd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * cphd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <complex>
+#include <string>
+#include <vector>
+
+#include <sys/Conf.h>
+#include <types/RowCol.h>
+#include <io/TempFile.h>
+#include <cphd/CPHDMetadataReader.h>
+#include <cphd/CPHDReader.h>
+#include <cphd/CPHDWriter.h>
+#include <cphd/Metadata.h>
+#include <cphd/PVPBlock.h>
+#include <cphd/TestDataGenerator.h>
+#include <TestCase.h>
+
+namespace
+{
+void writeCPHD(const std::string& pathname)
+{
+    const types::RowCol<size_t> dims(16, 32);
+    const std::vector<std::complex<sys::Int16_T> > writeData(dims.area());
+
+    cphd::Metadata metadata;
+    cphd::setUpData(metadata, dims, writeData);
+    cphd::setPVPXML(metadata.pvp);
+    cphd::PVPBlock pvpBlock(metadata.pvp, metadata.data);
+    for (size_t ii = 0; ii < dims.row; ++ii)
+    {
+        cphd::setVectorParameters(0, ii, pvpBlock);
+    }
+
+    cphd::CPHDWriter writer(metadata, pathname);
+    writer.writeMetadata(pvpBlock);
+    writer.writePVPData(pvpBlock);
+    writer.writeCPHDData(writeData.data(), dims.area());
+}
+
+TEST_CASE(testMatchesReader)
+{
+    io::TempFile tempfile;
+    writeCPHD(tempfile.pathname());
+
+    const cphd::CPHDReader reader(tempfile.pathname(), 1);
+    const cphd::CPHDMetadataReader metadataReader(tempfile.pathname());
+
+    TEST_ASSERT_EQ(metadataReader.getFileHeader().getXMLBlockSize(),
+                   reader.getFileHeader().getXMLBlockSize());
+    TEST_ASSERT_EQ(metadataReader.getXML().size(),
+                   static_cast<size_t>(
+                           reader.getFileHeader().getXMLBlockSize()));
+    TEST_ASSERT_TRUE(*metadataReader.getMetadata() == reader.getMetadata());
+}
+
+TEST_CASE(testSelectedElements)
+{
+    io::TempFile tempfile;
+    writeCPHD(tempfile.pathname());
+
+    const cphd::CPHDMetadataReader metadataReader(tempfile.pathname());
+
+    std::vector<std::string> elementNames;
+    elementNames.push_back("Data");
+    elementNames.push_back("PVP");
+    const std::unique_ptr<xml::lite::Document> doc(
+            metadataReader.getXMLDocument(elementNames));
+
+    const std::vector<xml::lite::Element*>& children =
+            doc->getRootElement()->getChildren();
+    TEST_ASSERT_EQ(children.size(), static_cast<size_t>(2));
+    TEST_ASSERT_EQ(children[0]->getLocalName(), "Data");
+    TEST_ASSERT_EQ(children[1]->getLocalName(), "PVP");
+
+    // The kept elements are complete
+    const std::unique_ptr<xml::lite::Document> fullDoc(
+            metadataReader.getXMLDocument());
+    std::vector<xml::lite::Element*> fullData;
+    fullDoc->getRootElement()->getElementsByTagName("Data", fullData);
+    TEST_ASSERT_EQ(fullData.size(), static_cast<size_t>(1));
+    TEST_ASSERT_EQ(children[0]->getChildren().size(),
+                   fullData[0]->getChildren().size());
+}
+}
+
+int main(int, char**)
+{
+    TEST_CHECK(testMatchesReader);
+    TEST_CHECK(testSelectedElements);
+    return 0;
+}
@@ -0,0 +1,288 @@
+/* =========================================================================
+ * This file is part of cphd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * cphd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <complex>
+#include <string>
+#include <vector>
+#include <io/TempFile.h>
+#include <mem/ScopedArray.h>
+#include <types/RowCol.h>
+#include <cphd/CPHDComparator.h>
+#include <cphd/CPHDReader.h>
+#include <cphd/CPHDSubsetWriter.h>
+#include <cphd/CPHDWriter.h>
+#include <cphd/Metadata.h>
+#include <cphd/PVPBlock.h>
+#include <cphd/TestDataGenerator.h>
+#include "TestCase.h"
+
+namespace
+{
+const types::RowCol<size_t> DIMS(40, 24);
+const size_t NUM_CHANNELS = 2;
+const size_t REF_VECTOR = 10;
+
+// Small enough that everything is copied a few vectors at a time
+const size_t BLOCK_SIZE = 1000;
+
+float getSample(size_t channel, size_t vector, size_t sample)
+{
+    return channel * 100000.0f + vector * 100.0f + sample;
+}
+
+double getSC0(size_t channel, size_t vector)
+{
+    return 1000.0 * (channel + 1) + vector;
+}
+
+const double SCSS = 2.0;
+
+void writeCPHD(const std::string& pathname)
+{
+    cphd::Metadata metadata;
+    cphd::setUpMetadata(metadata);
+    cphd::setUpData(metadata, DIMS,
+                    std::vector<std::complex<float> >(1));
+    metadata.data.channels.push_back(cphd::Data::Channel(DIMS.row, DIMS.col));
+    cphd::setPVPXML(metadata.pvp);
+    metadata.global.domainType = cphd::DomainType::FX;
+
+    metadata.channel.refChId = "CH0";
+    for (size_t ii = 0; ii < NUM_CHANNELS; ++ii)
+    {
+        // The arrays are written one after another
+        cphd::Data::Channel& channel = metadata.data.channels[ii];
+        channel.identifier = "CH" + str::toString(ii);
+        channel.signalArrayByteOffset =
+                ii * DIMS.area() * sizeof(std::complex<float>);
+        channel.pvpArrayByteOffset = ii * DIMS.row * metadata.data.numBytesPVP;
+
+        cphd::ChannelParameter parameter;
+        parameter.identifier = channel.identifier;
+        parameter.refVectorIndex = REF_VECTOR;
+        parameter.fxFixed = six::BooleanType::IS_FALSE;
+        parameter.toaFixed = six::BooleanType::IS_FALSE;
+        parameter.srpFixed = six::BooleanType::IS_TRUE;
+        parameter.polarization.txPol = cphd::PolarizationType::V;
+        parameter.polarization.rcvPol = cphd::PolarizationType::V;
+        parameter.fxC = 0.0;
+        parameter.fxBW = 0.0;
+        parameter.toaSaved = 0.0;
+        parameter.dwellTimes.codId = "COD";
+        parameter.dwellTimes.dwellId = "Dwell";
+        metadata.channel.parameters.push_back(parameter);
+    }
+
+    cphd::PVPBlock pvpBlock(metadata.pvp, metadata.data);
+    std::vector<std::complex<float> > data(NUM_CHANNELS * DIMS.area());
+    for (size_t ii = 0; ii < NUM_CHANNELS; ++ii)
+    {
+        for (size_t jj = 0; jj < DIMS.row; ++jj)
+        {
+            cphd::setVectorParameters(ii, jj, pvpBlock);
+            const double sc0 = getSC0(ii, jj);
+            pvpBlock.setTxTime(ii + jj * 0.1, ii, jj);
+            pvpBlock.setSC0(sc0, ii, jj);
+            pvpBlock.setSCSS(SCSS, ii, jj);
+            pvpBlock.setFx1(sc0 + 1.0, ii, jj);
+            pvpBlock.setFx2(sc0 + (DIMS.col - 1) * SCSS - 1.0, ii, jj);
+            pvpBlock.setTOA1(-1.0 - jj, ii, jj);
+            pvpBlock.setTOA2(1.0 + jj, ii, jj);
+
+            for (size_t kk = 0; kk < DIMS.col; ++kk)
+            {
+                data[(ii * DIMS.row + jj) * DIMS.col + kk] =
+                        std::complex<float>(getSample(ii, jj, kk), -1.0f);
+            }
+        }
+    }
+
+    cphd::CPHDWriter writer(metadata, pathname);
+    writer.writeMetadata(pvpBlock);
+    writer.writePVPData(pvpBlock);
+    for (size_t ii = 0; ii < NUM_CHANNELS; ++ii)
+    {
+        writer.writeCPHDData(&data[ii * DIMS.area()], DIMS.area(), ii);
+    }
+}
+
+TEST_CASE(testWholeFile)
+{
+    io::TempFile input;
+    io::TempFile output;
+    writeCPHD(input.pathname());
+
+    const cphd::CPHDSubsetWriter writer(input.pathname(),
+                                        std::vector<std::string>(),
+                                        BLOCK_SIZE);
+    std::vector<cphd::ChannelSubset> subsets;
+    subsets.push_back(cphd::ChannelSubset(0));
+    subsets.push_back(cphd::ChannelSubset(1));
+    writer.write(subsets, output.pathname());
+
+    const cphd::CPHDReader reader1(input.pathname(), 1);
+    const cphd::CPHDReader reader2(output.pathname(), 1);
+    const cphd::CPHDComparison comparison =
+            cphd::CPHDComparator().compare(reader1, reader2);
+    TEST_ASSERT_TRUE(comparison.matches());
+}
+
+TEST_CASE(testSubset)
+{
+    io::TempFile input;
+    io::TempFile output;
+    writeCPHD(input.pathname());
+
+    const cphd::CPHDSubsetWriter writer(input.pathname(),
+                                        std::vector<std::string>(),
+                                        BLOCK_SIZE);
+    const size_t channel = 1;
+    const size_t firstVector = 5;
+    const size_t lastVector = 20;
+    const size_t firstSample = 3;
+    const size_t lastSample = 10;
+    writer.write(std::vector<cphd::ChannelSubset>(1, cphd::ChannelSubset(
+                         channel, firstVector, lastVector,
+                         firstSample, lastSample)),
+                 output.pathname());
+
+    const cphd::CPHDReader reader(output.pathname(), 1);
+    const cphd::Metadata& metadata = reader.getMetadata();
+    const size_t numVectors = lastVector - firstVector + 1;
+    const size_t numSamples = lastSample - firstSample + 1;
+    TEST_ASSERT_EQ(metadata.data.getNumChannels(), static_cast<size_t>(1));
+    TEST_ASSERT_EQ(metadata.data.getNumVectors(0), numVectors);
+    TEST_ASSERT_EQ(metadata.data.getNumSamples(0), numSamples);
+    TEST_ASSERT_EQ(metadata.data.channels[0].identifier, "CH1");
+
+    // Channel 0 was the reference channel
+    TEST_ASSERT_EQ(metadata.channel.refChId, "CH1");
+    TEST_ASSERT_EQ(metadata.channel.parameters.size(), static_cast<size_t>(1));
+    const cphd::ChannelParameter& parameter = metadata.channel.parameters[0];
+    TEST_ASSERT_EQ(parameter.identifier, "CH1");
+    TEST_ASSERT_EQ(parameter.refVectorIndex, REF_VECTOR - firstVector);
+
+    // The first sample moves, and the band is clipped to the samples kept
+    const cphd::PVPBlock& pvpBlock = reader.getPVPBlock();
+    for (size_t ii = 0; ii < numVectors; ++ii)
+    {
+        const size_t vector = firstVector + ii;
+        const double sc0 = getSC0(channel, vector) + firstSample * SCSS;
+        TEST_ASSERT_EQ(pvpBlock.getSC0(0, ii), sc0);
+        TEST_ASSERT_EQ(pvpBlock.getSCSS(0, ii), SCSS);
+        TEST_ASSERT_EQ(pvpBlock.getFx1(0, ii), sc0);
+        TEST_ASSERT_EQ(pvpBlock.getFx2(0, ii), sc0 + (numSamples - 1) * SCSS);
+        TEST_ASSERT_EQ(pvpBlock.getTxTime(0, ii), channel + vector * 0.1);
+    }
+
+    const double fxMin = getSC0(channel, firstVector) + firstSample * SCSS;
+    const double fxMax = getSC0(channel, lastVector) +
+            (lastSample) * SCSS;
+    TEST_ASSERT_EQ(parameter.fxC, (fxMin + fxMax) / 2);
+    TEST_ASSERT_EQ(parameter.fxBW, fxMax - fxMin);
+    TEST_ASSERT_EQ(parameter.toaSaved, 2.0 * (1.0 + lastVector));
+    TEST_ASSERT_EQ(metadata.global.fxBand.fxMin, fxMin);
+    TEST_ASSERT_EQ(metadata.global.fxBand.fxMax, fxMax);
+    TEST_ASSERT_EQ(metadata.global.timeline.txTime1,
+                   channel + firstVector * 0.1);
+    TEST_ASSERT_EQ(metadata.global.timeline.txTime2,
+                   channel + lastVector * 0.1);
+
+    mem::ScopedArray<sys::ubyte> buffer;
+    reader.getWideband().read(0, 0, cphd::Wideband::ALL,
+                              0, cphd::Wideband::ALL, 1, buffer);
+    const std::complex<float>* data =
+            reinterpret_cast<const std::complex<float>*>(buffer.get());
+    for (size_t ii = 0; ii < numVectors; ++ii)
+    {
+        for (size_t jj = 0; jj < numSamples; ++jj)
+        {
+            TEST_ASSERT_EQ(data[ii * numSamples + jj].real(),
+                           getSample(channel, firstVector + ii,
+                                     firstSample + jj));
+        }
+    }
+}
+
+TEST_CASE(testReorderChannels)
+{
+    io::TempFile input;
+    io::TempFile output;
+    writeCPHD(input.pathname());
+
+    const cphd::CPHDSubsetWriter writer(input.pathname());
+    std::vector<cphd::ChannelSubset> subsets;
+    subsets.push_back(cphd::ChannelSubset(1));
+    subsets.push_back(cphd::ChannelSubset(0, 0, 4));
+    writer.write(subsets, output.pathname());
+
+    const cphd::CPHDReader reader(output.pathname(), 1);
+    const cphd::Metadata& metadata = reader.getMetadata();
+    TEST_ASSERT_EQ(metadata.data.getNumChannels(), static_cast<size_t>(2));
+    TEST_ASSERT_EQ(metadata.data.channels[0].identifier, "CH1");
+    TEST_ASSERT_EQ(metadata.data.channels[1].identifier, "CH0");
+    TEST_ASSERT_EQ(metadata.data.getNumVectors(0), DIMS.row);
+    TEST_ASSERT_EQ(metadata.data.getNumVectors(1), static_cast<size_t>(5));
+    TEST_ASSERT_EQ(metadata.channel.refChId, "CH0");
+
+    // Out of range, so the nearest vector becomes the reference
+    TEST_ASSERT_EQ(metadata.channel.parameters[1].refVectorIndex,
+                   static_cast<size_t>(4));
+    TEST_ASSERT_EQ(reader.getPVPBlock().getSC0(1, 4), getSC0(0, 4));
+
+    mem::ScopedArray<sys::ubyte> buffer;
+    reader.getWideband().read(1, 4, 4, 0, cphd::Wideband::ALL, 1, buffer);
+    const std::complex<float>* data =
+            reinterpret_cast<const std::complex<float>*>(buffer.get());
+    TEST_ASSERT_EQ(data[DIMS.col - 1].real(), getSample(0, 4, DIMS.col - 1));
+}
+
+TEST_CASE(testInvalidSubsets)
+{
+    io::TempFile input;
+    io::TempFile output;
+    writeCPHD(input.pathname());
+
+    const cphd::CPHDSubsetWriter writer(input.pathname());
+    TEST_EXCEPTION(writer.getSubsetMetadata(
+            std::vector<cphd::ChannelSubset>()));
+    TEST_EXCEPTION(writer.getSubsetMetadata(
+            std::vector<cphd::ChannelSubset>(1, cphd::ChannelSubset(2))));
+    TEST_EXCEPTION(writer.getSubsetMetadata(
+            std::vector<cphd::ChannelSubset>(2, cphd::ChannelSubset(0))));
+    TEST_EXCEPTION(writer.getSubsetMetadata(
+            std::vector<cphd::ChannelSubset>(1, cphd::ChannelSubset(
+                    0, 0, DIMS.row))));
+    TEST_EXCEPTION(writer.getSubsetMetadata(
+            std::vector<cphd::ChannelSubset>(1, cphd::ChannelSubset(
+                    0, 0, cphd::ChannelSubset::ALL, 5, 4))));
+}
+}
+
+int main(int, char**)
+{
+    TEST_CHECK(testWholeFile);
+    TEST_CHECK(testSubset);
+    TEST_CHECK(testReorderChannels);
+    TEST_CHECK(testInvalidSubsets);
+    return 0;
+}
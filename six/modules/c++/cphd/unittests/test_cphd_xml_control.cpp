@@ -1139,11 +1139,39 @@ TEST_CASE(testReadXML)
     TEST_ASSERT_EQ(ref.monostatic->dopplerConeAngle, 30.0);
 }
 
+TEST_CASE(testWriteXML)
+{
+    io::StringStream cphdStream;
+    cphdStream.write(XML, strlen(XML));
+
+    xml::lite::MinidomParser xmlParser;
+    xmlParser.preserveCharacterData(true);
+    xmlParser.parse(cphdStream, cphdStream.available());
+    cphd::CPHDXMLControl xmlControl;
+    const std::unique_ptr<cphd::Metadata> metadata =
+            xmlControl.fromXML(xmlParser.getDocument());
+
+    // toXMLString() writes the XML out without building up a DOM
+    const std::unique_ptr<xml::lite::Document> doc =
+            xmlControl.toXML(*metadata);
+    io::StringStream domStream;
+    doc->getRootElement()->print(domStream);
+    TEST_ASSERT_EQ(xmlControl.toXMLString(*metadata),
+                   domStream.stream().str());
+
+    io::StringStream prettyDomStream;
+    doc->getRootElement()->prettyPrint(prettyDomStream);
+    TEST_ASSERT_EQ(xmlControl.toXMLString(*metadata,
+                                          std::vector<std::string>(), true),
+                   prettyDomStream.stream().str());
+}
+
 int main(int /*argc*/, char** /*argv*/)
 {
     try
     {
         TEST_CHECK(testReadXML);
+        TEST_CHECK(testWriteXML);
         // TEST_CHECK(testValidation);
         return 0;
     }
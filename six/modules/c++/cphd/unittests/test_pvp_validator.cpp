@@ -0,0 +1,324 @@
+/* =========================================================================
+ * This file is part of cphd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * cphd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <complex>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <io/FileInputStream.h>
+#include <io/TempFile.h>
+#include <cphd/CPHDReader.h>
+#include <cphd/CPHDWriter.h>
+#include <cphd/Metadata.h>
+#include <cphd/PVPBlock.h>
+#include <cphd/PVPValidator.h>
+#include <cphd/TestDataGenerator.h>
+#include "TestCase.h"
+
+namespace
+{
+const size_t NUM_VECTORS = 40;
+const size_t NUM_SAMPLES = 16;
+const double PRI = 0.01;
+const double FXC = 10e9;
+const double FXBW = 100e6;
+
+cphd::Vector3 makeVector(double x, double y, double z)
+{
+    cphd::Vector3 vector;
+    vector[0] = x;
+    vector[1] = y;
+    vector[2] = z;
+    return vector;
+}
+
+cphd::Metadata createMetadata()
+{
+    cphd::Metadata metadata;
+    cphd::setUpData(metadata,
+                    types::RowCol<size_t>(NUM_VECTORS, NUM_SAMPLES),
+                    std::vector<std::complex<float> >(1));
+    cphd::setPVPXML(metadata.pvp);
+    metadata.pvp.append(metadata.pvp.ampSF);
+    metadata.pvp.append(metadata.pvp.toaE1);
+    metadata.pvp.append(metadata.pvp.toaE2);
+    metadata.pvp.append(metadata.pvp.signal);
+    metadata.data.numBytesPVP =
+            metadata.pvp.getReqSetSize() * cphd::PVPType::WORD_BYTE_SIZE;
+
+    metadata.global.domainType = cphd::DomainType::FX;
+    metadata.global.timeline.txTime1 = 0;
+    metadata.global.timeline.txTime2 = (NUM_VECTORS - 1) * PRI;
+    metadata.global.fxBand.fxMin = FXC - FXBW;
+    metadata.global.fxBand.fxMax = FXC + FXBW;
+    metadata.global.toaSwath.toaMin = -2e-6;
+    metadata.global.toaSwath.toaMax = 2e-6;
+
+    metadata.channel.parameters.resize(1);
+    cphd::ChannelParameter& parameter = metadata.channel.parameters[0];
+    parameter.fxFixed = six::BooleanType::IS_TRUE;
+    parameter.toaFixed = six::BooleanType::IS_TRUE;
+    parameter.srpFixed = six::BooleanType::IS_TRUE;
+    parameter.signalNormal = six::BooleanType::IS_TRUE;
+    parameter.fxC = FXC;
+    parameter.fxBW = FXBW;
+    parameter.toaSaved = 2e-6;
+    parameter.toaExtended.reset(new cphd::TOAExtended());
+    parameter.toaExtended->toaExtSaved = 3e-6;
+    return metadata;
+}
+
+// PVPs that keep every rule
+cphd::PVPBlock createPVPBlock(const cphd::Metadata& metadata)
+{
+    cphd::PVPBlock pvpBlock(metadata.pvp, metadata.data);
+    for (size_t ii = 0; ii < NUM_VECTORS; ++ii)
+    {
+        const double txTime = ii * PRI;
+        const double rcvTime = txTime + 1e-4;
+        const cphd::Vector3 velocity = makeVector(7000.0, 100.0, 0.0);
+        const cphd::Vector3 position = makeVector(7e6, 0.0, 0.0);
+        pvpBlock.setTxTime(txTime, 0, ii);
+        pvpBlock.setTxPos(position + velocity * txTime, 0, ii);
+        pvpBlock.setTxVel(velocity, 0, ii);
+        pvpBlock.setRcvTime(rcvTime, 0, ii);
+        pvpBlock.setRcvPos(position + velocity * rcvTime, 0, ii);
+        pvpBlock.setRcvVel(velocity, 0, ii);
+        pvpBlock.setSRPPos(makeVector(6378137.0, 0.0, 0.0), 0, ii);
+        pvpBlock.setaFDOP(0.0, 0, ii);
+        pvpBlock.setaFRR1(1.0, 0, ii);
+        pvpBlock.setaFRR2(1.0, 0, ii);
+        pvpBlock.setFx1(FXC - FXBW / 2, 0, ii);
+        pvpBlock.setFx2(FXC + FXBW / 2, 0, ii);
+        pvpBlock.setTOA1(-1e-6, 0, ii);
+        pvpBlock.setTOA2(1e-6, 0, ii);
+        pvpBlock.setTOAE1(-1.5e-6, 0, ii);
+        pvpBlock.setTOAE2(1.5e-6, 0, ii);
+        pvpBlock.setTdTropoSRP(0.0, 0, ii);
+        pvpBlock.setSC0(FXC - FXBW / 2, 0, ii);
+        pvpBlock.setSCSS(FXBW / (NUM_SAMPLES - 1), 0, ii);
+        pvpBlock.setAmpSF(1.0, 0, ii);
+        pvpBlock.setSignal(1.0, 0, ii);
+    }
+    return pvpBlock;
+}
+
+bool hasRanges(const cphd::PVPValidation& validation,
+               const std::string& rule,
+               const std::vector<std::pair<size_t, size_t> >& expected)
+{
+    const std::map<std::string, cphd::VectorRanges>& channel =
+            validation.channels.at(0);
+    const auto it = channel.find(rule);
+    return it != channel.end() && it->second.ranges == expected;
+}
+
+TEST_CASE(testValid)
+{
+    const cphd::Metadata metadata = createMetadata();
+    const cphd::PVPBlock pvpBlock = createPVPBlock(metadata);
+    const cphd::PVPValidation validation =
+            cphd::PVPValidator(metadata).validate(pvpBlock);
+    std::ostringstream ostr;
+    ostr << validation;
+    TEST_ASSERT_TRUE(validation.isValid());
+    TEST_ASSERT_EQ(ostr.str(), std::string("PVPs are consistent\n"));
+}
+
+TEST_CASE(testBrokenVectors)
+{
+    const cphd::Metadata metadata = createMetadata();
+    cphd::PVPBlock pvpBlock = createPVPBlock(metadata);
+
+    // TxTime goes backwards at 10, which also puts it before RcvTime of 9
+    pvpBlock.setTxTime(0.05, 0, 10);
+    pvpBlock.setRcvTime(0.05 + 1e-4, 0, 10);
+    // FX2 out of the channel's band for 20 to 22
+    for (size_t ii = 20; ii <= 22; ++ii)
+    {
+        pvpBlock.setFx2(FXC + FXBW, 0, ii);
+    }
+    // TOA2 outside TOAE2 at 30, and a NaN at 35
+    pvpBlock.setTOA2(1.8e-6, 0, 30);
+    pvpBlock.setaFDOP(std::numeric_limits<double>::quiet_NaN(), 0, 35);
+    pvpBlock.setSignal(0.0, 0, 39);
+
+    const cphd::PVPValidation validation =
+            cphd::PVPValidator(metadata).validate(pvpBlock);
+    TEST_ASSERT_FALSE(validation.isValid());
+
+    typedef std::vector<std::pair<size_t, size_t> > Ranges;
+    TEST_ASSERT_TRUE(hasRanges(validation, "TxTimeIncreasing",
+                               Ranges(1, std::make_pair(10, 10))));
+    TEST_ASSERT_TRUE(hasRanges(validation, "RcvTimeIncreasing",
+                               Ranges(1, std::make_pair(10, 10))));
+    TEST_ASSERT_TRUE(hasRanges(validation, "ChannelFxBand",
+                               Ranges(1, std::make_pair(20, 22))));
+    TEST_ASSERT_TRUE(hasRanges(validation, "FXFixed",
+                               Ranges(1, std::make_pair(20, 22))));
+    TEST_ASSERT_TRUE(hasRanges(validation, "SampledExtent",
+                               Ranges(1, std::make_pair(20, 22))));
+    TEST_ASSERT_TRUE(hasRanges(validation, "TOAExtended",
+                               Ranges(1, std::make_pair(30, 30))));
+    TEST_ASSERT_TRUE(hasRanges(validation, "TOAFixed",
+                               Ranges(1, std::make_pair(30, 30))));
+    TEST_ASSERT_TRUE(hasRanges(validation, "FiniteValues",
+                               Ranges(1, std::make_pair(35, 35))));
+    TEST_ASSERT_TRUE(hasRanges(validation, "SignalNormal",
+                               Ranges(1, std::make_pair(39, 39))));
+    TEST_ASSERT_EQ(validation.channels[0].count("GlobalFxBand"),
+                   static_cast<size_t>(0));
+    TEST_ASSERT_EQ(validation.channels[0].count("SignalValues"),
+                   static_cast<size_t>(0));
+
+    // The extents no longer match FxC, FxBW or TOASaved
+    TEST_ASSERT_EQ(validation.errors.size(), static_cast<size_t>(2));
+}
+
+TEST_CASE(testChannelErrors)
+{
+    cphd::Metadata metadata = createMetadata();
+    const cphd::PVPBlock pvpBlock = createPVPBlock(metadata);
+    cphd::ChannelParameter& parameter = metadata.channel.parameters[0];
+    parameter.toaFixed = six::BooleanType::IS_FALSE;
+    parameter.signalNormal = six::BooleanType::IS_FALSE;
+    parameter.toaExtended->toaExtSaved = 4e-6;
+
+    const cphd::PVPValidation validation =
+            cphd::PVPValidator(metadata).validate(pvpBlock);
+    TEST_ASSERT_EQ(validation.errors.size(), static_cast<size_t>(3));
+    TEST_ASSERT_TRUE(validation.channels[0].empty());
+
+    parameter.signalNormal = six::BooleanType::NOT_SET;
+    const cphd::PVPValidation missing =
+            cphd::PVPValidator(metadata).validate(pvpBlock);
+    TEST_ASSERT_EQ(missing.errors.size(), static_cast<size_t>(3));
+    TEST_ASSERT_NOT_EQ(missing.errors[0].find("SignalNormal is missing"),
+                       std::string::npos);
+}
+
+TEST_CASE(testBlocksAndThreads)
+{
+    const cphd::Metadata metadata = createMetadata();
+    cphd::PVPBlock pvpBlock = createPVPBlock(metadata);
+    for (size_t ii = 0; ii < NUM_VECTORS; ii += 3)
+    {
+        pvpBlock.setAmpSF(-1.0, 0, ii);
+    }
+    pvpBlock.setTxTime(0.0, 0, 7);
+
+    const cphd::PVPValidation expected =
+            cphd::PVPValidator(metadata).validate(pvpBlock);
+    TEST_ASSERT_EQ(expected.channels[0].at("AmpSF").numVectors,
+                   static_cast<size_t>(14));
+
+    // Block boundaries and thread boundaries everywhere
+    const size_t setSize = metadata.data.getNumBytesPVPSet();
+    for (size_t threads : {1, 2, 3, 8})
+    {
+        for (size_t vectors : {1, 4, 7, 100})
+        {
+            const cphd::PVPValidation validation =
+                    cphd::PVPValidator(metadata, threads, vectors * setSize)
+                            .validate(pvpBlock);
+            TEST_ASSERT_EQ(validation.channels[0].size(),
+                           expected.channels[0].size());
+            for (auto it = expected.channels[0].begin();
+                 it != expected.channels[0].end();
+                 ++it)
+            {
+                const cphd::VectorRanges& ranges =
+                        validation.channels[0].at(it->first);
+                TEST_ASSERT_EQ(ranges.numVectors, it->second.numVectors);
+                TEST_ASSERT_TRUE(ranges.ranges == it->second.ranges);
+            }
+            TEST_ASSERT_TRUE(validation.errors == expected.errors);
+        }
+    }
+}
+
+TEST_CASE(testTruncatedRanges)
+{
+    cphd::VectorRanges ranges;
+    for (size_t ii = 0; ii < 2 * cphd::VectorRanges::MAX_RANGES + 2; ii += 2)
+    {
+        ranges.add(ii);
+    }
+    TEST_ASSERT_TRUE(ranges.truncated);
+    TEST_ASSERT_EQ(ranges.ranges.size(), cphd::VectorRanges::MAX_RANGES);
+    TEST_ASSERT_EQ(ranges.numVectors, cphd::VectorRanges::MAX_RANGES + 1);
+
+    // Appending joins runs that meet
+    cphd::VectorRanges first;
+    cphd::VectorRanges second;
+    first.add(3);
+    first.add(4);
+    second.add(5);
+    second.add(9);
+    first.append(second);
+    TEST_ASSERT_EQ(first.ranges.size(), static_cast<size_t>(2));
+    TEST_ASSERT_EQ(first.ranges[0].second, static_cast<size_t>(5));
+    TEST_ASSERT_EQ(first.numVectors, static_cast<size_t>(4));
+}
+
+TEST_CASE(testStreaming)
+{
+    const cphd::Metadata metadata = createMetadata();
+    cphd::PVPBlock pvpBlock = createPVPBlock(metadata);
+    pvpBlock.setSCSS(0.0, 0, 12);
+    const std::vector<std::complex<float> > signal(NUM_VECTORS * NUM_SAMPLES);
+
+    io::TempFile tempfile;
+    cphd::CPHDWriter writer(metadata, tempfile.pathname());
+    writer.write(pvpBlock, &signal[0]);
+    writer.close();
+
+    const cphd::CPHDReader reader(tempfile.pathname(), 1);
+    io::FileInputStream inStream(tempfile.pathname());
+    const cphd::PVPValidation validation =
+            cphd::PVPValidator(reader.getMetadata(), 2,
+                               5 * metadata.data.getNumBytesPVPSet())
+                    .validate(inStream,
+                              reader.getFileHeader().getPvpBlockByteOffset());
+    const cphd::PVPValidation inMemory =
+            cphd::PVPValidator(metadata).validate(pvpBlock);
+
+    TEST_ASSERT_TRUE(hasRanges(validation, "SampleSpacing",
+                               std::vector<std::pair<size_t, size_t> >(
+                                       1, std::make_pair(12, 12))));
+    TEST_ASSERT_EQ(validation.channels[0].size(),
+                   inMemory.channels[0].size());
+    TEST_ASSERT_TRUE(validation.errors.empty());
+}
+}
+
+int main(int, char**)
+{
+    TEST_CHECK(testValid);
+    TEST_CHECK(testBrokenVectors);
+    TEST_CHECK(testChannelErrors);
+    TEST_CHECK(testBlocksAndThreads);
+    TEST_CHECK(testTruncatedRanges);
+    TEST_CHECK(testStreaming);
+    return 0;
+}
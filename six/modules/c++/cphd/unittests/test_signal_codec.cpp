@@ -0,0 +1,295 @@
+/* =========================================================================
+ * This file is part of cphd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * cphd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cmath>
+#include <complex>
+#include <cstring>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <io/TempFile.h>
+#include <sys/Conf.h>
+#include <types/RowCol.h>
+#include <cphd/CPHDReader.h>
+#include <cphd/CPHDWriter.h>
+#include <cphd/Metadata.h>
+#include <cphd/PVPBlock.h>
+#include <cphd/SignalCodec.h>
+#include <cphd/TestDataGenerator.h>
+#include <cphd/Wideband.h>
+#include "TestCase.h"
+
+namespace
+{
+// A slowly varying signal, so there's something to compress
+std::vector<std::complex<sys::Int16_T> >
+generateSignal(const types::RowCol<size_t>& dims)
+{
+    std::vector<std::complex<sys::Int16_T> > signal(dims.area());
+    srand(0);
+    for (size_t ii = 0; ii < signal.size(); ++ii)
+    {
+        const double phase = 0.01 * ii;
+        signal[ii] = std::complex<sys::Int16_T>(
+                static_cast<sys::Int16_T>(1000 * std::cos(phase) +
+                                          rand() % 4),
+                static_cast<sys::Int16_T>(1000 * std::sin(phase)));
+    }
+    return signal;
+}
+
+bool roundTrips(const cphd::SignalCodec& codec,
+                const std::vector<sys::ubyte>& input,
+                size_t typeSize)
+{
+    std::vector<sys::ubyte> compressed;
+    codec.compress(input.empty() ? nullptr : &input[0], input.size(),
+                   typeSize, compressed);
+    std::vector<sys::ubyte> output(input.size() + 1, 0xAB);
+    codec.decompress(&compressed[0], compressed.size(), typeSize,
+                     &output[0], input.size());
+    output.pop_back();
+    return output == input;
+}
+
+// Stores blocks as they are
+class CopyCodec : public cphd::SignalCodec
+{
+public:
+    void compress(const sys::ubyte* input,
+                  size_t numBytes,
+                  size_t ,
+                  std::vector<sys::ubyte>& output) const override
+    {
+        output.assign(input, input + numBytes);
+    }
+
+    void decompress(const sys::ubyte* input,
+                    size_t inputSize,
+                    size_t ,
+                    sys::ubyte* output,
+                    size_t outputSize) const override
+    {
+        std::memcpy(output, input, std::min(inputSize, outputSize));
+    }
+};
+
+void writeCompressedCPHD(const std::string& pathname,
+                         const std::string& compressionID,
+                         const types::RowCol<size_t>& dims,
+                         const std::vector<std::complex<sys::Int16_T> >& signal,
+                         size_t vectorsPerBlock)
+{
+    cphd::Metadata metadata;
+    cphd::setUpData(metadata, dims, signal);
+    cphd::setPVPXML(metadata.pvp);
+    metadata.data.signalCompressionID = compressionID;
+    cphd::PVPBlock pvpBlock(metadata.pvp, metadata.data);
+    for (size_t ii = 0; ii < dims.row; ++ii)
+    {
+        cphd::setVectorParameters(0, ii, pvpBlock);
+    }
+
+    cphd::CPHDWriter writer(metadata, pathname, std::vector<std::string>(), 3);
+    writer.writeCompressed(pvpBlock, &signal[0], nullptr, vectorsPerBlock);
+    writer.close();
+}
+
+TEST_CASE(testShuffleLZRoundTrip)
+{
+    const cphd::ShuffleLZCodec codec;
+    for (size_t size : {0, 1, 3, 4, 5, 17, 1000, 70001})
+    {
+        std::vector<sys::ubyte> random(size);
+        std::vector<sys::ubyte> runs(size);
+        srand(static_cast<unsigned int>(size));
+        for (size_t ii = 0; ii < size; ++ii)
+        {
+            random[ii] = static_cast<sys::ubyte>(rand());
+            runs[ii] = static_cast<sys::ubyte>(ii / 300);
+        }
+        for (size_t typeSize : {1, 2, 4})
+        {
+            TEST_ASSERT_TRUE(roundTrips(codec, random, typeSize));
+            TEST_ASSERT_TRUE(roundTrips(codec, runs, typeSize));
+        }
+    }
+
+    // Smooth samples shrink, noise doesn't grow by more than the mode byte
+    const std::vector<std::complex<sys::Int16_T> > signal =
+            generateSignal(types::RowCol<size_t>(64, 64));
+    const sys::ubyte* const bytes =
+            reinterpret_cast<const sys::ubyte*>(&signal[0]);
+    const std::vector<sys::ubyte> smooth(bytes, bytes + signal.size() * 4);
+    std::vector<sys::ubyte> compressed;
+    codec.compress(&smooth[0], smooth.size(), 2, compressed);
+    TEST_ASSERT_LESSER(compressed.size(), smooth.size() * 3 / 4);
+    TEST_ASSERT_TRUE(roundTrips(codec, smooth, 2));
+
+    std::vector<sys::ubyte> noise(5000);
+    for (size_t ii = 0; ii < noise.size(); ++ii)
+    {
+        noise[ii] = static_cast<sys::ubyte>(rand());
+    }
+    codec.compress(&noise[0], noise.size(), 4, compressed);
+    TEST_ASSERT_LESSER_EQ(compressed.size(), noise.size() + 1);
+}
+
+TEST_CASE(testShuffleLZCorrupt)
+{
+    const cphd::ShuffleLZCodec codec;
+    std::vector<sys::ubyte> input(4000);
+    for (size_t ii = 0; ii < input.size(); ++ii)
+    {
+        input[ii] = static_cast<sys::ubyte>(ii % 7);
+    }
+    std::vector<sys::ubyte> compressed;
+    codec.compress(&input[0], input.size(), 2, compressed);
+    std::vector<sys::ubyte> output(input.size());
+
+    // Truncated, wrong size, unknown mode
+    TEST_EXCEPTION(codec.decompress(&compressed[0], compressed.size() - 1, 2,
+                                    &output[0], output.size()));
+    TEST_EXCEPTION(codec.decompress(&compressed[0], compressed.size(), 2,
+                                    &output[0], output.size() - 1));
+    compressed[0] = 7;
+    TEST_EXCEPTION(codec.decompress(&compressed[0], compressed.size(), 2,
+                                    &output[0], output.size()));
+    TEST_EXCEPTION(codec.decompress(&compressed[0], 0, 2,
+                                    &output[0], output.size()));
+}
+
+TEST_CASE(testRegistry)
+{
+    cphd::SignalCodecRegistry& registry =
+            cphd::SignalCodecFactory::getInstance();
+    TEST_ASSERT_TRUE(registry.getCodec(cphd::ShuffleLZCodec::IDENTIFIER) !=
+                     nullptr);
+    TEST_ASSERT_TRUE(registry.getCodec("Huffman") == nullptr);
+
+    registry.addCodec("COPY", std::unique_ptr<cphd::SignalCodec>(
+            new CopyCodec()));
+    const cphd::SignalCodec* const codec = registry.getCodec("COPY");
+    TEST_ASSERT_TRUE(dynamic_cast<const CopyCodec*>(codec) != nullptr);
+
+    // Partial reads work with any registered codec
+    const types::RowCol<size_t> dims(20, 8);
+    const std::vector<std::complex<sys::Int16_T> > signal =
+            generateSignal(dims);
+    io::TempFile tempfile;
+    writeCompressedCPHD(tempfile.pathname(), "COPY", dims, signal, 3);
+    cphd::CPHDReader reader(tempfile.pathname(), 2);
+    std::vector<std::complex<sys::Int16_T> > readData(4 * 3);
+    reader.getWideband().read(0, 7, 10, 2, 4, 2,
+                              types::RowCol<size_t>(4, 3), &readData[0]);
+    for (size_t ii = 0; ii < 4; ++ii)
+    {
+        for (size_t jj = 0; jj < 3; ++jj)
+        {
+            TEST_ASSERT_EQ(readData[ii * 3 + jj],
+                           signal[(ii + 7) * dims.col + jj + 2]);
+        }
+    }
+}
+
+TEST_CASE(testCompressedCPHD)
+{
+    const types::RowCol<size_t> dims(100, 37);
+    const std::vector<std::complex<sys::Int16_T> > signal =
+            generateSignal(dims);
+    io::TempFile tempfile;
+    writeCompressedCPHD(tempfile.pathname(), cphd::ShuffleLZCodec::IDENTIFIER,
+                        dims, signal, 16);
+
+    cphd::CPHDReader reader(tempfile.pathname(), 4);
+    const cphd::Metadata& metadata = reader.getMetadata();
+    TEST_ASSERT_TRUE(metadata.data.isCompressed());
+    TEST_ASSERT_LESSER(metadata.data.getCompressedSignalSize(0),
+                       dims.area() * 4);
+    const cphd::Wideband& wideband = reader.getWideband();
+
+    // Whole channel
+    mem::ScopedArray<sys::ubyte> data;
+    wideband.read(0, 0, cphd::Wideband::ALL, 0, cphd::Wideband::ALL, 4, data);
+    TEST_ASSERT_EQ(std::memcmp(data.get(), &signal[0], dims.area() * 4), 0);
+
+    // Vectors straddling blocks, and some of the samples
+    const size_t firstVector = 10;
+    const size_t lastVector = 50;
+    const size_t firstSample = 5;
+    const size_t lastSample = 20;
+    const types::RowCol<size_t> readDims =
+            wideband.getBufferDims(0, firstVector, lastVector,
+                                   firstSample, lastSample);
+    TEST_ASSERT_EQ(readDims.row, lastVector - firstVector + 1);
+    TEST_ASSERT_EQ(readDims.col, lastSample - firstSample + 1);
+    wideband.read(0, firstVector, lastVector, firstSample, lastSample, 3,
+                  data);
+    const std::complex<sys::Int16_T>* const partial =
+            reinterpret_cast<const std::complex<sys::Int16_T>*>(data.get());
+    for (size_t ii = 0; ii < readDims.row; ++ii)
+    {
+        for (size_t jj = 0; jj < readDims.col; ++jj)
+        {
+            TEST_ASSERT_EQ(partial[ii * readDims.col + jj],
+                           signal[(ii + firstVector) * dims.col +
+                                  jj + firstSample]);
+        }
+    }
+
+    // Scaled and promoted
+    const std::vector<double> scaleFactors(readDims.row, 2.0);
+    std::vector<std::complex<float> > scaled(readDims.area());
+    std::vector<sys::ubyte> scratch(readDims.area() * 4);
+    wideband.read(0, firstVector, lastVector, firstSample, lastSample,
+                  scaleFactors, 2,
+                  mem::BufferView<sys::ubyte>(&scratch[0], scratch.size()),
+                  mem::BufferView<std::complex<float> >(&scaled[0],
+                                                        scaled.size()));
+    TEST_ASSERT_EQ(scaled[0],
+                   std::complex<float>(partial[0].real() * 2,
+                                       partial[0].imag() * 2));
+    TEST_ASSERT_EQ(scaled.back(),
+                   std::complex<float>(partial[readDims.area() - 1].real() * 2,
+                                       partial[readDims.area() - 1].imag() * 2));
+}
+
+TEST_CASE(testUnregisteredCodec)
+{
+    const types::RowCol<size_t> dims(4, 4);
+    const std::vector<std::complex<sys::Int16_T> > signal =
+            generateSignal(dims);
+    io::TempFile tempfile;
+    TEST_EXCEPTION(writeCompressedCPHD(tempfile.pathname(), "Huffman", dims,
+                                       signal, 2));
+}
+}
+
+int main(int, char**)
+{
+    TEST_CHECK(testShuffleLZRoundTrip);
+    TEST_CHECK(testShuffleLZCorrupt);
+    TEST_CHECK(testRegistry);
+    TEST_CHECK(testCompressedCPHD);
+    TEST_CHECK(testUnregisteredCodec);
+    return 0;
+}
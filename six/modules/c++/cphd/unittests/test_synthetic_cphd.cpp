@@ -0,0 +1,84 @@
+/* =========================================================================
+ * This file is part of cphd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * cphd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <complex>
+#include <cstring>
+#include <vector>
+#include <io/TempFile.h>
+#include <mem/ScopedArray.h>
+#include <cphd/CPHDReader.h>
+#include <cphd/Metadata.h>
+#include <cphd/PVPBlock.h>
+#include <cphd/TestDataGenerator.h>
+#include "TestCase.h"
+
+namespace
+{
+TEST_CASE(testRoundTrip)
+{
+    const types::RowCol<size_t> dims(30, 17);
+    cphd::Metadata metadata;
+    cphd::setUpSyntheticMetadata(2, dims, cphd::SignalArrayFormat::CI4, 3, 2,
+                                 types::RowCol<size_t>(5, 6), metadata);
+    TEST_ASSERT_EQ(metadata.data.getNumBytesPVPSet(),
+                   static_cast<size_t>((12 + 3 * 5 + 3) * 8));
+    TEST_ASSERT_EQ(metadata.data.getAllSupportSize(),
+                   static_cast<size_t>(2 * 5 * 6 * 4));
+
+    cphd::PVPBlock pvpBlock(metadata.pvp, metadata.data);
+    cphd::setSyntheticVectorParameters(metadata, pvpBlock);
+
+    // Small chunks, so each channel takes several writes
+    io::TempFile tempfile;
+    cphd::writeSyntheticCPHD(metadata, pvpBlock, tempfile.pathname(), 2,
+                             7 * dims.col * 4);
+
+    const cphd::CPHDReader reader(tempfile.pathname(), 2);
+    TEST_ASSERT_EQ(reader.getMetadata().data.getNumChannels(),
+                   static_cast<size_t>(2));
+    TEST_ASSERT_TRUE(reader.getPVPBlock() == pvpBlock);
+    TEST_ASSERT_EQ(reader.getPVPBlock().getAddedPVP<double>(1, 29,
+                                                                 "Added2"),
+                   pvpBlock.getAddedPVP<double>(1, 29, "Added2"));
+
+    mem::ScopedArray<sys::ubyte> support;
+    reader.getSupportBlock().readAll(1, support);
+
+    // Every channel repeats the same random chunk
+    mem::ScopedArray<sys::ubyte> first;
+    mem::ScopedArray<sys::ubyte> second;
+    reader.getWideband().read(0, 0, cphd::Wideband::ALL, 0,
+                              cphd::Wideband::ALL, 1, first);
+    reader.getWideband().read(1, 0, cphd::Wideband::ALL, 0,
+                              cphd::Wideband::ALL, 1, second);
+    TEST_ASSERT_EQ(std::memcmp(first.get(), second.get(), dims.area() * 4),
+                   0);
+    TEST_ASSERT_EQ(std::memcmp(first.get(), first.get() + 7 * dims.col * 4,
+                               7 * dims.col * 4), 0);
+}
+}
+
+int main(int, char**)
+{
+    TEST_CHECK(testRoundTrip);
+    return 0;
+}
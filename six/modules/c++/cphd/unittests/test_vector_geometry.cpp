@@ -0,0 +1,369 @@
+/* =========================================================================
+ * This file is part of cphd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * cphd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cmath>
+#include <complex>
+#include <string>
+#include <vector>
+#include <scene/Utilities.h>
+#include <six/sicd/GeoData.h>
+#include <six/sicd/Grid.h>
+#include <six/sicd/Position.h>
+#include <six/sicd/SCPCOA.h>
+#include <cphd/Metadata.h>
+#include <cphd/PVPBlock.h>
+#include <cphd/TestDataGenerator.h>
+#include <cphd/VectorGeometry.h>
+#include "TestCase.h"
+
+namespace
+{
+const size_t NUM_VECTORS = 21;
+const size_t NUM_SAMPLES = 4;
+const double PRI = 0.05;
+
+cphd::Vector3 makeVector(double x, double y, double z)
+{
+    cphd::Vector3 vector;
+    vector[0] = x;
+    vector[1] = y;
+    vector[2] = z;
+    return vector;
+}
+
+cphd::Vector3 getSRP()
+{
+    return scene::Utilities::latLonToECEF(scene::LatLonAlt(40.0, -100.0, 300.0));
+}
+
+cphd::Vector3 getVelocity()
+{
+    return makeVector(-2000.0, 6500.0, 3000.0);
+}
+
+cphd::Vector3 getPosition(double time)
+{
+    return getSRP() * 1.08 + makeVector(50000.0, 10000.0, -40000.0) +
+            getVelocity() * time;
+}
+
+cphd::Metadata createMetadata()
+{
+    cphd::Metadata metadata;
+    cphd::setUpData(metadata,
+                    types::RowCol<size_t>(NUM_VECTORS, NUM_SAMPLES),
+                    std::vector<std::complex<float> >());
+    cphd::setPVPXML(metadata.pvp);
+    metadata.collectionID.collectType = cphd::CollectType::MONOSTATIC;
+
+    metadata.sceneCoordinates.iarp.ecf =
+            getSRP() + makeVector(10.0, -20.0, 5.0);
+    metadata.sceneCoordinates.referenceSurface.planar.reset(
+            new cphd::Planar());
+    metadata.sceneCoordinates.referenceSurface.planar->uIax =
+            makeVector(0.0, 1.0, 0.0);
+    metadata.sceneCoordinates.referenceSurface.planar->uIay =
+            makeVector(0.0, 0.0, 1.0);
+
+    cphd::COD cod;
+    cod.identifier = "COD";
+    cod.codTimePoly = cphd::Poly2D(1, 1);
+    cod.codTimePoly[0][0] = 0.5;
+    cod.codTimePoly[1][0] = 0.01;
+    cod.codTimePoly[0][1] = -0.02;
+    metadata.dwell.cod.push_back(cod);
+    cphd::DwellTime dwell;
+    dwell.identifier = "Dwell";
+    dwell.dwellTimePoly = cphd::Poly2D(0, 0);
+    dwell.dwellTimePoly[0][0] = 1.0;
+    metadata.dwell.dtime.push_back(dwell);
+
+    metadata.channel.parameters.resize(1);
+    metadata.channel.parameters[0].dwellTimes.codId = "COD";
+    metadata.channel.parameters[0].dwellTimes.dwellId = "Dwell";
+    return metadata;
+}
+
+// A monostatic collect, with the receive APC a little further along
+cphd::PVPBlock createPVPBlock(const cphd::Metadata& metadata,
+                              double rcvDelay = 1e-4)
+{
+    cphd::PVPBlock pvpBlock(metadata.pvp, metadata.data);
+    for (size_t ii = 0; ii < NUM_VECTORS; ++ii)
+    {
+        const double txTime = ii * PRI;
+        const double rcvTime = txTime + rcvDelay;
+        pvpBlock.setTxTime(txTime, 0, ii);
+        pvpBlock.setTxPos(getPosition(txTime), 0, ii);
+        pvpBlock.setTxVel(getVelocity(), 0, ii);
+        pvpBlock.setRcvTime(rcvTime, 0, ii);
+        pvpBlock.setRcvPos(getPosition(rcvTime), 0, ii);
+        pvpBlock.setRcvVel(getVelocity(), 0, ii);
+        pvpBlock.setSRPPos(getSRP(), 0, ii);
+    }
+    return pvpBlock;
+}
+
+six::sicd::SCPCOA getSCPCOA(const cphd::Vector3& arpPos,
+                            const cphd::Vector3& arpVel,
+                            const cphd::Vector3& target)
+{
+    six::sicd::GeoData geoData;
+    geoData.scp.ecf = target;
+    six::sicd::SCPCOA scpcoa;
+    scpcoa.scpTime = 0.0;
+    scpcoa.arpPos = arpPos;
+    scpcoa.arpVel = arpVel;
+    scpcoa.arpAcc = makeVector(0.0, 0.0, 0.0);
+    scpcoa.fillDerivedFields(geoData, six::sicd::Grid(),
+                             six::sicd::Position());
+    return scpcoa;
+}
+
+void checkMatches(const std::string& testName,
+                  const cphd::VectorGeometry& geometry,
+                  size_t index,
+                  const six::sicd::SCPCOA& scpcoa)
+{
+    TEST_ASSERT_EQ(geometry.sideOfTrack[index], scpcoa.sideOfTrack);
+    TEST_ASSERT_ALMOST_EQ_EPS(geometry.slantRange[index],
+                              scpcoa.slantRange, 1e-6);
+    TEST_ASSERT_ALMOST_EQ_EPS(geometry.groundRange[index],
+                              scpcoa.groundRange, 1e-3);
+    TEST_ASSERT_ALMOST_EQ_EPS(geometry.dopplerConeAngle[index],
+                              scpcoa.dopplerConeAngle, 1e-9);
+    TEST_ASSERT_ALMOST_EQ_EPS(geometry.grazeAngle[index],
+                              scpcoa.grazeAngle, 1e-9);
+    TEST_ASSERT_ALMOST_EQ_EPS(geometry.incidenceAngle[index],
+                              scpcoa.incidenceAngle, 1e-9);
+    TEST_ASSERT_ALMOST_EQ_EPS(geometry.azimuthAngle[index],
+                              scpcoa.azimAngle, 1e-9);
+    TEST_ASSERT_ALMOST_EQ_EPS(geometry.twistAngle[index],
+                              scpcoa.twistAngle, 1e-9);
+    TEST_ASSERT_ALMOST_EQ_EPS(geometry.slopeAngle[index],
+                              scpcoa.slopeAngle, 1e-9);
+    TEST_ASSERT_ALMOST_EQ_EPS(geometry.layoverAngle[index],
+                              scpcoa.layoverAngle, 1e-9);
+}
+
+TEST_CASE(testMatchesSCPCOA)
+{
+    const cphd::Metadata metadata = createMetadata();
+    const cphd::PVPBlock pvpBlock = createPVPBlock(metadata);
+    const cphd::VectorGeometryCalculator calculator(metadata, pvpBlock, 3);
+
+    cphd::VectorGeometry geometry;
+    calculator.getChannelGeometry(0, geometry);
+    TEST_ASSERT_EQ(geometry.size(), NUM_VECTORS);
+    for (size_t ii = 0; ii < NUM_VECTORS; ++ii)
+    {
+        const double time = ii * PRI + 5e-5;
+        TEST_ASSERT_ALMOST_EQ(geometry.time[ii], time);
+        TEST_ASSERT_EQ(geometry.targetPos[ii], getSRP());
+        for (size_t jj = 0; jj < 3; ++jj)
+        {
+            TEST_ASSERT_ALMOST_EQ_EPS(geometry.arpPos[ii][jj],
+                                      getPosition(time)[jj], 1e-6);
+        }
+        TEST_ASSERT_ALMOST_EQ(
+                geometry.uLOS[ii].dot((getSRP() - geometry.arpPos[ii]).unit()),
+                1.0);
+        // The receive APC has moved on a little
+        TEST_ASSERT_ALMOST_EQ_EPS(geometry.bistaticAngle[ii], 0.0, 1e-3);
+        checkMatches(testName, geometry, ii,
+                     getSCPCOA(geometry.arpPos[ii], getVelocity(), getSRP()));
+    }
+
+    // A span matches the same vectors of the whole channel
+    cphd::VectorGeometry span;
+    calculator.getGeometry(0, 5, 4, span);
+    TEST_ASSERT_EQ(span.size(), static_cast<size_t>(4));
+    TEST_ASSERT_EQ(span.azimuthAngle[2], geometry.azimuthAngle[7]);
+    TEST_ASSERT_EQ(span.layoverAngle[3], geometry.layoverAngle[8]);
+
+    TEST_EXCEPTION(calculator.getGeometry(0, 20, 2, span));
+    TEST_EXCEPTION(calculator.getChannelGeometry(1, span));
+}
+
+TEST_CASE(testScenePoints)
+{
+    const cphd::Metadata metadata = createMetadata();
+    const cphd::PVPBlock pvpBlock = createPVPBlock(metadata);
+    const cphd::VectorGeometryCalculator calculator(metadata, pvpBlock);
+
+    const cphd::Vector3 points[] =
+    {
+        getSRP(),
+        scene::Utilities::latLonToECEF(scene::LatLonAlt(40.01, -100.02, 0.0)),
+        scene::Utilities::latLonToECEF(scene::LatLonAlt(39.98, -99.99, 900.0))
+    };
+    const size_t numPoints = 3;
+    const size_t firstVector = 3;
+    const size_t numVectors = 6;
+    cphd::VectorGeometry geometry;
+    calculator.getGeometry(0, firstVector, numVectors, points, numPoints,
+                           geometry);
+    TEST_ASSERT_EQ(geometry.size(), numVectors * numPoints);
+
+    cphd::VectorGeometry srpGeometry;
+    calculator.getGeometry(0, firstVector, numVectors, srpGeometry);
+    for (size_t ii = 0; ii < numVectors; ++ii)
+    {
+        // The first point is the SRP
+        TEST_ASSERT_EQ(geometry.grazeAngle[ii * numPoints],
+                       srpGeometry.grazeAngle[ii]);
+        TEST_ASSERT_EQ(geometry.twistAngle[ii * numPoints],
+                       srpGeometry.twistAngle[ii]);
+        for (size_t jj = 0; jj < numPoints; ++jj)
+        {
+            const size_t index = ii * numPoints + jj;
+            TEST_ASSERT_EQ(geometry.time[index], srpGeometry.time[ii]);
+            TEST_ASSERT_EQ(geometry.targetPos[index], points[jj]);
+            checkMatches(testName, geometry, index,
+                         getSCPCOA(geometry.arpPos[index], getVelocity(),
+                                   points[jj]));
+        }
+    }
+
+    // Threads don't change anything
+    const cphd::VectorGeometryCalculator threaded(metadata, pvpBlock, 4);
+    cphd::VectorGeometry threadedGeometry;
+    threaded.getGeometry(0, firstVector, numVectors, points, numPoints,
+                         threadedGeometry);
+    TEST_ASSERT(threadedGeometry.azimuthAngle == geometry.azimuthAngle);
+    TEST_ASSERT(threadedGeometry.slopeAngle == geometry.slopeAngle);
+}
+
+TEST_CASE(testMonostaticReference)
+{
+    const cphd::Metadata metadata = createMetadata();
+    const cphd::PVPBlock pvpBlock = createPVPBlock(metadata);
+    const cphd::VectorGeometryCalculator calculator(metadata, pvpBlock);
+
+    // The middle of vectors 4 - 12 is 8
+    const cphd::ReferenceGeometry geometry =
+            calculator.getReferenceGeometry(0, 4, 9);
+    cphd::VectorGeometry vectors;
+    calculator.getChannelGeometry(0, vectors);
+
+    TEST_ASSERT_EQ(geometry.referenceTime, vectors.time[8]);
+    TEST_ASSERT_EQ(geometry.srp.ecf, getSRP());
+    TEST_ASSERT_ALMOST_EQ(geometry.srp.iac[0], 20.0);
+    TEST_ASSERT_ALMOST_EQ(geometry.srp.iac[1], -5.0);
+    TEST_ASSERT_ALMOST_EQ(geometry.srp.iac[2], -10.0);
+    TEST_ASSERT_ALMOST_EQ(geometry.srpCODTime, 0.5 + 0.2 + 0.1);
+    TEST_ASSERT_EQ(geometry.srpDwellTime, 1.0);
+    TEST_ASSERT_TRUE(geometry.bistatic.get() == nullptr);
+    TEST_ASSERT_TRUE(geometry.monostatic.get() != nullptr);
+
+    const cphd::Monostatic& monostatic = *geometry.monostatic;
+    TEST_ASSERT_EQ(monostatic.arpPos, vectors.arpPos[8]);
+    TEST_ASSERT_EQ(monostatic.sideOfTrack, vectors.sideOfTrack[8]);
+    TEST_ASSERT_EQ(monostatic.slantRange, vectors.slantRange[8]);
+    TEST_ASSERT_EQ(monostatic.grazeAngle, vectors.grazeAngle[8]);
+    TEST_ASSERT_EQ(monostatic.layoverAngle, vectors.layoverAngle[8]);
+
+    TEST_EXCEPTION(calculator.getReferenceGeometry(0, 4, 0));
+
+    cphd::Metadata hae = createMetadata();
+    hae.sceneCoordinates.referenceSurface.planar.reset();
+    hae.sceneCoordinates.referenceSurface.hae.reset(new cphd::HAE());
+    const cphd::VectorGeometryCalculator haeCalculator(hae, pvpBlock);
+    TEST_EXCEPTION(haeCalculator.getReferenceGeometry(0, 0, NUM_VECTORS));
+}
+
+TEST_CASE(testBistaticReference)
+{
+    cphd::Metadata metadata = createMetadata();
+    metadata.collectionID.collectType = cphd::CollectType::BISTATIC;
+
+    // With both APCs in the same place it's the monostatic geometry
+    const cphd::PVPBlock colocated = createPVPBlock(metadata, 0.0);
+    const cphd::VectorGeometryCalculator calculator(metadata, colocated);
+    const cphd::ReferenceGeometry geometry =
+            calculator.getReferenceGeometry(0, 0, NUM_VECTORS);
+    TEST_ASSERT_TRUE(geometry.monostatic.get() == nullptr);
+    TEST_ASSERT_TRUE(geometry.bistatic.get() != nullptr);
+    const cphd::Bistatic& bistatic = *geometry.bistatic;
+
+    cphd::VectorGeometry vectors;
+    calculator.getGeometry(0, NUM_VECTORS / 2, 1, vectors);
+    TEST_ASSERT_EQ(bistatic.bistaticAngle, 0.0);
+    TEST_ASSERT_ALMOST_EQ_EPS(bistatic.azimuthAngle,
+                              vectors.azimuthAngle[0], 1e-9);
+    TEST_ASSERT_ALMOST_EQ_EPS(bistatic.grazeAngle,
+                              vectors.grazeAngle[0], 1e-9);
+    TEST_ASSERT_ALMOST_EQ_EPS(bistatic.twistAngle,
+                              vectors.twistAngle[0], 1e-9);
+    TEST_ASSERT_ALMOST_EQ_EPS(bistatic.slopeAngle,
+                              vectors.slopeAngle[0], 1e-9);
+    TEST_ASSERT_ALMOST_EQ_EPS(bistatic.layoverAngle,
+                              vectors.layoverAngle[0], 1e-9);
+    TEST_ASSERT_EQ(bistatic.txPlatform.slantRange, vectors.slantRange[0]);
+    TEST_ASSERT_EQ(bistatic.rcvPlatform.sideOfTrack,
+                   vectors.sideOfTrack[0]);
+    TEST_ASSERT_EQ(bistatic.txPlatform.time, NUM_VECTORS / 2 * PRI);
+
+    // The azimuth rate matches a finite difference
+    const cphd::ReferenceGeometry next =
+            calculator.getReferenceGeometry(0, 2, NUM_VECTORS - 2);
+    const cphd::ReferenceGeometry previous =
+            calculator.getReferenceGeometry(0, 0, NUM_VECTORS - 2);
+    TEST_ASSERT_ALMOST_EQ_EPS(
+            bistatic.azimuthAngleRate,
+            (next.bistatic->azimuthAngle -
+             previous.bistatic->azimuthAngle) / (2 * PRI),
+            1e-3);
+
+    // Separate the receiver
+    cphd::PVPBlock separated = createPVPBlock(metadata, 0.0);
+    const cphd::Vector3 rcvOffset = makeVector(0.0, 20000.0, 0.0);
+    for (size_t ii = 0; ii < NUM_VECTORS; ++ii)
+    {
+        separated.setRcvPos(getPosition(ii * PRI) + rcvOffset, 0, ii);
+    }
+    const cphd::VectorGeometryCalculator separatedCalculator(metadata,
+                                                             separated);
+    const cphd::ReferenceGeometry separatedGeometry =
+            separatedCalculator.getReferenceGeometry(0, 0, NUM_VECTORS);
+    const double refTime = NUM_VECTORS / 2 * PRI;
+    const cphd::Vector3 uTx = (getPosition(refTime) - getSRP()).unit();
+    const cphd::Vector3 uRcv =
+            (getPosition(refTime) + rcvOffset - getSRP()).unit();
+    TEST_ASSERT_ALMOST_EQ(
+            separatedGeometry.bistatic->bistaticAngle,
+            std::acos(uTx.dot(uRcv)) * 180.0 / M_PI);
+
+    separatedCalculator.getGeometry(0, NUM_VECTORS / 2, 1, vectors);
+    TEST_ASSERT_ALMOST_EQ(vectors.bistaticAngle[0],
+                          separatedGeometry.bistatic->bistaticAngle);
+}
+}
+
+int main(int, char**)
+{
+    TEST_CHECK(testMatchesSCPCOA);
+    TEST_CHECK(testScenePoints);
+    TEST_CHECK(testMonostaticReference);
+    TEST_CHECK(testBistaticReference);
+    return 0;
+}
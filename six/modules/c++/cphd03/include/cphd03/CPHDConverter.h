@@ -0,0 +1,195 @@
+/* =========================================================================
+ * This file is part of cphd03-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * cphd03-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CPHD03_CPHD_CONVERTER_H__
+#define __CPHD03_CPHD_CONVERTER_H__
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <io/SeekableStreams.h>
+#include <logging/Logger.h>
+#include <sys/Conf.h>
+#include <cphd/Metadata.h>
+#include <cphd03/FileHeader.h>
+#include <cphd03/Metadata.h>
+
+namespace cphd03
+{
+/*
+ *  \class CPHDConverter
+ *  \brief Converts a CPHD 0.3 file to CPHD 1.0
+ *
+ *  Neither the VBM nor the wideband is ever held in memory.  The VBM is
+ *  read a block of vectors at a time, once to work out the 1.0 metadata
+ *  and again to write the PVPs.  The signal arrays are copied byte for
+ *  byte, since both versions store the same three sample formats in big
+ *  endian and in channel order, so converting takes about as long as
+ *  copying the file.
+ *
+ *  The VBM maps to PVPs as follows:
+ *    - TxTime, TxPos, RcvTime, RcvPos, SRPPos and AmpSF are copied.
+ *    - TxVel and RcvVel are finite differences of the neighbouring
+ *      positions.
+ *    - TDTropoSRP is TropoSRP, or zero without it.
+ *    - FX domain: SC0 = Fx0, SCSS = FxSS, FX1/FX2 are copied and TOA1/TOA2
+ *      are -/+ TOASavedNom / 2.
+ *    - TOA domain: SC0 = DeltaTOA0, SCSS = TOASS, TOA1/TOA2 span the
+ *      samples and FX1/FX2 are FxCtrNom -/+ BWSavedNom / 2.
+ *    - aFDOP, aFRR1 and aFRR2 have no 0.3 equivalent and are zero.
+ *
+ *  The scene coordinates come from the 0.3 image area plane, or from a
+ *  plane tangent to the ellipsoid at the reference SRP if there isn't one.
+ *  The reference vector of each channel is its middle vector, and the
+ *  reference geometry is monostatic from the midpoint of the transmit and
+ *  receive positions.  Polarization isn't in 0.3, so it's UNSPECIFIED;
+ *  callers can fill in anything they know through getMetadata() before
+ *  writing.  Antenna parameters aren't converted.
+ *
+ *  Files whose frequencies are offsets from a reference frequency
+ *  (RefFreqIndex) can't be converted.
+ */
+class CPHDConverter
+{
+public:
+    //! Default number of bytes to read at once
+    static const size_t DEFAULT_BLOCK_SIZE;
+
+    /*
+     *  \func CPHDConverter constructor
+     *  \brief Reads the 0.3 header and XML and works out the 1.0 metadata.
+     *  This reads the VBM but not the wideband.
+     *
+     *  \param inStream Input CPHD 0.3
+     *  \param blockSize (Optional) Number of bytes to read at once.  At
+     *  least one vector is always read.
+     *  \param logger (Optional) Logger for the XML parser
+     *
+     *  \throw except::Exception If the file can't be converted
+     */
+    CPHDConverter(std::shared_ptr<io::SeekableInputStream> inStream,
+                  size_t blockSize = DEFAULT_BLOCK_SIZE,
+                  std::shared_ptr<logging::Logger> logger =
+                          std::shared_ptr<logging::Logger>());
+
+    /*
+     *  \func CPHDConverter constructor
+     *  \brief Same as above but opens the input file
+     *
+     *  \param inPathname Input CPHD 0.3 pathname
+     *  \param blockSize (Optional) Number of bytes to read at once
+     *  \param logger (Optional) Logger for the XML parser
+     */
+    CPHDConverter(const std::string& inPathname,
+                  size_t blockSize = DEFAULT_BLOCK_SIZE,
+                  std::shared_ptr<logging::Logger> logger =
+                          std::shared_ptr<logging::Logger>());
+
+    //! Get the 0.3 metadata
+    const Metadata& getInputMetadata() const
+    {
+        return *mInputMetadata;
+    }
+
+    //! Get the 1.0 metadata
+    const cphd::Metadata& getMetadata() const
+    {
+        return *mMetadata;
+    }
+
+    /*
+     *  \func getMetadata
+     *  \brief Get the 1.0 metadata to add what 0.3 doesn't have.  Only
+     *  descriptive fields may be changed; the Data and PVP blocks must match
+     *  what's written.
+     */
+    cphd::Metadata& getMetadata()
+    {
+        return *mMetadata;
+    }
+
+    /*
+     *  \func write
+     *  \brief Writes the CPHD 1.0 file to a stream
+     *
+     *  \param outStream Output stream
+     *  \param schemaPaths (Optional) XML schemas for validation
+     */
+    void write(io::OutputStream& outStream,
+               const std::vector<std::string>& schemaPaths =
+                       std::vector<std::string>()) const;
+
+    /*
+     *  \func write
+     *  \brief Writes the CPHD 1.0 file
+     *
+     *  \param outPathname Output pathname
+     *  \param schemaPaths (Optional) XML schemas for validation
+     */
+    void write(const std::string& outPathname,
+               const std::vector<std::string>& schemaPaths =
+                       std::vector<std::string>()) const;
+
+private:
+    struct VectorValues;
+    struct ChannelSummary;
+
+    void initialize(std::shared_ptr<logging::Logger> logger);
+
+    void readVectors(size_t channel,
+                     size_t firstVector,
+                     size_t numVectors,
+                     std::vector<sys::ubyte>& buffer,
+                     std::vector<VectorValues>& values) const;
+
+    ChannelSummary summarize(size_t channel,
+                             std::vector<sys::ubyte>& buffer) const;
+
+    void createMetadata(const std::vector<ChannelSummary>& summaries);
+
+    void writePVPs(size_t channel,
+                   std::vector<sys::ubyte>& buffer,
+                   io::OutputStream& outStream) const;
+
+    void copySignal(std::vector<sys::ubyte>& buffer,
+                    io::OutputStream& outStream) const;
+
+    sys::Off_T getVBMOffset(size_t channel) const;
+
+    size_t getVectorsPerBlock() const;
+
+    const std::shared_ptr<io::SeekableInputStream> mInStream;
+    const size_t mBlockSize;
+    FileHeader mFileHeader;
+    std::unique_ptr<Metadata> mInputMetadata;
+    std::unique_ptr<cphd::Metadata> mMetadata;
+
+    // Layout of a vector in the VBM
+    bool mHaveSRPTime;
+    bool mHaveTropoSRP;
+    bool mHaveAmpSF;
+    size_t mNumBytesVBP;
+};
+}
+
+#endif
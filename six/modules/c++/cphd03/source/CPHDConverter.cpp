@@ -0,0 +1,803 @@
+/* =========================================================================
+ * This file is part of cphd03-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * cphd03-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <sstream>
+
+#include <except/Exception.h>
+#include <io/FileInputStream.h>
+#include <io/FileOutputStream.h>
+#include <logging/NullLogger.h>
+#include <math/Constants.h>
+#include <str/Convert.h>
+#include <xml/lite/MinidomParser.h>
+#include <scene/Utilities.h>
+#include <six/sicd/GeoData.h>
+#include <six/sicd/Grid.h>
+#include <six/sicd/Position.h>
+#include <six/sicd/SCPCOA.h>
+#include <cphd/CPHDXMLControl.h>
+#include <cphd/FileHeader.h>
+#include <cphd03/CPHDConverter.h>
+#include <cphd03/CPHDXMLControl.h>
+
+namespace
+{
+const char COD_ID[] = "COD1";
+const char DWELL_ID[] = "DWELL1";
+
+// Both versions store big endian doubles
+double getWord(const sys::ubyte*& data)
+{
+    double value;
+    std::memcpy(&value, data, sizeof(value));
+    data += sizeof(value);
+    return sys::isBigEndianSystem() ? value : sys::byteSwap(value);
+}
+
+cphd::Vector3 getVector3(const sys::ubyte*& data)
+{
+    cphd::Vector3 value;
+    value[0] = getWord(data);
+    value[1] = getWord(data);
+    value[2] = getWord(data);
+    return value;
+}
+
+void setWord(double value, sys::ubyte* data)
+{
+    if (!sys::isBigEndianSystem())
+    {
+        value = sys::byteSwap(value);
+    }
+    std::memcpy(data, &value, sizeof(value));
+}
+
+void setWord(double value, const cphd::PVPType& param, sys::ubyte* data)
+{
+    setWord(value, data + param.getByteOffset());
+}
+
+void setWord(const cphd::Vector3& value,
+             const cphd::PVPType& param,
+             sys::ubyte* data)
+{
+    data += param.getByteOffset();
+    for (size_t ii = 0; ii < 3; ++ii)
+    {
+        setWord(value[ii], data + ii * sizeof(double));
+    }
+}
+
+void readFully(io::SeekableInputStream& inStream,
+               sys::ubyte* data,
+               size_t numBytes)
+{
+    inStream.read(reinterpret_cast<sys::byte*>(data), numBytes, true);
+}
+
+// Velocity from the positions either side, or zero if there's no time
+// between them
+cphd::Vector3 getVelocity(const cphd::Vector3& pos1, double time1,
+                          const cphd::Vector3& pos2, double time2)
+{
+    if (time1 == time2)
+    {
+        return cphd::Vector3(0.0);
+    }
+    return (pos2 - pos1) * (1.0 / (time2 - time1));
+}
+
+cphd::SignalArrayFormat getSignalArrayFormat(cphd::SampleType sampleType)
+{
+    switch (sampleType)
+    {
+    case cphd::SampleType::RE08I_IM08I:
+        return cphd::SignalArrayFormat::CI2;
+    case cphd::SampleType::RE16I_IM16I:
+        return cphd::SignalArrayFormat::CI4;
+    case cphd::SampleType::RE32F_IM32F:
+        return cphd::SignalArrayFormat::CF8;
+    default:
+        throw except::Exception(Ctxt("Unknown sample type " +
+                                     sampleType.toString()));
+    }
+}
+
+cphd::Poly2D getConstantPoly(double value)
+{
+    cphd::Poly2D poly(0, 0);
+    poly[0][0] = value;
+    return poly;
+}
+}
+
+namespace cphd03
+{
+// One vector's PVPs
+struct CPHDConverter::VectorValues
+{
+    double txTime;
+    cphd::Vector3 txPos;
+    cphd::Vector3 txVel;
+    double rcvTime;
+    cphd::Vector3 rcvPos;
+    cphd::Vector3 rcvVel;
+    cphd::Vector3 srpPos;
+    double fx1;
+    double fx2;
+    double toa1;
+    double toa2;
+    double tdTropoSRP;
+    double sc0;
+    double scss;
+    double ampSF;
+};
+
+// What the PVPs of a channel span
+struct CPHDConverter::ChannelSummary
+{
+    ChannelSummary() :
+        minFx1(std::numeric_limits<double>::max()),
+        maxFx1(-std::numeric_limits<double>::max()),
+        minFx2(std::numeric_limits<double>::max()),
+        maxFx2(-std::numeric_limits<double>::max()),
+        minTOA1(std::numeric_limits<double>::max()),
+        maxTOA1(-std::numeric_limits<double>::max()),
+        minTOA2(std::numeric_limits<double>::max()),
+        maxTOA2(-std::numeric_limits<double>::max()),
+        srpFixed(true),
+        refVectorIndex(0)
+    {
+    }
+
+    void add(const VectorValues& values, size_t vector)
+    {
+        minFx1 = std::min(minFx1, values.fx1);
+        maxFx1 = std::max(maxFx1, values.fx1);
+        minFx2 = std::min(minFx2, values.fx2);
+        maxFx2 = std::max(maxFx2, values.fx2);
+        minTOA1 = std::min(minTOA1, values.toa1);
+        maxTOA1 = std::max(maxTOA1, values.toa1);
+        minTOA2 = std::min(minTOA2, values.toa2);
+        maxTOA2 = std::max(maxTOA2, values.toa2);
+        if (vector == 0)
+        {
+            srpPos = values.srpPos;
+        }
+        else if (values.srpPos != srpPos)
+        {
+            srpFixed = false;
+        }
+        if (vector == refVectorIndex)
+        {
+            reference = values;
+        }
+    }
+
+    bool isFxFixed() const
+    {
+        return minFx1 == maxFx1 && minFx2 == maxFx2;
+    }
+
+    bool isTOAFixed() const
+    {
+        return minTOA1 == maxTOA1 && minTOA2 == maxTOA2;
+    }
+
+    double minFx1;
+    double maxFx1;
+    double minFx2;
+    double maxFx2;
+    double minTOA1;
+    double maxTOA1;
+    double minTOA2;
+    double maxTOA2;
+    bool srpFixed;
+    cphd::Vector3 srpPos;
+    size_t refVectorIndex;
+    VectorValues reference;
+};
+
+const size_t CPHDConverter::DEFAULT_BLOCK_SIZE = 64 * 1024 * 1024;
+
+CPHDConverter::CPHDConverter(
+        std::shared_ptr<io::SeekableInputStream> inStream,
+        size_t blockSize,
+        std::shared_ptr<logging::Logger> logger) :
+    mInStream(inStream),
+    mBlockSize(blockSize)
+{
+    initialize(logger);
+}
+
+CPHDConverter::CPHDConverter(const std::string& inPathname,
+                             size_t blockSize,
+                             std::shared_ptr<logging::Logger> logger) :
+    mInStream(new io::FileInputStream(inPathname)),
+    mBlockSize(blockSize)
+{
+    initialize(logger);
+}
+
+void CPHDConverter::initialize(std::shared_ptr<logging::Logger> logger)
+{
+    mFileHeader.read(*mInStream);
+
+    // Read in the XML string
+    mInStream->seek(mFileHeader.getXMLoffset(), io::Seekable::START);
+    xml::lite::MinidomParser xmlParser;
+    xmlParser.preserveCharacterData(true);
+    xmlParser.parse(*mInStream, static_cast<int>(mFileHeader.getXMLsize()));
+
+    if (logger.get() == NULL)
+    {
+        logger.reset(new logging::NullLogger());
+    }
+    mInputMetadata.reset(CPHDXMLControl(logger.get()).fromXML(
+            xmlParser.getDocument()).release());
+
+    const Metadata& metadata = *mInputMetadata;
+    if (!six::Init::isUndefined(metadata.global.refFrequencyIndex))
+    {
+        throw except::Exception(Ctxt(
+                "Frequencies relative to a reference frequency can't be "
+                "converted to CPHD 1.0"));
+    }
+    if (metadata.getDomainType() != cphd::DomainType::FX &&
+        metadata.getDomainType() != cphd::DomainType::TOA)
+    {
+        throw except::Exception(Ctxt("Unknown domain type"));
+    }
+    if (metadata.getNumChannels() == 0)
+    {
+        throw except::Exception(Ctxt("There are no channels"));
+    }
+    if (metadata.channel.parameters.size() < metadata.getNumChannels())
+    {
+        throw except::Exception(Ctxt(
+                "Every channel needs channel parameters"));
+    }
+
+    // The same layout as VBM
+    const VectorParameters& vp = metadata.vectorParameters;
+    const bool isFX = metadata.getDomainType() == cphd::DomainType::FX;
+    if ((isFX && vp.fxParameters.get() == NULL) ||
+        (!isFX && vp.toaParameters.get() == NULL))
+    {
+        throw except::Exception(Ctxt(
+                "Vector parameters don't match the domain type"));
+    }
+    mHaveSRPTime = vp.srpTimeOffset() > 0;
+    mHaveTropoSRP = vp.tropoSRPOffset() > 0;
+    mHaveAmpSF = vp.ampSFOffset() > 0;
+    const size_t numWords = 1 + 3 + 1 + 3 + (mHaveSRPTime ? 1 : 0) + 3 +
+            (mHaveTropoSRP ? 1 : 0) + (mHaveAmpSF ? 1 : 0) + (isFX ? 4 : 2);
+    mNumBytesVBP = numWords * sizeof(double);
+    if (!six::Init::isUndefined(metadata.data.getNumBytesVBP()))
+    {
+        mNumBytesVBP = std::max(mNumBytesVBP,
+                                metadata.data.getNumBytesVBP());
+    }
+    if (getVBMOffset(metadata.getNumChannels()) - getVBMOffset(0) !=
+        mFileHeader.getVBMsize())
+    {
+        std::ostringstream oss;
+        oss << "Calculated VBM size ("
+            << getVBMOffset(metadata.getNumChannels()) - getVBMOffset(0)
+            << ") != header VB_DATA_SIZE (" << mFileHeader.getVBMsize()
+            << ")";
+        throw except::Exception(Ctxt(oss.str()));
+    }
+
+    std::vector<sys::ubyte> buffer;
+    std::vector<ChannelSummary> summaries;
+    for (size_t ii = 0; ii < metadata.getNumChannels(); ++ii)
+    {
+        summaries.push_back(summarize(ii, buffer));
+    }
+    createMetadata(summaries);
+}
+
+sys::Off_T CPHDConverter::getVBMOffset(size_t channel) const
+{
+    sys::Off_T offset = mFileHeader.getVBMoffset();
+    for (size_t ii = 0; ii < channel; ++ii)
+    {
+        offset += static_cast<sys::Off_T>(
+                mInputMetadata->getNumVectors(ii)) * mNumBytesVBP;
+    }
+    return offset;
+}
+
+size_t CPHDConverter::getVectorsPerBlock() const
+{
+    return std::max<size_t>(mBlockSize / mNumBytesVBP, 1);
+}
+
+void CPHDConverter::readVectors(size_t channel,
+                                size_t firstVector,
+                                size_t numVectors,
+                                std::vector<sys::ubyte>& buffer,
+                                std::vector<VectorValues>& values) const
+{
+    const Metadata& metadata = *mInputMetadata;
+    const ChannelParameters& parameters = metadata.channel.parameters[channel];
+    const bool isFX = metadata.getDomainType() == cphd::DomainType::FX;
+    const size_t numSamples = metadata.getNumSamples(channel);
+
+    // Read a vector either side for the velocities
+    const size_t readFirst = firstVector > 0 ? firstVector - 1 : 0;
+    const size_t readEnd = std::min(firstVector + numVectors + 1,
+                                    metadata.getNumVectors(channel));
+    const size_t numRead = readEnd - readFirst;
+    buffer.resize(numRead * mNumBytesVBP);
+    mInStream->seek(getVBMOffset(channel) +
+                            static_cast<sys::Off_T>(readFirst) * mNumBytesVBP,
+                    io::Seekable::START);
+    readFully(*mInStream, &buffer[0], buffer.size());
+
+    std::vector<VectorValues> vectors(numRead);
+    for (size_t ii = 0; ii < numRead; ++ii)
+    {
+        const sys::ubyte* ptr = &buffer[ii * mNumBytesVBP];
+        VectorValues& vector = vectors[ii];
+        vector.txTime = getWord(ptr);
+        vector.txPos = getVector3(ptr);
+        vector.rcvTime = getWord(ptr);
+        vector.rcvPos = getVector3(ptr);
+        if (mHaveSRPTime)
+        {
+            getWord(ptr);
+        }
+        vector.srpPos = getVector3(ptr);
+        vector.tdTropoSRP = mHaveTropoSRP ? getWord(ptr) : 0.0;
+        vector.ampSF = mHaveAmpSF ? getWord(ptr) : 0.0;
+        if (isFX)
+        {
+            vector.sc0 = getWord(ptr);
+            vector.scss = getWord(ptr);
+            vector.fx1 = getWord(ptr);
+            vector.fx2 = getWord(ptr);
+            vector.toa1 = -parameters.toaSavedNom / 2;
+            vector.toa2 = parameters.toaSavedNom / 2;
+        }
+        else
+        {
+            vector.sc0 = getWord(ptr);
+            vector.scss = getWord(ptr);
+            const double toaLast = vector.sc0 + (numSamples - 1) * vector.scss;
+            vector.toa1 = std::min(vector.sc0, toaLast);
+            vector.toa2 = std::max(vector.sc0, toaLast);
+            vector.fx1 = parameters.fxCtrNom - parameters.bwSavedNom / 2;
+            vector.fx2 = parameters.fxCtrNom + parameters.bwSavedNom / 2;
+        }
+    }
+
+    values.resize(numVectors);
+    for (size_t ii = 0; ii < numVectors; ++ii)
+    {
+        const size_t index = firstVector - readFirst + ii;
+        const VectorValues& previous = vectors[index > 0 ? index - 1 : 0];
+        const VectorValues& next = vectors[std::min(index + 1, numRead - 1)];
+        values[ii] = vectors[index];
+        values[ii].txVel = getVelocity(previous.txPos, previous.txTime,
+                                       next.txPos, next.txTime);
+        values[ii].rcvVel = getVelocity(previous.rcvPos, previous.rcvTime,
+                                        next.rcvPos, next.rcvTime);
+    }
+}
+
+CPHDConverter::ChannelSummary
+CPHDConverter::summarize(size_t channel, std::vector<sys::ubyte>& buffer) const
+{
+    const size_t numVectors = mInputMetadata->getNumVectors(channel);
+    const size_t vectorsPerBlock = getVectorsPerBlock();
+
+    ChannelSummary summary;
+    summary.refVectorIndex = numVectors / 2;
+    std::vector<VectorValues> values;
+    for (size_t done = 0; done < numVectors; done += vectorsPerBlock)
+    {
+        const size_t numBlockVectors =
+                std::min(vectorsPerBlock, numVectors - done);
+        readVectors(channel, done, numBlockVectors, buffer, values);
+        for (size_t ii = 0; ii < numBlockVectors; ++ii)
+        {
+            summary.add(values[ii], done + ii);
+        }
+    }
+    return summary;
+}
+
+void CPHDConverter::createMetadata(
+        const std::vector<ChannelSummary>& summaries)
+{
+    const Metadata& input = *mInputMetadata;
+    mMetadata.reset(new cphd::Metadata());
+    cphd::Metadata& metadata = *mMetadata;
+
+    // CollectionID
+    metadata.collectionID = input.collectionInformation;
+    if (six::Init::isUndefined(metadata.collectionID.releaseInfo) &&
+        !mFileHeader.getReleaseInfo().empty())
+    {
+        metadata.collectionID.releaseInfo = mFileHeader.getReleaseInfo();
+    }
+
+    // Global
+    metadata.global.domainType = input.getDomainType();
+    metadata.global.sgn = input.global.phaseSGN;
+    metadata.global.timeline.collectionStart = input.global.collectStart;
+    metadata.global.timeline.txTime1 = input.global.txTime1;
+    metadata.global.timeline.txTime2 = input.global.txTime2;
+    metadata.global.fxBand.fxMin = std::numeric_limits<double>::max();
+    metadata.global.fxBand.fxMax = -std::numeric_limits<double>::max();
+    metadata.global.toaSwath.toaMin = std::numeric_limits<double>::max();
+    metadata.global.toaSwath.toaMax = -std::numeric_limits<double>::max();
+    for (size_t ii = 0; ii < summaries.size(); ++ii)
+    {
+        metadata.global.fxBand.fxMin = std::min(metadata.global.fxBand.fxMin,
+                                                summaries[ii].minFx1);
+        metadata.global.fxBand.fxMax = std::max(metadata.global.fxBand.fxMax,
+                                                summaries[ii].maxFx2);
+        metadata.global.toaSwath.toaMin = std::min(
+                metadata.global.toaSwath.toaMin, summaries[ii].minTOA1);
+        metadata.global.toaSwath.toaMax = std::max(
+                metadata.global.toaSwath.toaMax, summaries[ii].maxTOA2);
+    }
+
+    // SceneCoordinates, with the image area plane if there is one
+    const VectorValues& reference = summaries[0].reference;
+    cphd::SceneCoordinates& scene = metadata.sceneCoordinates;
+    scene.earthModel = cphd::EarthModelType::WGS_84;
+    scene.referenceSurface.planar.reset(new cphd::Planar());
+    cphd::Vector3& uIax = scene.referenceSurface.planar->uIax;
+    cphd::Vector3& uIay = scene.referenceSurface.planar->uIay;
+    const AreaPlane* const plane = input.global.imageArea.plane.get();
+    if (plane)
+    {
+        scene.iarp.ecf = plane->referencePoint.ecef;
+        scene.iarp.llh = scene::Utilities::ecefToLatLon(scene.iarp.ecf);
+        uIax = plane->xDirection.unitVector.unit();
+        uIay = plane->yDirection.unitVector.unit();
+    }
+    else
+    {
+        // East and north at the reference SRP
+        scene.iarp.ecf = reference.srpPos;
+        scene.iarp.llh = scene::Utilities::ecefToLatLon(scene.iarp.ecf);
+        const double lat = scene.iarp.llh.getLat() *
+                math::Constants::DEGREES_TO_RADIANS;
+        const double lon = scene.iarp.llh.getLon() *
+                math::Constants::DEGREES_TO_RADIANS;
+        uIax[0] = -std::sin(lon);
+        uIax[1] = std::cos(lon);
+        uIax[2] = 0.0;
+        uIay[0] = -std::sin(lat) * std::cos(lon);
+        uIay[1] = -std::sin(lat) * std::sin(lon);
+        uIay[2] = std::cos(lat);
+    }
+    const cphd::Vector3 uIaz = math::linear::cross(uIax, uIay);
+
+    // The image area bounds the corner points
+    const cphd::LatLonAltCorners& corners = input.global.imageArea.acpCorners;
+    cphd::Vector2 minXY(std::numeric_limits<double>::max());
+    cphd::Vector2 maxXY(-std::numeric_limits<double>::max());
+    for (size_t ii = 0; ii < cphd::LatLonAltCorners::NUM_CORNERS; ++ii)
+    {
+        const cphd::Vector3 offset =
+                scene::Utilities::latLonToECEF(corners.getCorner(ii)) -
+                scene.iarp.ecf;
+        const double x = offset.dot(uIax);
+        const double y = offset.dot(uIay);
+        minXY[0] = std::min(minXY[0], x);
+        minXY[1] = std::min(minXY[1], y);
+        maxXY[0] = std::max(maxXY[0], x);
+        maxXY[1] = std::max(maxXY[1], y);
+
+        scene.imageAreaCorners.getCorner(ii).setLat(
+                corners.getCorner(ii).getLat());
+        scene.imageAreaCorners.getCorner(ii).setLon(
+                corners.getCorner(ii).getLon());
+    }
+    scene.imageArea.x1y1 = minXY;
+    scene.imageArea.x2y2 = maxXY;
+
+    // PVP
+    cphd::Pvp& pvp = metadata.pvp;
+    pvp.append(pvp.txTime);
+    pvp.append(pvp.txPos);
+    pvp.append(pvp.txVel);
+    pvp.append(pvp.rcvTime);
+    pvp.append(pvp.rcvPos);
+    pvp.append(pvp.rcvVel);
+    pvp.append(pvp.srpPos);
+    if (mHaveAmpSF)
+    {
+        pvp.append(pvp.ampSF);
+    }
+    pvp.append(pvp.aFDOP);
+    pvp.append(pvp.aFRR1);
+    pvp.append(pvp.aFRR2);
+    pvp.append(pvp.fx1);
+    pvp.append(pvp.fx2);
+    pvp.append(pvp.toa1);
+    pvp.append(pvp.toa2);
+    pvp.append(pvp.tdTropoSRP);
+    pvp.append(pvp.sc0);
+    pvp.append(pvp.scss);
+
+    // Data, packed in channel order
+    cphd::Data& data = metadata.data;
+    data.signalArrayFormat = getSignalArrayFormat(input.getSampleType());
+    data.numBytesPVP = pvp.getReqSetSize() * cphd::PVPType::WORD_BYTE_SIZE;
+    size_t signalOffset = 0;
+    size_t pvpOffset = 0;
+    for (size_t ii = 0; ii < input.getNumChannels(); ++ii)
+    {
+        const size_t numVectors = input.getNumVectors(ii);
+        const size_t numSamples = input.getNumSamples(ii);
+        data.channels.push_back(cphd::Data::Channel(
+                numVectors, numSamples, signalOffset, pvpOffset));
+        data.channels.back().identifier = str::toString(ii + 1);
+        signalOffset += numVectors * numSamples * input.getNumBytesPerSample();
+        pvpOffset += numVectors * data.numBytesPVP;
+    }
+
+    // Dwell, from the image area plane or else constant over the collection
+    cphd::COD cod;
+    cod.identifier = COD_ID;
+    cphd::DwellTime dwellTime;
+    dwellTime.identifier = DWELL_ID;
+    if (plane && plane->dwellTime.get())
+    {
+        cod.codTimePoly = plane->dwellTime->codTimePoly;
+        dwellTime.dwellTimePoly = plane->dwellTime->dwellTimePoly;
+    }
+    else
+    {
+        cod.codTimePoly = getConstantPoly(
+                (input.global.txTime1 + input.global.txTime2) / 2);
+        dwellTime.dwellTimePoly = getConstantPoly(
+                std::abs(input.global.txTime2 - input.global.txTime1));
+    }
+    metadata.dwell.cod.push_back(cod);
+    metadata.dwell.dtime.push_back(dwellTime);
+
+    // Channel
+    metadata.channel.refChId = data.channels[0].identifier;
+    bool fxFixed = true;
+    bool toaFixed = true;
+    bool srpFixed = true;
+    for (size_t ii = 0; ii < summaries.size(); ++ii)
+    {
+        const ChannelSummary& summary = summaries[ii];
+        fxFixed = fxFixed && summary.isFxFixed() &&
+                summary.minFx1 == summaries[0].minFx1 &&
+                summary.minFx2 == summaries[0].minFx2;
+        toaFixed = toaFixed && summary.isTOAFixed() &&
+                summary.minTOA1 == summaries[0].minTOA1 &&
+                summary.minTOA2 == summaries[0].minTOA2;
+        srpFixed = srpFixed && summary.srpFixed &&
+                summary.srpPos == summaries[0].srpPos;
+
+        cphd::ChannelParameter parameter;
+        parameter.identifier = data.channels[ii].identifier;
+        parameter.refVectorIndex = summary.refVectorIndex;
+        parameter.fxFixed = summary.isFxFixed() ?
+                six::BooleanType::IS_TRUE : six::BooleanType::IS_FALSE;
+        parameter.toaFixed = summary.isTOAFixed() ?
+                six::BooleanType::IS_TRUE : six::BooleanType::IS_FALSE;
+        parameter.srpFixed = summary.srpFixed ?
+                six::BooleanType::IS_TRUE : six::BooleanType::IS_FALSE;
+        parameter.polarization.txPol = cphd::PolarizationType::UNSPECIFIED;
+        parameter.polarization.rcvPol = cphd::PolarizationType::UNSPECIFIED;
+        parameter.fxC = (summary.minFx1 + summary.maxFx2) / 2;
+        parameter.fxBW = summary.maxFx2 - summary.minFx1;
+        parameter.toaSaved = summary.maxTOA2 - summary.minTOA1;
+        parameter.dwellTimes.codId = COD_ID;
+        parameter.dwellTimes.dwellId = DWELL_ID;
+        metadata.channel.parameters.push_back(parameter);
+    }
+    metadata.channel.fxFixedCphd = fxFixed ?
+            six::BooleanType::IS_TRUE : six::BooleanType::IS_FALSE;
+    metadata.channel.toaFixedCphd = toaFixed ?
+            six::BooleanType::IS_TRUE : six::BooleanType::IS_FALSE;
+    metadata.channel.srpFixedCphd = srpFixed ?
+            six::BooleanType::IS_TRUE : six::BooleanType::IS_FALSE;
+
+    // ReferenceGeometry, at the reference vector of the reference channel
+    cphd::ReferenceGeometry& geometry = metadata.referenceGeometry;
+    const cphd::Vector3 srpOffset = reference.srpPos - scene.iarp.ecf;
+    geometry.srp.ecf = reference.srpPos;
+    geometry.srp.iac[0] = srpOffset.dot(uIax);
+    geometry.srp.iac[1] = srpOffset.dot(uIay);
+    geometry.srp.iac[2] = srpOffset.dot(uIaz);
+    geometry.referenceTime = reference.txTime;
+    geometry.srpCODTime = cod.codTimePoly(geometry.srp.iac[0],
+                                          geometry.srp.iac[1]);
+    geometry.srpDwellTime = dwellTime.dwellTimePoly(geometry.srp.iac[0],
+                                                    geometry.srp.iac[1]);
+
+    // SICD works out the same angles for its SCP
+    six::sicd::SCPCOA scpcoa;
+    scpcoa.scpTime = reference.txTime;
+    scpcoa.arpPos = (reference.txPos + reference.rcvPos) * 0.5;
+    scpcoa.arpVel = (reference.txVel + reference.rcvVel) * 0.5;
+    scpcoa.arpAcc = cphd::Vector3(0.0);
+    six::sicd::GeoData geoData;
+    geoData.scp.ecf = reference.srpPos;
+    scpcoa.fillDerivedFields(geoData, six::sicd::Grid(),
+                             six::sicd::Position());
+
+    geometry.monostatic.reset(new cphd::Monostatic());
+    cphd::Monostatic& monostatic = *geometry.monostatic;
+    monostatic.arpPos = scpcoa.arpPos;
+    monostatic.arpVel = scpcoa.arpVel;
+    monostatic.sideOfTrack = scpcoa.sideOfTrack;
+    monostatic.slantRange = scpcoa.slantRange;
+    monostatic.groundRange = scpcoa.groundRange;
+    monostatic.dopplerConeAngle = scpcoa.dopplerConeAngle;
+    monostatic.grazeAngle = scpcoa.grazeAngle;
+    monostatic.incidenceAngle = scpcoa.incidenceAngle;
+    monostatic.azimuthAngle = scpcoa.azimAngle;
+    monostatic.twistAngle = scpcoa.twistAngle;
+    monostatic.slopeAngle = scpcoa.slopeAngle;
+    monostatic.layoverAngle = scpcoa.layoverAngle;
+}
+
+void CPHDConverter::writePVPs(size_t channel,
+                              std::vector<sys::ubyte>& buffer,
+                              io::OutputStream& outStream) const
+{
+    const cphd::Pvp& pvp = mMetadata->pvp;
+    const size_t numBytesPVP = mMetadata->data.getNumBytesPVPSet();
+    const size_t numVectors = mMetadata->data.getNumVectors(channel);
+    const size_t vectorsPerBlock = getVectorsPerBlock();
+
+    std::vector<VectorValues> values;
+    std::vector<sys::ubyte> pvpBuffer;
+    for (size_t done = 0; done < numVectors; done += vectorsPerBlock)
+    {
+        const size_t numBlockVectors =
+                std::min(vectorsPerBlock, numVectors - done);
+        readVectors(channel, done, numBlockVectors, buffer, values);
+
+        pvpBuffer.assign(numBlockVectors * numBytesPVP, 0);
+        for (size_t ii = 0; ii < numBlockVectors; ++ii)
+        {
+            const VectorValues& vector = values[ii];
+            sys::ubyte* const row = &pvpBuffer[ii * numBytesPVP];
+            setWord(vector.txTime, pvp.txTime, row);
+            setWord(vector.txPos, pvp.txPos, row);
+            setWord(vector.txVel, pvp.txVel, row);
+            setWord(vector.rcvTime, pvp.rcvTime, row);
+            setWord(vector.rcvPos, pvp.rcvPos, row);
+            setWord(vector.rcvVel, pvp.rcvVel, row);
+            setWord(vector.srpPos, pvp.srpPos, row);
+            if (mHaveAmpSF)
+            {
+                setWord(vector.ampSF, pvp.ampSF, row);
+            }
+            setWord(vector.fx1, pvp.fx1, row);
+            setWord(vector.fx2, pvp.fx2, row);
+            setWord(vector.toa1, pvp.toa1, row);
+            setWord(vector.toa2, pvp.toa2, row);
+            setWord(vector.tdTropoSRP, pvp.tdTropoSRP, row);
+            setWord(vector.sc0, pvp.sc0, row);
+            setWord(vector.scss, pvp.scss, row);
+        }
+        outStream.write(reinterpret_cast<const sys::byte*>(&pvpBuffer[0]),
+                        pvpBuffer.size());
+    }
+}
+
+void CPHDConverter::copySignal(std::vector<sys::ubyte>& buffer,
+                               io::OutputStream& outStream) const
+{
+    const Metadata& metadata = *mInputMetadata;
+    sys::Off_T remaining = 0;
+    for (size_t ii = 0; ii < metadata.getNumChannels(); ++ii)
+    {
+        remaining += static_cast<sys::Off_T>(metadata.getNumVectors(ii)) *
+                metadata.getNumSamples(ii) * metadata.getNumBytesPerSample();
+    }
+
+    buffer.resize(static_cast<size_t>(std::min<sys::Off_T>(
+            remaining, std::max<size_t>(mBlockSize, 1))));
+    mInStream->seek(mFileHeader.getCPHDoffset(), io::Seekable::START);
+    while (remaining > 0)
+    {
+        const size_t numBytes = static_cast<size_t>(
+                std::min<sys::Off_T>(remaining, buffer.size()));
+        readFully(*mInStream, &buffer[0], numBytes);
+        outStream.write(reinterpret_cast<const sys::byte*>(&buffer[0]),
+                        numBytes);
+        remaining -= numBytes;
+    }
+}
+
+void CPHDConverter::write(io::OutputStream& outStream,
+                          const std::vector<std::string>& schemaPaths) const
+{
+    const cphd::Metadata& metadata = *mMetadata;
+    if (six::Init::isUndefined(
+                metadata.collectionID.getClassificationLevel()) ||
+        six::Init::isUndefined(metadata.collectionID.releaseInfo))
+    {
+        throw except::Exception(Ctxt("Classification level and Release "
+                                     "informaion must be specified"));
+    }
+
+    sys::Off_T pvpSize = 0;
+    sys::Off_T signalSize = 0;
+    for (size_t ii = 0; ii < metadata.data.getNumChannels(); ++ii)
+    {
+        pvpSize += static_cast<sys::Off_T>(metadata.data.getNumVectors(ii)) *
+                metadata.data.getNumBytesPVPSet();
+        signalSize += static_cast<sys::Off_T>(
+                metadata.data.getNumVectors(ii)) *
+                metadata.data.getNumSamples(ii) *
+                metadata.data.getNumBytesPerSample();
+    }
+
+    const std::string xml =
+            cphd::CPHDXMLControl().toXMLString(metadata, schemaPaths);
+    cphd::FileHeader header;
+    header.setVersion(metadata.getVersion());
+    header.setClassification(metadata.collectionID.getClassificationLevel());
+    header.setReleaseInfo(metadata.collectionID.releaseInfo);
+    header.set(xml.size(), 0, pvpSize, signalSize);
+
+    const std::string headerString = header.toString();
+    outStream.write(headerString.c_str(), headerString.size());
+    outStream.write("\f\n", 2);
+    outStream.write(xml.c_str(), xml.size());
+    outStream.write("\f\n", 2);
+
+    const std::vector<sys::byte> padding(
+            static_cast<size_t>(header.getPvpPadBytes()), 0);
+    if (!padding.empty())
+    {
+        outStream.write(&padding[0], padding.size());
+    }
+
+    std::vector<sys::ubyte> buffer;
+    for (size_t ii = 0; ii < metadata.data.getNumChannels(); ++ii)
+    {
+        writePVPs(ii, buffer, outStream);
+    }
+    copySignal(buffer, outStream);
+}
+
+void CPHDConverter::write(const std::string& outPathname,
+                          const std::vector<std::string>& schemaPaths) const
+{
+    io::FileOutputStream outStream(outPathname);
+    write(outStream, schemaPaths);
+    outStream.close();
+}
+}
@@ -77,7 +77,7 @@ std::auto_ptr<xml::lite::Document> CPHDXMLControl::toXML(const Metadata& metadat
 {
     std::auto_ptr<xml::lite::Document> doc(new xml::lite::Document());
 
-    XMLElem root = newElement("CPHD");
+    XMLElem root = createElement("CPHD");
     doc->setRootElement(root);
 
     // Fill in the rest...
@@ -104,7 +104,7 @@ XMLElem CPHDXMLControl::createLatLonAltFootprint(const std::string& name,
                                                  const cphd::LatLonAltCorners& corners,
                                                  XMLElem parent) const
 {
-    XMLElem footprint = newElement(name, parent);
+    XMLElem footprint = createElement(name, parent);
 
     // Write the corners in CW order
     XMLElem vertex =
@@ -125,7 +125,7 @@ XMLElem CPHDXMLControl::createLatLonAltFootprint(const std::string& name,
 
 XMLElem CPHDXMLControl::toXML(const Data& data, XMLElem parent)
 {
-    XMLElem dataXML = newElement("Data", parent);
+    XMLElem dataXML = createElement("Data", parent);
 
     createString("SampleType", data.sampleType.toString(), dataXML);
 
@@ -133,7 +133,7 @@ XMLElem CPHDXMLControl::toXML(const Data& data, XMLElem parent)
     createInt("NumBytesVBP", data.numBytesVBP, dataXML);
     for (size_t ii = 0; ii < data.numCPHDChannels; ++ii)
     {
-        XMLElem arrsizeXML = newElement("ArraySize", dataXML);
+        XMLElem arrsizeXML = createElement("ArraySize", dataXML);
         createInt("NumVectors", data.arraySize.at(ii).numVectors, arrsizeXML);
         createInt("NumSamples", data.arraySize.at(ii).numSamples, arrsizeXML);
         setAttribute(arrsizeXML, "index", str::toString(ii + 1));
@@ -144,7 +144,7 @@ XMLElem CPHDXMLControl::toXML(const Data& data, XMLElem parent)
 
 XMLElem CPHDXMLControl::toXML(const Global& global, XMLElem parent)
 {
-    XMLElem globalXML = newElement("Global", parent);
+    XMLElem globalXML = createElement("Global", parent);
 
     createString("DomainType", global.domainType.toString(), globalXML);
     createString("PhaseSGN", global.phaseSGN.toString(), globalXML);
@@ -160,7 +160,7 @@ XMLElem CPHDXMLControl::toXML(const Global& global, XMLElem parent)
     createDouble("TxTime2", global.txTime2, globalXML);
 
     // ImageArea is required (SICD RadarCollection:Area is optional)
-    XMLElem areaXML = newElement("ImageArea", globalXML);
+    XMLElem areaXML = createElement("ImageArea", globalXML);
 
     const ImageArea& area = global.imageArea;
 
@@ -175,8 +175,8 @@ XMLElem CPHDXMLControl::toXML(const Global& global, XMLElem parent)
     {
         const AreaPlane& plane = *area.plane;
 
-        XMLElem planeXML = newElement("Plane", areaXML);
-        XMLElem refPtXML = newElement("RefPt", planeXML);
+        XMLElem planeXML = createElement("Plane", areaXML);
+        XMLElem refPtXML = createElement("RefPt", planeXML);
 
         six::ReferencePoint refPt = plane.referencePoint;
         if (!refPt.name.empty())
@@ -194,7 +194,7 @@ XMLElem CPHDXMLControl::toXML(const Global& global, XMLElem parent)
         // Within the optional Plane, DwellTime is itself optional
         if (plane.dwellTime.get())
         {
-            XMLElem dwellTimeXML = newElement("DwellTime", planeXML);
+            XMLElem dwellTimeXML = createElement("DwellTime", planeXML);
             mCommon.createPoly2D("CODTimePoly",
                                  plane.dwellTime->codTimePoly,
                                  dwellTimeXML);
@@ -209,13 +209,13 @@ XMLElem CPHDXMLControl::toXML(const Global& global, XMLElem parent)
 
 XMLElem CPHDXMLControl::toXML(const Channel& channel, XMLElem parent)
 {
-    XMLElem channelXML = newElement("Channel", parent);
+    XMLElem channelXML = createElement("Channel", parent);
 
     // There is a Parameters entry for each channel
 
     for (size_t ii = 0; ii < channel.parameters.size(); ++ii)
     {
-        XMLElem chanParamsXML = newElement("Parameters", channelXML);
+        XMLElem chanParamsXML = createElement("Parameters", channelXML);
         chanParamsXML->attribute("index") = str::toString(ii + 1);
 
         ChannelParameters cp = channel.parameters[ii];
@@ -246,7 +246,7 @@ XMLElem CPHDXMLControl::toXML(const Channel& channel, XMLElem parent)
 
 XMLElem CPHDXMLControl::toXML(const SRP& srp, XMLElem parent)
 {
-    XMLElem srpXML = newElement("SRP", parent);
+    XMLElem srpXML = createElement("SRP", parent);
 
     createString("SRPType", srp.srpType.toString(), srpXML);
     createInt("NumSRPs", srp.numSRPs, srpXML);
@@ -261,7 +261,7 @@ XMLElem CPHDXMLControl::toXML(const SRP& srp, XMLElem parent)
         }
         for (size_t ii = 0; ii < srp.srpPT.size(); ++ii)
         {
-            XMLElem fixedptXML = newElement("FIXEDPT", srpXML);
+            XMLElem fixedptXML = createElement("FIXEDPT", srpXML);
             fixedptXML->attribute("index") = str::toString(ii + 1);
             mCommon.createVector3D("SRPPT", srp.srpPT[ii], fixedptXML);
         }
@@ -276,7 +276,7 @@ XMLElem CPHDXMLControl::toXML(const SRP& srp, XMLElem parent)
         }
         for (size_t ii = 0; ii < srp.srpPVTPoly.size(); ++ii)
         {
-            XMLElem pvtpolyXML = newElement("PVTPOLY", srpXML);
+            XMLElem pvtpolyXML = createElement("PVTPOLY", srpXML);
             pvtpolyXML->attribute("index") = str::toString<int>(ii + 1);
             mCommon.createPolyXYZ("SRPPVTPoly", srp.srpPVTPoly[ii], pvtpolyXML);
         }
@@ -290,7 +290,7 @@ XMLElem CPHDXMLControl::toXML(const SRP& srp, XMLElem parent)
         }
         for (size_t ii = 0; ii < srp.srpPVVPoly.size(); ++ii)
         {
-            XMLElem pvvpolyXML = newElement("PVVPOLY", srpXML);
+            XMLElem pvvpolyXML = createElement("PVVPOLY", srpXML);
             pvvpolyXML->attribute("index") = str::toString<int>(ii + 1);
             mCommon.createPolyXYZ("SRPPVVPoly", srp.srpPVVPoly[ii], pvvpolyXML);
         }
@@ -316,7 +316,7 @@ XMLElem CPHDXMLControl::toXML(const SRP& srp, XMLElem parent)
 
 XMLElem CPHDXMLControl::toXML(const Antenna& antenna, XMLElem parent)
 {
-    XMLElem antennaXML = newElement("Antenna", parent);
+    XMLElem antennaXML = createElement("Antenna", parent);
 
     createInt("NumTxAnt",  antenna.numTxAnt,  antennaXML);
     createInt("NumRcvAnt", antenna.numRcvAnt, antennaXML);
@@ -348,7 +348,7 @@ XMLElem CPHDXMLControl::toXML(const std::string& name,
                               const AntennaParameters& params,
                               XMLElem parent)
 {
-    XMLElem apXML = newElement(name, parent);
+    XMLElem apXML = createElement(name, parent);
 
     mCommon.createPolyXYZ("XAxisPoly", params.xAxisPoly, apXML);
     mCommon.createPolyXYZ("YAxisPoly", params.yAxisPoly, apXML);
@@ -356,25 +356,25 @@ XMLElem CPHDXMLControl::toXML(const std::string& name,
 
     if (params.electricalBoresight.get())
     {
-        XMLElem ebXML = newElement("EB", apXML);
+        XMLElem ebXML = createElement("EB", apXML);
         mCommon.createPoly1D("DCXPoly", params.electricalBoresight->dcxPoly, ebXML);
         mCommon.createPoly1D("DCYPoly", params.electricalBoresight->dcyPoly, ebXML);
     }
     if (params.halfPowerBeamwidths.get())
     {
-        XMLElem hpXML = newElement("HPBW", apXML);
+        XMLElem hpXML = createElement("HPBW", apXML);
         createDouble("DCX", params.halfPowerBeamwidths->dcx, hpXML);
         createDouble("DCY", params.halfPowerBeamwidths->dcy, hpXML);
     }
     if (params.array.get())
     {
-        XMLElem arrXML = newElement("Array", apXML);
+        XMLElem arrXML = createElement("Array", apXML);
         mCommon.createPoly2D("GainPoly", params.array->gainPoly, arrXML);
         mCommon.createPoly2D("PhasePoly", params.array->phasePoly, arrXML);
     }
     if (params.element.get())
     {
-        XMLElem elemXML = newElement("Elem", apXML);
+        XMLElem elemXML = createElement("Elem", apXML);
         mCommon.createPoly2D("GainPoly", params.element->gainPoly, elemXML);
         mCommon.createPoly2D("PhasePoly", params.element->phasePoly, elemXML);
     }
@@ -393,7 +393,7 @@ XMLElem CPHDXMLControl::toXML(const std::string& name,
 
 XMLElem CPHDXMLControl::toXML(const VectorParameters& vp, XMLElem parent)
 {
-    XMLElem vectorParametersXML = newElement("VectorParameters", parent);
+    XMLElem vectorParametersXML = createElement("VectorParameters", parent);
 
     createInt("TxTime", vp.txTime, vectorParametersXML);
     createInt("TxPos", vp.txPos, vectorParametersXML);
@@ -434,7 +434,7 @@ XMLElem CPHDXMLControl::toXML(const VectorParameters& vp, XMLElem parent)
 
     if (vp.fxParameters.get() != NULL)
     {
-        XMLElem fxParametersXML = newElement("FxParameters", vectorParametersXML);
+        XMLElem fxParametersXML = createElement("FxParameters", vectorParametersXML);
         createInt("Fx0", vp.fxParameters->Fx0, fxParametersXML);
         createInt("Fx_SS", vp.fxParameters->FxSS, fxParametersXML);
         createInt("Fx1", vp.fxParameters->Fx1, fxParametersXML);
@@ -443,7 +443,7 @@ XMLElem CPHDXMLControl::toXML(const VectorParameters& vp, XMLElem parent)
 
     if (vp.toaParameters.get() != NULL)
     {
-        XMLElem toaParametersXML = newElement("TOAParameters", vectorParametersXML);
+        XMLElem toaParametersXML = createElement("TOAParameters", vectorParametersXML);
         createInt("DeltaTOA0", vp.toaParameters->deltaTOA0, toaParametersXML);
         createInt("TOA_SS", vp.toaParameters->toaSS, toaParametersXML);
     }
@@ -456,7 +456,7 @@ XMLElem CPHDXMLControl::areaLineDirectionParametersToXML(
     const AreaDirectionParameters& adp,
     XMLElem parent)
 {
-    XMLElem adpXML = newElement(name, parent);
+    XMLElem adpXML = createElement(name, parent);
     mCommon.createVector3D("UVectECF", adp.unitVector, adpXML);
     createDouble("LineSpacing", adp.spacing, adpXML);
     createInt("NumLines", adp.elements, adpXML);
@@ -469,7 +469,7 @@ XMLElem CPHDXMLControl::areaSampleDirectionParametersToXML(
     const AreaDirectionParameters& adp,
     XMLElem parent)
 {
-    XMLElem adpXML = newElement(name, parent);
+    XMLElem adpXML = createElement(name, parent);
     mCommon.createVector3D("UVectECF", adp.unitVector, adpXML);
     createDouble("SampleSpacing", adp.spacing, adpXML);
     createInt("NumSamples", adp.elements, adpXML);
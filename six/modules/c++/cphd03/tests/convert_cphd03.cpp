@@ -0,0 +1,97 @@
+/* =========================================================================
+ * This file is part of cphd03-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * cphd03-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <iostream>
+#include <memory>
+#include <cli/Value.h>
+#include <cli/ArgumentParser.h>
+#include <cphd03/CPHDConverter.h>
+
+/*!
+ * Converts a CPHD 0.3 file to CPHD 1.0
+ */
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        // Parse the command line
+        cli::ArgumentParser parser;
+        parser.setDescription("Convert a CPHD 0.3 file to CPHD 1.0.");
+        parser.addArgument("--release-info",
+                           "Release information, if the 0.3 file has none",
+                           cli::STORE,
+                           "releaseInfo",
+                           "INFO");
+        parser.addArgument("-b --block-size",
+                           "Megabytes to read at once",
+                           cli::STORE,
+                           "blockSize",
+                           "MB")->setDefault(64);
+        parser.addArgument("--schema",
+                           "CPHD 1.0 schema pathname",
+                           cli::STORE,
+                           "schema",
+                           "XSD",
+                           1);
+        parser.addArgument("input", "Input CPHD 0.3 pathname", cli::STORE,
+                           "input", "CPHD03", 1, 1);
+        parser.addArgument("output", "Output CPHD 1.0 pathname", cli::STORE,
+                           "output", "CPHD", 1, 1);
+        const std::unique_ptr<cli::Results> options(parser.parse(argc, argv));
+
+        std::vector<std::string> schemaPathnames;
+        if (options->hasValue("schema"))
+        {
+            const cli::Value* value = options->getValue("schema");
+            for (size_t ii = 0; ii < value->size(); ++ii)
+            {
+                schemaPathnames.push_back(value->get<std::string>(ii));
+            }
+        }
+
+        cphd03::CPHDConverter converter(
+                options->get<std::string>("input"),
+                options->get<size_t>("blockSize") * 1024 * 1024);
+        if (options->hasValue("releaseInfo"))
+        {
+            converter.getMetadata().collectionID.releaseInfo =
+                    options->get<std::string>("releaseInfo");
+        }
+
+        converter.write(options->get<std::string>("output"), schemaPathnames);
+        return 0;
+    }
+    catch (const except::Exception& ex)
+    {
+        std::cerr << ex.toString() << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+    }
+    catch (...)
+    {
+        std::cerr << "Unknown exception\n";
+    }
+    return 1;
+}
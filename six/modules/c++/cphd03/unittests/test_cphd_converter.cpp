@@ -0,0 +1,370 @@
+/* =========================================================================
+ * This file is part of cphd03-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * cphd03-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <complex>
+#include <string>
+#include <vector>
+#include <io/TempFile.h>
+#include <mem/ScopedArray.h>
+#include <scene/Utilities.h>
+#include <cphd/CPHDReader.h>
+#include <cphd/Wideband.h>
+#include <cphd03/CPHDConverter.h>
+#include <cphd03/CPHDWriter.h>
+#include <cphd03/Metadata.h>
+#include <cphd03/VBM.h>
+#include "TestCase.h"
+
+namespace
+{
+const size_t NUM_CHANNELS = 2;
+const size_t NUM_SAMPLES = 16;
+const size_t NUM_VECTORS[NUM_CHANNELS] = {31, 20};
+const double PRI = 0.01;
+const double FX0 = 9.5e9;
+const double FXSS = 1e6;
+const double TOA_SAVED = 2e-6;
+
+// Small enough to read a few vectors at a time
+const size_t BLOCK_SIZE = 500;
+
+cphd::Vector3 getSRP()
+{
+    return scene::Utilities::latLonToECEF(six::LatLonAlt(35.0, -80.0, 100.0));
+}
+
+cphd::Vector3 getPlatformVelocity()
+{
+    cphd::Vector3 velocity;
+    velocity[0] = 100.0;
+    velocity[1] = -150.0;
+    velocity[2] = 50.0;
+    return velocity;
+}
+
+cphd::Vector3 getPlatformPosition(double time)
+{
+    const cphd::Vector3 srp = getSRP();
+    cphd::Vector3 offset;
+    offset[0] = 12000.0;
+    offset[1] = 9000.0;
+    offset[2] = 7000.0;
+    return srp + offset + getPlatformVelocity() * time;
+}
+
+double getTxTime(size_t channel, size_t vector)
+{
+    return (vector + channel * 0.5) * PRI;
+}
+
+std::complex<float> getSample(size_t channel, size_t vector, size_t sample)
+{
+    return std::complex<float>(channel * 1000.0f + vector, -1.0f * sample);
+}
+
+cphd03::Metadata createMetadata(cphd::DomainType domainType)
+{
+    cphd03::Metadata metadata;
+    metadata.collectionInformation.collectorName = "Collector";
+    metadata.collectionInformation.coreName = "Core";
+    metadata.collectionInformation.collectType = cphd::CollectType::MONOSTATIC;
+    metadata.collectionInformation.radarMode = cphd::RadarModeType::SPOTLIGHT;
+    metadata.collectionInformation.setClassificationLevel("UNCLASSIFIED");
+
+    metadata.data.sampleType = cphd::SampleType::RE32F_IM32F;
+    metadata.data.numCPHDChannels = NUM_CHANNELS;
+    for (size_t ii = 0; ii < NUM_CHANNELS; ++ii)
+    {
+        metadata.data.arraySize.push_back(
+                cphd03::ArraySize(NUM_VECTORS[ii], NUM_SAMPLES));
+    }
+
+    metadata.global.domainType = domainType;
+    metadata.global.phaseSGN = cphd::PhaseSGN::MINUS_1;
+    metadata.global.collectStart = cphd::DateTime(2020, 3, 4, 5, 6, 7.0);
+    metadata.global.collectDuration = 1.0;
+    metadata.global.txTime1 = 0.0;
+    metadata.global.txTime2 = getTxTime(0, NUM_VECTORS[0] - 1);
+    for (size_t ii = 0; ii < six::LatLonAltCorners::NUM_CORNERS; ++ii)
+    {
+        six::LatLonAlt& corner =
+                metadata.global.imageArea.acpCorners.getCorner(ii);
+        corner.setLat(ii < 2 ? 35.01 : 34.99);
+        corner.setLon(ii == 0 || ii == 3 ? -80.01 : -79.99);
+        corner.setAlt(100.0);
+    }
+
+    for (size_t ii = 0; ii < NUM_CHANNELS; ++ii)
+    {
+        cphd03::ChannelParameters parameters;
+        parameters.srpIndex = 0;
+        parameters.nomTOARateSF = 1.0;
+        parameters.fxCtrNom = FX0 + (NUM_SAMPLES - 1) * FXSS / 2;
+        parameters.bwSavedNom = (NUM_SAMPLES - 1) * FXSS;
+        parameters.toaSavedNom = TOA_SAVED;
+        metadata.channel.parameters.push_back(parameters);
+    }
+
+    metadata.srp.srpType = cphd::SRPType::FIXEDPT;
+    metadata.srp.numSRPs = 1;
+    metadata.srp.srpPT.push_back(getSRP());
+
+    cphd03::VectorParameters& vp = metadata.vectorParameters;
+    vp.txTime = 8;
+    vp.txPos = 24;
+    vp.rcvTime = 8;
+    vp.rcvPos = 24;
+    vp.srpPos = 24;
+    vp.tropoSRP = 8;
+    vp.ampSF = 8;
+    if (domainType == cphd::DomainType::FX)
+    {
+        vp.fxParameters.reset(new cphd03::FxParameters());
+        vp.fxParameters->Fx0 = 8;
+        vp.fxParameters->FxSS = 8;
+        vp.fxParameters->Fx1 = 8;
+        vp.fxParameters->Fx2 = 8;
+    }
+    else
+    {
+        vp.toaParameters.reset(new cphd03::TOAParameters());
+        vp.toaParameters->deltaTOA0 = 8;
+        vp.toaParameters->toaSS = 8;
+    }
+
+    // Padded past the parameters used
+    metadata.data.numBytesVBP = 160;
+    return metadata;
+}
+
+void writeCPHD03(const cphd03::Metadata& metadata,
+                 const std::string& pathname,
+                 const std::string& releaseInfo = "UNRESTRICTED")
+{
+    cphd03::VBM vbm(metadata.data, metadata.vectorParameters);
+    for (size_t ii = 0; ii < NUM_CHANNELS; ++ii)
+    {
+        for (size_t jj = 0; jj < NUM_VECTORS[ii]; ++jj)
+        {
+            const double txTime = getTxTime(ii, jj);
+            vbm.setTxTime(txTime, ii, jj);
+            vbm.setTxPos(getPlatformPosition(txTime), ii, jj);
+            vbm.setRcvTime(txTime + 1e-4, ii, jj);
+            vbm.setRcvPos(getPlatformPosition(txTime + 1e-4), ii, jj);
+            vbm.setSRPPos(getSRP(), ii, jj);
+            vbm.setTropoSRP(1e-9 * jj, ii, jj);
+            vbm.setAmpSF(1.0 + jj, ii, jj);
+            if (metadata.getDomainType() == cphd::DomainType::FX)
+            {
+                vbm.setFx0(FX0 + ii * FXSS, ii, jj);
+                vbm.setFxSS(FXSS, ii, jj);
+                vbm.setFx1(FX0 + ii * FXSS, ii, jj);
+                vbm.setFx2(FX0 + (ii + NUM_SAMPLES - 1) * FXSS, ii, jj);
+            }
+            else
+            {
+                vbm.setDeltaTOA0(-1e-6 + jj * 1e-9, ii, jj);
+                vbm.setTOASS(1e-7, ii, jj);
+            }
+        }
+    }
+
+    cphd03::CPHDWriter writer(metadata, pathname, 1);
+    writer.writeMetadata(vbm, "UNCLASSIFIED", releaseInfo);
+    for (size_t ii = 0; ii < NUM_CHANNELS; ++ii)
+    {
+        std::vector<std::complex<float> > data(NUM_VECTORS[ii] * NUM_SAMPLES);
+        for (size_t jj = 0; jj < NUM_VECTORS[ii]; ++jj)
+        {
+            for (size_t kk = 0; kk < NUM_SAMPLES; ++kk)
+            {
+                data[jj * NUM_SAMPLES + kk] = getSample(ii, jj, kk);
+            }
+        }
+        writer.writeCPHDData(&data[0], data.size());
+    }
+}
+
+TEST_CASE(testConvertFX)
+{
+    io::TempFile input;
+    io::TempFile output;
+    writeCPHD03(createMetadata(cphd::DomainType::FX), input.pathname());
+
+    const cphd03::CPHDConverter converter(input.pathname(), BLOCK_SIZE);
+    converter.write(output.pathname());
+
+    const cphd::CPHDReader reader(output.pathname(), 1);
+    const cphd::Metadata& metadata = reader.getMetadata();
+    TEST_ASSERT_EQ(metadata.collectionID.coreName, "Core");
+    TEST_ASSERT_EQ(metadata.collectionID.releaseInfo, "UNRESTRICTED");
+    TEST_ASSERT_EQ(metadata.getDomainType(), cphd::DomainType::FX);
+    TEST_ASSERT_EQ(metadata.global.sgn, cphd::PhaseSGN::MINUS_1);
+    TEST_ASSERT_EQ(metadata.global.fxBand.fxMin, FX0);
+    TEST_ASSERT_EQ(metadata.global.fxBand.fxMax,
+                   FX0 + NUM_SAMPLES * FXSS);
+    TEST_ASSERT_EQ(metadata.global.toaSwath.toaMin, -TOA_SAVED / 2);
+    TEST_ASSERT_EQ(metadata.data.signalArrayFormat,
+                   cphd::SignalArrayFormat::CF8);
+
+    // Each channel's band is fixed, but they're different
+    TEST_ASSERT_EQ(metadata.channel.refChId, "1");
+    TEST_ASSERT_EQ(metadata.channel.fxFixedCphd, six::BooleanType::IS_FALSE);
+    TEST_ASSERT_EQ(metadata.channel.srpFixedCphd, six::BooleanType::IS_TRUE);
+    TEST_ASSERT_EQ(metadata.channel.parameters[1].fxFixed,
+                   six::BooleanType::IS_TRUE);
+    TEST_ASSERT_EQ(metadata.channel.parameters[1].refVectorIndex,
+                   NUM_VECTORS[1] / 2);
+    TEST_ASSERT_EQ(metadata.channel.parameters[1].fxBW,
+                   (NUM_SAMPLES - 1) * FXSS);
+
+    // With no image area plane, the scene is centred on the SRP
+    const cphd::SceneCoordinates& scene = metadata.sceneCoordinates;
+    TEST_ASSERT_EQ(scene.iarp.ecf, getSRP());
+    TEST_ASSERT_TRUE(scene.imageArea.x1y1[0] < 0.0);
+    TEST_ASSERT_TRUE(scene.imageArea.x2y2[0] > 0.0);
+    TEST_ASSERT_TRUE(scene.imageArea.x1y1[1] < 0.0);
+    TEST_ASSERT_TRUE(scene.imageArea.x2y2[1] > 0.0);
+
+    const cphd::ReferenceGeometry& geometry = metadata.referenceGeometry;
+    const double refTime = getTxTime(0, NUM_VECTORS[0] / 2);
+    TEST_ASSERT_EQ(geometry.referenceTime, refTime);
+    TEST_ASSERT_TRUE(geometry.monostatic.get() != NULL);
+    TEST_ASSERT_ALMOST_EQ_EPS(
+            geometry.monostatic->slantRange,
+            (getPlatformPosition(refTime + 5e-5) - getSRP()).norm(), 1e-3);
+    TEST_ASSERT_EQ(geometry.srpCODTime,
+                   getTxTime(0, NUM_VECTORS[0] - 1) / 2);
+
+    const cphd::PVPBlock& pvpBlock = reader.getPVPBlock();
+    for (size_t ii = 0; ii < NUM_CHANNELS; ++ii)
+    {
+        for (size_t jj = 0; jj < NUM_VECTORS[ii]; ++jj)
+        {
+            const double txTime = getTxTime(ii, jj);
+            TEST_ASSERT_EQ(pvpBlock.getTxTime(ii, jj), txTime);
+            TEST_ASSERT_EQ(pvpBlock.getTxPos(ii, jj),
+                           getPlatformPosition(txTime));
+            TEST_ASSERT_EQ(pvpBlock.getSRPPos(ii, jj), getSRP());
+            TEST_ASSERT_EQ(pvpBlock.getAmpSF(ii, jj), 1.0 + jj);
+            TEST_ASSERT_EQ(pvpBlock.getTdTropoSRP(ii, jj), 1e-9 * jj);
+            TEST_ASSERT_EQ(pvpBlock.getSC0(ii, jj), FX0 + ii * FXSS);
+            TEST_ASSERT_EQ(pvpBlock.getSCSS(ii, jj), FXSS);
+            TEST_ASSERT_EQ(pvpBlock.getTOA2(ii, jj), TOA_SAVED / 2);
+
+            const cphd::Vector3 txVel = pvpBlock.getTxVel(ii, jj);
+            const cphd::Vector3 rcvVel = pvpBlock.getRcvVel(ii, jj);
+            for (size_t kk = 0; kk < 3; ++kk)
+            {
+                TEST_ASSERT_ALMOST_EQ_EPS(txVel[kk],
+                                          getPlatformVelocity()[kk], 1e-4);
+                TEST_ASSERT_ALMOST_EQ_EPS(rcvVel[kk],
+                                          getPlatformVelocity()[kk], 1e-4);
+            }
+        }
+
+        mem::ScopedArray<sys::ubyte> buffer;
+        reader.getWideband().read(ii, 0, cphd::Wideband::ALL,
+                                  0, cphd::Wideband::ALL, 1, buffer);
+        const std::complex<float>* data =
+                reinterpret_cast<const std::complex<float>*>(buffer.get());
+        for (size_t jj = 0; jj < NUM_VECTORS[ii]; ++jj)
+        {
+            for (size_t kk = 0; kk < NUM_SAMPLES; ++kk)
+            {
+                TEST_ASSERT_EQ(data[jj * NUM_SAMPLES + kk],
+                               getSample(ii, jj, kk));
+            }
+        }
+    }
+}
+
+TEST_CASE(testConvertTOA)
+{
+    io::TempFile input;
+    io::TempFile output;
+    cphd03::Metadata metadata03 = createMetadata(cphd::DomainType::TOA);
+    cphd03::AreaPlane* const plane = new cphd03::AreaPlane();
+    metadata03.global.imageArea.plane.reset(plane);
+    plane->referencePoint.ecef = getSRP();
+    plane->referencePoint.rowCol = six::RowColDouble(50.0, 50.0);
+    plane->xDirection.unitVector = getPlatformVelocity().unit();
+    plane->xDirection.spacing = 1.0;
+    plane->xDirection.elements = 100;
+    plane->xDirection.first = 0;
+    plane->yDirection.unitVector = math::linear::cross(
+            getSRP().unit(), plane->xDirection.unitVector).unit();
+    plane->yDirection.spacing = 1.0;
+    plane->yDirection.elements = 100;
+    plane->yDirection.first = 0;
+    writeCPHD03(metadata03, input.pathname());
+
+    const cphd03::CPHDConverter converter(input.pathname(), BLOCK_SIZE);
+    converter.write(output.pathname());
+
+    const cphd::CPHDReader reader(output.pathname(), 1);
+    const cphd::Metadata& metadata = reader.getMetadata();
+    TEST_ASSERT_EQ(metadata.getDomainType(), cphd::DomainType::TOA);
+    TEST_ASSERT_EQ(metadata.sceneCoordinates.iarp.ecf, getSRP());
+    TEST_ASSERT_EQ(metadata.sceneCoordinates.referenceSurface.planar->uIax,
+                   plane->xDirection.unitVector);
+    TEST_ASSERT_EQ(metadata.channel.fxFixedCphd, six::BooleanType::IS_TRUE);
+    TEST_ASSERT_EQ(metadata.channel.toaFixedCphd, six::BooleanType::IS_FALSE);
+
+    const cphd::PVPBlock& pvpBlock = reader.getPVPBlock();
+    const size_t vector = 7;
+    const double toa1 = -1e-6 + vector * 1e-9;
+    TEST_ASSERT_EQ(pvpBlock.getSC0(1, vector), toa1);
+    TEST_ASSERT_EQ(pvpBlock.getSCSS(1, vector), 1e-7);
+    TEST_ASSERT_EQ(pvpBlock.getTOA1(1, vector), toa1);
+    TEST_ASSERT_EQ(pvpBlock.getTOA2(1, vector),
+                   toa1 + (NUM_SAMPLES - 1) * 1e-7);
+    TEST_ASSERT_EQ(pvpBlock.getFx1(1, vector), FX0);
+    TEST_ASSERT_EQ(pvpBlock.getFx2(1, vector),
+                   FX0 + (NUM_SAMPLES - 1) * FXSS);
+}
+
+TEST_CASE(testUnsupported)
+{
+    io::TempFile input;
+    io::TempFile output;
+    cphd03::Metadata metadata = createMetadata(cphd::DomainType::FX);
+    metadata.global.refFrequencyIndex = 1;
+    writeCPHD03(metadata, input.pathname());
+    TEST_EXCEPTION(cphd03::CPHDConverter(input.pathname()));
+
+    // There's nothing to take the release info from
+    writeCPHD03(createMetadata(cphd::DomainType::FX), input.pathname(), "");
+    cphd03::CPHDConverter converter(input.pathname());
+    TEST_EXCEPTION(converter.write(output.pathname()));
+    converter.getMetadata().collectionID.releaseInfo = "UNRESTRICTED";
+    converter.write(output.pathname());
+}
+}
+
+int main(int, char**)
+{
+    TEST_CHECK(testConvertFX);
+    TEST_CHECK(testConvertTOA);
+    TEST_CHECK(testUnsupported);
+    return 0;
+}
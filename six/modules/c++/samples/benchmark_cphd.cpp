@@ -0,0 +1,371 @@
+/* =========================================================================
+ * This file is part of six-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <complex>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <cli/ArgumentParser.h>
+#include <cli/Value.h>
+#include <except/Exception.h>
+#include <io/FileInputStream.h>
+#include <mem/ScopedArray.h>
+#include <sys/OS.h>
+#include <sys/StopWatch.h>
+#include <cphd/CPHDReader.h>
+#include <cphd/Metadata.h>
+#include <cphd/PVPBlock.h>
+#include <cphd/TestDataGenerator.h>
+#include <six/Instrumentation.h>
+
+/*
+ * Generates a synthetic CPHD of any size and times writing it, opening it
+ * with CPHDReader, loading its PVPs, reading its signal arrays whole, in
+ * part and scaled to floats, and reading its support arrays, for each of
+ * a list of thread counts.  Results are written as JSON so runs can be
+ * compared.
+ *
+ * Reads follow the write, so unless the file is larger than memory they
+ * mostly measure reads from the page cache.
+ */
+namespace
+{
+struct Timing
+{
+    Timing() :
+        total(0),
+        fastest(std::numeric_limits<double>::max()),
+        count(0)
+    {
+    }
+
+    void add(double elapsed)
+    {
+        total += elapsed;
+        fastest = std::min(fastest, elapsed);
+        ++count;
+    }
+
+    double total;
+    double fastest;
+    size_t count;
+};
+
+struct Result
+{
+    std::string stage;
+    size_t numThreads;
+    size_t numBytes;
+    Timing timing;
+};
+
+void writeJSON(const std::vector<std::pair<std::string, std::string> >& config,
+               const std::vector<Result>& results,
+               std::ostream& os)
+{
+    os << "{\n  \"config\": {";
+    for (size_t ii = 0; ii < config.size(); ++ii)
+    {
+        os << (ii == 0 ? "\n" : ",\n") << "    \"" << config[ii].first
+           << "\": " << config[ii].second;
+    }
+    os << "\n  },\n  \"results\": [";
+    for (size_t ii = 0; ii < results.size(); ++ii)
+    {
+        const Result& result = results[ii];
+        const double meanMs = result.timing.total / result.timing.count;
+        os << (ii == 0 ? "\n" : ",\n")
+           << "    {\"stage\": \"" << result.stage << "\", "
+           << "\"threads\": " << result.numThreads << ", "
+           << "\"bytes\": " << result.numBytes << ", "
+           << "\"iterations\": " << result.timing.count << ", "
+           << "\"mean_ms\": " << meanMs << ", "
+           << "\"fastest_ms\": " << result.timing.fastest << ", "
+           << "\"fastest_mb_per_s\": "
+           << result.numBytes / (1024.0 * 1024.0) /
+                    (std::max(result.timing.fastest, 1e-6) / 1000.0)
+           << "}";
+    }
+    os << "\n  ]\n}\n";
+}
+
+// Times op numIter times and records it
+template <typename OpT>
+void time(const std::string& stage,
+          size_t numThreads,
+          size_t numBytes,
+          size_t numIter,
+          const OpT& op,
+          std::vector<Result>& results)
+{
+    Result result;
+    result.stage = stage;
+    result.numThreads = numThreads;
+    result.numBytes = numBytes;
+    sys::RealTimeStopWatch sw;
+    for (size_t iter = 0; iter < numIter; ++iter)
+    {
+        sw.clear();
+        sw.start();
+        op();
+        result.timing.add(sw.stop());
+    }
+    results.push_back(result);
+}
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        cli::ArgumentParser parser;
+        parser.setDescription(
+                "Times writing and reading a synthetic CPHD and prints the "
+                "results as JSON");
+        parser.addArgument("-c --channels", "Number of channels", cli::STORE,
+                           "channels", "NUM")->setDefault(1);
+        parser.addArgument("-v --vectors", "Number of vectors per channel",
+                           cli::STORE, "vectors", "NUM")->setDefault(4096);
+        parser.addArgument("-s --samples", "Number of samples per vector",
+                           cli::STORE, "samples", "NUM")->setDefault(4096);
+        parser.addArgument("-f --format", "Signal array format", cli::STORE,
+                           "format", "CI2|CI4|CF8")->setDefault("CF8");
+        parser.addArgument("--added-pvps", "Number of added PVPs", cli::STORE,
+                           "addedPVPs", "NUM")->setDefault(0);
+        parser.addArgument("--support-arrays", "Number of support arrays",
+                           cli::STORE, "supportArrays", "NUM")->setDefault(0);
+        parser.addArgument("--support-size",
+                           "Rows and columns of each support array",
+                           cli::STORE, "supportSize", "NUM", 2, 2);
+        parser.addArgument("-t --threads", "Thread counts to time",
+                           cli::STORE, "threads", "NUM", 1);
+        parser.addArgument("-i --iterations", "Number of times to repeat",
+                           cli::STORE, "iterations", "NUM")->setDefault(3);
+        parser.addArgument("--keep", "Keep the CPHD", cli::STORE_TRUE,
+                           "keep");
+        parser.addArgument("--instrument", "Print the instrumentation "
+                           "totals to standard error", cli::STORE_TRUE,
+                           "instrument");
+        parser.addArgument("-o --output", "Write the JSON here instead of "
+                           "to standard output", cli::STORE, "output",
+                           "JSON");
+        parser.addArgument("cphd", "Pathname to write the CPHD to",
+                           cli::STORE, "cphd", "CPHD", 1, 1);
+        const std::unique_ptr<cli::Results> options(parser.parse(argc, argv));
+
+        six::Instrumentation::enable(options->get<bool>("instrument"));
+
+        const size_t numChannels = options->get<size_t>("channels");
+        const types::RowCol<size_t> dims(options->get<size_t>("vectors"),
+                                         options->get<size_t>("samples"));
+        const std::string format = options->get<std::string>("format");
+        const size_t numAddedPVPs = options->get<size_t>("addedPVPs");
+        const size_t numSupportArrays = options->get<size_t>("supportArrays");
+        types::RowCol<size_t> supportDims(64, 64);
+        if (options->hasValue("supportSize"))
+        {
+            supportDims.row = options->getValue("supportSize")->get<size_t>(0);
+            supportDims.col = options->getValue("supportSize")->get<size_t>(1);
+        }
+        std::vector<size_t> threadCounts;
+        if (options->hasValue("threads"))
+        {
+            const cli::Value* value = options->getValue("threads");
+            for (size_t ii = 0; ii < value->size(); ++ii)
+            {
+                threadCounts.push_back(
+                        std::max<size_t>(value->get<size_t>(ii), 1));
+            }
+        }
+        else
+        {
+            threadCounts.push_back(1);
+            threadCounts.push_back(sys::OS().getNumCPUs());
+        }
+        const size_t numIter =
+                std::max<size_t>(options->get<size_t>("iterations"), 1);
+        const std::string pathname = options->get<std::string>("cphd");
+
+        cphd::Metadata metadata;
+        cphd::setUpSyntheticMetadata(numChannels, dims,
+                                     cphd::SignalArrayFormat(format),
+                                     numAddedPVPs, numSupportArrays,
+                                     supportDims, metadata);
+        cphd::PVPBlock pvpBlock(metadata.pvp, metadata.data);
+        cphd::setSyntheticVectorParameters(metadata, pvpBlock);
+
+        const size_t signalSize =
+                dims.area() * metadata.data.getNumBytesPerSample();
+        const size_t pvpSize = numChannels * dims.row *
+                metadata.data.getNumBytesPVPSet();
+        const size_t supportSize = metadata.data.getAllSupportSize();
+        const types::RowCol<size_t> partialDims(
+                std::max<size_t>(dims.row / 2, 1),
+                std::max<size_t>(dims.col / 2, 1));
+        const size_t firstVector = dims.row / 4;
+        const size_t firstSample = dims.col / 4;
+        const size_t lastVector = firstVector + partialDims.row - 1;
+        const size_t lastSample = firstSample + partialDims.col - 1;
+
+        std::vector<Result> results;
+        for (size_t threads : threadCounts)
+        {
+            time("CPHDWriter::write", threads,
+                 numChannels * signalSize + pvpSize + supportSize, numIter,
+                 [&]()
+                 {
+                     cphd::writeSyntheticCPHD(metadata, pvpBlock, pathname,
+                                              threads);
+                 },
+                 results);
+        }
+
+        for (size_t threads : threadCounts)
+        {
+            time("CPHDReader", threads, pvpSize + supportSize, numIter,
+                 [&]()
+                 {
+                     const cphd::CPHDReader reader(pathname, threads);
+                 },
+                 results);
+
+            const cphd::CPHDReader reader(pathname, threads);
+            const cphd::FileHeader& header = reader.getFileHeader();
+            time("PVPBlock::load", threads, pvpSize, numIter,
+                 [&]()
+                 {
+                     io::FileInputStream inStream(pathname);
+                     cphd::PVPBlock loaded(metadata.pvp, metadata.data);
+                     loaded.load(inStream, header.getPvpBlockByteOffset(),
+                                 header.getPvpBlockSize(), threads);
+                 },
+                 results);
+
+            const cphd::Wideband& wideband = reader.getWideband();
+            mem::ScopedArray<sys::ubyte> data;
+            time("Wideband::read full", threads, numChannels * signalSize,
+                 numIter,
+                 [&]()
+                 {
+                     for (size_t ii = 0; ii < numChannels; ++ii)
+                     {
+                         wideband.read(ii, 0, cphd::Wideband::ALL, 0,
+                                       cphd::Wideband::ALL, threads, data);
+                     }
+                 },
+                 results);
+
+            const size_t partialSize =
+                    partialDims.area() * metadata.data.getNumBytesPerSample();
+            time("Wideband::read partial", threads, partialSize, numIter,
+                 [&]()
+                 {
+                     wideband.read(0, firstVector, lastVector, firstSample,
+                                   lastSample, threads, data);
+                 },
+                 results);
+
+            const std::vector<double> scaleFactors(partialDims.row, 2.0);
+            std::vector<sys::ubyte> scratch(partialSize);
+            std::vector<std::complex<float> > scaled(partialDims.area());
+            time("Wideband::read scaled", threads, partialSize, numIter,
+                 [&]()
+                 {
+                     wideband.read(0, firstVector, lastVector, firstSample,
+                                   lastSample, scaleFactors, threads,
+                                   mem::BufferView<sys::ubyte>(
+                                           &scratch[0], scratch.size()),
+                                   mem::BufferView<std::complex<float> >(
+                                           &scaled[0], scaled.size()));
+                 },
+                 results);
+
+            if (supportSize != 0)
+            {
+                const cphd::SupportBlock& supportBlock =
+                        reader.getSupportBlock();
+                time("SupportBlock::readAll", threads, supportSize, numIter,
+                     [&]()
+                     {
+                         supportBlock.readAll(threads, data);
+                     },
+                     results);
+            }
+        }
+
+        if (!options->get<bool>("keep"))
+        {
+            sys::OS().remove(pathname);
+        }
+
+        std::vector<std::pair<std::string, std::string> > config;
+        config.push_back(std::make_pair("channels",
+                                        str::toString(numChannels)));
+        config.push_back(std::make_pair("vectors", str::toString(dims.row)));
+        config.push_back(std::make_pair("samples", str::toString(dims.col)));
+        config.push_back(std::make_pair("format", "\"" + format + "\""));
+        config.push_back(std::make_pair("added_pvps",
+                                        str::toString(numAddedPVPs)));
+        config.push_back(std::make_pair("support_arrays",
+                                        str::toString(numSupportArrays)));
+        config.push_back(std::make_pair(
+                "support_size",
+                "[" + str::toString(supportDims.row) + ", " +
+                        str::toString(supportDims.col) + "]"));
+        config.push_back(std::make_pair("iterations",
+                                        str::toString(numIter)));
+
+        if (options->hasValue("output"))
+        {
+            std::ofstream os(options->get<std::string>("output").c_str());
+            writeJSON(config, results, os);
+        }
+        else
+        {
+            writeJSON(config, results, std::cout);
+        }
+
+        if (options->get<bool>("instrument"))
+        {
+            std::cerr << six::Instrumentation::snapshot();
+        }
+        return 0;
+    }
+    catch (const except::Exception& ex)
+    {
+        std::cerr << ex.toString() << "\n";
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << ex.what() << "\n";
+    }
+    catch (...)
+    {
+        std::cerr << "An unknown exception occured\n";
+    }
+    return 1;
+}
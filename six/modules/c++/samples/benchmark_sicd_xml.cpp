@@ -0,0 +1,191 @@
+/* =========================================================================
+ * This file is part of six-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <memory>
+
+#include <cli/ArgumentParser.h>
+#include <except/Exception.h>
+#include <io/StringStream.h>
+#include <logging/NullLogger.h>
+#include <sys/StopWatch.h>
+#include <xml/lite/MinidomParser.h>
+#include <six/sicd/ComplexData.h>
+#include <six/sicd/ComplexXMLControl.h>
+#include <six/sicd/Utilities.h>
+
+/*
+ * Times each stage of reading and writing a SICD's XML: building the DOM
+ * from text, converting the DOM to ComplexData, converting ComplexData back
+ * to a DOM, and printing that DOM to text.  Also times writing ComplexData
+ * straight to text without a DOM, as six::toXMLString() does.  Optionally
+ * pads the valid data polygons out to a given number of vertices to make a
+ * larger document.
+ */
+namespace
+{
+struct Timing
+{
+    Timing() :
+        total(0),
+        fastest(std::numeric_limits<double>::max())
+    {
+    }
+
+    void add(double elapsed)
+    {
+        total += elapsed;
+        fastest = std::min(fastest, elapsed);
+    }
+
+    double total;
+    double fastest;
+};
+
+void addVertices(six::sicd::ComplexData& data, size_t numVertices)
+{
+    data.imageData->validData.resize(numVertices);
+    data.geoData->validData.resize(numVertices);
+    for (size_t ii = 0; ii < numVertices; ++ii)
+    {
+        data.imageData->validData[ii] = six::RowColInt(ii, ii * 2);
+        data.geoData->validData[ii] =
+                six::LatLon(10 + ii * 1.234567e-6, 20 - ii * 7.654321e-6);
+    }
+}
+
+void report(const std::string& stage, const Timing& timing, size_t numIter)
+{
+    std::cout << stage << ": " << timing.total / numIter << " ms mean, "
+              << timing.fastest << " ms fastest\n";
+}
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        cli::ArgumentParser parser;
+        parser.setDescription("Times parsing and writing a SICD's XML");
+        parser.addArgument("-s --schema",
+                           "Specify a schema or directory of schemas",
+                           cli::STORE, "schema", "FILE");
+        parser.addArgument("-v --vertices",
+                           "Replace the valid data polygons with this many "
+                           "vertices", cli::STORE, "vertices", "NUM")->
+                setDefault(0);
+        parser.addArgument("-i --iterations", "Number of times to repeat",
+                           cli::STORE, "iterations", "NUM")->setDefault(5);
+        parser.addArgument("input", "Input SICD NITF or XML", cli::STORE,
+                           "input", "INPUT", 1, 1);
+        const std::auto_ptr<cli::Results>
+                options(parser.parse(argc, argv));
+
+        std::vector<std::string> schemaPaths;
+        if (options->hasValue("schema"))
+        {
+            schemaPaths.push_back(options->get<std::string>("schema"));
+        }
+        const size_t numVertices = options->get<size_t>("vertices");
+        const size_t numIter =
+                std::max<size_t>(options->get<size_t>("iterations"), 1);
+
+        logging::NullLogger log;
+        std::auto_ptr<six::sicd::ComplexData> data =
+                six::sicd::Utilities::getComplexData(
+                        options->get<std::string>("input"), schemaPaths);
+        if (numVertices > 0)
+        {
+            addVertices(*data, numVertices);
+        }
+
+        const std::string xml =
+                six::sicd::Utilities::toXMLString(*data, schemaPaths, &log);
+        std::cout << "XML size: " << xml.length() << " bytes\n";
+
+        six::sicd::ComplexXMLControl xmlControl(&log);
+        Timing buildDom;
+        Timing fromXML;
+        Timing toXML;
+        Timing print;
+        Timing stream;
+        sys::RealTimeStopWatch sw;
+        for (size_t iter = 0; iter < numIter; ++iter)
+        {
+            io::StringStream inStream;
+            inStream.write(xml);
+            xml::lite::MinidomParser xmlParser;
+            xmlParser.preserveCharacterData(true);
+
+            sw.clear();
+            sw.start();
+            xmlParser.parse(inStream);
+            buildDom.add(sw.stop());
+
+            sw.clear();
+            sw.start();
+            const std::auto_ptr<six::Data> parsed(xmlControl.fromXML(
+                    xmlParser.getDocument(), schemaPaths));
+            fromXML.add(sw.stop());
+
+            sw.clear();
+            sw.start();
+            const std::auto_ptr<xml::lite::Document> doc(
+                    xmlControl.toXML(parsed.get(), schemaPaths));
+            toXML.add(sw.stop());
+
+            io::StringStream outStream;
+            sw.clear();
+            sw.start();
+            doc->getRootElement()->print(outStream);
+            print.add(sw.stop());
+
+            io::StringStream directStream;
+            sw.clear();
+            sw.start();
+            xmlControl.toXML(parsed.get(), schemaPaths, directStream);
+            stream.add(sw.stop());
+        }
+
+        report("Build DOM", buildDom, numIter);
+        report("DOM to ComplexData", fromXML, numIter);
+        report("ComplexData to DOM", toXML, numIter);
+        report("Print DOM", print, numIter);
+        report("ComplexData to text", stream, numIter);
+        return 0;
+    }
+    catch (const except::Exception& ex)
+    {
+        std::cerr << ex.toString() << "\n";
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << ex.what() << "\n";
+    }
+    catch (...)
+    {
+        std::cerr << "An unknown exception occured\n";
+    }
+    return 1;
+}
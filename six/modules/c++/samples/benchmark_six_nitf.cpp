@@ -0,0 +1,645 @@
+/* =========================================================================
+ * This file is part of six-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <complex>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+#include <cli/ArgumentParser.h>
+#include <except/Exception.h>
+#include <io/FileOutputStream.h>
+#include <str/Convert.h>
+#include <sys/OS.h>
+#include <sys/Path.h>
+#include <sys/StopWatch.h>
+#include <six/Instrumentation.h>
+#include <six/NITFHeaderCreator.h>
+#include <six/NITFReadControl.h>
+#include <six/NITFWriteControl.h>
+#include <six/XMLControlFactory.h>
+#include <six/sicd/ComplexXMLControl.h>
+#include <six/sicd/SICDWriteControl.h>
+#include <six/sicd/Utilities.h>
+#include <six/sidd/DerivedXMLControl.h>
+#include <six/sidd/SIDDByteProvider.h>
+#include <six/sidd/Utilities.h>
+
+/*
+ * Synthesizes SICDs and SIDDs of a range of pixel types and layouts and
+ * times the NITF paths that write and read them:
+ *
+ *   NITFWriteControl::save        the whole image from memory
+ *   SICDWriteControl::save        a SICD, a strip of rows at a time
+ *   SIDDByteProvider::getBytes    a SIDD, a strip of rows at a time, including
+ *                                 writing the buffers it provides to a file
+ *   NITFReadControl::load         headers and XML
+ *   interleaved full/window/tile  the whole image, its middle quarter and
+ *                                 random tiles (timed one tile at a time)
+ *   Utilities::getWidebandData    a SICD's pixels as complex<float>
+ *
+ * Each stage reports its mean and percentile latencies and its throughput
+ * as JSON.  A stage that fails, e.g. J2K without a decompression plugin,
+ * reports its error instead.
+ */
+namespace
+{
+struct Product
+{
+    std::string name;
+    six::DataType dataType;
+    six::PixelType pixelType;
+    size_t numSegments;
+    size_t blockSize;
+    bool j2k;
+};
+
+std::vector<Product> getProducts()
+{
+    const Product products[] =
+    {
+        {"SICD RE32F_IM32F", six::DataType::COMPLEX,
+         six::PixelType::RE32F_IM32F, 1, 0, false},
+        {"SICD RE16I_IM16I", six::DataType::COMPLEX,
+         six::PixelType::RE16I_IM16I, 1, 0, false},
+        {"SICD AMP8I_PHS8I", six::DataType::COMPLEX,
+         six::PixelType::AMP8I_PHS8I, 1, 0, false},
+        {"SIDD MONO8I", six::DataType::DERIVED, six::PixelType::MONO8I,
+         1, 0, false},
+        {"SIDD MONO16I", six::DataType::DERIVED, six::PixelType::MONO16I,
+         1, 0, false},
+        {"SIDD RGB8LU", six::DataType::DERIVED, six::PixelType::RGB8LU,
+         1, 0, false},
+        {"SIDD MONO8I blocked", six::DataType::DERIVED,
+         six::PixelType::MONO8I, 1, 256, false},
+        {"SIDD MONO8I multi-segment", six::DataType::DERIVED,
+         six::PixelType::MONO8I, 3, 0, false},
+        {"SIDD MONO8I J2K", six::DataType::DERIVED, six::PixelType::MONO8I,
+         1, 0, true}
+    };
+    return std::vector<Product>(
+            products, products + sizeof(products) / sizeof(products[0]));
+}
+
+// Latencies of each repetition, in ms
+class Latencies
+{
+public:
+    void add(double elapsed)
+    {
+        mSamples.push_back(elapsed);
+    }
+
+    size_t size() const
+    {
+        return mSamples.size();
+    }
+
+    double mean() const
+    {
+        double total = 0;
+        for (size_t ii = 0; ii < mSamples.size(); ++ii)
+        {
+            total += mSamples[ii];
+        }
+        return mSamples.empty() ? 0 : total / mSamples.size();
+    }
+
+    // Nearest rank
+    double percentile(double pct) const
+    {
+        if (mSamples.empty())
+        {
+            return 0;
+        }
+        std::vector<double> sorted(mSamples);
+        std::sort(sorted.begin(), sorted.end());
+        const size_t rank = static_cast<size_t>(
+                pct / 100.0 * sorted.size() + 0.999999);
+        return sorted[std::min(std::max<size_t>(rank, 1), sorted.size()) - 1];
+    }
+
+private:
+    std::vector<double> mSamples;
+};
+
+struct Result
+{
+    std::string product;
+    std::string stage;
+    size_t numBytes;
+    Latencies latencies;
+    std::string error;
+};
+
+std::string quote(const std::string& value)
+{
+    std::string quoted("\"");
+    for (size_t ii = 0; ii < value.size(); ++ii)
+    {
+        if (value[ii] == '"' || value[ii] == '\\')
+        {
+            quoted += '\\';
+        }
+        quoted += (value[ii] == '\n') ? ' ' : value[ii];
+    }
+    return quoted + "\"";
+}
+
+void writeJSON(const types::RowCol<size_t>& dims,
+               size_t numIter,
+               size_t numTiles,
+               size_t tileSize,
+               const std::vector<Result>& results,
+               std::ostream& os)
+{
+    os << "{\n  \"config\": {\"rows\": " << dims.row
+       << ", \"cols\": " << dims.col
+       << ", \"iterations\": " << numIter
+       << ", \"tiles\": " << numTiles
+       << ", \"tile_size\": " << tileSize << "},\n  \"results\": [";
+    for (size_t ii = 0; ii < results.size(); ++ii)
+    {
+        const Result& result = results[ii];
+        os << (ii == 0 ? "\n" : ",\n")
+           << "    {\"product\": " << quote(result.product)
+           << ", \"stage\": " << quote(result.stage);
+        if (!result.error.empty())
+        {
+            os << ", \"error\": " << quote(result.error) << "}";
+            continue;
+        }
+
+        const Latencies& latencies = result.latencies;
+        const double mean = latencies.mean();
+        os << ", \"bytes\": " << result.numBytes
+           << ", \"count\": " << latencies.size()
+           << ", \"mean_ms\": " << mean
+           << ", \"min_ms\": " << latencies.percentile(0)
+           << ", \"p50_ms\": " << latencies.percentile(50)
+           << ", \"p90_ms\": " << latencies.percentile(90)
+           << ", \"p99_ms\": " << latencies.percentile(99)
+           << ", \"max_ms\": " << latencies.percentile(100);
+        if (result.numBytes != 0)
+        {
+            os << ", \"mb_per_s\": "
+               << result.numBytes / (1024.0 * 1024.0) /
+                        (std::max(mean, 1e-6) / 1000.0);
+        }
+        os << "}";
+    }
+    os << "\n  ]\n}\n";
+}
+
+std::auto_ptr<six::Data> createData(const Product& product,
+                                    const types::RowCol<size_t>& dims)
+{
+    std::auto_ptr<six::Data> data;
+    if (product.dataType == six::DataType::COMPLEX)
+    {
+        data.reset(six::sicd::Utilities::createFakeComplexData().release());
+    }
+    else
+    {
+        std::auto_ptr<six::sidd::DerivedData> derived =
+                six::sidd::Utilities::createFakeDerivedData();
+        if (product.pixelType == six::PixelType::RGB8LU)
+        {
+            std::auto_ptr<six::LUT> lut(new six::LUT(256, 3));
+            for (size_t ii = 0; ii < lut->table.size(); ++ii)
+            {
+                lut->table[ii] = static_cast<unsigned char>(ii / 3);
+            }
+            derived->display->remapInformation.reset(
+                    new six::sidd::ColorDisplayRemap(lut.release()));
+        }
+        data.reset(derived.release());
+    }
+    data->setPixelType(product.pixelType);
+    data->setNumRows(dims.row);
+    data->setNumCols(dims.col);
+    return data;
+}
+
+six::Options getOptions(const Product& product, size_t imageSize)
+{
+    six::Options options;
+    if (product.numSegments > 1)
+    {
+        options.setParameter(
+                six::NITFHeaderCreator::OPT_MAX_PRODUCT_SIZE,
+                imageSize / product.numSegments + 1);
+    }
+    if (product.blockSize != 0)
+    {
+        options.setParameter(six::NITFHeaderCreator::OPT_NUM_ROWS_PER_BLOCK,
+                             product.blockSize);
+        options.setParameter(six::NITFHeaderCreator::OPT_NUM_COLS_PER_BLOCK,
+                             product.blockSize);
+    }
+    if (product.j2k)
+    {
+        options.setParameter(
+                six::NITFHeaderCreator::OPT_J2K_COMPRESSION_BYTERATE, 1.0);
+    }
+    return options;
+}
+
+class Benchmark
+{
+public:
+    Benchmark(const std::vector<std::string>& schemaPaths,
+              const types::RowCol<size_t>& dims,
+              size_t numIter,
+              size_t numTiles,
+              size_t tileSize,
+              const std::string& directory,
+              std::vector<Result>& results) :
+        mSchemaPaths(schemaPaths),
+        mDims(dims),
+        mNumIter(numIter),
+        mNumTiles(numTiles),
+        mTileSize(tileSize),
+        mDirectory(directory),
+        mResults(results)
+    {
+    }
+
+    void run(const Product& product)
+    {
+        const std::auto_ptr<six::Data> data(createData(product, mDims));
+        const size_t bytesPerPixel = data->getNumBytesPerPixel();
+        const size_t imageSize = mDims.area() * bytesPerPixel;
+        std::vector<six::UByte> image(imageSize);
+        srand(0);
+        for (size_t ii = 0; ii < image.size(); ++ii)
+        {
+            image[ii] = static_cast<six::UByte>(rand());
+        }
+
+        std::string name(product.name);
+        std::replace(name.begin(), name.end(), ' ', '_');
+        const std::string pathname =
+                sys::Path::joinPaths(mDirectory, "benchmark_" + name + ".nitf");
+        const six::Options options = getOptions(product, imageSize);
+
+        const bool saved =
+                time(product.name, "NITFWriteControl::save", imageSize, [&]()
+        {
+            mem::SharedPtr<six::Container> container(
+                    new six::Container(product.dataType));
+            container->addData(data->clone());
+            six::NITFWriteControl writer(options, container);
+            six::BufferList buffers;
+            buffers.push_back(&image[0]);
+            writer.save(buffers, pathname, mSchemaPaths);
+        });
+
+        const size_t numStripRows = std::max<size_t>((mDims.row + 7) / 8, 1);
+        if (product.dataType == six::DataType::COMPLEX)
+        {
+            const std::string stripPathname = pathname + ".strips";
+            time(product.name, "SICDWriteControl::save", imageSize, [&]()
+            {
+                mem::SharedPtr<six::Container> container(
+                        new six::Container(six::DataType::COMPLEX));
+                container->addData(data->clone());
+                six::sicd::SICDWriteControl writer(stripPathname,
+                                                   mSchemaPaths);
+                writer.initialize(options, container);
+                for (size_t row = 0; row < mDims.row; row += numStripRows)
+                {
+                    const size_t numRows =
+                            std::min(numStripRows, mDims.row - row);
+                    writer.save(&image[row * mDims.col * bytesPerPixel],
+                                types::RowCol<size_t>(row, 0),
+                                types::RowCol<size_t>(numRows, mDims.col));
+                }
+                writer.close();
+            });
+            removeIfExists(stripPathname);
+        }
+        else if (!product.j2k)
+        {
+            const std::string stripPathname = pathname + ".strips";
+            time(product.name, "SIDDByteProvider::getBytes", imageSize, [&]()
+            {
+                const six::sidd::SIDDByteProvider provider(
+                        dynamic_cast<const six::sidd::DerivedData&>(*data),
+                        mSchemaPaths, product.blockSize, product.blockSize,
+                        options.hasParameter(
+                                six::NITFHeaderCreator::OPT_MAX_PRODUCT_SIZE) ?
+                        static_cast<size_t>(options.getParameter(
+                                six::NITFHeaderCreator::OPT_MAX_PRODUCT_SIZE)) :
+                        0);
+                io::FileOutputStream outStream(stripPathname);
+
+                // Blocked images have to be handed over whole blocks at a
+                // time, so take them all at once
+                std::vector<six::UByte> blocked;
+                const size_t rowsPerCall =
+                        provider.isBlocked() ? mDims.row : numStripRows;
+                for (size_t row = 0; row < mDims.row; row += rowsPerCall)
+                {
+                    const size_t numRows =
+                            std::min(rowsPerCall, mDims.row - row);
+                    const six::UByte* input =
+                            &image[row * mDims.col * bytesPerPixel];
+                    if (provider.isBlocked())
+                    {
+                        const std::auto_ptr<const nitf::ImageBlocker> blocker =
+                                provider.getImageBlocker();
+                        blocked.resize(blocker->getNumBytesRequired(
+                                row, numRows, bytesPerPixel));
+                        blocker->block(input, row, numRows, &blocked[0]);
+                        input = &blocked[0];
+                    }
+
+                    nitf::NITFBufferList buffers;
+                    nitf::Off fileOffset;
+                    provider.getBytes(input, row, numRows, fileOffset,
+                                      buffers);
+                    outStream.seek(fileOffset, io::Seekable::START);
+                    for (size_t ii = 0; ii < buffers.mBuffers.size(); ++ii)
+                    {
+                        outStream.write(static_cast<const sys::byte*>(
+                                                buffers.mBuffers[ii].mData),
+                                        buffers.mBuffers[ii].mNumBytes);
+                    }
+                }
+                outStream.close();
+            });
+            removeIfExists(stripPathname);
+        }
+
+        if (saved)
+        {
+            timeReads(product, *data, pathname, bytesPerPixel);
+        }
+        removeIfExists(pathname);
+    }
+
+private:
+    void timeReads(const Product& product,
+                   const six::Data& data,
+                   const std::string& pathname,
+                   size_t bytesPerPixel)
+    {
+        time(product.name, "NITFReadControl::load", 0, [&]()
+        {
+            six::NITFReadControl reader;
+            reader.load(pathname, mSchemaPaths);
+        });
+
+        six::NITFReadControl reader;
+        try
+        {
+            reader.load(pathname, mSchemaPaths);
+        }
+        catch (const except::Exception&)
+        {
+            // Already reported by the load stage
+            return;
+        }
+
+        std::vector<six::UByte> buffer(mDims.area() * bytesPerPixel);
+        time(product.name, "interleaved full", buffer.size(), [&]()
+        {
+            read(reader, types::RowCol<size_t>(0, 0), mDims, &buffer[0]);
+        });
+
+        const types::RowCol<size_t> window(std::max<size_t>(mDims.row / 2, 1),
+                                           std::max<size_t>(mDims.col / 2, 1));
+        time(product.name, "interleaved window",
+             window.area() * bytesPerPixel, [&]()
+        {
+            read(reader, types::RowCol<size_t>(mDims.row / 4, mDims.col / 4),
+                 window, &buffer[0]);
+        });
+
+        // The same tiles for every product
+        const types::RowCol<size_t> tile(std::min(mTileSize, mDims.row),
+                                         std::min(mTileSize, mDims.col));
+        std::vector<types::RowCol<size_t> > offsets(mNumTiles);
+        srand(1);
+        for (size_t ii = 0; ii < offsets.size(); ++ii)
+        {
+            offsets[ii].row = rand() % (mDims.row - tile.row + 1);
+            offsets[ii].col = rand() % (mDims.col - tile.col + 1);
+        }
+        size_t tileNum = 0;
+        time(product.name, "interleaved tile", tile.area() * bytesPerPixel,
+             [&]()
+        {
+            read(reader, offsets[tileNum++], tile, &buffer[0]);
+        }, offsets.size());
+
+        if (product.dataType == six::DataType::COMPLEX)
+        {
+            std::vector<std::complex<float> > wideband(mDims.area());
+            time(product.name, "Utilities::getWidebandData",
+                 wideband.size() * sizeof(std::complex<float>), [&]()
+            {
+                six::sicd::Utilities::getWidebandData(
+                        reader,
+                        dynamic_cast<const six::sicd::ComplexData&>(data),
+                        &wideband[0]);
+            });
+        }
+    }
+
+    static void read(six::NITFReadControl& reader,
+                     const types::RowCol<size_t>& offset,
+                     const types::RowCol<size_t>& dims,
+                     six::UByte* buffer)
+    {
+        six::Region region;
+        region.setStartRow(offset.row);
+        region.setStartCol(offset.col);
+        region.setNumRows(dims.row);
+        region.setNumCols(dims.col);
+        region.setBuffer(buffer);
+        reader.interleaved(region, 0);
+    }
+
+    static void removeIfExists(const std::string& pathname)
+    {
+        sys::OS os;
+        if (os.exists(pathname))
+        {
+            os.remove(pathname);
+        }
+    }
+
+    // Times op numIter times, or the given number of times, and records
+    // it.  Returns false if op threw.
+    template <typename OpT>
+    bool time(const std::string& product,
+              const std::string& stage,
+              size_t numBytes,
+              const OpT& op,
+              size_t numIter = 0)
+    {
+        Result result;
+        result.product = product;
+        result.stage = stage;
+        result.numBytes = numBytes;
+        sys::RealTimeStopWatch sw;
+        try
+        {
+            for (size_t iter = 0; iter < (numIter ? numIter : mNumIter);
+                 ++iter)
+            {
+                sw.clear();
+                sw.start();
+                op();
+                result.latencies.add(sw.stop());
+            }
+        }
+        catch (const except::Exception& ex)
+        {
+            result.error = ex.getMessage();
+        }
+        catch (const std::exception& ex)
+        {
+            result.error = ex.what();
+        }
+        mResults.push_back(result);
+        return result.error.empty();
+    }
+
+    const std::vector<std::string>& mSchemaPaths;
+    const types::RowCol<size_t> mDims;
+    const size_t mNumIter;
+    const size_t mNumTiles;
+    const size_t mTileSize;
+    const std::string mDirectory;
+    std::vector<Result>& mResults;
+};
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        cli::ArgumentParser parser;
+        parser.setDescription(
+                "Times writing and reading synthetic SICDs and SIDDs and "
+                "prints the results as JSON");
+        parser.addArgument("-r --rows", "Number of rows", cli::STORE, "rows",
+                           "NUM")->setDefault(2048);
+        parser.addArgument("-c --cols", "Number of columns", cli::STORE,
+                           "cols", "NUM")->setDefault(2048);
+        parser.addArgument("-i --iterations", "Number of times to repeat "
+                           "each stage", cli::STORE, "iterations",
+                           "NUM")->setDefault(5);
+        parser.addArgument("--tiles", "Number of random tiles to read",
+                           cli::STORE, "tiles", "NUM")->setDefault(100);
+        parser.addArgument("--tile-size", "Rows and columns of each tile",
+                           cli::STORE, "tileSize", "NUM")->setDefault(256);
+        parser.addArgument("-p --product", "Only time products whose name "
+                           "contains this, e.g. SICD or MONO8I", cli::STORE,
+                           "product", "NAME");
+        parser.addArgument("-d --dir", "Directory to write files in",
+                           cli::STORE, "dir", "DIR")->setDefault(".");
+        parser.addArgument("--instrument", "Print the instrumentation "
+                           "totals to standard error", cli::STORE_TRUE,
+                           "instrument");
+        parser.addArgument("-s --schema",
+                           "Specify a schema or directory of schemas",
+                           cli::STORE, "schema", "FILE");
+        parser.addArgument("-o --output", "Write the JSON here instead of "
+                           "to standard output", cli::STORE, "output",
+                           "JSON");
+        const std::auto_ptr<cli::Results> options(parser.parse(argc, argv));
+
+        six::Instrumentation::enable(options->get<bool>("instrument"));
+
+        std::vector<std::string> schemaPaths;
+        if (options->hasValue("schema"))
+        {
+            schemaPaths.push_back(options->get<std::string>("schema"));
+        }
+        const types::RowCol<size_t> dims(
+                std::max<size_t>(options->get<size_t>("rows"), 1),
+                std::max<size_t>(options->get<size_t>("cols"), 1));
+        const size_t numIter =
+                std::max<size_t>(options->get<size_t>("iterations"), 1);
+        const size_t numTiles = options->get<size_t>("tiles");
+        const size_t tileSize =
+                std::max<size_t>(options->get<size_t>("tileSize"), 1);
+
+        six::XMLControlFactory::getInstance().addCreator(
+                six::DataType::COMPLEX,
+                new six::XMLControlCreatorT<six::sicd::ComplexXMLControl>());
+        six::XMLControlFactory::getInstance().addCreator(
+                six::DataType::DERIVED,
+                new six::XMLControlCreatorT<six::sidd::DerivedXMLControl>());
+
+        std::vector<Result> results;
+        Benchmark benchmark(schemaPaths, dims, numIter, numTiles, tileSize,
+                            options->get<std::string>("dir"), results);
+        const std::vector<Product> products = getProducts();
+        for (size_t ii = 0; ii < products.size(); ++ii)
+        {
+            if (!options->hasValue("product") ||
+                products[ii].name.find(options->get<std::string>(
+                        "product")) != std::string::npos)
+            {
+                benchmark.run(products[ii]);
+            }
+        }
+
+        if (options->hasValue("output"))
+        {
+            std::ofstream os(options->get<std::string>("output").c_str());
+            writeJSON(dims, numIter, numTiles, tileSize, results, os);
+        }
+        else
+        {
+            writeJSON(dims, numIter, numTiles, tileSize, results, std::cout);
+        }
+
+        if (options->get<bool>("instrument"))
+        {
+            std::cerr << six::Instrumentation::snapshot();
+        }
+        return 0;
+    }
+    catch (const except::Exception& ex)
+    {
+        std::cerr << ex.toString() << "\n";
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << ex.what() << "\n";
+    }
+    catch (...)
+    {
+        std::cerr << "An unknown exception occured\n";
+    }
+    return 1;
+}
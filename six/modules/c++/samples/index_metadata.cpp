@@ -0,0 +1,176 @@
+/* =========================================================================
+ * This file is part of six-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ *
+ * six-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <iostream>
+
+#include <import/cli.h>
+#include <import/sys.h>
+#include <import/six/index.h>
+
+namespace
+{
+// Directories are searched recursively.  Anything that isn't a SICD, SIDD
+// or CPHD just gets a record with an error.
+std::vector<std::string> getPathnames(const cli::Value& inputs)
+{
+    const sys::OS os;
+    std::vector<std::string> pathnames;
+    for (size_t ii = 0; ii < inputs.size(); ++ii)
+    {
+        const std::string input = inputs.get<std::string>(ii);
+        if (os.isDirectory(input))
+        {
+            const std::vector<std::string> found =
+                    sys::FileFinder::search(sys::FileOnlyPredicate(),
+                                            std::vector<std::string>(1, input),
+                                            true);
+            pathnames.insert(pathnames.end(), found.begin(), found.end());
+        }
+        else
+        {
+            pathnames.push_back(input);
+        }
+    }
+    return pathnames;
+}
+
+void printRecord(const six::index::IndexRecord& record)
+{
+    std::cout << record.pathname << "\n";
+    if (!record.error.empty())
+    {
+        std::cout << "    Error: " << record.error << "\n";
+        return;
+    }
+
+    std::cout << "    Type: " << record.getFileTypeString() << "\n"
+              << "    Collector: " << record.collectorName << "\n"
+              << "    Collection start (ms): "
+              << std::fixed << record.collectionStart << "\n"
+              << "    Collection duration (s): "
+              << record.collectionDuration << "\n"
+              << "    Corners:";
+    for (size_t ii = 0; ii < record.corners.size(); ++ii)
+    {
+        std::cout << " (" << record.corners[ii].getLat() << ", "
+                  << record.corners[ii].getLon() << ")";
+    }
+    std::cout << "\n    Valid data points: " << record.validData.size()
+              << "\n    Polarizations:";
+    for (size_t ii = 0; ii < record.polarizations.size(); ++ii)
+    {
+        std::cout << " " << record.polarizations[ii];
+    }
+    std::cout << "\n";
+}
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        cli::ArgumentParser parser;
+        parser.setDescription(
+                "Indexes the footprints, times, collectors and "
+                "polarizations of SICD, SIDD and CPHD files.  Files that "
+                "are already current in the index are skipped.");
+        parser.addArgument("-t --threads",
+                           "Number of threads to read files with",
+                           cli::STORE, "threads", "NUM")->setDefault(
+                                   sys::OS().getNumCPUs());
+        parser.addArgument("--prune",
+                           "Drop records for files that no longer exist",
+                           cli::STORE_TRUE, "prune")->setDefault(false);
+        parser.addArgument("--print", "Print every record in the index",
+                           cli::STORE_TRUE, "print")->setDefault(false);
+        parser.addArgument("index", "Index file.  Created if it doesn't exist.",
+                           cli::STORE, "index", "INDEX", 1, 1);
+        parser.addArgument("input", "Input files or directories",
+                           cli::STORE, "input", "INPUT", 0);
+
+        const std::auto_ptr<cli::Results>
+            options(parser.parse(argc, (const char**) argv));
+
+        const std::string indexPathname(options->get<std::string>("index"));
+        const size_t numThreads(options->get<size_t>("threads"));
+
+        six::index::MetadataIndex index;
+        if (sys::OS().exists(indexPathname))
+        {
+            index.load(indexPathname);
+        }
+
+        std::vector<std::string> pathnames;
+        if (options->hasValue("input"))
+        {
+            pathnames = getPathnames(*options->getValue("input"));
+        }
+
+        const six::index::MetadataIndex::UpdateStats stats =
+                index.update(pathnames, numThreads);
+
+        const double seconds = std::max(stats.elapsedSeconds, 1e-6);
+        std::cout << "Indexed " << stats.numIndexed << " files ("
+                  << stats.numFailed << " failed), skipped "
+                  << stats.numSkipped << " unchanged files\n"
+                  << "Read " << stats.numBytes / (1024.0 * 1024.0)
+                  << " MB of files in " << stats.elapsedSeconds << " s: "
+                  << stats.numIndexed / seconds << " files/s\n";
+
+        if (options->get<bool>("prune"))
+        {
+            std::cout << "Pruned " << index.prune() << " records\n";
+        }
+
+        index.save(indexPathname);
+
+        if (options->get<bool>("print"))
+        {
+            const six::index::MetadataIndex::Records& records =
+                    index.getRecords();
+            for (six::index::MetadataIndex::Records::const_iterator iter =
+                         records.begin();
+                 iter != records.end();
+                 ++iter)
+            {
+                printRecord(iter->second);
+            }
+        }
+
+        return 0;
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+    catch (const except::Exception& ex)
+    {
+        std::cerr << ex.toString() << std::endl;
+        return 1;
+    }
+    catch (...)
+    {
+        std::cerr << "Unknown exception\n";
+        return 1;
+    }
+}
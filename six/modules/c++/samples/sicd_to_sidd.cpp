@@ -0,0 +1,104 @@
+/* =========================================================================
+ * This file is part of six-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*
+ * Forms a detected SIDD from a SICD, a band of rows at a time, so that
+ * arbitrarily large SICDs can be processed in bounded memory.
+ */
+
+#include <iostream>
+#include <memory>
+
+#include <cli/ArgumentParser.h>
+#include <cli/Results.h>
+#include <except/Exception.h>
+#include <sys/OS.h>
+#include <six/product/SIDDProductGenerator.h>
+#include "utils.h"
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        cli::ArgumentParser parser;
+        parser.setDescription("Reads a SICD, projects its detected image to "
+                              "the output plane, and writes it as a SIDD");
+        parser.addArgument("-s --schema",
+                           "Specify a schema or directory of schemas",
+                           cli::STORE);
+        parser.addArgument("--sixteen-bit",
+                           "Write MONO16I pixels rather than MONO8I",
+                           cli::STORE_TRUE,
+                           "sixteenBit")->setDefault(false);
+        parser.addArgument("-t --threads",
+                           "Specify the number of threads to use",
+                           cli::STORE,
+                           "threads",
+                           "NUM")->setDefault(sys::OS().getNumCPUs());
+        parser.addArgument("--max-band-mb",
+                           "Maximum slant plane memory to use per band (MB)",
+                           cli::STORE,
+                           "maxBandMB",
+                           "MB")->setDefault(256);
+        parser.addArgument("--clip-factor",
+                           "Multiple of the mean amplitude to saturate at",
+                           cli::STORE,
+                           "clipFactor",
+                           "FACTOR")->setDefault(
+                    six::product::SIDDProductGenerator::DEFAULT_CLIP_FACTOR);
+        parser.addArgument("input", "Input SICD pathname", cli::STORE,
+                           "input", "INPUT", 1, 1);
+        parser.addArgument("output", "Output SIDD pathname", cli::STORE,
+                           "output", "OUTPUT", 1, 1);
+
+        const std::auto_ptr<cli::Results> options(parser.parse(argc, argv));
+        std::vector<std::string> schemaPaths;
+        getSchemaPaths(*options, "--schema", "schema", schemaPaths);
+
+        const six::PixelType pixelType = options->get<bool>("sixteenBit") ?
+                six::PixelType::MONO16I : six::PixelType::MONO8I;
+
+        six::product::SIDDProductGenerator generator(
+                options->get<std::string>("input"),
+                schemaPaths,
+                pixelType,
+                options->get<size_t>("threads"),
+                options->get<size_t>("maxBandMB") * 1024 * 1024);
+        generator.setClipFactor(options->get<double>("clipFactor"));
+        generator.write(options->get<std::string>("output"));
+
+        return 0;
+    }
+    catch (const except::Exception& ex)
+    {
+        std::cerr << ex.toString() << std::endl;
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+    }
+    catch (...)
+    {
+        std::cerr << "An unknown error occured\n";
+    }
+    return 1;
+}
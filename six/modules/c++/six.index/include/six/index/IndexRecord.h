@@ -0,0 +1,124 @@
+/* =========================================================================
+ * This file is part of six.index-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six.index-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef __SIX_INDEX_INDEX_RECORD_H__
+#define __SIX_INDEX_INDEX_RECORD_H__
+
+#include <string>
+#include <vector>
+
+#include <sys/Conf.h>
+#include <six/Types.h>
+
+namespace six
+{
+namespace index
+{
+/*!
+ * \struct IndexRecord
+ * \brief What the index knows about one SICD, SIDD or CPHD file
+ *
+ * The file's size and modification time are stored so that a later run
+ * can tell whether the file has changed since it was indexed.
+ */
+struct IndexRecord
+{
+    //! Kind of file that was indexed
+    enum FileType
+    {
+        UNKNOWN = 0,
+        SICD,
+        SIDD,
+        CPHD
+    };
+
+    IndexRecord();
+
+    //! \return The file type as a string ("SICD", "SIDD", "CPHD" or "")
+    std::string getFileTypeString() const;
+
+    /*!
+     * Appends the record to a buffer, in big endian byte order
+     *
+     * \param[out] buffer Buffer to append to
+     */
+    void serialize(std::vector<sys::byte>& buffer) const;
+
+    /*!
+     * Reads a record written by serialize()
+     *
+     * \param buffer Serialized data.  Advanced past the record.
+     */
+    void deserialize(const sys::byte*& buffer);
+
+    bool operator==(const IndexRecord& rhs) const;
+
+    bool operator!=(const IndexRecord& rhs) const
+    {
+        return !(*this == rhs);
+    }
+
+    //! Pathname the file was indexed under
+    std::string pathname;
+
+    //! File size in bytes when it was indexed
+    sys::Off_T fileSize;
+
+    //! Modification time (ms since the epoch) when it was indexed
+    sys::Off_T lastModified;
+
+    //! UNKNOWN if the file couldn't be indexed
+    FileType fileType;
+
+    //! Why the file couldn't be indexed.  Empty on success.
+    std::string error;
+
+    /*!
+     * Collector name from the SICD CollectionInfo, the SIDD's first
+     * collection, or the CPHD CollectionID
+     */
+    std::string collectorName;
+
+    //! Collection start (ms since the epoch)
+    double collectionStart;
+
+    //! Collection duration in seconds
+    double collectionDuration;
+
+    /*!
+     * Image corners (SICD and SIDD) or image area corners (CPHD), in
+     * the usual order starting at the first row and column
+     */
+    std::vector<LatLon> corners;
+
+    //! Valid data polygon.  Empty if there is none (or for CPHD).
+    std::vector<LatLon> validData;
+
+    /*!
+     * Transmit and receive polarizations of each channel, each as
+     * "TX:RCV" (e.g. "V:V")
+     */
+    std::vector<std::string> polarizations;
+};
+}
+}
+
+#endif
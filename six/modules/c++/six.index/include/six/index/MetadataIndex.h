@@ -0,0 +1,158 @@
+/* =========================================================================
+ * This file is part of six.index-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six.index-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef __SIX_INDEX_METADATA_INDEX_H__
+#define __SIX_INDEX_METADATA_INDEX_H__
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <sys/Conf.h>
+#include <six/index/IndexRecord.h>
+
+namespace six
+{
+namespace index
+{
+/*!
+ * \class MetadataIndex
+ * \brief Footprints, times, collectors and polarizations of a set of SICD,
+ * SIDD and CPHD files
+ *
+ * Files are indexed with NITFMetadataReader and CPHDMetadataReader, so only
+ * the file headers and XML are read.  Records are keyed by pathname and
+ * remember the file's size and modification time, so update() only reads
+ * files that are new or have changed since the index was saved.
+ */
+class MetadataIndex
+{
+public:
+    //! What happened during an update()
+    struct UpdateStats
+    {
+        UpdateStats();
+
+        //! Files that were read
+        size_t numIndexed;
+
+        //! Files whose records were current, so weren't read
+        size_t numSkipped;
+
+        //! Files that were read but couldn't be indexed
+        size_t numFailed;
+
+        //! Bytes actually read (file headers, subheaders and XML)
+        sys::Off_T numBytes;
+
+        //! Wall clock time spent reading files, in seconds
+        double elapsedSeconds;
+    };
+
+    typedef std::map<std::string, IndexRecord> Records;
+
+    //! Creates an empty index
+    MetadataIndex();
+
+    /*!
+     * Reads an index written by save()
+     *
+     * \param pathname Index pathname
+     */
+    explicit MetadataIndex(const std::string& pathname);
+
+    /*!
+     * Replaces the contents of the index with ones written by save()
+     *
+     * \param pathname Index pathname
+     */
+    void load(const std::string& pathname);
+
+    /*!
+     * Writes the index.  The file is written alongside the destination and
+     * then renamed over it, so an interrupted save leaves the old index.
+     *
+     * \param pathname Index pathname
+     */
+    void save(const std::string& pathname) const;
+
+    /*!
+     * Indexes any of the files that aren't already current in the index.
+     * A file that can't be read or isn't a SICD, SIDD or CPHD still gets a
+     * record (with its error set) so it isn't retried until it changes.
+     *
+     * \param pathnames Files to index
+     * \param numThreads Number of threads to read with.  If 0, one per CPU.
+     *
+     * \return What was done
+     */
+    UpdateStats update(const std::vector<std::string>& pathnames,
+                       size_t numThreads = 0);
+
+    /*!
+     * Drops records for files that no longer exist
+     *
+     * \return Number of records dropped
+     */
+    size_t prune();
+
+    /*!
+     * Reads one file's metadata
+     *
+     * \param pathname File to index
+     *
+     * \return The record.  If the file can't be indexed, the error is set
+     * rather than an exception being thrown.
+     */
+    static IndexRecord indexFile(const std::string& pathname);
+
+    /*!
+     * Reads one file's metadata
+     *
+     * \param pathname File to index
+     * \param[out] numBytesRead Number of bytes read from the file
+     *
+     * \return The record.  If the file can't be indexed, the error is set
+     * rather than an exception being thrown.
+     */
+    static IndexRecord indexFile(const std::string& pathname,
+                                 sys::Off_T& numBytesRead);
+
+    //! \return Record for a pathname, or NULL if it isn't in the index
+    const IndexRecord* find(const std::string& pathname) const;
+
+    const Records& getRecords() const
+    {
+        return mRecords;
+    }
+
+    size_t size() const
+    {
+        return mRecords.size();
+    }
+
+private:
+    Records mRecords;
+};
+}
+}
+
+#endif
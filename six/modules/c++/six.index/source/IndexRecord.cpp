@@ -0,0 +1,138 @@
+/* =========================================================================
+ * This file is part of six.index-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six.index-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <sys/Conf.h>
+#include <six/Serialize.h>
+#include <six/index/IndexRecord.h>
+
+namespace
+{
+// The index is always big endian on disk
+const bool SWAP_BYTES = !sys::isBigEndianSystem();
+
+void serializeLatLons(const std::vector<six::LatLon>& latLons,
+                      std::vector<sys::byte>& buffer)
+{
+    six::serialize(latLons.size(), SWAP_BYTES, buffer);
+    for (size_t ii = 0; ii < latLons.size(); ++ii)
+    {
+        six::serialize(latLons[ii].getLat(), SWAP_BYTES, buffer);
+        six::serialize(latLons[ii].getLon(), SWAP_BYTES, buffer);
+    }
+}
+
+void deserializeLatLons(const sys::byte*& buffer,
+                        std::vector<six::LatLon>& latLons)
+{
+    size_t numLatLons;
+    six::deserialize(buffer, SWAP_BYTES, numLatLons);
+    latLons.resize(numLatLons);
+    for (size_t ii = 0; ii < numLatLons; ++ii)
+    {
+        double lat;
+        double lon;
+        six::deserialize(buffer, SWAP_BYTES, lat);
+        six::deserialize(buffer, SWAP_BYTES, lon);
+        latLons[ii] = six::LatLon(lat, lon);
+    }
+}
+}
+
+namespace six
+{
+namespace index
+{
+IndexRecord::IndexRecord() :
+    fileSize(0),
+    lastModified(0),
+    fileType(UNKNOWN),
+    collectionStart(0),
+    collectionDuration(0)
+{
+}
+
+std::string IndexRecord::getFileTypeString() const
+{
+    switch (fileType)
+    {
+    case SICD:
+        return "SICD";
+    case SIDD:
+        return "SIDD";
+    case CPHD:
+        return "CPHD";
+    default:
+        return "";
+    }
+}
+
+void IndexRecord::serialize(std::vector<sys::byte>& buffer) const
+{
+    six::serialize(pathname, SWAP_BYTES, buffer);
+    six::serialize(fileSize, SWAP_BYTES, buffer);
+    six::serialize(lastModified, SWAP_BYTES, buffer);
+    six::serialize(static_cast<sys::Int32_T>(fileType), SWAP_BYTES, buffer);
+    six::serialize(error, SWAP_BYTES, buffer);
+    six::serialize(collectorName, SWAP_BYTES, buffer);
+    six::serialize(collectionStart, SWAP_BYTES, buffer);
+    six::serialize(collectionDuration, SWAP_BYTES, buffer);
+    serializeLatLons(corners, buffer);
+    serializeLatLons(validData, buffer);
+    six::serialize(polarizations, SWAP_BYTES, buffer);
+}
+
+void IndexRecord::deserialize(const sys::byte*& buffer)
+{
+    six::deserialize(buffer, SWAP_BYTES, pathname);
+    six::deserialize(buffer, SWAP_BYTES, fileSize);
+    six::deserialize(buffer, SWAP_BYTES, lastModified);
+
+    sys::Int32_T type;
+    six::deserialize(buffer, SWAP_BYTES, type);
+    fileType = static_cast<FileType>(type);
+
+    six::deserialize(buffer, SWAP_BYTES, error);
+    six::deserialize(buffer, SWAP_BYTES, collectorName);
+    six::deserialize(buffer, SWAP_BYTES, collectionStart);
+    six::deserialize(buffer, SWAP_BYTES, collectionDuration);
+    deserializeLatLons(buffer, corners);
+    deserializeLatLons(buffer, validData);
+
+    polarizations.clear();
+    six::deserialize(buffer, SWAP_BYTES, polarizations);
+}
+
+bool IndexRecord::operator==(const IndexRecord& rhs) const
+{
+    return pathname == rhs.pathname &&
+            fileSize == rhs.fileSize &&
+            lastModified == rhs.lastModified &&
+            fileType == rhs.fileType &&
+            error == rhs.error &&
+            collectorName == rhs.collectorName &&
+            collectionStart == rhs.collectionStart &&
+            collectionDuration == rhs.collectionDuration &&
+            corners == rhs.corners &&
+            validData == rhs.validData &&
+            polarizations == rhs.polarizations;
+}
+}
+}
@@ -0,0 +1,688 @@
+/* =========================================================================
+ * This file is part of six.index-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six.index-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <algorithm>
+#include <cstring>
+#include <exception>
+
+#include <except/Exception.h>
+#include <io/FileInputStream.h>
+#include <io/FileOutputStream.h>
+#include <io/SeekableStreams.h>
+#include <mem/SharedPtr.h>
+#include <mt/ThreadGroup.h>
+#include <str/Convert.h>
+#include <sys/AtomicCounter.h>
+#include <sys/OS.h>
+#include <sys/Runnable.h>
+#include <sys/StopWatch.h>
+#include <xml/lite/Document.h>
+#include <six/NITFMetadataReader.h>
+#include <six/Serialize.h>
+#include <six/Utilities.h>
+#include <cphd/CPHDMetadataReader.h>
+#include <six/index/MetadataIndex.h>
+
+namespace
+{
+// Index file layout: magic, version, number of records, then each record
+// preceded by its size in bytes.  Everything is big endian.
+const char MAGIC[] = "SIXINDEX";
+const size_t MAGIC_LENGTH = sizeof(MAGIC) - 1;
+const sys::Uint32_T VERSION = 1;
+const bool SWAP_BYTES = !sys::isBigEndianSystem();
+
+std::vector<six::LatLon> toVector(const six::LatLonCorners& corners)
+{
+    std::vector<six::LatLon> latLons(six::LatLonCorners::NUM_CORNERS);
+    for (size_t ii = 0; ii < latLons.size(); ++ii)
+    {
+        latLons[ii] = corners.getCorner(ii);
+    }
+    return latLons;
+}
+
+/*
+ * Passes reads through to another stream, counting the bytes that were
+ * actually read
+ */
+class CountingInputStream : public io::SeekableInputStream
+{
+public:
+    explicit CountingInputStream(
+            mem::SharedPtr<io::SeekableInputStream> inStream) :
+        mInStream(inStream),
+        mNumBytesRead(0)
+    {
+    }
+
+    virtual sys::Off_T available()
+    {
+        return mInStream->available();
+    }
+
+    virtual sys::Off_T seek(sys::Off_T offset, Whence whence)
+    {
+        return mInStream->seek(offset, whence);
+    }
+
+    virtual sys::Off_T tell()
+    {
+        return mInStream->tell();
+    }
+
+    sys::Off_T getNumBytesRead() const
+    {
+        return mNumBytesRead;
+    }
+
+protected:
+    virtual sys::SSize_T readImpl(void* buffer, size_t len)
+    {
+        const sys::SSize_T numRead = mInStream->read(buffer, len);
+        if (numRead > 0)
+        {
+            mNumBytesRead += numRead;
+        }
+        return numRead;
+    }
+
+private:
+    const mem::SharedPtr<io::SeekableInputStream> mInStream;
+    sys::Off_T mNumBytesRead;
+};
+
+/*
+ * The index only needs a handful of fields, so rather than turning all of
+ * the XML into a Data object, only the top-level elements below are kept
+ * and the fields are read straight out of them
+ */
+const char* const SICD_ELEMENTS[] =
+{
+    "CollectionInfo", "Timeline", "GeoData", "RadarCollection"
+};
+const char* const SIDD_ELEMENTS[] =
+{
+    "ExploitationFeatures", "GeographicAndTarget"
+};
+
+const xml::lite::Element* getOptional(const xml::lite::Element& parent,
+                                      const std::string& name)
+{
+    const std::vector<xml::lite::Element*>& children = parent.getChildren();
+    for (size_t ii = 0; ii < children.size(); ++ii)
+    {
+        if (children[ii]->getLocalName() == name)
+        {
+            return children[ii];
+        }
+    }
+    return NULL;
+}
+
+const xml::lite::Element& getChild(const xml::lite::Element& parent,
+                                   const std::string& name)
+{
+    const xml::lite::Element* const child = getOptional(parent, name);
+    if (child == NULL)
+    {
+        throw except::Exception(Ctxt(
+                parent.getLocalName() + " has no " + name));
+    }
+    return *child;
+}
+
+std::vector<const xml::lite::Element*>
+getChildren(const xml::lite::Element& parent, const std::string& name)
+{
+    const std::vector<xml::lite::Element*>& children = parent.getChildren();
+    std::vector<const xml::lite::Element*> matches;
+    for (size_t ii = 0; ii < children.size(); ++ii)
+    {
+        if (children[ii]->getLocalName() == name)
+        {
+            matches.push_back(children[ii]);
+        }
+    }
+    return matches;
+}
+
+std::string getText(const xml::lite::Element& parent, const std::string& name)
+{
+    return getChild(parent, name).getCharacterData();
+}
+
+double getDouble(const xml::lite::Element& parent, const std::string& name)
+{
+    return str::toType<double>(getText(parent, name));
+}
+
+// Lat/Lon points, in the order they appear
+std::vector<six::LatLon> getLatLons(const xml::lite::Element& parent,
+                                    const std::string& pointName)
+{
+    const std::vector<const xml::lite::Element*> points =
+            getChildren(parent, pointName);
+    std::vector<six::LatLon> latLons;
+    for (size_t ii = 0; ii < points.size(); ++ii)
+    {
+        latLons.push_back(six::LatLon(getDouble(*points[ii], "Lat"),
+                                      getDouble(*points[ii], "Lon")));
+    }
+    return latLons;
+}
+
+// Corners are placed by their 1-based index attribute (e.g. "1:FRFC")
+std::vector<six::LatLon> getCorners(const xml::lite::Element& parent,
+                                    const std::string& pointName)
+{
+    const std::vector<const xml::lite::Element*> points =
+            getChildren(parent, pointName);
+    std::vector<six::LatLon> corners(six::LatLonCorners::NUM_CORNERS);
+    std::vector<bool> found(corners.size(), false);
+    for (size_t ii = 0; ii < points.size(); ++ii)
+    {
+        std::string index = points[ii]->getAttributes().getValue("index");
+        index = index.substr(0, index.find(':'));
+        const size_t corner = str::toType<size_t>(index) - 1;
+        if (corner >= corners.size())
+        {
+            throw except::Exception(Ctxt("Invalid corner index " + index));
+        }
+        corners[corner] = six::LatLon(getDouble(*points[ii], "Lat"),
+                                      getDouble(*points[ii], "Lon"));
+        found[corner] = true;
+    }
+
+    if (std::find(found.begin(), found.end(), false) != found.end())
+    {
+        throw except::Exception(Ctxt("Didn't get all expected corners"));
+    }
+    return corners;
+}
+
+double getCollectionStart(const xml::lite::Element& parent,
+                          const std::string& name)
+{
+    return six::toType<six::DateTime>(getText(parent, name)).getTimeInMillis();
+}
+
+void indexSICD(const xml::lite::Element& root,
+               six::index::IndexRecord& record)
+{
+    record.fileType = six::index::IndexRecord::SICD;
+    record.collectorName =
+            getText(getChild(root, "CollectionInfo"), "CollectorName");
+
+    const xml::lite::Element& timeline(getChild(root, "Timeline"));
+    record.collectionStart = getCollectionStart(timeline, "CollectStart");
+    record.collectionDuration = getDouble(timeline, "CollectDuration");
+
+    const xml::lite::Element& geoData(getChild(root, "GeoData"));
+    record.corners = getCorners(getChild(geoData, "ImageCorners"), "ICP");
+    const xml::lite::Element* const validData =
+            getOptional(geoData, "ValidData");
+    if (validData)
+    {
+        record.validData = getLatLons(*validData, "Vertex");
+    }
+
+    const xml::lite::Element& rcvChannels(
+            getChild(getChild(root, "RadarCollection"), "RcvChannels"));
+    const std::vector<const xml::lite::Element*> channels =
+            getChildren(rcvChannels, "ChanParameters");
+    for (size_t ii = 0; ii < channels.size(); ++ii)
+    {
+        record.polarizations.push_back(
+                getText(*channels[ii], "TxRcvPolarization"));
+    }
+}
+
+void indexSIDD(const xml::lite::Element& root,
+               six::index::IndexRecord& record)
+{
+    record.fileType = six::index::IndexRecord::SIDD;
+
+    // SIDD 2.0 has ImageCorners, SIDD 1.0 only the coverage footprint
+    const xml::lite::Element& geographicAndTarget(
+            getChild(root, "GeographicAndTarget"));
+    const xml::lite::Element* const imageCorners =
+            getOptional(geographicAndTarget, "ImageCorners");
+    if (imageCorners)
+    {
+        record.corners = getCorners(*imageCorners, "ICP");
+    }
+    else
+    {
+        record.corners = getCorners(
+                getChild(getChild(geographicAndTarget, "GeographicCoverage"),
+                         "Footprint"),
+                "Vertex");
+    }
+
+    const xml::lite::Element* const validData =
+            getOptional(geographicAndTarget, "ValidData");
+    if (validData)
+    {
+        record.validData = getLatLons(*validData, "Vertex");
+    }
+
+    // Only the first collection is indexed.  That's the collection that
+    // DerivedData::getSource() and getCollectionStartDateTime() use.
+    const xml::lite::Element& information(getChild(
+            getChild(getChild(root, "ExploitationFeatures"), "Collection"),
+            "Information"));
+    record.collectorName = getText(information, "SensorName");
+    record.collectionStart =
+            getCollectionStart(information, "CollectionDateTime");
+    if (getOptional(information, "CollectionDuration"))
+    {
+        record.collectionDuration =
+                getDouble(information, "CollectionDuration");
+    }
+
+    const std::vector<const xml::lite::Element*> polarizations =
+            getChildren(information, "Polarization");
+    for (size_t ii = 0; ii < polarizations.size(); ++ii)
+    {
+        record.polarizations.push_back(
+                getText(*polarizations[ii], "TxPolarization") + ":" +
+                getText(*polarizations[ii], "RcvPolarization"));
+    }
+}
+
+void indexNITF(mem::SharedPtr<io::SeekableInputStream> inStream,
+               six::index::IndexRecord& record)
+{
+    const six::NITFMetadataReader reader(inStream);
+    if (reader.getNumXML() == 0)
+    {
+        throw except::Exception(Ctxt("Not a SICD or SIDD"));
+    }
+
+    // For a SIDD with several products, the first one describes the file
+    if (reader.getDataType(0) == six::DataType::COMPLEX)
+    {
+        const std::vector<std::string> elementNames(
+                SICD_ELEMENTS,
+                SICD_ELEMENTS + sizeof(SICD_ELEMENTS) / sizeof(*SICD_ELEMENTS));
+        const std::auto_ptr<xml::lite::Document> doc(
+                reader.getXMLDocument(0, elementNames));
+        indexSICD(*doc->getRootElement(), record);
+    }
+    else
+    {
+        const std::vector<std::string> elementNames(
+                SIDD_ELEMENTS,
+                SIDD_ELEMENTS + sizeof(SIDD_ELEMENTS) / sizeof(*SIDD_ELEMENTS));
+        const std::auto_ptr<xml::lite::Document> doc(
+                reader.getXMLDocument(0, elementNames));
+        indexSIDD(*doc->getRootElement(), record);
+    }
+}
+
+void indexCPHD(mem::SharedPtr<io::SeekableInputStream> inStream,
+               six::index::IndexRecord& record)
+{
+    const cphd::CPHDMetadataReader reader(inStream);
+    const std::unique_ptr<cphd::Metadata> metadata(reader.getMetadata());
+
+    record.fileType = six::index::IndexRecord::CPHD;
+    record.collectorName = metadata->collectionID.collectorName;
+
+    const cphd::Timeline& timeline(metadata->global.timeline);
+    record.collectionStart = timeline.collectionStart.getTimeInMillis();
+    record.collectionDuration = timeline.txTime2 - timeline.txTime1;
+
+    record.corners = toVector(metadata->sceneCoordinates.imageAreaCorners);
+
+    const std::vector<cphd::ChannelParameter>& channels(
+            metadata->channel.parameters);
+    for (size_t ii = 0; ii < channels.size(); ++ii)
+    {
+        record.polarizations.push_back(
+                channels[ii].polarization.txPol.toString() + ":" +
+                channels[ii].polarization.rcvPol.toString());
+    }
+}
+
+class IndexFiles : public sys::Runnable
+{
+public:
+    IndexFiles(const std::vector<std::string>& pathnames,
+               sys::AtomicCounter& nextIndex,
+               std::vector<six::index::IndexRecord>& records,
+               std::vector<sys::Off_T>& numBytesRead) :
+        mPathnames(pathnames),
+        mNextIndex(nextIndex),
+        mRecords(records),
+        mNumBytesRead(numBytesRead)
+    {
+    }
+
+    virtual void run()
+    {
+        // Files vary a lot in size so hand them out one at a time rather
+        // than splitting the list up front
+        for (size_t ii = mNextIndex.getThenIncrement();
+             ii < mPathnames.size();
+             ii = mNextIndex.getThenIncrement())
+        {
+            mRecords[ii] = six::index::MetadataIndex::indexFile(
+                    mPathnames[ii], mNumBytesRead[ii]);
+        }
+    }
+
+private:
+    const std::vector<std::string>& mPathnames;
+    sys::AtomicCounter& mNextIndex;
+    std::vector<six::index::IndexRecord>& mRecords;
+    std::vector<sys::Off_T>& mNumBytesRead;
+};
+}
+
+namespace six
+{
+namespace index
+{
+MetadataIndex::UpdateStats::UpdateStats() :
+    numIndexed(0),
+    numSkipped(0),
+    numFailed(0),
+    numBytes(0),
+    elapsedSeconds(0)
+{
+}
+
+MetadataIndex::MetadataIndex()
+{
+}
+
+MetadataIndex::MetadataIndex(const std::string& pathname)
+{
+    load(pathname);
+}
+
+void MetadataIndex::load(const std::string& pathname)
+{
+    io::FileInputStream inStream(pathname);
+    const size_t fileSize = static_cast<size_t>(inStream.available());
+
+    std::vector<sys::byte> buffer(fileSize);
+    if (fileSize != 0)
+    {
+        inStream.read(&buffer[0], fileSize, true);
+    }
+    inStream.close();
+
+    const size_t headerLength = MAGIC_LENGTH + sizeof(sys::Uint32_T) +
+            sizeof(sys::Uint64_T);
+    if (fileSize < headerLength ||
+        std::memcmp(&buffer[0], MAGIC, MAGIC_LENGTH) != 0)
+    {
+        throw except::Exception(Ctxt(pathname + " is not a metadata index"));
+    }
+
+    const sys::byte* ptr = &buffer[MAGIC_LENGTH];
+    const sys::byte* const end = &buffer[0] + fileSize;
+
+    sys::Uint32_T version;
+    six::deserialize(ptr, SWAP_BYTES, version);
+    if (version != VERSION)
+    {
+        throw except::Exception(Ctxt(
+                "Unsupported metadata index version " +
+                str::toString(version)));
+    }
+
+    sys::Uint64_T numRecords;
+    six::deserialize(ptr, SWAP_BYTES, numRecords);
+
+    Records records;
+    for (sys::Uint64_T ii = 0; ii < numRecords; ++ii)
+    {
+        sys::Uint64_T recordLength = 0;
+        if (static_cast<size_t>(end - ptr) >= sizeof(recordLength))
+        {
+            six::deserialize(ptr, SWAP_BYTES, recordLength);
+        }
+        if (recordLength == 0 ||
+            recordLength > static_cast<sys::Uint64_T>(end - ptr))
+        {
+            throw except::Exception(Ctxt(pathname + " is truncated"));
+        }
+
+        const sys::byte* const recordEnd = ptr + recordLength;
+        IndexRecord record;
+        record.deserialize(ptr);
+        if (ptr != recordEnd)
+        {
+            throw except::Exception(Ctxt(pathname + " is corrupt"));
+        }
+        records[record.pathname] = record;
+    }
+
+    mRecords.swap(records);
+}
+
+void MetadataIndex::save(const std::string& pathname) const
+{
+    std::vector<sys::byte> buffer(MAGIC, MAGIC + MAGIC_LENGTH);
+    six::serialize(VERSION, SWAP_BYTES, buffer);
+    six::serialize(static_cast<sys::Uint64_T>(mRecords.size()),
+                   SWAP_BYTES, buffer);
+
+    std::vector<sys::byte> recordBuffer;
+    for (Records::const_iterator iter = mRecords.begin();
+         iter != mRecords.end();
+         ++iter)
+    {
+        recordBuffer.clear();
+        iter->second.serialize(recordBuffer);
+        six::serialize(static_cast<sys::Uint64_T>(recordBuffer.size()),
+                       SWAP_BYTES, buffer);
+        buffer.insert(buffer.end(), recordBuffer.begin(), recordBuffer.end());
+    }
+
+    const std::string tempPathname = pathname + ".tmp";
+    io::FileOutputStream outStream(tempPathname);
+    outStream.write(&buffer[0], buffer.size());
+    outStream.close();
+
+    if (!sys::OS().move(tempPathname, pathname))
+    {
+        throw except::Exception(Ctxt(
+                "Unable to move " + tempPathname + " to " + pathname));
+    }
+}
+
+MetadataIndex::UpdateStats
+MetadataIndex::update(const std::vector<std::string>& pathnames,
+                      size_t numThreads)
+{
+    UpdateStats stats;
+    sys::RealTimeStopWatch stopWatch;
+    stopWatch.start();
+
+    // Only files that are new or have changed need to be read
+    const sys::OS os;
+    std::vector<std::string> toIndex;
+    for (size_t ii = 0; ii < pathnames.size(); ++ii)
+    {
+        const IndexRecord* const record = find(pathnames[ii]);
+        if (record && os.exists(pathnames[ii]) &&
+            record->fileSize == os.getSize(pathnames[ii]) &&
+            record->lastModified == os.getLastModifiedTime(pathnames[ii]))
+        {
+            ++stats.numSkipped;
+        }
+        else
+        {
+            toIndex.push_back(pathnames[ii]);
+        }
+    }
+
+    // The same file listed twice only needs to be read once
+    std::sort(toIndex.begin(), toIndex.end());
+    toIndex.erase(std::unique(toIndex.begin(), toIndex.end()),
+                  toIndex.end());
+
+    if (numThreads == 0)
+    {
+        numThreads = os.getNumCPUs();
+    }
+    numThreads = std::max<size_t>(std::min(numThreads, toIndex.size()), 1);
+
+    std::vector<IndexRecord> records(toIndex.size());
+    std::vector<sys::Off_T> numBytesRead(toIndex.size());
+    sys::AtomicCounter nextIndex;
+    if (numThreads == 1)
+    {
+        IndexFiles(toIndex, nextIndex, records, numBytesRead).run();
+    }
+    else
+    {
+        mt::ThreadGroup threads;
+        for (size_t ii = 0; ii < numThreads; ++ii)
+        {
+            threads.createThread(new IndexFiles(toIndex, nextIndex, records,
+                                                numBytesRead));
+        }
+        threads.joinAll();
+    }
+
+    for (size_t ii = 0; ii < records.size(); ++ii)
+    {
+        ++stats.numIndexed;
+        stats.numBytes += numBytesRead[ii];
+        if (!records[ii].error.empty())
+        {
+            ++stats.numFailed;
+        }
+        mRecords[records[ii].pathname] = records[ii];
+    }
+
+    stats.elapsedSeconds = stopWatch.stop() / 1000.0;
+    return stats;
+}
+
+size_t MetadataIndex::prune()
+{
+    const sys::OS os;
+    size_t numPruned = 0;
+    for (Records::iterator iter = mRecords.begin(); iter != mRecords.end();)
+    {
+        if (os.exists(iter->first))
+        {
+            ++iter;
+        }
+        else
+        {
+            mRecords.erase(iter++);
+            ++numPruned;
+        }
+    }
+    return numPruned;
+}
+
+IndexRecord MetadataIndex::indexFile(const std::string& pathname)
+{
+    sys::Off_T numBytesRead;
+    return indexFile(pathname, numBytesRead);
+}
+
+IndexRecord MetadataIndex::indexFile(const std::string& pathname,
+                                     sys::Off_T& numBytesRead)
+{
+    IndexRecord record;
+    record.pathname = pathname;
+
+    mem::SharedPtr<CountingInputStream> countingStream;
+    try
+    {
+        const sys::OS os;
+        record.fileSize = os.getSize(pathname);
+        record.lastModified = os.getLastModifiedTime(pathname);
+
+        // Only the headers and XML are read, so count what that comes to
+        // rather than the file size
+        countingStream.reset(new CountingInputStream(
+                mem::SharedPtr<io::SeekableInputStream>(
+                        new io::FileInputStream(pathname))));
+        const mem::SharedPtr<io::SeekableInputStream> inStream(
+                countingStream);
+
+        char magic[4];
+        if (record.fileSize < static_cast<sys::Off_T>(sizeof(magic)))
+        {
+            throw except::Exception(Ctxt("Not a NITF or CPHD"));
+        }
+        inStream->read(magic, sizeof(magic), true);
+        inStream->seek(0, io::Seekable::START);
+
+        const std::string fileType(magic, sizeof(magic));
+        if (fileType == "NITF" || fileType == "NSIF")
+        {
+            indexNITF(inStream, record);
+        }
+        else if (fileType == "CPHD")
+        {
+            indexCPHD(inStream, record);
+        }
+        else
+        {
+            throw except::Exception(Ctxt("Not a NITF or CPHD"));
+        }
+    }
+    catch (const except::Exception& ex)
+    {
+        record.error = ex.getMessage();
+    }
+    catch (const std::exception& ex)
+    {
+        record.error = ex.what();
+    }
+
+    numBytesRead = countingStream.get() ?
+            countingStream->getNumBytesRead() : 0;
+
+    if (!record.error.empty())
+    {
+        // Keep the size and time so the file isn't retried until it changes,
+        // but nothing that was only partly filled in
+        IndexRecord failed;
+        failed.pathname = record.pathname;
+        failed.fileSize = record.fileSize;
+        failed.lastModified = record.lastModified;
+        failed.error = record.error;
+        record = failed;
+    }
+
+    return record;
+}
+
+const IndexRecord* MetadataIndex::find(const std::string& pathname) const
+{
+    const Records::const_iterator iter = mRecords.find(pathname);
+    return (iter == mRecords.end()) ? NULL : &iter->second;
+}
+}
+}
@@ -0,0 +1,262 @@
+/* =========================================================================
+ * This file is part of six.index-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ *
+ * six.index-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <string>
+#include <vector>
+
+#include <io/FileOutputStream.h>
+#include <io/TempFile.h>
+#include <mem/SharedPtr.h>
+#include <six/NITFWriteControl.h>
+#include <six/sicd/ComplexXMLControl.h>
+#include <six/sicd/Utilities.h>
+#include <six/sidd/DerivedXMLControl.h>
+#include <six/sidd/Utilities.h>
+#include <six/index/MetadataIndex.h>
+#include "TestCase.h"
+
+namespace
+{
+/*
+ * Writes out a SIDD and a file that isn't a SICD, SIDD or CPHD
+ */
+struct TestHelper
+{
+    TestHelper() :
+        mData(six::sidd::Utilities::createFakeDerivedData().release())
+    {
+        mData->setNumRows(10);
+        mData->setNumCols(20);
+        mData->setPixelType(six::PixelType::MONO8I);
+
+        six::XMLControlRegistry xmlRegistry;
+        xmlRegistry.addCreator(
+                six::DataType::DERIVED,
+                new six::XMLControlCreatorT<six::sidd::DerivedXMLControl>());
+
+        mem::SharedPtr<six::Container> container(
+                new six::Container(six::DataType::DERIVED));
+        container->addData(mData->clone());
+
+        const std::vector<six::UByte> image(
+                mData->getNumRows() * mData->getNumCols());
+        six::NITFWriteControl writer(six::Options(), container, &xmlRegistry);
+        writer.save(six::BufferList(1, &image[0]), mSIDD.pathname(),
+                    std::vector<std::string>());
+
+        io::FileOutputStream outStream(mOther.pathname());
+        outStream.write("Not a NITF");
+        outStream.close();
+
+        mPathnames.push_back(mSIDD.pathname());
+        mPathnames.push_back(mOther.pathname());
+    }
+
+    io::TempFile mSIDD;
+    io::TempFile mOther;
+    io::TempFile mIndex;
+    std::vector<std::string> mPathnames;
+    const std::auto_ptr<six::Data> mData;
+};
+
+TEST_CASE(testUpdate)
+{
+    TestHelper helper;
+    six::index::MetadataIndex index;
+
+    // Listing a file twice shouldn't read it twice
+    std::vector<std::string> pathnames(helper.mPathnames);
+    pathnames.push_back(helper.mSIDD.pathname());
+
+    const six::index::MetadataIndex::UpdateStats stats =
+            index.update(pathnames, 2);
+    TEST_ASSERT_EQ(stats.numIndexed, static_cast<size_t>(2));
+    TEST_ASSERT_EQ(stats.numSkipped, static_cast<size_t>(0));
+    TEST_ASSERT_EQ(stats.numFailed, static_cast<size_t>(1));
+    TEST_ASSERT_EQ(index.size(), static_cast<size_t>(2));
+
+    const six::index::IndexRecord* const sidd =
+            index.find(helper.mSIDD.pathname());
+    TEST_ASSERT(sidd != NULL);
+    TEST_ASSERT_EQ(sidd->error, "");
+    TEST_ASSERT_EQ(sidd->fileType, six::index::IndexRecord::SIDD);
+    TEST_ASSERT_EQ(sidd->fileSize, sys::OS().getSize(helper.mSIDD.pathname()));
+    TEST_ASSERT_EQ(sidd->collectorName, helper.mData->getSource());
+    TEST_ASSERT_EQ(sidd->collectionStart,
+                   helper.mData->getCollectionStartDateTime().getTimeInMillis());
+    const six::sidd::DerivedData& derived =
+            static_cast<const six::sidd::DerivedData&>(*helper.mData);
+    TEST_ASSERT_EQ(sidd->collectionDuration,
+                   derived.exploitationFeatures->collections[0]->
+                           information.collectionDuration);
+
+    const six::LatLonCorners corners = helper.mData->getImageCorners();
+    TEST_ASSERT_EQ(sidd->corners.size(), static_cast<size_t>(4));
+    for (size_t ii = 0; ii < sidd->corners.size(); ++ii)
+    {
+        TEST_ASSERT_TRUE(sidd->corners[ii] == corners.getCorner(ii));
+    }
+
+    const six::index::IndexRecord* const other =
+            index.find(helper.mOther.pathname());
+    TEST_ASSERT(other != NULL);
+    TEST_ASSERT_EQ(other->fileType, six::index::IndexRecord::UNKNOWN);
+    TEST_ASSERT_TRUE(!other->error.empty());
+
+    TEST_ASSERT(index.find("missing") == NULL);
+
+    // Only the headers and XML are read, not the pixels
+    TEST_ASSERT_GREATER(stats.numBytes, static_cast<sys::Off_T>(0));
+    TEST_ASSERT_LESSER(stats.numBytes, sidd->fileSize + other->fileSize);
+}
+
+TEST_CASE(testSICD)
+{
+    std::auto_ptr<six::sicd::ComplexData> data(
+            six::sicd::Utilities::createFakeComplexData());
+    data->setNumRows(10);
+    data->setNumCols(20);
+    data->setPixelType(six::PixelType::RE32F_IM32F);
+    data->collectionInformation->collectorName = "Collector";
+    data->timeline->collectDuration = 2.5;
+    data->radarCollection->rcvChannels.resize(2);
+    data->radarCollection->rcvChannels[0].reset(
+            new six::sicd::ChannelParameters());
+    data->radarCollection->rcvChannels[0]->txRcvPolarization =
+            six::DualPolarizationType::V_V;
+    data->radarCollection->rcvChannels[1].reset(
+            new six::sicd::ChannelParameters());
+    data->radarCollection->rcvChannels[1]->txRcvPolarization =
+            six::DualPolarizationType::V_H;
+    data->geoData->validData.resize(3);
+    for (size_t ii = 0; ii < data->geoData->validData.size(); ++ii)
+    {
+        data->geoData->validData[ii] = data->geoData->imageCorners.getCorner(ii);
+    }
+
+    six::XMLControlRegistry xmlRegistry;
+    xmlRegistry.addCreator(
+            six::DataType::COMPLEX,
+            new six::XMLControlCreatorT<six::sicd::ComplexXMLControl>());
+    mem::SharedPtr<six::Container> container(
+            new six::Container(six::DataType::COMPLEX));
+    container->addData(data->clone());
+
+    const std::vector<std::complex<float> > image(
+            data->getNumRows() * data->getNumCols());
+    io::TempFile sicd;
+    six::NITFWriteControl writer(six::Options(), container, &xmlRegistry);
+    writer.save(six::BufferList(1, reinterpret_cast<const six::UByte*>(
+                        &image[0])),
+                sicd.pathname(), std::vector<std::string>());
+
+    sys::Off_T numBytesRead;
+    const six::index::IndexRecord record =
+            six::index::MetadataIndex::indexFile(sicd.pathname(),
+                                                 numBytesRead);
+    TEST_ASSERT_EQ(record.error, "");
+    TEST_ASSERT_EQ(record.fileType, six::index::IndexRecord::SICD);
+    TEST_ASSERT_EQ(record.collectorName, "Collector");
+    TEST_ASSERT_EQ(record.collectionStart,
+                   data->getCollectionStartDateTime().getTimeInMillis());
+    TEST_ASSERT_EQ(record.collectionDuration, 2.5);
+    TEST_ASSERT_LESSER(numBytesRead, record.fileSize);
+
+    TEST_ASSERT_EQ(record.corners.size(), static_cast<size_t>(4));
+    for (size_t ii = 0; ii < record.corners.size(); ++ii)
+    {
+        TEST_ASSERT_TRUE(record.corners[ii] ==
+                         data->geoData->imageCorners.getCorner(ii));
+    }
+    TEST_ASSERT_TRUE(record.validData == data->geoData->validData);
+
+    TEST_ASSERT_EQ(record.polarizations.size(), static_cast<size_t>(2));
+    TEST_ASSERT_EQ(record.polarizations[0], "V:V");
+    TEST_ASSERT_EQ(record.polarizations[1], "V:H");
+}
+
+TEST_CASE(testSkipUnchanged)
+{
+    TestHelper helper;
+    six::index::MetadataIndex index;
+    index.update(helper.mPathnames, 1);
+
+    six::index::MetadataIndex::UpdateStats stats =
+            index.update(helper.mPathnames, 1);
+    TEST_ASSERT_EQ(stats.numIndexed, static_cast<size_t>(0));
+    TEST_ASSERT_EQ(stats.numSkipped, static_cast<size_t>(2));
+
+    // A file whose size changed is read again
+    io::FileOutputStream outStream(helper.mOther.pathname());
+    outStream.write("Still not a NITF");
+    outStream.close();
+
+    stats = index.update(helper.mPathnames, 1);
+    TEST_ASSERT_EQ(stats.numIndexed, static_cast<size_t>(1));
+    TEST_ASSERT_EQ(stats.numSkipped, static_cast<size_t>(1));
+    TEST_ASSERT_EQ(index.find(helper.mOther.pathname())->fileSize,
+                   static_cast<sys::Off_T>(16));
+}
+
+TEST_CASE(testSaveLoad)
+{
+    TestHelper helper;
+    six::index::MetadataIndex index;
+    index.update(helper.mPathnames, 1);
+    index.save(helper.mIndex.pathname());
+
+    const six::index::MetadataIndex loaded(helper.mIndex.pathname());
+    TEST_ASSERT_EQ(loaded.size(), index.size());
+    TEST_ASSERT_TRUE(loaded.getRecords() == index.getRecords());
+
+    // Loaded records are just as good for skipping unchanged files
+    six::index::MetadataIndex reloaded(helper.mIndex.pathname());
+    TEST_ASSERT_EQ(reloaded.update(helper.mPathnames, 1).numSkipped,
+                   static_cast<size_t>(2));
+
+    // Anything else is rejected
+    six::index::MetadataIndex other;
+    TEST_EXCEPTION(other.load(helper.mOther.pathname()));
+}
+
+TEST_CASE(testPrune)
+{
+    six::index::MetadataIndex index;
+    {
+        TestHelper helper;
+        index.update(helper.mPathnames, 1);
+    }
+    TEST_ASSERT_EQ(index.size(), static_cast<size_t>(2));
+    TEST_ASSERT_EQ(index.prune(), static_cast<size_t>(2));
+    TEST_ASSERT_EQ(index.size(), static_cast<size_t>(0));
+}
+}
+
+int main(int, char**)
+{
+    TEST_CHECK(testUpdate);
+    TEST_CHECK(testSICD);
+    TEST_CHECK(testSkipUnchanged);
+    TEST_CHECK(testSaveLoad);
+    TEST_CHECK(testPrune);
+    return 0;
+}
@@ -0,0 +1,87 @@
+/* =========================================================================
+ * This file is part of six.product-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six.product-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef __SIX_PRODUCT_LINEAR_REMAP_H__
+#define __SIX_PRODUCT_LINEAR_REMAP_H__
+
+#include <stddef.h>
+
+#include <six/Types.h>
+
+namespace six
+{
+namespace product
+{
+/*!
+ * \class LinearRemap
+ * \brief Maps detected amplitudes onto MONO8I or MONO16I pixels
+ *
+ * Amplitudes from 0 up to the clip value are scaled linearly onto the full
+ * range of the output pixel type.  Anything above the clip value saturates.
+ * Output pixels are in native byte order.
+ */
+class LinearRemap
+{
+public:
+    //! Name of the remap, as it appears in the SIDD's RemapInformation
+    static const char REMAP_TYPE[];
+
+    /*!
+     * Constructor
+     *
+     * \param clipValue Amplitude that maps to the brightest output pixel.
+     * Must be positive.
+     * \param pixelType Output pixel type.  Must be MONO8I or MONO16I.
+     */
+    LinearRemap(double clipValue, PixelType pixelType);
+
+    //! \return The amplitude that maps to the brightest output pixel
+    double getClipValue() const
+    {
+        return mClipValue;
+    }
+
+    //! \return The number of bytes in each output pixel
+    size_t getNumBytesPerPixel() const
+    {
+        return mNumBytesPerPixel;
+    }
+
+    /*!
+     * Remaps amplitudes
+     *
+     * \param amplitude Amplitudes to remap.  Must contain 'numPixels' values.
+     * \param numPixels Number of pixels to remap
+     * \param output Output pixels.  Must hold
+     * 'numPixels * getNumBytesPerPixel()' bytes.
+     */
+    void apply(const float* amplitude, size_t numPixels, UByte* output) const;
+
+private:
+    double mClipValue;
+    size_t mNumBytesPerPixel;
+    double mMaxOutput;
+    double mScale;
+};
+}
+}
+
+#endif
@@ -0,0 +1,173 @@
+/* =========================================================================
+ * This file is part of six.product-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six.product-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef __SIX_PRODUCT_SIDD_PRODUCT_GENERATOR_H__
+#define __SIX_PRODUCT_SIDD_PRODUCT_GENERATOR_H__
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <io/SeekableStreams.h>
+#include <types/RowCol.h>
+#include <six/NITFReadControl.h>
+#include <six/XMLControlFactory.h>
+#include <six/sicd/ComplexData.h>
+#include <six/sidd/DerivedData.h>
+#include <six/product/LinearRemap.h>
+
+namespace six
+{
+namespace product
+{
+/*!
+ * \class SIDDProductGenerator
+ * \brief Forms a detected SIDD from a SICD
+ *
+ * The SICD is processed a band of output rows at a time: the slant plane
+ * pixels feeding each band are read, detected, resampled (bilinearly) into
+ * the SICD's output plane, remapped, and handed to a SIDDByteProvider.  Only
+ * one band is in memory at a time, so the peak memory use is governed by
+ * the band size rather than the size of the SICD.  Detection, resampling,
+ * and remapping are spread across threads.
+ *
+ * The output plane is RadarCollection.Area.Plane, derived from the SICD's
+ * geometry if it is not present.  The DerivedData is filled in from the
+ * ComplexData on construction and may be adjusted (e.g. for product
+ * classification) before calling write().
+ *
+ * Only SICDs with RE32F_IM32F or RE16I_IM16I pixels are supported.
+ */
+class SIDDProductGenerator
+{
+public:
+    //! Default cap on the slant plane memory used per band
+    static const size_t DEFAULT_MAX_BAND_BYTES = 256 * 1024 * 1024;
+
+    //! Default order of the output to slant plane polynomials
+    static const size_t DEFAULT_POLY_ORDER = 3;
+
+    //! Multiple of the mean amplitude that is clipped by the remap
+    static const double DEFAULT_CLIP_FACTOR;
+
+    /*!
+     * Constructor.  Loads the SICD's metadata and fits the projection
+     * polynomials.  No pixel data is read until write() is called.
+     *
+     * \param sicdPathname SICD NITF pathname
+     * \param schemaPaths Directories or files of schema locations
+     * \param pixelType Output pixel type.  Must be MONO8I or MONO16I.
+     * \param numThreads Number of threads to use.  If 0, uses all cores.
+     * \param maxBandBytes Upper bound on the memory used to hold the SICD
+     * pixels (complex and detected) feeding a band.  A band is never
+     * smaller than one output row.
+     */
+    SIDDProductGenerator(const std::string& sicdPathname,
+                         const std::vector<std::string>& schemaPaths,
+                         PixelType pixelType = PixelType::MONO8I,
+                         size_t numThreads = 0,
+                         size_t maxBandBytes = DEFAULT_MAX_BAND_BYTES);
+
+    //! \return The input SICD metadata
+    const sicd::ComplexData& getComplexData() const
+    {
+        return *mComplexData;
+    }
+
+    //! \return The SIDD metadata that will be written
+    sidd::DerivedData& getDerivedData()
+    {
+        return *mDerivedData;
+    }
+
+    //! \return The SIDD metadata that will be written
+    const sidd::DerivedData& getDerivedData() const
+    {
+        return *mDerivedData;
+    }
+
+    //! \return The number of rows and columns in the output image
+    types::RowCol<size_t> getDims() const
+    {
+        return mOutputExtent;
+    }
+
+    /*!
+     * Sets the multiple of the mean amplitude that saturates the remap.
+     * Defaults to DEFAULT_CLIP_FACTOR.
+     */
+    void setClipFactor(double clipFactor)
+    {
+        mClipFactor = clipFactor;
+    }
+
+    /*!
+     * Forms the SIDD and writes it out
+     *
+     * \param siddPathname Output SIDD NITF pathname
+     */
+    void write(const std::string& siddPathname);
+
+    /*!
+     * Forms the SIDD and writes it out
+     *
+     * \param outStream Output stream.  The SIDD is written starting at the
+     * stream's current position.
+     */
+    void write(io::SeekableOutputStream& outStream);
+
+private:
+    void initDerivedData(PixelType pixelType);
+
+    double estimateMeanAmplitude();
+
+    size_t getBandRows(size_t startRow,
+                       types::RowCol<size_t>& slantOffset,
+                       types::RowCol<size_t>& slantExtent) const;
+
+    void getSlantBounds(size_t startRow,
+                        size_t numRows,
+                        types::RowCol<size_t>& slantOffset,
+                        types::RowCol<size_t>& slantExtent) const;
+
+private:
+    const std::vector<std::string> mSchemaPaths;
+    const size_t mNumThreads;
+    const size_t mMaxBandBytes;
+    double mClipFactor;
+
+    XMLControlRegistry mXMLRegistry;
+    NITFReadControl mReader;
+    std::auto_ptr<sicd::ComplexData> mComplexData;
+    std::auto_ptr<sidd::DerivedData> mDerivedData;
+
+    // Portion of the output plane covered by the SICD
+    types::RowCol<size_t> mOutputOffset;
+    types::RowCol<size_t> mOutputExtent;
+
+    // Output plane pixel to slant plane pixel, with x = col and y = row
+    Poly2D mToSlantRow;
+    Poly2D mToSlantCol;
+};
+}
+}
+
+#endif
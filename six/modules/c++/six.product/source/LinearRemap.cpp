@@ -0,0 +1,93 @@
+/* =========================================================================
+ * This file is part of six.product-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six.product-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <sys/Conf.h>
+#include <except/Exception.h>
+#include <six/product/LinearRemap.h>
+
+namespace
+{
+template <typename OutT>
+void remap(const float* amplitude,
+           size_t numPixels,
+           double scale,
+           double maxOutput,
+           OutT* output)
+{
+    for (size_t ii = 0; ii < numPixels; ++ii)
+    {
+        const double value = amplitude[ii] * scale;
+        output[ii] = (value >= maxOutput) ?
+                static_cast<OutT>(maxOutput) :
+                static_cast<OutT>(value + 0.5);
+    }
+}
+}
+
+namespace six
+{
+namespace product
+{
+const char LinearRemap::REMAP_TYPE[] = "LINEAR";
+
+LinearRemap::LinearRemap(double clipValue, PixelType pixelType) :
+    mClipValue(clipValue)
+{
+    if (!(clipValue > 0))
+    {
+        throw except::Exception(Ctxt("Clip value must be positive"));
+    }
+
+    switch (pixelType)
+    {
+    case PixelType::MONO8I:
+        mNumBytesPerPixel = 1;
+        mMaxOutput = 255;
+        break;
+    case PixelType::MONO16I:
+        mNumBytesPerPixel = 2;
+        mMaxOutput = 65535;
+        break;
+    default:
+        throw except::Exception(Ctxt(
+                "Linear remap only supports MONO8I and MONO16I, not " +
+                pixelType.toString()));
+    }
+
+    mScale = mMaxOutput / mClipValue;
+}
+
+void LinearRemap::apply(const float* amplitude,
+                        size_t numPixels,
+                        UByte* output) const
+{
+    if (mNumBytesPerPixel == 1)
+    {
+        remap(amplitude, numPixels, mScale, mMaxOutput, output);
+    }
+    else
+    {
+        remap(amplitude, numPixels, mScale, mMaxOutput,
+              reinterpret_cast<sys::Uint16_T*>(output));
+    }
+}
+}
+}
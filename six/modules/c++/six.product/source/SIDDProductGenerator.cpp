@@ -0,0 +1,692 @@
+/* =========================================================================
+ * This file is part of six.product-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six.product-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <math.h>
+
+#include <algorithm>
+#include <complex>
+#include <limits>
+
+#include <sys/Conf.h>
+#include <sys/OS.h>
+#include <except/Exception.h>
+#include <str/Manip.h>
+#include <io/FileOutputStream.h>
+#include <mt/ThreadPlanner.h>
+#include <mt/Runnable1D.h>
+#include <scene/GridECEFTransform.h>
+#include <scene/ProjectionPolynomialFitter.h>
+#include <scene/SceneGeometry.h>
+#include <scene/Utilities.h>
+#include <six/sicd/ComplexXMLControl.h>
+#include <six/sicd/Utilities.h>
+#include <six/sidd/DerivedDataBuilder.h>
+#include <six/sidd/SIDDByteProvider.h>
+#include <six/sidd/Utilities.h>
+#include <six/product/SIDDProductGenerator.h>
+
+namespace
+{
+// Number of slant plane rows sampled to compute the remap statistics
+const size_t NUM_STATISTICS_ROWS = 256;
+
+// Spacing, in output pixels, of the points used to find the slant plane
+// footprint of a band
+const size_t FOOTPRINT_SAMPLE_SPACING = 32;
+
+// Extra slant plane pixels read around each band's footprint.  Covers the
+// bilinear kernel and any wiggle in the polynomials between sample points.
+const size_t FOOTPRINT_PAD = 4;
+
+// Distance, in slant plane pixels, that a resampled point may fall outside
+// of the SICD and still be treated as on its edge.  Keeps round off in the
+// polynomials from zeroing out edge pixels.
+const double EDGE_TOLERANCE = 1e-3;
+
+// Bytes held per slant plane pixel: the complex pixel plus its amplitude
+const size_t BYTES_PER_SLANT_PIXEL =
+        sizeof(std::complex<float>) + sizeof(float);
+
+size_t getNumThreads(size_t numThreads)
+{
+    return (numThreads == 0) ? sys::OS().getNumCPUs() : numThreads;
+}
+
+std::string getClassificationLevel(const std::string& sicdLevel)
+{
+    std::string level(sicdLevel);
+    str::trim(level);
+    str::upper(level);
+
+    if (level == "UNCLASSIFIED")
+    {
+        return "U";
+    }
+    if (level == "CONFIDENTIAL")
+    {
+        return "C";
+    }
+    if (level == "SECRET")
+    {
+        return "S";
+    }
+    if (level == "TOP SECRET")
+    {
+        return "TS";
+    }
+    return level.empty() ? "U" : level;
+}
+
+/*
+ * sidd::Utilities::setCollectionValues() can't be used here as it never
+ * provides the output plane to the scene geometry, so the ground track and
+ * the rest are computed directly from the SICD's slant plane and the
+ * product plane.
+ */
+void setExploitationFeatures(const six::sicd::ComplexData& complexData,
+                             const six::sidd::PlaneProjection& projection,
+                             six::sidd::ExploitationFeatures& features)
+{
+    const six::Vector3& arpPos = complexData.scpcoa->arpPos;
+    const six::Vector3& arpVel = complexData.scpcoa->arpVel;
+    const six::Vector3& scp = complexData.geoData->scp.ecf;
+    const six::Vector3& slantRow = complexData.grid->row->unitVector;
+    const six::Vector3& slantCol = complexData.grid->col->unitVector;
+    const six::Vector3& productRow = projection.productPlane.rowUnitVector;
+    const six::Vector3& productCol = projection.productPlane.colUnitVector;
+
+    const scene::SceneGeometry slantGeom(arpVel, arpPos, scp,
+                                         slantRow, slantCol,
+                                         productRow, productCol);
+    const scene::SceneGeometry productGeom(arpVel, arpPos, scp,
+                                           productRow, productCol);
+
+    six::sidd::Product& product = features.product[0];
+    product.north = productGeom.getNorthAngle();
+    product.resolution = slantGeom.getGroundResolution(
+            types::RgAz<double>(complexData.grid->row->impulseResponseWidth,
+                                complexData.grid->col->impulseResponseWidth));
+
+    six::sidd::Collection& collection = *features.collections[0];
+    collection.geometry.reset(new six::sidd::Geometry());
+    collection.geometry->slope = slantGeom.getETPSlopeAngle();
+    collection.geometry->squint = slantGeom.getSquintAngle();
+    collection.geometry->graze = slantGeom.getETPGrazingAngle();
+    collection.geometry->tilt = slantGeom.getETPTiltAngle();
+    collection.geometry->azimuth = slantGeom.getAzimuthAngle();
+
+    collection.phenomenology.reset(new six::sidd::Phenomenology());
+    collection.phenomenology->multiPath = slantGeom.getMultiPathAngle();
+    collection.phenomenology->groundTrack =
+            slantGeom.getOPGroundTrackAngle();
+    collection.phenomenology->shadow = slantGeom.getShadow();
+    collection.phenomenology->layover = slantGeom.getLayover();
+}
+
+class DetectRows
+{
+public:
+    DetectRows(const std::complex<float>* input,
+               size_t numCols,
+               float* output) :
+        mInput(input),
+        mNumCols(numCols),
+        mOutput(output)
+    {
+    }
+
+    void operator()(size_t row) const
+    {
+        const std::complex<float>* const input = mInput + row * mNumCols;
+        float* const output = mOutput + row * mNumCols;
+        for (size_t col = 0; col < mNumCols; ++col)
+        {
+            output[col] = std::abs(input[col]);
+        }
+    }
+
+private:
+    const std::complex<float>* const mInput;
+    const size_t mNumCols;
+    float* const mOutput;
+};
+
+/*
+ * Resamples one output row at a time from a window of detected slant plane
+ * pixels, then remaps it into its final pixel type (and byte order).  Each
+ * thread needs its own copy, as the amplitude row is scratch space.
+ */
+class ResampleRows
+{
+public:
+    ResampleRows(const float* slant,
+                 const types::RowCol<size_t>& slantOffset,
+                 const types::RowCol<size_t>& slantExtent,
+                 const six::Poly2D& toSlantRow,
+                 const six::Poly2D& toSlantCol,
+                 const types::RowCol<size_t>& planeStart,
+                 size_t numCols,
+                 const six::product::LinearRemap& remap,
+                 bool swapBytes,
+                 six::UByte* output) :
+        mSlant(slant),
+        mSlantOffset(slantOffset),
+        mSlantExtent(slantExtent),
+        mToSlantRow(toSlantRow),
+        mToSlantCol(toSlantCol),
+        mPlaneStart(planeStart),
+        mNumCols(numCols),
+        mRemap(remap),
+        mSwapBytes(swapBytes),
+        mOutput(output),
+        mAmplitude(numCols)
+    {
+    }
+
+    void operator()(size_t row) const
+    {
+        float* const amplitude = &mAmplitude[0];
+        std::fill_n(amplitude, mNumCols, 0.0f);
+        if (mSlant)
+        {
+            resample(row, amplitude);
+        }
+
+        const size_t numBytesPerPixel = mRemap.getNumBytesPerPixel();
+        six::UByte* const output =
+                mOutput + row * mNumCols * numBytesPerPixel;
+        mRemap.apply(amplitude, mNumCols, output);
+        if (mSwapBytes && numBytesPerPixel > 1)
+        {
+            sys::byteSwap(output, static_cast<unsigned short>(numBytesPerPixel),
+                          mNumCols);
+        }
+    }
+
+private:
+    void resample(size_t row, float* amplitude) const
+    {
+        const double planeRow = static_cast<double>(mPlaneStart.row + row);
+        const six::Poly1D rowPoly = mToSlantRow.atY(planeRow);
+        const six::Poly1D colPoly = mToSlantCol.atY(planeRow);
+
+        const double maxRow = static_cast<double>(mSlantExtent.row - 1);
+        const double maxCol = static_cast<double>(mSlantExtent.col - 1);
+        for (size_t col = 0; col < mNumCols; ++col)
+        {
+            const double planeCol = static_cast<double>(mPlaneStart.col + col);
+            double slantRow = rowPoly(planeCol) - mSlantOffset.row;
+            double slantCol = colPoly(planeCol) - mSlantOffset.col;
+
+            // Out of bounds values just get assigned to 0
+            if (!(slantRow >= -EDGE_TOLERANCE &&
+                  slantRow <= maxRow + EDGE_TOLERANCE &&
+                  slantCol >= -EDGE_TOLERANCE &&
+                  slantCol <= maxCol + EDGE_TOLERANCE))
+            {
+                continue;
+            }
+            slantRow = std::min(std::max(slantRow, 0.0), maxRow);
+            slantCol = std::min(std::max(slantCol, 0.0), maxCol);
+
+            const size_t row0 = static_cast<size_t>(slantRow);
+            const size_t col0 = static_cast<size_t>(slantCol);
+            const size_t row1 = std::min(row0 + 1, mSlantExtent.row - 1);
+            const size_t col1 = std::min(col0 + 1, mSlantExtent.col - 1);
+            const float rowFrac = static_cast<float>(slantRow - row0);
+            const float colFrac = static_cast<float>(slantCol - col0);
+
+            const float* const top = mSlant + row0 * mSlantExtent.col;
+            const float* const bottom = mSlant + row1 * mSlantExtent.col;
+            const float upper = top[col0] + colFrac * (top[col1] - top[col0]);
+            const float lower =
+                    bottom[col0] + colFrac * (bottom[col1] - bottom[col0]);
+            amplitude[col] = upper + rowFrac * (lower - upper);
+        }
+    }
+
+private:
+    const float* const mSlant;
+    const types::RowCol<size_t> mSlantOffset;
+    const types::RowCol<size_t> mSlantExtent;
+    const six::Poly2D& mToSlantRow;
+    const six::Poly2D& mToSlantCol;
+    const types::RowCol<size_t> mPlaneStart;
+    const size_t mNumCols;
+    const six::product::LinearRemap& mRemap;
+    const bool mSwapBytes;
+    six::UByte* const mOutput;
+    mutable std::vector<float> mAmplitude;
+};
+}
+
+namespace six
+{
+namespace product
+{
+const size_t SIDDProductGenerator::DEFAULT_MAX_BAND_BYTES;
+const size_t SIDDProductGenerator::DEFAULT_POLY_ORDER;
+const double SIDDProductGenerator::DEFAULT_CLIP_FACTOR = 3.0;
+
+SIDDProductGenerator::SIDDProductGenerator(
+        const std::string& sicdPathname,
+        const std::vector<std::string>& schemaPaths,
+        PixelType pixelType,
+        size_t numThreads,
+        size_t maxBandBytes) :
+    mSchemaPaths(schemaPaths),
+    mNumThreads(getNumThreads(numThreads)),
+    mMaxBandBytes(maxBandBytes),
+    mClipFactor(DEFAULT_CLIP_FACTOR)
+{
+    mXMLRegistry.addCreator(
+            DataType::COMPLEX,
+            new XMLControlCreatorT<sicd::ComplexXMLControl>());
+    mReader.setXMLControlRegistry(&mXMLRegistry);
+    mReader.load(sicdPathname, mSchemaPaths);
+    mComplexData = sicd::Utilities::getComplexData(mReader);
+
+    const PixelType inputType = mComplexData->getPixelType();
+    if (inputType != PixelType::RE32F_IM32F &&
+        inputType != PixelType::RE16I_IM16I)
+    {
+        throw except::Exception(Ctxt(
+                "Cannot form a SIDD from " + inputType.toString() +
+                " pixels"));
+    }
+
+    std::auto_ptr<scene::SceneGeometry> geometry;
+    std::auto_ptr<scene::ProjectionModel> projectionModel;
+    sicd::AreaPlane areaPlane;
+    sicd::Utilities::getModelComponents(*mComplexData,
+                                        geometry,
+                                        projectionModel,
+                                        areaPlane);
+    mComplexData->getOutputPlaneOffsetAndExtent(areaPlane,
+                                                mOutputOffset,
+                                                mOutputExtent);
+
+    const std::auto_ptr<scene::ProjectionPolynomialFitter> fitter(
+            sicd::Utilities::getPolynomialFitter(*mComplexData));
+
+    const RowColDouble slantSpacing(mComplexData->grid->row->sampleSpacing,
+                                    mComplexData->grid->col->sampleSpacing);
+    const types::RowCol<size_t> slantStart(mComplexData->imageData->firstRow,
+                                           mComplexData->imageData->firstCol);
+    fitter->fitOutputToSlantPolynomials(slantStart,
+                                        mComplexData->imageData->scpPixel,
+                                        mComplexData->imageData->scpPixel,
+                                        slantSpacing,
+                                        DEFAULT_POLY_ORDER,
+                                        DEFAULT_POLY_ORDER,
+                                        mToSlantRow,
+                                        mToSlantCol);
+
+    // Flip so that fixing the output row gives a polynomial in column
+    mToSlantRow = mToSlantRow.flipXY();
+    mToSlantCol = mToSlantCol.flipXY();
+
+    initDerivedData(pixelType);
+
+    // Fill in the product geometry
+    sidd::PlaneProjection* const projection =
+            static_cast<sidd::PlaneProjection*>(
+                    mDerivedData->measurement->projection.get());
+    const RowColDouble outputSpacing(areaPlane.xDirection->spacing,
+                                     areaPlane.yDirection->spacing);
+
+    // The area plane's reference point may be far outside of this SICD (if
+    // it's been cropped, say), so reference the product to its center
+    // instead.  This also keeps the time COA polynomial well conditioned.
+    const scene::PlanarGridECEFTransform areaTransform(
+            outputSpacing,
+            areaPlane.referencePoint.rowCol,
+            areaPlane.xDirection->unitVector,
+            areaPlane.yDirection->unitVector,
+            areaPlane.referencePoint.ecef);
+    projection->referencePoint.rowCol = RowColDouble(
+            (mOutputExtent.row - 1) / 2.0,
+            (mOutputExtent.col - 1) / 2.0);
+    projection->referencePoint.ecef = areaTransform.rowColToECEF(RowColDouble(
+            mOutputOffset.row + projection->referencePoint.rowCol.row,
+            mOutputOffset.col + projection->referencePoint.rowCol.col));
+    projection->sampleSpacing = outputSpacing;
+    projection->productPlane.rowUnitVector = areaPlane.xDirection->unitVector;
+    projection->productPlane.colUnitVector = areaPlane.yDirection->unitVector;
+    fitter->fitTimeCOAPolynomial(projection->referencePoint.rowCol,
+                                 outputSpacing,
+                                 DEFAULT_POLY_ORDER,
+                                 DEFAULT_POLY_ORDER,
+                                 projection->timeCOAPoly);
+
+    mDerivedData->measurement->arpPoly = mComplexData->position->arpPoly;
+    mDerivedData->measurement->pixelFootprint =
+            RowColInt(mOutputExtent.row, mOutputExtent.col);
+
+    const scene::PlanarGridECEFTransform ecefTransform(
+            outputSpacing,
+            projection->referencePoint.rowCol,
+            projection->productPlane.rowUnitVector,
+            projection->productPlane.colUnitVector,
+            projection->referencePoint.ecef);
+    const double lastRow = static_cast<double>(mOutputExtent.row - 1);
+    const double lastCol = static_cast<double>(mOutputExtent.col - 1);
+    const RowColDouble corners[LatLonCorners::NUM_CORNERS] =
+    {
+        RowColDouble(0, 0),
+        RowColDouble(0, lastCol),
+        RowColDouble(lastRow, lastCol),
+        RowColDouble(lastRow, 0)
+    };
+    LatLonCorners imageCorners;
+    for (size_t ii = 0; ii < LatLonCorners::NUM_CORNERS; ++ii)
+    {
+        const scene::LatLonAlt latLon = scene::Utilities::ecefToLatLon(
+                ecefTransform.rowColToECEF(corners[ii]));
+        imageCorners.getCorner(ii).setLat(latLon.getLat());
+        imageCorners.getCorner(ii).setLon(latLon.getLon());
+    }
+    mDerivedData->setImageCorners(imageCorners);
+
+    setExploitationFeatures(*mComplexData,
+                            *projection,
+                            *mDerivedData->exploitationFeatures);
+}
+
+void SIDDProductGenerator::initDerivedData(PixelType pixelType)
+{
+    sidd::DerivedDataBuilder builder;
+    builder.addDisplay(pixelType)
+            .addGeographicAndTargetOld(RegionType::GEOGRAPHIC_INFO)
+            .addMeasurement(ProjectionType::PLANE)
+            .addExploitationFeatures(1);
+    mDerivedData.reset(builder.steal());
+    mDerivedData->exploitationFeatures->product.resize(1);
+
+    const CollectionInformation& collectionInfo =
+            *mComplexData->collectionInformation;
+
+    sidd::ProductCreation& productCreation = *mDerivedData->productCreation;
+    productCreation.processorInformation.application = "six.product";
+    productCreation.processorInformation.processingDateTime = DateTime();
+    productCreation.classification.classification =
+            getClassificationLevel(collectionInfo.getClassificationLevel());
+    productCreation.classification.createDate = DateTime();
+    productCreation.productName = collectionInfo.coreName;
+    productCreation.productClass = "Detected Image";
+    productCreation.productType = "SIDD";
+
+    // The clip value is filled in once we've looked at the pixels
+    sidd::Display& display = *mDerivedData->display;
+    display.remapInformation.reset(
+            new sidd::MonochromeDisplayRemap(LinearRemap::REMAP_TYPE));
+    display.magnificationMethod = MagnificationMethod::BILINEAR;
+    display.decimationMethod = DecimationMethod::BILINEAR;
+
+    sidd::GeographicCoverage& coverage =
+            *mDerivedData->geographicAndTarget->geographicCoverage;
+    coverage.geographicInformation.reset(new sidd::GeographicInformation());
+
+    sidd::Collection& collection =
+            *mDerivedData->exploitationFeatures->collections[0];
+    collection.information.sensorName = collectionInfo.collectorName;
+    collection.information.radarMode = collectionInfo.radarMode;
+    collection.information.radarModeID = collectionInfo.radarModeID;
+    collection.information.collectionDateTime =
+            mComplexData->timeline->collectStart;
+    collection.information.collectionDuration =
+            mComplexData->timeline->collectDuration;
+    collection.information.resolution.rg =
+            mComplexData->grid->row->impulseResponseWidth;
+    collection.information.resolution.az =
+            mComplexData->grid->col->impulseResponseWidth;
+
+    const DualPolarizationType polarization =
+            mComplexData->imageFormation->txRcvPolarizationProc;
+    if (polarization != DualPolarizationType::NOT_SET)
+    {
+        const std::pair<PolarizationType, PolarizationType> txRcv =
+                sidd::Utilities::convertDualPolarization(polarization);
+        mem::ScopedCopyablePtr<sidd::TxRcvPolarization> txRcvPolarization(
+                new sidd::TxRcvPolarization());
+        txRcvPolarization->txPolarization =
+                PolarizationSequenceType(txRcv.first.toString());
+        txRcvPolarization->rcvPolarization =
+                PolarizationSequenceType(txRcv.second.toString());
+        txRcvPolarization->processed = BooleanType::IS_TRUE;
+        collection.information.polarization.push_back(txRcvPolarization);
+    }
+}
+
+double SIDDProductGenerator::estimateMeanAmplitude()
+{
+    const size_t numRows = mComplexData->getNumRows();
+    const size_t numCols = mComplexData->getNumCols();
+    const size_t numStatsRows = std::min(numRows, NUM_STATISTICS_ROWS);
+
+    std::vector<std::complex<float> > row(numCols);
+    std::vector<float> amplitude(numCols);
+    double sum(0);
+    size_t count(0);
+    for (size_t ii = 0; ii < numStatsRows; ++ii)
+    {
+        // Spread the rows evenly through the image
+        const size_t rowNum = (ii * numRows + numRows / 2) / numStatsRows;
+        sicd::Utilities::getWidebandData(mReader,
+                                         *mComplexData,
+                                         types::RowCol<size_t>(rowNum, 0),
+                                         types::RowCol<size_t>(1, numCols),
+                                         &row[0]);
+        DetectRows(&row[0], numCols, &amplitude[0])(0);
+
+        for (size_t col = 0; col < numCols; ++col)
+        {
+            // Zeros are fill, so don't let them drag down the mean
+            if (amplitude[col] > 0)
+            {
+                sum += amplitude[col];
+                ++count;
+            }
+        }
+    }
+
+    return (count == 0) ? 0 : sum / count;
+}
+
+void SIDDProductGenerator::getSlantBounds(
+        size_t startRow,
+        size_t numRows,
+        types::RowCol<size_t>& slantOffset,
+        types::RowCol<size_t>& slantExtent) const
+{
+    double minRow = std::numeric_limits<double>::max();
+    double maxRow = -std::numeric_limits<double>::max();
+    double minCol = std::numeric_limits<double>::max();
+    double maxCol = -std::numeric_limits<double>::max();
+
+    // Sample the band's footprint on a grid, always including its edges
+    const size_t lastRow = numRows - 1;
+    const size_t lastCol = mOutputExtent.col - 1;
+    for (size_t row = 0; ; row = std::min(row + FOOTPRINT_SAMPLE_SPACING,
+                                          lastRow))
+    {
+        const double planeRow =
+                static_cast<double>(startRow + row);
+        const Poly1D rowPoly = mToSlantRow.atY(planeRow);
+        const Poly1D colPoly = mToSlantCol.atY(planeRow);
+        for (size_t col = 0; ; col = std::min(col + FOOTPRINT_SAMPLE_SPACING,
+                                              lastCol))
+        {
+            const double planeCol = static_cast<double>(col);
+            const double slantRow = rowPoly(planeCol);
+            const double slantCol = colPoly(planeCol);
+            minRow = std::min(minRow, slantRow);
+            maxRow = std::max(maxRow, slantRow);
+            minCol = std::min(minCol, slantCol);
+            maxCol = std::max(maxCol, slantCol);
+
+            if (col == lastCol)
+            {
+                break;
+            }
+        }
+
+        if (row == lastRow)
+        {
+            break;
+        }
+    }
+
+    const double numSlantRows = static_cast<double>(mComplexData->getNumRows());
+    const double numSlantCols = static_cast<double>(mComplexData->getNumCols());
+    minRow = std::max(::floor(minRow) - FOOTPRINT_PAD, 0.0);
+    minCol = std::max(::floor(minCol) - FOOTPRINT_PAD, 0.0);
+    maxRow = std::min(::ceil(maxRow) + FOOTPRINT_PAD, numSlantRows - 1);
+    maxCol = std::min(::ceil(maxCol) + FOOTPRINT_PAD, numSlantCols - 1);
+
+    if (minRow > maxRow || minCol > maxCol)
+    {
+        // The band doesn't overlap the SICD at all
+        slantOffset = types::RowCol<size_t>(0, 0);
+        slantExtent = types::RowCol<size_t>(0, 0);
+        return;
+    }
+
+    slantOffset.row = static_cast<size_t>(minRow);
+    slantOffset.col = static_cast<size_t>(minCol);
+    slantExtent.row = static_cast<size_t>(maxRow) - slantOffset.row + 1;
+    slantExtent.col = static_cast<size_t>(maxCol) - slantOffset.col + 1;
+}
+
+size_t SIDDProductGenerator::getBandRows(
+        size_t startRow,
+        types::RowCol<size_t>& slantOffset,
+        types::RowCol<size_t>& slantExtent) const
+{
+    // Start with as many rows as would fit if the output plane and slant
+    // plane lined up, then shrink until the footprint fits
+    const size_t bytesPerSlantRow =
+            mComplexData->getNumCols() * BYTES_PER_SLANT_PIXEL;
+    size_t numRows = std::max<size_t>(mMaxBandBytes / bytesPerSlantRow, 1);
+    numRows = std::min(numRows, mOutputExtent.row - startRow);
+
+    while (true)
+    {
+        getSlantBounds(startRow, numRows, slantOffset, slantExtent);
+        if (numRows == 1 ||
+            slantExtent.area() * BYTES_PER_SLANT_PIXEL <= mMaxBandBytes)
+        {
+            return numRows;
+        }
+        numRows = (numRows + 1) / 2;
+    }
+}
+
+void SIDDProductGenerator::write(const std::string& siddPathname)
+{
+    io::FileOutputStream outStream(siddPathname);
+    write(outStream);
+    outStream.close();
+}
+
+void SIDDProductGenerator::write(io::SeekableOutputStream& outStream)
+{
+    const double meanAmplitude = estimateMeanAmplitude();
+    const double clipValue = (meanAmplitude > 0) ?
+            mClipFactor * meanAmplitude : 1.0;
+    const LinearRemap remap(clipValue,
+                            mDerivedData->display->pixelType);
+
+    sidd::MonochromeDisplayRemap* const monoRemap =
+            dynamic_cast<sidd::MonochromeDisplayRemap*>(
+                    mDerivedData->display->remapInformation.get());
+    if (monoRemap)
+    {
+        Parameter clipParameter(clipValue);
+        clipParameter.setName("ClipValue");
+        ParameterCollection& remapParameters = monoRemap->remapParameters;
+        if (remapParameters.containsParameter(clipParameter.getName()))
+        {
+            remapParameters[remapParameters.findParameterIndex(
+                    clipParameter.getName())] = clipParameter;
+        }
+        else
+        {
+            remapParameters.push_back(clipParameter);
+        }
+    }
+
+    const sidd::SIDDByteProvider byteProvider(*mDerivedData, mSchemaPaths);
+    const sys::Off_T startOffset = outStream.tell();
+    const bool swapBytes = !sys::isBigEndianSystem();
+    const size_t numBytesPerRow =
+            mOutputExtent.col * remap.getNumBytesPerPixel();
+
+    std::vector<std::complex<float> > slantPixels;
+    std::vector<float> slantAmplitude;
+    std::vector<UByte> bandPixels;
+    nitf::NITFBufferList buffers;
+    nitf::Off fileOffset;
+    for (size_t startRow = 0; startRow < mOutputExtent.row; )
+    {
+        types::RowCol<size_t> slantOffset;
+        types::RowCol<size_t> slantExtent;
+        const size_t numRows =
+                getBandRows(startRow, slantOffset, slantExtent);
+
+        const float* slant = NULL;
+        if (slantExtent.area() > 0)
+        {
+            sicd::Utilities::getWidebandData(mReader,
+                                             *mComplexData,
+                                             slantOffset,
+                                             slantExtent,
+                                             slantPixels);
+            slantAmplitude.resize(slantExtent.area());
+            mt::run1D(slantExtent.row, mNumThreads,
+                      DetectRows(&slantPixels[0], slantExtent.col,
+                                 &slantAmplitude[0]));
+            slant = &slantAmplitude[0];
+        }
+
+        bandPixels.resize(numRows * numBytesPerRow);
+        const types::RowCol<size_t> planeStart(startRow, 0);
+        mt::run1DWithCopies(numRows, mNumThreads,
+                            ResampleRows(slant, slantOffset, slantExtent,
+                                         mToSlantRow, mToSlantCol,
+                                         planeStart, mOutputExtent.col,
+                                         remap, swapBytes, &bandPixels[0]));
+
+        byteProvider.getBytes(&bandPixels[0], startRow, numRows,
+                              fileOffset, buffers);
+        outStream.seek(startOffset + fileOffset, io::Seekable::START);
+        for (size_t ii = 0; ii < buffers.mBuffers.size(); ++ii)
+        {
+            outStream.write(
+                    static_cast<const sys::byte*>(buffers.mBuffers[ii].mData),
+                    buffers.mBuffers[ii].mNumBytes);
+        }
+
+        startRow += numRows;
+    }
+}
+}
+}
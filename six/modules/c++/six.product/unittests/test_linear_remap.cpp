@@ -0,0 +1,80 @@
+/* =========================================================================
+ * This file is part of six.product-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six.product-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <vector>
+
+#include <sys/Conf.h>
+#include <six/product/LinearRemap.h>
+#include "TestCase.h"
+
+namespace
+{
+TEST_CASE(RemapMono8)
+{
+    const six::product::LinearRemap remap(10.0, six::PixelType::MONO8I);
+    TEST_ASSERT_EQ(remap.getNumBytesPerPixel(), 1);
+
+    std::vector<float> amplitude;
+    amplitude.push_back(0);
+    amplitude.push_back(5);
+    amplitude.push_back(10);
+    amplitude.push_back(1000);
+
+    std::vector<six::UByte> output(amplitude.size());
+    remap.apply(&amplitude[0], amplitude.size(), &output[0]);
+    TEST_ASSERT_EQ(output[0], 0);
+    TEST_ASSERT_EQ(output[1], 128);
+    TEST_ASSERT_EQ(output[2], 255);
+    TEST_ASSERT_EQ(output[3], 255);
+}
+
+TEST_CASE(RemapMono16)
+{
+    const six::product::LinearRemap remap(2.0, six::PixelType::MONO16I);
+    TEST_ASSERT_EQ(remap.getNumBytesPerPixel(), 2);
+
+    std::vector<float> amplitude;
+    amplitude.push_back(0);
+    amplitude.push_back(1);
+    amplitude.push_back(3);
+
+    std::vector<sys::Uint16_T> output(amplitude.size());
+    remap.apply(&amplitude[0], amplitude.size(),
+                reinterpret_cast<six::UByte*>(&output[0]));
+    TEST_ASSERT_EQ(output[0], 0);
+    TEST_ASSERT_EQ(output[1], 32768);
+    TEST_ASSERT_EQ(output[2], 65535);
+}
+
+TEST_CASE(RemapRejectsBadInputs)
+{
+    TEST_EXCEPTION(six::product::LinearRemap(0, six::PixelType::MONO8I));
+    TEST_EXCEPTION(six::product::LinearRemap(1, six::PixelType::RGB24I));
+}
+}
+
+int main(int, char**)
+{
+    TEST_CHECK(RemapMono8);
+    TEST_CHECK(RemapMono16);
+    TEST_CHECK(RemapRejectsBadInputs);
+    return 0;
+}
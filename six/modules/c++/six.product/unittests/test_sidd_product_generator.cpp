@@ -0,0 +1,391 @@
+/* =========================================================================
+ * This file is part of six.product-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six.product-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <math.h>
+#include <stdlib.h>
+
+#include <complex>
+#include <vector>
+
+#include <sys/Conf.h>
+#include <sys/OS.h>
+#include <mem/ScopedArray.h>
+#include <mem/SharedPtr.h>
+#include <scene/Utilities.h>
+#include <six/NITFReadControl.h>
+#include <six/NITFWriteControl.h>
+#include <six/sicd/ComplexXMLControl.h>
+#include <six/sicd/Utilities.h>
+#include <six/sidd/DerivedXMLControl.h>
+#include <six/product/LinearRemap.h>
+#include <six/product/SIDDProductGenerator.h>
+#include "TestCase.h"
+
+namespace
+{
+/*
+ * Writes a small synthetic SICD whose slant plane is a flat patch of the
+ * ground, and whose output plane is that same patch with an extra
+ * 'PAD' pixels around every edge.  That makes the output to slant plane
+ * mapping a pure shift, so every output pixel is known: the amplitude at
+ * slant pixel (row - PAD, col - PAD), linearly remapped, and zero well
+ * outside of the SICD.
+ */
+class TestHelper
+{
+public:
+    static const size_t NUM_ROWS = 40;
+    static const size_t NUM_COLS = 30;
+    static const size_t PAD = 4;
+
+    TestHelper() :
+        mSicdPathname("test_sidd_product_generator.sicd.nitf")
+    {
+        mXmlRegistry.addCreator(
+                six::DataType::DERIVED,
+                new six::XMLControlCreatorT<six::sidd::DerivedXMLControl>());
+
+        const double lat = 35.0 * M_PI / 180.0;
+        const double lon = -117.0 * M_PI / 180.0;
+        mScp = scene::Utilities::latLonToECEF(
+                scene::LatLonAlt(35.0, -117.0, 0.0));
+        mEast[0] = -sin(lon);
+        mEast[1] = cos(lon);
+        mEast[2] = 0;
+        mNorth[0] = -sin(lat) * cos(lon);
+        mNorth[1] = -sin(lat) * sin(lon);
+        mNorth[2] = cos(lat);
+        mUp[0] = cos(lat) * cos(lon);
+        mUp[1] = cos(lat) * sin(lon);
+        mUp[2] = sin(lat);
+
+        writeSicd();
+    }
+
+    ~TestHelper()
+    {
+        remove(mSicdPathname);
+    }
+
+    //! \return The detected amplitude of slant plane pixel (row, col)
+    static float amplitude(size_t row, size_t col)
+    {
+        return static_cast<float>(1000 + 7 * row + 11 * col);
+    }
+
+    static void remove(const std::string& pathname)
+    {
+        try
+        {
+            sys::OS().remove(pathname);
+        }
+        catch (...)
+        {
+        }
+    }
+
+    const std::string mSicdPathname;
+    six::XMLControlRegistry mXmlRegistry;
+    six::Vector3 mScp;
+    six::Vector3 mEast;
+    six::Vector3 mNorth;
+    six::Vector3 mUp;
+
+private:
+    void writeSicd()
+    {
+        std::auto_ptr<six::sicd::ComplexData> data =
+                six::sicd::Utilities::createFakeComplexData();
+        data->setPixelType(six::PixelType::RE32F_IM32F);
+        data->setNumRows(NUM_ROWS);
+        data->setNumCols(NUM_COLS);
+        data->imageData->validData.clear();
+
+        data->geoData->scp.ecf = mScp;
+        data->geoData->scp.llh = scene::Utilities::ecefToLatLon(mScp);
+
+        // Flying north, looking east from 20 km away and 8 km up.  Time
+        // COA is fixed, so the slant plane maps onto itself.
+        data->position->arpPoly = six::PolyXYZ(1);
+        data->position->arpPoly[0] = mScp - mEast * 20000.0 + mUp * 8000.0;
+        data->position->arpPoly[1] = mNorth * 200.0;
+        data->grid->timeCOAPoly = six::Poly2D(0, 0);
+        data->grid->timeCOAPoly[0][0] = 0;
+
+        data->grid->type = six::ComplexImageGridType::PLANE;
+        data->grid->row->unitVector = mEast;
+        data->grid->row->sampleSpacing = 1.0;
+        data->grid->row->impulseResponseWidth = 1.5;
+        data->grid->col->unitVector = mNorth;
+        data->grid->col->sampleSpacing = 1.0;
+        data->grid->col->impulseResponseWidth = 1.5;
+
+        data->scpcoa.reset(new six::sicd::SCPCOA());
+        data->scpcoa->fillDerivedFields(*data->geoData,
+                                        *data->grid,
+                                        *data->position);
+
+        data->radarCollection->area.reset(new six::sicd::Area());
+        data->radarCollection->area->plane.reset(new six::sicd::AreaPlane());
+        six::sicd::AreaPlane& areaPlane = *data->radarCollection->area->plane;
+        areaPlane.referencePoint.ecef = mScp;
+        areaPlane.referencePoint.rowCol = six::RowColDouble(
+                static_cast<double>(data->imageData->scpPixel.row + PAD),
+                static_cast<double>(data->imageData->scpPixel.col + PAD));
+        areaPlane.xDirection->unitVector = mEast;
+        areaPlane.xDirection->spacing = 1.0;
+        areaPlane.xDirection->elements = NUM_ROWS + 2 * PAD;
+        areaPlane.xDirection->first = 0;
+        areaPlane.yDirection->unitVector = mNorth;
+        areaPlane.yDirection->spacing = 1.0;
+        areaPlane.yDirection->elements = NUM_COLS + 2 * PAD;
+        areaPlane.yDirection->first = 0;
+        areaPlane.orientation = six::OrientationType::ARBITRARY;
+
+        const double lastRow =
+                static_cast<double>(areaPlane.xDirection->elements - 1);
+        const double lastCol =
+                static_cast<double>(areaPlane.yDirection->elements - 1);
+        const six::RowColDouble corners[six::LatLonAltCorners::NUM_CORNERS] =
+        {
+            six::RowColDouble(0, 0),
+            six::RowColDouble(0, lastCol),
+            six::RowColDouble(lastRow, lastCol),
+            six::RowColDouble(lastRow, 0)
+        };
+        for (size_t ii = 0; ii < six::LatLonAltCorners::NUM_CORNERS; ++ii)
+        {
+            const six::Vector3 corner = mScp +
+                    mEast * (corners[ii].row -
+                             areaPlane.referencePoint.rowCol.row) +
+                    mNorth * (corners[ii].col -
+                              areaPlane.referencePoint.rowCol.col);
+            data->radarCollection->area->acpCorners.getCorner(ii) =
+                    scene::Utilities::ecefToLatLon(corner);
+        }
+
+        // Split the amplitude between I and Q so detection is exercised
+        std::vector<std::complex<float> > image(NUM_ROWS * NUM_COLS);
+        for (size_t row = 0; row < NUM_ROWS; ++row)
+        {
+            for (size_t col = 0; col < NUM_COLS; ++col)
+            {
+                image[row * NUM_COLS + col] = std::complex<float>(
+                        0.6f * amplitude(row, col),
+                        0.8f * amplitude(row, col));
+            }
+        }
+
+        six::XMLControlRegistry xmlRegistry;
+        xmlRegistry.addCreator(
+                six::DataType::COMPLEX,
+                new six::XMLControlCreatorT<six::sicd::ComplexXMLControl>());
+
+        mem::SharedPtr<six::Container> container(
+                new six::Container(six::DataType::COMPLEX));
+        container->addData(std::auto_ptr<six::Data>(data.release()));
+
+        six::BufferList buffers;
+        buffers.push_back(reinterpret_cast<const six::UByte*>(&image[0]));
+        six::NITFWriteControl writer(six::Options(), container,
+                                     &xmlRegistry);
+        writer.save(buffers, mSicdPathname, std::vector<std::string>());
+    }
+};
+
+const size_t TestHelper::NUM_ROWS;
+const size_t TestHelper::NUM_COLS;
+const size_t TestHelper::PAD;
+
+/*
+ * Forms a MONO16I SIDD with the given settings and reads back its
+ * metadata and pixels
+ */
+void formSidd(const TestHelper& helper,
+              size_t numThreads,
+              size_t maxBandBytes,
+              std::auto_ptr<six::sidd::DerivedData>& derivedData,
+              std::vector<sys::Uint16_T>& pixels)
+{
+    const std::string siddPathname("test_sidd_product_generator.sidd.nitf");
+    six::product::SIDDProductGenerator generator(
+            helper.mSicdPathname,
+            std::vector<std::string>(),
+            six::PixelType::MONO16I,
+            numThreads,
+            maxBandBytes);
+    const types::RowCol<size_t> dims = generator.getDims();
+    generator.write(siddPathname);
+
+    six::NITFReadControl reader;
+    reader.setXMLControlRegistry(&helper.mXmlRegistry);
+    reader.load(siddPathname);
+    derivedData.reset(static_cast<six::sidd::DerivedData*>(
+            reader.getContainer()->getData(0)->clone()));
+
+    six::Region region;
+    const mem::ScopedArray<six::UByte> buffer(reader.interleaved(region, 0));
+    const sys::Uint16_T* const begin =
+            reinterpret_cast<const sys::Uint16_T*>(buffer.get());
+    pixels.assign(begin, begin + dims.area());
+
+    TestHelper::remove(siddPathname);
+}
+
+TEST_CASE(testGeometry)
+{
+    TestHelper helper;
+    std::auto_ptr<six::sidd::DerivedData> derivedData;
+    std::vector<sys::Uint16_T> pixels;
+    formSidd(helper, 1, six::product::SIDDProductGenerator::
+                     DEFAULT_MAX_BAND_BYTES, derivedData, pixels);
+
+    const size_t numRows = TestHelper::NUM_ROWS + 2 * TestHelper::PAD;
+    const size_t numCols = TestHelper::NUM_COLS + 2 * TestHelper::PAD;
+    TEST_ASSERT_EQ(derivedData->getNumRows(), numRows);
+    TEST_ASSERT_EQ(derivedData->getNumCols(), numCols);
+    TEST_ASSERT_EQ(derivedData->getPixelType(), six::PixelType::MONO16I);
+
+    // The product is referenced to its center
+    const six::sidd::PlaneProjection& projection =
+            *static_cast<const six::sidd::PlaneProjection*>(
+                    derivedData->measurement->projection.get());
+    const six::RowColDouble center((numRows - 1) / 2.0,
+                                   (numCols - 1) / 2.0);
+    TEST_ASSERT_ALMOST_EQ(projection.referencePoint.rowCol.row, center.row);
+    TEST_ASSERT_ALMOST_EQ(projection.referencePoint.rowCol.col, center.col);
+    TEST_ASSERT_ALMOST_EQ(projection.sampleSpacing.row, 1.0);
+    TEST_ASSERT_ALMOST_EQ(projection.sampleSpacing.col, 1.0);
+
+    const six::RowColDouble scpPixel(TestHelper::NUM_ROWS / 2 +
+                                             TestHelper::PAD,
+                                     TestHelper::NUM_COLS / 2 +
+                                             TestHelper::PAD);
+    const six::Vector3 expectedReference = helper.mScp +
+            helper.mEast * (center.row - scpPixel.row) +
+            helper.mNorth * (center.col - scpPixel.col);
+    for (size_t ii = 0; ii < 3; ++ii)
+    {
+        TEST_ASSERT_ALMOST_EQ_EPS(projection.referencePoint.ecef[ii],
+                                  expectedReference[ii], 1e-3);
+        TEST_ASSERT_ALMOST_EQ_EPS(projection.productPlane.rowUnitVector[ii],
+                                  helper.mEast[ii], 1e-9);
+        TEST_ASSERT_ALMOST_EQ_EPS(projection.productPlane.colUnitVector[ii],
+                                  helper.mNorth[ii], 1e-9);
+    }
+}
+
+TEST_CASE(testKnownPixels)
+{
+    TestHelper helper;
+    std::auto_ptr<six::sidd::DerivedData> derivedData;
+    std::vector<sys::Uint16_T> pixels;
+    formSidd(helper, 1, six::product::SIDDProductGenerator::
+                     DEFAULT_MAX_BAND_BYTES, derivedData, pixels);
+
+    // The clip value is a multiple of the mean amplitude
+    double sum = 0;
+    for (size_t row = 0; row < TestHelper::NUM_ROWS; ++row)
+    {
+        for (size_t col = 0; col < TestHelper::NUM_COLS; ++col)
+        {
+            sum += TestHelper::amplitude(row, col);
+        }
+    }
+    const double expectedClip =
+            six::product::SIDDProductGenerator::DEFAULT_CLIP_FACTOR * sum /
+            (TestHelper::NUM_ROWS * TestHelper::NUM_COLS);
+
+    const six::sidd::MonochromeDisplayRemap& remapInfo =
+            dynamic_cast<const six::sidd::MonochromeDisplayRemap&>(
+                    *derivedData->display->remapInformation);
+    const double clipValue =
+            remapInfo.remapParameters.findParameter("ClipValue");
+    TEST_ASSERT_ALMOST_EQ_EPS(clipValue, expectedClip, 1e-3);
+    const six::product::LinearRemap remap(clipValue,
+                                          six::PixelType::MONO16I);
+
+    const size_t numCols = TestHelper::NUM_COLS + 2 * TestHelper::PAD;
+    for (size_t row = 0; row < TestHelper::NUM_ROWS; ++row)
+    {
+        for (size_t col = 0; col < TestHelper::NUM_COLS; ++col)
+        {
+            const float amplitude = TestHelper::amplitude(row, col);
+            sys::Uint16_T expected;
+            remap.apply(&amplitude, 1,
+                        reinterpret_cast<six::UByte*>(&expected));
+
+            const sys::Uint16_T actual =
+                    pixels[(row + TestHelper::PAD) * numCols +
+                           col + TestHelper::PAD];
+            TEST_ASSERT_LESSER_EQ(::abs(static_cast<int>(actual) -
+                                        static_cast<int>(expected)), 1);
+        }
+    }
+
+    // Two or more pixels off the SICD is outside of any bilinear kernel
+    for (size_t row = 0; row < TestHelper::PAD - 1; ++row)
+    {
+        for (size_t col = 0; col < numCols; ++col)
+        {
+            TEST_ASSERT_EQ(pixels[row * numCols + col], 0);
+        }
+    }
+    for (size_t row = TestHelper::PAD; row < TestHelper::PAD + 5; ++row)
+    {
+        TEST_ASSERT_EQ(pixels[row * numCols], 0);
+        TEST_ASSERT_EQ(pixels[row * numCols + numCols - 1], 0);
+    }
+}
+
+TEST_CASE(testBandSplit)
+{
+    TestHelper helper;
+    std::auto_ptr<six::sidd::DerivedData> derivedData;
+    std::vector<sys::Uint16_T> expected;
+    formSidd(helper, 1, six::product::SIDDProductGenerator::
+                     DEFAULT_MAX_BAND_BYTES, derivedData, expected);
+
+    // Room for a few slant plane rows (complex pixels plus amplitudes), so
+    // each band is a single output row and reads its own window of the SICD
+    const size_t maxBandBytes = 3 * TestHelper::NUM_COLS *
+            (sizeof(std::complex<float>) + sizeof(float));
+    for (size_t numThreads = 1; numThreads <= 4; numThreads += 3)
+    {
+        std::vector<sys::Uint16_T> pixels;
+        formSidd(helper, numThreads, maxBandBytes, derivedData, pixels);
+        TEST_ASSERT(pixels == expected);
+    }
+
+    std::vector<sys::Uint16_T> pixels;
+    formSidd(helper, 4, six::product::SIDDProductGenerator::
+                     DEFAULT_MAX_BAND_BYTES, derivedData, pixels);
+    TEST_ASSERT(pixels == expected);
+}
+}
+
+int main(int, char**)
+{
+    TEST_CHECK(testGeometry);
+    TEST_CHECK(testKnownPixels);
+    TEST_CHECK(testBandSplit);
+    return 0;
+}
@@ -63,6 +63,15 @@ protected:
      */
     virtual xml::lite::Document* toXMLImpl(const Data* data);
 
+    /*!
+     *  This function writes a ComplexData object out as XML as the
+     *  parser creates each element, without holding a DOM.
+     *
+     *  \param data A ComplexData object
+     *  \param writer Writer to send the XML to
+     */
+    virtual void toXMLImpl(const Data* data, XMLStreamWriter& writer);
+
     /*!
      *  Function takes a DOM Document* node and creates a new-allocated
      *  ComplexData* populated by the DOM.  
@@ -46,6 +46,8 @@ public:
 
     ComplexData* fromXML(const xml::lite::Document* doc) const;
 
+    virtual void setXMLWriter(XMLStreamWriter* writer);
+
 protected:
 
     virtual XMLElem convertGeoInfoToXML(const GeoInfo *obj,
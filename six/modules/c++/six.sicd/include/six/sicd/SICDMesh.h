@@ -286,6 +286,65 @@ protected:
     std::vector<double> mAzimuthAmbiguityNoise;
     std::vector<double> mCombinedNoise;
 };
+
+/*!
+ *  \class MeshInterpolator
+ *  \brief Bilinearly interpolates values given at the nodes of a
+ *   PlanarCoordinateMesh (e.g. the noise values of a NoiseMesh).
+ *
+ *  The mesh must be rectilinear: x is the same across each mesh row and y
+ *  is the same down each mesh column, and both change monotonically.  The
+ *  mesh axes are worked out once at construction so each lookup is just a
+ *  search (or, for evenly spaced axes, a divide) per axis.  Points outside
+ *  the mesh get the value at the nearest edge.  Interpolating only reads
+ *  the object, so one can be shared across threads.
+ */
+class MeshInterpolator
+{
+public:
+    /*!
+     * \param mesh The mesh.  Only its coordinates are used, so it may go
+     * away afterwards.
+     * \throws except::Exception if the mesh is empty or isn't rectilinear
+     */
+    MeshInterpolator(const PlanarCoordinateMesh& mesh);
+
+    //! \return The mesh dimensions
+    types::RowCol<size_t> getMeshDims() const
+    {
+        return types::RowCol<size_t>(mX.coords.size(), mY.coords.size());
+    }
+
+    /*!
+     * Interpolates the values at a point
+     *
+     * \param values Flattened values at the mesh nodes (e.g.
+     * NoiseMesh::getCombinedNoise()).  There must be one per node.
+     * \param x X coordinate (distance from SCP row)
+     * \param y Y coordinate (distance from SCP col)
+     * \return The interpolated value
+     */
+    double interpolate(const std::vector<double>& values,
+                       double x,
+                       double y) const;
+
+private:
+    //! Coordinates of the mesh along one dimension
+    struct Axis
+    {
+        std::vector<double> coords;
+        bool increasing;
+        bool uniform;
+
+        void initialize(const std::string& name);
+
+        //! Finds the node before value and how far along to the next one
+        void locate(double value, size_t& index, double& fraction) const;
+    };
+
+    Axis mX;
+    Axis mY;
+};
 }
 }
 #endif
@@ -53,6 +53,24 @@ xml::lite::Document* ComplexXMLControl::toXMLImpl(const Data* data)
     return getParser(data->getVersion())->toXML(sicd);
 }
 
+void ComplexXMLControl::toXMLImpl(const Data* data, XMLStreamWriter& writer)
+{
+    if (data->getDataType() != DataType::COMPLEX)
+    {
+        throw except::Exception(Ctxt("Data must be SICD"));
+    }
+
+    const ComplexData* const sicd(reinterpret_cast<const ComplexData*>(data));
+    const std::auto_ptr<ComplexXMLParser> parser(
+            getParser(data->getVersion()));
+    parser->setXMLWriter(&writer);
+
+    // The document only holds the root, which the writer needs until it's
+    // closed
+    const std::auto_ptr<xml::lite::Document> doc(parser->toXML(sicd));
+    writer.close();
+}
+
 std::auto_ptr<ComplexXMLParser>
 ComplexXMLControl::getParser(const std::string& version) const
 {
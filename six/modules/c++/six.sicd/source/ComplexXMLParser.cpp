@@ -44,6 +44,12 @@ ComplexXMLParser::ComplexXMLParser(const std::string& version,
 {
 }
 
+void ComplexXMLParser::setXMLWriter(XMLStreamWriter* writer)
+{
+    XMLParser::setXMLWriter(writer);
+    mCommon->setXMLWriter(writer);
+}
+
 ComplexData* ComplexXMLParser::fromXML(const xml::lite::Document* doc) const
 {
     ComplexDataBuilder builder;
@@ -144,7 +150,7 @@ xml::lite::Document* ComplexXMLParser::toXML(const ComplexData* sicd) const
 {
     xml::lite::Document* doc = new xml::lite::Document();
 
-    XMLElem root = newElement("SICD");
+    XMLElem root = createElement("SICD");
     doc->setRootElement(root);
 
     common().convertCollectionInformationToXML(
@@ -182,7 +188,7 @@ xml::lite::Document* ComplexXMLParser::toXML(const ComplexData* sicd) const
     convertImageFormationAlgoToXML(sicd->pfa.get(), sicd->rma.get(), sicd->rgAzComp.get(), root);
 
     //set the XMLNS
-    root->setNamespacePrefix("", getDefaultURI());
+    setNamespacePrefixes(root);
     //        root->setNamespacePrefix("si", common().getSICommonURI());
 
     return doc;
@@ -199,7 +205,7 @@ XMLElem ComplexXMLParser::convertImageCreationToXML(
     const ImageCreation *imageCreation,
     XMLElem parent) const
 {
-    XMLElem imageCreationXML = newElement("ImageCreation", parent);
+    XMLElem imageCreationXML = createElement("ImageCreation", parent);
 
     const std::string si = common().getSICommonURI();
 
@@ -219,13 +225,13 @@ XMLElem ComplexXMLParser::convertImageCreationToXML(
 XMLElem ComplexXMLParser::convertImageDataToXML(
     const ImageData *imageData, XMLElem parent) const
 {
-    XMLElem imageDataXML = newElement("ImageData", parent);
+    XMLElem imageDataXML = createElement("ImageData", parent);
 
     createString("PixelType", six::toString(imageData->pixelType), imageDataXML);
     if (imageData->amplitudeTable.get())
     {
         const AmplitudeTable& ampTable = *imageData->amplitudeTable;
-        XMLElem ampTableXML = newElement("AmpTable", imageDataXML);
+        XMLElem ampTableXML = createElement("AmpTable", imageDataXML);
         setAttribute(ampTableXML, "size", str::toString(ampTable.numEntries));
         for (size_t i = 0; i < ampTable.numEntries; ++i)
         {
@@ -247,7 +253,7 @@ XMLElem ComplexXMLParser::convertImageDataToXML(
     const size_t numVertices = imageData->validData.size();
     if (numVertices >= 3)
     {
-        XMLElem vXML = newElement("ValidData", imageDataXML);
+        XMLElem vXML = createElement("ValidData", imageDataXML);
         setAttribute(vXML, "size", str::toString(numVertices));
 
         for (size_t ii = 0; ii < numVertices; ++ii)
@@ -263,11 +269,11 @@ XMLElem ComplexXMLParser::convertImageDataToXML(
 XMLElem ComplexXMLParser::convertGeoDataToXML(
     const GeoData *geoData, XMLElem parent) const
 {
-    XMLElem geoDataXML = newElement("GeoData", parent);
+    XMLElem geoDataXML = createElement("GeoData", parent);
 
     common().createEarthModelType("EarthModel", geoData->earthModel, geoDataXML);
 
-    XMLElem scpXML = newElement("SCP", geoDataXML);
+    XMLElem scpXML = createElement("SCP", geoDataXML);
     common().createVector3D("ECF", geoData->scp.ecf, scpXML);
     common().createLatLonAlt("LLH", geoData->scp.llh, scpXML);
 
@@ -277,7 +283,7 @@ XMLElem ComplexXMLParser::convertGeoDataToXML(
     const size_t numVertices = geoData->validData.size();
     if (numVertices >= 3)
     {
-        XMLElem vXML = newElement("ValidData", geoDataXML);
+        XMLElem vXML = createElement("ValidData", geoDataXML);
         setAttribute(vXML, "size", str::toString(numVertices));
 
         for (size_t ii = 0; ii < numVertices; ++ii)
@@ -299,13 +305,13 @@ XMLElem ComplexXMLParser::convertGeoDataToXML(
 XMLElem ComplexXMLParser::convertGridToXML(
     const Grid *grid, XMLElem parent) const
 {
-    XMLElem gridXML = newElement("Grid", parent);
+    XMLElem gridXML = createElement("Grid", parent);
 
     createString("ImagePlane", six::toString(grid->imagePlane), gridXML);
     createString("Type", six::toString(grid->type), gridXML);
     common().createPoly2D("TimeCOAPoly", grid->timeCOAPoly, gridXML);
 
-    XMLElem rowDirXML = newElement("Row", gridXML);
+    XMLElem rowDirXML = createElement("Row", gridXML);
 
     common().createVector3D("UVectECF", grid->row->unitVector, rowDirXML);
     createDouble("SS", grid->row->sampleSpacing, rowDirXML);
@@ -329,7 +335,7 @@ XMLElem ComplexXMLParser::convertGridToXML(
     size_t numWeights = grid->row->weights.size();
     if (numWeights > 0)
     {
-        XMLElem wgtFuncXML = newElement("WgtFunct", rowDirXML);
+        XMLElem wgtFuncXML = createElement("WgtFunct", rowDirXML);
         setAttribute(wgtFuncXML, "size", str::toString(numWeights));
 
         for (size_t i = 1; i <= numWeights; ++i)
@@ -340,7 +346,7 @@ XMLElem ComplexXMLParser::convertGridToXML(
         }
     }
 
-    XMLElem colDirXML = newElement("Col", gridXML);
+    XMLElem colDirXML = createElement("Col", gridXML);
 
     common().createVector3D("UVectECF", grid->col->unitVector, colDirXML);
     createDouble("SS", grid->col->sampleSpacing, colDirXML);
@@ -364,7 +370,7 @@ XMLElem ComplexXMLParser::convertGridToXML(
     numWeights = grid->col->weights.size();
     if (numWeights > 0)
     {
-        XMLElem wgtFuncXML = newElement("WgtFunct", colDirXML);
+        XMLElem wgtFuncXML = createElement("WgtFunct", colDirXML);
         setAttribute(wgtFuncXML, "size", str::toString(numWeights));
 
         for (size_t i = 1; i <= numWeights; ++i)
@@ -381,21 +387,21 @@ XMLElem ComplexXMLParser::convertGridToXML(
 XMLElem ComplexXMLParser::convertTimelineToXML(
     const Timeline *timeline, XMLElem parent) const
 {
-    XMLElem timelineXML = newElement("Timeline", parent);
+    XMLElem timelineXML = createElement("Timeline", parent);
 
     createDateTime("CollectStart", timeline->collectStart, timelineXML);
     createDouble("CollectDuration", timeline->collectDuration, timelineXML);
 
     if (timeline->interPulsePeriod.get())
     {
-        XMLElem ippXML = newElement("IPP", timelineXML);
+        XMLElem ippXML = createElement("IPP", timelineXML);
         size_t setSize = timeline->interPulsePeriod->sets.size();
         ippXML->attribute("size") = str::toString<size_t>(setSize);
 
         for (size_t i = 0; i < setSize; ++i)
         {
             const TimelineSet& timelineSet = timeline->interPulsePeriod->sets[i];
-            XMLElem setXML = newElement("Set", ippXML);
+            XMLElem setXML = createElement("Set", ippXML);
             setXML->attribute("index") = str::toString<size_t>(i + 1);
 
             createDouble("TStart", timelineSet.tStart, setXML);
@@ -412,7 +418,7 @@ XMLElem ComplexXMLParser::convertTimelineToXML(
 XMLElem ComplexXMLParser::convertPositionToXML(
     const Position *position, XMLElem parent) const
 {
-    XMLElem positionXML = newElement("Position", parent);
+    XMLElem positionXML = createElement("Position", parent);
 
     common().createPolyXYZ("ARPPoly", position->arpPoly, positionXML);
     if (!Init::isUndefined(position->grpPoly))
@@ -422,7 +428,7 @@ XMLElem ComplexXMLParser::convertPositionToXML(
     if (position->rcvAPC.get() && !position->rcvAPC->rcvAPCPolys.empty())
     {
         size_t numPolys = position->rcvAPC->rcvAPCPolys.size();
-        XMLElem rcvXML = newElement("RcvAPC", positionXML);
+        XMLElem rcvXML = createElement("RcvAPC", positionXML);
         setAttribute(rcvXML, "size", str::toString(numPolys));
 
         for (size_t i = 0; i < numPolys; ++i)
@@ -438,7 +444,7 @@ XMLElem ComplexXMLParser::convertPositionToXML(
 XMLElem ComplexXMLParser::createTxFrequency(const RadarCollection* radar,
                                             XMLElem parent) const
 {
-    XMLElem txFreqXML = newElement("TxFrequency", parent);
+    XMLElem txFreqXML = createElement("TxFrequency", parent);
     createDouble("Min", radar->txFrequencyMin, txFreqXML);
     createDouble("Max", radar->txFrequencyMax, txFreqXML);
     return txFreqXML;
@@ -453,14 +459,14 @@ XMLElem ComplexXMLParser::createTxSequence(const RadarCollection* radar,
     }
     else
     {
-        XMLElem txSeqXML = newElement("TxSequence", parent);
+        XMLElem txSeqXML = createElement("TxSequence", parent);
         setAttribute(txSeqXML, "size", str::toString(radar->txSequence.size()));
 
         for (size_t ii = 0; ii < radar->txSequence.size(); ++ii)
         {
             const TxStep* const tx = radar->txSequence[ii].get();
 
-            XMLElem txStepXML = newElement("TxStep", txSeqXML);
+            XMLElem txStepXML = createElement("TxStep", txSeqXML);
             setAttribute(txStepXML, "index", str::toString(ii + 1));
 
             if (!Init::isUndefined(tx->waveformIndex))
@@ -488,14 +494,14 @@ XMLElem ComplexXMLParser::createWaveform(const RadarCollection* radar,
     else
     {
         const size_t numWaveforms = radar->waveform.size();
-        XMLElem wfXML = newElement("Waveform", parent);
+        XMLElem wfXML = createElement("Waveform", parent);
         setAttribute(wfXML, "size", str::toString(numWaveforms));
 
         for (size_t ii = 0; ii < numWaveforms; ++ii)
         {
             const WaveformParameters* const wf = radar->waveform[ii].get();
 
-            XMLElem wfpXML = newElement("WFParameters", wfXML);
+            XMLElem wfpXML = createElement("WFParameters", wfXML);
             setAttribute(wfpXML, "index", str::toString(ii + 1));
 
             if (!Init::isUndefined(wf->txPulseLength))
@@ -534,7 +540,7 @@ XMLElem ComplexXMLParser::createArea(const RadarCollection* radar,
     }
     else
     {
-        XMLElem areaXML = newElement("Area", parent);
+        XMLElem areaXML = createElement("Area", parent);
         const Area* const area = radar->area.get();
 
         bool haveACPCorners = true;
@@ -556,8 +562,8 @@ XMLElem ComplexXMLParser::createArea(const RadarCollection* radar,
         const AreaPlane* const plane = area->plane.get();
         if (plane)
         {
-            XMLElem planeXML = newElement("Plane", areaXML);
-            XMLElem refPtXML = newElement("RefPt", planeXML);
+            XMLElem planeXML = createElement("Plane", areaXML);
+            XMLElem refPtXML = createElement("RefPt", planeXML);
 
             ReferencePoint refPt = plane->referencePoint;
             if (!refPt.name.empty())
@@ -574,14 +580,14 @@ XMLElem ComplexXMLParser::createArea(const RadarCollection* radar,
 
             if (!plane->segmentList.empty())
             {
-                XMLElem segListXML = newElement("SegmentList", planeXML);
+                XMLElem segListXML = createElement("SegmentList", planeXML);
                 setAttribute(segListXML, "size",
                              str::toString(plane->segmentList.size()));
 
                 for (size_t ii = 0; ii < plane->segmentList.size(); ++ii)
                 {
                     const Segment* const segment = plane->segmentList[ii].get();
-                    XMLElem segXML = newElement("Segment", segListXML);
+                    XMLElem segXML = createElement("Segment", segListXML);
                     setAttribute(segXML, "index", str::toString(ii + 1));
 
                     createInt("StartLine", segment->startLine, segXML);
@@ -609,7 +615,7 @@ XMLElem ComplexXMLParser::areaLineDirectionParametersToXML(
     const AreaDirectionParameters *adp,
     XMLElem parent) const
 {
-    XMLElem adpXML = newElement(name, parent);
+    XMLElem adpXML = createElement(name, parent);
     common().createVector3D("UVectECF", adp->unitVector, adpXML);
     createDouble("LineSpacing", adp->spacing, adpXML);
     createInt("NumLines", static_cast<int>(adp->elements), adpXML);
@@ -622,7 +628,7 @@ XMLElem ComplexXMLParser::areaSampleDirectionParametersToXML(
     const AreaDirectionParameters *adp,
     XMLElem parent) const
 {
-    XMLElem adpXML = newElement(name, parent);
+    XMLElem adpXML = createElement(name, parent);
     common().createVector3D("UVectECF", adp->unitVector, adpXML);
     createDouble("SampleSpacing", adp->spacing, adpXML);
     createInt("NumSamples", static_cast<int>(adp->elements), adpXML);
@@ -634,7 +640,7 @@ XMLElem ComplexXMLParser::convertSCPCOAToXML(
     const SCPCOA *scpcoa,
     XMLElem parent) const
 {
-    XMLElem scpcoaXML = newElement("SCPCOA", parent);
+    XMLElem scpcoaXML = createElement("SCPCOA", parent);
     createDouble("SCPTime", scpcoa->scpTime, scpcoaXML);
     common().createVector3D("ARPPos", scpcoa->arpPos, scpcoaXML);
     common().createVector3D("ARPVel", scpcoa->arpVel, scpcoaXML);
@@ -655,7 +661,7 @@ XMLElem ComplexXMLParser::convertAntennaToXML(
     const Antenna *antenna,
     XMLElem parent) const
 {
-    XMLElem antennaXML = newElement("Antenna", parent);
+    XMLElem antennaXML = createElement("Antenna", parent);
 
     if (antenna->tx.get())
     {
@@ -677,7 +683,7 @@ XMLElem ComplexXMLParser::convertAntennaParametersToXML(
     AntennaParameters *params,
     XMLElem parent) const
 {
-    XMLElem apXML = newElement(name, parent);
+    XMLElem apXML = createElement(name, parent);
 
     common().createPolyXYZ("XAxisPoly", params->xAxisPoly, apXML);
     common().createPolyXYZ("YAxisPoly", params->yAxisPoly, apXML);
@@ -685,7 +691,7 @@ XMLElem ComplexXMLParser::convertAntennaParametersToXML(
 
     if (params->electricalBoresight.get())
     {
-        XMLElem ebXML = newElement("EB", apXML);
+        XMLElem ebXML = createElement("EB", apXML);
         common().createPoly1D("DCXPoly", params->electricalBoresight->dcxPoly, ebXML);
         common().createPoly1D("DCYPoly", params->electricalBoresight->dcyPoly, ebXML);
     }
@@ -696,7 +702,7 @@ XMLElem ComplexXMLParser::convertAntennaParametersToXML(
 
     if (params->element.get())
     {
-        XMLElem elemXML = newElement("Elem", apXML);
+        XMLElem elemXML = createElement("Elem", apXML);
         common().createPoly2D("GainPoly", params->element->gainPoly, elemXML);
         common().createPoly2D("PhasePoly", params->element->phasePoly, elemXML);
     }
@@ -717,7 +723,7 @@ XMLElem ComplexXMLParser::convertPFAToXML(
     const PFA *pfa,
     XMLElem parent) const
 {
-    XMLElem pfaXML = newElement("PFA", parent);
+    XMLElem pfaXML = createElement("PFA", parent);
 
     common().createVector3D("FPN", pfa->focusPlaneNormal, pfaXML);
     common().createVector3D("IPN", pfa->imagePlaneNormal, pfaXML);
@@ -731,7 +737,7 @@ XMLElem ComplexXMLParser::convertPFAToXML(
     createDouble("Kaz2", pfa->kaz2, pfaXML);
     if (pfa->slowTimeDeskew.get())
     {
-        XMLElem stdXML = newElement("STDeskew", pfaXML);
+        XMLElem stdXML = createElement("STDeskew", pfaXML);
         require(createBooleanType("Applied", pfa->slowTimeDeskew->applied,
                                   stdXML), "Applied");
 
@@ -756,7 +762,7 @@ XMLElem ComplexXMLParser::convertRMCRToXML(
 {
     createString("ImageType", "RMCR", rmaXML);
 
-    XMLElem rmcrXML = newElement("RMCR", rmaXML);
+    XMLElem rmcrXML = createElement("RMCR", rmaXML);
 
     common().createVector3D("PosRef", rmcr->refPos, rmcrXML);
     common().createVector3D("VelRef", rmcr->refVel, rmcrXML);
@@ -771,7 +777,7 @@ XMLElem ComplexXMLParser::convertINCAToXML(
 {
     createString("ImageType", "INCA", rmaXML);
 
-    XMLElem incaXML = newElement("INCA", rmaXML);
+    XMLElem incaXML = createElement("INCA", rmaXML);
 
     common().createPoly1D("TimeCAPoly", inca->timeCAPoly, incaXML);
     createDouble("R_CA_SCP", inca->rangeCA, incaXML);
@@ -803,7 +809,7 @@ XMLElem ComplexXMLParser::convertRcvChanProcToXML(
 {
     if (rcvChanProc)
     {
-        XMLElem rcvChanXML = newElement("RcvChanProc", imageFormationXML);
+        XMLElem rcvChanXML = createElement("RcvChanProc", imageFormationXML);
         createInt("NumChanProc",
                   rcvChanProc->numChannelsProcessed,
                   rcvChanXML);
@@ -835,7 +841,7 @@ XMLElem ComplexXMLParser::convertDistortionToXML(
 {
     if (distortion)
     {
-        XMLElem distortionXML = newElement("Distortion", pcXML);
+        XMLElem distortionXML = createElement("Distortion", pcXML);
 
         //This should be optionally added...
         createDateTime("CalibrationDate", distortion->calibrationDate,
@@ -878,7 +884,7 @@ XMLElem ComplexXMLParser::convertRgAzCompToXML(
     const RgAzComp* rgAzComp,
     XMLElem parent) const
 {
-    XMLElem rgAzCompXML = newElement("RgAzComp", parent);
+    XMLElem rgAzCompXML = createElement("RgAzComp", parent);
 
     createDouble("AzSF", rgAzComp->azSF, rgAzCompXML);
     common().createPoly1D("KazPoly", rgAzComp->kazPoly, rgAzCompXML);
@@ -1807,7 +1813,7 @@ XMLElem ComplexXMLParser::createLatLonAltFootprint(const std::string& name,
                                                    const LatLonAltCorners& corners,
                                                    XMLElem parent) const
 {
-    XMLElem footprint = newElement(name, parent);
+    XMLElem footprint = createElement(name, parent);
 
     // Write the corners in CW order
     XMLElem vertex =
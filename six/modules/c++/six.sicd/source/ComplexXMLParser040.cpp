@@ -50,7 +50,7 @@ XMLElem ComplexXMLParser040::convertRMATToXML(
 {
     createString("ImageType", "RMAT", rmaXML);
 
-    XMLElem rmatXML = newElement("RMAT", rmaXML);
+    XMLElem rmatXML = createElement("RMAT", rmaXML);
 
     createDouble("RMRefTime", rmat->refTime, rmatXML);
     common().createVector3D("RMPosRef", rmat->refPos, rmatXML);
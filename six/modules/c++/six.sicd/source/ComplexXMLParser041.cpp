@@ -60,7 +60,7 @@ XMLElem ComplexXMLParser041::convertRMATToXML(
 {
     createString("ImageType", "RMAT", rmaXML);
 
-    XMLElem rmatXML = newElement("RMAT", rmaXML);
+    XMLElem rmatXML = createElement("RMAT", rmaXML);
 
     createDouble("RefTime", rmat->refTime, rmatXML);
     common().createVector3D("PosRef", rmat->refPos, rmatXML);
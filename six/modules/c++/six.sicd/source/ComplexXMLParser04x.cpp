@@ -47,7 +47,7 @@ XMLElem ComplexXMLParser04x::convertGeoInfoToXML(
     XMLElem parent) const
 {
     //! 0.4.x has ordering (1. GeoInfo, 2. Desc, 3. choice)
-    XMLElem geoInfoXML = newElement("GeoInfo", parent);
+    XMLElem geoInfoXML = createElement("GeoInfo", parent);
     if (!geoInfo->name.empty())
         setAttribute(geoInfoXML, "name", geoInfo->name);
 
@@ -65,8 +65,8 @@ XMLElem ComplexXMLParser04x::convertGeoInfoToXML(
     }
     else if (numLatLons >= 2)
     {
-        XMLElem linePolyXML = newElement(numLatLons == 2 ? "Line" : "Polygon",
-                                         geoInfoXML);
+        XMLElem linePolyXML = createElement(numLatLons == 2 ? "Line" : "Polygon",
+                                            geoInfoXML);
         setAttribute(linePolyXML, "size", str::toString(numLatLons));
 
         for (size_t ii = 0; ii < numLatLons; ++ii)
@@ -90,7 +90,7 @@ XMLElem ComplexXMLParser04x::convertRadarCollectionToXML(
     const RadarCollection *radar,
     XMLElem parent) const
 {
-    XMLElem radarXML = newElement("RadarCollection", parent);
+    XMLElem radarXML = createElement("RadarCollection", parent);
 
     if (!Init::isUndefined(radar->refFrequencyIndex))
     {
@@ -131,7 +131,7 @@ XMLElem ComplexXMLParser04x::convertImageFormationToXML(
 {
     //! this segment was recreated completely because the ordering of
     //! a lot of the variables has been updated
-    XMLElem imageFormationXML = newElement("ImageFormation", parent);
+    XMLElem imageFormationXML = createElement("ImageFormation", parent);
 
     if (radarCollection.area.get() != NULL &&
         radarCollection.area->plane.get() != NULL &&
@@ -163,7 +163,7 @@ XMLElem ComplexXMLParser04x::convertImageFormationToXML(
     createDouble("TStartProc", imageFormation->tStartProc, imageFormationXML);
     createDouble("TEndProc", imageFormation->tEndProc, imageFormationXML);
 
-    XMLElem txFreqXML = newElement("TxFrequencyProc", imageFormationXML);
+    XMLElem txFreqXML = createElement("TxFrequencyProc", imageFormationXML);
     createDouble("MinProc", imageFormation->txFrequencyProcMin, txFreqXML);
     createDouble("MaxProc", imageFormation->txFrequencyProcMax, txFreqXML);
 
@@ -183,7 +183,7 @@ XMLElem ComplexXMLParser04x::convertImageFormationToXML(
     {
         const Processing* proc = &imageFormation->processing[i];
 
-        XMLElem procXML = newElement("Processing", imageFormationXML);
+        XMLElem procXML = createElement("Processing", imageFormationXML);
 
         createString("Type", proc->type, procXML);
         require(createBooleanType("Applied", proc->applied, procXML), "Applied");
@@ -193,7 +193,7 @@ XMLElem ComplexXMLParser04x::convertImageFormationToXML(
     if (imageFormation->polarizationCalibration.get())
     {
         XMLElem pcXML =
-                newElement("PolarizationCalibration", imageFormationXML);
+                createElement("PolarizationCalibration", imageFormationXML);
 
         require(createBooleanType(
             "HVAngleCompApplied",
@@ -244,7 +244,7 @@ XMLElem ComplexXMLParser04x::convertRMAToXML(
     const RMA* rma,
     XMLElem parent) const
 {
-    XMLElem rmaXML = newElement("RMA", parent);
+    XMLElem rmaXML = createElement("RMA", parent);
 
     createString("RMAlgoType", six::toString<six::RMAlgoType>(rma->algoType),
                  rmaXML);
@@ -278,7 +278,7 @@ XMLElem ComplexXMLParser04x::convertRMATToXML(
 {
     createString("ImageType", "RMAT", rmaXML);
 
-    XMLElem rmatXML = newElement("RMAT", rmaXML);
+    XMLElem rmatXML = createElement("RMAT", rmaXML);
 
     createDouble("RefTime", rmat->refTime, rmatXML);
     common().createVector3D("PosRef", rmat->refPos, rmatXML);
@@ -299,7 +299,7 @@ XMLElem ComplexXMLParser04x::convertHPBWToXML(
 {
     if (halfPowerBeamwidths)
     {
-        XMLElem hpXML = newElement("HPBW", parent);
+        XMLElem hpXML = createElement("HPBW", parent);
         createDouble("DCX", halfPowerBeamwidths->dcx, hpXML);
         createDouble("DCY", halfPowerBeamwidths->dcy, hpXML);
         return hpXML;
@@ -318,7 +318,7 @@ XMLElem ComplexXMLParser04x::convertAntennaParamArrayToXML(
     //! optional field in 0.4
     if (array)
     {
-        XMLElem arrXML = newElement("Array", apXML);
+        XMLElem arrXML = createElement("Array", apXML);
         common().createPoly2D("GainPoly", array->gainPoly, arrXML);
         common().createPoly2D("PhasePoly", array->phasePoly, arrXML);
         return arrXML;
@@ -413,12 +413,12 @@ XMLElem ComplexXMLParser04x::createRcvChannels(const RadarCollection* radar,
                                                XMLElem parent) const
 {
     const size_t numChannels = radar->rcvChannels.size();
-    XMLElem rcvChanXML = newElement("RcvChannels", parent);
+    XMLElem rcvChanXML = createElement("RcvChannels", parent);
     setAttribute(rcvChanXML, "size", str::toString(numChannels));
     for (size_t ii = 0; ii < numChannels; ++ii)
     {
         const ChannelParameters* const cp = radar->rcvChannels[ii].get();
-        XMLElem cpXML = newElement("ChanParameters", rcvChanXML);
+        XMLElem cpXML = createElement("ChanParameters", rcvChanXML);
         setAttribute(cpXML, "index", str::toString(ii + 1));
 
         if (!Init::isUndefined(cp->rcvAPCIndex))
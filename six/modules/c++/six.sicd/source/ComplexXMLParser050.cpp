@@ -53,7 +53,7 @@ XMLElem SICommonXMLParser050::convertRadiometryToXML(
     const six::Radiometric* r, XMLElem parent) const
 {
     std::string defaultURI = getSICommonURI();
-    XMLElem rXML = newElement("Radiometric", getDefaultURI(), parent);
+    XMLElem rXML = createElement("Radiometric", getDefaultURI(), parent);
 
     if (!r->noiseLevel.noisePoly.empty())
     {
@@ -193,7 +193,7 @@ XMLElem ComplexXMLParser050::convertWeightTypeToXML(
     const WeightType& obj,
     XMLElem parent) const
 {
-    XMLElem weightTypeXML = newElement("WgtType", parent);
+    XMLElem weightTypeXML = createElement("WgtType", parent);
     createString("WindowName", obj.windowName, weightTypeXML);
 
     common().addParameters("Parameter", obj.parameters, weightTypeXML);
@@ -255,12 +255,12 @@ XMLElem ComplexXMLParser050::convertMatchInformationToXML(
     const MatchInformation& matchInfo,
     XMLElem parent) const
 {
-    XMLElem matchInfoXML = newElement("MatchInfo", parent);
+    XMLElem matchInfoXML = createElement("MatchInfo", parent);
 
     for (size_t i = 0; i < matchInfo.types.size(); ++i)
     {
         const MatchType& mt = matchInfo.types[i];
-        XMLElem mtXML = newElement("Collect", matchInfoXML);
+        XMLElem mtXML = createElement("Collect", matchInfoXML);
         setAttribute(mtXML, "index", str::toString(i + 1));
 
         createString("CollectorName", mt.collectorName, mtXML);
@@ -42,7 +42,7 @@ XMLElem ComplexXMLParser100::convertGeoInfoToXML(
     XMLElem parent) const
 {
     //! 1.0.0 has ordering (1. Desc, 2. GeoInfo, 3. choice)
-    XMLElem geoInfoXML = newElement("GeoInfo", parent);
+    XMLElem geoInfoXML = createElement("GeoInfo", parent);
     if (!geoInfo->name.empty())
         setAttribute(geoInfoXML, "name", geoInfo->name);
 
@@ -60,8 +60,8 @@ XMLElem ComplexXMLParser100::convertGeoInfoToXML(
     }
     else if (numLatLons >= 2)
     {
-        XMLElem linePolyXML = newElement(numLatLons == 2 ? "Line" : "Polygon",
-                                         geoInfoXML);
+        XMLElem linePolyXML = createElement(numLatLons == 2 ? "Line" : "Polygon",
+                                            geoInfoXML);
         setAttribute(linePolyXML, "size", str::toString(numLatLons));
 
         for (size_t ii = 0; ii < numLatLons; ++ii)
@@ -41,7 +41,7 @@ XMLElem ComplexXMLParser101::convertGeoInfoToXML(
     XMLElem parent) const
 {
     //! 1.0.1 has ordering (1. Desc, 2. choice, 3. GeoInfo)
-    XMLElem geoInfoXML = newElement("GeoInfo", parent);
+    XMLElem geoInfoXML = createElement("GeoInfo", parent);
     if (!geoInfo->name.empty())
         setAttribute(geoInfoXML, "name", geoInfo->name);
 
@@ -54,8 +54,8 @@ XMLElem ComplexXMLParser101::convertGeoInfoToXML(
     }
     else if (numLatLons >= 2)
     {
-        XMLElem linePolyXML = newElement(numLatLons == 2 ? "Line" : "Polygon",
-                                         geoInfoXML);
+        XMLElem linePolyXML = createElement(numLatLons == 2 ? "Line" : "Polygon",
+                                            geoInfoXML);
         setAttribute(linePolyXML, "size", str::toString(numLatLons));
 
         for (size_t ii = 0; ii < numLatLons; ++ii)
@@ -56,7 +56,7 @@ XMLElem ComplexXMLParser10x::convertWeightTypeToXML(
     const WeightType& obj,
     XMLElem parent) const
 {
-    XMLElem weightTypeXML = newElement("WgtType", parent);
+    XMLElem weightTypeXML = createElement("WgtType", parent);
     createString("WindowName", obj.windowName, weightTypeXML);
 
     common().addParameters("Parameter", obj.parameters, weightTypeXML);
@@ -68,7 +68,7 @@ XMLElem ComplexXMLParser10x::convertRadarCollectionToXML(
     const RadarCollection *radar,
     XMLElem parent) const
 {
-    XMLElem radarXML = newElement("RadarCollection", parent);
+    XMLElem radarXML = createElement("RadarCollection", parent);
 
     createTxFrequency(radar, radarXML);
 
@@ -100,7 +100,7 @@ XMLElem ComplexXMLParser10x::convertImageFormationToXML(
 {
     //! this segment was recreated completely because the ordering of
     //! a lot of the variables has been updated
-    XMLElem imageFormationXML = newElement("ImageFormation", parent);
+    XMLElem imageFormationXML = createElement("ImageFormation", parent);
 
     convertRcvChanProcToXML("1.0", imageFormation->rcvChannelProcessed.get(),
                             imageFormationXML);
@@ -112,7 +112,7 @@ XMLElem ComplexXMLParser10x::convertImageFormationToXML(
     createDouble("TStartProc", imageFormation->tStartProc, imageFormationXML);
     createDouble("TEndProc", imageFormation->tEndProc, imageFormationXML);
 
-    XMLElem txFreqXML = newElement("TxFrequencyProc", imageFormationXML);
+    XMLElem txFreqXML = createElement("TxFrequencyProc", imageFormationXML);
     createDouble("MinProc", imageFormation->txFrequencyProcMin, txFreqXML);
     createDouble("MaxProc", imageFormation->txFrequencyProcMax, txFreqXML);
 
@@ -151,7 +151,7 @@ XMLElem ComplexXMLParser10x::convertImageFormationToXML(
     {
         const Processing* proc = &imageFormation->processing[i];
 
-        XMLElem procXML = newElement("Processing", imageFormationXML);
+        XMLElem procXML = createElement("Processing", imageFormationXML);
 
         createString("Type", proc->type, procXML);
         require(createBooleanType("Applied", proc->applied, procXML), "Applied");
@@ -161,7 +161,7 @@ XMLElem ComplexXMLParser10x::convertImageFormationToXML(
     if (imageFormation->polarizationCalibration.get())
     {
         XMLElem pcXML =
-                newElement("PolarizationCalibration", imageFormationXML);
+                createElement("PolarizationCalibration", imageFormationXML);
 
         require(createBooleanType("DistortCorrectionApplied",
                                   imageFormation ->polarizationCalibration->
@@ -221,7 +221,7 @@ XMLElem ComplexXMLParser10x::convertRMAToXML(
     const RMA* rma,
     XMLElem parent) const
 {
-    XMLElem rmaXML = newElement("RMA", parent);
+    XMLElem rmaXML = createElement("RMA", parent);
 
     createString("RMAlgoType", six::toString<six::RMAlgoType>(rma->algoType),
                  rmaXML);
@@ -254,7 +254,7 @@ XMLElem ComplexXMLParser10x::convertRMATToXML(
 {
     createString("ImageType", "RMAT", rmaXML);
 
-    XMLElem rmatXML = newElement("RMAT", rmaXML);
+    XMLElem rmatXML = createElement("RMAT", rmaXML);
 
     common().createVector3D("PosRef", rmat->refPos, rmatXML);
     common().createVector3D("VelRef", rmat->refVel, rmatXML);
@@ -279,7 +279,7 @@ XMLElem ComplexXMLParser10x::convertAntennaParamArrayToXML(
     //! mandatory field in 1.0
     if (array)
     {
-        XMLElem arrXML = newElement("Array", apXML);
+        XMLElem arrXML = createElement("Array", apXML);
         common().createPoly2D("GainPoly", array->gainPoly, arrXML);
         common().createPoly2D("PhasePoly", array->phasePoly, arrXML);
         return arrXML;
@@ -376,12 +376,12 @@ XMLElem ComplexXMLParser10x::createRcvChannels(const RadarCollection* radar,
                                                XMLElem parent) const
 {
     const size_t numChannels = radar->rcvChannels.size();
-    XMLElem rcvChanXML = newElement("RcvChannels", parent);
+    XMLElem rcvChanXML = createElement("RcvChannels", parent);
     setAttribute(rcvChanXML, "size", str::toString(numChannels));
     for (size_t ii = 0; ii < numChannels; ++ii)
     {
         const ChannelParameters* const cp = radar->rcvChannels[ii].get();
-        XMLElem cpXML = newElement("ChanParameters", rcvChanXML);
+        XMLElem cpXML = createElement("ChanParameters", rcvChanXML);
         setAttribute(cpXML, "index", str::toString(ii + 1));
 
         //! required in 1.0
@@ -19,11 +19,25 @@
  * see <http://www.gnu.org/licenses/>.
  *
  */
+#include <algorithm>
+#include <cmath>
+#include <functional>
 #include <numeric>
 
+#include <str/Convert.h>
 #include <six/sicd/SICDMesh.h>
 #include <six/Serialize.h>
 
+namespace
+{
+// How far (relative to the size of the mesh) a coordinate may be from the
+// one the rest of its mesh row/column has and still be considered the same
+const double RECTILINEAR_TOLERANCE = 1e-6;
+
+// Same thing for how far a coordinate may be off from an even spacing
+const double UNIFORM_TOLERANCE = 1e-9;
+}
+
 namespace six
 {
 namespace sicd
@@ -220,5 +234,149 @@ void NoiseMesh::deserialize(const sys::byte*& values)
     six::deserialize(values, mSwapBytes, mAzimuthAmbiguityNoise);
     six::deserialize(values, mSwapBytes, mCombinedNoise);
 }
+
+MeshInterpolator::MeshInterpolator(const PlanarCoordinateMesh& mesh)
+{
+    const types::RowCol<size_t> dims = mesh.getMeshDims();
+    const std::vector<double>& x = mesh.getX();
+    const std::vector<double>& y = mesh.getY();
+    if (dims.area() == 0 || x.size() != dims.area() ||
+        y.size() != dims.area())
+    {
+        throw except::Exception(Ctxt(
+                "Mesh '" + mesh.getName() + "' has no or mismatched data"));
+    }
+
+    mX.coords.resize(dims.row);
+    for (size_t row = 0; row < dims.row; ++row)
+    {
+        mX.coords[row] = x[row * dims.col];
+    }
+    mY.coords.assign(y.begin(), y.begin() + dims.col);
+
+    const double xTolerance = RECTILINEAR_TOLERANCE *
+            std::max(std::abs(mX.coords.back() - mX.coords.front()), 1.0);
+    const double yTolerance = RECTILINEAR_TOLERANCE *
+            std::max(std::abs(mY.coords.back() - mY.coords.front()), 1.0);
+    for (size_t row = 0, idx = 0; row < dims.row; ++row)
+    {
+        for (size_t col = 0; col < dims.col; ++col, ++idx)
+        {
+            if (std::abs(x[idx] - mX.coords[row]) > xTolerance ||
+                std::abs(y[idx] - mY.coords[col]) > yTolerance)
+            {
+                throw except::Exception(Ctxt(
+                        "Mesh '" + mesh.getName() + "' is not rectilinear"));
+            }
+        }
+    }
+
+    mX.initialize("x");
+    mY.initialize("y");
+}
+
+void MeshInterpolator::Axis::initialize(const std::string& name)
+{
+    const size_t numNodes = coords.size();
+    increasing = (numNodes < 2 || coords[1] > coords[0]);
+    uniform = true;
+    if (numNodes < 2)
+    {
+        return;
+    }
+
+    const double step = (coords.back() - coords.front()) / (numNodes - 1);
+    const double tolerance = UNIFORM_TOLERANCE * std::abs(step) * numNodes;
+    for (size_t ii = 1; ii < numNodes; ++ii)
+    {
+        const double delta = coords[ii] - coords[ii - 1];
+        if (delta == 0 || (delta > 0) != increasing)
+        {
+            throw except::Exception(Ctxt(
+                    "Mesh " + name + " coordinates are not monotonic at "
+                    "node " + str::toString(ii)));
+        }
+
+        if (std::abs(coords[ii] - (coords.front() + ii * step)) > tolerance)
+        {
+            uniform = false;
+        }
+    }
+}
+
+void MeshInterpolator::Axis::locate(double value,
+                                    size_t& index,
+                                    double& fraction) const
+{
+    const size_t numNodes = coords.size();
+    if (numNodes < 2)
+    {
+        index = 0;
+        fraction = 0.0;
+        return;
+    }
+
+    // Position of the value in nodes from the first one
+    double position;
+    if (uniform)
+    {
+        position = (value - coords.front()) /
+                (coords.back() - coords.front()) * (numNodes - 1);
+    }
+    else
+    {
+        const std::vector<double>::const_iterator upper = increasing ?
+                std::upper_bound(coords.begin(), coords.end(), value) :
+                std::upper_bound(coords.begin(), coords.end(), value,
+                                 std::greater<double>());
+        position = static_cast<double>(upper - coords.begin()) - 0.5;
+    }
+
+    if (!(position > 0.0))
+    {
+        index = 0;
+        fraction = 0.0;
+        return;
+    }
+    if (position >= numNodes - 1)
+    {
+        index = numNodes - 2;
+        fraction = 1.0;
+        return;
+    }
+
+    index = static_cast<size_t>(position);
+    fraction = (value - coords[index]) / (coords[index + 1] - coords[index]);
+    fraction = std::min(std::max(fraction, 0.0), 1.0);
+}
+
+double MeshInterpolator::interpolate(const std::vector<double>& values,
+                                     double x,
+                                     double y) const
+{
+    const size_t numCols = mY.coords.size();
+    if (values.size() != mX.coords.size() * numCols)
+    {
+        throw except::Exception(Ctxt(
+                "Expected " + str::toString(mX.coords.size() * numCols) +
+                " mesh values but got " + str::toString(values.size())));
+    }
+
+    size_t row;
+    double rowFraction;
+    mX.locate(x, row, rowFraction);
+    size_t col;
+    double colFraction;
+    mY.locate(y, col, colFraction);
+
+    const size_t nextRow = std::min(row + 1, mX.coords.size() - 1);
+    const size_t nextCol = std::min(col + 1, numCols - 1);
+    const double top = values[row * numCols + col] * (1.0 - colFraction) +
+            values[row * numCols + nextCol] * colFraction;
+    const double bottom =
+            values[nextRow * numCols + col] * (1.0 - colFraction) +
+            values[nextRow * numCols + nextCol] * colFraction;
+    return top * (1.0 - rowFraction) + bottom * rowFraction;
+}
 }
 }
@@ -20,9 +20,18 @@
  *
  */
 
+#include <six/Instrumentation.h>
 #include <six/sicd/SICDByteProvider.h>
 #include <six/sicd/SICDWriteControl.h>
 
+namespace
+{
+const size_t SAVE_POINT = six::Instrumentation::registerPoint(
+        "six::sicd::SICDWriteControl::save");
+const size_t BYTE_SWAP_POINT = six::Instrumentation::registerPoint(
+        "six::sicd::SICDWriteControl::byteSwap");
+}
+
 namespace six
 {
 namespace sicd
@@ -108,9 +117,14 @@ void SICDWriteControl::save(void* imageData,
     const size_t numPixelsTotal = dims.area() * NUM_BANDS;
     const bool doByteSwap = shouldByteSwap();
 
+    InstrumentationTimer timer(SAVE_POINT,
+                               numPixelsTotal * numBytesPerPixel);
+
     // Byte swap if needed
     if (doByteSwap)
     {
+        InstrumentationTimer swapTimer(BYTE_SWAP_POINT,
+                                       numPixelsTotal * numBytesPerPixel);
         sys::byteSwap(imageData,
                       static_cast<unsigned short>(numBytesPerPixel),
                       numPixelsTotal);
@@ -150,6 +164,7 @@ void SICDWriteControl::save(void* imageData,
             if (dims.col == globalNumCols)
             {
                 // Life is easy - one write
+                timer.addSeeks(1);
                 mIO->seek(byteOffset, NITF_SEEK_SET);
                 mIO->write(imageDataPtr,
                            numRowsToWrite * dims.col * NUM_BANDS *
@@ -166,6 +181,7 @@ void SICDWriteControl::save(void* imageData,
                      ++row, byteOffset += rowSeekStride,
                          imageDataPtr += numBytesPerRow)
                 {
+                    timer.addSeeks(1);
                     mIO->seek(byteOffset, NITF_SEEK_SET);
                     mIO->write(imageDataPtr, numBytesPerRow);
                 }
@@ -176,6 +192,8 @@ void SICDWriteControl::save(void* imageData,
     // Byte swap back if needed
     if (doByteSwap && restoreData)
     {
+        InstrumentationTimer swapTimer(BYTE_SWAP_POINT,
+                                       numPixelsTotal * numBytesPerPixel);
         sys::byteSwap(imageData,
                       static_cast<unsigned short>(numBytesPerPixel),
                       numPixelsTotal);
@@ -0,0 +1,203 @@
+/* =========================================================================
+* This file is part of six.sicd-c++
+* =========================================================================
+*
+* (C) Copyright 2004 - 2020, MDA Information Systems LLC
+*
+* six.sicd-c++ is free software; you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation; either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License along with this program; If not,
+* see <http://www.gnu.org/licenses/>.
+*
+*/
+
+#include <cmath>
+#include <map>
+#include <vector>
+
+#include <six/sicd/SICDMesh.h>
+#include "TestCase.h"
+
+namespace
+{
+const types::RowCol<size_t> MESH_DIMS(4, 5);
+
+// A rectilinear mesh with unevenly spaced x and evenly spaced y
+void makeCoordinates(std::vector<double>& x, std::vector<double>& y)
+{
+    const double xCoords[] = {-100.0, -20.0, 10.0, 250.0};
+    x.clear();
+    y.clear();
+    for (size_t row = 0; row < MESH_DIMS.row; ++row)
+    {
+        for (size_t col = 0; col < MESH_DIMS.col; ++col)
+        {
+            x.push_back(xCoords[row]);
+            y.push_back(50.0 - 25.0 * col);
+        }
+    }
+}
+
+// Bilinear interpolation is exact for this
+double plane(double x, double y)
+{
+    return 3.0 + 0.5 * x - 0.25 * y + 0.01 * x * y;
+}
+
+six::sicd::NoiseMesh makeNoiseMesh()
+{
+    std::vector<double> x;
+    std::vector<double> y;
+    makeCoordinates(x, y);
+
+    std::vector<double> mainBeam;
+    std::vector<double> azimuthAmbiguity;
+    std::vector<double> combined;
+    for (size_t ii = 0; ii < x.size(); ++ii)
+    {
+        mainBeam.push_back(plane(x[ii], y[ii]));
+        azimuthAmbiguity.push_back(ii * 0.125);
+        combined.push_back(-1.0 * ii);
+    }
+
+    return six::sicd::NoiseMesh(six::sicd::SICDMeshes::NOISE_MESH_ID,
+                                MESH_DIMS, x, y,
+                                mainBeam, azimuthAmbiguity, combined);
+}
+}
+
+TEST_CASE(testNoiseMeshRoundTrip)
+{
+    const six::sicd::NoiseMesh mesh = makeNoiseMesh();
+    std::vector<sys::byte> buffer;
+    mesh.serialize(buffer);
+
+    six::sicd::NoiseMesh meshCopy(six::sicd::SICDMeshes::NOISE_MESH_ID);
+    const sys::byte* data = &buffer[0];
+    meshCopy.deserialize(data);
+
+    TEST_ASSERT(data == &buffer[0] + buffer.size());
+    TEST_ASSERT_EQ(meshCopy.getMeshDims().row, MESH_DIMS.row);
+    TEST_ASSERT_EQ(meshCopy.getMeshDims().col, MESH_DIMS.col);
+    TEST_ASSERT(meshCopy.getX() == mesh.getX());
+    TEST_ASSERT(meshCopy.getY() == mesh.getY());
+    TEST_ASSERT(meshCopy.getMainBeamNoise() == mesh.getMainBeamNoise());
+    TEST_ASSERT(meshCopy.getAzimuthAmbiguityNoise() ==
+                mesh.getAzimuthAmbiguityNoise());
+    TEST_ASSERT(meshCopy.getCombinedNoise() == mesh.getCombinedNoise());
+}
+
+TEST_CASE(testScalarMeshRoundTrip)
+{
+    std::vector<double> x;
+    std::vector<double> y;
+    makeCoordinates(x, y);
+
+    std::map<std::string, std::vector<double> > scalars;
+    for (size_t ii = 0; ii < x.size(); ++ii)
+    {
+        scalars["height"].push_back(ii * 2.0);
+        scalars["temperature"].push_back(ii * -0.5);
+    }
+    const six::sicd::ScalarMesh mesh(six::sicd::SICDMeshes::SCALAR_MESH_ID,
+                                     MESH_DIMS, x, y, scalars.size(),
+                                     scalars);
+    std::vector<sys::byte> buffer;
+    mesh.serialize(buffer);
+
+    six::sicd::ScalarMesh meshCopy(six::sicd::SICDMeshes::SCALAR_MESH_ID);
+    const sys::byte* data = &buffer[0];
+    meshCopy.deserialize(data);
+
+    TEST_ASSERT(data == &buffer[0] + buffer.size());
+    TEST_ASSERT(meshCopy.getX() == mesh.getX());
+    TEST_ASSERT(meshCopy.getY() == mesh.getY());
+    TEST_ASSERT_EQ(meshCopy.getNumScalarsPerCoord(), scalars.size());
+    TEST_ASSERT(meshCopy.getScalars() == scalars);
+}
+
+TEST_CASE(testInterpolateAtNodes)
+{
+    const six::sicd::NoiseMesh mesh = makeNoiseMesh();
+    const six::sicd::MeshInterpolator interpolator(mesh);
+    TEST_ASSERT_EQ(interpolator.getMeshDims().row, MESH_DIMS.row);
+    TEST_ASSERT_EQ(interpolator.getMeshDims().col, MESH_DIMS.col);
+
+    for (size_t ii = 0; ii < mesh.getX().size(); ++ii)
+    {
+        TEST_ASSERT_EQ(interpolator.interpolate(mesh.getCombinedNoise(),
+                                                mesh.getX()[ii],
+                                                mesh.getY()[ii]),
+                       mesh.getCombinedNoise()[ii]);
+    }
+}
+
+TEST_CASE(testInterpolateBetweenNodes)
+{
+    const six::sicd::NoiseMesh mesh = makeNoiseMesh();
+    const six::sicd::MeshInterpolator interpolator(mesh);
+
+    for (double x = -100.0; x <= 250.0; x += 17.5)
+    {
+        for (double y = -50.0; y <= 50.0; y += 7.25)
+        {
+            TEST_ASSERT_ALMOST_EQ_EPS(
+                    interpolator.interpolate(mesh.getMainBeamNoise(), x, y),
+                    plane(x, y), 1e-9);
+        }
+    }
+}
+
+TEST_CASE(testInterpolateOutsideMesh)
+{
+    const six::sicd::NoiseMesh mesh = makeNoiseMesh();
+    const six::sicd::MeshInterpolator interpolator(mesh);
+
+    // Clamped to the nearest edge
+    TEST_ASSERT_ALMOST_EQ_EPS(
+            interpolator.interpolate(mesh.getMainBeamNoise(), -500.0, 0.0),
+            plane(-100.0, 0.0), 1e-9);
+    TEST_ASSERT_ALMOST_EQ_EPS(
+            interpolator.interpolate(mesh.getMainBeamNoise(), 10.0, 900.0),
+            plane(10.0, 50.0), 1e-9);
+    TEST_ASSERT_ALMOST_EQ_EPS(
+            interpolator.interpolate(mesh.getMainBeamNoise(), 900.0, -900.0),
+            plane(250.0, -50.0), 1e-9);
+}
+
+TEST_CASE(testInterpolatorErrors)
+{
+    const six::sicd::NoiseMesh mesh = makeNoiseMesh();
+    const six::sicd::MeshInterpolator interpolator(mesh);
+    TEST_EXCEPTION(interpolator.interpolate(std::vector<double>(3), 0, 0));
+
+    std::vector<double> x;
+    std::vector<double> y;
+    makeCoordinates(x, y);
+    x[7] += 1.0;
+    const six::sicd::PlanarCoordinateMesh skewed("skewed", MESH_DIMS, x, y);
+    TEST_EXCEPTION(six::sicd::MeshInterpolator(skewed));
+
+    const six::sicd::PlanarCoordinateMesh empty("empty");
+    TEST_EXCEPTION(six::sicd::MeshInterpolator(empty));
+}
+
+int main(int, char**)
+{
+    TEST_CHECK(testNoiseMeshRoundTrip);
+    TEST_CHECK(testScalarMeshRoundTrip);
+    TEST_CHECK(testInterpolateAtNodes);
+    TEST_CHECK(testInterpolateBetweenNodes);
+    TEST_CHECK(testInterpolateOutsideMesh);
+    TEST_CHECK(testInterpolatorErrors);
+    return 0;
+}
@@ -0,0 +1,102 @@
+/* =========================================================================
+ * This file is part of six.sicd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six.sicd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <string>
+
+#include <io/StringStream.h>
+#include <six/XMLStreamWriter.h>
+#include <six/sicd/ComplexData.h>
+#include <six/sicd/ComplexXMLControl.h>
+#include <six/sicd/Utilities.h>
+#include "TestCase.h"
+
+namespace
+{
+// Exposes both ways of writing out the XML, neither of which validates
+class TestXMLControl : public six::sicd::ComplexXMLControl
+{
+public:
+    std::string printDOM(const six::Data& data, const std::string& formatter)
+    {
+        const std::auto_ptr<xml::lite::Document> doc(toXMLImpl(&data));
+        io::StringStream stream;
+        if (formatter.empty())
+        {
+            doc->getRootElement()->print(stream);
+        }
+        else
+        {
+            doc->getRootElement()->prettyPrint(stream, formatter);
+        }
+        return stream.stream().str();
+    }
+
+    std::string stream(const six::Data& data, const std::string& formatter)
+    {
+        io::StringStream stream;
+        six::XMLStreamWriter writer(stream, formatter);
+        toXMLImpl(&data, writer);
+        return stream.stream().str();
+    }
+};
+
+std::auto_ptr<six::sicd::ComplexData> createData(const std::string& version)
+{
+    std::auto_ptr<six::sicd::ComplexData> data =
+            six::sicd::Utilities::createFakeComplexData();
+    data->setVersion(version);
+    data->setPixelType(six::PixelType::RE32F_IM32F);
+
+    // The "index" attributes go on after each vertex's children
+    data->imageData->validData.resize(3);
+    data->geoData->validData.resize(3);
+    for (size_t ii = 0; ii < 3; ++ii)
+    {
+        data->imageData->validData[ii] = six::RowColInt(ii, ii * 2);
+        data->geoData->validData[ii] = six::LatLon(10 + ii, 20 - ii);
+    }
+    return data;
+}
+
+TEST_CASE(testMatchesDOM)
+{
+    const char* const versions[] = {"0.4.0", "0.4.1", "0.5.0", "1.0.0",
+                                    "1.0.1", "1.1.0", "1.2.0", "1.2.1"};
+    TestXMLControl xmlControl;
+    for (size_t ii = 0; ii < sizeof(versions) / sizeof(versions[0]); ++ii)
+    {
+        const std::auto_ptr<six::sicd::ComplexData> data =
+                createData(versions[ii]);
+
+        const std::string xml = xmlControl.stream(*data, "");
+        TEST_ASSERT_EQ(xml, xmlControl.printDOM(*data, ""));
+        TEST_ASSERT_EQ(xmlControl.stream(*data, "    "),
+                       xmlControl.printDOM(*data, "    "));
+        TEST_ASSERT_EQ(xml.find("xmlns=\"urn:SICD:"), 6);
+    }
+}
+}
+
+int main(int, char**)
+{
+    TEST_CHECK(testMatchesDOM);
+    return 0;
+}
@@ -48,6 +48,12 @@ protected:
      *  Returns a new allocated DOM document, created from the DerivedData*
      */
     virtual xml::lite::Document* toXMLImpl(const Data* data);
+
+    /*!
+     *  Writes out the DerivedData* as XML as it's created, without a DOM
+     */
+    virtual void toXMLImpl(const Data* data, XMLStreamWriter& writer);
+
     /*!
      *  Returns a new allocated DerivedData*, created from the DOM Document*
      *
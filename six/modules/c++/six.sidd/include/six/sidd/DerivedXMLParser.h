@@ -43,6 +43,8 @@ public:
 
     virtual DerivedData* fromXML(const xml::lite::Document* doc) const = 0;
 
+    virtual void setXMLWriter(six::XMLStreamWriter* writer);
+
 protected:
     virtual void parseDerivedClassificationFromXML(
             const XMLElem classificationElem,
@@ -100,30 +102,26 @@ protected:
                               const std::string& attributeName,
                               BooleanType& boolean);
 
-    static
     void setAttributeList(XMLElem element,
                           const std::string& attributeName,
                           const std::vector<std::string>& values,
                           const std::string& uri = "",
-                          bool setIfEmpty = false);
+                          bool setIfEmpty = false) const;
 
-    static
     void setAttributeIfNonEmpty(XMLElem element,
                                 const std::string& name,
                                 const std::string& value,
-                                const std::string& uri = "");
+                                const std::string& uri = "") const;
 
-    static
     void setAttributeIfNonEmpty(XMLElem element,
                                 const std::string& name,
                                 six::BooleanType value,
-                                const std::string& uri = "");
+                                const std::string& uri = "") const;
 
-    static
     void setAttributeIfNonNull(XMLElem element,
                                const std::string& name,
                                const DateTime* value,
-                               const std::string& uri = "");
+                               const std::string& uri = "") const;
 
     virtual XMLElem createLUT(const std::string& name, const LUT *l,
             XMLElem parent = NULL) const;
@@ -40,6 +40,8 @@ public:
     virtual DerivedData* fromXML(const xml::lite::Document* doc) const;
 
 protected:
+    virtual six::XMLStreamWriter::Namespaces getNamespacePrefixes() const;
+
     virtual void parseDerivedClassificationFromXML(
             const XMLElem classificationElem,
             DerivedClassification& classification) const;
@@ -0,0 +1,60 @@
+/* =========================================================================
+ * This file is part of six.sidd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six.sidd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef __SIX_SIDD_J2K_TILE_COMPRESSOR_H__
+#define __SIX_SIDD_J2K_TILE_COMPRESSOR_H__
+
+#include <six/sidd/TileCompressor.h>
+
+namespace six
+{
+namespace sidd
+{
+/*!
+ * \class J2KTileCompressor
+ * \brief Compresses each tile with OpenJPEG
+ *
+ * Only available when building with OpenJPEG as the J2K layer.
+ *
+ * Pixels of 1 or 2 bytes are written as a single 8 or 16 bit component and
+ * 3 byte pixels as three 8 bit RGB components, using the reversible 5-3
+ * wavelet.  The number of wavelet levels from the SIDD's Compression block
+ * sets the number of resolutions.  Each layer bit rate (in bits per pixel)
+ * becomes a quality layer, so the bit rates must increase from one layer to
+ * the next.  Without any layers, the tile is compressed losslessly; a
+ * final layer whose bit rate reaches the uncompressed bits per pixel is
+ * also lossless.
+ */
+class J2KTileCompressor : public TileCompressor
+{
+public:
+    virtual void compress(const sys::ubyte* pixels,
+                          const types::RowCol<size_t>& offset,
+                          const types::RowCol<size_t>& dims,
+                          const types::RowCol<size_t>& tileDims,
+                          size_t numBytesPerPixel,
+                          const J2KCompression& settings,
+                          std::vector<sys::ubyte>& compressed) const;
+};
+}
+}
+
+#endif
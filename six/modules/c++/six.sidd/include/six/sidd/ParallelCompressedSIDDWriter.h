@@ -0,0 +1,210 @@
+/* =========================================================================
+ * This file is part of six.sidd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six.sidd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef __SIX_SIDD_PARALLEL_COMPRESSED_SIDD_WRITER_H__
+#define __SIX_SIDD_PARALLEL_COMPRESSED_SIDD_WRITER_H__
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <sys/Conf.h>
+#include <io/SeekableStreams.h>
+#include <types/RowCol.h>
+#include <nitf/System.hpp>
+#include <six/sidd/CompressedSIDDByteProvider.h>
+#include <six/sidd/DerivedData.h>
+#include <six/sidd/TileCompressor.h>
+
+namespace six
+{
+namespace sidd
+{
+/*!
+ * \class ParallelCompressedSIDDWriter
+ * \brief Writes a compressed SIDD from uncompressed pixels
+ *
+ * The caller provides the uncompressed pixels as bands of rows, in order.
+ * As each row of NITF blocks is completed, its blocks are compressed
+ * concurrently with the provided TileCompressor, using the J2K settings in
+ * the DerivedData's Compression block (if any), and written straight to the
+ * output stream.  The NITF headers are sized independently of the compressed
+ * block sizes, so the offset of each block row is known as soon as the
+ * blocks before it have been compressed.  close() then fills in the file
+ * header, image subheaders and DES around the image data.
+ *
+ * Only one caller-provided band of uncompressed pixels (plus any partial row
+ * of blocks) and the compressed blocks of that band are held in memory.
+ * Passing in bands that span several rows of blocks gives the worker threads
+ * more tiles to spread across.
+ *
+ * Each image segment is written as a single J2K codestream (IC=C8), tiled
+ * with one J2K tile per NITF block, and the image subheaders are blocked to
+ * match the tiling.  The TileCompressor encodes each tile on its own; the
+ * tiles are then spliced into the segment's codestream as described in
+ * TileCompressor.  The first block of each segment also carries the
+ * codestream's main header and the last one its EOC marker, which is
+ * reflected in getBytesPerBlock().
+ *
+ * The layer bit rates in the Compression block are only as good as the
+ * TileCompressor: they're passed along to it with the rest of the J2K
+ * settings, and J2KTileCompressor turns them into quality layers.  A
+ * TileCompressor that can't honor them must throw rather than ignore them.
+ */
+class ParallelCompressedSIDDWriter
+{
+public:
+    /*!
+     * Constructor
+     *
+     * \param data Representation of the derived data.  Its Compression
+     * block, if any, supplies the wavelet levels and layer bit rates handed
+     * to the compressor.
+     * \param schemaPaths Directories or files of schema locations
+     * \param compressor Compresses each block into one J2K tile.  Must
+     * outlive this object.
+     * \param isNumericallyLossless Flag whether compression is lossless
+     * \param outStream Output stream.  The SIDD is written starting at the
+     * stream's current position.  Must outlive this object.
+     * \param numRowsPerBlock The number of rows per block.  Defaults to no
+     * blocking.
+     * \param numColsPerBlock The number of columns per block.  Defaults to no
+     * blocking.
+     * \param numThreads Number of threads to compress with.  If 0, uses all
+     * cores.
+     * \param maxProductSize The max number of bytes in an image segment.
+     * By default this is set automatically for you based on NITF file rules.
+     */
+    ParallelCompressedSIDDWriter(const DerivedData& data,
+                                 const std::vector<std::string>& schemaPaths,
+                                 const TileCompressor& compressor,
+                                 bool isNumericallyLossless,
+                                 io::SeekableOutputStream& outStream,
+                                 size_t numRowsPerBlock = 0,
+                                 size_t numColsPerBlock = 0,
+                                 size_t numThreads = 0,
+                                 size_t maxProductSize = 0);
+
+    /*!
+     * Provides the next band of uncompressed pixels.  Any rows of blocks
+     * completed by this band are compressed and written to the output
+     * stream before returning.
+     *
+     * \param pixels Pixels in row-major order and native byte order.  Must
+     * contain 'numRows' full rows of the image.
+     * \param numRows Number of rows in the band
+     */
+    void addRows(const void* pixels, size_t numRows);
+
+    //! \return The number of rows provided so far
+    size_t getNumRowsAdded() const
+    {
+        return mNextRow;
+    }
+
+    /*!
+     * \return The compressed size of each block, per image segment.  This is
+     * only complete once all rows have been added.
+     */
+    const std::vector<std::vector<size_t> >& getBytesPerBlock() const
+    {
+        return mBytesPerBlock;
+    }
+
+    /*!
+     * Writes the NITF headers and DES around the image data already
+     * written.  All rows must have been added.  The stream is left
+     * positioned at the end of the SIDD.
+     */
+    void close();
+
+private:
+    struct BlockRow
+    {
+        size_t segment;
+        size_t startRow;
+        size_t numRows;
+
+        // First row of this block row within its image segment
+        size_t segmentRow;
+
+        // Index of this block row's first tile in its segment's codestream
+        size_t firstTile;
+
+        // Offset of this block row's image data, relative to the start of
+        // the SIDD, if every block were compressed to a single byte
+        nitf::Off placeholderOffset;
+
+        // Actual offset of this block row's image data, relative to the
+        // start of the SIDD, once it has been written
+        nitf::Off offset;
+    };
+
+    std::auto_ptr<CompressedSIDDByteProvider>
+    makeByteProvider(const std::vector<std::vector<size_t> >& bytesPerBlock)
+            const;
+
+    void compressBlockRows(size_t numBlockRows);
+
+    //! Seeks to 'offset' from the start of the SIDD, ready to write there
+    void seekForWrite(nitf::Off offset);
+
+private:
+    const std::auto_ptr<DerivedData> mData;
+    const std::vector<std::string> mSchemaPaths;
+    const TileCompressor& mCompressor;
+    const J2KCompression mSettings;
+    const bool mIsNumericallyLossless;
+    io::SeekableOutputStream& mOutStream;
+    const sys::Off_T mStartOffset;
+    const size_t mNumRowsPerBlockOpt;
+    const size_t mNumColsPerBlockOpt;
+    const size_t mNumThreads;
+    const size_t mMaxProductSize;
+    const size_t mNumBytesPerRow;
+
+    size_t mNumColsPerBlock;
+    std::vector<BlockRow> mBlockRows;
+
+    // Size of each image segment and of its J2K tiles
+    std::vector<types::RowCol<size_t> > mSegmentDims;
+    std::vector<types::RowCol<size_t> > mTileDims;
+
+    // Uncompressed rows not yet compressed, starting at the first row of
+    // block row 'mNextBlockRow'
+    std::vector<sys::ubyte> mStaged;
+    size_t mNextRow;
+    size_t mNextBlockRow;
+
+    // Number of bytes from the start of the SIDD to the end of the last
+    // block written
+    nitf::Off mNumBytesWritten;
+
+    // How many more bytes the blocks written so far took up than their
+    // single byte placeholders
+    nitf::Off mExtraBytesWritten;
+
+    std::vector<std::vector<size_t> > mBytesPerBlock;
+};
+}
+}
+
+#endif
@@ -0,0 +1,95 @@
+/* =========================================================================
+ * This file is part of six.sidd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six.sidd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef __SIX_SIDD_TILE_COMPRESSOR_H__
+#define __SIX_SIDD_TILE_COMPRESSOR_H__
+
+#include <stddef.h>
+#include <vector>
+
+#include <sys/Conf.h>
+#include <types/RowCol.h>
+#include <six/sidd/Compression.h>
+
+namespace six
+{
+namespace sidd
+{
+/*!
+ * \class TileCompressor
+ * \brief Compresses a single NITF block of SIDD pixels into one J2K tile
+ *
+ * Implementations wrap a J2K encoder.  Each NITF block becomes one tile of
+ * the image segment's J2K codestream.  The tiles are encoded independently,
+ * so each one comes back as a complete codestream (SOC through EOC) that
+ * holds only that tile, placed on the reference grid exactly where it sits
+ * in the image segment:
+ *
+ * - XOsiz = XTOsiz = offset.col and YOsiz = YTOsiz = offset.row
+ * - Xsiz = offset.col + dims.col and Ysiz = offset.row + dims.row
+ * - XTsiz = tileDims.col and YTsiz = tileDims.row
+ *
+ * Since the code-block and precinct partitions are anchored to the
+ * reference grid, the tile's coded data is then exactly what it would be in
+ * a codestream covering the whole segment.  ParallelCompressedSIDDWriter
+ * keeps the main header of the segment's first tile, rewrites its SIZ
+ * marker to cover the whole segment, renumbers each tile's tile-parts, and
+ * ends the segment with a single EOC marker.  Every tile in a segment must
+ * therefore be encoded with the same coding parameters, and the main header
+ * must not carry TLM or PPM markers.
+ *
+ * compress() is called concurrently from multiple threads, so it must not
+ * modify any state shared between calls.
+ */
+class TileCompressor
+{
+public:
+    virtual ~TileCompressor()
+    {
+    }
+
+    /*!
+     * Compresses one tile
+     *
+     * \param pixels Tile pixels in row-major order and native byte order.
+     * Contains 'dims.area() * numBytesPerPixel' bytes.
+     * \param offset Row and column of the tile's first pixel within its
+     * image segment
+     * \param dims Tile dimensions.  Tiles along the bottom and right edges
+     * of an image segment are not padded out to the full block size.
+     * \param tileDims Nominal tile (block) size for the image segment
+     * \param numBytesPerPixel Number of bytes in each pixel
+     * \param settings J2K settings (wavelet levels and layer bit rates) from
+     * the SIDD's Compression block
+     * \param[out] compressed J2K codestream holding just this tile
+     */
+    virtual void compress(const sys::ubyte* pixels,
+                          const types::RowCol<size_t>& offset,
+                          const types::RowCol<size_t>& dims,
+                          const types::RowCol<size_t>& tileDims,
+                          size_t numBytesPerPixel,
+                          const J2KCompression& settings,
+                          std::vector<sys::ubyte>& compressed) const = 0;
+};
+}
+}
+
+#endif
@@ -65,6 +65,24 @@ xml::lite::Document* DerivedXMLControl::toXMLImpl(const Data* data)
     return getParser(data->getVersion())->toXML(sidd);
 }
 
+void DerivedXMLControl::toXMLImpl(const Data* data, XMLStreamWriter& writer)
+{
+    if (data->getDataType() != DataType::DERIVED)
+    {
+        throw except::Exception(Ctxt("Data must be SIDD"));
+    }
+
+    const DerivedData* const sidd(reinterpret_cast<const DerivedData*>(data));
+    const std::auto_ptr<DerivedXMLParser> parser(
+            getParser(data->getVersion()));
+    parser->setXMLWriter(&writer);
+
+    // The document only holds the root, which the writer needs until it's
+    // closed
+    const std::auto_ptr<xml::lite::Document> doc(parser->toXML(sidd));
+    writer.close();
+}
+
 std::auto_ptr<DerivedXMLParser>
 DerivedXMLControl::getParser(const std::string& version) const
 {
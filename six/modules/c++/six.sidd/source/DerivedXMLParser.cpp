@@ -51,6 +51,12 @@ DerivedXMLParser::DerivedXMLParser(
 {
 }
 
+void DerivedXMLParser::setXMLWriter(six::XMLStreamWriter* writer)
+{
+    six::XMLParser::setXMLWriter(writer);
+    mCommon->setXMLWriter(writer);
+}
+
 void DerivedXMLParser::getAttributeList(
         const xml::lite::Attributes& attributes,
         const std::string& attributeName,
@@ -171,7 +177,7 @@ void DerivedXMLParser::setAttributeList(
         const std::string& attributeName,
         const std::vector<std::string>& values,
         const std::string& uri,
-        bool setIfEmpty)
+        bool setIfEmpty) const
 {
     std::string value;
     for (size_t ii = 0; ii < values.size(); ++ii)
@@ -198,7 +204,7 @@ void DerivedXMLParser::setAttributeList(
 void DerivedXMLParser::setAttributeIfNonEmpty(XMLElem element,
                                               const std::string& name,
                                               const std::string& value,
-                                              const std::string& uri)
+                                              const std::string& uri) const
 {
     if (!value.empty())
     {
@@ -209,7 +215,7 @@ void DerivedXMLParser::setAttributeIfNonEmpty(XMLElem element,
 void DerivedXMLParser::setAttributeIfNonEmpty(XMLElem element,
                                               const std::string& name,
                                               BooleanType value,
-                                              const std::string& uri)
+                                              const std::string& uri) const
 {
     if (!Init::isUndefined(value))
     {
@@ -220,7 +226,7 @@ void DerivedXMLParser::setAttributeIfNonEmpty(XMLElem element,
 void DerivedXMLParser::setAttributeIfNonNull(XMLElem element,
                                              const std::string& name,
                                              const DateTime* value,
-                                             const std::string& uri)
+                                             const std::string& uri) const
 {
     if (value)
     {
@@ -861,7 +867,7 @@ XMLElem DerivedXMLParser::convertProcessorInformationToXML(
         XMLElem parent) const
 {
     XMLElem procInfoElem
-            = newElement("ProcessorInformation", parent);
+            = createElement("ProcessorInformation", parent);
 
     createString("Application",
                  processorInformation->application,
@@ -890,7 +896,7 @@ XMLElem DerivedXMLParser::convertProductCreationToXML(
         XMLElem parent) const
 {
     // create ProductCreation -- root
-    XMLElem productCreationElem = newElement("ProductCreation", parent);
+    XMLElem productCreationElem = createElement("ProductCreation", parent);
 
     convertProcessorInformationToXML(
             &productCreation->processorInformation, productCreationElem);
@@ -924,21 +930,21 @@ void DerivedXMLParser::convertRemapToXML(const Remap& remap,
 {
     if (remap.displayType == DisplayType::COLOR)
     {
-        XMLElem remapElem = newElement("ColorDisplayRemap", parent);
+        XMLElem remapElem = createElement("ColorDisplayRemap", parent);
         if (remap.remapLUT.get())
             createLUT("RemapLUT",
                       remap.remapLUT.get(), remapElem);
     }
     else if (remap.displayType == DisplayType::MONO)
     {
-        XMLElem remapElem = newElement("MonochromeDisplayRemap",
+        XMLElem remapElem = createElement("MonochromeDisplayRemap",
                                       parent);
         // a little risky, but let's assume the displayType is correct
         const MonochromeDisplayRemap& mdr =
                 reinterpret_cast<const MonochromeDisplayRemap&>(remap);
         createString("RemapType", mdr.remapType, remapElem);
     /* TODO: Where does this actually go??
-    XMLElem geographicAndTargetXML = newElement("GeographicAndTarget", parent);
+    XMLElem geographicAndTargetXML = createElement("GeographicAndTarget", parent);
     convertGeographicCoverageToXML(
             "GeographicCoverage",
             &geographicAndTarget->geographicCoverage,
@@ -950,7 +956,7 @@ void DerivedXMLParser::convertRemapToXML(const Remap& remap,
             it != geographicAndTarget->targetInformation.end(); ++it)
     {
         TargetInformation* ti = (*it).get();
-        XMLElem tiXML = newElement("TargetInformation", geographicAndTargetXML);
+        XMLElem tiXML = createElement("TargetInformation", geographicAndTargetXML);
 
         // 1 to unbounded
         common().addParameters("Identifier", ti->identifiers, tiXML);
@@ -974,7 +980,7 @@ XMLElem DerivedXMLParser::convertGeographicCoverageToXML(
         XMLElem parent) const
 {
     //GeographicAndTarget
-    XMLElem geoCoverageElem = newElement(localName, parent);
+    XMLElem geoCoverageElem = createElement(localName, parent);
 
     // optional to unbounded
     common().addParameters("GeoregionIdentifier", geoCoverage->georegionIdentifiers,
@@ -986,7 +992,7 @@ XMLElem DerivedXMLParser::convertGeographicCoverageToXML(
     // GeographicInfo
     if (geoCoverage->geographicInformation.get())
     {
-        XMLElem geoInfoElem = newElement("GeographicInfo", geoCoverageElem);
+        XMLElem geoInfoElem = createElement("GeographicInfo", geoCoverageElem);
 
         // optional to unbounded
         size_t numCC = geoCoverage->geographicInformation->countryCodes.size();
@@ -1030,13 +1036,13 @@ XMLElem DerivedXMLParser::convertMeasurementToXML(
         const Measurement* measurement,
         XMLElem parent) const
 {
-    XMLElem measurementElem = newElement("Measurement", parent);
+    XMLElem measurementElem = createElement("Measurement", parent);
 
-    XMLElem projectionElem = newElement("", measurementElem);
+    XMLElem projectionElem = createElement("", measurementElem);
 
     // NOTE: ReferencePoint is present in all of the ProjectionTypes
     //       so its added here for ease
-    XMLElem referencePointElem = newElement("ReferencePoint", projectionElem);
+    XMLElem referencePointElem = createElement("ReferencePoint", projectionElem);
     if (measurement->projection->referencePoint.name
             != Init::undefined<std::string>())
     {
@@ -1103,7 +1109,7 @@ XMLElem DerivedXMLParser::convertMeasurementToXML(
                               planeProj->timeCOAPoly,
                               projectionElem);
 
-        XMLElem productPlaneElem = newElement("ProductPlane", projectionElem);
+        XMLElem productPlaneElem = createElement("ProductPlane", projectionElem);
         common().createVector3D("RowUnitVector",
                                 planeProj->productPlane.rowUnitVector,
                                 productPlaneElem);
@@ -1153,7 +1159,7 @@ XMLElem DerivedXMLParser::convertMeasurementToXML(
 XMLElem DerivedXMLParser::createLUT(const std::string& name, const LUT *lut,
         XMLElem parent) const
 {
-    XMLElem lutElement = newElement(name, parent);
+    XMLElem lutElement = createElement(name, parent);
     setAttribute(lutElement, "size", str::toString(lut->numEntries));
     return createLUTImpl(lut, lutElement);
 }
@@ -1192,7 +1198,7 @@ XMLElem DerivedXMLParser::createFootprint(const std::string& name,
                                           const LatLonCorners& corners,
                                           XMLElem parent) const
 {
-    XMLElem footprint = newElement(name, getDefaultURI(), parent);
+    XMLElem footprint = createElement(name, getDefaultURI(), parent);
     xml::lite::AttributeNode node;
     node.setQName("size");
     node.setValue(str::toString(LatLonCorners::NUM_CORNERS));
@@ -1219,9 +1225,9 @@ XMLElem DerivedXMLParser::createSFADatum(const std::string& name,
                                          const six::sidd::SFADatum& datum,
                                          XMLElem parent) const
 {
-    XMLElem datumElem = newElement(name, SFA_URI, parent);
+    XMLElem datumElem = createElement(name, SFA_URI, parent);
 
-    XMLElem spheriodElem = newElement("Spheroid", SFA_URI, datumElem);
+    XMLElem spheriodElem = createElement("Spheroid", SFA_URI, datumElem);
 
     createString("SpheriodName", SFA_URI, datum.spheroid.name, spheriodElem);
     createDouble("SemiMajorAxis", SFA_URI,
@@ -1236,7 +1242,7 @@ XMLElem DerivedXMLParser::convertProductProcessingToXML(
         const ProductProcessing* productProcessing,
         XMLElem parent) const
 {
-    XMLElem productProcessingElem = newElement("ProductProcessing", parent);
+    XMLElem productProcessingElem = createElement("ProductProcessing", parent);
 
     // error checking
     if (productProcessing->processingModules.size() < 1)
@@ -1262,7 +1268,7 @@ XMLElem DerivedXMLParser::convertProcessingModuleToXML(
         const ProcessingModule* procMod,
         XMLElem parent) const
 {
-    XMLElem procModElem = newElement("ProcessingModule", parent);
+    XMLElem procModElem = createElement("ProcessingModule", parent);
 
     common().createParameter("ModuleName", procMod->moduleName, procModElem);
 
@@ -1291,13 +1297,13 @@ XMLElem DerivedXMLParser::convertDownstreamReprocessingToXML(
         const DownstreamReprocessing* downstreamReproc,
         XMLElem parent) const
 {
-    XMLElem epElem = newElement("DownstreamReprocessing", parent);
+    XMLElem epElem = createElement("DownstreamReprocessing", parent);
 
     // optional
     GeometricChip *geoChip = downstreamReproc->geometricChip.get();
     if (geoChip)
     {
-        XMLElem geoChipElem = newElement("GeometricChip", epElem);
+        XMLElem geoChipElem = createElement("GeometricChip", epElem);
         common().createRowCol("ChipSize", geoChip->chipSize, geoChipElem);
         common().createRowCol("OriginalUpperLeftCoordinate",
                      geoChip->originalUpperLeftCoordinate, geoChipElem);
@@ -1316,7 +1322,7 @@ XMLElem DerivedXMLParser::convertDownstreamReprocessingToXML(
                 it != downstreamReproc->processingEvents.end(); ++it)
         {
             ProcessingEvent *procEvent = (*it).get();
-            XMLElem procEventElem = newElement("ProcessingEvent", epElem);
+            XMLElem procEventElem = createElement("ProcessingEvent", epElem);
 
             createString("ApplicationName", procEvent->applicationName,
                          procEventElem);
@@ -1603,14 +1609,14 @@ XMLElem DerivedXMLParser::convertGeographicCoordinateSystemToXML(
         const SFAGeographicCoordinateSystem* geographicCoordinateSystem,
         XMLElem parent) const
 {
-    XMLElem geoSysElem = newElement("GeographicCoordinateSystem",
+    XMLElem geoSysElem = createElement("GeographicCoordinateSystem",
                                    SFA_URI, parent);
 
     createString("Csname", SFA_URI,
                  geographicCoordinateSystem->csName, geoSysElem);
     createSFADatum("Datum", geographicCoordinateSystem->datum, geoSysElem);
 
-    XMLElem primeMeridianElem = newElement("PrimeMeridian", SFA_URI, geoSysElem);
+    XMLElem primeMeridianElem = createElement("PrimeMeridian", SFA_URI, geoSysElem);
     createString("Name", SFA_URI,
                  geographicCoordinateSystem->primeMeridian.name,
                  primeMeridianElem);
@@ -1630,20 +1636,20 @@ XMLElem DerivedXMLParser::convertAnnotationToXML(
         const Annotation* a,
         XMLElem parent) const
 {
-    XMLElem annElem = newElement("Annotation", parent);
+    XMLElem annElem = createElement("Annotation", parent);
 
     createString("Identifier", a->identifier, annElem);
 
     // optional
     if (a->spatialReferenceSystem.get())
     {
-        XMLElem spRefElem = newElement("SpatialReferenceSystem",
+        XMLElem spRefElem = createElement("SpatialReferenceSystem",
                                       getDefaultURI(), annElem);
 
         if (a->spatialReferenceSystem->coordinateSystem->getType()
                 == six::sidd::SFAProjectedCoordinateSystem::TYPE_NAME)
         {
-            XMLElem coordElem = newElement("ProjectedCoordinateSystem", SFA_URI, spRefElem);
+            XMLElem coordElem = createElement("ProjectedCoordinateSystem", SFA_URI, spRefElem);
 
             SFAProjectedCoordinateSystem* coordSys
                     = (SFAProjectedCoordinateSystem*)a->
@@ -1654,14 +1660,14 @@ XMLElem DerivedXMLParser::convertAnnotationToXML(
             convertGeographicCoordinateSystemToXML(
                     coordSys->geographicCoordinateSystem.get(), coordElem);
 
-            XMLElem projectionElem = newElement("Projection", SFA_URI, coordElem);
+            XMLElem projectionElem = createElement("Projection", SFA_URI, coordElem);
             createString("ProjectionName", SFA_URI, coordSys->projection.name,
                          projectionElem);
 
             // optional
             if (!coordSys->parameter.name.empty())
             {
-                XMLElem parameterElem = newElement("Parameter", SFA_URI,
+                XMLElem parameterElem = createElement("Parameter", SFA_URI,
                                                   coordElem);
                 createString("ParameterName", SFA_URI,
                              coordSys->parameter.name, parameterElem);
@@ -1683,7 +1689,7 @@ XMLElem DerivedXMLParser::convertAnnotationToXML(
         else if (a->spatialReferenceSystem->coordinateSystem->getType()
                     == six::sidd::SFAGeocentricCoordinateSystem::TYPE_NAME)
         {
-            XMLElem coordElem = newElement("GeocentricCoordinateSystem",
+            XMLElem coordElem = createElement("GeocentricCoordinateSystem",
                                           SFA_URI, spRefElem);
 
             SFAGeocentricCoordinateSystem* coordSys
@@ -1693,7 +1699,7 @@ XMLElem DerivedXMLParser::convertAnnotationToXML(
             createString("Csname", SFA_URI, coordSys->csName, coordElem);
             createSFADatum("Datum", coordSys->datum, coordElem);
 
-            XMLElem primeMeridianElem = newElement("PrimeMeridian", SFA_URI,
+            XMLElem primeMeridianElem = createElement("PrimeMeridian", SFA_URI,
                                                   coordElem);
             createString("Name", SFA_URI,
                          coordSys->primeMeridian.name,
@@ -1719,7 +1725,7 @@ XMLElem DerivedXMLParser::convertAnnotationToXML(
     // one to unbounded
     for (size_t i = 0, num = a->objects.size(); i < num; ++i)
     {
-        XMLElem objElem = newElement("Object", annElem);
+        XMLElem objElem = createElement("Object", annElem);
         convertSFAGeometryToXML(a->objects[i].get(), objElem);
     }
     return annElem;
@@ -1829,9 +1835,9 @@ XMLElem DerivedXMLParser::createSFAPoint(
         XMLElem parent) const
 {
     XMLElem pointElem
-            = newElement(localName,
-                         (localName == "Vertex")
-                         ? SFA_URI : getDefaultURI(), parent);
+            = createElement(localName,
+                            (localName == "Vertex")
+                            ? SFA_URI : getDefaultURI(), parent);
 
     createDouble("X", SFA_URI, p->x, pointElem);
     createDouble("Y", SFA_URI, p->y, pointElem);
@@ -1852,9 +1858,9 @@ XMLElem DerivedXMLParser::createSFALine(
         XMLElem parent) const
 {
     XMLElem lineElem
-            = newElement(localName,
-                         (localName == "Ring")
-                         ? SFA_URI : getDefaultURI(), parent);
+            = createElement(localName,
+                            (localName == "Ring")
+                            ? SFA_URI : getDefaultURI(), parent);
 
     // error check the vertices
     if (l->vertices.size() < 2)
@@ -1893,7 +1899,7 @@ XMLElem DerivedXMLParser::convertSFAGeometryToXML(
     }
     else if (geoType == SFAPolygon::TYPE_NAME)
     {
-        geoElem = newElement("Polygon", getDefaultURI(), parent);
+        geoElem = createElement("Polygon", getDefaultURI(), parent);
 
         SFAPolygon* p = (SFAPolygon*) g;
 
@@ -1905,13 +1911,13 @@ XMLElem DerivedXMLParser::convertSFAGeometryToXML(
     }
     else if (geoType == SFAPolyhedralSurface::TYPE_NAME)
     {
-        geoElem = newElement("PolyhedralSurface", getDefaultURI(), parent);
+        geoElem = createElement("PolyhedralSurface", getDefaultURI(), parent);
 
         SFAPolyhedralSurface* p = (SFAPolyhedralSurface*) g;
 
         for (size_t ii = 0; ii < p->patches.size(); ++ii)
         {
-            XMLElem patchElem = newElement("Patch", SFA_URI, geoElem);
+            XMLElem patchElem = createElement("Patch", SFA_URI, geoElem);
             for (size_t jj = 0; jj < p->patches[ii]->rings.size(); ++jj)
             {
                 createSFALine("Ring", p->patches[ii]->rings[jj].get(), patchElem);
@@ -1920,14 +1926,14 @@ XMLElem DerivedXMLParser::convertSFAGeometryToXML(
     }
     else if (geoType == SFAMultiPolygon::TYPE_NAME)
     {
-        geoElem = newElement("MultiPolygon", getDefaultURI(), parent);
+        geoElem = createElement("MultiPolygon", getDefaultURI(), parent);
 
         SFAMultiPolygon* p = (SFAMultiPolygon*) g;
 
         // optional to unbounded
         for (size_t ii = 0; ii < p->elements.size(); ++ii)
         {
-            XMLElem elemElem = newElement("Element", SFA_URI, geoElem);
+            XMLElem elemElem = createElement("Element", SFA_URI, geoElem);
             for (size_t jj = 0; jj < p->elements[ii]->rings.size(); ++jj)
             {
                 createSFALine("Ring", p->elements[ii]->rings[jj].get(), elemElem);
@@ -1936,14 +1942,14 @@ XMLElem DerivedXMLParser::convertSFAGeometryToXML(
     }
     else if (geoType == SFAMultiLineString::TYPE_NAME)
     {
-        geoElem = newElement("MultiLineString", getDefaultURI(), parent);
+        geoElem = createElement("MultiLineString", getDefaultURI(), parent);
 
         SFAMultiLineString* p = (SFAMultiLineString*) g;
 
         // optional to unbounded
         for (size_t ii = 0; ii < p->elements.size(); ++ii)
         {
-            XMLElem elemElem = newElement("Element", SFA_URI, geoElem);
+            XMLElem elemElem = createElement("Element", SFA_URI, geoElem);
             for (size_t jj = 0; jj < p->elements[ii]->vertices.size(); ++jj)
             {
                 createSFAPoint("Vertex", p->elements[ii]->vertices[jj].get(),
@@ -1953,7 +1959,7 @@ XMLElem DerivedXMLParser::convertSFAGeometryToXML(
     }
     else if (geoType == SFAMultiPoint::TYPE_NAME)
     {
-        geoElem = newElement("MultiPoint", getDefaultURI(), parent);
+        geoElem = createElement("MultiPoint", getDefaultURI(), parent);
 
         SFAMultiPoint* p = (SFAMultiPoint*) g;
 
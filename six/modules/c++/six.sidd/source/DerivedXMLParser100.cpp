@@ -175,7 +175,7 @@ XMLElem DerivedXMLParser100::convertDerivedClassificationToXML(
         const DerivedClassification& classification,
         XMLElem parent) const
 {
-    XMLElem classElem = newElement("Classification", parent);
+    XMLElem classElem = createElement("Classification", parent);
 
     common().addParameters("SecurityExtension",
                            classification.securityExtensions,
@@ -291,7 +291,7 @@ xml::lite::Document*
 DerivedXMLParser100::toXML(const DerivedData* derived) const
 {
     xml::lite::Document* doc = new xml::lite::Document();
-    XMLElem root = newElement("SIDD");
+    XMLElem root = createElement("SIDD");
     doc->setRootElement(root);
 
     convertProductCreationToXML(derived->productCreation.get(), root);
@@ -326,7 +326,7 @@ DerivedXMLParser100::toXML(const DerivedData* derived) const
     // optional
     if (!derived->annotations.empty())
     {
-        XMLElem annotationsElem = newElement("Annotations", root);
+        XMLElem annotationsElem = createElement("Annotations", root);
         for (size_t i = 0, num = derived->annotations.size(); i < num; ++i)
         {
             convertAnnotationToXML(derived->annotations[i].get(),
@@ -335,26 +335,37 @@ DerivedXMLParser100::toXML(const DerivedData* derived) const
     }
 
     //set the ElemNS
-    root->setNamespacePrefix("", getDefaultURI());
-    root->setNamespacePrefix("si", SI_COMMON_URI);
-    root->setNamespacePrefix("sfa", SFA_URI);
-    root->setNamespacePrefix("ism", ISM_URI);
+    setNamespacePrefixes(root);
 
     return doc;
 }
 
+six::XMLStreamWriter::Namespaces
+DerivedXMLParser100::getNamespacePrefixes() const
+{
+    six::XMLStreamWriter::Namespaces namespaces;
+    namespaces.push_back(std::make_pair(std::string(), getDefaultURI()));
+    namespaces.push_back(std::make_pair(std::string("si"),
+                                        std::string(SI_COMMON_URI)));
+    namespaces.push_back(std::make_pair(std::string("sfa"),
+                                        std::string(SFA_URI)));
+    namespaces.push_back(std::make_pair(std::string("ism"),
+                                        std::string(ISM_URI)));
+    return namespaces;
+}
+
 XMLElem DerivedXMLParser100::convertDisplayToXML(
         const Display& display,
         XMLElem parent) const
 {
-    XMLElem displayElem = newElement("Display", parent);
+    XMLElem displayElem = createElement("Display", parent);
 
     createString("PixelType", six::toString(display.pixelType), displayElem);
 
     // optional
     if (display.remapInformation.get())
     {
-        XMLElem remapInfoElem = newElement("RemapInformation", displayElem);
+        XMLElem remapInfoElem = createElement("RemapInformation", displayElem);
         convertRemapToXML(*display.remapInformation, remapInfoElem);
     }
 
@@ -375,7 +386,7 @@ XMLElem DerivedXMLParser100::convertDisplayToXML(
     // optional
     if (display.histogramOverrides.get())
     {
-        XMLElem histo = newElement("DRAHistogramOverrides", displayElem);
+        XMLElem histo = createElement("DRAHistogramOverrides", displayElem);
         createInt("ClipMin", display.histogramOverrides->clipMin, histo);
         createInt("ClipMax", display.histogramOverrides->clipMax, histo);
     }
@@ -383,7 +394,7 @@ XMLElem DerivedXMLParser100::convertDisplayToXML(
     // optional
     if (display.monitorCompensationApplied.get())
     {
-        XMLElem monComp = newElement("MonitorCompensationApplied", displayElem);
+        XMLElem monComp = createElement("MonitorCompensationApplied", displayElem);
         createDouble("Gamma", display.monitorCompensationApplied->gamma,
                      monComp);
         createDouble("XMin", display.monitorCompensationApplied->xMin, monComp);
@@ -399,7 +410,7 @@ XMLElem DerivedXMLParser100::convertGeographicTargetToXML(
         const GeographicAndTarget& geographicAndTarget,
         XMLElem parent) const
 {
-    XMLElem geographicAndTargetElem = newElement("GeographicAndTarget", parent);
+    XMLElem geographicAndTargetElem = createElement("GeographicAndTarget", parent);
 
     if (geographicAndTarget.geographicCoverage.get() == NULL)
     {
@@ -417,7 +428,7 @@ XMLElem DerivedXMLParser100::convertGeographicTargetToXML(
             it != geographicAndTarget.targetInformation.end(); ++it)
     {
         TargetInformation* ti = (*it).get();
-        XMLElem tiElem = newElement("TargetInformation", geographicAndTargetElem);
+        XMLElem tiElem = createElement("TargetInformation", geographicAndTargetElem);
 
         // 1 to unbounded
         common().addParameters("Identifier", ti->identifiers, tiElem);
@@ -563,7 +574,7 @@ XMLElem DerivedXMLParser100::convertExploitationFeaturesToXML(
     XMLElem parent) const
 {
     XMLElem exploitationFeaturesElem =
-        newElement("ExploitationFeatures", parent);
+        createElement("ExploitationFeatures", parent);
 
     if (exploitationFeatures->collections.size() < 1)
     {
@@ -576,17 +587,17 @@ XMLElem DerivedXMLParser100::convertExploitationFeaturesToXML(
     for (size_t i = 0; i < exploitationFeatures->collections.size(); ++i)
     {
         Collection* collection = exploitationFeatures->collections[i].get();
-        XMLElem collectionElem = newElement("Collection",
+        XMLElem collectionElem = createElement("Collection",
             exploitationFeaturesElem);
         setAttribute(collectionElem, "identifier", collection->identifier);
 
         // create Information
-        XMLElem informationElem = newElement("Information", collectionElem);
+        XMLElem informationElem = createElement("Information", collectionElem);
 
         createString("SensorName",
             collection->information.sensorName,
             informationElem);
-        XMLElem radarModeElem = newElement("RadarMode", informationElem);
+        XMLElem radarModeElem = createElement("RadarMode", informationElem);
         createString("ModeType",
             common().getSICommonURI(),
             six::toString(collection->information.radarMode),
@@ -622,7 +633,7 @@ XMLElem DerivedXMLParser100::convertExploitationFeaturesToXML(
         // optional
         if (collection->information.inputROI.get())
         {
-            XMLElem roiElem = newElement("InputROI", informationElem);
+            XMLElem roiElem = createElement("InputROI", informationElem);
             common().createRowCol("Size",
                 collection->information.inputROI->size,
                 roiElem);
@@ -635,7 +646,7 @@ XMLElem DerivedXMLParser100::convertExploitationFeaturesToXML(
             collection->information.polarization.size(); n < nElems; ++n)
         {
             TxRcvPolarization *p = collection->information.polarization[n].get();
-            XMLElem polElem = newElement("Polarization", informationElem);
+            XMLElem polElem = createElement("Polarization", informationElem);
 
             createString("TxPolarization",
                 six::toString(p->txPolarization),
@@ -661,7 +672,7 @@ XMLElem DerivedXMLParser100::convertExploitationFeaturesToXML(
         Geometry* geom = collection->geometry.get();
         if (geom != NULL)
         {
-            XMLElem geometryElem = newElement("Geometry", collectionElem);
+            XMLElem geometryElem = createElement("Geometry", collectionElem);
 
             // optional
             if (geom->azimuth != Init::undefined<double>())
@@ -687,13 +698,13 @@ XMLElem DerivedXMLParser100::convertExploitationFeaturesToXML(
         Phenomenology* phenom = collection->phenomenology.get();
         if (phenom != NULL)
         {
-            XMLElem phenomenologyElem = newElement("Phenomenology",
+            XMLElem phenomenologyElem = createElement("Phenomenology",
                 collectionElem);
 
             // optional
             if (phenom->shadow != Init::undefined<AngleMagnitude>())
             {
-                XMLElem shadow = newElement("Shadow", phenomenologyElem);
+                XMLElem shadow = createElement("Shadow", phenomenologyElem);
                 createDouble("Angle", common().getSICommonURI(),
                     phenom->shadow.angle, shadow);
                 createDouble("Magnitude", common().getSICommonURI(),
@@ -702,7 +713,7 @@ XMLElem DerivedXMLParser100::convertExploitationFeaturesToXML(
             // optional
             if (phenom->layover != Init::undefined<AngleMagnitude>())
             {
-                XMLElem layover = newElement("Layover", phenomenologyElem);
+                XMLElem layover = createElement("Layover", phenomenologyElem);
                 createDouble("Angle", common().getSICommonURI(),
                     phenom->layover.angle, layover);
                 createDouble("Magnitude", common().getSICommonURI(),
@@ -722,7 +733,7 @@ XMLElem DerivedXMLParser100::convertExploitationFeaturesToXML(
     }
 
     // create Product
-    XMLElem productElem = newElement("Product", exploitationFeaturesElem);
+    XMLElem productElem = createElement("Product", exploitationFeaturesElem);
 
     if (exploitationFeatures->product.size() != 1)
     {
@@ -220,7 +220,7 @@ DerivedData* DerivedXMLParser200::fromXML(
 xml::lite::Document* DerivedXMLParser200::toXML(const DerivedData* derived) const
 {
     xml::lite::Document* doc = new xml::lite::Document();
-    XMLElem root = newElement("SIDD");
+    XMLElem root = createElement("SIDD");
     doc->setRootElement(root);
 
     convertProductCreationToXML(derived->productCreation.get(), root);
@@ -272,7 +272,7 @@ xml::lite::Document* DerivedXMLParser200::toXML(const DerivedData* derived) cons
     // optional
     if (!derived->annotations.empty())
     {
-        XMLElem annotationsElem = newElement("Annotations", root);
+        XMLElem annotationsElem = createElement("Annotations", root);
         for (size_t i = 0, num = derived->annotations.size(); i < num; ++i)
         {
             convertAnnotationToXML(derived->annotations[i].get(),
@@ -281,14 +281,25 @@ xml::lite::Document* DerivedXMLParser200::toXML(const DerivedData* derived) cons
     }
 
     //set the ElemNS
-    root->setNamespacePrefix("", getDefaultURI());
-    root->setNamespacePrefix("si", SI_COMMON_URI);
-    root->setNamespacePrefix("sfa", SFA_URI);
-    root->setNamespacePrefix("ism", ISM_URI);
+    setNamespacePrefixes(root);
 
     return doc;
 }
 
+six::XMLStreamWriter::Namespaces
+DerivedXMLParser200::getNamespacePrefixes() const
+{
+    six::XMLStreamWriter::Namespaces namespaces;
+    namespaces.push_back(std::make_pair(std::string(), getDefaultURI()));
+    namespaces.push_back(std::make_pair(std::string("si"),
+                                        std::string(SI_COMMON_URI)));
+    namespaces.push_back(std::make_pair(std::string("sfa"),
+                                        std::string(SFA_URI)));
+    namespaces.push_back(std::make_pair(std::string("ism"),
+                                        std::string(ISM_URI)));
+    return namespaces;
+}
+
 void DerivedXMLParser200::parseDerivedClassificationFromXML(
         const XMLElem classificationElem,
         DerivedClassification& classification) const
@@ -852,7 +863,7 @@ XMLElem DerivedXMLParser200::convertDerivedClassificationToXML(
         const DerivedClassification& classification,
         XMLElem parent) const
 {
-    XMLElem classElem = newElement("Classification", parent);
+    XMLElem classElem = createElement("Classification", parent);
 
     common().addParameters("SecurityExtension",
                     classification.securityExtensions,
@@ -1009,7 +1020,7 @@ XMLElem DerivedXMLParser200::convertLookupTableToXML(
         const LookupTable& table,
         XMLElem parent) const
 {
-    XMLElem lookupElem = newElement(name, parent);
+    XMLElem lookupElem = createElement(name, parent);
     createString("LUTName", table.lutName, lookupElem);
 
     bool ok = false;
@@ -1018,7 +1029,7 @@ XMLElem DerivedXMLParser200::convertLookupTableToXML(
         if (table.custom.get() == NULL)
         {
             ok = true;
-            XMLElem predefElem = newElement("Predefined", lookupElem);
+            XMLElem predefElem = createElement("Predefined", lookupElem);
 
             //exactly one of databaseName or (remapFamily and remapMember) can be set
             bool innerOk = false;
@@ -1049,8 +1060,8 @@ XMLElem DerivedXMLParser200::convertLookupTableToXML(
         ok = true;
         std::vector<LUT>& lutValues = table.custom->lutValues;
 
-        XMLElem customElem = newElement("Custom", lookupElem);
-        XMLElem lutInfoElem = newElement("LUTInfo", customElem);
+        XMLElem customElem = createElement("Custom", lookupElem);
+        XMLElem lutInfoElem = createElement("LUTInfo", customElem);
         setAttribute(lutInfoElem, "numLuts", str::toString(lutValues.size()));
         setAttribute(lutInfoElem, "size",
                      str::toString(lutValues[0].table.size()));
@@ -1072,10 +1083,10 @@ XMLElem DerivedXMLParser200::convertNonInteractiveProcessingToXML(
         const NonInteractiveProcessing& processing,
         XMLElem parent) const
 {
-    XMLElem processingElem = newElement("NonInteractiveProcessing", parent);
+    XMLElem processingElem = createElement("NonInteractiveProcessing", parent);
 
     // ProductGenerationOptions
-    XMLElem prodGenElem = newElement("ProductGenerationOptions",
+    XMLElem prodGenElem = createElement("ProductGenerationOptions",
                                     processingElem);
 
     const ProductGenerationOptions& prodGen =
@@ -1084,7 +1095,7 @@ XMLElem DerivedXMLParser200::convertNonInteractiveProcessingToXML(
     if (prodGen.bandEqualization.get())
     {
         const BandEqualization& bandEq = *prodGen.bandEqualization;
-        XMLElem bandEqElem = newElement("BandEqualization", prodGenElem);
+        XMLElem bandEqElem = createElement("BandEqualization", prodGenElem);
         createStringFromEnum("Algorithm", bandEq.algorithm, bandEqElem);
         for (size_t ii = 0; ii < bandEq.bandLUTs.size(); ++ii)
         {
@@ -1120,7 +1131,7 @@ XMLElem DerivedXMLParser200::convertNonInteractiveProcessingToXML(
     }
 
     // RRDS
-    XMLElem rrdsElem = newElement("RRDS", processingElem);
+    XMLElem rrdsElem = createElement("RRDS", processingElem);
 
     const RRDS& rrds = processing.rrds;
     createStringFromEnum("DownsamplingMethod", rrds.downsamplingMethod,
@@ -1143,26 +1154,26 @@ XMLElem DerivedXMLParser200::convertInteractiveProcessingToXML(
         const InteractiveProcessing& processing,
         XMLElem parent) const
 {
-    XMLElem processingElem = newElement("InteractiveProcessing", parent);
+    XMLElem processingElem = createElement("InteractiveProcessing", parent);
 
     // GeometricTransform
     const GeometricTransform& geoTransform(processing.geometricTransform);
-    XMLElem geoTransformElem = newElement("GeometricTransform", processingElem);
+    XMLElem geoTransformElem = createElement("GeometricTransform", processingElem);
 
-    XMLElem scalingElem = newElement("Scaling", geoTransformElem);
+    XMLElem scalingElem = createElement("Scaling", geoTransformElem);
     convertFilterToXML("AntiAlias", geoTransform.scaling.antiAlias,
                        scalingElem);
     convertFilterToXML("Interpolation", geoTransform.scaling.interpolation,
                        scalingElem);
 
-    XMLElem orientationElem = newElement("Orientation", geoTransformElem);
+    XMLElem orientationElem = createElement("Orientation", geoTransformElem);
     createStringFromEnum("ShadowDirection",
         geoTransform.orientation.shadowDirection,
         orientationElem);
 
     // SharpnessEnhancement
     const SharpnessEnhancement& sharpness(processing.sharpnessEnhancement);
-    XMLElem sharpElem = newElement("SharpnessEnhancement", processingElem);
+    XMLElem sharpElem = createElement("SharpnessEnhancement", processingElem);
 
     bool ok = false;
     if (sharpness.modularTransferFunctionCompensation.get())
@@ -1197,9 +1208,9 @@ XMLElem DerivedXMLParser200::convertInteractiveProcessingToXML(
                 processing.colorSpaceTransform->colorManagementModule;
 
         XMLElem colorSpaceTransformElem =
-                newElement("ColorSpaceTransform", processingElem);
+                createElement("ColorSpaceTransform", processingElem);
         XMLElem cmmElem =
-                newElement("ColorManagementModule", colorSpaceTransformElem);
+                createElement("ColorManagementModule", colorSpaceTransformElem);
 
         createStringFromEnum("RenderingIntent", cmm.renderingIntent, cmmElem);
 
@@ -1219,7 +1230,7 @@ XMLElem DerivedXMLParser200::convertInteractiveProcessingToXML(
             processing.dynamicRangeAdjustment;
 
     XMLElem adjustElem =
-        newElement("DynamicRangeAdjustment", processingElem);
+        createElement("DynamicRangeAdjustment", processingElem);
 
     createStringFromEnum("AlgorithmType", adjust.algorithmType,
         adjustElem);
@@ -1230,7 +1241,7 @@ XMLElem DerivedXMLParser200::convertInteractiveProcessingToXML(
                       adjust.draOverrides.get());
     if (adjust.draParameters.get())
     {
-        XMLElem paramElem = newElement("DRAParameters", adjustElem);
+        XMLElem paramElem = createElement("DRAParameters", adjustElem);
         createDouble("Pmin", adjust.draParameters->pMin, paramElem);
         createDouble("Pmax", adjust.draParameters->pMax, paramElem);
         createDouble("EminModifier", adjust.draParameters->eMinModifier, paramElem);
@@ -1238,7 +1249,7 @@ XMLElem DerivedXMLParser200::convertInteractiveProcessingToXML(
     }
     if (adjust.draOverrides.get())
     {
-        XMLElem overrideElem = newElement("DRAOverrides", adjustElem);
+        XMLElem overrideElem = createElement("DRAOverrides", adjustElem);
         createDouble("Subtractor", adjust.draOverrides->subtractor, overrideElem);
         createDouble("Multiplier", adjust.draOverrides->multiplier, overrideElem);
     }
@@ -1254,7 +1265,7 @@ XMLElem DerivedXMLParser200::convertPredefinedFilterToXML(
         const Filter::Predefined& predefined,
         XMLElem parent) const
 {
-    XMLElem predefinedElem = newElement("Predefined", parent);
+    XMLElem predefinedElem = createElement("Predefined", parent);
 
     // Make sure either DBName or FilterFamily+FilterMember are defined
     bool ok = false;
@@ -1291,7 +1302,7 @@ XMLElem DerivedXMLParser200::convertKernelToXML(
         const Filter::Kernel& kernel,
         XMLElem parent) const
 {
-    XMLElem kernelElem = newElement("FilterKernel", parent);
+    XMLElem kernelElem = createElement("FilterKernel", parent);
 
     bool ok = false;
     if (kernel.predefined.get())
@@ -1306,7 +1317,7 @@ XMLElem DerivedXMLParser200::convertKernelToXML(
     {
         ok = true;
 
-        XMLElem customElem = newElement("Custom", kernelElem);
+        XMLElem customElem = createElement("Custom", kernelElem);
 
         if (kernel.custom->filterCoef.size() !=
             static_cast<size_t>(kernel.custom->size.row) * kernel.custom->size.col)
@@ -1318,7 +1329,7 @@ XMLElem DerivedXMLParser200::convertKernelToXML(
             throw except::Exception(Ctxt(ostr.str()));
         }
 
-        XMLElem filterCoef = newElement("FilterCoefficients", customElem);
+        XMLElem filterCoef = createElement("FilterCoefficients", customElem);
         setAttribute(filterCoef, "numRows", str::toString(kernel.custom->size.row));
         setAttribute(filterCoef, "numCols", str::toString(kernel.custom->size.col));
 
@@ -1344,7 +1355,7 @@ XMLElem DerivedXMLParser200::convertKernelToXML(
 XMLElem DerivedXMLParser200::convertBankToXML(const Filter::Bank& bank,
     XMLElem parent) const
 {
-    XMLElem bankElem = newElement("FilterBank", parent);
+    XMLElem bankElem = createElement("FilterBank", parent);
 
     bool ok = false;
     if (bank.predefined.get())
@@ -1359,7 +1370,7 @@ XMLElem DerivedXMLParser200::convertBankToXML(const Filter::Bank& bank,
     {
         ok = true;
 
-        XMLElem customElem = newElement("Custom", bankElem);
+        XMLElem customElem = createElement("Custom", bankElem);
 
         if (bank.custom->filterCoef.size() !=
             static_cast<size_t>(bank.custom->numPhasings) * bank.custom->numPoints)
@@ -1371,7 +1382,7 @@ XMLElem DerivedXMLParser200::convertBankToXML(const Filter::Bank& bank,
             throw except::Exception(Ctxt(ostr.str()));
         }
 
-        XMLElem filterCoef = newElement("FilterCoefficients", customElem);
+        XMLElem filterCoef = createElement("FilterCoefficients", customElem);
         setAttribute(filterCoef, "numPhasings", str::toString(bank.custom->numPhasings));
         setAttribute(filterCoef, "numPoints", str::toString(bank.custom->numPoints));
 
@@ -1398,7 +1409,7 @@ XMLElem DerivedXMLParser200::convertFilterToXML(const std::string& name,
                                                 const Filter& filter,
                                                 XMLElem parent) const
 {
-    XMLElem filterElem = newElement(name, parent);
+    XMLElem filterElem = createElement(name, parent);
 
     createString("FilterName", filter.filterName, filterElem);
 
@@ -1433,14 +1444,14 @@ XMLElem DerivedXMLParser200::convertCompressionToXML(
         const Compression& compression,
         XMLElem parent) const
 {
-    XMLElem compressionElem = newElement("Compression", parent);
-    XMLElem j2kElem = newElement("J2K", compressionElem);
-    XMLElem originalElem = newElement("Original", j2kElem);
+    XMLElem compressionElem = createElement("Compression", parent);
+    XMLElem j2kElem = createElement("J2K", compressionElem);
+    XMLElem originalElem = createElement("Original", j2kElem);
     convertJ2KToXML(compression.original, originalElem);
 
     if (compression.parsed.get())
     {
-        XMLElem parsedElem = newElement("Parsed", j2kElem);
+        XMLElem parsedElem = createElement("Parsed", j2kElem);
         convertJ2KToXML(*compression.parsed, parsedElem);
     }
     return compressionElem;
@@ -1453,12 +1464,12 @@ void DerivedXMLParser200::convertJ2KToXML(const J2KCompression& j2k,
     createInt("NumBands", j2k.numBands, parent);
 
     size_t numLayers = j2k.layerInfo.size();
-    XMLElem layerInfoElem = newElement("LayerInfo", parent);
+    XMLElem layerInfoElem = createElement("LayerInfo", parent);
     setAttribute(layerInfoElem, "numLayers", toString(numLayers));
 
     for (size_t ii = 0; ii < numLayers; ++ii)
     {
-        XMLElem layerElem = newElement("Layer", layerInfoElem);
+        XMLElem layerElem = createElement("Layer", layerInfoElem);
         setAttribute(layerElem, "index", toString(ii + 1));
         createDouble("Bitrate", j2k.layerInfo[ii].bitRate, layerElem);
     }
@@ -1482,7 +1493,7 @@ XMLElem DerivedXMLParser200::convertMeasurementToXML(const Measurement* measurem
     const size_t numVertices = measurement->validData.size();
     if (numVertices >= 3)
     {
-        XMLElem vElem = newElement("ValidData", measurementElem);
+        XMLElem vElem = createElement("ValidData", measurementElem);
         setAttribute(vElem, "size", str::toString(numVertices));
 
         for (size_t ii = 0; ii < numVertices; ++ii)
@@ -1505,7 +1516,7 @@ XMLElem DerivedXMLParser200::convertExploitationFeaturesToXML(
     XMLElem parent) const
 {
     XMLElem exploitationFeaturesElem =
-        newElement("ExploitationFeatures", parent);
+        createElement("ExploitationFeatures", parent);
 
     if (exploitationFeatures->collections.size() < 1)
     {
@@ -1518,17 +1529,17 @@ XMLElem DerivedXMLParser200::convertExploitationFeaturesToXML(
     for (size_t i = 0; i < exploitationFeatures->collections.size(); ++i)
     {
         Collection* collection = exploitationFeatures->collections[i].get();
-        XMLElem collectionElem = newElement("Collection",
+        XMLElem collectionElem = createElement("Collection",
             exploitationFeaturesElem);
         setAttribute(collectionElem, "identifier", collection->identifier);
 
         // create Information
-        XMLElem informationElem = newElement("Information", collectionElem);
+        XMLElem informationElem = createElement("Information", collectionElem);
 
         createString("SensorName",
             collection->information.sensorName,
             informationElem);
-        XMLElem radarModeElem = newElement("RadarMode", informationElem);
+        XMLElem radarModeElem = createElement("RadarMode", informationElem);
         createString("ModeType",
             common().getSICommonURI(),
             six::toString(collection->information.radarMode),
@@ -1564,7 +1575,7 @@ XMLElem DerivedXMLParser200::convertExploitationFeaturesToXML(
         // optional
         if (collection->information.inputROI.get())
         {
-            XMLElem roiElem = newElement("InputROI", informationElem);
+            XMLElem roiElem = createElement("InputROI", informationElem);
             common().createRowCol("Size",
                 collection->information.inputROI->size,
                 roiElem);
@@ -1577,7 +1588,7 @@ XMLElem DerivedXMLParser200::convertExploitationFeaturesToXML(
             collection->information.polarization.size(); n < nElems; ++n)
         {
             TxRcvPolarization *p = collection->information.polarization[n].get();
-            XMLElem polElem = newElement("Polarization", informationElem);
+            XMLElem polElem = createElement("Polarization", informationElem);
 
             createString("TxPolarization",
                 six::toString(p->txPolarization),
@@ -1604,7 +1615,7 @@ XMLElem DerivedXMLParser200::convertExploitationFeaturesToXML(
         Geometry* geom = collection->geometry.get();
         if (geom != NULL)
         {
-            XMLElem geometryElem = newElement("Geometry", collectionElem);
+            XMLElem geometryElem = createElement("Geometry", collectionElem);
 
             // optional
             if (geom->azimuth != Init::undefined<double>())
@@ -1633,13 +1644,13 @@ XMLElem DerivedXMLParser200::convertExploitationFeaturesToXML(
         Phenomenology* phenom = collection->phenomenology.get();
         if (phenom != NULL)
         {
-            XMLElem phenomenologyElem = newElement("Phenomenology",
+            XMLElem phenomenologyElem = createElement("Phenomenology",
                 collectionElem);
 
             // optional
             if (phenom->shadow != Init::undefined<AngleMagnitude>())
             {
-                XMLElem shadow = newElement("Shadow", phenomenologyElem);
+                XMLElem shadow = createElement("Shadow", phenomenologyElem);
                 createDouble("Angle", common().getSICommonURI(),
                     phenom->shadow.angle, shadow);
                 createDouble("Magnitude", common().getSICommonURI(),
@@ -1648,7 +1659,7 @@ XMLElem DerivedXMLParser200::convertExploitationFeaturesToXML(
             // optional
             if (phenom->layover != Init::undefined<AngleMagnitude>())
             {
-                XMLElem layover = newElement("Layover", phenomenologyElem);
+                XMLElem layover = createElement("Layover", phenomenologyElem);
                 createDouble("Angle", common().getSICommonURI(),
                     phenom->layover.angle, layover);
                 createDouble("Magnitude", common().getSICommonURI(),
@@ -1676,7 +1687,7 @@ XMLElem DerivedXMLParser200::convertExploitationFeaturesToXML(
 
     for (size_t ii = 0; ii < exploitationFeatures->product.size(); ++ii)
     {
-        XMLElem productElem = newElement("Product", exploitationFeaturesElem);
+        XMLElem productElem = createElement("Product", exploitationFeaturesElem);
         const Product& product = exploitationFeatures->product[ii];
 
         common().createRowCol("Resolution",
@@ -1693,7 +1704,7 @@ XMLElem DerivedXMLParser200::convertExploitationFeaturesToXML(
 
         for (size_t jj = 0; jj < product.polarization.size(); ++jj)
         {
-            XMLElem polarizationElem = newElement("Polarization", productElem);
+            XMLElem polarizationElem = createElement("Polarization", productElem);
             createStringFromEnum("TxPolarizationProc",
                                  product.polarization[jj].txPolarizationProc,
                                  polarizationElem);
@@ -1722,7 +1733,7 @@ XMLElem DerivedXMLParser200::convertDisplayToXML(
     // NOTE: In several spots here, there are fields which are required in
     //       SIDD 2.0 but a pointer in the Display class since it didn't exist
     //       in SIDD 1.0, so need to confirm it's allocated
-    XMLElem displayElem = newElement("Display", parent);
+    XMLElem displayElem = createElement("Display", parent);
 
     createString("PixelType", six::toString(display.pixelType), displayElem);
 
@@ -1764,7 +1775,7 @@ XMLElem DerivedXMLParser200::convertGeographicTargetToXML(
         const GeographicAndTarget& geographicAndTarget,
         XMLElem parent) const
 {
-    XMLElem geographicAndTargetElem = newElement("GeographicAndTarget", parent);
+    XMLElem geographicAndTargetElem = createElement("GeographicAndTarget", parent);
 
     common().createEarthModelType("EarthModel", geographicAndTarget.earthModel, geographicAndTargetElem);
 
@@ -1778,7 +1789,7 @@ XMLElem DerivedXMLParser200::convertGeographicTargetToXML(
     const size_t numVertices = geographicAndTarget.validData.size();
     if (numVertices >= 3)
     {
-        XMLElem vElem = newElement("ValidData", geographicAndTargetElem);
+        XMLElem vElem = createElement("ValidData", geographicAndTargetElem);
         setAttribute(vElem, "size", str::toString(numVertices));
 
         for (size_t ii = 0; ii < numVertices; ++ii)
@@ -1809,10 +1820,10 @@ XMLElem DerivedXMLParser200::convertDigitalElevationDataToXML(
         const DigitalElevationData& ded,
         XMLElem parent) const
 {
-    XMLElem dedElem = newElement("DigitalElevationData", parent);
+    XMLElem dedElem = createElement("DigitalElevationData", parent);
 
     // GeographicCoordinates
-    XMLElem geoCoordElem = newElement("GeographicCoordinates", dedElem);
+    XMLElem geoCoordElem = createElement("GeographicCoordinates", dedElem);
     createDouble("LongitudeDensity",
                  ded.geographicCoordinates.longitudeDensity,
                  geoCoordElem);
@@ -1824,7 +1835,7 @@ XMLElem DerivedXMLParser200::convertDigitalElevationDataToXML(
                           geoCoordElem);
 
     // Geopositioning
-    XMLElem geoposElem = newElement("Geopositioning", dedElem);
+    XMLElem geoposElem = createElement("Geopositioning", dedElem);
     createStringFromEnum("CoordinateSystemType",
                          ded.geopositioning.coordinateSystemType,
                          geoposElem);
@@ -1845,10 +1856,10 @@ XMLElem DerivedXMLParser200::convertDigitalElevationDataToXML(
     }
 
     // PositionalAccuracy
-    XMLElem posAccElem = newElement("PositionalAccuracy", dedElem);
+    XMLElem posAccElem = createElement("PositionalAccuracy", dedElem);
     createInt("NumRegions", ded.positionalAccuracy.numRegions, posAccElem);
 
-    XMLElem absAccElem = newElement("AbsoluteAccuracy", posAccElem);
+    XMLElem absAccElem = createElement("AbsoluteAccuracy", posAccElem);
     createDouble("Horizontal",
                  ded.positionalAccuracy.absoluteAccuracyHorizontal,
                  absAccElem);
@@ -1856,7 +1867,7 @@ XMLElem DerivedXMLParser200::convertDigitalElevationDataToXML(
                  ded.positionalAccuracy.absoluteAccuracyVertical,
                  absAccElem);
 
-    XMLElem p2pAccElem = newElement("PointToPointAccuracy", posAccElem);
+    XMLElem p2pAccElem = createElement("PointToPointAccuracy", posAccElem);
     createDouble("Horizontal",
                  ded.positionalAccuracy.pointToPointAccuracyHorizontal,
                  p2pAccElem);
@@ -2050,7 +2061,7 @@ std::auto_ptr<LUT> DerivedXMLParser200::parseSingleLUT(const XMLElem elem,
 XMLElem DerivedXMLParser200::createLUT(const std::string& name, const LUT *lut,
         XMLElem parent) const
 {
-    XMLElem lutElement = newElement(name, parent);
+    XMLElem lutElement = createElement(name, parent);
     return createLUTImpl(lut, lutElement);
 }
 }
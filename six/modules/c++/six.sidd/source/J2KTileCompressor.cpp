@@ -0,0 +1,345 @@
+/* =========================================================================
+ * This file is part of six.sidd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six.sidd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <string.h>
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+
+#include <except/Exception.h>
+#include <six/sidd/J2KTileCompressor.h>
+
+#include <openjpeg.h>
+
+namespace
+{
+// Collects the codestream as OpenJPEG writes it out
+struct OutputBuffer
+{
+    OutputBuffer(std::vector<sys::ubyte>& bytes) :
+        bytes(bytes),
+        pos(0)
+    {
+    }
+
+    std::vector<sys::ubyte>& bytes;
+    size_t pos;
+};
+
+OPJ_SIZE_T writeBytes(void* buffer, OPJ_SIZE_T numBytes, void* userData)
+{
+    OutputBuffer& output = *static_cast<OutputBuffer*>(userData);
+    if (numBytes > 0)
+    {
+        if (output.pos + numBytes > output.bytes.size())
+        {
+            output.bytes.resize(output.pos + numBytes);
+        }
+        ::memcpy(&output.bytes[output.pos], buffer, numBytes);
+        output.pos += numBytes;
+    }
+    return numBytes;
+}
+
+OPJ_BOOL seekBytes(OPJ_OFF_T pos, void* userData)
+{
+    OutputBuffer& output = *static_cast<OutputBuffer*>(userData);
+    if (pos < 0)
+    {
+        return OPJ_FALSE;
+    }
+
+    output.pos = static_cast<size_t>(pos);
+    if (output.pos > output.bytes.size())
+    {
+        output.bytes.resize(output.pos);
+    }
+    return OPJ_TRUE;
+}
+
+OPJ_OFF_T skipBytes(OPJ_OFF_T numBytes, void* userData)
+{
+    const OutputBuffer& output = *static_cast<OutputBuffer*>(userData);
+    const OPJ_OFF_T pos = static_cast<OPJ_OFF_T>(output.pos) + numBytes;
+    return seekBytes(pos, userData) ? numBytes : -1;
+}
+
+void recordError(const char* message, void* userData)
+{
+    // Keep the first message; later ones tend to just say the step failed
+    std::string& error = *static_cast<std::string*>(userData);
+    if (error.empty())
+    {
+        error = message;
+    }
+}
+
+void throwOpenJPEGError(const std::string& step, const std::string& error)
+{
+    throw except::Exception(Ctxt(
+            "OpenJPEG failed to " + step +
+            (error.empty() ? std::string() : ": " + error)));
+}
+
+// Frees the OpenJPEG objects no matter how compress() exits
+class OpenJPEGObjects
+{
+public:
+    OpenJPEGObjects() :
+        image(NULL),
+        codec(NULL),
+        stream(NULL)
+    {
+    }
+
+    ~OpenJPEGObjects()
+    {
+        if (stream)
+        {
+            opj_stream_destroy(stream);
+        }
+        if (codec)
+        {
+            opj_destroy_codec(codec);
+        }
+        if (image)
+        {
+            opj_image_destroy(image);
+        }
+    }
+
+    opj_image_t* image;
+    opj_codec_t* codec;
+    opj_stream_t* stream;
+};
+
+// Turns the SIDD layer bit rates into OpenJPEG compression ratios
+void setLayers(const six::sidd::J2KCompression& settings,
+               size_t numBitsPerPixel,
+               opj_cparameters_t& parameters)
+{
+    parameters.cp_disto_alloc = 1;
+
+    const std::vector<six::sidd::J2KCompression::Layer>& layers =
+            settings.layerInfo;
+    if (layers.empty())
+    {
+        parameters.tcp_numlayers = 1;
+        parameters.tcp_rates[0] = 0;
+        return;
+    }
+
+    const size_t maxNumLayers =
+            sizeof(parameters.tcp_rates) / sizeof(parameters.tcp_rates[0]);
+    if (layers.size() > maxNumLayers)
+    {
+        std::ostringstream ostr;
+        ostr << "Cannot J2K compress " << layers.size()
+             << " layers; OpenJPEG supports at most " << maxNumLayers;
+        throw except::Exception(Ctxt(ostr.str()));
+    }
+
+    for (size_t ii = 0; ii < layers.size(); ++ii)
+    {
+        const double bitRate = layers[ii].bitRate;
+        if (bitRate <= 0 || (ii > 0 && bitRate <= layers[ii - 1].bitRate))
+        {
+            throw except::Exception(Ctxt(
+                    "J2K layer bit rates must be positive and increase from "
+                    "one layer to the next"));
+        }
+
+        // A ratio of 0 leaves the layer untruncated
+        const double ratio = numBitsPerPixel / bitRate;
+        if (ratio <= 1 && ii + 1 != layers.size())
+        {
+            throw except::Exception(Ctxt(
+                    "Only the last J2K layer can reach the uncompressed bit "
+                    "rate"));
+        }
+        parameters.tcp_rates[ii] = (ratio > 1) ? static_cast<float>(ratio) : 0;
+    }
+    parameters.tcp_numlayers = static_cast<int>(layers.size());
+}
+
+// How many resolutions fit in the tile, capped at OpenJPEG's default
+int getDefaultNumResolutions(const types::RowCol<size_t>& tileDims,
+                             int defaultNumResolutions)
+{
+    const size_t minDim = std::min(tileDims.row, tileDims.col);
+    int numResolutions = 1;
+    while (numResolutions < defaultNumResolutions &&
+           (static_cast<size_t>(1) << numResolutions) <= minDim)
+    {
+        ++numResolutions;
+    }
+    return numResolutions;
+}
+}
+
+namespace six
+{
+namespace sidd
+{
+void J2KTileCompressor::compress(const sys::ubyte* pixels,
+                                 const types::RowCol<size_t>& offset,
+                                 const types::RowCol<size_t>& dims,
+                                 const types::RowCol<size_t>& tileDims,
+                                 size_t numBytesPerPixel,
+                                 const J2KCompression& settings,
+                                 std::vector<sys::ubyte>& compressed) const
+{
+    size_t numComponents;
+    size_t precision;
+    OPJ_COLOR_SPACE colorSpace;
+    switch (numBytesPerPixel)
+    {
+    case 1:
+    case 2:
+        numComponents = 1;
+        precision = numBytesPerPixel * 8;
+        colorSpace = OPJ_CLRSPC_GRAY;
+        break;
+    case 3:
+        numComponents = 3;
+        precision = 8;
+        colorSpace = OPJ_CLRSPC_SRGB;
+        break;
+    default:
+    {
+        std::ostringstream ostr;
+        ostr << "Cannot J2K compress " << numBytesPerPixel
+             << " byte pixels";
+        throw except::Exception(Ctxt(ostr.str()));
+    }
+    }
+
+    opj_cparameters_t parameters;
+    opj_set_default_encoder_parameters(&parameters);
+
+    // The tile grid starts at this tile, so it's the only one in the
+    // codestream
+    parameters.tile_size_on = OPJ_TRUE;
+    parameters.cp_tx0 = static_cast<int>(offset.col);
+    parameters.cp_ty0 = static_cast<int>(offset.row);
+    parameters.cp_tdx = static_cast<int>(tileDims.col);
+    parameters.cp_tdy = static_cast<int>(tileDims.row);
+    parameters.tcp_mct = static_cast<char>(numComponents == 3 ? 1 : 0);
+    parameters.numresolution = (settings.numWaveletLevels > 0) ?
+            static_cast<int>(settings.numWaveletLevels + 1) :
+            getDefaultNumResolutions(tileDims, parameters.numresolution);
+    setLayers(settings, numBytesPerPixel * 8, parameters);
+
+    std::vector<opj_image_cmptparm_t> componentParameters(numComponents);
+    ::memset(&componentParameters[0], 0,
+             sizeof(opj_image_cmptparm_t) * numComponents);
+    for (size_t ii = 0; ii < numComponents; ++ii)
+    {
+        opj_image_cmptparm_t& component = componentParameters[ii];
+        component.dx = 1;
+        component.dy = 1;
+        component.w = static_cast<OPJ_UINT32>(dims.col);
+        component.h = static_cast<OPJ_UINT32>(dims.row);
+        component.x0 = static_cast<OPJ_UINT32>(offset.col);
+        component.y0 = static_cast<OPJ_UINT32>(offset.row);
+        component.prec = static_cast<OPJ_UINT32>(precision);
+        component.bpp = static_cast<OPJ_UINT32>(precision);
+        component.sgnd = 0;
+    }
+
+    OpenJPEGObjects objects;
+    objects.image = opj_image_tile_create(
+            static_cast<OPJ_UINT32>(numComponents), &componentParameters[0],
+            colorSpace);
+    if (!objects.image)
+    {
+        throwOpenJPEGError("create the image", "");
+    }
+
+    // Place the tile on the reference grid where it sits in the segment
+    objects.image->x0 = static_cast<OPJ_UINT32>(offset.col);
+    objects.image->y0 = static_cast<OPJ_UINT32>(offset.row);
+    objects.image->x1 = static_cast<OPJ_UINT32>(offset.col + dims.col);
+    objects.image->y1 = static_cast<OPJ_UINT32>(offset.row + dims.row);
+
+    objects.codec = opj_create_compress(OPJ_CODEC_J2K);
+    if (!objects.codec)
+    {
+        throwOpenJPEGError("create the codec", "");
+    }
+
+    std::string error;
+    opj_set_error_handler(objects.codec, recordError, &error);
+    if (!opj_setup_encoder(objects.codec, &parameters, objects.image))
+    {
+        throwOpenJPEGError("set up the encoder", error);
+    }
+
+    compressed.clear();
+    OutputBuffer output(compressed);
+    objects.stream = opj_stream_default_create(OPJ_FALSE);
+    if (!objects.stream)
+    {
+        throwOpenJPEGError("create the output stream", "");
+    }
+    opj_stream_set_user_data(objects.stream, &output, NULL);
+    opj_stream_set_write_function(objects.stream, writeBytes);
+    opj_stream_set_seek_function(objects.stream, seekBytes);
+    opj_stream_set_skip_function(objects.stream, skipBytes);
+
+    if (!opj_start_compress(objects.codec, objects.image, objects.stream))
+    {
+        throwOpenJPEGError("start compressing", error);
+    }
+
+    // OpenJPEG wants each component's samples together rather than
+    // interleaved by pixel
+    const size_t numBytes = dims.area() * numBytesPerPixel;
+    std::vector<sys::ubyte> planar;
+    if (numComponents > 1)
+    {
+        planar.resize(numBytes);
+        const size_t numPixels = dims.area();
+        for (size_t pixel = 0; pixel < numPixels; ++pixel)
+        {
+            for (size_t comp = 0; comp < numComponents; ++comp)
+            {
+                planar[comp * numPixels + pixel] =
+                        pixels[pixel * numComponents + comp];
+            }
+        }
+        pixels = &planar[0];
+    }
+
+    if (!opj_write_tile(objects.codec, 0, const_cast<OPJ_BYTE*>(pixels),
+                        static_cast<OPJ_UINT32>(numBytes), objects.stream))
+    {
+        throwOpenJPEGError("compress the tile", error);
+    }
+
+    if (!opj_end_compress(objects.codec, objects.stream))
+    {
+        throwOpenJPEGError("finish the codestream", error);
+    }
+}
+}
+}
@@ -0,0 +1,609 @@
+/* =========================================================================
+ * This file is part of six.sidd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six.sidd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <string.h>
+
+#include <algorithm>
+#include <sstream>
+
+#include <sys/OS.h>
+#include <except/Exception.h>
+#include <math/Round.h>
+#include <mt/Runnable1D.h>
+#include <six/ByteProvider.h>
+#include <six/NITFWriteControl.h>
+#include <six/sidd/CompressedSIDDByteProvider.h>
+#include <six/sidd/DerivedXMLControl.h>
+#include <six/sidd/ParallelCompressedSIDDWriter.h>
+
+namespace
+{
+// J2K markers needed to splice the tiles together
+const sys::ubyte MARKER = 0xFF;
+const sys::ubyte SOC = 0x4F;
+const sys::ubyte SIZ = 0x51;
+const sys::ubyte TLM = 0x55;
+const sys::ubyte PPM = 0x60;
+const sys::ubyte SOT = 0x90;
+const sys::ubyte EOC = 0xD9;
+
+// Lsiz through YTOsiz, plus Csiz
+const size_t SIZ_MIN_LENGTH = 40;
+
+// SOT marker segment plus the SOD marker
+const size_t TILE_PART_MIN_LENGTH = 14;
+
+// J2K has room for 65535 tiles (Isot is 16 bits and 65535 is reserved)
+const size_t MAX_NUM_TILES = 65535;
+
+size_t readUint16(const std::vector<sys::ubyte>& bytes, size_t pos)
+{
+    return (static_cast<size_t>(bytes[pos]) << 8) | bytes[pos + 1];
+}
+
+size_t readUint32(const std::vector<sys::ubyte>& bytes, size_t pos)
+{
+    return (readUint16(bytes, pos) << 16) | readUint16(bytes, pos + 2);
+}
+
+void writeUint16(size_t value, size_t pos, std::vector<sys::ubyte>& bytes)
+{
+    bytes[pos] = static_cast<sys::ubyte>(value >> 8);
+    bytes[pos + 1] = static_cast<sys::ubyte>(value);
+}
+
+void writeUint32(size_t value, size_t pos, std::vector<sys::ubyte>& bytes)
+{
+    writeUint16(value >> 16, pos, bytes);
+    writeUint16(value & 0xFFFF, pos + 2, bytes);
+}
+
+void throwMalformed(const std::string& details)
+{
+    throw except::Exception(Ctxt(
+            "Tile compressor produced a malformed codestream: " + details));
+}
+
+/*
+ * Turns the codestream the TileCompressor produced for one tile into that
+ * tile's share of its image segment's codestream: the tile's tile-parts,
+ * renumbered to 'tileIndex', preceded by the segment's main header if it's
+ * the segment's first tile and followed by EOC if it's the last.
+ */
+void spliceTile(const std::vector<sys::ubyte>& codestream,
+                size_t tileIndex,
+                const types::RowCol<size_t>& segmentDims,
+                const types::RowCol<size_t>& tileDims,
+                bool isFirstTile,
+                bool isLastTile,
+                std::vector<sys::ubyte>& block)
+{
+    const size_t size = codestream.size();
+    if (size < 4 || codestream[0] != MARKER || codestream[1] != SOC)
+    {
+        throwMalformed("no SOC marker");
+    }
+
+    // The main header is every marker segment up to the first SOT
+    size_t pos = 2;
+    size_t sizPos = 0;
+    while (true)
+    {
+        if (pos + 4 > size || codestream[pos] != MARKER)
+        {
+            throwMalformed("truncated main header");
+        }
+
+        const sys::ubyte marker = codestream[pos + 1];
+        if (marker == SOT)
+        {
+            break;
+        }
+        else if (marker == SIZ)
+        {
+            sizPos = pos;
+        }
+        else if (marker == TLM || marker == PPM)
+        {
+            throw except::Exception(Ctxt(
+                    "Tile compressor produced TLM or PPM markers, which "
+                    "can't be spliced into the image segment's codestream"));
+        }
+        pos += 2 + readUint16(codestream, pos + 2);
+    }
+    const size_t mainHeaderEnd = pos;
+
+    if (sizPos == 0 || sizPos + 2 + SIZ_MIN_LENGTH > mainHeaderEnd)
+    {
+        throwMalformed("no SIZ marker");
+    }
+    if (readUint32(codestream, sizPos + 22) != tileDims.col ||
+        readUint32(codestream, sizPos + 26) != tileDims.row)
+    {
+        std::ostringstream ostr;
+        ostr << "Tile compressor used " << readUint32(codestream, sizPos + 26)
+             << " x " << readUint32(codestream, sizPos + 22)
+             << " tiles rather than the " << tileDims.row << " x "
+             << tileDims.col << " block size";
+        throw except::Exception(Ctxt(ostr.str()));
+    }
+
+    block.clear();
+    if (isFirstTile)
+    {
+        // Widen the image and tile grid from this one tile to the segment
+        block.assign(codestream.begin(), codestream.begin() + mainHeaderEnd);
+        writeUint32(segmentDims.col, sizPos + 6, block);
+        writeUint32(segmentDims.row, sizPos + 10, block);
+        writeUint32(0, sizPos + 14, block);
+        writeUint32(0, sizPos + 18, block);
+        writeUint32(0, sizPos + 30, block);
+        writeUint32(0, sizPos + 34, block);
+    }
+
+    // Each tile-part runs from its SOT marker through the end of its data
+    while (true)
+    {
+        if (pos + 2 > size || codestream[pos] != MARKER)
+        {
+            throwMalformed("truncated tile-part");
+        }
+        if (codestream[pos + 1] == EOC)
+        {
+            break;
+        }
+        if (codestream[pos + 1] != SOT || pos + TILE_PART_MIN_LENGTH > size)
+        {
+            throwMalformed("expected an SOT marker");
+        }
+
+        // A length of zero runs to the EOC marker, which is only allowed for
+        // the last tile-part of the codestream, so always fill it in
+        size_t length = readUint32(codestream, pos + 6);
+        if (length == 0)
+        {
+            length = size - 2 - pos;
+        }
+        if (length < TILE_PART_MIN_LENGTH || pos + length > size)
+        {
+            throwMalformed("bad tile-part length");
+        }
+
+        const size_t blockPos = block.size();
+        block.insert(block.end(), codestream.begin() + pos,
+                     codestream.begin() + pos + length);
+        writeUint16(tileIndex, blockPos + 4, block);
+        writeUint32(length, blockPos + 6, block);
+        pos += length;
+    }
+
+    if (isLastTile)
+    {
+        block.push_back(MARKER);
+        block.push_back(EOC);
+    }
+}
+
+/*
+ * Compresses one tile at a time out of a band of uncompressed rows.  Tiles
+ * are numbered in block order across all the block rows in the band.
+ */
+class CompressTiles
+{
+public:
+    // Where a row of tiles sits in the band and in its segment's codestream
+    struct TileRow
+    {
+        size_t bandOffset;
+        size_t numRows;
+        size_t segmentRow;
+        size_t firstTile;
+        size_t numTiles;
+        types::RowCol<size_t> segmentDims;
+        types::RowCol<size_t> tileDims;
+    };
+
+    CompressTiles(const sys::ubyte* band,
+                  const std::vector<TileRow>& tileRows,
+                  size_t numCols,
+                  size_t numColsPerBlock,
+                  size_t numBytesPerPixel,
+                  const six::sidd::TileCompressor& compressor,
+                  const six::sidd::J2KCompression& settings,
+                  std::vector<std::vector<sys::ubyte> >& tiles) :
+        mBand(band),
+        mTileRows(tileRows),
+        mNumCols(numCols),
+        mNumColsPerBlock(numColsPerBlock),
+        mNumBlocksPerRow(math::ceilingDivide(numCols, numColsPerBlock)),
+        mNumBytesPerPixel(numBytesPerPixel),
+        mCompressor(compressor),
+        mSettings(settings),
+        mTiles(tiles)
+    {
+    }
+
+    void operator()(size_t tile) const
+    {
+        const TileRow& tileRow = mTileRows[tile / mNumBlocksPerRow];
+        const size_t blockCol = tile % mNumBlocksPerRow;
+        const size_t startCol = blockCol * mNumColsPerBlock;
+
+        const types::RowCol<size_t> offset(tileRow.segmentRow, startCol);
+        const types::RowCol<size_t> dims(
+                tileRow.numRows,
+                std::min(mNumColsPerBlock, mNumCols - startCol));
+
+        const size_t inStride = mNumCols * mNumBytesPerPixel;
+        const size_t outStride = dims.col * mNumBytesPerPixel;
+        const sys::ubyte* input = mBand + tileRow.bandOffset +
+                startCol * mNumBytesPerPixel;
+
+        std::vector<sys::ubyte> pixels(dims.area() * mNumBytesPerPixel);
+        for (size_t row = 0; row < dims.row; ++row, input += inStride)
+        {
+            ::memcpy(&pixels[row * outStride], input, outStride);
+        }
+
+        std::vector<sys::ubyte> codestream;
+        mCompressor.compress(&pixels[0], offset, dims, tileRow.tileDims,
+                             mNumBytesPerPixel, mSettings, codestream);
+
+        const size_t tileIndex = tileRow.firstTile + blockCol;
+        spliceTile(codestream, tileIndex, tileRow.segmentDims,
+                   tileRow.tileDims, tileIndex == 0,
+                   tileIndex + 1 == tileRow.numTiles, mTiles[tile]);
+    }
+
+private:
+    const sys::ubyte* const mBand;
+    const std::vector<TileRow>& mTileRows;
+    const size_t mNumCols;
+    const size_t mNumColsPerBlock;
+    const size_t mNumBlocksPerRow;
+    const size_t mNumBytesPerPixel;
+    const six::sidd::TileCompressor& mCompressor;
+    const six::sidd::J2KCompression& mSettings;
+    std::vector<std::vector<sys::ubyte> >& mTiles;
+};
+
+six::sidd::J2KCompression getSettings(const six::sidd::DerivedData& data)
+{
+    return data.compression.get() ? data.compression->original :
+                                    six::sidd::J2KCompression();
+}
+
+// Stands in for the image data when asking the byte provider for a block
+// row, so the image data buffer can be told apart from the headers
+const sys::byte IMAGE_DATA = 0;
+}
+
+namespace six
+{
+namespace sidd
+{
+ParallelCompressedSIDDWriter::ParallelCompressedSIDDWriter(
+        const DerivedData& data,
+        const std::vector<std::string>& schemaPaths,
+        const TileCompressor& compressor,
+        bool isNumericallyLossless,
+        io::SeekableOutputStream& outStream,
+        size_t numRowsPerBlock,
+        size_t numColsPerBlock,
+        size_t numThreads,
+        size_t maxProductSize) :
+    mData(static_cast<DerivedData*>(data.clone())),
+    mSchemaPaths(schemaPaths),
+    mCompressor(compressor),
+    mSettings(getSettings(data)),
+    mIsNumericallyLossless(isNumericallyLossless),
+    mOutStream(outStream),
+    mStartOffset(outStream.tell()),
+    mNumRowsPerBlockOpt(numRowsPerBlock),
+    mNumColsPerBlockOpt(numColsPerBlock),
+    mNumThreads(numThreads == 0 ? sys::OS().getNumCPUs() : numThreads),
+    mMaxProductSize(maxProductSize),
+    mNumBytesPerRow(data.getNumCols() * data.getNumBytesPerPixel()),
+    mNumColsPerBlock(numColsPerBlock == 0 ?
+            data.getNumCols() : std::min(numColsPerBlock, data.getNumCols())),
+    mNextRow(0),
+    mNextBlockRow(0),
+    mNumBytesWritten(0),
+    mExtraBytesWritten(0)
+{
+    // The segmentation doesn't depend on the compressed size, so lay out an
+    // uncompressed NITF to find out where the image segments break
+    XMLControlRegistry xmlRegistry;
+    xmlRegistry.addCreator(DataType::DERIVED,
+                           new XMLControlCreatorT<DerivedXMLControl>());
+
+    mem::SharedPtr<Container> container(new Container(DataType::DERIVED));
+    container->addData(data.clone());
+
+    Options options;
+    six::ByteProvider::populateOptions(container, maxProductSize,
+                                       numRowsPerBlock, numColsPerBlock,
+                                       options);
+    const NITFWriteControl writer(options, container, &xmlRegistry);
+
+    const std::vector<NITFSegmentInfo> segments =
+            writer.getNITFHeaderCreator()->getInfos()[0]->getImageSegments();
+
+    const size_t numBlocksPerRow =
+            math::ceilingDivide(data.getNumCols(), mNumColsPerBlock);
+
+    mBytesPerBlock.resize(segments.size());
+    std::vector<std::vector<size_t> > placeholderBytesPerBlock(
+            segments.size());
+    for (size_t seg = 0; seg < segments.size(); ++seg)
+    {
+        const size_t rowsPerBlock = (numRowsPerBlock == 0) ?
+                segments[seg].numRows :
+                std::min(numRowsPerBlock, segments[seg].numRows);
+
+        mSegmentDims.push_back(types::RowCol<size_t>(segments[seg].numRows,
+                                                     data.getNumCols()));
+        mTileDims.push_back(types::RowCol<size_t>(rowsPerBlock,
+                                                  mNumColsPerBlock));
+
+        for (size_t row = 0; row < segments[seg].numRows; row += rowsPerBlock)
+        {
+            BlockRow blockRow;
+            blockRow.segment = seg;
+            blockRow.startRow = segments[seg].firstRow + row;
+            blockRow.numRows = std::min(rowsPerBlock,
+                                        segments[seg].numRows - row);
+            blockRow.segmentRow = row;
+            blockRow.firstTile = placeholderBytesPerBlock[seg].size();
+            blockRow.placeholderOffset = 0;
+            blockRow.offset = 0;
+            mBlockRows.push_back(blockRow);
+
+            placeholderBytesPerBlock[seg].resize(
+                    placeholderBytesPerBlock[seg].size() + numBlocksPerRow, 1);
+        }
+
+        if (placeholderBytesPerBlock[seg].size() > MAX_NUM_TILES)
+        {
+            std::ostringstream ostr;
+            ostr << "Image segment " << seg << " needs "
+                 << placeholderBytesPerBlock[seg].size()
+                 << " blocks but a J2K codestream holds at most "
+                 << MAX_NUM_TILES << " tiles";
+            throw except::Exception(Ctxt(ostr.str()));
+        }
+    }
+
+    // None of the header fields change width with the compressed size, so
+    // each block row's image data lands where it would if every block were
+    // one byte, shifted by the extra bytes the blocks before it took up
+    const std::auto_ptr<CompressedSIDDByteProvider> placeholderProvider =
+            makeByteProvider(placeholderBytesPerBlock);
+
+    nitf::Off fileOffset;
+    nitf::NITFBufferList buffers;
+    for (size_t ii = 0; ii < mBlockRows.size(); ++ii)
+    {
+        BlockRow& blockRow = mBlockRows[ii];
+        placeholderProvider->getBytes(&IMAGE_DATA,
+                                      blockRow.startRow,
+                                      blockRow.numRows,
+                                      fileOffset,
+                                      buffers);
+
+        blockRow.placeholderOffset = fileOffset;
+        for (size_t jj = 0;
+             buffers.mBuffers[jj].mData != &IMAGE_DATA;
+             ++jj)
+        {
+            blockRow.placeholderOffset += buffers.mBuffers[jj].mNumBytes;
+        }
+    }
+}
+
+std::auto_ptr<CompressedSIDDByteProvider>
+ParallelCompressedSIDDWriter::makeByteProvider(
+        const std::vector<std::vector<size_t> >& bytesPerBlock) const
+{
+    return std::auto_ptr<CompressedSIDDByteProvider>(
+            new CompressedSIDDByteProvider(*mData,
+                                           mSchemaPaths,
+                                           bytesPerBlock,
+                                           mIsNumericallyLossless,
+                                           mNumRowsPerBlockOpt,
+                                           mNumColsPerBlockOpt,
+                                           mMaxProductSize));
+}
+
+void ParallelCompressedSIDDWriter::addRows(const void* pixels, size_t numRows)
+{
+    if (mNextRow + numRows > mData->getNumRows())
+    {
+        std::ostringstream ostr;
+        ostr << "Adding rows [" << mNextRow << ", " << (mNextRow + numRows)
+             << ") but the image only has " << mData->getNumRows() << " rows";
+        throw except::Exception(Ctxt(ostr.str()));
+    }
+
+    const sys::ubyte* const pixelsPtr = static_cast<const sys::ubyte*>(pixels);
+    mStaged.insert(mStaged.end(), pixelsPtr,
+                   pixelsPtr + numRows * mNumBytesPerRow);
+    mNextRow += numRows;
+
+    size_t numBlockRows = 0;
+    while (mNextBlockRow + numBlockRows < mBlockRows.size())
+    {
+        const BlockRow& blockRow = mBlockRows[mNextBlockRow + numBlockRows];
+        if (blockRow.startRow + blockRow.numRows > mNextRow)
+        {
+            break;
+        }
+        ++numBlockRows;
+    }
+
+    if (numBlockRows > 0)
+    {
+        compressBlockRows(numBlockRows);
+    }
+}
+
+void ParallelCompressedSIDDWriter::compressBlockRows(size_t numBlockRows)
+{
+    const size_t firstRow = mBlockRows[mNextBlockRow].startRow;
+    const size_t numBlocksPerRow =
+            math::ceilingDivide(mData->getNumCols(), mNumColsPerBlock);
+
+    std::vector<CompressTiles::TileRow> tileRows(numBlockRows);
+    for (size_t ii = 0; ii < numBlockRows; ++ii)
+    {
+        const BlockRow& blockRow = mBlockRows[mNextBlockRow + ii];
+        CompressTiles::TileRow& tileRow = tileRows[ii];
+        tileRow.bandOffset = (blockRow.startRow - firstRow) * mNumBytesPerRow;
+        tileRow.numRows = blockRow.numRows;
+        tileRow.segmentRow = blockRow.segmentRow;
+        tileRow.firstTile = blockRow.firstTile;
+        tileRow.segmentDims = mSegmentDims[blockRow.segment];
+        tileRow.tileDims = mTileDims[blockRow.segment];
+        tileRow.numTiles = math::ceilingDivide(tileRow.segmentDims.row,
+                                               tileRow.tileDims.row) *
+                numBlocksPerRow;
+    }
+
+    std::vector<std::vector<sys::ubyte> > tiles(numBlockRows *
+                                                numBlocksPerRow);
+
+    mt::run1D(tiles.size(), mNumThreads,
+              CompressTiles(&mStaged[0],
+                            tileRows,
+                            mData->getNumCols(),
+                            mNumColsPerBlock,
+                            mData->getNumBytesPerPixel(),
+                            mCompressor,
+                            mSettings,
+                            tiles));
+
+    // Write each row of blocks out where its image data will sit in the
+    // final NITF
+    size_t numRowsCompressed = 0;
+    for (size_t ii = 0; ii < numBlockRows; ++ii)
+    {
+        BlockRow& blockRow = mBlockRows[mNextBlockRow + ii];
+        std::vector<size_t>& bytesPerBlock = mBytesPerBlock[blockRow.segment];
+
+        blockRow.offset = blockRow.placeholderOffset + mExtraBytesWritten;
+        seekForWrite(blockRow.offset);
+
+        nitf::Off endOffset = blockRow.offset;
+
+        for (size_t jj = 0; jj < numBlocksPerRow; ++jj)
+        {
+            std::vector<sys::ubyte>& tile = tiles[ii * numBlocksPerRow + jj];
+            mOutStream.write(reinterpret_cast<const sys::byte*>(&tile[0]),
+                             tile.size());
+            endOffset += tile.size();
+            bytesPerBlock.push_back(tile.size());
+            mExtraBytesWritten += tile.size() - 1;
+            std::vector<sys::ubyte>().swap(tile);
+        }
+
+        mNumBytesWritten = std::max(mNumBytesWritten, endOffset);
+        numRowsCompressed += blockRow.numRows;
+    }
+
+    mStaged.erase(mStaged.begin(),
+                  mStaged.begin() + numRowsCompressed * mNumBytesPerRow);
+    mNextBlockRow += numBlockRows;
+}
+
+void ParallelCompressedSIDDWriter::seekForWrite(nitf::Off offset)
+{
+    // Not every stream can seek past its end (io::ByteStream can't), so
+    // fill in the gap where the headers will go with zeros.  close()
+    // overwrites them.
+    if (offset > mNumBytesWritten)
+    {
+        mOutStream.seek(mStartOffset + mNumBytesWritten, io::Seekable::START);
+
+        const std::vector<sys::byte> zeros(
+                static_cast<size_t>(offset - mNumBytesWritten), 0);
+        mOutStream.write(&zeros[0], zeros.size());
+        mNumBytesWritten = offset;
+    }
+    else
+    {
+        mOutStream.seek(mStartOffset + offset, io::Seekable::START);
+    }
+}
+
+void ParallelCompressedSIDDWriter::close()
+{
+    if (mNextBlockRow != mBlockRows.size())
+    {
+        std::ostringstream ostr;
+        ostr << "Only " << mNextRow << " of " << mData->getNumRows()
+             << " rows have been added";
+        throw except::Exception(Ctxt(ostr.str()));
+    }
+
+    const std::auto_ptr<CompressedSIDDByteProvider> byteProvider =
+            makeByteProvider(mBytesPerBlock);
+
+    // The image data is already in place, so only write what surrounds it
+    nitf::Off fileOffset;
+    nitf::NITFBufferList buffers;
+    for (size_t ii = 0; ii < mBlockRows.size(); ++ii)
+    {
+        const BlockRow& blockRow = mBlockRows[ii];
+        byteProvider->getBytes(&IMAGE_DATA,
+                               blockRow.startRow,
+                               blockRow.numRows,
+                               fileOffset,
+                               buffers);
+
+        mOutStream.seek(mStartOffset + fileOffset, io::Seekable::START);
+        for (size_t jj = 0; jj < buffers.mBuffers.size(); ++jj)
+        {
+            const nitf::NITFBuffer& buffer = buffers.mBuffers[jj];
+            if (buffer.mData == &IMAGE_DATA)
+            {
+                if (mOutStream.tell() != mStartOffset + blockRow.offset)
+                {
+                    std::ostringstream ostr;
+                    ostr << "Image data for rows [" << blockRow.startRow
+                         << ", " << (blockRow.startRow + blockRow.numRows)
+                         << ") was written at offset " << blockRow.offset
+                         << " but belongs at offset "
+                         << (mOutStream.tell() - mStartOffset);
+                    throw except::Exception(Ctxt(ostr.str()));
+                }
+
+                mOutStream.seek(buffer.mNumBytes, io::Seekable::CURRENT);
+            }
+            else
+            {
+                mOutStream.write(static_cast<const sys::byte*>(buffer.mData),
+                                 buffer.mNumBytes);
+            }
+        }
+    }
+}
+}
+}
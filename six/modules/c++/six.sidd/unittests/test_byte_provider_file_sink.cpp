@@ -0,0 +1,243 @@
+/* =========================================================================
+ * This file is part of six.sidd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six.sidd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include <sys/OS.h>
+#include <io/FileInputStream.h>
+#include <mem/SharedPtr.h>
+#include <mt/ThreadGroup.h>
+#include <six/ByteProviderFileSink.h>
+#include <six/NITFWriteControl.h>
+#include <six/NITFHeaderCreator.h>
+#include <six/NITFImageInfo.h>
+#include <six/sidd/DerivedXMLControl.h>
+#include <six/sidd/SIDDByteProvider.h>
+#include <six/sidd/Utilities.h>
+#include "TestCase.h"
+
+namespace
+{
+// Small enough that the image is split into several segments
+const size_t MAX_PRODUCT_SIZE = 4000;
+
+/*
+ * Writes a multi-segment MONO16I SIDD with NITFWriteControl and then with a
+ * ByteProviderFileSink from multiple threads, and checks that the files are
+ * identical
+ */
+class TestHelper
+{
+public:
+    TestHelper(size_t numRowsPerBlock, size_t numColsPerBlock) :
+        mNumRowsPerBlock(numRowsPerBlock),
+        mNumColsPerBlock(numColsPerBlock),
+        mExpectedPathname("test_byte_provider_file_sink_expected.nitf"),
+        mActualPathname("test_byte_provider_file_sink_actual.nitf"),
+        mData(six::sidd::Utilities::createFakeDerivedData().release())
+    {
+        mXmlRegistry.addCreator(
+                six::DataType::DERIVED,
+                new six::XMLControlCreatorT<six::sidd::DerivedXMLControl>());
+
+        mData->setNumRows(123);
+        mData->setNumCols(57);
+        mData->setPixelType(six::PixelType::MONO16I);
+
+        mImage.resize(mData->getNumRows() * mData->getNumCols() *
+                      mData->getNumBytesPerPixel());
+        for (size_t ii = 0; ii < mImage.size(); ++ii)
+        {
+            mImage[ii] = static_cast<six::UByte>(ii * 7 + ii / 57);
+        }
+    }
+
+    ~TestHelper()
+    {
+        remove(mExpectedPathname);
+        remove(mActualPathname);
+    }
+
+    bool filesMatch()
+    {
+        writeExpected();
+        writeActual();
+        return read(mExpectedPathname) == read(mActualPathname);
+    }
+
+private:
+    void writeExpected()
+    {
+        mem::SharedPtr<six::Container> container(
+                new six::Container(six::DataType::DERIVED));
+        container->addData(mData->clone());
+
+        six::Options options;
+        options.setParameter(six::NITFHeaderCreator::OPT_MAX_PRODUCT_SIZE,
+                             str::toString(MAX_PRODUCT_SIZE));
+        if (mNumRowsPerBlock != 0)
+        {
+            options.setParameter(
+                    six::NITFHeaderCreator::OPT_NUM_ROWS_PER_BLOCK,
+                    str::toString(mNumRowsPerBlock));
+            options.setParameter(
+                    six::NITFHeaderCreator::OPT_NUM_COLS_PER_BLOCK,
+                    str::toString(mNumColsPerBlock));
+        }
+
+        six::NITFWriteControl writer(options, container, &mXmlRegistry);
+        six::BufferList buffers;
+        buffers.push_back(&mImage[0]);
+        writer.save(buffers, mExpectedPathname, std::vector<std::string>());
+    }
+
+    void writeActual()
+    {
+        const six::sidd::SIDDByteProvider byteProvider(
+                *mData, std::vector<std::string>(),
+                mNumRowsPerBlock, mNumColsPerBlock, MAX_PRODUCT_SIZE);
+        six::ByteProviderFileSink sink(byteProvider, *mData, mActualPathname);
+
+        // Bands of whole blocks that stop at each segment boundary, written
+        // in reverse order
+        const six::NITFImageInfo info(mData.get(), six::Constants::ILOC_MAX,
+                                      MAX_PRODUCT_SIZE, true,
+                                      mNumRowsPerBlock, mNumColsPerBlock);
+        const std::vector<six::NITFSegmentInfo> segments =
+                info.getImageSegments();
+        const size_t bandRows = (mNumRowsPerBlock == 0) ?
+                7 : mNumRowsPerBlock;
+        std::vector<std::pair<size_t, size_t> > bands;
+        for (size_t seg = 0; seg < segments.size(); ++seg)
+        {
+            const size_t endRow = segments[seg].endRow();
+            for (size_t startRow = segments[seg].firstRow;
+                 startRow < endRow;
+                 startRow += bandRows)
+            {
+                bands.push_back(std::make_pair(
+                        startRow, std::min(bandRows, endRow - startRow)));
+            }
+        }
+        std::reverse(bands.begin(), bands.end());
+
+        const size_t numThreads = 3;
+        mt::ThreadGroup threads;
+        for (size_t ii = 0; ii < numThreads; ++ii)
+        {
+            threads.createThread(new WriteRunnable(
+                    sink, mImage, *mData, bands, ii, numThreads));
+        }
+        threads.joinAll();
+
+        sink.close();
+    }
+
+    // Writes every 'numThreads'th band starting at 'threadNum'
+    class WriteRunnable : public sys::Runnable
+    {
+    public:
+        WriteRunnable(six::ByteProviderFileSink& sink,
+                      const std::vector<six::UByte>& image,
+                      const six::Data& data,
+                      const std::vector<std::pair<size_t, size_t> >& bands,
+                      size_t threadNum,
+                      size_t numThreads) :
+            mSink(sink),
+            mImage(image),
+            mNumBytesPerRow(data.getNumCols() * data.getNumBytesPerPixel()),
+            mBands(bands),
+            mThreadNum(threadNum),
+            mNumThreads(numThreads)
+        {
+        }
+
+        virtual void run()
+        {
+            for (size_t ii = mThreadNum; ii < mBands.size(); ii += mNumThreads)
+            {
+                mSink.write(&mImage[mBands[ii].first * mNumBytesPerRow],
+                            mBands[ii].first,
+                            mBands[ii].second);
+            }
+        }
+
+    private:
+        six::ByteProviderFileSink& mSink;
+        const std::vector<six::UByte>& mImage;
+        const size_t mNumBytesPerRow;
+        const std::vector<std::pair<size_t, size_t> >& mBands;
+        const size_t mThreadNum;
+        const size_t mNumThreads;
+    };
+
+    static std::vector<sys::byte> read(const std::string& pathname)
+    {
+        io::FileInputStream inStream(pathname);
+        std::vector<sys::byte> contents(
+                static_cast<size_t>(inStream.available()));
+        inStream.read(&contents[0], contents.size());
+        return contents;
+    }
+
+    static void remove(const std::string& pathname)
+    {
+        try
+        {
+            sys::OS().remove(pathname);
+        }
+        catch (...)
+        {
+        }
+    }
+
+private:
+    const size_t mNumRowsPerBlock;
+    const size_t mNumColsPerBlock;
+    const std::string mExpectedPathname;
+    const std::string mActualPathname;
+    six::XMLControlRegistry mXmlRegistry;
+    std::auto_ptr<six::sidd::DerivedData> mData;
+    std::vector<six::UByte> mImage;
+};
+
+TEST_CASE(testUnblocked)
+{
+    TestHelper helper(0, 0);
+    TEST_ASSERT_TRUE(helper.filesMatch());
+}
+
+TEST_CASE(testBlocked)
+{
+    // Blocks that don't evenly divide the segments, so there's padding
+    TestHelper helper(6, 16);
+    TEST_ASSERT_TRUE(helper.filesMatch());
+}
+}
+
+int main(int, char**)
+{
+    TEST_CHECK(testUnblocked);
+    TEST_CHECK(testBlocked);
+    return 0;
+}
@@ -0,0 +1,236 @@
+/* =========================================================================
+ * This file is part of six.sidd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six.sidd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <io/ByteStream.h>
+#include <nitf/IOStreamReader.hpp>
+#include <nitf/NITFException.hpp>
+#include <nitf/Reader.hpp>
+#include <six/sidd/J2KTileCompressor.h>
+#include <six/sidd/ParallelCompressedSIDDWriter.h>
+#include <six/sidd/Utilities.h>
+#include "TestCase.h"
+
+#include <j2k/Reader.h>
+
+namespace
+{
+// Frees the J2K reader and the last tile it read no matter how a test exits
+class J2KReader
+{
+public:
+    J2KReader(nitf::IOInterface& io) :
+        mReader(NULL),
+        mTile(NULL)
+    {
+        nrt_Error error;
+        mReader = j2k_Reader_openIO(io.getNative(), &error);
+        if (!mReader)
+        {
+            throw nitf::NITFException(&error);
+        }
+    }
+
+    ~J2KReader()
+    {
+        freeTile();
+        j2k_Reader_destruct(&mReader);
+    }
+
+    j2k_Container* getContainer()
+    {
+        nrt_Error error;
+        j2k_Container* const container =
+                j2k_Reader_getContainer(mReader, &error);
+        if (!container)
+        {
+            throw nitf::NITFException(&error);
+        }
+        return container;
+    }
+
+    //! Tile rows are as wide as a full tile, even along the right edge
+    const sys::ubyte* readTile(size_t tileRow, size_t tileCol)
+    {
+        freeTile();
+
+        nrt_Error error;
+        if (!j2k_Reader_readTile(mReader, static_cast<nrt_Uint32>(tileCol),
+                                 static_cast<nrt_Uint32>(tileRow), &mTile,
+                                 &error))
+        {
+            throw nitf::NITFException(&error);
+        }
+        return mTile;
+    }
+
+private:
+    void freeTile()
+    {
+        if (mTile)
+        {
+            J2K_FREE(mTile);
+            mTile = NULL;
+        }
+    }
+
+    j2k_Reader* mReader;
+    nrt_Uint8* mTile;
+};
+
+/*
+ * Writes a blocked SIDD through J2KTileCompressor, then decodes the image
+ * segment's codestream with NITRO's J2K reader and checks that it's one
+ * codestream tiled the same as the blocks and that every pixel survived.
+ */
+void testRoundTrip(const std::string& testName,
+                   six::PixelType pixelType,
+                   const six::sidd::J2KCompression& settings)
+{
+    const size_t numRows = 70;
+    const size_t numCols = 100;
+    const size_t numRowsPerBlock = 32;
+    const size_t numColsPerBlock = 40;
+
+    std::auto_ptr<six::sidd::DerivedData> data =
+            six::sidd::Utilities::createFakeDerivedData();
+    data->setNumRows(numRows);
+    data->setNumCols(numCols);
+    data->setPixelType(pixelType);
+    data->compression.reset(new six::sidd::Compression());
+    data->compression->original = settings;
+    const size_t numBytesPerPixel = data->getNumBytesPerPixel();
+
+    std::vector<sys::ubyte> image(numRows * numCols * numBytesPerPixel);
+    for (size_t ii = 0; ii < image.size(); ++ii)
+    {
+        image[ii] = static_cast<sys::ubyte>(ii * 7 + ii / numCols);
+    }
+
+    const six::sidd::J2KTileCompressor compressor;
+    io::ByteStream stream;
+    six::sidd::ParallelCompressedSIDDWriter writer(
+            *data,
+            std::vector<std::string>(),
+            compressor,
+            settings.layerInfo.empty(),
+            stream,
+            numRowsPerBlock,
+            numColsPerBlock,
+            3);
+    writer.addRows(&image[0], numRows);
+    writer.close();
+
+    stream.seek(0, io::Seekable::START);
+    nitf::IOStreamReader io(stream);
+    nitf::Reader reader;
+    nitf::Record record = reader.readIO(io);
+    nitf::ImageSegment segment = record.getImages()[0];
+    TEST_ASSERT_EQ(segment.getSubheader().getImageCompression().toString(),
+                   "C8");
+
+    io.seek(static_cast<nitf::Off>(segment.getImageOffset()), NITF_SEEK_SET);
+    J2KReader j2kReader(io);
+
+    nrt_Error error;
+    j2k_Container* const container = j2kReader.getContainer();
+    TEST_ASSERT_EQ(j2k_Container_getWidth(container, &error), numCols);
+    TEST_ASSERT_EQ(j2k_Container_getHeight(container, &error), numRows);
+    TEST_ASSERT_EQ(j2k_Container_getTileWidth(container, &error),
+                   numColsPerBlock);
+    TEST_ASSERT_EQ(j2k_Container_getTileHeight(container, &error),
+                   numRowsPerBlock);
+    TEST_ASSERT_EQ(j2k_Container_getTilesX(container, &error), 3);
+    TEST_ASSERT_EQ(j2k_Container_getTilesY(container, &error), 3);
+
+    for (size_t tileRow = 0; tileRow < 3; ++tileRow)
+    {
+        for (size_t tileCol = 0; tileCol < 3; ++tileCol)
+        {
+            const sys::ubyte* const tile =
+                    j2kReader.readTile(tileRow, tileCol);
+
+            const size_t startRow = tileRow * numRowsPerBlock;
+            const size_t startCol = tileCol * numColsPerBlock;
+            const size_t tileNumRows =
+                    std::min(numRowsPerBlock, numRows - startRow);
+            const size_t tileNumCols =
+                    std::min(numColsPerBlock, numCols - startCol);
+            for (size_t row = 0; row < tileNumRows; ++row)
+            {
+                const sys::ubyte* const expected =
+                        &image[((startRow + row) * numCols + startCol) *
+                               numBytesPerPixel];
+                const sys::ubyte* const actual =
+                        tile + row * numColsPerBlock * numBytesPerPixel;
+                TEST_ASSERT_EQ(::memcmp(actual, expected,
+                                        tileNumCols * numBytesPerPixel), 0);
+            }
+        }
+    }
+}
+
+TEST_CASE(testMono8)
+{
+    testRoundTrip(testName, six::PixelType::MONO8I,
+                  six::sidd::J2KCompression());
+}
+
+TEST_CASE(testMono16WithLayers)
+{
+    // The last layer is untruncated, so this is still lossless
+    six::sidd::J2KCompression settings;
+    settings.numWaveletLevels = 2;
+    settings.layerInfo.resize(2);
+    settings.layerInfo[0].bitRate = 2;
+    settings.layerInfo[1].bitRate = 16;
+    testRoundTrip(testName, six::PixelType::MONO16I, settings);
+}
+
+TEST_CASE(testDecreasingBitRates)
+{
+    six::sidd::J2KCompression settings;
+    settings.layerInfo.resize(2);
+    settings.layerInfo[0].bitRate = 4;
+    settings.layerInfo[1].bitRate = 2;
+
+    const sys::ubyte pixels[4] = {0};
+    std::vector<sys::ubyte> compressed;
+    const types::RowCol<size_t> dims(2, 2);
+    TEST_EXCEPTION(six::sidd::J2KTileCompressor().compress(
+            pixels, types::RowCol<size_t>(0, 0), dims, dims, 1, settings,
+            compressed));
+}
+}
+
+int main(int, char**)
+{
+    TEST_CHECK(testMono8);
+    TEST_CHECK(testMono16WithLayers);
+    TEST_CHECK(testDecreasingBitRates);
+    return 0;
+}
@@ -0,0 +1,147 @@
+/* =========================================================================
+ * This file is part of six.sidd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six.sidd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <vector>
+
+#include <io/TempFile.h>
+#include <logging/NullLogger.h>
+#include <mem/SharedPtr.h>
+#include <six/NITFMetadataReader.h>
+#include <six/NITFReadControl.h>
+#include <six/NITFWriteControl.h>
+#include <six/XMLControlFactory.h>
+#include <six/sidd/DerivedXMLControl.h>
+#include <six/sidd/Utilities.h>
+#include "TestCase.h"
+
+namespace
+{
+/*
+ * Writes out a SIDD with two products and reads it back with
+ * NITFReadControl
+ */
+struct TestHelper
+{
+    TestHelper()
+    {
+        mXmlRegistry.addCreator(
+                six::DataType::DERIVED,
+                new six::XMLControlCreatorT<six::sidd::DerivedXMLControl>());
+
+        mem::SharedPtr<six::Container> container(
+                new six::Container(six::DataType::DERIVED));
+        std::vector<std::vector<six::UByte> > images;
+        for (size_t ii = 0; ii < 2; ++ii)
+        {
+            std::auto_ptr<six::sidd::DerivedData> data =
+                    six::sidd::Utilities::createFakeDerivedData();
+            data->setNumRows(10 + ii);
+            data->setNumCols(20 + ii);
+            data->setPixelType(six::PixelType::MONO8I);
+            images.push_back(std::vector<six::UByte>(
+                    data->getNumRows() * data->getNumCols()));
+            container->addData(std::auto_ptr<six::Data>(data));
+        }
+
+        six::NITFWriteControl writer(six::Options(), container,
+                                     &mXmlRegistry);
+        six::BufferList buffers;
+        for (size_t ii = 0; ii < images.size(); ++ii)
+        {
+            buffers.push_back(&images[ii][0]);
+        }
+        writer.save(buffers, mTempFile.pathname(),
+                    std::vector<std::string>());
+
+        mReadControl.setXMLControlRegistry(&mXmlRegistry);
+        mReadControl.load(mTempFile.pathname());
+    }
+
+    io::TempFile mTempFile;
+    six::XMLControlRegistry mXmlRegistry;
+    six::NITFReadControl mReadControl;
+};
+
+TEST_CASE(testMatchesReadControl)
+{
+    TestHelper helper;
+    const six::NITFMetadataReader reader(helper.mTempFile.pathname());
+
+    TEST_ASSERT_EQ(reader.getDataType(), six::DataType::DERIVED);
+    TEST_ASSERT_EQ(reader.getNumXML(), static_cast<size_t>(2));
+
+    logging::NullLogger log;
+    mem::SharedPtr<const six::Container> container =
+            helper.mReadControl.getContainer();
+    for (size_t ii = 0; ii < reader.getNumXML(); ++ii)
+    {
+        TEST_ASSERT_EQ(reader.getDataType(ii), six::DataType::DERIVED);
+
+        const std::auto_ptr<six::Data> data = reader.getData(
+                ii, helper.mXmlRegistry, std::vector<std::string>(), log);
+
+        // NITFReadControl also picks up classification options from the
+        // NITF subheaders, so only compare what's in the XML
+        TEST_ASSERT_EQ(six::toXMLString(data.get(), &helper.mXmlRegistry),
+                       six::toXMLString(container->getData(ii),
+                                        &helper.mXmlRegistry));
+    }
+
+    TEST_EXCEPTION(reader.getXML(2));
+}
+
+TEST_CASE(testSelectedElements)
+{
+    TestHelper helper;
+    const six::NITFMetadataReader reader(helper.mTempFile.pathname());
+
+    std::vector<std::string> elementNames;
+    elementNames.push_back("ProductCreation");
+    elementNames.push_back("Measurement");
+    const std::auto_ptr<xml::lite::Document> doc(
+            reader.getXMLDocument(1, elementNames));
+
+    const xml::lite::Element* const root = doc->getRootElement();
+    TEST_ASSERT_EQ(root->getLocalName(), "SIDD");
+    TEST_ASSERT_EQ(root->getChildren().size(), static_cast<size_t>(2));
+    TEST_ASSERT_EQ(root->getChildren()[0]->getLocalName(),
+                   "ProductCreation");
+    TEST_ASSERT_EQ(root->getChildren()[1]->getLocalName(), "Measurement");
+
+    // The kept elements are complete
+    const std::auto_ptr<xml::lite::Document> fullDoc(
+            reader.getXMLDocument(1));
+    std::vector<xml::lite::Element*> fullMeasurement;
+    fullDoc->getRootElement()->getElementsByTagName("Measurement",
+                                                     fullMeasurement);
+    TEST_ASSERT_EQ(fullMeasurement.size(), static_cast<size_t>(1));
+    TEST_ASSERT_EQ(root->getChildren()[1]->getChildren().size(),
+                   fullMeasurement[0]->getChildren().size());
+}
+}
+
+int main(int, char**)
+{
+    TEST_CHECK(testMatchesReadControl);
+    TEST_CHECK(testSelectedElements);
+    return 0;
+}
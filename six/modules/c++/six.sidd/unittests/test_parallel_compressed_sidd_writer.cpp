@@ -0,0 +1,444 @@
+/* =========================================================================
+ * This file is part of six.sidd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six.sidd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+
+#include <io/ByteStream.h>
+#include <six/sidd/CompressedSIDDByteProvider.h>
+#include <six/sidd/ParallelCompressedSIDDWriter.h>
+#include <six/sidd/Utilities.h>
+#include "TestCase.h"
+
+namespace
+{
+void append16(size_t value, std::vector<sys::ubyte>& bytes)
+{
+    bytes.push_back(static_cast<sys::ubyte>(value >> 8));
+    bytes.push_back(static_cast<sys::ubyte>(value));
+}
+
+void append32(size_t value, std::vector<sys::ubyte>& bytes)
+{
+    append16(value >> 16, bytes);
+    append16(value & 0xFFFF, bytes);
+}
+
+// SOC and a single component SIZ marker segment
+void appendMainHeader(const types::RowCol<size_t>& offset,
+                      const types::RowCol<size_t>& end,
+                      const types::RowCol<size_t>& tileDims,
+                      std::vector<sys::ubyte>& bytes)
+{
+    append16(0xFF4F, bytes);
+    append16(0xFF51, bytes);
+    append16(41, bytes);
+    append16(0, bytes);
+    append32(end.col, bytes);
+    append32(end.row, bytes);
+    append32(offset.col, bytes);
+    append32(offset.row, bytes);
+    append32(tileDims.col, bytes);
+    append32(tileDims.row, bytes);
+    append32(offset.col, bytes);
+    append32(offset.row, bytes);
+    append16(1, bytes);
+    bytes.push_back(7);
+    bytes.push_back(1);
+    bytes.push_back(1);
+}
+
+// SOT, SOD and the tile data
+void appendTilePart(size_t tileIndex,
+                    const std::vector<sys::ubyte>& data,
+                    std::vector<sys::ubyte>& bytes)
+{
+    append16(0xFF90, bytes);
+    append16(10, bytes);
+    append16(tileIndex, bytes);
+    append32(14 + data.size(), bytes);
+    bytes.push_back(0);
+    bytes.push_back(1);
+    append16(0xFF93, bytes);
+    bytes.insert(bytes.end(), data.begin(), data.end());
+}
+
+const size_t MAIN_HEADER_SIZE = 45;
+const size_t TILE_PART_HEADER_SIZE = 14;
+const size_t EOC_SIZE = 2;
+
+std::vector<sys::ubyte> subsample(const sys::ubyte* pixels, size_t numBytes)
+{
+    std::vector<sys::ubyte> data;
+    for (size_t ii = 0; ii < numBytes; ii += 4)
+    {
+        data.push_back(pixels[ii]);
+    }
+    return data;
+}
+
+/*
+ * Stand-in for a J2K encoder.  Wraps every fourth pixel in just enough of a
+ * single tile codestream for the writer to splice, which is enough to tell
+ * the tiles apart and verify that each saw the right pixels.
+ */
+class SubsampleCompressor : public six::sidd::TileCompressor
+{
+public:
+    virtual void compress(const sys::ubyte* pixels,
+                          const types::RowCol<size_t>& offset,
+                          const types::RowCol<size_t>& dims,
+                          const types::RowCol<size_t>& tileDims,
+                          size_t numBytesPerPixel,
+                          const six::sidd::J2KCompression& ,
+                          std::vector<sys::ubyte>& compressed) const
+    {
+        compressed.clear();
+        appendMainHeader(offset, offset + dims, tileDims, compressed);
+        appendTilePart(0,
+                       subsample(pixels, dims.area() * numBytesPerPixel),
+                       compressed);
+        append16(0xFFD9, compressed);
+    }
+};
+
+// Sizes the tile grid to each tile rather than the block size
+class UntiledCompressor : public SubsampleCompressor
+{
+public:
+    virtual void compress(const sys::ubyte* pixels,
+                          const types::RowCol<size_t>& offset,
+                          const types::RowCol<size_t>& dims,
+                          const types::RowCol<size_t>& ,
+                          size_t numBytesPerPixel,
+                          const six::sidd::J2KCompression& settings,
+                          std::vector<sys::ubyte>& compressed) const
+    {
+        SubsampleCompressor::compress(pixels, offset, dims, dims,
+                                      numBytesPerPixel, settings, compressed);
+    }
+};
+
+std::auto_ptr<six::sidd::DerivedData> createData(size_t numRows,
+                                                 size_t numCols)
+{
+    std::auto_ptr<six::sidd::DerivedData> data =
+            six::sidd::Utilities::createFakeDerivedData();
+    data->setNumRows(numRows);
+    data->setNumCols(numCols);
+    data->setPixelType(six::PixelType::MONO8I);
+    return data;
+}
+
+std::vector<sys::ubyte> createImage(size_t numRows, size_t numCols)
+{
+    std::vector<sys::ubyte> image(numRows * numCols);
+    for (size_t ii = 0; ii < image.size(); ++ii)
+    {
+        image[ii] = static_cast<sys::ubyte>(ii * 7 + ii / numCols);
+    }
+    return image;
+}
+
+// Builds an image segment's codestream serially, in file order
+std::vector<sys::ubyte> expectedPayload(const std::vector<sys::ubyte>& image,
+                                        size_t numCols,
+                                        size_t startRow,
+                                        size_t endRow,
+                                        size_t numRowsPerBlock,
+                                        size_t numColsPerBlock)
+{
+    std::vector<sys::ubyte> payload;
+    appendMainHeader(types::RowCol<size_t>(0, 0),
+                     types::RowCol<size_t>(endRow - startRow, numCols),
+                     types::RowCol<size_t>(numRowsPerBlock, numColsPerBlock),
+                     payload);
+
+    size_t tileIndex = 0;
+    for (size_t row = startRow; row < endRow; row += numRowsPerBlock)
+    {
+        for (size_t col = 0; col < numCols; col += numColsPerBlock)
+        {
+            const types::RowCol<size_t> dims(
+                    std::min(numRowsPerBlock, endRow - row),
+                    std::min(numColsPerBlock, numCols - col));
+            std::vector<sys::ubyte> tile;
+            for (size_t ii = 0; ii < dims.row; ++ii)
+            {
+                const sys::ubyte* const input =
+                        &image[(row + ii) * numCols + col];
+                tile.insert(tile.end(), input, input + dims.col);
+            }
+
+            appendTilePart(tileIndex++, subsample(&tile[0], tile.size()),
+                           payload);
+        }
+    }
+
+    append16(0xFFD9, payload);
+    return payload;
+}
+
+bool contains(io::ByteStream& stream, const std::vector<sys::ubyte>& payload)
+{
+    const sys::ubyte* const begin = stream.get();
+    const sys::ubyte* const end = begin + stream.getSize();
+    return std::search(begin, end, payload.begin(), payload.end()) != end;
+}
+
+// Lays out the whole SIDD in one shot from the already compressed payload
+bool matchesByteProvider(io::ByteStream& stream,
+                         const six::sidd::DerivedData& data,
+                         const std::vector<std::vector<size_t> >& bytesPerBlock,
+                         const std::vector<sys::ubyte>& payload,
+                         bool isNumericallyLossless,
+                         size_t numRowsPerBlock,
+                         size_t numColsPerBlock,
+                         size_t maxProductSize)
+{
+    const six::sidd::CompressedSIDDByteProvider byteProvider(
+            data, std::vector<std::string>(), bytesPerBlock,
+            isNumericallyLossless, numRowsPerBlock, numColsPerBlock,
+            maxProductSize);
+
+    nitf::Off fileOffset;
+    nitf::NITFBufferList buffers;
+    byteProvider.getBytes(&payload[0], 0, data.getNumRows(), fileOffset,
+                          buffers);
+
+    std::vector<sys::ubyte> expected;
+    for (size_t ii = 0; ii < buffers.mBuffers.size(); ++ii)
+    {
+        const sys::ubyte* const buffer =
+                static_cast<const sys::ubyte*>(buffers.mBuffers[ii].mData);
+        expected.insert(expected.end(), buffer,
+                        buffer + buffers.mBuffers[ii].mNumBytes);
+    }
+
+    return fileOffset == 0 &&
+            stream.getSize() == static_cast<sys::Off_T>(expected.size()) &&
+            std::equal(expected.begin(), expected.end(), stream.get());
+}
+
+TEST_CASE(testBlockedImage)
+{
+    const size_t numRows = 50;
+    const size_t numCols = 30;
+    const size_t numRowsPerBlock = 16;
+    const size_t numColsPerBlock = 12;
+    const std::vector<sys::ubyte> image = createImage(numRows, numCols);
+    const std::auto_ptr<six::sidd::DerivedData> data =
+            createData(numRows, numCols);
+
+    const SubsampleCompressor compressor;
+    io::ByteStream stream;
+    six::sidd::ParallelCompressedSIDDWriter writer(
+            *data,
+            std::vector<std::string>(),
+            compressor,
+            false,
+            stream,
+            numRowsPerBlock,
+            numColsPerBlock,
+            3);
+
+    // Bands that don't line up with the blocks
+    writer.addRows(&image[0], 7);
+    TEST_ASSERT_EQ(writer.getBytesPerBlock().size(), 1);
+    TEST_ASSERT_TRUE(writer.getBytesPerBlock()[0].empty());
+    TEST_ASSERT_EQ(stream.getSize(), 0);
+
+    // The first two rows of blocks are written out as soon as they're done
+    writer.addRows(&image[7 * numCols], 30);
+    TEST_ASSERT_EQ(writer.getBytesPerBlock()[0].size(), 6);
+
+    const std::vector<sys::ubyte> payload =
+            expectedPayload(image, numCols, 0, numRows, numRowsPerBlock,
+                            numColsPerBlock);
+    size_t numBytesWritten = 0;
+    for (size_t ii = 0; ii < 6; ++ii)
+    {
+        numBytesWritten += writer.getBytesPerBlock()[0][ii];
+    }
+    TEST_ASSERT_TRUE(contains(stream, std::vector<sys::ubyte>(
+            payload.begin(), payload.begin() + numBytesWritten)));
+
+    writer.addRows(&image[37 * numCols], numRows - 37);
+    TEST_ASSERT_EQ(writer.getNumRowsAdded(), numRows);
+
+    // 4 rows of 3 blocks.  The bottom and right edge tiles aren't padded.
+    // The first block also holds the main header and the last one EOC.
+    const std::vector<size_t>& bytesPerBlock = writer.getBytesPerBlock()[0];
+    TEST_ASSERT_EQ(bytesPerBlock.size(), 12);
+    TEST_ASSERT_EQ(bytesPerBlock[0],
+                   MAIN_HEADER_SIZE + TILE_PART_HEADER_SIZE + 16 * 12 / 4);
+    TEST_ASSERT_EQ(bytesPerBlock[2], TILE_PART_HEADER_SIZE + 16 * 6 / 4);
+    TEST_ASSERT_EQ(bytesPerBlock[9], TILE_PART_HEADER_SIZE + 2 * 12 / 4);
+    TEST_ASSERT_EQ(bytesPerBlock[11],
+                   TILE_PART_HEADER_SIZE + 2 * 6 / 4 + EOC_SIZE);
+
+    writer.close();
+    TEST_ASSERT_EQ(stream.tell(), stream.getSize());
+    TEST_ASSERT_TRUE(matchesByteProvider(
+            stream, *data, writer.getBytesPerBlock(), payload,
+            false, numRowsPerBlock, numColsPerBlock, 0));
+}
+
+TEST_CASE(testUnblockedImage)
+{
+    const size_t numRows = 20;
+    const size_t numCols = 40;
+    const std::vector<sys::ubyte> image = createImage(numRows, numCols);
+    const std::auto_ptr<six::sidd::DerivedData> data =
+            createData(numRows, numCols);
+
+    const SubsampleCompressor compressor;
+    io::ByteStream stream;
+    six::sidd::ParallelCompressedSIDDWriter writer(
+            *data,
+            std::vector<std::string>(),
+            compressor,
+            true,
+            stream);
+
+    writer.addRows(&image[0], numRows);
+
+    TEST_ASSERT_EQ(writer.getBytesPerBlock().size(), 1);
+    TEST_ASSERT_EQ(writer.getBytesPerBlock()[0].size(), 1);
+
+    writer.close();
+    TEST_ASSERT_TRUE(matchesByteProvider(
+            stream, *data, writer.getBytesPerBlock(),
+            expectedPayload(image, numCols, 0, numRows, numRows, numCols),
+            true, 0, 0, 0));
+}
+
+TEST_CASE(testMultipleSegments)
+{
+    const size_t numRows = 50;
+    const size_t numCols = 32;
+    const size_t maxProductSize = 20 * numCols;
+    const std::vector<sys::ubyte> image = createImage(numRows, numCols);
+    const std::auto_ptr<six::sidd::DerivedData> data =
+            createData(numRows, numCols);
+
+    const SubsampleCompressor compressor;
+    io::ByteStream stream;
+    six::sidd::ParallelCompressedSIDDWriter writer(
+            *data,
+            std::vector<std::string>(),
+            compressor,
+            false,
+            stream,
+            0,
+            0,
+            2,
+            maxProductSize);
+
+    for (size_t row = 0; row < numRows; row += 10)
+    {
+        writer.addRows(&image[row * numCols], 10);
+    }
+
+    // Each segment is a single block holding a whole codestream, and each
+    // of its rows compresses to numCols / 4 bytes
+    const std::vector<std::vector<size_t> >& bytesPerBlock =
+            writer.getBytesPerBlock();
+    TEST_ASSERT_GREATER(bytesPerBlock.size(), 1);
+
+    std::vector<sys::ubyte> payload;
+    size_t startRow = 0;
+    for (size_t seg = 0; seg < bytesPerBlock.size(); ++seg)
+    {
+        TEST_ASSERT_EQ(bytesPerBlock[seg].size(), 1);
+
+        const size_t endRow = startRow +
+                (bytesPerBlock[seg][0] - MAIN_HEADER_SIZE -
+                 TILE_PART_HEADER_SIZE - EOC_SIZE) / (numCols / 4);
+        const std::vector<sys::ubyte> segmentPayload =
+                expectedPayload(image, numCols, startRow, endRow,
+                                endRow - startRow, numCols);
+        payload.insert(payload.end(), segmentPayload.begin(),
+                       segmentPayload.end());
+        startRow = endRow;
+    }
+    TEST_ASSERT_EQ(startRow, numRows);
+
+    writer.close();
+    TEST_ASSERT_TRUE(matchesByteProvider(stream, *data, bytesPerBlock,
+                                         payload, false, 0, 0,
+                                         maxProductSize));
+}
+
+TEST_CASE(testUntiledCodestream)
+{
+    const size_t numRows = 20;
+    const size_t numCols = 30;
+    const std::vector<sys::ubyte> image = createImage(numRows, numCols);
+
+    // The right edge tiles are narrower than the blocks
+    const UntiledCompressor compressor;
+    io::ByteStream stream;
+    six::sidd::ParallelCompressedSIDDWriter writer(
+            *createData(numRows, numCols),
+            std::vector<std::string>(),
+            compressor,
+            false,
+            stream,
+            8,
+            16);
+
+    TEST_EXCEPTION(writer.addRows(&image[0], numRows));
+}
+
+TEST_CASE(testIncompleteImage)
+{
+    const size_t numRows = 20;
+    const size_t numCols = 40;
+    const std::vector<sys::ubyte> image = createImage(numRows, numCols);
+
+    const SubsampleCompressor compressor;
+    io::ByteStream stream;
+    six::sidd::ParallelCompressedSIDDWriter writer(
+            *createData(numRows, numCols),
+            std::vector<std::string>(),
+            compressor,
+            false,
+            stream,
+            8,
+            8);
+
+    writer.addRows(&image[0], numRows - 1);
+
+    TEST_EXCEPTION(writer.close());
+    TEST_EXCEPTION(writer.addRows(&image[0], 2));
+}
+}
+
+int main(int, char**)
+{
+    TEST_CHECK(testBlockedImage);
+    TEST_CHECK(testUnblockedImage);
+    TEST_CHECK(testMultipleSegments);
+    TEST_CHECK(testUntiledCodestream);
+    TEST_CHECK(testIncompleteImage);
+    return 0;
+}
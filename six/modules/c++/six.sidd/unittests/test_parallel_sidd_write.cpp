@@ -0,0 +1,174 @@
+/* =========================================================================
+ * This file is part of six.sidd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six.sidd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <vector>
+
+#include <sys/OS.h>
+#include <io/FileInputStream.h>
+#include <mem/SharedPtr.h>
+#include <six/NITFWriteControl.h>
+#include <six/NITFHeaderCreator.h>
+#include <six/sidd/DerivedXMLControl.h>
+#include <six/sidd/Utilities.h>
+#include "TestCase.h"
+
+namespace
+{
+/*
+ * Writes a multi-product, multi-segment SIDD with a MONO8I and a MONO16I
+ * product, serially and then with multiple threads, and checks that the
+ * files are identical
+ */
+class TestHelper
+{
+public:
+    TestHelper(size_t numRowsPerBlock, size_t numColsPerBlock) :
+        mNumRowsPerBlock(numRowsPerBlock),
+        mNumColsPerBlock(numColsPerBlock),
+        mSerialPathname("test_parallel_sidd_write_serial.nitf"),
+        mParallelPathname("test_parallel_sidd_write_parallel.nitf")
+    {
+        mXmlRegistry.addCreator(
+                six::DataType::DERIVED,
+                new six::XMLControlCreatorT<six::sidd::DerivedXMLControl>());
+
+        addImage(123, 57, six::PixelType::MONO8I);
+        addImage(71, 40, six::PixelType::MONO16I);
+    }
+
+    ~TestHelper()
+    {
+        remove(mSerialPathname);
+        remove(mParallelPathname);
+    }
+
+    bool filesMatch()
+    {
+        write(1, mSerialPathname);
+        write(3, mParallelPathname);
+        return read(mSerialPathname) == read(mParallelPathname);
+    }
+
+private:
+    void addImage(size_t numRows, size_t numCols, six::PixelType pixelType)
+    {
+        std::auto_ptr<six::sidd::DerivedData> data =
+                six::sidd::Utilities::createFakeDerivedData();
+        data->setNumRows(numRows);
+        data->setNumCols(numCols);
+        data->setPixelType(pixelType);
+
+        mImages.push_back(std::vector<six::UByte>(
+                numRows * numCols * data->getNumBytesPerPixel()));
+        std::vector<six::UByte>& image = mImages.back();
+        for (size_t ii = 0; ii < image.size(); ++ii)
+        {
+            image[ii] = static_cast<six::UByte>(ii * 7 + ii / numCols);
+        }
+
+        mData.push_back(mem::SharedPtr<six::Data>(data.release()));
+    }
+
+    void write(size_t numThreads, const std::string& pathname)
+    {
+        mem::SharedPtr<six::Container> container(
+                new six::Container(six::DataType::DERIVED));
+        for (size_t ii = 0; ii < mData.size(); ++ii)
+        {
+            container->addData(mData[ii]->clone());
+        }
+
+        // Small segments so each product is split up
+        six::Options options;
+        options.setParameter(six::NITFHeaderCreator::OPT_MAX_PRODUCT_SIZE,
+                             str::toString(2000));
+        options.setParameter(six::WriteControl::OPT_NUM_THREADS,
+                             str::toString(numThreads));
+        if (mNumRowsPerBlock != 0)
+        {
+            options.setParameter(
+                    six::NITFHeaderCreator::OPT_NUM_ROWS_PER_BLOCK,
+                    str::toString(mNumRowsPerBlock));
+            options.setParameter(
+                    six::NITFHeaderCreator::OPT_NUM_COLS_PER_BLOCK,
+                    str::toString(mNumColsPerBlock));
+        }
+
+        six::NITFWriteControl writer(options, container, &mXmlRegistry);
+        six::BufferList buffers;
+        for (size_t ii = 0; ii < mImages.size(); ++ii)
+        {
+            buffers.push_back(&mImages[ii][0]);
+        }
+        writer.save(buffers, pathname, std::vector<std::string>());
+    }
+
+    static std::vector<sys::byte> read(const std::string& pathname)
+    {
+        io::FileInputStream inStream(pathname);
+        std::vector<sys::byte> contents(
+                static_cast<size_t>(inStream.available()));
+        inStream.read(&contents[0], contents.size());
+        return contents;
+    }
+
+    static void remove(const std::string& pathname)
+    {
+        try
+        {
+            sys::OS().remove(pathname);
+        }
+        catch (...)
+        {
+        }
+    }
+
+private:
+    const size_t mNumRowsPerBlock;
+    const size_t mNumColsPerBlock;
+    const std::string mSerialPathname;
+    const std::string mParallelPathname;
+    six::XMLControlRegistry mXmlRegistry;
+    std::vector<mem::SharedPtr<six::Data> > mData;
+    std::vector<std::vector<six::UByte> > mImages;
+};
+
+TEST_CASE(testUnblocked)
+{
+    TestHelper helper(0, 0);
+    TEST_ASSERT_TRUE(helper.filesMatch());
+}
+
+TEST_CASE(testBlocked)
+{
+    // Blocks that don't evenly divide the segments, so there's padding
+    TestHelper helper(6, 16);
+    TEST_ASSERT_TRUE(helper.filesMatch());
+}
+}
+
+int main(int, char**)
+{
+    TEST_CHECK(testUnblocked);
+    TEST_CHECK(testBlocked);
+    return 0;
+}
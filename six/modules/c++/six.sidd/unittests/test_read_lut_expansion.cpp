@@ -0,0 +1,188 @@
+/* =========================================================================
+ * This file is part of six.sidd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six.sidd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+
+#include <string.h>
+
+#include <vector>
+
+#include <sys/OS.h>
+#include <mem/ScopedArray.h>
+#include <mem/SharedPtr.h>
+#include <six/NITFReadControl.h>
+#include <six/NITFWriteControl.h>
+#include <six/sidd/DerivedXMLControl.h>
+#include <six/sidd/Utilities.h>
+#include "TestCase.h"
+
+namespace
+{
+/*
+ * Writes a LUT-indexed SIDD whose display LUT is carried in the
+ * RemapInformation, then reads it back through interleavedThroughLUT() and
+ * checks every pixel against the LUT entry its index selects.
+ */
+class TestHelper
+{
+public:
+    TestHelper(six::PixelType pixelType) :
+        mPathname("test_read_lut_expansion.nitf"),
+        mNumRows(29),
+        mNumCols(17),
+        mNumEntries(7),
+        mElementSize(pixelType == six::PixelType::RGB8LU ?
+                3 : sizeof(sys::Uint16_T)),
+        mLUT(mNumEntries, mElementSize)
+    {
+        mXmlRegistry.addCreator(
+                six::DataType::DERIVED,
+                new six::XMLControlCreatorT<six::sidd::DerivedXMLControl>());
+
+        // Make every byte of every entry distinct so a misplaced byte shows
+        for (size_t ii = 0; ii < mNumEntries; ++ii)
+        {
+            for (size_t jj = 0; jj < mElementSize; ++jj)
+            {
+                mLUT[ii][jj] =
+                        static_cast<unsigned char>(0x10 * (ii + 1) + jj);
+            }
+        }
+
+        mIndices.resize(mNumRows * mNumCols);
+        for (size_t ii = 0; ii < mIndices.size(); ++ii)
+        {
+            mIndices[ii] =
+                    static_cast<six::UByte>((ii + ii / mNumCols) % mNumEntries);
+        }
+
+        write(pixelType);
+    }
+
+    ~TestHelper()
+    {
+        try
+        {
+            sys::OS().remove(mPathname);
+        }
+        catch (...)
+        {
+        }
+    }
+
+    const unsigned char* expectedPixel(size_t pixel) const
+    {
+        return mLUT[mIndices[pixel]];
+    }
+
+    const std::string mPathname;
+    const size_t mNumRows;
+    const size_t mNumCols;
+    const size_t mNumEntries;
+    const size_t mElementSize;
+    six::XMLControlRegistry mXmlRegistry;
+
+private:
+    void write(six::PixelType pixelType)
+    {
+        std::auto_ptr<six::sidd::DerivedData> data =
+                six::sidd::Utilities::createFakeDerivedData();
+        data->setNumRows(mNumRows);
+        data->setNumCols(mNumCols);
+        data->setPixelType(pixelType);
+        if (pixelType == six::PixelType::RGB8LU)
+        {
+            data->display->remapInformation.reset(
+                    new six::sidd::ColorDisplayRemap(mLUT.clone()));
+        }
+        else
+        {
+            data->display->remapInformation.reset(
+                    new six::sidd::MonochromeDisplayRemap("Test",
+                                                          mLUT.clone()));
+        }
+
+        mem::SharedPtr<six::Container> container(
+                new six::Container(six::DataType::DERIVED));
+        container->addData(std::auto_ptr<six::Data>(data.release()));
+
+        six::BufferList buffers;
+        buffers.push_back(&mIndices[0]);
+
+        six::NITFWriteControl writer(six::Options(), container,
+                                     &mXmlRegistry);
+        writer.save(buffers, mPathname, std::vector<std::string>());
+    }
+
+    six::LUT mLUT;
+    std::vector<six::UByte> mIndices;
+};
+
+void testExpansion(const std::string& testName, six::PixelType pixelType)
+{
+    TestHelper helper(pixelType);
+
+    six::NITFReadControl reader;
+    reader.setXMLControlRegistry(&helper.mXmlRegistry);
+    reader.load(helper.mPathname);
+
+    for (size_t numThreads = 1; numThreads <= 4; numThreads += 3)
+    {
+        six::Region region;
+        const mem::ScopedArray<six::UByte> pixels(
+                reader.interleavedThroughLUT(region, 0, numThreads));
+        TEST_ASSERT_EQ(static_cast<size_t>(region.getNumRows()),
+                       helper.mNumRows);
+        TEST_ASSERT_EQ(static_cast<size_t>(region.getNumCols()),
+                       helper.mNumCols);
+
+        for (size_t ii = 0; ii < helper.mNumRows * helper.mNumCols; ++ii)
+        {
+            const unsigned char* const expected = helper.expectedPixel(ii);
+            for (size_t jj = 0; jj < helper.mElementSize; ++jj)
+            {
+                TEST_ASSERT_EQ(
+                        static_cast<size_t>(
+                                pixels[ii * helper.mElementSize + jj]),
+                        static_cast<size_t>(expected[jj]));
+            }
+        }
+    }
+}
+
+TEST_CASE(testRGB8LU)
+{
+    testExpansion(testName, six::PixelType::RGB8LU);
+}
+
+TEST_CASE(testMONO8LU)
+{
+    testExpansion(testName, six::PixelType::MONO8LU);
+}
+}
+
+int main(int, char**)
+{
+    TEST_CHECK(testRGB8LU);
+    TEST_CHECK(testMONO8LU);
+    return 0;
+}
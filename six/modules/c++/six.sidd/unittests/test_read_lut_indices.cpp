@@ -0,0 +1,200 @@
+/* =========================================================================
+ * This file is part of six.sidd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six.sidd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include <string.h>
+
+#include <vector>
+
+#include <sys/OS.h>
+#include <mem/ScopedArray.h>
+#include <mem/SharedPtr.h>
+#include <six/LUTUtils.h>
+#include <six/NITFReadControl.h>
+#include <six/NITFWriteControl.h>
+#include <six/sidd/DerivedXMLControl.h>
+#include <six/sidd/Utilities.h>
+#include "TestCase.h"
+
+namespace
+{
+/*
+ * Writes a MONO16I SIDD whose pixels are all entries of a small LUT, then
+ * reads it back as LUT indices.  None of the entries are byte-symmetric,
+ * and each one's byte swap is either another entry or closer to a different
+ * entry, so reading the pixels in the wrong byte order maps them onto the
+ * wrong index.
+ */
+class TestHelper
+{
+public:
+    TestHelper() :
+        mPathname("test_read_lut_indices.nitf"),
+        mNumRows(37),
+        mNumCols(23)
+    {
+        mXmlRegistry.addCreator(
+                six::DataType::DERIVED,
+                new six::XMLControlCreatorT<six::sidd::DerivedXMLControl>());
+
+        mValues.push_back(0x0102);
+        mValues.push_back(0x0201);
+        mValues.push_back(0x00FF);
+        mValues.push_back(0xFF00);
+        mValues.push_back(0x8001);
+
+        mImage.resize(mNumRows * mNumCols);
+        for (size_t ii = 0; ii < mImage.size(); ++ii)
+        {
+            mImage[ii] = mValues[expectedIndex(ii)];
+        }
+
+        write();
+    }
+
+    ~TestHelper()
+    {
+        try
+        {
+            sys::OS().remove(mPathname);
+        }
+        catch (...)
+        {
+        }
+    }
+
+    six::LUT makeLUT() const
+    {
+        six::LUT lut(mValues.size(), sizeof(sys::Uint16_T));
+        for (size_t ii = 0; ii < mValues.size(); ++ii)
+        {
+            ::memcpy(lut[ii], &mValues[ii], sizeof(sys::Uint16_T));
+        }
+        return lut;
+    }
+
+    size_t expectedIndex(size_t pixel) const
+    {
+        return (pixel + pixel / mNumCols) % mValues.size();
+    }
+
+    const std::string mPathname;
+    const size_t mNumRows;
+    const size_t mNumCols;
+    six::XMLControlRegistry mXmlRegistry;
+
+private:
+    void write()
+    {
+        std::auto_ptr<six::sidd::DerivedData> data =
+                six::sidd::Utilities::createFakeDerivedData();
+        data->setNumRows(mNumRows);
+        data->setNumCols(mNumCols);
+        data->setPixelType(six::PixelType::MONO16I);
+
+        mem::SharedPtr<six::Container> container(
+                new six::Container(six::DataType::DERIVED));
+        container->addData(std::auto_ptr<six::Data>(data.release()));
+
+        six::BufferList buffers;
+        buffers.push_back(reinterpret_cast<const six::UByte*>(&mImage[0]));
+
+        six::NITFWriteControl writer(six::Options(), container,
+                                     &mXmlRegistry);
+        writer.save(buffers, mPathname, std::vector<std::string>());
+    }
+
+    std::vector<sys::Uint16_T> mValues;
+    std::vector<sys::Uint16_T> mImage;
+};
+
+TEST_CASE(testFullImage)
+{
+    TestHelper helper;
+    const six::InverseLUT inverseLUT(helper.makeLUT());
+
+    six::NITFReadControl reader;
+    reader.setXMLControlRegistry(&helper.mXmlRegistry);
+    reader.load(helper.mPathname);
+
+    for (size_t numThreads = 1; numThreads <= 4; numThreads += 3)
+    {
+        six::Region region;
+        const mem::ScopedArray<six::UByte> indices(
+                reader.interleavedToLUTIndices(region, 0, inverseLUT,
+                                               numThreads));
+        TEST_ASSERT_EQ(static_cast<size_t>(region.getNumRows()),
+                       helper.mNumRows);
+        TEST_ASSERT_EQ(static_cast<size_t>(region.getNumCols()),
+                       helper.mNumCols);
+
+        for (size_t ii = 0; ii < helper.mNumRows * helper.mNumCols; ++ii)
+        {
+            TEST_ASSERT_EQ(static_cast<size_t>(indices[ii]),
+                           helper.expectedIndex(ii));
+        }
+    }
+}
+
+TEST_CASE(testSubRegion)
+{
+    TestHelper helper;
+    const six::InverseLUT inverseLUT(helper.makeLUT());
+
+    six::NITFReadControl reader;
+    reader.setXMLControlRegistry(&helper.mXmlRegistry);
+    reader.load(helper.mPathname);
+
+    const size_t startRow = 5;
+    const size_t startCol = 3;
+    const size_t numRows = 11;
+    const size_t numCols = 7;
+
+    std::vector<six::UByte> indices(numRows * numCols);
+    six::Region region;
+    region.setStartRow(startRow);
+    region.setStartCol(startCol);
+    region.setNumRows(numRows);
+    region.setNumCols(numCols);
+    region.setBuffer(&indices[0]);
+    TEST_ASSERT_EQ(reader.interleavedToLUTIndices(region, 0, inverseLUT),
+                   &indices[0]);
+
+    for (size_t row = 0; row < numRows; ++row)
+    {
+        for (size_t col = 0; col < numCols; ++col)
+        {
+            const size_t pixel =
+                    (startRow + row) * helper.mNumCols + startCol + col;
+            TEST_ASSERT_EQ(static_cast<size_t>(indices[row * numCols + col]),
+                           helper.expectedIndex(pixel));
+        }
+    }
+}
+}
+
+int main(int, char**)
+{
+    TEST_CHECK(testFullImage);
+    TEST_CHECK(testSubRegion);
+    return 0;
+}
@@ -0,0 +1,182 @@
+/* =========================================================================
+ * This file is part of six.sidd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six.sidd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <vector>
+
+#include <sys/OS.h>
+#include <mem/ScopedArray.h>
+#include <mem/SharedPtr.h>
+#include <six/NITFReadControl.h>
+#include <six/NITFWriteControl.h>
+#include <six/NITFHeaderCreator.h>
+#include <six/sidd/DerivedXMLControl.h>
+#include <six/sidd/Utilities.h>
+#include "TestCase.h"
+
+namespace
+{
+/*
+ * Writes out a blocked, multi-segment MONO8I SIDD with a unique-ish value
+ * at each pixel
+ */
+struct TestHelper
+{
+    TestHelper() :
+        mPathname("test_read_reduced_resolution.nitf"),
+        mNumRows(123),
+        mNumCols(57),
+        mImage(mNumRows * mNumCols)
+    {
+        mXmlRegistry.addCreator(
+                six::DataType::DERIVED,
+                new six::XMLControlCreatorT<six::sidd::DerivedXMLControl>());
+
+        for (size_t ii = 0; ii < mImage.size(); ++ii)
+        {
+            mImage[ii] = static_cast<sys::ubyte>(ii * 7 + ii / mNumCols);
+        }
+
+        std::auto_ptr<six::sidd::DerivedData> data =
+                six::sidd::Utilities::createFakeDerivedData();
+        data->setNumRows(mNumRows);
+        data->setNumCols(mNumCols);
+        data->setPixelType(six::PixelType::MONO8I);
+
+        mem::SharedPtr<six::Container> container(
+                new six::Container(six::DataType::DERIVED));
+        container->addData(std::auto_ptr<six::Data>(data));
+
+        // Segments of 50 rows, blocks of 16 x 16
+        six::Options options;
+        options.setParameter(six::NITFHeaderCreator::OPT_MAX_PRODUCT_SIZE,
+                             str::toString(mNumCols * 50));
+        options.setParameter(six::NITFHeaderCreator::OPT_NUM_ROWS_PER_BLOCK,
+                             str::toString(16));
+        options.setParameter(six::NITFHeaderCreator::OPT_NUM_COLS_PER_BLOCK,
+                             str::toString(16));
+
+        six::NITFWriteControl writer(options, container, &mXmlRegistry);
+        std::vector<const six::UByte*> buffers(1, &mImage[0]);
+        writer.save(buffers, mPathname, std::vector<std::string>());
+    }
+
+    ~TestHelper()
+    {
+        try
+        {
+            sys::OS().remove(mPathname);
+        }
+        catch (...)
+        {
+        }
+    }
+
+    // Every 'skip'th pixel of the region, starting with its first
+    std::vector<sys::ubyte> decimate(size_t startRow, size_t numRows,
+                                     size_t startCol, size_t numCols,
+                                     size_t skip) const
+    {
+        std::vector<sys::ubyte> reduced;
+        for (size_t row = startRow; row < startRow + numRows; row += skip)
+        {
+            for (size_t col = startCol; col < startCol + numCols; col += skip)
+            {
+                reduced.push_back(mImage[row * mNumCols + col]);
+            }
+        }
+        return reduced;
+    }
+
+    bool readMatches(six::NITFReadControl& reader,
+                     size_t startRow, size_t numRows,
+                     size_t startCol, size_t numCols,
+                     size_t resolutionLevel,
+                     size_t numThreads) const
+    {
+        const std::vector<sys::ubyte> expected =
+                decimate(startRow, numRows, startCol, numCols,
+                         static_cast<size_t>(1) << resolutionLevel);
+
+        six::Region region;
+        region.setStartRow(startRow);
+        region.setNumRows(numRows);
+        region.setStartCol(startCol);
+        region.setNumCols(numCols);
+        const mem::ScopedArray<sys::ubyte> buffer(reader.interleavedReduced(
+                region, 0, resolutionLevel, numThreads));
+
+        return std::equal(expected.begin(), expected.end(), buffer.get());
+    }
+
+    const std::string mPathname;
+    const size_t mNumRows;
+    const size_t mNumCols;
+    std::vector<sys::ubyte> mImage;
+    six::XMLControlRegistry mXmlRegistry;
+};
+
+TEST_CASE(testFullImage)
+{
+    const TestHelper helper;
+    six::NITFReadControl reader;
+    reader.setXMLControlRegistry(&helper.mXmlRegistry);
+    reader.load(helper.mPathname);
+
+    // Includes skips bigger than a block
+    for (size_t level = 0; level <= 6; ++level)
+    {
+        TEST_ASSERT_TRUE(helper.readMatches(reader, 0, helper.mNumRows,
+                                            0, helper.mNumCols, level, 1));
+        TEST_ASSERT_TRUE(helper.readMatches(reader, 0, helper.mNumRows,
+                                            0, helper.mNumCols, level, 3));
+    }
+
+    six::Region region;
+    region.setNumRows(helper.mNumRows + 1);
+    TEST_EXCEPTION(reader.interleavedReduced(region, 0, 1));
+}
+
+TEST_CASE(testRegion)
+{
+    const TestHelper helper;
+    six::NITFReadControl reader;
+    reader.setXMLControlRegistry(&helper.mXmlRegistry);
+    reader.load(helper.mPathname);
+
+    // Starts partway through a block and spans a segment boundary
+    for (size_t level = 0; level <= 3; ++level)
+    {
+        TEST_ASSERT_TRUE(helper.readMatches(reader, 37, 61, 5, 45, level, 1));
+        TEST_ASSERT_TRUE(helper.readMatches(reader, 37, 61, 5, 45, level, 4));
+    }
+
+    // Region entirely within the last segment
+    TEST_ASSERT_TRUE(helper.readMatches(reader, 101, 22, 0, 57, 1, 2));
+}
+}
+
+int main(int, char**)
+{
+    TEST_CHECK(testFullImage);
+    TEST_CHECK(testRegion);
+    return 0;
+}
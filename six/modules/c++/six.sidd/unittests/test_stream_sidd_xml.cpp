@@ -0,0 +1,94 @@
+/* =========================================================================
+ * This file is part of six.sidd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six.sidd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <string>
+
+#include <io/StringStream.h>
+#include <logging/NullLogger.h>
+#include <six/XMLStreamWriter.h>
+#include <six/sidd/DerivedData.h>
+#include <six/sidd/DerivedXMLControl.h>
+#include <six/sidd/SIDDVersionUpdater.h>
+#include <six/sidd/Utilities.h>
+#include "TestCase.h"
+
+namespace
+{
+// Exposes both ways of writing out the XML, neither of which validates
+class TestXMLControl : public six::sidd::DerivedXMLControl
+{
+public:
+    std::string printDOM(const six::Data& data, const std::string& formatter)
+    {
+        const std::auto_ptr<xml::lite::Document> doc(toXMLImpl(&data));
+        io::StringStream stream;
+        if (formatter.empty())
+        {
+            doc->getRootElement()->print(stream);
+        }
+        else
+        {
+            doc->getRootElement()->prettyPrint(stream, formatter);
+        }
+        return stream.stream().str();
+    }
+
+    std::string stream(const six::Data& data, const std::string& formatter)
+    {
+        io::StringStream stream;
+        six::XMLStreamWriter writer(stream, formatter);
+        toXMLImpl(&data, writer);
+        return stream.stream().str();
+    }
+};
+
+TEST_CASE(testMatchesDOM)
+{
+    const std::string versions[] = {"1.0.0", "2.0.0"};
+    TestXMLControl xmlControl;
+    logging::NullLogger log;
+    for (size_t ii = 0; ii < sizeof(versions) / sizeof(versions[0]); ++ii)
+    {
+        const std::auto_ptr<six::sidd::DerivedData> data =
+                six::sidd::Utilities::createFakeDerivedData();
+        data->setVersion("1.0.0");
+        data->setPixelType(six::PixelType::MONO8I);
+        if (versions[ii] != data->getVersion())
+        {
+            six::sidd::SIDDVersionUpdater(*data, versions[ii], log).update();
+        }
+
+        const std::string xml = xmlControl.stream(*data, "");
+        TEST_ASSERT_EQ(xml, xmlControl.printDOM(*data, ""));
+        TEST_ASSERT_EQ(xmlControl.stream(*data, "    "),
+                       xmlControl.printDOM(*data, "    "));
+        TEST_ASSERT_EQ(xml.find("xmlns=\"urn:SIDD:"), 6);
+        TEST_ASSERT(xml.find("xmlns:si=") != std::string::npos);
+        TEST_ASSERT(xml.find("<si:") != std::string::npos);
+    }
+}
+}
+
+int main(int, char**)
+{
+    TEST_CHECK(testMatchesDOM);
+    return 0;
+}
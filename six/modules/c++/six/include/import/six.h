@@ -30,9 +30,11 @@
 #include "six/ErrorStatistics.h"
 #include "six/MatchInformation.h"
 #include "six/GeoInfo.h"
+#include "six/LUTUtils.h"
 #include "six/Mesh.h"
 #include "six/NITFImageInfo.h"
 #include "six/NITFImageInputStream.h"
+#include "six/NITFMetadataReader.h"
 #include "six/NITFSegmentInfo.h"
 #include "six/NITFReadControl.h"
 #include "six/NITFWriteControl.h"
@@ -49,6 +51,7 @@
 #include "six/WriteControl.h"
 #include "six/XMLControl.h"
 #include "six/XMLControlFactory.h"
+#include "six/XMLSubsetParser.h"
 
 #endif
 
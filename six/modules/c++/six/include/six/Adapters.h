@@ -126,6 +126,49 @@ public:
                        bool doByteSwap);
 };
 
+/*!
+ *  \class ParallelMemoryWriteHandler
+ *  \brief Overloaded NITF write handler from memory buffer which prepares
+ *  the image data with multiple threads
+ *
+ *  Like the MemoryWriteHandler, but the segment is processed in bands.
+ *  The rows of each band are split up between the threads, which copy,
+ *  rearrange into NITF blocks (if the segment is blocked, including pad
+ *  rows and columns) and byte swap them.  Each band is then written out
+ *  before moving on to the next, so the data still goes into the NITF in
+ *  order and only one band is held in memory at a time.
+ *
+ *  Compressed segments are not supported.
+ */
+class ParallelMemoryWriteHandler: public nitf::WriteHandler
+{
+public:
+    /*!
+     *  \param info Segment to write
+     *  \param buffer Image buffer, starting at the first row of the image
+     *  \param firstRow First row of the segment within 'buffer'
+     *  \param numCols Number of columns in the image
+     *  \param numChannels Number of channels per pixel
+     *  \param pixelSize Number of bytes per pixel
+     *  \param doByteSwap Whether to byte swap each channel
+     *  \param numRowsPerBlock Number of rows per block.  If 0, the segment
+     *  is written unblocked.
+     *  \param numColsPerBlock Number of columns per block.  If 0, the
+     *  segment is written unblocked.
+     *  \param numThreads Number of threads to use
+     */
+    ParallelMemoryWriteHandler(const NITFSegmentInfo& info,
+                               const UByte* buffer,
+                               size_t firstRow,
+                               size_t numCols,
+                               size_t numChannels,
+                               size_t pixelSize,
+                               bool doByteSwap,
+                               size_t numRowsPerBlock,
+                               size_t numColsPerBlock,
+                               size_t numThreads);
+};
+
 /*!
  *  \class StreamWriteHandler
  *  \brief Derived implementation for nitf::WriteHandler
@@ -139,6 +139,13 @@ public:
     void initialize(std::auto_ptr<six::NITFHeaderCreator> headerCreator,
                     const std::vector<std::string>& schemaPaths,
                     const std::vector<PtrAndLength>& desBuffers);
+
+    /*!
+     * \return Whether image data has to be blocked via getImageBlocker()
+     * before it is passed to getBytes()
+     */
+    bool isBlocked() const;
+
 protected:
     /*!
      * Default constructor. Client code must call initialize() to
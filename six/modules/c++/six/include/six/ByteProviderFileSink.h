@@ -0,0 +1,120 @@
+/* =========================================================================
+ * This file is part of six-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef __SIX_BYTE_PROVIDER_FILE_SINK_H__
+#define __SIX_BYTE_PROVIDER_FILE_SINK_H__
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <sys/Conf.h>
+#include <sys/File.h>
+#include <sys/Mutex.h>
+#include <nitf/ImageBlocker.hpp>
+#include <nitf/NITFBufferList.hpp>
+#include <six/ByteProvider.h>
+#include <six/Data.h>
+
+namespace six
+{
+/*!
+ * \class ByteProviderFileSink
+ * \brief Writes the pieces of a NITF produced by a ByteProvider to a file
+ *
+ * Image data is passed in native byte order and, for blocked products,
+ * unblocked.  The sink byte swaps and blocks it into reusable scratch
+ * buffers as needed, then writes everything getBytes() returns for those
+ * rows with a single positional write.  Rows may be written in any order
+ * and from multiple threads at once.
+ */
+class ByteProviderFileSink
+{
+public:
+    /*!
+     * Constructor.  Creates the file, replacing any existing one.
+     *
+     * \param byteProvider Initialized byte provider for 'data'.  Must
+     * outlive this object.
+     * \param data Representation of the product being written
+     * \param pathname Output NITF pathname
+     */
+    ByteProviderFileSink(const ByteProvider& byteProvider,
+                         const Data& data,
+                         const std::string& pathname);
+
+    //! Destructor.  Closes the file.
+    ~ByteProviderFileSink();
+
+    /*!
+     * Writes a band of rows along with any headers or DES that belong
+     * before or after them.  This may be called concurrently.
+     *
+     * \param imageData Pixels in row-major order and native byte order.
+     * Must contain 'numRows' full rows of the image.
+     * \param startRow Global start row of the band.  For blocked products,
+     * this must be the start of a block.
+     * \param numRows Number of rows in the band.  For blocked products, the
+     * band must end on a block or image segment boundary.
+     */
+    void write(const void* imageData, size_t startRow, size_t numRows);
+
+    /*!
+     * Writes buffers that are contiguous in the file with a single
+     * positional write.  This may be called concurrently.
+     *
+     * \param fileOffset File offset to write 'buffers' to
+     * \param buffers Buffers to write
+     */
+    void write(nitf::Off fileOffset, const nitf::NITFBufferList& buffers);
+
+    //! Closes the file.  No more writes are allowed afterwards.
+    void close();
+
+private:
+    ByteProviderFileSink(const ByteProviderFileSink&);
+    ByteProviderFileSink& operator=(const ByteProviderFileSink&);
+
+    std::vector<sys::ubyte>* acquireBuffer();
+    void releaseBuffer(std::vector<sys::ubyte>* buffer);
+
+private:
+    const ByteProvider& mByteProvider;
+    const size_t mNumCols;
+    const size_t mNumBytesPerPixel;
+
+    // Size of each value that needs byte swapping (e.g. 4 for complex
+    // float), or 0 if nothing needs to be swapped
+    size_t mNumBytesToSwap;
+
+    // NULL for products that aren't blocked
+    std::auto_ptr<const nitf::ImageBlocker> mImageBlocker;
+
+    sys::File mFile;
+
+    // Guards mFreeBuffers and, on platforms without positional writes,
+    // the file position
+    sys::Mutex mMutex;
+    std::vector<std::vector<sys::ubyte>*> mFreeBuffers;
+};
+}
+
+#endif
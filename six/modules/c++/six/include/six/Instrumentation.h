@@ -0,0 +1,181 @@
+/* =========================================================================
+ * This file is part of six-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef __SIX_INSTRUMENTATION_H__
+#define __SIX_INSTRUMENTATION_H__
+
+#include <atomic>
+#include <map>
+#include <ostream>
+#include <string>
+
+#include <sys/Conf.h>
+#include <sys/StopWatch.h>
+
+namespace six
+{
+/*!
+ * \struct InstrumentationCounters
+ * \brief Totals for one instrumentation point
+ */
+struct InstrumentationCounters
+{
+    InstrumentationCounters();
+
+    //! Adds the totals of 'other' to these
+    void add(const InstrumentationCounters& other);
+
+    //! Number of times the point was hit
+    sys::Uint64_T calls;
+
+    //! Total and longest time spent in the point, in ms
+    double elapsedMs;
+    double maxMs;
+
+    //! Bytes read, written or processed
+    sys::Uint64_T bytes;
+
+    //! Number of seeks
+    sys::Uint64_T seeks;
+};
+
+/*!
+ * \struct InstrumentationSnapshot
+ * \brief Totals of every point that was hit, keyed by point name
+ */
+struct InstrumentationSnapshot
+{
+    std::map<std::string, InstrumentationCounters> points;
+};
+
+/*!
+ * Writes one line per point, as
+ *   name calls=N elapsed_ms=T max_ms=T bytes=N seeks=N
+ * which is meant to be easy to both read and scrape.
+ */
+std::ostream& operator<<(std::ostream& os,
+                         const InstrumentationSnapshot& snapshot);
+
+/*!
+ * \class Instrumentation
+ * \brief Opt-in timers and byte and seek counters for the hot paths
+ *
+ * Points are registered by name, usually once at static initialization,
+ * and hit through InstrumentationTimer.  Instrumentation is off by default
+ * and a disabled timer only checks a flag, so the points can stay in the
+ * hot paths.
+ *
+ * Threads record into one of a fixed number of shards, picked by thread
+ * ID, so threads rarely contend with one another.  A snapshot sums the
+ * shards.
+ */
+class Instrumentation
+{
+public:
+    /*!
+     * Turns instrumentation on or off.  This may be done while other
+     * threads are hitting points.  Timers that are already running when
+     * it's changed keep the state they started with.
+     */
+    static void enable(bool enabled = true);
+
+    //! True if points are being recorded
+    static bool isEnabled()
+    {
+        return mEnabled.load(std::memory_order_relaxed);
+    }
+
+    /*!
+     * Returns the ID of the point with this name, registering it if needed
+     *
+     * \param name Name of the point, e.g. "six::NITFReadControl::load"
+     */
+    static size_t registerPoint(const std::string& name);
+
+    /*!
+     * Records one hit of a point
+     *
+     * \param point ID from registerPoint()
+     * \param elapsedMs Time spent, in ms
+     * \param bytes Bytes read, written or processed
+     * \param seeks Number of seeks
+     */
+    static void record(size_t point,
+                       double elapsedMs,
+                       sys::Uint64_T bytes,
+                       sys::Uint64_T seeks);
+
+    //! Totals of every point that was hit since the last reset()
+    static InstrumentationSnapshot snapshot();
+
+    //! Zeros every point
+    static void reset();
+
+private:
+    static std::atomic<bool> mEnabled;
+};
+
+/*!
+ * \class InstrumentationTimer
+ * \brief Times a scope and records it, along with any bytes and seeks, to
+ * a point when it ends.  Does nothing if instrumentation is disabled when
+ * the scope starts.
+ */
+class InstrumentationTimer
+{
+public:
+    /*!
+     * Starts timing
+     *
+     * \param point ID from Instrumentation::registerPoint()
+     * \param bytes Bytes read, written or processed, if already known
+     */
+    explicit InstrumentationTimer(size_t point, sys::Uint64_T bytes = 0);
+
+    //! Stops timing and records the point
+    ~InstrumentationTimer();
+
+    //! Counts bytes read, written or processed
+    void addBytes(sys::Uint64_T bytes)
+    {
+        mBytes += bytes;
+    }
+
+    //! Counts seeks
+    void addSeeks(sys::Uint64_T seeks)
+    {
+        mSeeks += seeks;
+    }
+
+private:
+    InstrumentationTimer(const InstrumentationTimer&);
+    InstrumentationTimer& operator=(const InstrumentationTimer&);
+
+private:
+    const size_t mPoint;
+    const bool mEnabled;
+    sys::Uint64_T mBytes;
+    sys::Uint64_T mSeeks;
+    sys::RealTimeStopWatch mStopWatch;
+};
+}
+
+#endif
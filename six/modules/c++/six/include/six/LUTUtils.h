@@ -0,0 +1,101 @@
+/* =========================================================================
+ * This file is part of six-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef __SIX_LUT_UTILS_H__
+#define __SIX_LUT_UTILS_H__
+
+#include <vector>
+
+#include <sys/Conf.h>
+#include <six/Types.h>
+
+namespace six
+{
+/*!
+ * Expands LUT indices into their LUT entries.  This is what turns an
+ * RGB8LU product into interleaved RGB triplets, or a MONO8LU product into
+ * 16-bit values.  Entries are copied exactly as they are stored in the LUT,
+ * so 16-bit output has the LUT's byte order: LUTs built from a NITF
+ * subheader (six::LUT(nitf::LookupTable)) store them little-endian, while
+ * LUTs parsed from SIDD 1.0 XML store them native-endian.
+ *
+ * \param input LUT indices.  Must contain 'numPixels' values.  Indices
+ * past the end of the LUT expand to zeros.
+ * \param numPixels Number of pixels to expand
+ * \param lut Lookup table to apply.  Must have no more than 256 entries.
+ * \param numThreads Number of threads to use
+ * \param output Expanded output.  Must hold 'numPixels * lut.elementSize'
+ * bytes.
+ */
+void applyLUT(const UByte* input,
+              size_t numPixels,
+              const LUT& lut,
+              size_t numThreads,
+              UByte* output);
+
+/*!
+ * \class InverseLUT
+ * \brief Maps 16-bit pixel values back onto LUT indices
+ *
+ * Given a MONO LUT (8-bit index -> 16-bit value), this precomputes, for
+ * every possible 16-bit value, the index whose LUT entry is closest to it.
+ * Ties go to the lowest index.  Building an index image is then a single
+ * table lookup per pixel.
+ */
+class InverseLUT
+{
+public:
+    //! Size of the precomputed table
+    static const size_t NUM_VALUES = 65536;
+
+    /*!
+     * Constructor
+     *
+     * \param lut Lookup table to invert.  Must have 2-byte entries, which
+     * are read as native-endian values, and no more than 256 of them.
+     */
+    InverseLUT(const LUT& lut);
+
+    //! \return The index whose LUT entry is closest to 'value'
+    UByte operator()(sys::Uint16_T value) const
+    {
+        return mTable[value];
+    }
+
+    /*!
+     * Converts 16-bit values into LUT indices
+     *
+     * \param input Values to convert.  Must contain 'numPixels' values.
+     * \param numPixels Number of pixels to convert
+     * \param numThreads Number of threads to use
+     * \param output LUT indices.  Must hold 'numPixels' bytes.
+     */
+    void apply(const sys::Uint16_T* input,
+               size_t numPixels,
+               size_t numThreads,
+               UByte* output) const;
+
+private:
+    std::vector<UByte> mTable;
+};
+}
+
+#endif
@@ -0,0 +1,156 @@
+/* =========================================================================
+ * This file is part of six-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef __SIX_NITF_METADATA_READER_H__
+#define __SIX_NITF_METADATA_READER_H__
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <io/SeekableStreams.h>
+#include <logging/Logger.h>
+#include <mem/SharedPtr.h>
+#include <sys/Conf.h>
+#include <xml/lite/Document.h>
+#include <six/Data.h>
+#include <six/Types.h>
+#include <six/XMLControlFactory.h>
+
+namespace six
+{
+/*!
+ * \class NITFMetadataReader
+ * \brief Gets the SICD/SIDD XML out of a NITF without loading the rest
+ *
+ * NITFReadControl::load() reads every subheader in the file, parses and
+ * validates the XML, looks for legends and sets up for reading pixels.
+ * This class is for when only the metadata is wanted.  It reads the NITF
+ * file header and the DES subheaders directly (one read each) to find the
+ * SICD/SIDD DESs, and only reads a DES's XML when asked for it.  Image
+ * subheaders and pixel data are never touched.
+ *
+ * Only NITF 2.1 (and NSIF 1.0) files are supported, as required by the
+ * SICD and SIDD specs.  Reads share the one stream, so an object must not
+ * be used by multiple threads at once.
+ */
+class NITFMetadataReader
+{
+public:
+    /*!
+     * Reads the file header and DES subheaders
+     *
+     * \param pathname NITF pathname
+     */
+    NITFMetadataReader(const std::string& pathname);
+
+    /*!
+     * Reads the file header and DES subheaders
+     *
+     * \param inStream Stream positioned anywhere.  The NITF must start at
+     * the beginning of the stream.
+     */
+    NITFMetadataReader(mem::SharedPtr<io::SeekableInputStream> inStream);
+
+    /*!
+     * \return The type of the first DES, which is how
+     * NITFReadControl::getDataType() decides if a file is a SICD or SIDD.
+     * NOT_SET if it isn't a SICD/SIDD DES.
+     */
+    DataType getDataType() const
+    {
+        return mDataType;
+    }
+
+    //! \return The number of SICD/SIDD DESs, in file order
+    size_t getNumXML() const
+    {
+        return mDESs.size();
+    }
+
+    /*!
+     * \param index Index of a SICD/SIDD DES
+     * \return Whether it holds COMPLEX or DERIVED XML
+     */
+    DataType getDataType(size_t index) const;
+
+    /*!
+     * Reads the XML from a SICD/SIDD DES
+     *
+     * \param index Index of a SICD/SIDD DES
+     * \return The raw XML
+     */
+    std::string getXML(size_t index) const;
+
+    /*!
+     * Reads and parses the XML from a SICD/SIDD DES, keeping only some of
+     * the top-level elements
+     *
+     * \param index Index of a SICD/SIDD DES
+     * \param elementNames Local names of the root's children to keep (e.g.
+     * "CollectionInfo", "GeoData").  If empty, the whole document is kept.
+     * \return The document
+     */
+    std::auto_ptr<xml::lite::Document> getXMLDocument(
+            size_t index,
+            const std::vector<std::string>& elementNames =
+                    std::vector<std::string>()) const;
+
+    /*!
+     * Reads and parses the XML from a SICD/SIDD DES into a Data object, the
+     * same way NITFReadControl::load() does.  Unlike NITFReadControl, the
+     * classification options from the NITF subheaders are not filled in.
+     *
+     * \param index Index of a SICD/SIDD DES
+     * \param xmlRegistry XML registry
+     * \param schemaPaths Schema paths to validate against.  If empty, no
+     * validation is done.
+     * \param log Logger for validation errors
+     * \return The data
+     */
+    std::auto_ptr<Data> getData(size_t index,
+                                const XMLControlRegistry& xmlRegistry,
+                                const std::vector<std::string>& schemaPaths,
+                                logging::Logger& log) const;
+
+private:
+    struct DESInfo
+    {
+        DataType dataType;
+        sys::Off_T dataOffset;
+        size_t dataLength;
+    };
+
+    void initialize();
+
+    void readAt(sys::Off_T offset, size_t numBytes,
+                std::vector<sys::byte>& buffer) const;
+
+    const DESInfo& getDES(size_t index) const;
+
+private:
+    const mem::SharedPtr<io::SeekableInputStream> mInStream;
+    DataType mDataType;
+    std::vector<DESInfo> mDESs;
+};
+}
+
+#endif
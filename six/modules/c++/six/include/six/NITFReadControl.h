@@ -28,6 +28,7 @@
 #include "six/ReadControl.h"
 #include "six/ReadControlFactory.h"
 #include "six/Adapters.h"
+#include "six/LUTUtils.h"
 #include <io/SeekableStreams.h>
 #include <import/nitf.hpp>
 #include <nitf/IOStreamReader.hpp>
@@ -154,6 +155,81 @@ public:
      */
     virtual UByte* interleaved(Region& region, size_t imageNumber);
 
+    /*!
+     * Read a reduced-resolution overview of a section of the image.  Level
+     * 'n' keeps every 2^n-th row and column of the region, starting with its
+     * first pixel, so the returned buffer holds
+     * ceil(numRows / 2^n) x ceil(numCols / 2^n) pixels.  Only the NITF
+     * blocks that intersect the region and contain kept rows are read and
+     * decompressed.
+     *
+     * This point-samples the full-resolution pixels; nothing is filtered or
+     * averaged first, so detail finer than the new pixel spacing aliases.
+     * It is not a true reduced-resolution read: J2K resolution levels are
+     * not used, and every block that holds a kept row is still decoded at
+     * full resolution.
+     *
+     * When more than one thread is requested and the image was loaded from
+     * a pathname, each thread reads its own rows of blocks through its own
+     * handle to the file.  Otherwise the read is done serially.
+     *
+     * \param region Rows and columns of the image to read, at full
+     * resolution, as with interleaved().  The number of rows and columns
+     * are not updated to the reduced size.  If the buffer is set, it must be
+     * large enough to hold the reduced pixels.
+     * \param imageNumber Index of the image to read
+     * \param resolutionLevel Number of times to halve the resolution
+     * \param numThreads Number of threads to read with
+     *
+     * \return Buffer of reduced image data.  Memory ownership follows the
+     * same rules as interleaved().
+     */
+    UByte* interleavedReduced(Region& region,
+                              size_t imageNumber,
+                              size_t resolutionLevel,
+                              size_t numThreads = 1);
+
+    /*!
+     * Read section of a LUT-indexed image (MONO8LU or RGB8LU) and expand
+     * it through the image's display LUT.  For RGB8LU this gives back
+     * interleaved RGB triplets rather than LUT indices.  For MONO8LU, the
+     * 16-bit values keep the display LUT's stored byte order (see
+     * applyLUT()).
+     *
+     * \param region Rows and columns of the image to read, as with
+     * interleaved().  If the buffer is set, it must be large enough to
+     * hold the expanded pixels (LUT element size bytes per pixel).
+     * \param imageNumber Index of the image to read
+     * \param numThreads Number of threads to use for the LUT application
+     *
+     * \return Buffer of expanded image data.  Memory ownership follows the
+     * same rules as interleaved().
+     */
+    UByte* interleavedThroughLUT(Region& region,
+                                 size_t imageNumber,
+                                 size_t numThreads = 1);
+
+    /*!
+     * Read section of a 16-bit image (e.g. MONO16I) and convert it into
+     * LUT indices, suitable for a MONO8LU display product.
+     *
+     * \param region Rows and columns of the image to read, as with
+     * interleaved().  If the buffer is set, it must be large enough to
+     * hold one byte per pixel.
+     * \param imageNumber Index of the image to read
+     * \param inverseLUT Precomputed mapping from pixel values to LUT
+     * indices.  Pixels are looked up in native byte order, as returned by
+     * interleaved().
+     * \param numThreads Number of threads to use for the conversion
+     *
+     * \return Buffer of LUT indices.  Memory ownership follows the
+     * same rules as interleaved().
+     */
+    UByte* interleavedToLUTIndices(Region& region,
+                                   size_t imageNumber,
+                                   const InverseLUT& inverseLUT,
+                                   size_t numThreads = 1);
+
     virtual std::string getFileType() const
     {
         return "NITF";
@@ -247,6 +323,9 @@ private:
     // The issue occurs from the explicit destructor of
     // IOControl
     mem::SharedPtr<nitf::IOInterface> mInterface;
+
+    // Set when loaded from a file so that additional readers can be opened
+    std::string mPathname;
 };
 
 
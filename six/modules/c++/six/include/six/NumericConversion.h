@@ -0,0 +1,112 @@
+/* =========================================================================
+ * This file is part of six-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef __SIX_NUMERIC_CONVERSION_H__
+#define __SIX_NUMERIC_CONVERSION_H__
+
+#include <string>
+
+#include <import/str.h>
+
+namespace six
+{
+/*!
+ * Converts a number to the same text as str::toString(), without going
+ * through an ostream.  Floating point values use printf's %g notation with
+ * max_digits10 significant digits, so they parse back to exactly the same
+ * value.  The result always uses '.' as the decimal point regardless of the
+ * global C locale.
+ *
+ * Types other than the built-in floating point and integer types fall back
+ * to str::toString().
+ *
+ * \param value Value to convert
+ *
+ * \return String representation of 'value'
+ */
+template <typename T>
+std::string formatNumber(const T& value)
+{
+    return str::toString<T>(value);
+}
+
+template <> std::string formatNumber(const float& value);
+template <> std::string formatNumber(const double& value);
+template <> std::string formatNumber(const short& value);
+template <> std::string formatNumber(const unsigned short& value);
+template <> std::string formatNumber(const int& value);
+template <> std::string formatNumber(const unsigned int& value);
+template <> std::string formatNumber(const long& value);
+template <> std::string formatNumber(const unsigned long& value);
+template <> std::string formatNumber(const long long& value);
+template <> std::string formatNumber(const unsigned long long& value);
+
+/*!
+ * Same as formatNumber() but in scientific notation with max_digits10
+ * digits after the decimal point, an uppercase 'E' and no '+' in the
+ * exponent (e.g. "1.00000000000000006E-01", "3.00000000000000000E08"), as
+ * used for xs:double values in the SICD and SIDD XML.
+ *
+ * \param value Value to convert
+ *
+ * \return Scientific representation of 'value'
+ */
+std::string formatScientific(double value);
+
+//! \copydoc formatScientific(double)
+std::string formatScientific(float value);
+
+/*!
+ * Parses a number, accepting exactly what str::toType() does and giving
+ * the same value, independent of the global C locale.  Leading whitespace
+ * is skipped and the number ends at the first character that can't
+ * continue it, so "1.5" parses as 1 for integer types and trailing text is
+ * ignored.  Negative values wrap around for unsigned types.
+ *
+ * Types other than the built-in floating point and integer types fall back
+ * to str::toType().
+ *
+ * \param s String to parse
+ *
+ * \return The value in 's'
+ *
+ * \throws except::BadCastException if 's' doesn't start with a valid T or
+ * it is out of range for T
+ */
+template <typename T>
+T parseNumber(const std::string& s)
+{
+    return str::toType<T>(s);
+}
+
+template <> float parseNumber(const std::string& s);
+template <> double parseNumber(const std::string& s);
+template <> short parseNumber(const std::string& s);
+template <> unsigned short parseNumber(const std::string& s);
+template <> int parseNumber(const std::string& s);
+template <> unsigned int parseNumber(const std::string& s);
+template <> long parseNumber(const std::string& s);
+template <> unsigned long parseNumber(const std::string& s);
+template <> long long parseNumber(const std::string& s);
+template <> unsigned long long parseNumber(const std::string& s);
+}
+
+#endif
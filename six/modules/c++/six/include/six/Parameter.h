@@ -23,7 +23,9 @@
 #define __SIX_PARAMETER_H__
 
 #include "six/Types.h"
+#include <complex>
 #include <import/str.h>
+#include "six/NumericConversion.h"
 
 namespace six
 {
@@ -35,36 +37,53 @@ namespace six
  *  for use with the Options object and allows the developer to set
  *  and get parameters directly from native types without string
  *  conversion.
+ *
+ *  Built-in numeric and complex values are stored as-is, so reading
+ *  them back as the same kind of type doesn't parse anything, and setting
+ *  them doesn't allocate.  They're only formatted as a string when one is
+ *  asked for.  Other types are stored as strings.
  */
 class Parameter
 {
 public:
     //!  Constructor
-    Parameter()
+    Parameter() :
+        mFormatted(true),
+        mType(STRING),
+        mImag(0.0)
     {
+        mNumber.real = 0.0;
     }
+    //!  Copy constructor.  Doesn't copy a numeric value's formatted string.
+    Parameter(const Parameter& other);
+
+    //!  Assignment operator.  Doesn't copy a numeric value's formatted string.
+    Parameter& operator=(const Parameter& other);
+
     //!  Destructor
     ~Parameter()
     {
     }
 
-    Parameter(const Parameter & other)
-      : mValue(other.mValue),
-        mName(other.mName)
-    {
-    }
-
     //!  Templated constructor, constructs from given value
     template<typename T>
-    Parameter(T value)
+    Parameter(T value) :
+        mFormatted(true),
+        mType(STRING),
+        mImag(0.0)
     {
-        mValue = str::toString<T>(value);
+        mNumber.real = 0.0;
+        assign(value);
     }
 
     template<typename T>
-    Parameter(std::complex<T> value)
+    Parameter(std::complex<T> value) :
+        mFormatted(true),
+        mType(STRING),
+        mImag(0.0)
     {
-        mValue = str::toString<std::complex<T> >(mValue);
+        mNumber.real = 0.0;
+        assign(value);
     }
 
      /*!
@@ -75,14 +94,12 @@ public:
     template<typename T>
     inline operator T() const
     {
-        return str::toType<T>(mValue);
+        return toValue(static_cast<T*>(NULL));
     }
 
     //!  Get a string as a string
-    inline std::string str() const
-    {
-        return mValue;
-    }
+    std::string str() const;
+
     //!  Get the parameter's name
     inline std::string getName() const
     {
@@ -93,7 +110,7 @@ public:
     template<typename T>
     inline std::complex<T> getComplex() const
     {
-        return str::toType<std::complex<T> >(mValue);
+        return toComplex(static_cast<T*>(NULL));
     }
 
     //!  Set the parameters' name
@@ -106,26 +123,27 @@ public:
     template<typename T>
     void setValue(T value)
     {
-        mValue = str::toString<T>(value);
+        assign(value);
     }
 
     //! Overload templated setValue function
     template<typename T>
     void setValue(const std::complex<T>& value)
     {
-        mValue = str::toString<std::complex<T> >(value);
+        assign(value);
     }
 
-    //!  Get back const char*
+    /*!
+     *  Get back const char*.  A numeric value is formatted the first time
+     *  this is called after it's set, and the string is kept until the
+     *  value changes.
+     */
     operator const char*() const
     {
-        return mValue.c_str();
+        return getFormatted().c_str();
     }
 
-    bool operator==(const Parameter& o) const
-    {
-        return mName == o.mName && mValue == o.mValue;
-    }
+    bool operator==(const Parameter& o) const;
 
     bool operator!=(const Parameter& o) const
     {
@@ -133,12 +151,149 @@ public:
     }
 
 protected:
-    std::string mValue;
+    // String representation of the value.  For numeric values, this is
+    // only filled in by getFormatted() and is current when mFormatted is.
+    mutable std::string mValue;
     std::string mName;
 
+private:
+    enum ValueType
+    {
+        STRING,
+        FLOAT,
+        DOUBLE,
+        SIGNED,
+        UNSIGNED,
+        COMPLEX_INT,
+        COMPLEX_FLOAT,
+        COMPLEX_DOUBLE
+    };
+
+    // Anything without an overload below is stored as a string
+    template<typename T>
+    void assign(const T& value)
+    {
+        setString(six::formatNumber<T>(value));
+    }
+
+    template<typename T>
+    void assign(const std::complex<T>& value)
+    {
+        setString(str::toString<std::complex<T> >(value));
+    }
+
+    void assign(const std::string& value)
+    {
+        setString(value);
+    }
+
+    void assign(float value)
+    {
+        setReal(FLOAT, value, 0.0);
+    }
+    void assign(double value)
+    {
+        setReal(DOUBLE, value, 0.0);
+    }
+    void assign(short value)
+    {
+        setSigned(value);
+    }
+    void assign(int value)
+    {
+        setSigned(value);
+    }
+    void assign(long value)
+    {
+        setSigned(value);
+    }
+    void assign(long long value)
+    {
+        setSigned(value);
+    }
+    void assign(unsigned short value)
+    {
+        setUnsigned(value);
+    }
+    void assign(unsigned int value)
+    {
+        setUnsigned(value);
+    }
+    void assign(unsigned long value)
+    {
+        setUnsigned(value);
+    }
+    void assign(unsigned long long value)
+    {
+        setUnsigned(value);
+    }
+    void assign(const std::complex<int>& value)
+    {
+        setReal(COMPLEX_INT, value.real(), value.imag());
+    }
+    void assign(const std::complex<float>& value)
+    {
+        setReal(COMPLEX_FLOAT, value.real(), value.imag());
+    }
+    void assign(const std::complex<double>& value)
+    {
+        setReal(COMPLEX_DOUBLE, value.real(), value.imag());
+    }
+
+    void setString(const std::string& value);
+    void setReal(ValueType type, double real, double imag);
+    void setSigned(long long value);
+    void setUnsigned(unsigned long long value);
+
+    // Formats the stored value the way str() returns it
+    std::string format() const;
+
+    // Fills in mValue if it isn't current and returns it
+    const std::string& getFormatted() const;
+
+    // Anything without an overload below is parsed from str()
+    template<typename T>
+    T toValue(T*) const
+    {
+        return six::parseNumber<T>(str());
+    }
+
+    std::string toValue(std::string*) const;
+    float toValue(float*) const;
+    double toValue(double*) const;
+    short toValue(short*) const;
+    int toValue(int*) const;
+    long toValue(long*) const;
+    long long toValue(long long*) const;
+    unsigned short toValue(unsigned short*) const;
+    unsigned int toValue(unsigned int*) const;
+    unsigned long toValue(unsigned long*) const;
+    unsigned long long toValue(unsigned long long*) const;
+
+    template<typename T>
+    T toInteger() const;
+
+    template<typename T>
+    std::complex<T> toComplex(T*) const
+    {
+        return str::toType<std::complex<T> >(str());
+    }
+
+    std::complex<int> toComplex(int*) const;
+    std::complex<float> toComplex(float*) const;
+    std::complex<double> toComplex(double*) const;
+
+    mutable bool mFormatted;
+    ValueType mType;
+    union
+    {
+        double real;
+        long long integer;
+        unsigned long long uinteger;
+    } mNumber;
+    double mImag;
 };
 
 }
 
 #endif
-
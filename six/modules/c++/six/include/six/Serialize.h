@@ -185,6 +185,133 @@ struct Serializer<std::string>
     }
 };
 
+/*!
+ * \struct ArraySerializer
+ * \tparam T Scalar type
+ * \brief Implements serialization and deserialization for contiguous
+ *  arrays of scalars.  The bytes are the same as serializing each value
+ *  in turn, but the whole array is copied (and byte swapped) at once.
+ */
+template<typename T>
+struct ArraySerializer
+{
+    /*!
+     * Serialize an array of values into a byte buffer.  The length is
+     * not written.
+     * \param values The values to serialize.
+     * \param numValues The number of values.
+     * \param swapBytes Should byte-swapping be applied?
+     * \param[out] buffer The serialized data.
+     */
+    static void serializeImpl(const T* values,
+                              size_t numValues,
+                              bool swapBytes,
+                              std::vector<sys::byte>& buffer)
+    {
+        const size_t numBytes = numValues * sizeof(T);
+        if (numBytes == 0)
+        {
+            return;
+        }
+
+        const size_t prevLength = buffer.size();
+        buffer.resize(prevLength + numBytes);
+
+        const sys::byte* data = reinterpret_cast<const sys::byte*>(values);
+        if (swapBytes && sizeof(T) > 1)
+        {
+            sys::byteSwap(data,
+                          static_cast<unsigned short>(sizeof(T)),
+                          numValues,
+                          &buffer[prevLength]);
+        }
+        else
+        {
+            std::copy(data, data + numBytes, &buffer[prevLength]);
+        }
+    }
+
+    /*!
+     * Deserialize a byte array into an array of values.
+     * \param buffer The data to deserialize. Pointer is incremented
+     *  by numValues * sizeof(T) after calling this function.
+     * \param swapBytes Should byte-swapping be applied?
+     * \param numValues The number of values.
+     * \param[out] values The values to deserialize into.
+     */
+    static void deserializeImpl(const sys::byte*& buffer,
+                                bool swapBytes,
+                                size_t numValues,
+                                T* values)
+    {
+        const size_t numBytes = numValues * sizeof(T);
+        if (numBytes == 0)
+        {
+            return;
+        }
+
+        sys::byte* data = reinterpret_cast<sys::byte*>(values);
+        std::copy(buffer, buffer + numBytes, data);
+        if (swapBytes)
+        {
+            sys::byteSwap(data,
+                          static_cast<unsigned short>(sizeof(T)),
+                          numValues);
+        }
+
+        buffer += numBytes;
+    }
+};
+
+/*!
+ * \struct ScalarVectorSerializer
+ * \tparam T Scalar type
+ * \brief Same format as Serializer<std::vector<T> >, but the values are
+ *  handled as one array rather than one at a time
+ */
+template<typename T>
+struct ScalarVectorSerializer
+{
+    static void serializeImpl(const std::vector<T>& val,
+                              bool swapBytes,
+                              std::vector<sys::byte>& buffer)
+    {
+        const size_t length = val.size();
+        Serializer<size_t>::serializeImpl(length, swapBytes, buffer);
+        if (length != 0)
+        {
+            ArraySerializer<T>::serializeImpl(&val[0], length, swapBytes,
+                                              buffer);
+        }
+    }
+
+    static void deserializeImpl(const sys::byte*& buffer,
+                                bool swapBytes,
+                                std::vector<T>& val)
+    {
+        const size_t currentVectorLength = val.size();
+        size_t length;
+        Serializer<size_t>::deserializeImpl(buffer, swapBytes, length);
+        val.resize(currentVectorLength + length);
+        if (length != 0)
+        {
+            ArraySerializer<T>::deserializeImpl(buffer, swapBytes, length,
+                                                &val[currentVectorLength]);
+        }
+    }
+};
+
+//! Meshes are made of these, so they are serialized in bulk
+template <>
+struct Serializer<std::vector<double> > : public ScalarVectorSerializer<double>
+{
+};
+
+template <>
+struct Serializer<std::vector<float> > : public ScalarVectorSerializer<float>
+{
+};
+
 /*!
  * Function interface to serialize.
  * \tparam T Data type to serialize. Argument determines which
@@ -214,5 +341,41 @@ void deserialize(const sys::byte*& buffer, bool swapBytes, T& val)
 {
     Serializer<T>::deserializeImpl(buffer, swapBytes, val);
 }
+
+/*!
+ * Function interface to serialize an array of scalars.  The length is not
+ * written.
+ * \tparam T Scalar type
+ * \param values Values to serialize
+ * \param numValues Number of values
+ * \param swapBytes Should the bytes be swapped?
+ * \param[out] buffer Byte array to serialize into
+ */
+template<typename T>
+void serializeArray(const T* values,
+                    size_t numValues,
+                    bool swapBytes,
+                    std::vector<sys::byte>& buffer)
+{
+    ArraySerializer<T>::serializeImpl(values, numValues, swapBytes, buffer);
+}
+
+/*!
+ * Function interface to deserialize an array of scalars
+ * \tparam T Scalar type
+ * \param buffer Address from which to begin deserialization. Pointer
+ *  is incremented by numValues * sizeof(T).
+ * \param swapBytes Should bytes be swapped?
+ * \param numValues Number of values
+ * \param[out] values Values to deserialize into
+ */
+template<typename T>
+void deserializeArray(const sys::byte*& buffer,
+                      bool swapBytes,
+                      size_t numValues,
+                      T* values)
+{
+    ArraySerializer<T>::deserializeImpl(buffer, swapBytes, numValues, values);
+}
 }
 #endif
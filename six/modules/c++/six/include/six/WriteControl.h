@@ -72,6 +72,24 @@ public:
      */
     static const char OPT_BUFFER_SIZE[];
 
+    /*!
+     *  Number of threads to use when preparing image data to be written.
+     *  This is just a preference, and may be ignored by an implementation
+     *  file.  Defaults to 1.
+     *
+     *  NITFWriteControl only uses it when saving from a BufferList, and
+     *  only for image segments that are written uncompressed.  Within each
+     *  such segment, the threads split up the byte swapping and copying of
+     *  the pixels, and for single-band blocked images, the blocking too.
+     *  Image segments and products are still written one after another.
+     *
+     *  It is ignored when saving from a SourceList, for J2K or otherwise
+     *  compressed images, for multi-band blocked images (all of which go
+     *  through NITRO's ImageWriter), and for legends.  LUTs are always
+     *  written out serially in the image subheader.
+     */
+    static const char OPT_NUM_THREADS[];
+
     //!  Constructor.  Null-sets the Container
     WriteControl() :
         mContainer(NULL), mLog(NULL), mOwnLog(false), mXMLRegistry(NULL)
@@ -26,6 +26,8 @@
 #include <six/Data.h>
 #include <xml/lite/Document.h>
 #include <xml/lite/Validator.h>
+#include <io/OutputStream.h>
+#include <six/XMLStreamWriter.h>
 
 namespace six
 {
@@ -74,6 +76,21 @@ class XMLControl
                          const std::vector<std::string>& schemaPaths,
                          logging::Logger* log);
 
+    /*
+     *  \func validate
+     *  \brief Validate XML text and log any errors
+     *
+     *  \param xml XML document, ideally pretty-printed so that the line
+     *  numbers in any errors are useful
+     *  \param uri Namespace URI of the root element
+     *  \param schemaPaths  Directories or files of schema locations
+     *  \param log Logs validation errors
+     */
+    static void validate(const std::string& xml,
+                         const std::string& uri,
+                         const std::vector<std::string>& schemaPaths,
+                         logging::Logger* log);
+
     /*!
      * Retrieve the proper schema paths for validation.
      * Schema paths can come from three sources, in
@@ -99,6 +116,20 @@ class XMLControl
     xml::lite::Document* toXML(const Data* data,
                                const std::vector<std::string>& schemaPaths);
 
+    /*!
+     *  Convert the Data model straight to XML, without building a DOM
+     *  where the implementation supports it.  The output is the same as
+     *  printing the DOM from toXML().  The XML is written to 'stream' as
+     *  it's generated, so if validation fails the stream already holds
+     *  the invalid document.
+     *  \param data         Data structure
+     *  \param schemaPaths  Directories or files of schema locations
+     *  \param stream       Stream to write the XML to
+     */
+    void toXML(const Data* data,
+               const std::vector<std::string>& schemaPaths,
+               io::OutputStream& stream);
+
     /*!
      *  Convert a document from a DOM into a Data model
      *  \param doc          XML Document
@@ -141,6 +172,14 @@ class XMLControl
      */
     virtual xml::lite::Document* toXMLImpl(const Data* data) = 0;
 
+    /*!
+     *  Write the Data model out as XML.  By default this builds the DOM
+     *  with toXMLImpl() and writes that out.
+     *  \param data the Data model
+     *  \param writer Writer to send the XML to
+     */
+    virtual void toXMLImpl(const Data* data, XMLStreamWriter& writer);
+
     static std::string getDefaultURI(const Data& data);
 
     static std::string getVersionFromURI(const xml::lite::Document* doc);
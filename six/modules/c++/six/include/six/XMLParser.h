@@ -28,6 +28,8 @@
 #include <logging/Logger.h>
 #include <six/Types.h>
 #include <six/Init.h>
+#include <six/NumericConversion.h>
+#include <six/XMLStreamWriter.h>
 
 namespace six
 {
@@ -45,6 +47,16 @@ public:
 
     void setLogger(logging::Logger* log, bool ownLog = false);
 
+    /*!
+     * Writes elements to 'writer' as they are created rather than building
+     * up a DOM.  The tree returned while a writer is attached only has the
+     * root element in it.
+     *
+     * \param writer Writer to use, or NULL to go back to building a DOM.
+     * Must outlive any calls made while it is attached.
+     */
+    virtual void setXMLWriter(XMLStreamWriter* writer);
+
     typedef xml::lite::Element* XMLElem;
 
 protected:
@@ -61,6 +73,11 @@ protected:
 
     XMLElem newElement(const std::string& name, XMLElem prnt = NULL) const;
 
+    /*!
+     * Creates an element and adds it to 'prnt'.  These always build a DOM,
+     * even while a writer is attached, so parsers that may be streamed
+     * should use createElement() instead.
+     */
     static
     XMLElem newElement(const std::string& name, const std::string& uri,
             XMLElem prnt = NULL);
@@ -69,6 +86,25 @@ protected:
     XMLElem newElement(const std::string& name, const std::string& uri,
             const std::string& characterData, XMLElem parent = NULL);
 
+    /*!
+     * Creates an element under 'prnt', or hands it to the attached writer
+     * if there is one.  If 'prnt' is NULL, this is the root element.
+     */
+    XMLElem createElement(const std::string& name,
+            XMLElem prnt = NULL) const;
+
+    XMLElem createElement(const std::string& name, const std::string& uri,
+            XMLElem prnt = NULL) const;
+
+    XMLElem createElement(const std::string& name, const std::string& uri,
+            const std::string& characterData, XMLElem parent = NULL) const;
+
+    //! Prefix and URI of each namespace declared on the root element
+    virtual XMLStreamWriter::Namespaces getNamespacePrefixes() const;
+
+    //! Applies getNamespacePrefixes() to a finished DOM
+    void setNamespacePrefixes(XMLElem root) const;
+
     // generic element creation methods, w/URI
     XMLElem createString(const std::string& name,
             const std::string& uri, const std::string& p = "",
@@ -134,7 +170,7 @@ protected:
     {
         try
         {
-            value = str::toType<T>(element->getCharacterData());
+            value = six::parseNumber<T>(element->getCharacterData());
         }
         catch (const except::BadCastException& ex)
         {
@@ -163,6 +199,11 @@ protected:
 
     void parseDateTime(XMLElem element, DateTime& value) const;
 
+    /*!
+     * While a writer is attached, an element is written out once something
+     * other than its descendants is created, so set its attributes before
+     * then.  The root's must be set before its first child is created.
+     */
     static
     void setAttribute(XMLElem e, const std::string& name,
                       const std::string& v, const std::string& uri = "");
@@ -183,6 +224,7 @@ private:
 
     logging::Logger* mLog;
     bool mOwnLog;
+    XMLStreamWriter* mXMLWriter;
 };
 }
 
@@ -0,0 +1,211 @@
+/* =========================================================================
+ * This file is part of six-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef __SIX_XML_STREAM_WRITER_H__
+#define __SIX_XML_STREAM_WRITER_H__
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <io/OutputStream.h>
+#include <xml/lite/Element.h>
+
+namespace six
+{
+/*!
+ * \class XMLStreamWriter
+ * \brief Writes XML elements to a stream as they are created
+ *
+ * An XMLParser with a writer attached hands each element it creates to the
+ * writer rather than adding it to its parent.  Elements are written out
+ * once they can no longer change, which is as soon as an element is created
+ * under the same parent or one of its ancestors.  Until then they may still
+ * get attributes and character data.
+ *
+ * Each child of the root goes to the stream as soon as it's closed.  Below
+ * that, a closed element's text is held by its parent, which may still get
+ * attributes, and the closed Element objects are kept until their parent is
+ * written since callers sometimes hold onto them.  So memory is bounded by
+ * the largest child of the root, not the whole document.  The output is
+ * byte-for-byte what
+ * xml::lite::Element::print() (or prettyPrint()) would produce for the
+ * equivalent DOM.
+ *
+ * The namespace prefixes that a DOM-building parser would apply at the end
+ * via xml::lite::Element::setNamespacePrefix() are passed in up front, when
+ * the root element is created.
+ */
+class XMLStreamWriter
+{
+public:
+    //! Prefix and URI of each namespace declared on the root element
+    typedef std::vector<std::pair<std::string, std::string> > Namespaces;
+
+    /*!
+     * \param stream Stream to write to.  Must outlive this object.
+     * \param formatter Indentation per level.  If empty, writes the document
+     * on one line like xml::lite::Element::print().  Otherwise, matches
+     * xml::lite::Element::prettyPrint() with this formatter.
+     */
+    XMLStreamWriter(io::OutputStream& stream,
+                    const std::string& formatter = "");
+
+    /*!
+     * Also writes the document to another stream, possibly formatted
+     * differently.  This is cheaper than writing the document twice.  Must
+     * be called before any elements are created.
+     *
+     * \param stream Stream to write to.  Must outlive this object.
+     * \param formatter Indentation per level, as in the constructor
+     */
+    void addOutput(io::OutputStream& stream, const std::string& formatter);
+
+    //! Deletes all elements created by the writer other than the root
+    ~XMLStreamWriter();
+
+    /*!
+     * Creates the root element.  The caller owns it (typically by making it
+     * a Document's root element), but must not add any attributes to it
+     * after its first child has been created.
+     *
+     * \param name Qualified name of the element
+     * \param uri Namespace URI of the element
+     * \param characterData Character data of the element
+     * \param namespaces Namespace prefixes to declare on the root.  Any
+     * element or attribute in one of these URIs is written with its prefix.
+     *
+     * \return The root element
+     */
+    xml::lite::Element* newRootElement(const std::string& name,
+                                       const std::string& uri,
+                                       const std::string& characterData,
+                                       const Namespaces& namespaces);
+
+    /*!
+     * Creates an element under 'parent', closing and writing out any
+     * elements previously created under 'parent'.
+     *
+     * \param name Qualified name of the element
+     * \param uri Namespace URI of the element
+     * \param characterData Character data of the element
+     * \param parent Parent element.  Must still be open.
+     *
+     * \return The new element.  The writer owns it.
+     *
+     * \throws except::Exception if 'parent' has already been written
+     */
+    xml::lite::Element* newElement(const std::string& name,
+                                   const std::string& uri,
+                                   const std::string& characterData,
+                                   xml::lite::Element* parent);
+
+    /*!
+     * Checks that 'element' can still be modified
+     *
+     * \throws except::Exception if 'element' has already been written
+     */
+    void checkOpen(const xml::lite::Element* element) const;
+
+    /*!
+     * Writes out the document in full.  Any elements created by the writer
+     * may no longer be used.
+     */
+    void close();
+
+    /*!
+     * Writes out a document that was built as a DOM instead
+     *
+     * \param root Root element of the document
+     */
+    void write(const xml::lite::Element& root);
+
+    //! \return The namespace URI of the root element
+    const std::string& getRootURI() const
+    {
+        return mRootURI;
+    }
+
+private:
+    struct Output
+    {
+        io::OutputStream* stream;
+        std::string formatter;
+    };
+
+    struct OpenElement
+    {
+        OpenElement() :
+            element(NULL),
+            hasChildren(false)
+        {
+        }
+
+        xml::lite::Element* element;
+
+        // Everything written so far for this element's children, per output
+        std::vector<std::string> content;
+        bool hasChildren;
+
+        // Children that have been written.  They're only deleted once this
+        // element is written too, since callers sometimes hold onto them.
+        std::vector<xml::lite::Element*> closedChildren;
+    };
+
+    // Closes elements until 'element' is the innermost open element
+    void closeUntil(const xml::lite::Element* element);
+
+    void closeTop();
+
+    void openElement(xml::lite::Element* element);
+
+    void appendIndent(size_t output, size_t depth, std::string& text) const;
+
+    // Returns the prefix declared for 'uri', or NULL if there isn't one
+    const std::string* findPrefix(const std::string& uri) const;
+
+    // Return the qualified name after applying the declared namespace
+    // prefixes
+    std::string getQName(const xml::lite::Element& element) const;
+    std::string getQName(const xml::lite::AttributeNode& attribute) const;
+
+    void appendStartTag(const xml::lite::Element& element,
+                        const std::string& qname,
+                        bool isRoot,
+                        std::string& text) const;
+
+    void writeRootStartTag();
+
+    void write(size_t output, const std::string& text);
+
+private:
+    XMLStreamWriter(const XMLStreamWriter&);
+    XMLStreamWriter& operator=(const XMLStreamWriter&);
+
+    std::vector<Output> mOutputs;
+    Namespaces mNamespaces;
+    std::string mRootURI;
+    std::vector<OpenElement> mOpen;
+    bool mRootStartTagWritten;
+};
+}
+
+#endif
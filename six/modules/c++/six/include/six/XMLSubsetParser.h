@@ -0,0 +1,119 @@
+/* =========================================================================
+ * This file is part of six-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef __SIX_XML_SUBSET_PARSER_H__
+#define __SIX_XML_SUBSET_PARSER_H__
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <io/InputStream.h>
+#include <xml/lite/Document.h>
+#include <xml/lite/MinidomHandler.h>
+#include <xml/lite/XMLReader.h>
+
+namespace six
+{
+/*!
+ * \class XMLSubsetParser
+ * \brief Builds a DOM holding only some of the root's children
+ *
+ * The resulting document has the root element (with its attributes) and
+ * only those children of the root whose local names were requested, with
+ * everything beneath them.  All other elements are dropped as they are
+ * read rather than being built and thrown away, so pulling a few blocks
+ * like CollectionInfo or GeoData out of a SICD costs little more than
+ * scanning the text.
+ */
+class XMLSubsetParser
+{
+public:
+    /*!
+     * \param elementNames Local names of the root's children to keep.  If
+     * empty, every child is kept (and this is just a MinidomParser).
+     */
+    XMLSubsetParser(const std::vector<std::string>& elementNames);
+
+    /*!
+     * Parses a document
+     *
+     * \param is Stream to read from
+     * \param size Number of bytes to read.  Defaults to the whole stream.
+     */
+    void parse(io::InputStream& is, int size = io::InputStream::IS_END);
+
+    /*!
+     * Releases the parsed document.  A new, empty document is set up for
+     * the next parse.
+     */
+    std::auto_ptr<xml::lite::Document> releaseDocument();
+
+    //! \return The parsed document, still owned by this object
+    xml::lite::Document* getDocument() const
+    {
+        return mHandler.getDocument();
+    }
+
+private:
+    class Handler : public xml::lite::MinidomHandler
+    {
+    public:
+        Handler(const std::vector<std::string>& elementNames);
+
+        virtual void characters(const char* value, int length);
+
+        virtual void startElement(const std::string& uri,
+                                  const std::string& localName,
+                                  const std::string& qname,
+                                  const xml::lite::Attributes& atts);
+
+        virtual void endElement(const std::string& uri,
+                                const std::string& localName,
+                                const std::string& qname);
+
+    private:
+        bool isKept() const
+        {
+            return mSkipDepth == 0;
+        }
+
+    private:
+        const std::set<std::string> mElementNames;
+
+        // Depth of the element currently being read (the root is 1)
+        size_t mDepth;
+
+        // Depth within a dropped subtree, or 0 when not in one
+        size_t mSkipDepth;
+    };
+
+    XMLSubsetParser(const XMLSubsetParser&);
+    XMLSubsetParser& operator=(const XMLSubsetParser&);
+
+private:
+    Handler mHandler;
+    xml::lite::XMLReader mReader;
+};
+}
+
+#endif
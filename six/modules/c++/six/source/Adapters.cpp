@@ -19,10 +19,111 @@
  * see <http://www.gnu.org/licenses/>.
  *
  */
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <math/Round.h>
+#include <mt/Runnable1D.h>
+#include <nitf/ImageBlocker.hpp>
 #include "six/Adapters.h"
 
 using namespace six;
 
+namespace
+{
+// Target size of the piece of a band given to each thread when writing
+// unblocked data
+const size_t PARALLEL_WRITE_TASK_SIZE = 4 * 1024 * 1024;
+
+/*
+ * Prepares the rows of one band of a segment for writing.  Each task is
+ * either one row of blocks or, if the segment is unblocked, a fixed number
+ * of rows.
+ */
+class PrepareBand
+{
+public:
+    PrepareBand(const UByte* input,
+                size_t bandStartRow,
+                size_t bandNumRows,
+                size_t numRowsPerTask,
+                size_t numCols,
+                size_t numChannels,
+                size_t pixelSize,
+                bool doByteSwap,
+                const nitf::ImageBlocker* blocker,
+                UByte* output) :
+        mInput(input),
+        mBandStartRow(bandStartRow),
+        mBandNumRows(bandNumRows),
+        mNumRowsPerTask(numRowsPerTask),
+        mNumCols(numCols),
+        mNumChannels(numChannels),
+        mPixelSize(pixelSize),
+        mDoByteSwap(doByteSwap),
+        mBlocker(blocker),
+        mOutput(output)
+    {
+    }
+
+    void operator()(size_t task) const
+    {
+        const size_t rowInBand = task * mNumRowsPerTask;
+        const size_t numRows =
+                std::min(mNumRowsPerTask, mBandNumRows - rowInBand);
+        const size_t rowSize = mPixelSize * mNumCols;
+        const UByte* const input = mInput + rowInBand * rowSize;
+
+        UByte* output;
+        size_t numBytes;
+        if (mBlocker)
+        {
+            // Rows of blocks are all the same size, pad included
+            numBytes = mBlocker->getNumBytesRequired(
+                    mBandStartRow + rowInBand, numRows, mPixelSize);
+            output = mOutput + task * mBlocker->getNumBytesRequired(
+                    mBandStartRow, mNumRowsPerTask, mPixelSize);
+            mBlocker->block(input, mBandStartRow + rowInBand, numRows,
+                            mPixelSize, output);
+        }
+        else
+        {
+            numBytes = numRows * rowSize;
+            output = mOutput + rowInBand * rowSize;
+            ::memcpy(output, input, numBytes);
+        }
+
+        if (mDoByteSwap)
+        {
+            const size_t elementSize = mPixelSize / mNumChannels;
+            sys::byteSwap(output, static_cast<unsigned short>(elementSize),
+                          numBytes / elementSize);
+        }
+    }
+
+private:
+    const UByte* const mInput;
+    const size_t mBandStartRow;
+    const size_t mBandNumRows;
+    const size_t mNumRowsPerTask;
+    const size_t mNumCols;
+    const size_t mNumChannels;
+    const size_t mPixelSize;
+    const bool mDoByteSwap;
+    const nitf::ImageBlocker* const mBlocker;
+    UByte* const mOutput;
+};
+}
+
+extern "C"
+{
+void __six_ParallelMemoryWriteHandler_destruct(NITF_DATA * data);
+NITF_BOOL __six_ParallelMemoryWriteHandler_write(NITF_DATA * data,
+        nitf_IOInterface* io, nitf_Error * error);
+}
+
 extern "C"
 {
 void __six_StreamWriteHandler_destruct(NITF_DATA * data);
@@ -123,6 +224,150 @@ MemoryWriteHandler::MemoryWriteHandler(const NITFSegmentInfo& info,
     setManaged(false);
 }
 
+//
+// ParallelMemoryWriteHandler
+//
+
+typedef struct _ParallelMemoryWriteHandlerImpl
+{
+    const UByte* buffer;
+    size_t firstRow;
+    size_t numCols;
+    size_t numRows;
+    size_t numChannels;
+    size_t pixelSize;
+    int doByteSwap;
+    size_t numRowsPerBlock;
+    size_t numColsPerBlock;
+    size_t numThreads;
+} ParallelMemoryWriteHandlerImpl;
+
+extern "C" void __six_ParallelMemoryWriteHandler_destruct(NITF_DATA * data)
+{
+    ParallelMemoryWriteHandlerImpl *impl =
+            (ParallelMemoryWriteHandlerImpl *) data;
+    if (impl)
+        NITF_FREE(impl);
+}
+
+extern "C" NITF_BOOL __six_ParallelMemoryWriteHandler_write(NITF_DATA * data,
+        nitf_IOInterface* io, nitf_Error * error)
+{
+    ParallelMemoryWriteHandlerImpl *impl =
+            (ParallelMemoryWriteHandlerImpl *) data;
+
+    try
+    {
+        const size_t rowSize = impl->pixelSize * impl->numCols;
+        const UByte* const segment = impl->buffer + impl->firstRow * rowSize;
+
+        std::auto_ptr<nitf::ImageBlocker> blocker;
+        size_t numRowsPerTask;
+        if (impl->numRowsPerBlock != 0 && impl->numColsPerBlock != 0)
+        {
+            blocker.reset(new nitf::ImageBlocker(impl->numRows,
+                                                 impl->numCols,
+                                                 impl->numRowsPerBlock,
+                                                 impl->numColsPerBlock));
+            numRowsPerTask = blocker->getNumRowsPerBlock()[0];
+        }
+        else
+        {
+            numRowsPerTask = std::max<size_t>(
+                    PARALLEL_WRITE_TASK_SIZE / rowSize, 1);
+        }
+
+        const size_t numRowsPerBand = numRowsPerTask * impl->numThreads;
+        std::vector<UByte> band;
+        for (size_t row = 0; row < impl->numRows; row += numRowsPerBand)
+        {
+            const size_t numRows =
+                    std::min(numRowsPerBand, impl->numRows - row);
+            const size_t numTasks =
+                    math::ceilingDivide(numRows, numRowsPerTask);
+
+            band.resize(blocker.get() ?
+                    blocker->getNumBytesRequired(row, numRows,
+                                                 impl->pixelSize) :
+                    numRows * rowSize);
+
+            mt::run1D(numTasks,
+                      std::min(impl->numThreads, numTasks),
+                      PrepareBand(segment + row * rowSize,
+                                  row,
+                                  numRows,
+                                  numRowsPerTask,
+                                  impl->numCols,
+                                  impl->numChannels,
+                                  impl->pixelSize,
+                                  impl->doByteSwap != 0,
+                                  blocker.get(),
+                                  &band[0]));
+
+            if (!nitf_IOInterface_write(io, (const sys::byte*) &band[0],
+                                        band.size(), error))
+            {
+                return NITF_FAILURE;
+            }
+        }
+    }
+    catch (const except::Exception& ex)
+    {
+        nitf_Error_init(error, ex.getMessage().c_str(), NITF_CTXT,
+                        NITF_ERR_WRITING_TO_FILE);
+        return NITF_FAILURE;
+    }
+    catch (const std::exception& ex)
+    {
+        nitf_Error_init(error, ex.what(), NITF_CTXT,
+                        NITF_ERR_WRITING_TO_FILE);
+        return NITF_FAILURE;
+    }
+
+    return NITF_SUCCESS;
+}
+
+ParallelMemoryWriteHandler::ParallelMemoryWriteHandler(
+        const NITFSegmentInfo& info, const UByte* buffer, size_t firstRow,
+        size_t numCols, size_t numChannels, size_t pixelSize,
+        bool doByteSwap, size_t numRowsPerBlock, size_t numColsPerBlock,
+        size_t numThreads)
+{
+    // Dont do it if we only have a byte!
+    if (pixelSize / numChannels == 1)
+        doByteSwap = false;
+
+    static nitf_IWriteHandler iWriteHandler =
+            { &__six_ParallelMemoryWriteHandler_write,
+              &__six_ParallelMemoryWriteHandler_destruct };
+
+    ParallelMemoryWriteHandlerImpl *impl =
+            (ParallelMemoryWriteHandlerImpl *) NITF_MALLOC(
+                    sizeof(ParallelMemoryWriteHandlerImpl));
+    if (!impl)
+        throw nitf::NITFException(Ctxt("Out of memory"));
+    impl->buffer = buffer;
+    impl->firstRow = firstRow;
+    impl->numCols = numCols;
+    impl->numRows = info.numRows;
+    impl->numChannels = numChannels;
+    impl->pixelSize = pixelSize;
+    impl->doByteSwap = doByteSwap;
+    impl->numRowsPerBlock = numRowsPerBlock;
+    impl->numColsPerBlock = numColsPerBlock;
+    impl->numThreads = std::max<size_t>(numThreads, 1);
+
+    nitf_SegmentWriter *segmentWriter =
+            (nitf_SegmentWriter *) NITF_MALLOC(sizeof(nitf_SegmentWriter));
+    if (!segmentWriter)
+        throw nitf::NITFException(Ctxt("Out of memory"));
+    segmentWriter->data = impl;
+    segmentWriter->iface = &iWriteHandler;
+
+    setNative(segmentWriter);
+    setManaged(false);
+}
+
 //
 // StreamWriteHandler
 //
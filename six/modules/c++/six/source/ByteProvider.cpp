@@ -254,4 +254,10 @@ void ByteProvider::initialize(std::auto_ptr<six::NITFHeaderCreator> headerCreato
                                    numColsPerBlock);
 }
 
+bool ByteProvider::isBlocked() const
+{
+    // Without blocking, the columns per block is the whole image
+    return mOverallNumRowsPerBlock != 0 || mNumColsPerBlock != mNumCols;
+}
+
 }
@@ -0,0 +1,230 @@
+/* =========================================================================
+ * This file is part of six-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <errno.h>
+#include <limits.h>
+
+#if !defined(WIN32)
+#include <sys/uio.h>
+#endif
+
+#include <algorithm>
+
+#include <except/Exception.h>
+#include <mt/CriticalSection.h>
+#include <sys/Err.h>
+#include <six/ByteProviderFileSink.h>
+
+#if !defined(WIN32) && !defined(IOV_MAX)
+#define IOV_MAX 16
+#endif
+
+namespace six
+{
+ByteProviderFileSink::ByteProviderFileSink(const ByteProvider& byteProvider,
+                                           const Data& data,
+                                           const std::string& pathname) :
+    mByteProvider(byteProvider),
+    mNumCols(data.getNumCols()),
+    mNumBytesPerPixel(data.getNumBytesPerPixel()),
+    mNumBytesToSwap(0),
+    mFile(pathname, sys::File::WRITE_ONLY,
+          sys::File::CREATE | sys::File::TRUNCATE)
+{
+    const size_t numBytesPerValue = mNumBytesPerPixel / data.getNumChannels();
+    if (!sys::isBigEndianSystem() && numBytesPerValue > 1)
+    {
+        mNumBytesToSwap = numBytesPerValue;
+    }
+
+    if (byteProvider.isBlocked())
+    {
+        mImageBlocker = byteProvider.getImageBlocker();
+    }
+}
+
+ByteProviderFileSink::~ByteProviderFileSink()
+{
+    for (size_t ii = 0; ii < mFreeBuffers.size(); ++ii)
+    {
+        delete mFreeBuffers[ii];
+    }
+
+    try
+    {
+        close();
+    }
+    catch (...)
+    {
+    }
+}
+
+void ByteProviderFileSink::close()
+{
+    if (mFile.isOpen())
+    {
+        mFile.close();
+    }
+}
+
+void ByteProviderFileSink::write(const void* imageData,
+                                 size_t startRow,
+                                 size_t numRows)
+{
+    // Data that's already in NITF order is written as is
+    if (mNumBytesToSwap == 0 && !mImageBlocker.get())
+    {
+        nitf::Off fileOffset;
+        nitf::NITFBufferList buffers;
+        mByteProvider.getBytes(imageData, startRow, numRows,
+                               fileOffset, buffers);
+        write(fileOffset, buffers);
+        return;
+    }
+
+    std::vector<sys::ubyte>* const buffer = acquireBuffer();
+    try
+    {
+        if (mImageBlocker.get())
+        {
+            buffer->resize(mImageBlocker->getNumBytesRequired(
+                    startRow, numRows, mNumBytesPerPixel));
+            if (!buffer->empty())
+            {
+                mImageBlocker->block(imageData, startRow, numRows,
+                                     mNumBytesPerPixel, &(*buffer)[0]);
+                if (mNumBytesToSwap != 0)
+                {
+                    sys::byteSwap(&(*buffer)[0],
+                                  static_cast<unsigned short>(mNumBytesToSwap),
+                                  buffer->size() / mNumBytesToSwap);
+                }
+            }
+        }
+        else
+        {
+            // Swap while copying
+            buffer->resize(numRows * mNumCols * mNumBytesPerPixel);
+            if (!buffer->empty())
+            {
+                sys::byteSwap(imageData,
+                              static_cast<unsigned short>(mNumBytesToSwap),
+                              buffer->size() / mNumBytesToSwap,
+                              &(*buffer)[0]);
+            }
+        }
+
+        nitf::Off fileOffset;
+        nitf::NITFBufferList buffers;
+        mByteProvider.getBytes(buffer->empty() ? NULL : &(*buffer)[0],
+                               startRow, numRows, fileOffset, buffers);
+        write(fileOffset, buffers);
+    }
+    catch (...)
+    {
+        releaseBuffer(buffer);
+        throw;
+    }
+    releaseBuffer(buffer);
+}
+
+void ByteProviderFileSink::write(nitf::Off fileOffset,
+                                 const nitf::NITFBufferList& buffers)
+{
+#if defined(WIN32)
+    mt::CriticalSection<sys::Mutex> lock(&mMutex);
+    mFile.seekTo(fileOffset, sys::File::FROM_START);
+    for (size_t ii = 0; ii < buffers.mBuffers.size(); ++ii)
+    {
+        mFile.writeFrom(buffers.mBuffers[ii].mData,
+                        buffers.mBuffers[ii].mNumBytes);
+    }
+#else
+    std::vector<struct iovec> iov;
+    iov.reserve(buffers.mBuffers.size());
+    for (size_t ii = 0; ii < buffers.mBuffers.size(); ++ii)
+    {
+        if (buffers.mBuffers[ii].mNumBytes != 0)
+        {
+            struct iovec vec;
+            vec.iov_base = const_cast<void*>(buffers.mBuffers[ii].mData);
+            vec.iov_len = buffers.mBuffers[ii].mNumBytes;
+            iov.push_back(vec);
+        }
+    }
+
+    // Usually this is a single call, but the kernel is allowed to write
+    // less than was asked for
+    size_t next = 0;
+    while (next < iov.size())
+    {
+        const int count = static_cast<int>(
+                std::min<size_t>(iov.size() - next, IOV_MAX));
+        const ssize_t numWritten = ::pwritev(mFile.getHandle(), &iov[next],
+                                             count, fileOffset);
+        if (numWritten < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw except::IOException(Ctxt(
+                    "Writing " + mFile.getPath().getPath() + " failed: " +
+                    sys::Err().toString()));
+        }
+
+        fileOffset += numWritten;
+        size_t remaining = static_cast<size_t>(numWritten);
+        while (next < iov.size() && remaining >= iov[next].iov_len)
+        {
+            remaining -= iov[next].iov_len;
+            ++next;
+        }
+        if (remaining != 0)
+        {
+            iov[next].iov_base =
+                    static_cast<sys::ubyte*>(iov[next].iov_base) + remaining;
+            iov[next].iov_len -= remaining;
+        }
+    }
+#endif
+}
+
+std::vector<sys::ubyte>* ByteProviderFileSink::acquireBuffer()
+{
+    {
+        mt::CriticalSection<sys::Mutex> lock(&mMutex);
+        if (!mFreeBuffers.empty())
+        {
+            std::vector<sys::ubyte>* const buffer = mFreeBuffers.back();
+            mFreeBuffers.pop_back();
+            return buffer;
+        }
+    }
+    return new std::vector<sys::ubyte>();
+}
+
+void ByteProviderFileSink::releaseBuffer(std::vector<sys::ubyte>* buffer)
+{
+    mt::CriticalSection<sys::Mutex> lock(&mMutex);
+    mFreeBuffers.push_back(buffer);
+}
+}
@@ -0,0 +1,219 @@
+/* =========================================================================
+ * This file is part of six-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include <mt/CriticalSection.h>
+#include <sys/Mutex.h>
+#include <sys/Thread.h>
+#include <six/Instrumentation.h>
+
+namespace
+{
+const size_t NUM_SHARDS = 16;
+
+struct Shard
+{
+    sys::Mutex mutex;
+    std::vector<six::InstrumentationCounters> counters;
+};
+
+class Registry
+{
+public:
+    size_t registerPoint(const std::string& name)
+    {
+        mt::CriticalSection<sys::Mutex> lock(&mMutex);
+        const std::vector<std::string>::const_iterator iter =
+                std::find(mNames.begin(), mNames.end(), name);
+        if (iter != mNames.end())
+        {
+            return iter - mNames.begin();
+        }
+        mNames.push_back(name);
+        return mNames.size() - 1;
+    }
+
+    void record(size_t point,
+                double elapsedMs,
+                sys::Uint64_T bytes,
+                sys::Uint64_T seeks)
+    {
+        // Thread IDs are usually addresses, so mix in the higher bits
+        const size_t id = static_cast<size_t>(sys::getThreadID());
+        Shard& shard = mShards[(id ^ (id >> 8) ^ (id >> 16)) % NUM_SHARDS];
+
+        mt::CriticalSection<sys::Mutex> lock(&shard.mutex);
+        if (point >= shard.counters.size())
+        {
+            shard.counters.resize(point + 1);
+        }
+        six::InstrumentationCounters& counters(shard.counters[point]);
+        ++counters.calls;
+        counters.elapsedMs += elapsedMs;
+        counters.maxMs = std::max(counters.maxMs, elapsedMs);
+        counters.bytes += bytes;
+        counters.seeks += seeks;
+    }
+
+    six::InstrumentationSnapshot snapshot()
+    {
+        // Holding this for the whole snapshot means no point can be
+        // registered, and so hit, that's past the end of 'totals'
+        mt::CriticalSection<sys::Mutex> lock(&mMutex);
+        std::vector<six::InstrumentationCounters> totals(mNames.size());
+        for (size_t ii = 0; ii < NUM_SHARDS; ++ii)
+        {
+            mt::CriticalSection<sys::Mutex> shardLock(&mShards[ii].mutex);
+            const std::vector<six::InstrumentationCounters>& counters =
+                    mShards[ii].counters;
+            for (size_t point = 0; point < counters.size(); ++point)
+            {
+                totals[point].add(counters[point]);
+            }
+        }
+
+        six::InstrumentationSnapshot snapshot;
+        for (size_t point = 0; point < totals.size(); ++point)
+        {
+            if (totals[point].calls != 0)
+            {
+                snapshot.points[mNames[point]] = totals[point];
+            }
+        }
+        return snapshot;
+    }
+
+    void reset()
+    {
+        for (size_t ii = 0; ii < NUM_SHARDS; ++ii)
+        {
+            mt::CriticalSection<sys::Mutex> lock(&mShards[ii].mutex);
+            mShards[ii].counters.clear();
+        }
+    }
+
+private:
+    sys::Mutex mMutex;
+    std::vector<std::string> mNames;
+    Shard mShards[NUM_SHARDS];
+};
+
+// Points are registered during static initialization, so this has to be
+// constructed on first use
+Registry& getRegistry()
+{
+    static Registry registry;
+    return registry;
+}
+}
+
+namespace six
+{
+InstrumentationCounters::InstrumentationCounters() :
+    calls(0),
+    elapsedMs(0),
+    maxMs(0),
+    bytes(0),
+    seeks(0)
+{
+}
+
+void InstrumentationCounters::add(const InstrumentationCounters& other)
+{
+    calls += other.calls;
+    elapsedMs += other.elapsedMs;
+    maxMs = std::max(maxMs, other.maxMs);
+    bytes += other.bytes;
+    seeks += other.seeks;
+}
+
+std::ostream& operator<<(std::ostream& os,
+                         const InstrumentationSnapshot& snapshot)
+{
+    for (std::map<std::string, InstrumentationCounters>::const_iterator iter =
+                 snapshot.points.begin();
+         iter != snapshot.points.end();
+         ++iter)
+    {
+        const InstrumentationCounters& counters(iter->second);
+        os << iter->first
+           << " calls=" << counters.calls
+           << " elapsed_ms=" << counters.elapsedMs
+           << " max_ms=" << counters.maxMs
+           << " bytes=" << counters.bytes
+           << " seeks=" << counters.seeks << "\n";
+    }
+    return os;
+}
+
+std::atomic<bool> Instrumentation::mEnabled(false);
+
+void Instrumentation::enable(bool enabled)
+{
+    mEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+size_t Instrumentation::registerPoint(const std::string& name)
+{
+    return getRegistry().registerPoint(name);
+}
+
+void Instrumentation::record(size_t point,
+                             double elapsedMs,
+                             sys::Uint64_T bytes,
+                             sys::Uint64_T seeks)
+{
+    getRegistry().record(point, elapsedMs, bytes, seeks);
+}
+
+InstrumentationSnapshot Instrumentation::snapshot()
+{
+    return getRegistry().snapshot();
+}
+
+void Instrumentation::reset()
+{
+    getRegistry().reset();
+}
+
+InstrumentationTimer::InstrumentationTimer(size_t point, sys::Uint64_T bytes) :
+    mPoint(point),
+    mEnabled(Instrumentation::isEnabled()),
+    mBytes(bytes),
+    mSeeks(0)
+{
+    if (mEnabled)
+    {
+        mStopWatch.start();
+    }
+}
+
+InstrumentationTimer::~InstrumentationTimer()
+{
+    if (mEnabled)
+    {
+        Instrumentation::record(mPoint, mStopWatch.stop(), mBytes, mSeeks);
+    }
+}
+}
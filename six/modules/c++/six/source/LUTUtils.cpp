@@ -0,0 +1,380 @@
+/* =========================================================================
+ * This file is part of six-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <string.h>
+
+#include <algorithm>
+#include <utility>
+
+#include <except/Exception.h>
+#include <str/Convert.h>
+#include <mt/ThreadPlanner.h>
+#include <mt/Runnable1D.h>
+#include <six/LUTUtils.h>
+
+namespace
+{
+// Pixels per unit of work handed to a thread.  Large enough that the
+// per-chunk overhead disappears, small enough to balance across threads.
+const size_t PIXELS_PER_CHUNK = 64 * 1024;
+
+size_t getNumChunks(size_t numPixels)
+{
+    return (numPixels + PIXELS_PER_CHUNK - 1) / PIXELS_PER_CHUNK;
+}
+
+/*
+ * All LUT kernels work on a full 256-entry table so that no index needs to
+ * be range checked in the inner loop.  Entries past the end of the LUT are
+ * zero.
+ */
+template <typename EntryT>
+std::vector<EntryT> makeTable(const six::LUT& lut)
+{
+    std::vector<EntryT> table(256, 0);
+    for (size_t ii = 0; ii < lut.numEntries; ++ii)
+    {
+        ::memcpy(&table[ii], lut[ii], lut.elementSize);
+    }
+    return table;
+}
+
+/*
+ * Fixed-width entries (1, 2, or 4 bytes) are a straight gather.
+ */
+template <typename EntryT>
+class ExpandFixed
+{
+public:
+    ExpandFixed(const six::UByte* input,
+                size_t numPixels,
+                const std::vector<EntryT>& table,
+                six::UByte* output) :
+        mInput(input),
+        mNumPixels(numPixels),
+        mTable(&table[0]),
+        mOutput(reinterpret_cast<EntryT*>(output))
+    {
+    }
+
+    void operator()(size_t chunk) const
+    {
+        const size_t start = chunk * PIXELS_PER_CHUNK;
+        const size_t end = std::min(start + PIXELS_PER_CHUNK, mNumPixels);
+
+        const six::UByte* const input = mInput;
+        const EntryT* const table = mTable;
+        EntryT* const output = mOutput;
+        for (size_t ii = start; ii < end; ++ii)
+        {
+            output[ii] = table[input[ii]];
+        }
+    }
+
+private:
+    const six::UByte* const mInput;
+    const size_t mNumPixels;
+    const EntryT* const mTable;
+    EntryT* const mOutput;
+};
+
+/*
+ * RGB entries are stored padded out to 32 bits (in memory order, so this is
+ * endian-independent).  Each pixel is written with a single unaligned 32-bit
+ * store and the output pointer advances by three, so the pad byte is
+ * overwritten by the next pixel.  The final pixel of each chunk is written
+ * with a 3-byte copy so we never write past the end of the chunk.
+ */
+class ExpandRGB
+{
+public:
+    ExpandRGB(const six::UByte* input,
+              size_t numPixels,
+              const std::vector<sys::Uint32_T>& table,
+              six::UByte* output) :
+        mInput(input),
+        mNumPixels(numPixels),
+        mTable(&table[0]),
+        mOutput(output)
+    {
+    }
+
+    void operator()(size_t chunk) const
+    {
+        const size_t start = chunk * PIXELS_PER_CHUNK;
+        const size_t end = std::min(start + PIXELS_PER_CHUNK, mNumPixels);
+        if (start == end)
+        {
+            return;
+        }
+
+        const six::UByte* const input = mInput;
+        const sys::Uint32_T* const table = mTable;
+        six::UByte* output = mOutput + start * 3;
+
+        size_t ii = start;
+        for (; ii + 4 <= end; ii += 4, output += 12)
+        {
+            const sys::Uint32_T p0 = table[input[ii]];
+            const sys::Uint32_T p1 = table[input[ii + 1]];
+            const sys::Uint32_T p2 = table[input[ii + 2]];
+            const sys::Uint32_T p3 = table[input[ii + 3]];
+            ::memcpy(output, &p0, 4);
+            ::memcpy(output + 3, &p1, 4);
+            ::memcpy(output + 6, &p2, 4);
+            if (ii + 4 < end)
+            {
+                ::memcpy(output + 9, &p3, 4);
+            }
+            else
+            {
+                ::memcpy(output + 9, &p3, 3);
+            }
+        }
+        for (; ii < end; ++ii, output += 3)
+        {
+            ::memcpy(output, &table[input[ii]], 3);
+        }
+    }
+
+private:
+    const six::UByte* const mInput;
+    const size_t mNumPixels;
+    const sys::Uint32_T* const mTable;
+    six::UByte* const mOutput;
+};
+
+class ExpandGeneric
+{
+public:
+    ExpandGeneric(const six::UByte* input,
+                  size_t numPixels,
+                  const six::LUT& lut,
+                  six::UByte* output) :
+        mInput(input),
+        mNumPixels(numPixels),
+        mElementSize(lut.elementSize),
+        mTable(256 * lut.elementSize, 0),
+        mOutput(output)
+    {
+        std::copy(lut.table.begin(), lut.table.end(), mTable.begin());
+    }
+
+    void operator()(size_t chunk) const
+    {
+        const size_t start = chunk * PIXELS_PER_CHUNK;
+        const size_t end = std::min(start + PIXELS_PER_CHUNK, mNumPixels);
+
+        for (size_t ii = start; ii < end; ++ii)
+        {
+            ::memcpy(mOutput + ii * mElementSize,
+                     &mTable[mInput[ii] * mElementSize],
+                     mElementSize);
+        }
+    }
+
+private:
+    const six::UByte* const mInput;
+    const size_t mNumPixels;
+    const size_t mElementSize;
+    std::vector<six::UByte> mTable;
+    six::UByte* const mOutput;
+};
+
+class ApplyInverse
+{
+public:
+    ApplyInverse(const sys::Uint16_T* input,
+                 size_t numPixels,
+                 const six::UByte* table,
+                 six::UByte* output) :
+        mInput(input),
+        mNumPixels(numPixels),
+        mTable(table),
+        mOutput(output)
+    {
+    }
+
+    void operator()(size_t chunk) const
+    {
+        const size_t start = chunk * PIXELS_PER_CHUNK;
+        const size_t end = std::min(start + PIXELS_PER_CHUNK, mNumPixels);
+
+        const sys::Uint16_T* const input = mInput;
+        const six::UByte* const table = mTable;
+        six::UByte* const output = mOutput;
+        for (size_t ii = start; ii < end; ++ii)
+        {
+            output[ii] = table[input[ii]];
+        }
+    }
+
+private:
+    const sys::Uint16_T* const mInput;
+    const size_t mNumPixels;
+    const six::UByte* const mTable;
+    six::UByte* const mOutput;
+};
+}
+
+namespace six
+{
+void applyLUT(const UByte* input,
+              size_t numPixels,
+              const LUT& lut,
+              size_t numThreads,
+              UByte* output)
+{
+    if (lut.numEntries > 256)
+    {
+        throw except::Exception(Ctxt(
+                "Cannot index a LUT with " + str::toString(lut.numEntries) +
+                " entries with 8-bit pixels"));
+    }
+    if (lut.elementSize == 0)
+    {
+        throw except::Exception(Ctxt("LUT has no output space"));
+    }
+    if (numPixels == 0)
+    {
+        return;
+    }
+
+    const size_t numChunks = getNumChunks(numPixels);
+    switch (lut.elementSize)
+    {
+    case 1:
+    {
+        const std::vector<sys::Uint8_T> table(makeTable<sys::Uint8_T>(lut));
+        mt::run1D(numChunks, numThreads,
+                  ExpandFixed<sys::Uint8_T>(input, numPixels, table, output));
+        break;
+    }
+    case 2:
+    {
+        const std::vector<sys::Uint16_T> table(makeTable<sys::Uint16_T>(lut));
+        mt::run1D(numChunks, numThreads,
+                  ExpandFixed<sys::Uint16_T>(input, numPixels, table, output));
+        break;
+    }
+    case 3:
+    {
+        const std::vector<sys::Uint32_T> table(makeTable<sys::Uint32_T>(lut));
+        mt::run1D(numChunks, numThreads,
+                  ExpandRGB(input, numPixels, table, output));
+        break;
+    }
+    case 4:
+    {
+        const std::vector<sys::Uint32_T> table(makeTable<sys::Uint32_T>(lut));
+        mt::run1D(numChunks, numThreads,
+                  ExpandFixed<sys::Uint32_T>(input, numPixels, table, output));
+        break;
+    }
+    default:
+        mt::run1D(numChunks, numThreads,
+                  ExpandGeneric(input, numPixels, lut, output));
+    }
+}
+
+const size_t InverseLUT::NUM_VALUES;
+
+InverseLUT::InverseLUT(const LUT& lut) :
+    mTable(NUM_VALUES, 0)
+{
+    if (lut.elementSize != sizeof(sys::Uint16_T))
+    {
+        throw except::Exception(Ctxt(
+                "Can only invert LUTs with 16-bit entries, not " +
+                str::toString(lut.elementSize) + "-byte entries"));
+    }
+    if (lut.numEntries == 0 || lut.numEntries > 256)
+    {
+        throw except::Exception(Ctxt(
+                "Cannot invert a LUT with " + str::toString(lut.numEntries) +
+                " entries"));
+    }
+
+    // Sort the entries by value, keeping only the lowest index for
+    // duplicate values
+    std::vector<std::pair<size_t, size_t> > entries(lut.numEntries);
+    for (size_t ii = 0; ii < lut.numEntries; ++ii)
+    {
+        sys::Uint16_T value;
+        ::memcpy(&value, lut[ii], sizeof(value));
+        entries[ii] = std::make_pair(static_cast<size_t>(value), ii);
+    }
+    std::sort(entries.begin(), entries.end());
+
+    std::vector<std::pair<size_t, size_t> > unique;
+    for (size_t ii = 0; ii < entries.size(); ++ii)
+    {
+        if (unique.empty() || unique.back().first != entries[ii].first)
+        {
+            unique.push_back(entries[ii]);
+        }
+    }
+
+    // Sweep through every possible value, advancing to the next entry once
+    // it is at least as close as the current one
+    size_t current = 0;
+    for (size_t value = 0; value < NUM_VALUES; ++value)
+    {
+        while (current + 1 < unique.size())
+        {
+            const size_t thisValue = unique[current].first;
+            const size_t nextValue = unique[current + 1].first;
+            if (value >= nextValue)
+            {
+                ++current;
+                continue;
+            }
+            if (value > thisValue)
+            {
+                const size_t thisDist = value - thisValue;
+                const size_t nextDist = nextValue - value;
+                if (nextDist < thisDist ||
+                    (nextDist == thisDist &&
+                     unique[current + 1].second < unique[current].second))
+                {
+                    ++current;
+                    continue;
+                }
+            }
+            break;
+        }
+        mTable[value] = static_cast<UByte>(unique[current].second);
+    }
+}
+
+void InverseLUT::apply(const sys::Uint16_T* input,
+                       size_t numPixels,
+                       size_t numThreads,
+                       UByte* output) const
+{
+    if (numPixels == 0)
+    {
+        return;
+    }
+    mt::run1D(getNumChunks(numPixels), numThreads,
+              ApplyInverse(input, numPixels, &mTable[0], output));
+}
+}
@@ -0,0 +1,308 @@
+/* =========================================================================
+ * This file is part of six-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <except/Exception.h>
+#include <io/FileInputStream.h>
+#include <str/Manip.h>
+#include <six/NITFMetadataReader.h>
+#include <six/NITFReadControl.h>
+#include <six/NumericConversion.h>
+#include <six/Utilities.h>
+#include <six/XMLSubsetParser.h>
+
+namespace
+{
+// NITF 2.1 file header layout up through HL.  FHDR and FVER together are
+// the first 9 bytes.
+const size_t FILE_VERSION_LENGTH = 9;
+const size_t HL_OFFSET = 354;
+const size_t HL_LENGTH = 6;
+const size_t NUMI_OFFSET = HL_OFFSET + HL_LENGTH;
+
+// Lengths of the segment counts and the subheader/data lengths that follow
+// each of them in the file header
+const size_t NUM_SEGMENTS_LENGTH = 3;
+const size_t LISH_LENGTH = 6;
+const size_t LI_LENGTH = 10;
+const size_t LSSH_LENGTH = 4;
+const size_t LS_LENGTH = 6;
+const size_t LTSH_LENGTH = 4;
+const size_t LT_LENGTH = 5;
+const size_t LDSH_LENGTH = 4;
+const size_t LD_LENGTH = 9;
+
+// NITF 2.1 DES subheader layout
+const size_t DESID_OFFSET = 2;
+const size_t DESID_LENGTH = 25;
+const size_t DESSHL_OFFSET = 196;
+const size_t DESSHL_LENGTH = 4;
+const size_t DESSHF_OFFSET = DESSHL_OFFSET + DESSHL_LENGTH;
+
+// TRE_OVERFLOW DESs have DESOFLW and DESITEM before DESSHL.  They're never
+// SICD/SIDD DESs so there's no need to read them.
+const char TRE_OVERFLOW_DESID[] = "TRE_OVERFLOW";
+
+// DESSHSI within the XML_DATA_CONTENT subheader fields
+const size_t DESSHSI_OFFSET = 73;
+const size_t DESSHSI_LENGTH = 60;
+
+// Reads the fields of a NITF header in order
+class FieldParser
+{
+public:
+    FieldParser(const std::vector<sys::byte>& buffer, size_t offset) :
+        mBuffer(buffer),
+        mOffset(offset)
+    {
+    }
+
+    std::string getString(size_t length)
+    {
+        if (mOffset + length > mBuffer.size())
+        {
+            throw except::Exception(Ctxt("NITF header is truncated"));
+        }
+
+        const std::string value(&mBuffer[mOffset], length);
+        mOffset += length;
+        return value;
+    }
+
+    sys::Uint64_T getNumber(size_t length)
+    {
+        const std::string value = getString(length);
+        try
+        {
+            return six::parseNumber<sys::Uint64_T>(value);
+        }
+        catch (const except::Exception& ex)
+        {
+            throw except::Exception(ex, Ctxt(
+                    "Invalid NITF header field '" + value + "'"));
+        }
+    }
+
+    void skip(size_t length)
+    {
+        mOffset += length;
+    }
+
+private:
+    const std::vector<sys::byte>& mBuffer;
+    size_t mOffset;
+};
+
+// Adds up the subheader and data lengths of one type of segment
+sys::Uint64_T sumSegmentLengths(FieldParser& parser,
+                                size_t subheaderLengthLength,
+                                size_t dataLengthLength)
+{
+    const sys::Uint64_T numSegments = parser.getNumber(NUM_SEGMENTS_LENGTH);
+    sys::Uint64_T total = 0;
+    for (sys::Uint64_T ii = 0; ii < numSegments; ++ii)
+    {
+        total += parser.getNumber(subheaderLengthLength);
+        total += parser.getNumber(dataLengthLength);
+    }
+    return total;
+}
+}
+
+namespace six
+{
+NITFMetadataReader::NITFMetadataReader(const std::string& pathname) :
+    mInStream(new io::FileInputStream(pathname)),
+    mDataType(DataType::NOT_SET)
+{
+    initialize();
+}
+
+NITFMetadataReader::NITFMetadataReader(
+        mem::SharedPtr<io::SeekableInputStream> inStream) :
+    mInStream(inStream),
+    mDataType(DataType::NOT_SET)
+{
+    initialize();
+}
+
+void NITFMetadataReader::initialize()
+{
+    // Everything up through HL, then the rest of the file header
+    std::vector<sys::byte> fileHeader;
+    readAt(0, NUMI_OFFSET, fileHeader);
+
+    const std::string version(&fileHeader[0], FILE_VERSION_LENGTH);
+    if (version != "NITF02.10" && version != "NSIF01.00")
+    {
+        throw except::Exception(Ctxt(
+                "Expected a NITF 2.1 or NSIF 1.0 file but got '" +
+                version + "'"));
+    }
+
+    const sys::Uint64_T headerLength =
+            FieldParser(fileHeader, HL_OFFSET).getNumber(HL_LENGTH);
+    if (headerLength < NUMI_OFFSET)
+    {
+        throw except::Exception(Ctxt("Invalid NITF header length"));
+    }
+    readAt(0, static_cast<size_t>(headerLength), fileHeader);
+
+    // The segments are laid out in the same order as they appear in the
+    // file header.  Reserved extension segments (NUMRES) come after the
+    // DESs so we don't need them.
+    FieldParser parser(fileHeader, NUMI_OFFSET);
+    sys::Uint64_T offset = headerLength;
+    offset += sumSegmentLengths(parser, LISH_LENGTH, LI_LENGTH);
+    offset += sumSegmentLengths(parser, LSSH_LENGTH, LS_LENGTH);
+
+    // NUMX is reserved and has no lengths after it
+    parser.skip(NUM_SEGMENTS_LENGTH);
+
+    offset += sumSegmentLengths(parser, LTSH_LENGTH, LT_LENGTH);
+
+    const sys::Uint64_T numDES = parser.getNumber(NUM_SEGMENTS_LENGTH);
+    std::vector<sys::byte> subheader;
+    for (sys::Uint64_T ii = 0; ii < numDES; ++ii)
+    {
+        const size_t subheaderLength =
+                static_cast<size_t>(parser.getNumber(LDSH_LENGTH));
+        const size_t dataLength =
+                static_cast<size_t>(parser.getNumber(LD_LENGTH));
+
+        readAt(static_cast<sys::Off_T>(offset), subheaderLength, subheader);
+
+        FieldParser desParser(subheader, DESID_OFFSET);
+        std::string desid = desParser.getString(DESID_LENGTH);
+        str::trim(desid);
+
+        // Older SICD_XML/SIDD_XML DESs may have no user-defined subheader
+        // at all, so only look for DESSHSI if there is room for it
+        sys::Uint64_T desshl = 0;
+        std::string desshsi;
+        if (desid != TRE_OVERFLOW_DESID && subheader.size() >= DESSHF_OFFSET)
+        {
+            desshl = FieldParser(subheader, DESSHL_OFFSET).getNumber(
+                    DESSHL_LENGTH);
+            if (desshl >= DESSHSI_OFFSET + DESSHSI_LENGTH)
+            {
+                desshsi = FieldParser(
+                        subheader, DESSHF_OFFSET + DESSHSI_OFFSET).getString(
+                                DESSHSI_LENGTH);
+                str::trim(desshsi);
+            }
+        }
+
+        // As with NITFReadControl, the TRE tag of the user-defined
+        // subheader is the DESID
+        const DataType dataType = NITFReadControl::getDataType(
+                desid, desshl, desshsi, desid);
+        if (ii == 0)
+        {
+            mDataType = dataType;
+        }
+
+        if (dataType != DataType::NOT_SET)
+        {
+            DESInfo info;
+            info.dataType = dataType;
+            info.dataOffset = static_cast<sys::Off_T>(offset +
+                                                      subheaderLength);
+            info.dataLength = dataLength;
+            mDESs.push_back(info);
+        }
+
+        offset += subheaderLength + dataLength;
+    }
+}
+
+void NITFMetadataReader::readAt(sys::Off_T offset,
+                                size_t numBytes,
+                                std::vector<sys::byte>& buffer) const
+{
+    buffer.resize(numBytes);
+    if (numBytes != 0)
+    {
+        mInStream->seek(offset, io::Seekable::START);
+        mInStream->read(&buffer[0], numBytes, true);
+    }
+}
+
+const NITFMetadataReader::DESInfo&
+NITFMetadataReader::getDES(size_t index) const
+{
+    if (index >= mDESs.size())
+    {
+        throw except::Exception(Ctxt(
+                "XML index " + str::toString(index) + " is out of bounds"));
+    }
+    return mDESs[index];
+}
+
+DataType NITFMetadataReader::getDataType(size_t index) const
+{
+    return getDES(index).dataType;
+}
+
+std::string NITFMetadataReader::getXML(size_t index) const
+{
+    const DESInfo& info(getDES(index));
+    std::vector<sys::byte> buffer;
+    readAt(info.dataOffset, info.dataLength, buffer);
+    return buffer.empty() ? std::string() :
+            std::string(&buffer[0], buffer.size());
+}
+
+std::auto_ptr<xml::lite::Document> NITFMetadataReader::getXMLDocument(
+        size_t index,
+        const std::vector<std::string>& elementNames) const
+{
+    const DESInfo& info(getDES(index));
+    mInStream->seek(info.dataOffset, io::Seekable::START);
+
+    XMLSubsetParser parser(elementNames);
+    try
+    {
+        parser.parse(*mInStream, static_cast<int>(info.dataLength));
+    }
+    catch (const except::Throwable& ex)
+    {
+        throw except::Exception(ex, Ctxt("Invalid XML data"));
+    }
+    return parser.releaseDocument();
+}
+
+std::auto_ptr<Data> NITFMetadataReader::getData(
+        size_t index,
+        const XMLControlRegistry& xmlRegistry,
+        const std::vector<std::string>& schemaPaths,
+        logging::Logger& log) const
+{
+    // Same as what NITFReadControl::load() does with each DES
+    const std::string xml = getXML(index);
+    std::auto_ptr<Data> data(parseDataFromString(
+            xmlRegistry, xml, mDataType, schemaPaths, log));
+    if (data.get() == NULL)
+    {
+        throw except::Exception(Ctxt("Unable to transform XML DES"));
+    }
+    return data;
+}
+}
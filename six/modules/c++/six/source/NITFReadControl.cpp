@@ -20,14 +20,28 @@
  *
  */
 
+#include <string.h>
+
 #include <sstream>
 
+#include <math/Round.h>
+#include <mt/Runnable1D.h>
+#include <six/Instrumentation.h>
 #include <six/NITFReadControl.h>
 #include <six/XMLControlFactory.h>
 #include <six/Utilities.h>
 
 namespace
 {
+const size_t LOAD_POINT =
+        six::Instrumentation::registerPoint("six::NITFReadControl::load");
+const size_t READ_RECORD_POINT = six::Instrumentation::registerPoint(
+        "six::NITFReadControl::readRecord");
+const size_t PARSE_XML_POINT =
+        six::Instrumentation::registerPoint("six::NITFReadControl::parseXML");
+const size_t INTERLEAVED_POINT = six::Instrumentation::registerPoint(
+        "six::NITFReadControl::interleaved");
+
 types::RowCol<size_t> parseILOC(const std::string& str)
 {
     // First 5 digits are the row
@@ -38,6 +52,152 @@ types::RowCol<size_t> parseILOC(const std::string& str)
     return iLoc;
 }
 
+// Output rows of a reduced-resolution read that all come from the same row
+// of blocks in one image segment
+struct ReducedChunk
+{
+    size_t segment;
+
+    // First full resolution row to read, relative to the segment.  Every
+    // skip'th row after it is kept.
+    size_t startRow;
+
+    // Number of reduced resolution rows to read
+    size_t numRows;
+
+    // First reduced resolution row in the output buffer
+    size_t outputRow;
+};
+
+/*
+ * Reads chunks of a reduced-resolution region.  If a pathname is provided,
+ * each copy of this functor lazily opens its own reader on the file so that
+ * threads aren't contending for the same file position.
+ */
+class ReadReducedChunks
+{
+public:
+    ReadReducedChunks(const std::vector<ReducedChunk>& chunks,
+                      nitf::Reader reader,
+                      const std::string& pathname,
+                      const std::map<std::string, void*>& compressionOptions,
+                      size_t startIndex,
+                      size_t startCol,
+                      size_t numCols,
+                      size_t skip,
+                      size_t numBytesPerPixel,
+                      nitf::Uint8* buffer) :
+        mChunks(chunks),
+        mReader(reader),
+        mPathname(pathname),
+        mCompressionOptions(compressionOptions),
+        mStartIndex(startIndex),
+        mStartCol(startCol),
+        mNumCols(numCols),
+        mSkip(skip),
+        mNumBytesPerPixel(numBytesPerPixel),
+        mBuffer(buffer)
+    {
+    }
+
+    void operator()(size_t chunkNum) const
+    {
+        const ReducedChunk& chunk = mChunks[chunkNum];
+
+        // Read from the first to the last kept pixel at full resolution.
+        // NITRO's own pixel skipping is avoided as it overruns its pad
+        // buffer when the skip extends past the edge of the image.
+        const size_t numRowsFull = (chunk.numRows - 1) * mSkip + 1;
+        const size_t numColsFull = (mNumCols - 1) * mSkip + 1;
+
+        nitf::Uint32 bandList(0);
+        nitf::SubWindow sw;
+        sw.setStartRow(static_cast<nitf::Uint32>(chunk.startRow));
+        sw.setNumRows(static_cast<nitf::Uint32>(numRowsFull));
+        sw.setStartCol(static_cast<nitf::Uint32>(mStartCol));
+        sw.setNumCols(static_cast<nitf::Uint32>(numColsFull));
+        sw.setNumBands(1);
+        sw.setBandList(&bandList);
+
+        nitf::ImageReader imageReader = getReader().newImageReader(
+                static_cast<int>(mStartIndex + chunk.segment),
+                mCompressionOptions);
+
+        nitf::Uint8* const output =
+                mBuffer + chunk.outputRow * mNumCols * mNumBytesPerPixel;
+        if (mSkip == 1)
+        {
+            nitf::Uint8* bufferPtr = output;
+            int padded;
+            imageReader.read(sw, &bufferPtr, &padded);
+            return;
+        }
+
+        mScratch.resize(numRowsFull * numColsFull * mNumBytesPerPixel);
+        nitf::Uint8* bufferPtr = &mScratch[0];
+        int padded;
+        imageReader.read(sw, &bufferPtr, &padded);
+
+        const size_t inRowStride = mSkip * numColsFull * mNumBytesPerPixel;
+        const size_t inColStride = mSkip * mNumBytesPerPixel;
+        const nitf::Uint8* inRow = &mScratch[0];
+        nitf::Uint8* out = output;
+        for (size_t row = 0; row < chunk.numRows; ++row, inRow += inRowStride)
+        {
+            const nitf::Uint8* in = inRow;
+            for (size_t col = 0;
+                 col < mNumCols;
+                 ++col, in += inColStride, out += mNumBytesPerPixel)
+            {
+                ::memcpy(out, in, mNumBytesPerPixel);
+            }
+        }
+    }
+
+private:
+    struct FileReader
+    {
+        FileReader(const std::string& pathname) :
+            handle(new nitf::IOHandle(pathname))
+        {
+            record = reader.readIO(*handle);
+        }
+
+        mem::SharedPtr<nitf::IOInterface> handle;
+        nitf::Reader reader;
+        nitf::Record record;
+    };
+
+    nitf::Reader& getReader() const
+    {
+        if (mPathname.empty())
+        {
+            return mReader;
+        }
+
+        if (mFileReader.get() == NULL)
+        {
+            mFileReader.reset(new FileReader(mPathname));
+        }
+        return mFileReader->reader;
+    }
+
+private:
+    const std::vector<ReducedChunk>& mChunks;
+    mutable nitf::Reader mReader;
+    const std::string mPathname;
+    const std::map<std::string, void*>& mCompressionOptions;
+    const size_t mStartIndex;
+    const size_t mStartCol;
+    const size_t mNumCols;
+    const size_t mSkip;
+    const size_t mNumBytesPerPixel;
+    nitf::Uint8* const mBuffer;
+
+    mutable mem::SharedPtr<FileReader> mFileReader;
+    mutable std::vector<nitf::Uint8> mScratch;
+};
+
 void assignLUT(nitf::ImageSubheader& subheader, six::Legend& legend)
 {
     nitf::LookupTable lut =
@@ -241,6 +401,7 @@ void NITFReadControl::load(const std::string& fromFile,
 {
     mem::SharedPtr<nitf::IOInterface> handle(new nitf::IOHandle(fromFile));
     load(handle, schemaPaths);
+    mPathname = fromFile;
 }
 
 void NITFReadControl::load(io::SeekableInputStream& stream,
@@ -258,10 +419,14 @@ void NITFReadControl::load(mem::SharedPtr<nitf::IOInterface> ioInterface)
 void NITFReadControl::load(mem::SharedPtr<nitf::IOInterface> ioInterface,
                            const std::vector<std::string>& schemaPaths)
 {
+    InstrumentationTimer timer(LOAD_POINT);
     reset();
     mInterface = ioInterface;
 
-    mRecord = mReader.readIO(*ioInterface);
+    {
+        InstrumentationTimer recordTimer(READ_RECORD_POINT);
+        mRecord = mReader.readIO(*ioInterface);
+    }
     const DataType dataType = getDataType(mRecord);
     mContainer.reset(new Container(dataType));
 
@@ -282,11 +447,16 @@ void NITFReadControl::load(mem::SharedPtr<nitf::IOInterface> ioInterface,
         else
         {
             SegmentInputStreamAdapter ioAdapter(deReader);
-            std::auto_ptr<Data> data(parseData(*mXMLRegistry,
-                                               ioAdapter,
-                                               dataType,
-                                               schemaPaths,
-                                               *mLog));
+            std::auto_ptr<Data> data;
+            {
+                InstrumentationTimer xmlTimer(PARSE_XML_POINT,
+                                              subheader.getDataLength());
+                data.reset(parseData(*mXMLRegistry,
+                                     ioAdapter,
+                                     dataType,
+                                     schemaPaths,
+                                     *mLog).release());
+            }
             if (data.get() == NULL)
             {
                 throw except::Exception(Ctxt("Unable to transform XML DES"));
@@ -639,6 +809,7 @@ UByte* NITFReadControl::interleaved(Region& region, size_t imageNumber)
 
     size_t subWindowSize = numRowsReq * numColsReq
             * thisImage->getData()->getNumBytesPerPixel();
+    InstrumentationTimer timer(INTERLEAVED_POINT, subWindowSize);
 
     if (buffer == NULL)
     {
@@ -711,6 +882,239 @@ UByte* NITFReadControl::interleaved(Region& region, size_t imageNumber)
     return buffer;
 }
 
+UByte* NITFReadControl::interleavedReduced(Region& region,
+                                           size_t imageNumber,
+                                           size_t resolutionLevel,
+                                           size_t numThreads)
+{
+    if (imageNumber >= mInfos.size())
+    {
+        throw except::Exception(Ctxt(
+                "Image " + str::toString(imageNumber) + " is out of bounds"));
+    }
+    if (resolutionLevel >= 32)
+    {
+        throw except::Exception(Ctxt(
+                "Invalid resolution level " + str::toString(resolutionLevel)));
+    }
+
+    NITFImageInfo* const thisImage = mInfos[imageNumber];
+    const size_t numRowsTotal = thisImage->getData()->getNumRows();
+    const size_t numColsTotal = thisImage->getData()->getNumCols();
+
+    if (region.getNumRows() == -1)
+    {
+        region.setNumRows(numRowsTotal);
+    }
+    if (region.getNumCols() == -1)
+    {
+        region.setNumCols(numColsTotal);
+    }
+
+    const size_t startRow = region.getStartRow();
+    const size_t startCol = region.getStartCol();
+    const size_t numRowsReq = region.getNumRows();
+    const size_t numColsReq = region.getNumCols();
+
+    if (numRowsReq == 0 || startRow + numRowsReq > numRowsTotal)
+    {
+        throw except::Exception(Ctxt(FmtX("Too many rows requested [%d]",
+                                          numRowsReq)));
+    }
+    if (numColsReq == 0 || startCol + numColsReq > numColsTotal)
+    {
+        throw except::Exception(Ctxt(FmtX("Too many cols requested [%d]",
+                                          numColsReq)));
+    }
+
+    const size_t skip = static_cast<size_t>(1) << resolutionLevel;
+    const size_t numRowsOut = math::ceilingDivide(numRowsReq, skip);
+    const size_t numColsOut = math::ceilingDivide(numColsReq, skip);
+    const size_t regionEndRow = startRow + numRowsReq;
+
+    // Break the output rows up by segment and row of blocks so that no
+    // block is decompressed by more than one chunk.  Rows of blocks without
+    // any kept rows are never read.
+    const std::vector<NITFSegmentInfo> imageSegments =
+            thisImage->getImageSegments();
+    const size_t startIndex = thisImage->getStartIndex();
+    nitf::List images = mRecord.getImages();
+
+    std::vector<ReducedChunk> chunks;
+    size_t row = startRow;
+    for (size_t seg = 0; seg < imageSegments.size() && row < regionEndRow; ++seg)
+    {
+        const NITFSegmentInfo& segInfo = imageSegments[seg];
+        if (row >= segInfo.endRow())
+        {
+            continue;
+        }
+
+        nitf::ImageSubheader subheader =
+                nitf::ImageSegment(images[startIndex + seg]).getSubheader();
+        size_t numRowsPerBlock =
+                static_cast<size_t>(subheader.getNumPixelsPerVertBlock());
+        if (numRowsPerBlock == 0)
+        {
+            numRowsPerBlock = segInfo.numRows;
+        }
+
+        const size_t segEndRow = std::min(regionEndRow, segInfo.endRow());
+        while (row < segEndRow)
+        {
+            const size_t rowInSeg = row - segInfo.firstRow;
+            const size_t blockEndRow = std::min(
+                    segEndRow,
+                    segInfo.firstRow +
+                            (rowInSeg / numRowsPerBlock + 1) * numRowsPerBlock);
+
+            ReducedChunk chunk;
+            chunk.segment = seg;
+            chunk.startRow = rowInSeg;
+            chunk.numRows = math::ceilingDivide(blockEndRow - row, skip);
+            chunk.outputRow = (row - startRow) / skip;
+            chunks.push_back(chunk);
+
+            row += chunk.numRows * skip;
+        }
+    }
+
+    nitf::Uint8* buffer = region.getBuffer();
+    if (buffer == NULL)
+    {
+        buffer = new nitf::Uint8[numRowsOut * numColsOut *
+                thisImage->getData()->getNumBytesPerPixel()];
+        region.setBuffer(buffer);
+    }
+
+    createCompressionOptions(mCompressionOptions);
+
+    // A single reader can't be shared between threads
+    const bool useFileReaders = numThreads > 1 && !mPathname.empty();
+    const ReadReducedChunks op(chunks,
+                               mReader,
+                               useFileReaders ? mPathname : std::string(),
+                               mCompressionOptions,
+                               startIndex,
+                               startCol,
+                               numColsOut,
+                               skip,
+                               thisImage->getData()->getNumBytesPerPixel(),
+                               buffer);
+    if (useFileReaders)
+    {
+        mt::run1DWithCopies(chunks.size(),
+                            std::min(numThreads, chunks.size()),
+                            op);
+    }
+    else
+    {
+        mt::run1D(chunks.size(), 1, op);
+    }
+
+    return buffer;
+}
+
+UByte* NITFReadControl::interleavedThroughLUT(Region& region,
+                                              size_t imageNumber,
+                                              size_t numThreads)
+{
+    if (imageNumber >= mInfos.size())
+    {
+        throw except::Exception(Ctxt(
+                "Image " + str::toString(imageNumber) + " is out of bounds"));
+    }
+
+    Data* const data = mInfos[imageNumber]->getData();
+    const LUT* const lut = data->getDisplayLUT().get();
+    if (lut == NULL)
+    {
+        throw except::Exception(Ctxt(
+                "Image " + str::toString(imageNumber) + " has no display LUT"));
+    }
+    if (data->getNumBytesPerPixel() != 1)
+    {
+        throw except::Exception(Ctxt(
+                "Expected 8-bit LUT indices but image has " +
+                str::toString(data->getNumBytesPerPixel()) +
+                " bytes per pixel"));
+    }
+
+    // Read the indices into scratch space, then expand into the caller's
+    // buffer (or one we allocate)
+    Region indexRegion(region);
+    indexRegion.setBuffer(NULL);
+    const mem::ScopedArray<UByte> indices(interleaved(indexRegion,
+                                                      imageNumber));
+    region.setNumRows(indexRegion.getNumRows());
+    region.setNumCols(indexRegion.getNumCols());
+
+    const size_t numPixels = static_cast<size_t>(region.getNumRows()) *
+            static_cast<size_t>(region.getNumCols());
+
+    mem::ScopedArray<UByte> allocated;
+    UByte* buffer = region.getBuffer();
+    if (buffer == NULL)
+    {
+        allocated.reset(new UByte[numPixels * lut->elementSize]);
+        buffer = allocated.get();
+    }
+
+    applyLUT(indices.get(), numPixels, *lut, numThreads, buffer);
+
+    region.setBuffer(buffer);
+    allocated.release();
+    return buffer;
+}
+
+UByte* NITFReadControl::interleavedToLUTIndices(Region& region,
+                                                size_t imageNumber,
+                                                const InverseLUT& inverseLUT,
+                                                size_t numThreads)
+{
+    if (imageNumber >= mInfos.size())
+    {
+        throw except::Exception(Ctxt(
+                "Image " + str::toString(imageNumber) + " is out of bounds"));
+    }
+
+    const Data* const data = mInfos[imageNumber]->getData();
+    if (data->getNumBytesPerPixel() != sizeof(sys::Uint16_T))
+    {
+        throw except::Exception(Ctxt(
+                "Expected 16-bit pixels but image has " +
+                str::toString(data->getNumBytesPerPixel()) +
+                " bytes per pixel"));
+    }
+
+    Region valueRegion(region);
+    valueRegion.setBuffer(NULL);
+    const mem::ScopedArray<UByte> values(interleaved(valueRegion,
+                                                     imageNumber));
+    region.setNumRows(valueRegion.getNumRows());
+    region.setNumCols(valueRegion.getNumCols());
+
+    const size_t numPixels = static_cast<size_t>(region.getNumRows()) *
+            static_cast<size_t>(region.getNumCols());
+
+    mem::ScopedArray<UByte> allocated;
+    UByte* buffer = region.getBuffer();
+    if (buffer == NULL)
+    {
+        allocated.reset(new UByte[numPixels]);
+        buffer = allocated.get();
+    }
+
+    // NITRO's image reader already swapped the big-endian NITF pixels into
+    // native byte order, which is what InverseLUT expects
+    inverseLUT.apply(reinterpret_cast<const sys::Uint16_T*>(values.get()),
+                     numPixels, numThreads, buffer);
+
+    region.setBuffer(buffer);
+    allocated.release();
+    return buffer;
+}
+
 std::auto_ptr<Legend> NITFReadControl::findLegend(size_t productNum)
 {
     std::auto_ptr<Legend> legend;
@@ -789,6 +1193,7 @@ void NITFReadControl::reset()
     }
     mInfos.clear();
     mInterface.reset();
+    mPathname.clear();
 }
 
 
@@ -261,6 +261,12 @@ void NITFWriteControl::save(const BufferList& imageData,
 
     // TODO maybe we need to see if the compression plug-in is even available
 
+    // Uncompressed image segments can be blocked and byte swapped by
+    // multiple threads as they're written out.  Segments themselves are
+    // written serially, and the ImageWriter path below is single-threaded.
+    const size_t numThreads = static_cast<size_t>(getOptions().getParameter(
+            WriteControl::OPT_NUM_THREADS, Parameter(1)));
+
     size_t numImages = getInfos().size();
     createCompressionOptions(mCompressionOptions);
     for (size_t i = 0; i < numImages; ++i)
@@ -281,10 +287,54 @@ void NITFWriteControl::save(const BufferList& imageData,
                 static_cast<nitf::Uint32>(subheader.getNumBlocksPerRow()) > 1 ||
                 static_cast<nitf::Uint32>(subheader.getNumBlocksPerCol()) > 1;
 
+        const bool isCompressed = (enableJ2K && numIS == 1) ||
+                !mCompressionOptions.empty();
+
+        if (isBlocking && !isCompressed && numThreads > 1 &&
+            numChannels == 1)
+        {
+            // Blocked SIDDs can bypass the ImageWriter too, as long as there
+            // is no compression to do
+            for (size_t jj = 0; jj < numIS; ++jj)
+            {
+                const NITFSegmentInfo segmentInfo = imageSegments[jj];
+                nitf::ImageSubheader segmentSubheader =
+                        nitf::ImageSegment(getRecord().getImages()[
+                                info.getStartIndex() + jj]).getSubheader();
+
+                // A block size of 0 means that dimension isn't blocked
+                size_t numRowsPerBlock = static_cast<size_t>(
+                        segmentSubheader.getNumPixelsPerVertBlock());
+                if (numRowsPerBlock == 0)
+                {
+                    numRowsPerBlock = segmentInfo.numRows;
+                }
+                size_t numColsPerBlock = static_cast<size_t>(
+                        segmentSubheader.getNumPixelsPerHorizBlock());
+                if (numColsPerBlock == 0)
+                {
+                    numColsPerBlock = numCols;
+                }
+
+                mem::SharedPtr<::nitf::WriteHandler> writeHandler(
+                        new ParallelMemoryWriteHandler(segmentInfo,
+                                                       imageData[i],
+                                                       segmentInfo.firstRow,
+                                                       numCols,
+                                                       numChannels,
+                                                       pixelSize,
+                                                       doByteSwap,
+                                                       numRowsPerBlock,
+                                                       numColsPerBlock,
+                                                       numThreads));
+                mWriter.setImageWriteHandler(static_cast<int>(
+                                                     info.getStartIndex() + jj),
+                                             writeHandler);
+            }
+        }
         // The SIDD spec requires that a J2K compressed SIDDs be only a
         // single image segment. However this functionality remains untested.
-        if (isBlocking || (enableJ2K && numIS == 1) ||
-            !mCompressionOptions.empty())
+        else if (isBlocking || isCompressed)
         {
             if ((isBlocking || (enableJ2K && numIS == 1)) &&
                 info.getData()->getDataType() == six::DataType::COMPLEX)
@@ -330,14 +380,32 @@ void NITFWriteControl::save(const BufferList& imageData,
             {
                 const NITFSegmentInfo segmentInfo = imageSegments[jj];
 
-                mem::SharedPtr<::nitf::WriteHandler> writeHandler(
-                        new MemoryWriteHandler(segmentInfo,
-                                               imageData[i],
-                                               segmentInfo.firstRow,
-                                               numCols,
-                                               numChannels,
-                                               pixelSize,
-                                               doByteSwap));
+                mem::SharedPtr<::nitf::WriteHandler> writeHandler;
+                if (numThreads > 1)
+                {
+                    writeHandler.reset(
+                            new ParallelMemoryWriteHandler(segmentInfo,
+                                                           imageData[i],
+                                                           segmentInfo.firstRow,
+                                                           numCols,
+                                                           numChannels,
+                                                           pixelSize,
+                                                           doByteSwap,
+                                                           0,
+                                                           0,
+                                                           numThreads));
+                }
+                else
+                {
+                    writeHandler.reset(
+                            new MemoryWriteHandler(segmentInfo,
+                                                   imageData[i],
+                                                   segmentInfo.firstRow,
+                                                   numCols,
+                                                   numChannels,
+                                                   pixelSize,
+                                                   doByteSwap));
+                }
                 // Could set start index here
                 mWriter.setImageWriteHandler(static_cast<int>(
                                                      info.getStartIndex() + jj),
@@ -0,0 +1,425 @@
+/* =========================================================================
+ * This file is part of six-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <limits>
+
+#include <sys/Conf.h>
+#include <except/Exception.h>
+#include <six/NumericConversion.h>
+
+namespace
+{
+void throwBadCast(const std::string& s, const char* type)
+{
+    throw except::BadCastException(Ctxt(
+            "Conversion failed: '" + s + "' -> " + type));
+}
+
+bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' ||
+            c == '\f' || c == '\v';
+}
+
+bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+/*
+ * snprintf() writes the C locale's decimal point, which is whatever sits
+ * between the leading digits and the exponent (or the end).  Swap it for
+ * '.' without asking localeconv(), which isn't thread-safe.
+ */
+void fixDecimalPoint(std::string& str)
+{
+    size_t begin = (!str.empty() && str[0] == '-') ? 1 : 0;
+    while (begin < str.length() && isDigit(str[begin]))
+    {
+        ++begin;
+    }
+
+    size_t end = begin;
+    while (end < str.length() && !isDigit(str[end]) &&
+           str[end] != 'e' && str[end] != 'E')
+    {
+        ++end;
+    }
+
+    if (end > begin)
+    {
+        str.replace(begin, end - begin, ".");
+    }
+}
+
+template <typename T>
+std::string formatFloat(T value, bool scientific)
+{
+    // Same as an ostream with precision max_digits10 and either the default
+    // or uppercase scientific float field
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), scientific ? "%.*E" : "%.*g",
+             std::numeric_limits<T>::max_digits10,
+             static_cast<double>(value));
+    std::string str(buffer);
+
+    // NaN and infinity have no decimal point or exponent to fix up
+    if (value - value == 0)
+    {
+        fixDecimalPoint(str);
+
+        // remove any + in scientific notation to meet SICD XML standard
+        if (scientific)
+        {
+            const size_t plusPos = str.find('+');
+            if (plusPos != std::string::npos)
+            {
+                str.erase(plusPos, 1);
+            }
+        }
+    }
+    return str;
+}
+
+std::string formatInteger(long long value)
+{
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%lld", value);
+    return buffer;
+}
+
+std::string formatInteger(unsigned long long value)
+{
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%llu", value);
+    return buffer;
+}
+
+double toFloat(const char* str, char** end, double)
+{
+    return strtod(str, end);
+}
+
+float toFloat(const char* str, char** end, float)
+{
+    return strtof(str, end);
+}
+
+/*
+ * Reads a floating point value the same way operator>> does: after any
+ * leading whitespace, take the longest prefix of the form
+ * [+-]digits[.digits][(e|E)[+-]digits] and ignore whatever follows.  The
+ * prefix must have a digit in the mantissa and, if there's an exponent
+ * marker, in the exponent.  Values that overflow are an error.
+ *
+ * The decimal point is folded into the exponent before handing the number
+ * to strtod(), so the C locale's decimal point never matters.
+ */
+template <typename T>
+T parseFloat(const std::string& s, const char* type)
+{
+    size_t pos = 0;
+    while (pos < s.length() && isSpace(s[pos]))
+    {
+        ++pos;
+    }
+
+    std::string number;
+    if (pos < s.length() && (s[pos] == '+' || s[pos] == '-'))
+    {
+        number += s[pos++];
+    }
+
+    bool foundMantissa = false;
+    long fractionDigits = 0;
+    for (; pos < s.length() && isDigit(s[pos]); ++pos)
+    {
+        number += s[pos];
+        foundMantissa = true;
+    }
+    if (pos < s.length() && s[pos] == '.')
+    {
+        for (++pos; pos < s.length() && isDigit(s[pos]); ++pos)
+        {
+            number += s[pos];
+            ++fractionDigits;
+            foundMantissa = true;
+        }
+    }
+    if (!foundMantissa)
+    {
+        throwBadCast(s, type);
+    }
+
+    // Saturate well past where every value under- or overflows
+    const long maxExponent = 100000000;
+    long exponent = 0;
+    if (pos < s.length() && (s[pos] == 'e' || s[pos] == 'E'))
+    {
+        ++pos;
+        const bool isNegative = (pos < s.length() && s[pos] == '-');
+        if (pos < s.length() && (s[pos] == '+' || s[pos] == '-'))
+        {
+            ++pos;
+        }
+
+        bool foundExponent = false;
+        for (; pos < s.length() && isDigit(s[pos]); ++pos)
+        {
+            exponent = std::min(exponent * 10 + (s[pos] - '0'), maxExponent);
+            foundExponent = true;
+        }
+        if (!foundExponent)
+        {
+            throwBadCast(s, type);
+        }
+        if (isNegative)
+        {
+            exponent = -exponent;
+        }
+    }
+
+    char exponentStr[32];
+    snprintf(exponentStr, sizeof(exponentStr), "e%ld",
+             exponent - fractionDigits);
+    number += exponentStr;
+
+    const T value = toFloat(number.c_str(), NULL, T());
+    if (value - value != 0)
+    {
+        throwBadCast(s, type);
+    }
+    return value;
+}
+
+/*
+ * Reads an integer the same way operator>> does: after any leading
+ * whitespace, take an optional sign and as many decimal digits as follow
+ * and ignore the rest.  A negative value read into an unsigned type wraps
+ * around, as long as its magnitude fits.
+ */
+template <typename T>
+T parseInteger(const std::string& s, const char* type)
+{
+    size_t pos = 0;
+    while (pos < s.length() && isSpace(s[pos]))
+    {
+        ++pos;
+    }
+
+    bool isNegative = false;
+    if (pos < s.length() && (s[pos] == '+' || s[pos] == '-'))
+    {
+        isNegative = (s[pos] == '-');
+        ++pos;
+    }
+
+    // operator>> reads short and int as long and then range checks them
+    const bool readAsLong = std::numeric_limits<T>::is_signed &&
+            std::numeric_limits<T>::digits <
+                    std::numeric_limits<long>::digits;
+    const unsigned long long maxMagnitude = readAsLong ?
+            static_cast<unsigned long long>(
+                    std::numeric_limits<long>::max()) + (isNegative ? 1 : 0) :
+            static_cast<unsigned long long>(std::numeric_limits<T>::max()) +
+                    (isNegative && std::numeric_limits<T>::is_signed ? 1 : 0);
+
+    unsigned long long magnitude = 0;
+    bool foundDigit = false;
+    bool overflow = false;
+    for (; pos < s.length() && isDigit(s[pos]); ++pos)
+    {
+        const unsigned long long digit = s[pos] - '0';
+        if (magnitude > (maxMagnitude - digit) / 10)
+        {
+            overflow = true;
+        }
+        else
+        {
+            magnitude = magnitude * 10 + digit;
+        }
+        foundDigit = true;
+    }
+    if (!foundDigit || overflow)
+    {
+        throwBadCast(s, type);
+    }
+
+    if (readAsLong)
+    {
+        const long long value = isNegative ?
+                -static_cast<long long>(magnitude - 1) - 1 :
+                static_cast<long long>(magnitude);
+        if (value < static_cast<long long>(std::numeric_limits<T>::min()) ||
+            value > static_cast<long long>(std::numeric_limits<T>::max()))
+        {
+            throwBadCast(s, type);
+        }
+        return static_cast<T>(value);
+    }
+
+    if (std::numeric_limits<T>::is_signed)
+    {
+        return isNegative ?
+                static_cast<T>(-static_cast<long long>(magnitude - 1) - 1) :
+                static_cast<T>(magnitude);
+    }
+    return isNegative ? static_cast<T>(-magnitude) :
+                        static_cast<T>(magnitude);
+}
+}
+
+namespace six
+{
+template <>
+std::string formatNumber(const float& value)
+{
+    return formatFloat(value, false);
+}
+
+template <>
+std::string formatNumber(const double& value)
+{
+    return formatFloat(value, false);
+}
+
+template <>
+std::string formatNumber(const short& value)
+{
+    return formatInteger(static_cast<long long>(value));
+}
+
+template <>
+std::string formatNumber(const unsigned short& value)
+{
+    return formatInteger(static_cast<unsigned long long>(value));
+}
+
+template <>
+std::string formatNumber(const int& value)
+{
+    return formatInteger(static_cast<long long>(value));
+}
+
+template <>
+std::string formatNumber(const unsigned int& value)
+{
+    return formatInteger(static_cast<unsigned long long>(value));
+}
+
+template <>
+std::string formatNumber(const long& value)
+{
+    return formatInteger(static_cast<long long>(value));
+}
+
+template <>
+std::string formatNumber(const unsigned long& value)
+{
+    return formatInteger(static_cast<unsigned long long>(value));
+}
+
+template <>
+std::string formatNumber(const long long& value)
+{
+    return formatInteger(value);
+}
+
+template <>
+std::string formatNumber(const unsigned long long& value)
+{
+    return formatInteger(value);
+}
+
+std::string formatScientific(double value)
+{
+    return formatFloat(value, true);
+}
+
+std::string formatScientific(float value)
+{
+    return formatFloat(value, true);
+}
+
+template <>
+float parseNumber(const std::string& s)
+{
+    return parseFloat<float>(s, "float");
+}
+
+template <>
+double parseNumber(const std::string& s)
+{
+    return parseFloat<double>(s, "double");
+}
+
+template <>
+short parseNumber(const std::string& s)
+{
+    return parseInteger<short>(s, "short");
+}
+
+template <>
+unsigned short parseNumber(const std::string& s)
+{
+    return parseInteger<unsigned short>(s, "unsigned short");
+}
+
+template <>
+int parseNumber(const std::string& s)
+{
+    return parseInteger<int>(s, "int");
+}
+
+template <>
+unsigned int parseNumber(const std::string& s)
+{
+    return parseInteger<unsigned int>(s, "unsigned int");
+}
+
+template <>
+long parseNumber(const std::string& s)
+{
+    return parseInteger<long>(s, "long");
+}
+
+template <>
+unsigned long parseNumber(const std::string& s)
+{
+    return parseInteger<unsigned long>(s, "unsigned long");
+}
+
+template <>
+long long parseNumber(const std::string& s)
+{
+    return parseInteger<long long>(s, "long long");
+}
+
+template <>
+unsigned long long parseNumber(const std::string& s)
+{
+    return parseInteger<unsigned long long>(s, "unsigned long long");
+}
+}
@@ -0,0 +1,311 @@
+/* =========================================================================
+ * This file is part of six-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ *
+ * six-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <limits>
+
+#include <mt/CriticalSection.h>
+#include <sys/Mutex.h>
+#include "six/Parameter.h"
+
+namespace
+{
+// Whether 'value' fits in a T.  Mirrors the range check in
+// six::parseNumber<T>().
+template <typename T>
+bool inRange(long long value)
+{
+    if (value < 0)
+    {
+        return std::numeric_limits<T>::is_signed &&
+                value >= static_cast<long long>(std::numeric_limits<T>::min());
+    }
+    return static_cast<unsigned long long>(value) <=
+            static_cast<unsigned long long>(std::numeric_limits<T>::max());
+}
+
+template <typename T>
+bool inRange(unsigned long long value)
+{
+    return value <=
+            static_cast<unsigned long long>(std::numeric_limits<T>::max());
+}
+
+// Guards the formatted strings that const Parameters fill in, so that
+// threads can share them.  It's only taken for the const char* conversion
+// of a numeric value.
+sys::Mutex formatMutex;
+}
+
+namespace six
+{
+Parameter::Parameter(const Parameter& other) :
+    mName(other.mName),
+    mFormatted(true),
+    mType(STRING),
+    mImag(0.0)
+{
+    mNumber.real = 0.0;
+    *this = other;
+}
+
+Parameter& Parameter::operator=(const Parameter& other)
+{
+    if (this != &other)
+    {
+        // Another thread may be filling in other's formatted string, so
+        // that's left behind and formatted again if it's needed
+        if (other.mType == STRING)
+        {
+            mValue = other.mValue;
+        }
+        mName = other.mName;
+        mFormatted = (other.mType == STRING);
+        mType = other.mType;
+        mNumber = other.mNumber;
+        mImag = other.mImag;
+    }
+    return *this;
+}
+
+std::string Parameter::str() const
+{
+    return (mType == STRING) ? mValue : format();
+}
+
+const std::string& Parameter::getFormatted() const
+{
+    if (mType != STRING)
+    {
+        mt::CriticalSection<sys::Mutex> lock(&formatMutex);
+        if (!mFormatted)
+        {
+            mValue = format();
+            mFormatted = true;
+        }
+    }
+    return mValue;
+}
+
+std::string Parameter::format() const
+{
+    switch (mType)
+    {
+    case FLOAT:
+        return formatNumber(static_cast<float>(mNumber.real));
+    case DOUBLE:
+        return formatNumber(mNumber.real);
+    case SIGNED:
+        return formatNumber(mNumber.integer);
+    case UNSIGNED:
+        return formatNumber(mNumber.uinteger);
+    case COMPLEX_INT:
+        return str::toString(std::complex<int>(
+                static_cast<int>(mNumber.real), static_cast<int>(mImag)));
+    case COMPLEX_FLOAT:
+        return str::toString(std::complex<float>(
+                static_cast<float>(mNumber.real), static_cast<float>(mImag)));
+    case COMPLEX_DOUBLE:
+        return str::toString(std::complex<double>(mNumber.real, mImag));
+    case STRING:
+    default:
+        return mValue;
+    }
+}
+
+bool Parameter::operator==(const Parameter& o) const
+{
+    if (mName != o.mName)
+    {
+        return false;
+    }
+
+    // Integers have exactly one string representation.  Everything else
+    // compares the way it always has, so that e.g. 0.0 != -0.0.
+    if (mType == o.mType)
+    {
+        switch (mType)
+        {
+        case SIGNED:
+            return mNumber.integer == o.mNumber.integer;
+        case UNSIGNED:
+            return mNumber.uinteger == o.mNumber.uinteger;
+        case STRING:
+            return mValue == o.mValue;
+        default:
+            break;
+        }
+    }
+    return str() == o.str();
+}
+
+void Parameter::setString(const std::string& value)
+{
+    mType = STRING;
+    mValue = value;
+    mFormatted = true;
+}
+
+void Parameter::setReal(ValueType type, double real, double imag)
+{
+    mType = type;
+    mNumber.real = real;
+    mImag = imag;
+    mFormatted = false;
+}
+
+void Parameter::setSigned(long long value)
+{
+    mType = SIGNED;
+    mNumber.integer = value;
+    mImag = 0.0;
+    mFormatted = false;
+}
+
+void Parameter::setUnsigned(unsigned long long value)
+{
+    mType = UNSIGNED;
+    mNumber.uinteger = value;
+    mImag = 0.0;
+    mFormatted = false;
+}
+
+std::string Parameter::toValue(std::string*) const
+{
+    return str();
+}
+
+float Parameter::toValue(float*) const
+{
+    switch (mType)
+    {
+    case FLOAT:
+        return static_cast<float>(mNumber.real);
+    case SIGNED:
+        return static_cast<float>(mNumber.integer);
+    case UNSIGNED:
+        return static_cast<float>(mNumber.uinteger);
+    default:
+        // Rounding a double to float directly can differ from parsing its
+        // string, so that still goes through the string
+        return parseNumber<float>(str());
+    }
+}
+
+double Parameter::toValue(double*) const
+{
+    switch (mType)
+    {
+    case DOUBLE:
+        return mNumber.real;
+    case SIGNED:
+        return static_cast<double>(mNumber.integer);
+    case UNSIGNED:
+        return static_cast<double>(mNumber.uinteger);
+    default:
+        return parseNumber<double>(str());
+    }
+}
+
+template <typename T>
+T Parameter::toInteger() const
+{
+    if (mType == SIGNED && inRange<T>(mNumber.integer))
+    {
+        return static_cast<T>(mNumber.integer);
+    }
+    if (mType == UNSIGNED && inRange<T>(mNumber.uinteger))
+    {
+        return static_cast<T>(mNumber.uinteger);
+    }
+
+    // This also reports values that are out of range
+    return parseNumber<T>(str());
+}
+
+short Parameter::toValue(short*) const
+{
+    return toInteger<short>();
+}
+
+int Parameter::toValue(int*) const
+{
+    return toInteger<int>();
+}
+
+long Parameter::toValue(long*) const
+{
+    return toInteger<long>();
+}
+
+long long Parameter::toValue(long long*) const
+{
+    return toInteger<long long>();
+}
+
+unsigned short Parameter::toValue(unsigned short*) const
+{
+    return toInteger<unsigned short>();
+}
+
+unsigned int Parameter::toValue(unsigned int*) const
+{
+    return toInteger<unsigned int>();
+}
+
+unsigned long Parameter::toValue(unsigned long*) const
+{
+    return toInteger<unsigned long>();
+}
+
+unsigned long long Parameter::toValue(unsigned long long*) const
+{
+    return toInteger<unsigned long long>();
+}
+
+std::complex<int> Parameter::toComplex(int*) const
+{
+    if (mType == COMPLEX_INT)
+    {
+        return std::complex<int>(static_cast<int>(mNumber.real),
+                                 static_cast<int>(mImag));
+    }
+    return str::toType<std::complex<int> >(str());
+}
+
+std::complex<float> Parameter::toComplex(float*) const
+{
+    if (mType == COMPLEX_INT || mType == COMPLEX_FLOAT)
+    {
+        return std::complex<float>(static_cast<float>(mNumber.real),
+                                   static_cast<float>(mImag));
+    }
+    return str::toType<std::complex<float> >(str());
+}
+
+std::complex<double> Parameter::toComplex(double*) const
+{
+    if (mType == COMPLEX_INT || mType == COMPLEX_DOUBLE)
+    {
+        return std::complex<double>(mNumber.real, mImag);
+    }
+    return str::toType<std::complex<double> >(str());
+}
+}
@@ -76,7 +76,7 @@ XMLElem SICommonXMLParser::createVector2D(
         Vector2 p,
         XMLElem parent) const
 {
-    XMLElem e = newElement(name, (uri.empty()) ? getDefaultURI() : uri, parent);
+    XMLElem e = createElement(name, (uri.empty()) ? getDefaultURI() : uri, parent);
     createDouble("X", getSICommonURI(), p[0], e);
     createDouble("Y", getSICommonURI(), p[1], e);
     return e;
@@ -96,7 +96,7 @@ XMLElem SICommonXMLParser::createVector3D(
         Vector3 p,
         XMLElem parent) const
 {
-    XMLElem e = newElement(name, (uri.empty()) ? getDefaultURI() : uri, parent);
+    XMLElem e = createElement(name, (uri.empty()) ? getDefaultURI() : uri, parent);
     createDouble("X", getSICommonURI(), p[0], e);
     createDouble("Y", getSICommonURI(), p[1], e);
     createDouble("Z", getSICommonURI(), p[2], e);
@@ -115,7 +115,7 @@ XMLElem SICommonXMLParser::createPoly1D(const std::string& name,
         const std::string& uri, const Poly1D& poly1D, XMLElem parent) const
 {
     size_t order = poly1D.order();
-    XMLElem poly1DXML = newElement(name, uri, parent);
+    XMLElem poly1DXML = createElement(name, uri, parent);
     setAttribute(poly1DXML, "order1", six::toString(order));
 
     for (size_t ii = 0; ii <= order; ++ii)
@@ -185,26 +185,23 @@ XMLElem SICommonXMLParser::createPolyXYZ(const std::string& name,
         const PolyXYZ& polyXYZ, XMLElem parent) const
 {
     size_t order = polyXYZ.order();
-    XMLElem polyXML = newElement(name, getDefaultURI(), parent);
+    XMLElem polyXML = createElement(name, getDefaultURI(), parent);
 
-    XMLElem xXML = newElement("X", getSICommonURI(), polyXML);
-    XMLElem yXML = newElement("Y", getSICommonURI(), polyXML);
-    XMLElem zXML = newElement("Z", getSICommonURI(), polyXML);
-
-    setAttribute(xXML, "order1", six::toString(order));
-    setAttribute(yXML, "order1", six::toString(order));
-    setAttribute(zXML, "order1", six::toString(order));
-
-    for (size_t ii = 0; ii <= order; ++ii)
+    // One component at a time, so that each is finished before the next
+    // starts when streaming
+    const char* const componentNames[] = {"X", "Y", "Z"};
+    for (size_t jj = 0; jj < 3; ++jj)
     {
-        Vector3 v3 = polyXYZ[ii];
-        XMLElem xCoefXML = createDouble("Coef", getSICommonURI(), v3[0], xXML);
-        XMLElem yCoefXML = createDouble("Coef", getSICommonURI(), v3[1], yXML);
-        XMLElem zCoefXML = createDouble("Coef", getSICommonURI(), v3[2], zXML);
-
-        setAttribute(xCoefXML, "exponent1", six::toString(ii));
-        setAttribute(yCoefXML, "exponent1", six::toString(ii));
-        setAttribute(zCoefXML, "exponent1", six::toString(ii));
+        XMLElem componentXML =
+                createElement(componentNames[jj], getSICommonURI(), polyXML);
+        setAttribute(componentXML, "order1", six::toString(order));
+
+        for (size_t ii = 0; ii <= order; ++ii)
+        {
+            XMLElem coefXML = createDouble("Coef", getSICommonURI(),
+                                           polyXYZ[ii][jj], componentXML);
+            setAttribute(coefXML, "exponent1", six::toString(ii));
+        }
     }
     return polyXML;
 }
@@ -216,7 +213,7 @@ XMLElem SICommonXMLParser::convertGeoInfoToXML(const GeoInfo& geoInfo,
     const std::string uri = hasSIPrefix ? getSICommonURI() : "";
 
     //! 1.0.x has ordering (1. Desc, 2. choice, 3. GeoInfo)
-    XMLElem geoInfoXML = newElement("GeoInfo", uri, parent);
+    XMLElem geoInfoXML = createElement("GeoInfo", uri, parent);
 
     addParameters("Desc", uri, geoInfo.desc, geoInfoXML);
 
@@ -227,8 +224,8 @@ XMLElem SICommonXMLParser::convertGeoInfoToXML(const GeoInfo& geoInfo,
     }
     else if (numLatLons >= 2)
     {
-        XMLElem linePolyXML = newElement(numLatLons == 2 ? "Line" : "Polygon",
-                                         uri, geoInfoXML);
+        XMLElem linePolyXML = createElement(numLatLons == 2 ? "Line" : "Polygon",
+                                            uri, geoInfoXML);
 
         setAttribute(linePolyXML, "size", str::toString(numLatLons));
 
@@ -317,7 +314,7 @@ XMLElem SICommonXMLParser::createLatLonFootprint(const std::string& name,
                                                  const LatLonCorners& corners,
                                                  XMLElem parent) const
 {
-    XMLElem footprint = newElement(name, parent);
+    XMLElem footprint = createElement(name, parent);
 
     // Write the corners in CW order
     XMLElem vertex = createLatLon(cornerName, corners.upperLeft, footprint);
@@ -377,7 +374,7 @@ XMLElem SICommonXMLParser::createPoly2D(const std::string& name,
         const std::string& uri, const Poly2D& poly2D, XMLElem parent) const
 {
     xml::lite::AttributeNode node;
-    XMLElem poly2DXML = newElement(name, uri, parent);
+    XMLElem poly2DXML = createElement(name, uri, parent);
     setAttribute(poly2DXML, "order1", six::toString(poly2D.orderX()));
     setAttribute(poly2DXML, "order2", six::toString(poly2D.orderY()));
 
@@ -405,7 +402,7 @@ XMLElem SICommonXMLParser::createPoly2D(const std::string& name,
 XMLElem SICommonXMLParser::createComplex(const std::string& name,
         std::complex<double> c, XMLElem parent) const
 {
-    XMLElem e = newElement(name, getDefaultURI(), parent);
+    XMLElem e = createElement(name, getDefaultURI(), parent);
     createDouble("Real", getSICommonURI(), c.real(), e);
     createDouble("Imag", getSICommonURI(), c.imag(), e);
     return e;
@@ -416,7 +413,7 @@ XMLElem SICommonXMLParser::createRowCol(
         const std::string& rowName, const std::string& colName,
         const RowColInt& value, XMLElem parent) const
 {
-    XMLElem e = newElement(name, (uri.empty()) ? getDefaultURI() : uri, parent);
+    XMLElem e = createElement(name, (uri.empty()) ? getDefaultURI() : uri, parent);
     createInt(rowName, getSICommonURI(), static_cast<int>(value.row), e);
     createInt(colName, getSICommonURI(), static_cast<int>(value.col), e);
     return e;
@@ -434,7 +431,7 @@ XMLElem SICommonXMLParser::createRowCol(
         const std::string& rowName, const std::string& colName,
         const RowColDouble& value, XMLElem parent) const
 {
-    XMLElem e = newElement(name, (uri.empty()) ? getDefaultURI() : uri, parent);
+    XMLElem e = createElement(name, (uri.empty()) ? getDefaultURI() : uri, parent);
     createDouble(rowName, getSICommonURI(), value.row, e);
     createDouble(colName, getSICommonURI(), value.col, e);
     return e;
@@ -476,7 +473,7 @@ XMLElem SICommonXMLParser::createRowCol(const std::string& name,
 XMLElem SICommonXMLParser::createRowCol(const std::string& name,
         const RowColLatLon& value, XMLElem parent) const
 {
-    XMLElem e = newElement(name, getDefaultURI(), parent);
+    XMLElem e = createElement(name, getDefaultURI(), parent);
     createLatLon("Row", value.row, e);
     createLatLon("Col", value.col, e);
     return e;
@@ -485,7 +482,7 @@ XMLElem SICommonXMLParser::createRowCol(const std::string& name,
 XMLElem SICommonXMLParser::createRangeAzimuth(const std::string& name,
         const types::RgAz<double>& value, XMLElem parent) const
 {
-    XMLElem e = newElement(name, getDefaultURI(), parent);
+    XMLElem e = createElement(name, getDefaultURI(), parent);
     createDouble("Range", getSICommonURI(), value.rg, e);
     createDouble("Azimuth", getSICommonURI(), value.az, e);
     return e;
@@ -497,7 +494,7 @@ XMLElem SICommonXMLParser::createLatLon(
         const LatLon& value,
         XMLElem parent) const
 {
-    XMLElem e = newElement(name, uri, parent);
+    XMLElem e = createElement(name, uri, parent);
     createDouble("Lat", getSICommonURI(), value.getLat(), e);
     createDouble("Lon", getSICommonURI(), value.getLon(), e);
     return e;
@@ -578,7 +575,7 @@ void SICommonXMLParser::addDecorrType(const std::string& name,
     if (!Init::isUndefined<double>(decorrType.corrCoefZero)
             && !Init::isUndefined<double>(decorrType.decorrRate))
     {
-        XMLElem decorrXML = newElement(name, uri, parent);
+        XMLElem decorrXML = createElement(name, uri, parent);
         createDouble("CorrCoefZero", uri, decorrType.corrCoefZero, decorrXML);
         createDouble("DecorrRate", uri, decorrType.decorrRate, decorrXML);
     }
@@ -771,8 +768,8 @@ XMLElem SICommonXMLParser::convertErrorStatisticsToXML(
     const ErrorStatistics* errorStatistics,
     XMLElem parent) const
 {
-    XMLElem errorStatsXML = newElement("ErrorStatistics", getDefaultURI(),
-                                       parent);
+    XMLElem errorStatsXML = createElement("ErrorStatistics", getDefaultURI(),
+                                          parent);
 
     //! version specific implementation
     convertCompositeSCPToXML(errorStatistics, errorStatsXML);
@@ -780,9 +777,9 @@ XMLElem SICommonXMLParser::convertErrorStatisticsToXML(
     const Components* const components = errorStatistics->components.get();
     if (components)
     {
-        XMLElem componentsXML = newElement("Components",
-                                           getSICommonURI(),
-                                           errorStatsXML);
+        XMLElem componentsXML = createElement("Components",
+                                              getSICommonURI(),
+                                              errorStatsXML);
 
         const PosVelError* const posVelError = components->posVelError.get();
         const RadarSensor* const radarSensor = components->radarSensor.get();
@@ -791,9 +788,9 @@ XMLElem SICommonXMLParser::convertErrorStatisticsToXML(
 
         if (posVelError)
         {
-            XMLElem posVelErrXML = newElement("PosVelErr",
-                                              getSICommonURI(),
-                                              componentsXML);
+            XMLElem posVelErrXML = createElement("PosVelErr",
+                                                 getSICommonURI(),
+                                                 componentsXML);
 
             createString("Frame", getSICommonURI(),
                          six::toString(posVelError->frame), posVelErrXML);
@@ -807,9 +804,9 @@ XMLElem SICommonXMLParser::convertErrorStatisticsToXML(
             const CorrCoefs* const coefs = posVelError->corrCoefs.get();
             if (coefs)
             {
-                XMLElem coefsXML = newElement("CorrCoefs",
-                                              getSICommonURI(),
-                                              posVelErrXML);
+                XMLElem coefsXML = createElement("CorrCoefs",
+                                                 getSICommonURI(),
+                                                 posVelErrXML);
 
                 createDouble("P1P2", getSICommonURI(), coefs->p1p2, coefsXML);
                 createDouble("P1P3", getSICommonURI(), coefs->p1p3, coefsXML);
@@ -833,8 +830,8 @@ XMLElem SICommonXMLParser::convertErrorStatisticsToXML(
         }
         if (radarSensor)
         {
-            XMLElem radarSensorXML = newElement("RadarSensor", getSICommonURI(),
-                                                componentsXML);
+            XMLElem radarSensorXML = createElement("RadarSensor", getSICommonURI(),
+                                                   componentsXML);
 
             createDouble("RangeBias", getSICommonURI(), radarSensor->rangeBias,
                          radarSensorXML);
@@ -854,9 +851,9 @@ XMLElem SICommonXMLParser::convertErrorStatisticsToXML(
         }
         if (tropoError)
         {
-            XMLElem tropoErrXML = newElement("TropoError",
-                                             getSICommonURI(),
-                                             componentsXML);
+            XMLElem tropoErrXML = createElement("TropoError",
+                                                getSICommonURI(),
+                                                componentsXML);
 
             if (!Init::isUndefined<double>(tropoError->tropoRangeVertical))
             {
@@ -874,9 +871,9 @@ XMLElem SICommonXMLParser::convertErrorStatisticsToXML(
         }
         if (ionoError)
         {
-            XMLElem ionoErrXML = newElement("IonoError",
-                                            getSICommonURI(),
-                                            componentsXML);
+            XMLElem ionoErrXML = createElement("IonoError",
+                                               getSICommonURI(),
+                                               componentsXML);
 
             if (!Init::isUndefined<double>(ionoError->ionoRangeVertical))
             {
@@ -899,9 +896,9 @@ XMLElem SICommonXMLParser::convertErrorStatisticsToXML(
 
     if (!errorStatistics->additionalParameters.empty())
     {
-        XMLElem paramsXML = newElement("AdditionalParms",
-                                       getSICommonURI(),
-                                       errorStatsXML);
+        XMLElem paramsXML = createElement("AdditionalParms",
+                                          getSICommonURI(),
+                                          errorStatsXML);
         addParameters("Parameter", getSICommonURI(),
                       errorStatistics->additionalParameters, paramsXML);
     }
@@ -1236,7 +1233,7 @@ XMLElem SICommonXMLParser::convertCollectionInformationToXML(
     const CollectionInformation *collInfo,
     XMLElem parent) const
 {
-    XMLElem collInfoXML = newElement("CollectionInfo", parent);
+    XMLElem collInfoXML = createElement("CollectionInfo", parent);
 
     const std::string si = getSICommonURI();
 
@@ -1254,7 +1251,7 @@ XMLElem SICommonXMLParser::convertCollectionInformationToXML(
                      collInfoXML);
     }
 
-    XMLElem radarModeXML = newElement("RadarMode", si, collInfoXML);
+    XMLElem radarModeXML = createElement("RadarMode", si, collInfoXML);
     createString("ModeType", si, six::toString(collInfo->radarMode),
                  radarModeXML);
     if (!collInfo->radarModeID.empty())
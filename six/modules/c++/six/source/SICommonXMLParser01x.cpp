@@ -52,11 +52,11 @@ XMLElem SICommonXMLParser01x::convertCompositeSCPToXML(
     //TODO compositeSCP needs to be reworked
     if (errorStatistics->compositeSCP.get())
     {
-        XMLElem scpXML = newElement("CompositeSCP", defaultURI, errorStatsXML);
+        XMLElem scpXML = createElement("CompositeSCP", defaultURI, errorStatsXML);
 
         if (errorStatistics->compositeSCP->scpType == CompositeSCP::RG_AZ)
         {
-            XMLElem rgAzXML = newElement("RgAzErr", defaultURI, scpXML);
+            XMLElem rgAzXML = createElement("RgAzErr", defaultURI, scpXML);
             createDouble("Rg", defaultURI, errorStatistics->compositeSCP->xErr, rgAzXML);
             createDouble("Az", defaultURI, errorStatistics->compositeSCP->yErr, rgAzXML);
             createDouble("RgAz", defaultURI, errorStatistics->compositeSCP->xyErr,
@@ -64,7 +64,7 @@ XMLElem SICommonXMLParser01x::convertCompositeSCPToXML(
         }
         else
         {
-            XMLElem rgAzXML = newElement("RowColErr", defaultURI, scpXML);
+            XMLElem rgAzXML = createElement("RowColErr", defaultURI, scpXML);
             createDouble("Row", defaultURI, errorStatistics->compositeSCP->xErr,
                          rgAzXML);
             createDouble("Col", defaultURI, errorStatistics->compositeSCP->yErr,
@@ -121,7 +121,7 @@ XMLElem SICommonXMLParser01x::convertRadiometryToXML(
     const Radiometric *r, XMLElem parent) const
 {
     std::string defaultURI = getSICommonURI();
-    XMLElem rXML = newElement("Radiometric", getDefaultURI(), parent);
+    XMLElem rXML = createElement("Radiometric", getDefaultURI(), parent);
 
     if (!r->noiseLevel.noisePoly.empty())
     {
@@ -234,12 +234,12 @@ XMLElem SICommonXMLParser01x::convertMatchInformationToXML(
     XMLElem parent) const
 {
     // This is SICD 0.4 format
-    XMLElem matchInfoXML = newElement("MatchInfo", parent);
+    XMLElem matchInfoXML = createElement("MatchInfo", parent);
 
     for (size_t i = 0; i < matchInfo.types.size(); ++i)
     {
         const MatchType& mt = matchInfo.types[i];
-        XMLElem mtXML = newElement("Collect", matchInfoXML);
+        XMLElem mtXML = createElement("Collect", matchInfoXML);
         setAttribute(mtXML, "index", str::toString(i + 1));
 
         createString("CollectorName", mt.collectorName, mtXML);
@@ -49,7 +49,7 @@ XMLElem SICommonXMLParser10x::convertCompositeSCPToXML(
     std::string defaultURI = getSICommonURI();
     if (errorStatistics->compositeSCP.get())
     {
-        XMLElem scpXML = newElement("CompositeSCP", defaultURI, errorStatsXML);
+        XMLElem scpXML = createElement("CompositeSCP", defaultURI, errorStatsXML);
 
         createDouble("Rg", defaultURI, errorStatistics->compositeSCP->xErr,
                      scpXML);
@@ -87,11 +87,11 @@ XMLElem SICommonXMLParser10x::convertRadiometryToXML(
     const Radiometric *r, XMLElem parent) const
 {
     std::string defaultURI = getSICommonURI();
-    XMLElem rXML = newElement("Radiometric", getDefaultURI(), parent);
+    XMLElem rXML = createElement("Radiometric", getDefaultURI(), parent);
 
     if (!r->noiseLevel.noiseType.empty() && !r->noiseLevel.noisePoly.empty())
     {
-        XMLElem noiseLevelXML = newElement("NoiseLevel", defaultURI, rXML);
+        XMLElem noiseLevelXML = createElement("NoiseLevel", defaultURI, rXML);
         createString("NoiseLevelType", defaultURI, r->noiseLevel.noiseType, noiseLevelXML);
         createPoly2D("NoisePoly", defaultURI, r->noiseLevel.noisePoly, noiseLevelXML);
     }
@@ -169,7 +169,7 @@ XMLElem SICommonXMLParser10x::convertMatchInformationToXML(
     const MatchInformation& matchInfo,
     XMLElem parent) const
 {
-    XMLElem matchInfoXML = newElement("MatchInfo", parent);
+    XMLElem matchInfoXML = createElement("MatchInfo", parent);
 
     createInt("NumMatchTypes",
               static_cast<int>(matchInfo.types.size()),
@@ -178,7 +178,7 @@ XMLElem SICommonXMLParser10x::convertMatchInformationToXML(
     for (size_t ii = 0; ii < matchInfo.types.size(); ++ii)
     {
         const MatchType& mt = matchInfo.types[ii];
-        XMLElem mtXML = newElement("MatchType", matchInfoXML);
+        XMLElem mtXML = createElement("MatchType", matchInfoXML);
         setAttribute(mtXML, "index", str::toString(ii + 1));
 
         createString("TypeID", mt.typeID, mtXML);
@@ -188,7 +188,7 @@ XMLElem SICommonXMLParser10x::convertMatchInformationToXML(
 
         for (size_t jj = 0; jj < mt.matchCollects.size(); ++jj)
         {
-            XMLElem mcXML = newElement("MatchCollection", mtXML);
+            XMLElem mcXML = createElement("MatchCollection", mtXML);
             setAttribute(mcXML, "index", str::toString(jj + 1));
 
             createString("CoreName", mt.matchCollects[jj].coreName, mcXML);
@@ -26,6 +26,7 @@
 #include <logging/NullLogger.h>
 #include <math/Utilities.h>
 #include <nitf/PluginRegistry.hpp>
+#include "six/NumericConversion.h"
 #include "six/Utilities.h"
 #include "six/XMLControl.h"
 
@@ -106,19 +107,7 @@ std::string six::toString<float>(const float& value)
                 Ctxt("Attempted use of uninitialized float value"));
     }
 
-    std::ostringstream os;
-    size_t precision = std::numeric_limits<float>::max_digits10;
-    os << std::uppercase << std::scientific << std::setprecision(precision)
-       << value;
-    std::string strValue = os.str();
-
-    // remove any + in scientific notation to meet SICD XML standard
-    size_t plusPos = strValue.find("+");
-    if (plusPos != std::string::npos)
-    {
-        strValue.erase(plusPos, 1);
-    }
-    return strValue;
+    return six::formatScientific(value);
 }
 
 template <>
@@ -130,19 +119,7 @@ std::string six::toString<double>(const double& value)
                 Ctxt("Attempted use of uninitialized double value"));
     }
 
-    std::ostringstream os;
-    size_t precision = std::numeric_limits<double>::max_digits10;
-    os << std::uppercase << std::scientific << std::setprecision(precision)
-       << value;
-    std::string strValue = os.str();
-
-    // remove any + in scientific notation to meet SICD XML standard
-    size_t plusPos = strValue.find("+");
-    if (plusPos != std::string::npos)
-    {
-        strValue.erase(plusPos, 1);
-    }
-    return strValue;
+    return six::formatScientific(value);
 }
 
 template <>
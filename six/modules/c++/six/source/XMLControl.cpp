@@ -21,8 +21,15 @@
  */
 
 #include <logging/NullLogger.h>
+#include <six/Instrumentation.h>
 #include <six/XMLControl.h>
 
+namespace
+{
+const size_t VALIDATE_POINT =
+        six::Instrumentation::registerPoint("six::XMLControl::validate");
+}
+
 namespace six
 {
 XMLControl::XMLControl(logging::Logger* log, bool ownLog) :
@@ -64,6 +71,21 @@ void XMLControl::validate(const xml::lite::Document* doc,
                           const std::vector<std::string>& schemaPaths,
                           logging::Logger* log)
 {
+    // Pretty-print so that lines numbers are useful
+    io::StringStream xmlStream;
+    doc->getRootElement()->prettyPrint(xmlStream);
+
+    validate(xmlStream.stream().str(), doc->getRootElement()->getUri(),
+             schemaPaths, log);
+}
+
+void XMLControl::validate(const std::string& xml,
+                          const std::string& uri,
+                          const std::vector<std::string>& schemaPaths,
+                          logging::Logger* log)
+{
+    InstrumentationTimer timer(VALIDATE_POINT, xml.size());
+
     // attempt to get the schema location from the
     // environment if nothing is specified
     std::vector<std::string> paths(schemaPaths);
@@ -84,22 +106,18 @@ void XMLControl::validate(const xml::lite::Document* doc,
     // validate against any specified schemas
     if (!paths.empty())
     {
-        xml::lite::Validator validator(paths, log, true);
-
-        std::vector<xml::lite::ValidationInfo> errors;
-
-        if (doc->getRootElement()->getUri().empty())
+        if (uri.empty())
         {
             throw six::DESValidationException(Ctxt(
                     "INVALID XML: URI is empty so document version cannot be "
                     "determined to use for validation"));
         }
 
-        // Pretty-print so that lines numbers are useful
-        io::StringStream xmlStream;
-        doc->getRootElement()->prettyPrint(xmlStream);
+        xml::lite::Validator validator(paths, log, true);
+
+        std::vector<xml::lite::ValidationInfo> errors;
 
-        validator.validate(xmlStream, doc->getRootElement()->getUri(), errors);
+        validator.validate(xml, uri, errors);
 
         // log any error found and throw
         if (!errors.empty())
@@ -187,6 +205,36 @@ xml::lite::Document* XMLControl::toXML(
     return doc;
 }
 
+void XMLControl::toXML(const Data* data,
+                       const std::vector<std::string>& schemaPaths,
+                       io::OutputStream& stream)
+{
+    std::vector<std::string> paths(schemaPaths);
+    loadSchemaPaths(paths);
+
+    // Only validation needs a pretty-printed copy, as in validate().  It's
+    // written in the same pass as the XML itself.
+    XMLStreamWriter writer(stream);
+    io::StringStream prettyStream;
+    if (!paths.empty())
+    {
+        writer.addOutput(prettyStream, "    ");
+    }
+    toXMLImpl(data, writer);
+
+    if (!paths.empty())
+    {
+        validate(prettyStream.stream().str(), writer.getRootURI(), paths,
+                 mLog);
+    }
+}
+
+void XMLControl::toXMLImpl(const Data* data, XMLStreamWriter& writer)
+{
+    const std::auto_ptr<xml::lite::Document> doc(toXMLImpl(data));
+    writer.write(*doc->getRootElement());
+}
+
 Data* XMLControl::fromXML(const xml::lite::Document* doc,
                           const std::vector<std::string>& schemaPaths)
 {
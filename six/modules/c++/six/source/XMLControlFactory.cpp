@@ -92,11 +92,8 @@ std::string six::toValidXMLString(const Data* data,
         xmlControl(xmlRegistry->newXMLControl(data->getDataType(), log));
 
     // this will validate if SIX_SCHEMA_PATH EnvVar is set
-    const std::auto_ptr<xml::lite::Document> doc(
-        xmlControl->toXML(data, schemaPaths));
-
     io::StringStream oss;
-    doc->getRootElement()->print(oss);
+    xmlControl->toXML(data, schemaPaths, oss);
 
     return oss.stream().str();
 }
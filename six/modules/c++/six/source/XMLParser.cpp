@@ -41,7 +41,8 @@ XMLParser::XMLParser(const std::string& defaultURI,
     mDefaultURI(defaultURI),
     mAddClassAttributes(addClassAttributes),
     mLog(NULL),
-    mOwnLog(false)
+    mOwnLog(false),
+    mXMLWriter(NULL)
 {
     setLogger(log, ownLog);
 }
@@ -74,9 +75,14 @@ void XMLParser::setLogger(logging::Logger* log, bool own)
     }
 }
 
+void XMLParser::setXMLWriter(XMLStreamWriter* writer)
+{
+    mXMLWriter = writer;
+}
+
 XMLElem XMLParser::newElement(const std::string& name, XMLElem parent) const
 {
-    return newElement(name, mDefaultURI, parent);
+    return createElement(name, mDefaultURI, parent);
 }
 
 XMLElem XMLParser::newElement(const std::string& name,
@@ -95,10 +101,57 @@ XMLElem XMLParser::newElement(const std::string& name,
     return elem;
 }
 
+XMLElem XMLParser::createElement(const std::string& name,
+        XMLElem parent) const
+{
+    return createElement(name, mDefaultURI, parent);
+}
+
+XMLElem XMLParser::createElement(const std::string& name,
+        const std::string& uri, XMLElem parent) const
+{
+    return createElement(name, uri, "", parent);
+}
+
+XMLElem XMLParser::createElement(const std::string& name,
+        const std::string& uri, const std::string& characterData,
+        XMLElem parent) const
+{
+    if (mXMLWriter)
+    {
+        return parent ?
+                mXMLWriter->newElement(name, uri, characterData, parent) :
+                mXMLWriter->newRootElement(name, uri, characterData,
+                                           getNamespacePrefixes());
+    }
+
+    return newElement(name, uri, characterData, parent);
+}
+
+XMLStreamWriter::Namespaces XMLParser::getNamespacePrefixes() const
+{
+    return XMLStreamWriter::Namespaces(
+            1, std::make_pair(std::string(), mDefaultURI));
+}
+
+void XMLParser::setNamespacePrefixes(XMLElem root) const
+{
+    // A writer declares these as it writes the root
+    if (!mXMLWriter)
+    {
+        const XMLStreamWriter::Namespaces namespaces = getNamespacePrefixes();
+        for (size_t ii = 0; ii < namespaces.size(); ++ii)
+        {
+            root->setNamespacePrefix(namespaces[ii].first,
+                                     namespaces[ii].second);
+        }
+    }
+}
+
 XMLElem XMLParser::createString(const std::string& name,
         const std::string& uri, const std::string& p, XMLElem parent) const
 {
-    XMLElem const elem = newElement(name, uri, p, parent);
+    XMLElem const elem = createElement(name, uri, p, parent);
     if (mAddClassAttributes)
     {
         xml::lite::AttributeNode node;
@@ -123,7 +176,7 @@ XMLElem XMLParser::createInt(const std::string& name, const std::string& uri,
     std::string elementValue;
     try
     {
-        elementValue = six::toString<int>(p);
+        elementValue = six::formatNumber<int>(p);
     }
     catch (const except::Exception& ex)
     {
@@ -131,7 +184,7 @@ XMLElem XMLParser::createInt(const std::string& name, const std::string& uri,
                 + parent->getLocalName() + ": " + ex.getMessage());
         throw except::Exception(Ctxt(message));
     }
-    XMLElem const elem = newElement(name, uri, elementValue, parent);
+    XMLElem const elem = createElement(name, uri, elementValue, parent);
     if (mAddClassAttributes)
     {
         xml::lite::AttributeNode node;
@@ -147,7 +200,7 @@ XMLElem XMLParser::createInt(const std::string& name, const std::string& uri,
 XMLElem XMLParser::createInt(const std::string& name, const std::string& uri,
         const std::string& p, XMLElem parent) const
 {
-    XMLElem const elem = newElement(name, uri, p, parent);
+    XMLElem const elem = createElement(name, uri, p, parent);
     if (mAddClassAttributes)
     {
         xml::lite::AttributeNode node;
@@ -179,7 +232,7 @@ XMLElem XMLParser::createDouble(const std::string& name,
                 + parent->getLocalName() + ": " + ex.getMessage());
         throw except::Exception(Ctxt(message));
     }
-    XMLElem elem = newElement(name, uri, elementValue, parent);
+    XMLElem elem = createElement(name, uri, elementValue, parent);
     if (mAddClassAttributes)
     {
         xml::lite::AttributeNode node;
@@ -207,7 +260,7 @@ XMLElem XMLParser::createBooleanType(const std::string& name,
     }
 
     XMLElem const elem =
-            newElement(name, uri, six::toString<BooleanType>(p), parent);
+            createElement(name, uri, six::toString<BooleanType>(p), parent);
     if (mAddClassAttributes)
     {
         xml::lite::AttributeNode node;
@@ -229,7 +282,7 @@ XMLElem XMLParser::createBooleanType(const std::string& name, BooleanType p,
 XMLElem XMLParser::createDateTime(const std::string& name,
         const std::string& uri, const std::string& s, XMLElem parent) const
 {
-    XMLElem elem = newElement(name, uri, s, parent);
+    XMLElem elem = createElement(name, uri, s, parent);
     if (mAddClassAttributes)
     {
         xml::lite::AttributeNode node;
@@ -263,7 +316,7 @@ XMLElem XMLParser::createDateTime(const std::string& name, const DateTime& p,
 XMLElem XMLParser::createDate(const std::string& name,
         const std::string& uri, const DateTime& p, XMLElem parent) const
 {
-    XMLElem const elem = newElement(name, uri, p.format("%Y-%m-%d"), parent);
+    XMLElem const elem = createElement(name, uri, p.format("%Y-%m-%d"), parent);
     if (mAddClassAttributes)
     {
         xml::lite::AttributeNode node;
@@ -327,7 +380,7 @@ void XMLParser::parseDouble(XMLElem element, double& value) const
 {
     try
     {
-        value = str::toType<double>(element->getCharacterData());
+        value = six::parseNumber<double>(element->getCharacterData());
     }
     catch (const except::BadCastException& ex)
     {
@@ -0,0 +1,421 @@
+/* =========================================================================
+ * This file is part of six-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <sys/Conf.h>
+#include <except/Exception.h>
+#include <six/XMLStreamWriter.h>
+
+namespace
+{
+void deleteElements(std::vector<xml::lite::Element*>& elements)
+{
+    for (size_t ii = 0; ii < elements.size(); ++ii)
+    {
+        delete elements[ii];
+    }
+    elements.clear();
+}
+}
+
+namespace six
+{
+XMLStreamWriter::XMLStreamWriter(io::OutputStream& stream,
+                                 const std::string& formatter) :
+    mRootStartTagWritten(false)
+{
+    addOutput(stream, formatter);
+}
+
+XMLStreamWriter::~XMLStreamWriter()
+{
+    for (size_t ii = 0; ii < mOpen.size(); ++ii)
+    {
+        deleteElements(mOpen[ii].closedChildren);
+        if (ii > 0)
+        {
+            delete mOpen[ii].element;
+        }
+    }
+}
+
+void XMLStreamWriter::addOutput(io::OutputStream& stream,
+                                const std::string& formatter)
+{
+    if (!mOpen.empty() || mRootStartTagWritten)
+    {
+        throw except::Exception(Ctxt(
+                "Outputs must be added before writing any elements"));
+    }
+
+    Output output;
+    output.stream = &stream;
+    output.formatter = formatter;
+    mOutputs.push_back(output);
+}
+
+xml::lite::Element* XMLStreamWriter::newRootElement(
+        const std::string& name,
+        const std::string& uri,
+        const std::string& characterData,
+        const Namespaces& namespaces)
+{
+    if (!mOpen.empty() || mRootStartTagWritten)
+    {
+        throw except::Exception(Ctxt(
+                "Root element <" + name + "> is not the first element"));
+    }
+
+    mNamespaces = namespaces;
+    mRootURI = uri;
+
+    openElement(new xml::lite::Element(name, uri, characterData));
+    return mOpen.back().element;
+}
+
+xml::lite::Element* XMLStreamWriter::newElement(
+        const std::string& name,
+        const std::string& uri,
+        const std::string& characterData,
+        xml::lite::Element* parent)
+{
+    closeUntil(parent);
+
+    openElement(new xml::lite::Element(name, uri, characterData));
+    return mOpen.back().element;
+}
+
+void XMLStreamWriter::openElement(xml::lite::Element* element)
+{
+    std::auto_ptr<xml::lite::Element> scopedElement(element);
+    mOpen.push_back(OpenElement());
+    mOpen.back().content.resize(mOutputs.size());
+    mOpen.back().element = scopedElement.release();
+}
+
+void XMLStreamWriter::checkOpen(const xml::lite::Element* element) const
+{
+    // The root's start tag goes out with its first child
+    bool isOpen = !mOpen.empty() && element == mOpen[0].element &&
+            !mRootStartTagWritten;
+
+    for (size_t ii = 1; ii < mOpen.size() && !isOpen; ++ii)
+    {
+        isOpen = mOpen[ii].element == element;
+    }
+
+    if (!isOpen)
+    {
+        throw except::Exception(Ctxt("XML element <" +
+                element->getQName() + "> has already been written"));
+    }
+}
+
+void XMLStreamWriter::closeUntil(const xml::lite::Element* element)
+{
+    size_t depth = mOpen.size();
+    while (depth > 0 && mOpen[depth - 1].element != element)
+    {
+        --depth;
+    }
+
+    if (depth == 0)
+    {
+        throw except::Exception(Ctxt("Parent element <" +
+                (element ? element->getQName() : std::string()) +
+                "> is not open for writing"));
+    }
+
+    while (mOpen.size() > depth)
+    {
+        closeTop();
+    }
+}
+
+void XMLStreamWriter::closeTop()
+{
+    OpenElement& top = mOpen.back();
+    const size_t depth = mOpen.size() - 1;
+    const xml::lite::Element& element = *top.element;
+
+    const std::string qname = getQName(element);
+    std::string startTag;
+    appendStartTag(element, qname, false, startTag);
+    const std::string characterData = element.getCharacterData();
+    const bool isEmpty = characterData.empty() && !top.hasChildren;
+
+    // Children of the root go straight to the stream.  Anything deeper is
+    // held by its parent, which may still get attributes.
+    std::vector<std::string> rootChildText(depth == 1 ? mOutputs.size() : 0);
+    for (size_t ii = 0; ii < mOutputs.size(); ++ii)
+    {
+        std::string& text = (depth == 1) ? rootChildText[ii] :
+                                           mOpen[depth - 1].content[ii];
+
+        appendIndent(ii, depth, text);
+        text += startTag;
+        if (isEmpty)
+        {
+            text += "/>";
+        }
+        else
+        {
+            text += ">";
+            text += characterData;
+            text += top.content[ii];
+            if (top.hasChildren)
+            {
+                appendIndent(ii, depth, text);
+            }
+            text += "</";
+            text += qname;
+            text += ">";
+        }
+    }
+
+    deleteElements(top.closedChildren);
+    xml::lite::Element* const closed = top.element;
+    mOpen.pop_back();
+
+    OpenElement& parent = mOpen.back();
+    parent.hasChildren = true;
+    parent.closedChildren.push_back(closed);
+
+    if (depth == 1)
+    {
+        writeRootStartTag();
+        for (size_t ii = 0; ii < mOutputs.size(); ++ii)
+        {
+            write(ii, rootChildText[ii]);
+        }
+    }
+}
+
+void XMLStreamWriter::close()
+{
+    if (mOpen.empty())
+    {
+        return;
+    }
+
+    while (mOpen.size() > 1)
+    {
+        closeTop();
+    }
+
+    const OpenElement& root = mOpen[0];
+    const std::string qname = getQName(*root.element);
+    const bool isEmpty = !mRootStartTagWritten &&
+            root.element->getCharacterData().empty();
+    std::string endTag;
+    if (isEmpty)
+    {
+        appendStartTag(*root.element, qname, true, endTag);
+        endTag += "/>";
+        mRootStartTagWritten = true;
+    }
+    else
+    {
+        writeRootStartTag();
+        endTag += "</";
+        endTag += qname;
+        endTag += ">";
+    }
+
+    for (size_t ii = 0; ii < mOutputs.size(); ++ii)
+    {
+        std::string text;
+        if (root.hasChildren)
+        {
+            appendIndent(ii, 0, text);
+        }
+        text += endTag;
+
+        // Element::prettyPrint() ends with a newline
+        if (!mOutputs[ii].formatter.empty())
+        {
+            text += "\n";
+        }
+        write(ii, text);
+    }
+
+    deleteElements(mOpen[0].closedChildren);
+    mOpen.clear();
+}
+
+void XMLStreamWriter::write(const xml::lite::Element& root)
+{
+    mRootURI = root.getUri();
+    for (size_t ii = 0; ii < mOutputs.size(); ++ii)
+    {
+        if (mOutputs[ii].formatter.empty())
+        {
+            root.print(*mOutputs[ii].stream);
+        }
+        else
+        {
+            root.prettyPrint(*mOutputs[ii].stream, mOutputs[ii].formatter);
+        }
+    }
+}
+
+void XMLStreamWriter::appendIndent(size_t output,
+                                   size_t depth,
+                                   std::string& text) const
+{
+    const std::string& formatter = mOutputs[output].formatter;
+    if (!formatter.empty())
+    {
+        text += "\n";
+        for (size_t ii = 0; ii < depth; ++ii)
+        {
+            text += formatter;
+        }
+    }
+}
+
+const std::string* XMLStreamWriter::findPrefix(const std::string& uri) const
+{
+    // Matches what xml::lite::Element::setNamespacePrefix() does to the DOM,
+    // where later declarations win
+    for (size_t ii = mNamespaces.size(); ii > 0; --ii)
+    {
+        if (mNamespaces[ii - 1].second == uri)
+        {
+            return &mNamespaces[ii - 1].first;
+        }
+    }
+    return NULL;
+}
+
+std::string XMLStreamWriter::getQName(const xml::lite::Element& element) const
+{
+    const std::string* const prefix = findPrefix(element.getUri());
+    if (!prefix)
+    {
+        return element.getQName();
+    }
+    return prefix->empty() ? element.getLocalName() :
+                             *prefix + ":" + element.getLocalName();
+}
+
+std::string
+XMLStreamWriter::getQName(const xml::lite::AttributeNode& attribute) const
+{
+    const std::string* const prefix = findPrefix(attribute.getUri());
+    if (!prefix)
+    {
+        return attribute.getQName();
+    }
+    return prefix->empty() ? attribute.getLocalName() :
+                             *prefix + ":" + attribute.getLocalName();
+}
+
+void XMLStreamWriter::appendStartTag(const xml::lite::Element& element,
+                                     const std::string& qname,
+                                     bool isRoot,
+                                     std::string& text) const
+{
+    text += "<";
+    text += qname;
+
+    std::vector<std::pair<std::string, std::string> > attributes;
+    const xml::lite::Attributes& elementAttributes = element.getAttributes();
+    for (int ii = 0; ii < elementAttributes.getLength(); ++ii)
+    {
+        const xml::lite::AttributeNode& node = elementAttributes[ii];
+
+        // Declaring a namespace on the root removes any other declarations
+        // of it from the document
+        bool isRedeclared = false;
+        if (node.getPrefix() == "xmlns")
+        {
+            for (size_t jj = 0; jj < mNamespaces.size(); ++jj)
+            {
+                isRedeclared = isRedeclared ||
+                        mNamespaces[jj].second == node.getValue();
+            }
+        }
+
+        if (!isRedeclared)
+        {
+            attributes.push_back(std::make_pair(getQName(node),
+                                                node.getValue()));
+        }
+    }
+
+    if (isRoot)
+    {
+        for (size_t ii = 0; ii < mNamespaces.size(); ++ii)
+        {
+            std::string name("xmlns");
+            if (!mNamespaces[ii].first.empty())
+            {
+                name += ":" + mNamespaces[ii].first;
+            }
+
+            size_t jj = 0;
+            while (jj < attributes.size() && attributes[jj].first != name)
+            {
+                ++jj;
+            }
+            if (jj == attributes.size())
+            {
+                attributes.push_back(std::make_pair(name, ""));
+            }
+            attributes[jj].second = mNamespaces[ii].second;
+        }
+    }
+
+    for (size_t ii = 0; ii < attributes.size(); ++ii)
+    {
+        text += " ";
+        text += attributes[ii].first;
+        text += "=\"";
+        text += attributes[ii].second;
+        text += "\"";
+    }
+}
+
+void XMLStreamWriter::writeRootStartTag()
+{
+    if (!mRootStartTagWritten)
+    {
+        const xml::lite::Element& root = *mOpen[0].element;
+        std::string text;
+        appendStartTag(root, getQName(root), true, text);
+        text += ">";
+        text += root.getCharacterData();
+        for (size_t ii = 0; ii < mOutputs.size(); ++ii)
+        {
+            write(ii, text);
+        }
+        mRootStartTagWritten = true;
+    }
+}
+
+void XMLStreamWriter::write(size_t output, const std::string& text)
+{
+    if (!text.empty())
+    {
+        mOutputs[output].stream->write(text.data(), text.length());
+    }
+}
+}
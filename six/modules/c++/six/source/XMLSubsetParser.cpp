@@ -0,0 +1,99 @@
+/* =========================================================================
+ * This file is part of six-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <six/XMLSubsetParser.h>
+
+namespace six
+{
+XMLSubsetParser::Handler::Handler(
+        const std::vector<std::string>& elementNames) :
+    mElementNames(elementNames.begin(), elementNames.end()),
+    mDepth(0),
+    mSkipDepth(0)
+{
+    // Same as six::parseData()
+    preserveCharacterData(true);
+}
+
+void XMLSubsetParser::Handler::characters(const char* value, int length)
+{
+    if (isKept())
+    {
+        xml::lite::MinidomHandler::characters(value, length);
+    }
+}
+
+void XMLSubsetParser::Handler::startElement(
+        const std::string& uri,
+        const std::string& localName,
+        const std::string& qname,
+        const xml::lite::Attributes& atts)
+{
+    ++mDepth;
+    if (!isKept())
+    {
+        ++mSkipDepth;
+    }
+    else if (mDepth == 2 && !mElementNames.empty() &&
+             mElementNames.find(localName) == mElementNames.end())
+    {
+        mSkipDepth = 1;
+    }
+    else
+    {
+        xml::lite::MinidomHandler::startElement(uri, localName, qname, atts);
+    }
+}
+
+void XMLSubsetParser::Handler::endElement(const std::string& uri,
+                                          const std::string& localName,
+                                          const std::string& qname)
+{
+    --mDepth;
+    if (isKept())
+    {
+        xml::lite::MinidomHandler::endElement(uri, localName, qname);
+    }
+    else
+    {
+        --mSkipDepth;
+    }
+}
+
+XMLSubsetParser::XMLSubsetParser(
+        const std::vector<std::string>& elementNames) :
+    mHandler(elementNames)
+{
+    mReader.setContentHandler(&mHandler);
+}
+
+void XMLSubsetParser::parse(io::InputStream& is, int size)
+{
+    mReader.parse(is, size);
+}
+
+std::auto_ptr<xml::lite::Document> XMLSubsetParser::releaseDocument()
+{
+    std::auto_ptr<xml::lite::Document> doc(mHandler.getDocument(true));
+    mHandler.setDocument(new xml::lite::Document());
+    return doc;
+}
+}
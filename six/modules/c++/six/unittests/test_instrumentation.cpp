@@ -0,0 +1,193 @@
+/* =========================================================================
+ * This file is part of six-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <sstream>
+#include <string>
+
+#include "TestCase.h"
+#include <mt/ThreadGroup.h>
+#include <sys/Runnable.h>
+#include <six/Instrumentation.h>
+
+namespace
+{
+class HitRunnable : public sys::Runnable
+{
+public:
+    HitRunnable(size_t point, size_t numHits) :
+        mPoint(point),
+        mNumHits(numHits)
+    {
+    }
+
+    virtual void run()
+    {
+        for (size_t ii = 0; ii < mNumHits; ++ii)
+        {
+            six::InstrumentationTimer timer(mPoint, 10);
+            timer.addSeeks(1);
+        }
+    }
+
+private:
+    const size_t mPoint;
+    const size_t mNumHits;
+};
+
+// Registers a new point and hits it, over and over
+class RegisterRunnable : public sys::Runnable
+{
+public:
+    RegisterRunnable(size_t threadNum, size_t numPoints) :
+        mThreadNum(threadNum),
+        mNumPoints(numPoints)
+    {
+    }
+
+    virtual void run()
+    {
+        for (size_t ii = 0; ii < mNumPoints; ++ii)
+        {
+            std::ostringstream name;
+            name << "test::register" << mThreadNum << "_" << ii;
+            six::InstrumentationTimer timer(
+                    six::Instrumentation::registerPoint(name.str()), 1);
+        }
+    }
+
+private:
+    const size_t mThreadNum;
+    const size_t mNumPoints;
+};
+
+TEST_CASE(RegisterPoint)
+{
+    const size_t first = six::Instrumentation::registerPoint("test::first");
+    const size_t second = six::Instrumentation::registerPoint("test::second");
+    TEST_ASSERT_NOT_EQ(first, second);
+    TEST_ASSERT_EQ(six::Instrumentation::registerPoint("test::first"), first);
+}
+
+TEST_CASE(DisabledRecordsNothing)
+{
+    six::Instrumentation::reset();
+    six::Instrumentation::enable(false);
+    const size_t point = six::Instrumentation::registerPoint("test::disabled");
+    {
+        six::InstrumentationTimer timer(point, 100);
+    }
+    TEST_ASSERT_TRUE(six::Instrumentation::snapshot().points.empty());
+}
+
+TEST_CASE(Counters)
+{
+    six::Instrumentation::reset();
+    six::Instrumentation::enable();
+    const size_t point = six::Instrumentation::registerPoint("test::counters");
+    {
+        six::InstrumentationTimer timer(point, 100);
+        timer.addBytes(20);
+        timer.addSeeks(3);
+    }
+    {
+        six::InstrumentationTimer timer(point);
+    }
+    six::Instrumentation::enable(false);
+
+    const six::InstrumentationSnapshot snapshot =
+            six::Instrumentation::snapshot();
+    TEST_ASSERT_EQ(snapshot.points.size(), static_cast<size_t>(1));
+    const six::InstrumentationCounters& counters =
+            snapshot.points.find("test::counters")->second;
+    TEST_ASSERT_EQ(counters.calls, static_cast<sys::Uint64_T>(2));
+    TEST_ASSERT_EQ(counters.bytes, static_cast<sys::Uint64_T>(120));
+    TEST_ASSERT_EQ(counters.seeks, static_cast<sys::Uint64_T>(3));
+    TEST_ASSERT_TRUE(counters.elapsedMs >= counters.maxMs);
+    TEST_ASSERT_TRUE(counters.maxMs >= 0);
+
+    std::ostringstream os;
+    os << snapshot;
+    TEST_ASSERT_EQ(os.str().find("test::counters calls=2 "),
+                   static_cast<size_t>(0));
+    TEST_ASSERT_TRUE(os.str().find(" bytes=120 seeks=3\n") !=
+                     std::string::npos);
+
+    six::Instrumentation::reset();
+    TEST_ASSERT_TRUE(six::Instrumentation::snapshot().points.empty());
+}
+
+TEST_CASE(Threads)
+{
+    six::Instrumentation::reset();
+    six::Instrumentation::enable();
+    const size_t point = six::Instrumentation::registerPoint("test::threads");
+    const size_t numThreads = 8;
+    const size_t numHits = 1000;
+    mt::ThreadGroup threads;
+    for (size_t ii = 0; ii < numThreads; ++ii)
+    {
+        threads.createThread(new HitRunnable(point, numHits));
+    }
+    threads.joinAll();
+    six::Instrumentation::enable(false);
+
+    const six::InstrumentationCounters counters =
+            six::Instrumentation::snapshot().points["test::threads"];
+    TEST_ASSERT_EQ(counters.calls,
+                   static_cast<sys::Uint64_T>(numThreads * numHits));
+    TEST_ASSERT_EQ(counters.bytes,
+                   static_cast<sys::Uint64_T>(numThreads * numHits * 10));
+    TEST_ASSERT_EQ(counters.seeks,
+                   static_cast<sys::Uint64_T>(numThreads * numHits));
+}
+
+TEST_CASE(SnapshotWhileRegistering)
+{
+    six::Instrumentation::reset();
+    six::Instrumentation::enable();
+    const size_t numThreads = 4;
+    const size_t numPoints = 500;
+    mt::ThreadGroup threads;
+    for (size_t ii = 0; ii < numThreads; ++ii)
+    {
+        threads.createThread(new RegisterRunnable(ii, numPoints));
+    }
+    for (size_t ii = 0; ii < 200; ++ii)
+    {
+        six::Instrumentation::snapshot();
+    }
+    threads.joinAll();
+    six::Instrumentation::enable(false);
+
+    TEST_ASSERT_EQ(six::Instrumentation::snapshot().points.size(),
+                   numThreads * numPoints);
+}
+}
+
+int main(int, char**)
+{
+    TEST_CHECK(RegisterPoint);
+    TEST_CHECK(DisabledRecordsNothing);
+    TEST_CHECK(Counters);
+    TEST_CHECK(Threads);
+    TEST_CHECK(SnapshotWhileRegistering);
+    return 0;
+}
@@ -0,0 +1,176 @@
+/* =========================================================================
+ * This file is part of six-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <string.h>
+#include <stdlib.h>
+
+#include <vector>
+
+#include "TestCase.h"
+#include <six/LUTUtils.h>
+
+namespace
+{
+six::LUT makeRGBLUT(size_t numEntries)
+{
+    six::LUT lut(numEntries, 3);
+    for (size_t ii = 0; ii < numEntries; ++ii)
+    {
+        lut[ii][0] = static_cast<unsigned char>(ii);
+        lut[ii][1] = static_cast<unsigned char>(255 - ii);
+        lut[ii][2] = static_cast<unsigned char>(ii * 7);
+    }
+    return lut;
+}
+
+six::LUT makeMonoLUT(const std::vector<sys::Uint16_T>& values)
+{
+    six::LUT lut(values.size(), sizeof(sys::Uint16_T));
+    for (size_t ii = 0; ii < values.size(); ++ii)
+    {
+        ::memcpy(lut[ii], &values[ii], sizeof(sys::Uint16_T));
+    }
+    return lut;
+}
+
+bool expandMatches(const six::LUT& lut, size_t numPixels, size_t numThreads)
+{
+    std::vector<six::UByte> indices(numPixels);
+    for (size_t ii = 0; ii < numPixels; ++ii)
+    {
+        indices[ii] = static_cast<six::UByte>(rand() % 256);
+    }
+
+    // Pad the output so we can check nothing is written past the end
+    const size_t numBytes = numPixels * lut.elementSize;
+    std::vector<six::UByte> output(numBytes + 8, 0xAB);
+    six::applyLUT(indices.empty() ? NULL : &indices[0], numPixels, lut,
+                  numThreads, &output[0]);
+
+    for (size_t ii = 0; ii < numPixels; ++ii)
+    {
+        for (size_t jj = 0; jj < lut.elementSize; ++jj)
+        {
+            const six::UByte expected = indices[ii] < lut.numEntries ?
+                    lut[indices[ii]][jj] : 0;
+            if (output[ii * lut.elementSize + jj] != expected)
+            {
+                return false;
+            }
+        }
+    }
+    for (size_t ii = numBytes; ii < output.size(); ++ii)
+    {
+        if (output[ii] != 0xAB)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+}
+
+TEST_CASE(ExpandRGB)
+{
+    const six::LUT lut(makeRGBLUT(256));
+    TEST_ASSERT_TRUE(expandMatches(lut, 0, 1));
+    TEST_ASSERT_TRUE(expandMatches(lut, 1, 1));
+    TEST_ASSERT_TRUE(expandMatches(lut, 7, 1));
+    TEST_ASSERT_TRUE(expandMatches(lut, 1001, 1));
+    TEST_ASSERT_TRUE(expandMatches(lut, 300007, 4));
+}
+
+TEST_CASE(ExpandShortLUT)
+{
+    // Indices past the end of the LUT should come back as zeros
+    const six::LUT lut(makeRGBLUT(100));
+    TEST_ASSERT_TRUE(expandMatches(lut, 5003, 2));
+}
+
+TEST_CASE(ExpandMono)
+{
+    std::vector<sys::Uint16_T> values(256);
+    for (size_t ii = 0; ii < values.size(); ++ii)
+    {
+        values[ii] = static_cast<sys::Uint16_T>(ii * 257);
+    }
+    const six::LUT lut(makeMonoLUT(values));
+    TEST_ASSERT_TRUE(expandMatches(lut, 70001, 3));
+
+    six::LUT oddLUT(256, 5);
+    for (size_t ii = 0; ii < oddLUT.table.size(); ++ii)
+    {
+        oddLUT.table[ii] = static_cast<unsigned char>(ii);
+    }
+    TEST_ASSERT_TRUE(expandMatches(oddLUT, 1234, 2));
+}
+
+TEST_CASE(InverseLUT)
+{
+    std::vector<sys::Uint16_T> values;
+    values.push_back(1000);
+    values.push_back(0);
+    values.push_back(2000);
+    values.push_back(1000);
+    values.push_back(65535);
+    const six::InverseLUT inverse(makeMonoLUT(values));
+
+    // Exact matches, with duplicates going to the lowest index
+    TEST_ASSERT_EQ(inverse(0), 1);
+    TEST_ASSERT_EQ(inverse(1000), 0);
+    TEST_ASSERT_EQ(inverse(2000), 2);
+    TEST_ASSERT_EQ(inverse(65535), 4);
+
+    // Nearest entry, with ties going to the lowest index
+    TEST_ASSERT_EQ(inverse(499), 1);
+    TEST_ASSERT_EQ(inverse(500), 0);
+    TEST_ASSERT_EQ(inverse(501), 0);
+    TEST_ASSERT_EQ(inverse(1500), 0);
+    TEST_ASSERT_EQ(inverse(1501), 2);
+    TEST_ASSERT_EQ(inverse(60000), 4);
+
+    std::vector<sys::Uint16_T> image(100003);
+    for (size_t ii = 0; ii < image.size(); ++ii)
+    {
+        image[ii] = static_cast<sys::Uint16_T>(rand() % 65536);
+    }
+    std::vector<six::UByte> indices(image.size());
+    inverse.apply(&image[0], image.size(), 4, &indices[0]);
+    for (size_t ii = 0; ii < image.size(); ++ii)
+    {
+        TEST_ASSERT_EQ(indices[ii], inverse(image[ii]));
+    }
+}
+
+TEST_CASE(InverseLUTRejectsRGB)
+{
+    TEST_EXCEPTION(six::InverseLUT(makeRGBLUT(256)));
+}
+
+int main(int, char**)
+{
+    TEST_CHECK(ExpandRGB);
+    TEST_CHECK(ExpandShortLUT);
+    TEST_CHECK(ExpandMono);
+    TEST_CHECK(InverseLUT);
+    TEST_CHECK(InverseLUTRejectsRGB);
+    return 0;
+}
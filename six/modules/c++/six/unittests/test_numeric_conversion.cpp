@@ -0,0 +1,296 @@
+/* =========================================================================
+ * This file is part of six-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <locale.h>
+#include <string.h>
+
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+#include <sys/Conf.h>
+#include <six/NumericConversion.h>
+#include <six/Parameter.h>
+#include "TestCase.h"
+
+namespace
+{
+// Every bit pattern that isn't NaN or infinity, spread across all exponents
+double nextDouble(sys::Uint64_T& state)
+{
+    while (true)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        double value;
+        ::memcpy(&value, &state, sizeof(value));
+        if (value - value == 0)
+        {
+            return value;
+        }
+    }
+}
+
+// How six::toString<double> used to write xs:double values
+template <typename T>
+std::string iostreamScientific(T value)
+{
+    std::ostringstream os;
+    os << std::uppercase << std::scientific
+       << std::setprecision(std::numeric_limits<T>::max_digits10) << value;
+    std::string str = os.str();
+    const size_t plusPos = str.find("+");
+    if (plusPos != std::string::npos)
+    {
+        str.erase(plusPos, 1);
+    }
+    return str;
+}
+
+// Distinguishes 0 from -0
+template <typename T>
+bool identical(T lhs, T rhs)
+{
+    return ::memcmp(&lhs, &rhs, sizeof(T)) == 0;
+}
+
+// parseNumber<T>() should accept and reject the same strings as
+// str::toType<T>(), with the same result
+template <typename T>
+bool parsesLikeToType(const std::string& s)
+{
+    bool toTypeThrew = false;
+    T expected = T();
+    try
+    {
+        expected = str::toType<T>(s);
+    }
+    catch (const except::BadCastException&)
+    {
+        toTypeThrew = true;
+    }
+
+    try
+    {
+        const T value = six::parseNumber<T>(s);
+        return !toTypeThrew && identical(value, expected);
+    }
+    catch (const except::BadCastException&)
+    {
+        return toTypeThrew;
+    }
+}
+
+const char* const PARSE_INPUTS[] = {
+    "0", "-0", "+3", "42", "00012", " 17 ", "\t\n42\n", "-17",
+    "1.5", " 1.5", "1.5 ", "1.5abc", "1.5 2.5", "1.2.3", "1,5", ".5", "5.",
+    "+.5", "-.5", ".", "-", "+", "", "   ", "abc", "e5", "1e", "1e+",
+    "1e+5", "1E-01", "1.5E-01", "\n   -3E08  ", "1e5e3", "1.e3",
+    "0x10", "0x1p3", "inf", "-inf", "nan", "1E999", "-1E999", "1E-999",
+    "1E-320", "3.4028235e38", "3.4028236e38", "1e-46",
+    "1.7976931348623157e308", "1.7976931348623159e308",
+    "00000000000000000000000000000000000000001.5",
+    "0.0000000000000000000000000000000000000000000000000000000000001",
+    "123456789012345678901234567890", "1e100000000000000000000",
+    "127", "128", "-129", "255", "256", "-1", "-256",
+    "32767", "32768", "-32768", "-32769", "65535", "65536", "-65535",
+    "-65536", "70000", "2147483647", "2147483648", "-2147483648",
+    "-2147483649", "3000000000", "4294967295", "4294967296",
+    "-4294967295", "-4294967296", "9223372036854775807",
+    "9223372036854775808", "-9223372036854775808", "-9223372036854775809",
+    "18446744073709551615", "18446744073709551616",
+    "-18446744073709551615", "-18446744073709551616"};
+
+TEST_CASE(testFormatMatchesIostreams)
+{
+    const double doubles[] = {0.0, -0.0, 0.1, -2.5, 100.0, 1.0 / 3.0,
+                              299792458.0, 1e-5, 1e16, 1e17, 123456789.0,
+                              std::numeric_limits<double>::max(),
+                              std::numeric_limits<double>::min(),
+                              std::numeric_limits<double>::denorm_min(),
+                              std::numeric_limits<double>::epsilon(),
+                              std::numeric_limits<double>::infinity(),
+                              -std::numeric_limits<double>::infinity(),
+                              std::numeric_limits<double>::quiet_NaN()};
+    for (size_t ii = 0; ii < sizeof(doubles) / sizeof(doubles[0]); ++ii)
+    {
+        TEST_ASSERT_EQ(six::formatNumber(doubles[ii]),
+                       str::toString(doubles[ii]));
+        TEST_ASSERT_EQ(six::formatScientific(doubles[ii]),
+                       iostreamScientific(doubles[ii]));
+
+        const float floatValue = static_cast<float>(doubles[ii]);
+        TEST_ASSERT_EQ(six::formatNumber(floatValue),
+                       str::toString(floatValue));
+        TEST_ASSERT_EQ(six::formatScientific(floatValue),
+                       iostreamScientific(floatValue));
+    }
+
+    sys::Uint64_T state = 54321;
+    for (size_t ii = 0; ii < 20000; ++ii)
+    {
+        const double value = nextDouble(state);
+        TEST_ASSERT_EQ(six::formatNumber(value), str::toString(value));
+        TEST_ASSERT_EQ(six::formatScientific(value),
+                       iostreamScientific(value));
+
+        const float floatValue = static_cast<float>(value);
+        TEST_ASSERT_EQ(six::formatNumber(floatValue),
+                       str::toString(floatValue));
+        TEST_ASSERT_EQ(six::formatScientific(floatValue),
+                       iostreamScientific(floatValue));
+    }
+
+    TEST_ASSERT_EQ(six::formatScientific(0.1), "1.00000000000000006E-01");
+    TEST_ASSERT_EQ(six::formatScientific(3e8), "3.00000000000000000E08");
+    TEST_ASSERT_EQ(six::formatNumber(-42), "-42");
+    TEST_ASSERT_EQ(six::formatNumber(std::numeric_limits<sys::Uint64_T>::max()),
+                   "18446744073709551615");
+    TEST_ASSERT_EQ(six::formatNumber(std::numeric_limits<long long>::min()),
+                   str::toString(std::numeric_limits<long long>::min()));
+}
+
+TEST_CASE(testParseMatchesIostreams)
+{
+    for (size_t ii = 0; ii < sizeof(PARSE_INPUTS) / sizeof(PARSE_INPUTS[0]);
+         ++ii)
+    {
+        const std::string input(PARSE_INPUTS[ii]);
+        TEST_ASSERT(parsesLikeToType<double>(input));
+        TEST_ASSERT(parsesLikeToType<float>(input));
+        TEST_ASSERT(parsesLikeToType<short>(input));
+        TEST_ASSERT(parsesLikeToType<unsigned short>(input));
+        TEST_ASSERT(parsesLikeToType<int>(input));
+        TEST_ASSERT(parsesLikeToType<unsigned int>(input));
+        TEST_ASSERT(parsesLikeToType<long>(input));
+        TEST_ASSERT(parsesLikeToType<unsigned long>(input));
+        TEST_ASSERT(parsesLikeToType<long long>(input));
+        TEST_ASSERT(parsesLikeToType<unsigned long long>(input));
+    }
+
+    sys::Uint64_T state = 98765;
+    for (size_t ii = 0; ii < 20000; ++ii)
+    {
+        const double value = nextDouble(state);
+        TEST_ASSERT(parsesLikeToType<double>(six::formatScientific(value)));
+        TEST_ASSERT(parsesLikeToType<double>(six::formatNumber(value)));
+        TEST_ASSERT(parsesLikeToType<float>(six::formatNumber(value)));
+
+        // Fewer digits than it takes to round-trip
+        std::ostringstream os;
+        os << std::setprecision(7) << value;
+        TEST_ASSERT(parsesLikeToType<double>(os.str()));
+        TEST_ASSERT(parsesLikeToType<float>(os.str()));
+    }
+
+    TEST_ASSERT_EQ(six::parseNumber<double>("1.5E-01"), 0.15);
+    TEST_ASSERT_EQ(six::parseNumber<double>("1.5abc"), 1.5);
+    TEST_ASSERT_EQ(six::parseNumber<int>("1.5"), 1);
+    TEST_ASSERT_EQ(six::parseNumber<unsigned int>("-1"),
+                   std::numeric_limits<unsigned int>::max());
+    TEST_EXCEPTION(six::parseNumber<double>("1E999"));
+    TEST_EXCEPTION(six::parseNumber<int>("3000000000"));
+    TEST_EXCEPTION(six::parseNumber<double>("abc"));
+}
+
+TEST_CASE(testRoundTrip)
+{
+    sys::Uint64_T state = 12345;
+    for (size_t ii = 0; ii < 100000; ++ii)
+    {
+        const double value = nextDouble(state);
+        TEST_ASSERT_EQ(six::parseNumber<double>(six::formatNumber(value)),
+                       value);
+        TEST_ASSERT_EQ(six::parseNumber<double>(six::formatScientific(value)),
+                       value);
+
+        const float floatValue = static_cast<float>(value);
+        if (floatValue - floatValue == 0)
+        {
+            TEST_ASSERT_EQ(six::parseNumber<float>(
+                                   six::formatNumber(floatValue)),
+                           floatValue);
+            TEST_ASSERT_EQ(six::parseNumber<float>(
+                                   six::formatScientific(floatValue)),
+                           floatValue);
+        }
+    }
+
+    const double extremes[] = {std::numeric_limits<double>::max(),
+                               std::numeric_limits<double>::min(),
+                               std::numeric_limits<double>::denorm_min(),
+                               std::numeric_limits<double>::epsilon()};
+    for (size_t ii = 0; ii < sizeof(extremes) / sizeof(extremes[0]); ++ii)
+    {
+        TEST_ASSERT_EQ(six::parseNumber<double>(
+                               six::formatScientific(extremes[ii])),
+                       extremes[ii]);
+        TEST_ASSERT_EQ(six::parseNumber<double>(
+                               six::formatScientific(-extremes[ii])),
+                       -extremes[ii]);
+    }
+}
+
+TEST_CASE(testLocale)
+{
+    // Only meaningful where a locale with a decimal comma is installed
+    const char* const locales[] = {"de_DE.UTF-8", "de_DE", "fr_FR.UTF-8"};
+    bool found = false;
+    for (size_t ii = 0; ii < 3 && !found; ++ii)
+    {
+        found = setlocale(LC_NUMERIC, locales[ii]) != NULL;
+    }
+    if (!found)
+    {
+        return;
+    }
+
+    TEST_ASSERT_EQ(six::formatNumber(2.5), "2.5");
+    TEST_ASSERT_EQ(six::formatScientific(2.5), "2.50000000000000000E00");
+    TEST_ASSERT_EQ(six::parseNumber<double>("2.5"), 2.5);
+    TEST_ASSERT_EQ(six::parseNumber<double>("-1.25E-01"), -0.125);
+    setlocale(LC_NUMERIC, "C");
+}
+
+TEST_CASE(testParameter)
+{
+    six::Parameter param;
+    param.setValue(0.1);
+    TEST_ASSERT_EQ(param.str(), str::toString(0.1));
+    TEST_ASSERT_EQ(static_cast<double>(param), 0.1);
+
+    const six::Parameter fromCtor(1.0 / 3.0);
+    TEST_ASSERT_EQ(static_cast<double>(fromCtor), 1.0 / 3.0);
+
+    param.setValue<size_t>(123);
+    TEST_ASSERT_EQ(static_cast<size_t>(param), 123);
+    TEST_ASSERT_EQ(param.str(), "123");
+}
+}
+
+int main(int, char**)
+{
+    TEST_CHECK(testFormatMatchesIostreams);
+    TEST_CHECK(testParseMatchesIostreams);
+    TEST_CHECK(testRoundTrip);
+    TEST_CHECK(testLocale);
+    TEST_CHECK(testParameter);
+    return 0;
+}
@@ -0,0 +1,158 @@
+/* =========================================================================
+ * This file is part of six-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <limits>
+
+#include <except/Exception.h>
+#include <six/Parameter.h>
+#include "TestCase.h"
+
+namespace
+{
+TEST_CASE(testNumbers)
+{
+    // Same text as str::toString()
+    const six::Parameter real(0.1);
+    TEST_ASSERT_EQ(real.str(), "0.10000000000000001");
+    TEST_ASSERT_EQ(static_cast<double>(real), 0.1);
+
+    const six::Parameter single(0.1f);
+    TEST_ASSERT_EQ(single.str(), "0.100000001");
+    TEST_ASSERT_EQ(static_cast<float>(single), 0.1f);
+
+    // Same as parsing its string
+    TEST_ASSERT_EQ(static_cast<double>(single), 0.100000001);
+
+    six::Parameter integer(-42);
+    TEST_ASSERT_EQ(integer.str(), "-42");
+    TEST_ASSERT_EQ(static_cast<int>(integer), -42);
+    TEST_ASSERT_EQ(static_cast<long long>(integer), -42);
+    TEST_ASSERT_EQ(static_cast<double>(integer), -42.0);
+    TEST_ASSERT_EQ(std::string(static_cast<const char*>(integer)), "-42");
+
+    const six::Parameter large(std::numeric_limits<unsigned long long>::max());
+    TEST_ASSERT_EQ(static_cast<unsigned long long>(large),
+                   std::numeric_limits<unsigned long long>::max());
+
+    // Values are replaced by later ones of a different type
+    integer.setValue(std::string("text"));
+    TEST_ASSERT_EQ(integer.str(), "text");
+    integer.setValue(7u);
+    TEST_ASSERT_EQ(static_cast<unsigned short>(integer), 7);
+}
+
+TEST_CASE(testConversionErrors)
+{
+    // Conversions that don't fit go through the string, just like
+    // str::toType()
+    const six::Parameter negative(-1);
+    TEST_ASSERT_EQ(static_cast<unsigned int>(negative),
+                   std::numeric_limits<unsigned int>::max());
+
+    const six::Parameter large(70000);
+    TEST_EXCEPTION(static_cast<short>(large));
+
+    const six::Parameter fraction(1.5);
+    TEST_ASSERT_EQ(static_cast<int>(fraction), 1);
+
+    six::Parameter text;
+    text.setValue<std::string>("12");
+    TEST_ASSERT_EQ(static_cast<int>(text), 12);
+    text.setValue<std::string>("twelve");
+    TEST_EXCEPTION(static_cast<int>(text));
+}
+
+TEST_CASE(testComplex)
+{
+    const std::complex<double> value(0.1, -2.5);
+    six::Parameter param(value);
+    TEST_ASSERT_EQ(param.getComplex<double>(), value);
+    TEST_ASSERT_EQ(param.str(), str::toString(value));
+
+    param.setValue(std::complex<int>(3, -4));
+    TEST_ASSERT_EQ(param.str(), "(3,-4)");
+    TEST_ASSERT_EQ(param.getComplex<int>(), std::complex<int>(3, -4));
+    TEST_ASSERT_EQ(param.getComplex<double>(), std::complex<double>(3, -4));
+
+    param.setValue<std::string>("(1,2)");
+    TEST_ASSERT_EQ(param.getComplex<float>(), std::complex<float>(1, 2));
+}
+
+TEST_CASE(testConstCharPointer)
+{
+    // A numeric value is only formatted once a string is asked for
+    const six::Parameter real(2.5);
+    TEST_ASSERT_EQ(std::string(static_cast<const char*>(real)), real.str());
+    const six::Parameter complex(std::complex<float>(1, -2));
+    TEST_ASSERT_EQ(std::string(static_cast<const char*>(complex)),
+                   complex.str());
+
+    six::Parameter param(std::string("text"));
+    TEST_ASSERT_EQ(std::string(static_cast<const char*>(param)), "text");
+    param.setValue(12u);
+    TEST_ASSERT_EQ(std::string(static_cast<const char*>(param)), "12");
+    param.setValue(-3);
+    TEST_ASSERT_EQ(std::string(static_cast<const char*>(param)), "-3");
+
+    // Copies format their own string, and setting a new value drops the
+    // old one
+    const six::Parameter copy(param);
+    TEST_ASSERT_EQ(std::string(static_cast<const char*>(copy)), "-3");
+    param.setValue(0.5);
+    TEST_ASSERT_EQ(std::string(static_cast<const char*>(param)), "0.5");
+    TEST_ASSERT_EQ(std::string(static_cast<const char*>(copy)), "-3");
+
+    six::Parameter assigned;
+    assigned = copy;
+    TEST_ASSERT_EQ(assigned.str(), "-3");
+    assigned = six::Parameter(std::string("text"));
+    TEST_ASSERT_EQ(std::string(static_cast<const char*>(assigned)), "text");
+}
+
+TEST_CASE(testEquality)
+{
+    six::Parameter lhs(5);
+    six::Parameter rhs(5u);
+    TEST_ASSERT(lhs == rhs);
+
+    rhs.setValue<std::string>("5");
+    TEST_ASSERT(lhs == rhs);
+
+    rhs.setValue(6);
+    TEST_ASSERT(lhs != rhs);
+
+    rhs.setValue(5);
+    rhs.setName("name");
+    TEST_ASSERT(lhs != rhs);
+
+    TEST_ASSERT(six::Parameter(0.0) != six::Parameter(-0.0));
+}
+}
+
+int main(int, char**)
+{
+    TEST_CHECK(testNumbers);
+    TEST_CHECK(testConversionErrors);
+    TEST_CHECK(testComplex);
+    TEST_CHECK(testConstCharPointer);
+    TEST_CHECK(testEquality);
+    return 0;
+}
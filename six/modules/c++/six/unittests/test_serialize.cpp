@@ -82,6 +82,23 @@ bool testVector(size_t length, bool byteSwap)
     return val == valCopy;
 }
 
+// Bulk serialization must give the same bytes as one value at a time
+template<typename T>
+bool testVectorFormat(size_t length, bool byteSwap)
+{
+    const std::vector<T> val = getRandomVector<T>(length);
+    std::vector<sys::byte> serializedData;
+    six::serialize<std::vector<T> >(val, byteSwap, serializedData);
+
+    std::vector<sys::byte> expectedData;
+    six::serialize<size_t>(val.size(), byteSwap, expectedData);
+    for (size_t ii = 0; ii < val.size(); ++ii)
+    {
+        six::serialize<T>(val[ii], byteSwap, expectedData);
+    }
+    return serializedData == expectedData;
+}
+
 bool testString(const std::string& str, bool byteSwap)
 {
     std::vector<sys::byte> serializedData;
@@ -139,10 +156,36 @@ TEST_CASE(VectorSerialize)
     TEST_ASSERT_TRUE(testVector<double>(length, true));
 }
 
+TEST_CASE(VectorSerializeFormat)
+{
+    const size_t length = 213;
+    TEST_ASSERT_TRUE(testVectorFormat<float>(length, false));
+    TEST_ASSERT_TRUE(testVectorFormat<double>(length, false));
+    TEST_ASSERT_TRUE(testVectorFormat<float>(length, true));
+    TEST_ASSERT_TRUE(testVectorFormat<double>(length, true));
+    TEST_ASSERT_TRUE(testVectorFormat<double>(0, true));
+}
+
+TEST_CASE(ArraySerialize)
+{
+    const std::vector<double> val = getRandomVector<double>(17);
+    std::vector<sys::byte> serializedData;
+    six::serializeArray(&val[0], val.size(), true, serializedData);
+    TEST_ASSERT_EQ(serializedData.size(), val.size() * sizeof(double));
+
+    std::vector<double> valCopy(val.size());
+    const sys::byte* buffer = &serializedData[0];
+    six::deserializeArray(buffer, true, valCopy.size(), &valCopy[0]);
+    TEST_ASSERT(buffer == &serializedData[0] + serializedData.size());
+    TEST_ASSERT(val == valCopy);
+}
+
 int main(int, char**)
 {
     srand(time(NULL));
     TEST_CHECK(ScalarSerialize);
     TEST_CHECK(VectorSerialize);
     TEST_CHECK(StringSerialize);
+    TEST_CHECK(VectorSerializeFormat);
+    TEST_CHECK(ArraySerialize);
 }
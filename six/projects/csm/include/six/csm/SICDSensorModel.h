@@ -72,6 +72,22 @@ public:
     static
     bool containsComplexDES(const csm::Nitf21Isd& isd);
 
+    /**
+     * Chooses what getModelState() returns.  By default it's the SICD XML,
+     * as earlier versions of the plugin returned.  The geometry state is a
+     * much smaller, versioned binary encoding of just the fields the model
+     * uses, and it's restored without parsing any XML.  It contains NUL
+     * characters, so it must not be handled as a C string.
+     *
+     * Setting the SIX_CSM_GEOMETRY_STATE environment variable to 1 makes
+     * the geometry state the default for models constructed afterwards.
+     * A model restored from a geometry state no longer holds the whole
+     * SICD, so it always returns a geometry state.
+     *
+     * \param useGeometryState Whether to return the geometry state
+     */
+    void setGeometryModelState(bool useGeometryState);
+
 public: // Model methods
     /*
      * Returns the version of the sensor model
@@ -143,6 +159,14 @@ public: // Model methods
      */
     virtual std::string getSensorMode() const;
 
+    /**
+     * Returns the sensor model name, followed by a space, then either the
+     * SICD XML or the geometry state (see setGeometryModelState())
+     *
+     * \return State of the sensor model
+     */
+    virtual std::string getModelState() const;
+
 public: // GeometricModel methods
 
 
@@ -181,8 +205,11 @@ private:
 
     void reinitialize();
 
+    void reinitialize(const scene::Errors& errors);
+
 private:
     std::auto_ptr<six::sicd::ComplexData> mData;
+    bool mUseGeometryState;
 };
 }
 }
@@ -64,7 +64,9 @@ public: // Model methods
     /**
      * Returns a string representing the state of the sensor model.  The state
      * string is made up of the sensor model name, followed by a space, then
-     * the SICD XML as a string.
+     * the model's data.  For SIDDs this is the SIDD XML.  For SICDs it's the
+     * SICD XML unless a binary geometry state was asked for (see
+     * SICDSensorModel::setGeometryModelState()).
      *
      * \return State of the sensor model
      */
@@ -593,6 +595,69 @@ public: // RasterGM methods
     double getCorrelationCoefficient(size_t cpGroupIndex,
                                      double deltaTime) const;
 
+public: // Batch methods (extensions to the CSM API)
+    // NOTE: The model's projection only reads its state, so these (and the
+    //       single point methods) may be called from any number of threads
+    //       at once.  Nothing may change the model (replaceModelState(),
+    //       setParameterValue(), etc.) while they run.
+
+    /**
+     * Converts many ground points to image coordinates.  Gives the same
+     * results as calling groundToImage() on each point, with the points
+     * split across threads.
+     *
+     * \param[in] groundPts Ground coordinates in meters
+     * \param[out] imagePts Image coordinates in pixels, one per ground point
+     * \param[in] numThreads Number of threads to use
+     *
+     * \throws csm::Error the error from the lowest indexed point that fails,
+     *     as the single point method throws it, however many threads are
+     *     used
+     */
+    void groundToImage(const std::vector<csm::EcefCoord>& groundPts,
+                       std::vector<csm::ImageCoord>& imagePts,
+                       size_t numThreads = 1) const;
+
+    /**
+     * Converts many image points to ground coordinates.  Gives the same
+     * results as calling imageToGround() on each point, with the points
+     * split across threads.
+     *
+     * \param[in] imagePts Image line and sample in pixels
+     * \param[in] heights Heights in meters measured with respect to the
+     *     WGS-84 ellipsoid.  Either one per image point or a single height
+     *     for all of them.
+     * \param[out] groundPts Ground coordinates in meters, one per image point
+     * \param[in] numThreads Number of threads to use
+     *
+     * \throws csm::Error the error from the lowest indexed point that fails,
+     *     as the single point method throws it, however many threads are
+     *     used
+     */
+    void imageToGround(const std::vector<csm::ImageCoord>& imagePts,
+                       const std::vector<double>& heights,
+                       std::vector<csm::EcefCoord>& groundPts,
+                       size_t numThreads = 1) const;
+
+    /**
+     * Computes the partials of line and sample with respect to all of the
+     * model parameters for many ground points.  Gives the same results as
+     * calling computeAllSensorPartials() on each point, with the points
+     * split across threads.
+     *
+     * \param[in] groundPts Ground coordinates in meters
+     * \param[out] partials Sensor partials, one set per ground point
+     * \param[in] numThreads Number of threads to use
+     *
+     * \throws csm::Error the error from the lowest indexed point that fails,
+     *     as the single point method throws it, however many threads are
+     *     used
+     */
+    void computeAllSensorPartials(
+            const std::vector<csm::EcefCoord>& groundPts,
+            std::vector<std::vector<SensorPartials> >& partials,
+            size_t numThreads = 1) const;
+
 public:
     // All remaining public methods throw csm::Error's that they're not
     // implemented
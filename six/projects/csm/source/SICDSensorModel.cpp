@@ -30,16 +30,440 @@
 #include <six/NITFReadControl.h>
 #include <six/sicd/ComplexXMLControl.h>
 #include <six/sicd/Utilities.h>
+#include <six/Serialize.h>
+#include <six/Utilities.h>
+#include <str/Convert.h>
+#include <sys/Conf.h>
+
+namespace
+{
+// The binary model state follows the model name and a space.  It starts with
+// this (which an XML state never does) and a version, and is big endian.
+const char GEOMETRY_STATE_MAGIC[] = "SIXGEOM";
+const size_t GEOMETRY_STATE_MAGIC_LENGTH = sizeof(GEOMETRY_STATE_MAGIC) - 1;
+const sys::Uint32_T GEOMETRY_STATE_VERSION = 1;
+const bool SWAP_BYTES = !sys::isBigEndianSystem();
+
+// Whether new models should return the geometry state
+bool useGeometryStateByDefault()
+{
+    std::string value;
+    sys::OS().getEnvIfSet("SIX_CSM_GEOMETRY_STATE", value);
+    return value == "1";
+}
+
+class StateWriter
+{
+public:
+    StateWriter(std::vector<sys::byte>& buffer) :
+        mBuffer(buffer)
+    {
+    }
+
+    template <typename T>
+    void write(const T& value)
+    {
+        six::serialize(value, SWAP_BYTES, mBuffer);
+    }
+
+    // Single bytes are copied as is (byte swapping them doesn't copy them)
+    void write(sys::ubyte value)
+    {
+        mBuffer.push_back(static_cast<sys::byte>(value));
+    }
+
+    void write(const std::string& value)
+    {
+        write(static_cast<sys::Uint64_T>(value.size()));
+        mBuffer.insert(mBuffer.end(), value.begin(), value.end());
+    }
+
+    void write(const scene::Vector3& value)
+    {
+        for (size_t ii = 0; ii < 3; ++ii)
+        {
+            write(value[ii]);
+        }
+    }
+
+    template <size_t ND>
+    void write(const math::linear::MatrixMxN<ND, ND>& value)
+    {
+        for (size_t ii = 0; ii < ND; ++ii)
+        {
+            for (size_t jj = 0; jj < ND; ++jj)
+            {
+                write(value(ii, jj));
+            }
+        }
+    }
+
+    template <typename T>
+    void write(const math::poly::OneD<T>& value)
+    {
+        write(static_cast<sys::Uint64_T>(value.size()));
+        for (size_t ii = 0; ii < value.size(); ++ii)
+        {
+            write(value[ii]);
+        }
+    }
+
+    void write(const six::Poly2D& value)
+    {
+        // An unset polynomial is written with no coefficients
+        const bool empty = value.empty();
+        write(static_cast<sys::Uint64_T>(empty ? 0 : value.orderX() + 1));
+        write(static_cast<sys::Uint64_T>(empty ? 0 : value.orderY() + 1));
+        if (!empty)
+        {
+            for (size_t ii = 0; ii <= value.orderX(); ++ii)
+            {
+                for (size_t jj = 0; jj <= value.orderY(); ++jj)
+                {
+                    write(value[ii][jj]);
+                }
+            }
+        }
+    }
+
+private:
+    std::vector<sys::byte>& mBuffer;
+};
+
+class StateReader
+{
+public:
+    StateReader(const std::string& state, size_t offset) :
+        mState(state),
+        mOffset(offset)
+    {
+    }
+
+    template <typename T>
+    void read(T& value)
+    {
+        require(sizeof(T));
+        const sys::byte* ptr =
+                reinterpret_cast<const sys::byte*>(&mState[mOffset]);
+        six::deserialize(ptr, SWAP_BYTES, value);
+        mOffset += sizeof(T);
+    }
+
+    void read(sys::ubyte& value)
+    {
+        require(1);
+        value = static_cast<sys::ubyte>(mState[mOffset]);
+        ++mOffset;
+    }
+
+    void read(std::string& value)
+    {
+        const size_t length = readLength(1);
+        value = mState.substr(mOffset, length);
+        mOffset += length;
+    }
+
+    void read(scene::Vector3& value)
+    {
+        for (size_t ii = 0; ii < 3; ++ii)
+        {
+            read(value[ii]);
+        }
+    }
+
+    template <size_t ND>
+    void read(math::linear::MatrixMxN<ND, ND>& value)
+    {
+        for (size_t ii = 0; ii < ND; ++ii)
+        {
+            for (size_t jj = 0; jj < ND; ++jj)
+            {
+                read(value(ii, jj));
+            }
+        }
+    }
+
+    template <typename T>
+    void read(math::poly::OneD<T>& value)
+    {
+        std::vector<T> coeffs(readLength(sizeof(T)));
+        for (size_t ii = 0; ii < coeffs.size(); ++ii)
+        {
+            read(coeffs[ii]);
+        }
+        value = coeffs.empty() ? math::poly::OneD<T>() :
+                math::poly::OneD<T>(coeffs);
+    }
+
+    void read(six::Poly2D& value)
+    {
+        const size_t numX = readLength(sizeof(double));
+        const size_t numY = readLength(sizeof(double));
+        if (numX == 0 || numY == 0)
+        {
+            value = six::Poly2D();
+            return;
+        }
+
+        require(numX * numY * sizeof(double));
+        value = six::Poly2D(numX - 1, numY - 1);
+        for (size_t ii = 0; ii < numX; ++ii)
+        {
+            for (size_t jj = 0; jj < numY; ++jj)
+            {
+                read(value[ii][jj]);
+            }
+        }
+    }
+
+    bool atEnd() const
+    {
+        return mOffset == mState.size();
+    }
+
+private:
+    // Reads a count of elements, each of which takes at least elementSize
+    // bytes, and makes sure there are enough bytes left for them
+    size_t readLength(size_t elementSize)
+    {
+        sys::Uint64_T length;
+        read(length);
+        if (elementSize != 0 &&
+            length > (mState.size() - mOffset) / elementSize)
+        {
+            throw except::Exception(Ctxt("Sensor model state is truncated"));
+        }
+        return static_cast<size_t>(length);
+    }
+
+    void require(size_t numBytes) const
+    {
+        if (numBytes > mState.size() - mOffset)
+        {
+            throw except::Exception(Ctxt("Sensor model state is truncated"));
+        }
+    }
+
+private:
+    const std::string& mState;
+    size_t mOffset;
+};
+
+// Writes everything that SICDSensorModel and its projection model use
+std::string toGeometryState(const six::sicd::ComplexData& data,
+                            const scene::Errors& errors)
+{
+    std::vector<sys::byte> buffer(
+            GEOMETRY_STATE_MAGIC,
+            GEOMETRY_STATE_MAGIC + GEOMETRY_STATE_MAGIC_LENGTH);
+    StateWriter writer(buffer);
+    writer.write(GEOMETRY_STATE_VERSION);
+
+    const six::CollectionInformation& collectionInfo(
+            *data.collectionInformation);
+    writer.write(collectionInfo.collectorName);
+    writer.write(collectionInfo.coreName);
+    writer.write(static_cast<sys::Int32_T>(collectionInfo.radarMode.value));
+
+    writer.write(data.timeline->collectStart.getTimeInMillis());
+    writer.write(data.timeline->collectDuration);
+
+    const six::sicd::ImageData& imageData(*data.imageData);
+    writer.write(static_cast<sys::Uint64_T>(imageData.numRows));
+    writer.write(static_cast<sys::Uint64_T>(imageData.numCols));
+    writer.write(static_cast<sys::Uint64_T>(imageData.firstRow));
+    writer.write(static_cast<sys::Uint64_T>(imageData.firstCol));
+    writer.write(static_cast<sys::Int64_T>(imageData.scpPixel.row));
+    writer.write(static_cast<sys::Int64_T>(imageData.scpPixel.col));
+
+    const six::sicd::Grid& grid(*data.grid);
+    writer.write(static_cast<sys::Int32_T>(grid.type.value));
+    writer.write(grid.row->unitVector);
+    writer.write(grid.col->unitVector);
+    writer.write(grid.row->sampleSpacing);
+    writer.write(grid.col->sampleSpacing);
+    writer.write(grid.timeCOAPoly);
+
+    writer.write(data.scpcoa->arpPos);
+    writer.write(data.scpcoa->arpVel);
+    writer.write(static_cast<sys::Int32_T>(data.scpcoa->sideOfTrack.value));
+
+    const six::SCP& scp(data.geoData->scp);
+    writer.write(scp.ecf);
+    writer.write(scp.llh.getLat());
+    writer.write(scp.llh.getLon());
+    writer.write(scp.llh.getAlt());
+
+    writer.write(data.position->arpPoly);
+
+    // Only the image formation block that the grid type needs
+    const bool hasPFA = (grid.type == six::ComplexImageGridType::RGAZIM &&
+                         data.pfa.get());
+    writer.write(static_cast<sys::ubyte>(hasPFA));
+    if (hasPFA)
+    {
+        writer.write(data.pfa->polarAnglePoly);
+        writer.write(data.pfa->spatialFrequencyScaleFactorPoly);
+    }
+
+    const bool hasINCA = (grid.type == six::ComplexImageGridType::RGZERO &&
+                          data.rma.get() && data.rma->inca.get());
+    writer.write(static_cast<sys::ubyte>(hasINCA));
+    if (hasINCA)
+    {
+        const six::sicd::INCA& inca(*data.rma->inca);
+        writer.write(inca.timeCAPoly);
+        writer.write(inca.dopplerRateScaleFactorPoly);
+        writer.write(inca.rangeCA);
+    }
+
+    writer.write(static_cast<sys::Int32_T>(errors.mFrameType.mValue));
+    writer.write(errors.mSensorErrorCovar);
+    writer.write(errors.mUnmodeledErrorCovar);
+    writer.write(errors.mIonoErrorCovar);
+    writer.write(errors.mTropoErrorCovar);
+    writer.write(errors.mPositionCorrCoefZero);
+    writer.write(errors.mPositionDecorrRate);
+    writer.write(errors.mRangeCorrCoefZero);
+    writer.write(errors.mRangeDecorrRate);
+
+    return std::string(buffer.begin(), buffer.end());
+}
+
+bool isGeometryState(const std::string& state, size_t offset)
+{
+    return state.compare(offset, GEOMETRY_STATE_MAGIC_LENGTH,
+                         GEOMETRY_STATE_MAGIC) == 0;
+}
+
+// Reads what toGeometryState() wrote into a ComplexData with only those
+// fields set
+std::auto_ptr<six::sicd::ComplexData>
+fromGeometryState(const std::string& state,
+                  size_t offset,
+                  scene::Errors& errors)
+{
+    StateReader reader(state, offset + GEOMETRY_STATE_MAGIC_LENGTH);
+
+    sys::Uint32_T version;
+    reader.read(version);
+    if (version != GEOMETRY_STATE_VERSION)
+    {
+        throw except::Exception(Ctxt(
+                "Unsupported sensor model state version " +
+                str::toString(version)));
+    }
+
+    std::auto_ptr<six::sicd::ComplexData> data(new six::sicd::ComplexData());
+    sys::Int32_T intValue;
+    sys::Uint64_T sizeValue;
+    sys::Int64_T ssizeValue;
+
+    six::CollectionInformation& collectionInfo(*data->collectionInformation);
+    reader.read(collectionInfo.collectorName);
+    reader.read(collectionInfo.coreName);
+    reader.read(intValue);
+    collectionInfo.radarMode = six::RadarModeType(intValue);
+
+    double collectStart;
+    reader.read(collectStart);
+    data->timeline->collectStart = six::DateTime(collectStart);
+    reader.read(data->timeline->collectDuration);
+
+    six::sicd::ImageData& imageData(*data->imageData);
+    reader.read(sizeValue);
+    imageData.numRows = static_cast<size_t>(sizeValue);
+    reader.read(sizeValue);
+    imageData.numCols = static_cast<size_t>(sizeValue);
+    reader.read(sizeValue);
+    imageData.firstRow = static_cast<size_t>(sizeValue);
+    reader.read(sizeValue);
+    imageData.firstCol = static_cast<size_t>(sizeValue);
+    reader.read(ssizeValue);
+    imageData.scpPixel.row = static_cast<sys::SSize_T>(ssizeValue);
+    reader.read(ssizeValue);
+    imageData.scpPixel.col = static_cast<sys::SSize_T>(ssizeValue);
+
+    six::sicd::Grid& grid(*data->grid);
+    reader.read(intValue);
+    grid.type = six::ComplexImageGridType(intValue);
+    reader.read(grid.row->unitVector);
+    reader.read(grid.col->unitVector);
+    reader.read(grid.row->sampleSpacing);
+    reader.read(grid.col->sampleSpacing);
+    reader.read(grid.timeCOAPoly);
+
+    reader.read(data->scpcoa->arpPos);
+    reader.read(data->scpcoa->arpVel);
+    reader.read(intValue);
+    data->scpcoa->sideOfTrack = six::SideOfTrackType(intValue);
+
+    six::SCP& scp(data->geoData->scp);
+    reader.read(scp.ecf);
+    double lat;
+    double lon;
+    double alt;
+    reader.read(lat);
+    reader.read(lon);
+    reader.read(alt);
+    scp.llh = six::LatLonAlt(lat, lon, alt);
+
+    reader.read(data->position->arpPoly);
+
+    sys::ubyte hasBlock;
+    reader.read(hasBlock);
+    if (hasBlock)
+    {
+        data->pfa.reset(new six::sicd::PFA());
+        reader.read(data->pfa->polarAnglePoly);
+        reader.read(data->pfa->spatialFrequencyScaleFactorPoly);
+    }
+
+    reader.read(hasBlock);
+    if (hasBlock)
+    {
+        data->rma.reset(new six::sicd::RMA());
+        data->rma->inca.reset(new six::sicd::INCA());
+        six::sicd::INCA& inca(*data->rma->inca);
+        reader.read(inca.timeCAPoly);
+        reader.read(inca.dopplerRateScaleFactorPoly);
+        reader.read(inca.rangeCA);
+    }
+
+    reader.read(intValue);
+    errors.mFrameType =
+            scene::FrameType(static_cast<scene::FrameType::FrameTypesEnum>(
+                    intValue));
+    reader.read(errors.mSensorErrorCovar);
+    reader.read(errors.mUnmodeledErrorCovar);
+    reader.read(errors.mIonoErrorCovar);
+    reader.read(errors.mTropoErrorCovar);
+    reader.read(errors.mPositionCorrCoefZero);
+    reader.read(errors.mPositionDecorrRate);
+    reader.read(errors.mRangeCorrCoefZero);
+    reader.read(errors.mRangeDecorrRate);
+
+    if (!reader.atEnd())
+    {
+        throw except::Exception(Ctxt(
+                "Unexpected data at the end of the sensor model state"));
+    }
+
+    return data;
+}
+}
+
 
 namespace six
 {
 namespace CSM
 {
-const csm::Version SICDSensorModel::VERSION(1, 1, 5);
+const csm::Version SICDSensorModel::VERSION(1, 1, 6);
 const char SICDSensorModel::NAME[] = "SICD_SENSOR_MODEL";
 
 SICDSensorModel::SICDSensorModel(const csm::Isd& isd,
-                                 const std::string& dataDir)
+                                 const std::string& dataDir) :
+    mUseGeometryState(useGeometryStateByDefault())
 {
     setSchemaDir(dataDir);
 
@@ -67,7 +491,8 @@ SICDSensorModel::SICDSensorModel(const csm::Isd& isd,
 }
 
 SICDSensorModel::SICDSensorModel(const std::string& sensorModelState,
-                                 const std::string& dataDir)
+                                 const std::string& dataDir) :
+    mUseGeometryState(useGeometryStateByDefault())
 {
     setSchemaDir(dataDir);
     replaceModelStateImpl(sensorModelState);
@@ -414,6 +839,29 @@ void SICDSensorModel::replaceModelStateImpl(const std::string& sensorModelState)
                            "SICDSensorModel::replaceModelStateImpl");
     }
 
+    // The binary geometry state is restored without any XML parsing
+    if (isGeometryState(sensorModelState, idx + 1))
+    {
+        try
+        {
+            scene::Errors errors;
+            mData = fromGeometryState(sensorModelState, idx + 1, errors);
+            reinitialize(errors);
+
+            // There's no XML to give back
+            mSensorModelState.clear();
+            mUseGeometryState = true;
+        }
+        catch (const except::Exception& ex)
+        {
+            throw csm::Error(csm::Error::INVALID_SENSOR_MODEL_STATE,
+                               ex.getMessage(),
+                               "SICDSensorModel::replaceModelStateImpl");
+        }
+        return;
+    }
+
+    // Otherwise it's the SICD XML, as older versions of the plugin wrote
     const std::string sensorModelXML = sensorModelState.substr(idx + 1);
 
     try
@@ -448,12 +896,23 @@ void SICDSensorModel::replaceModelStateImpl(const std::string& sensorModelState)
 }
 
 void SICDSensorModel::reinitialize()
+{
+    scene::Errors errors;
+    six::getErrors(mData->errorStatistics.get(),
+                   types::RgAz<double>(mData->grid->row->sampleSpacing,
+                                       mData->grid->col->sampleSpacing),
+                   errors);
+    reinitialize(errors);
+}
+
+void SICDSensorModel::reinitialize(const scene::Errors& errors)
 {
     mGeometry.reset(six::sicd::Utilities::getSceneGeometry(mData.get()));
 
     mProjection.reset(six::sicd::Utilities::getProjectionModel(
             mData.get(),
             mGeometry.get()));
+    mProjection->getErrors() = errors;
 
     std::fill_n(mAdjustableTypes,
                 static_cast<size_t>(scene::AdjustableParams::NUM_PARAMS),
@@ -463,5 +922,21 @@ void SICDSensorModel::reinitialize()
     mSensorCovariance = mProjection->getErrorCovariance(
             mGeometry->getReferencePosition());
 }
+
+void SICDSensorModel::setGeometryModelState(bool useGeometryState)
+{
+    // A model restored from a geometry state has no XML to fall back on
+    mUseGeometryState = useGeometryState || mSensorModelState.empty();
+}
+
+std::string SICDSensorModel::getModelState() const
+{
+    if (mUseGeometryState)
+    {
+        return NAME + std::string(" ") +
+                toGeometryState(*mData, mProjection->getErrors());
+    }
+    return mSensorModelState;
+}
 }
 }
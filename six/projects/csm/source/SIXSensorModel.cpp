@@ -24,6 +24,9 @@
 #include <limits>
 
 #include "Error.h"
+#include <sys/Mutex.h>
+#include <mt/CriticalSection.h>
+#include <mt/Runnable1D.h>
 #include <six/NITFReadControl.h>
 #include <six/csm/SIXSensorModel.h>
 
@@ -121,6 +124,165 @@ math::linear::Matrix2D<T> matrixSqrt(const math::linear::Matrix2D<T>& m)
     const math::linear::Matrix2D<T> eigenVec = eig.getV();
     return (eigenVec * diag * eigenVec.transpose());
 }
+
+// The precision CSM defaults to.  The projection ignores it anyway.
+const double DEFAULT_PRECISION = 0.001;
+
+// Keeps the csm::Error from the lowest indexed point that failed.  Errors
+// thrown on a worker thread would otherwise come out of mt::ThreadGroup as
+// an except::Exception, and this way a batch throws the same error however
+// its points are split across threads.
+class BatchError
+{
+public:
+    BatchError() :
+        mIndex(std::numeric_limits<size_t>::max())
+    {
+    }
+
+    void set(size_t index, const csm::Error& error)
+    {
+        mt::CriticalSection<sys::Mutex> lock(&mMutex);
+        if (index < mIndex)
+        {
+            mIndex = index;
+            mError = error;
+        }
+    }
+
+    void rethrow() const
+    {
+        if (mIndex != std::numeric_limits<size_t>::max())
+        {
+            throw mError;
+        }
+    }
+
+private:
+    sys::Mutex mMutex;
+    size_t mIndex;
+    csm::Error mError;
+};
+
+// Each of these handles one point of a batch.  They only read the model so
+// any number of threads can share one.
+class GroundToImageOp
+{
+public:
+    GroundToImageOp(const six::CSM::SIXSensorModel& model,
+                    const std::vector<csm::EcefCoord>& groundPts,
+                    std::vector<csm::ImageCoord>& imagePts,
+                    BatchError& error) :
+        mModel(model),
+        mGroundPts(groundPts),
+        mImagePts(imagePts),
+        mError(error)
+    {
+    }
+
+    void operator()(size_t index) const
+    {
+        try
+        {
+            mImagePts[index] = mModel.groundToImage(mGroundPts[index],
+                                                    DEFAULT_PRECISION,
+                                                    NULL,
+                                                    NULL);
+        }
+        catch (const csm::Error& ex)
+        {
+            mError.set(index, ex);
+        }
+    }
+
+private:
+    const six::CSM::SIXSensorModel& mModel;
+    const std::vector<csm::EcefCoord>& mGroundPts;
+    std::vector<csm::ImageCoord>& mImagePts;
+    BatchError& mError;
+};
+
+class ImageToGroundOp
+{
+public:
+    ImageToGroundOp(const six::CSM::SIXSensorModel& model,
+                    const std::vector<csm::ImageCoord>& imagePts,
+                    const std::vector<double>& heights,
+                    std::vector<csm::EcefCoord>& groundPts,
+                    BatchError& error) :
+        mModel(model),
+        mImagePts(imagePts),
+        mHeights(heights),
+        mGroundPts(groundPts),
+        mError(error)
+    {
+    }
+
+    void operator()(size_t index) const
+    {
+        const double height = (mHeights.size() == 1) ?
+                mHeights[0] : mHeights[index];
+        try
+        {
+            mGroundPts[index] = mModel.imageToGround(mImagePts[index],
+                                                     height,
+                                                     DEFAULT_PRECISION,
+                                                     NULL,
+                                                     NULL);
+        }
+        catch (const csm::Error& ex)
+        {
+            mError.set(index, ex);
+        }
+    }
+
+private:
+    const six::CSM::SIXSensorModel& mModel;
+    const std::vector<csm::ImageCoord>& mImagePts;
+    const std::vector<double>& mHeights;
+    std::vector<csm::EcefCoord>& mGroundPts;
+    BatchError& mError;
+};
+
+class SensorPartialsOp
+{
+public:
+    SensorPartialsOp(
+            const six::CSM::SIXSensorModel& model,
+            const std::vector<csm::EcefCoord>& groundPts,
+            std::vector<std::vector<csm::RasterGM::SensorPartials> >&
+                    partials,
+            BatchError& error) :
+        mModel(model),
+        mGroundPts(groundPts),
+        mPartials(partials),
+        mError(error)
+    {
+    }
+
+    void operator()(size_t index) const
+    {
+        try
+        {
+            mPartials[index] = mModel.computeAllSensorPartials(
+                    mGroundPts[index],
+                    csm::param::VALID,
+                    DEFAULT_PRECISION,
+                    NULL,
+                    NULL);
+        }
+        catch (const csm::Error& ex)
+        {
+            mError.set(index, ex);
+        }
+    }
+
+private:
+    const six::CSM::SIXSensorModel& mModel;
+    const std::vector<csm::EcefCoord>& mGroundPts;
+    std::vector<std::vector<csm::RasterGM::SensorPartials> >& mPartials;
+    BatchError& mError;
+};
 }
 
 namespace six
@@ -1111,6 +1273,77 @@ double SIXSensorModel::getCorrelationCoefficient(size_t cpGroupIndex,
     }
 }
 
+void SIXSensorModel::groundToImage(
+        const std::vector<csm::EcefCoord>& groundPts,
+        std::vector<csm::ImageCoord>& imagePts,
+        size_t numThreads) const
+{
+    imagePts.resize(groundPts.size());
+    BatchError error;
+    try
+    {
+        mt::run1D(groundPts.size(), numThreads,
+                  GroundToImageOp(*this, groundPts, imagePts, error));
+    }
+    catch (const except::Exception& ex)
+    {
+        throw csm::Error(csm::Error::UNKNOWN_ERROR,
+                           ex.getMessage(),
+                           "SIXSensorModel::groundToImage");
+    }
+    error.rethrow();
+}
+
+void SIXSensorModel::imageToGround(
+        const std::vector<csm::ImageCoord>& imagePts,
+        const std::vector<double>& heights,
+        std::vector<csm::EcefCoord>& groundPts,
+        size_t numThreads) const
+{
+    if (heights.size() != 1 && heights.size() != imagePts.size())
+    {
+        throw csm::Error(csm::Error::BOUNDS,
+                           "Need one height or one per image point",
+                           "SIXSensorModel::imageToGround");
+    }
+
+    groundPts.resize(imagePts.size());
+    BatchError error;
+    try
+    {
+        mt::run1D(imagePts.size(), numThreads,
+                  ImageToGroundOp(*this, imagePts, heights, groundPts, error));
+    }
+    catch (const except::Exception& ex)
+    {
+        throw csm::Error(csm::Error::UNKNOWN_ERROR,
+                           ex.getMessage(),
+                           "SIXSensorModel::imageToGround");
+    }
+    error.rethrow();
+}
+
+void SIXSensorModel::computeAllSensorPartials(
+        const std::vector<csm::EcefCoord>& groundPts,
+        std::vector<std::vector<SensorPartials> >& partials,
+        size_t numThreads) const
+{
+    partials.resize(groundPts.size());
+    BatchError error;
+    try
+    {
+        mt::run1D(groundPts.size(), numThreads,
+                  SensorPartialsOp(*this, groundPts, partials, error));
+    }
+    catch (const except::Exception& ex)
+    {
+        throw csm::Error(csm::Error::UNKNOWN_ERROR,
+                           ex.getMessage(),
+                           "SIXSensorModel::computeAllSensorPartials");
+    }
+    error.rethrow();
+}
+
 DataType SIXSensorModel::getDataType(const csm::Des& des)
 {
     // This should be the length of everything up to the user-defined section
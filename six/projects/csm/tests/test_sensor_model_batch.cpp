@@ -0,0 +1,299 @@
+/* =========================================================================
+ * This file is part of six-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+#include <sys/OS.h>
+#include <sys/Path.h>
+#include <except/Exception.h>
+#include <six/csm/SICDSensorModel.h>
+
+namespace
+{
+// The batch methods run the same single-point code, so the results should
+// match exactly
+bool equals(const csm::ImageCoord& lhs, const csm::ImageCoord& rhs)
+{
+    return lhs.line == rhs.line && lhs.samp == rhs.samp;
+}
+
+bool equals(const csm::EcefCoord& lhs, const csm::EcefCoord& rhs)
+{
+    return lhs.x == rhs.x && lhs.y == rhs.y && lhs.z == rhs.z;
+}
+
+bool equals(const std::vector<csm::RasterGM::SensorPartials>& lhs,
+            const std::vector<csm::RasterGM::SensorPartials>& rhs)
+{
+    if (lhs.size() != rhs.size())
+    {
+        return false;
+    }
+    for (size_t ii = 0; ii < lhs.size(); ++ii)
+    {
+        if (lhs[ii].first != rhs[ii].first ||
+            lhs[ii].second != rhs[ii].second)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool equals(const csm::Error& lhs, const csm::Error& rhs)
+{
+    return lhs.getError() == rhs.getError() &&
+            lhs.getMessage() == rhs.getMessage() &&
+            lhs.getFunction() == rhs.getFunction();
+}
+
+class Test
+{
+public:
+    Test(const six::CSM::SIXSensorModel& model) :
+        mModel(model),
+        mSinglePoint(model)
+    {
+        // A grid of points across the image
+        const csm::ImageVector size = mModel.getImageSize();
+        for (size_t row = 0; row < 5; ++row)
+        {
+            for (size_t col = 0; col < 4; ++col)
+            {
+                mImagePts.push_back(csm::ImageCoord(
+                        size.line * (row + 0.5) / 5,
+                        size.samp * (col + 0.5) / 4));
+            }
+        }
+
+        mHeights.resize(mImagePts.size());
+        for (size_t ii = 0; ii < mHeights.size(); ++ii)
+        {
+            mHeights[ii] = 10.0 * ii;
+        }
+
+        for (size_t ii = 0; ii < mImagePts.size(); ++ii)
+        {
+            mGroundPts.push_back(mSinglePoint.imageToGround(mImagePts[ii],
+                                                            mHeights[ii]));
+        }
+    }
+
+    bool testMatchesSinglePoint(size_t numThreads)
+    {
+        bool testPassed = true;
+
+        std::vector<csm::EcefCoord> groundPts;
+        mModel.imageToGround(mImagePts, mHeights, groundPts, numThreads);
+        for (size_t ii = 0; ii < mImagePts.size(); ++ii)
+        {
+            if (!equals(groundPts[ii], mGroundPts[ii]))
+            {
+                std::cerr << "Batch imageToGround() differs at point " << ii
+                          << " with " << numThreads << " threads\n";
+                testPassed = false;
+            }
+        }
+
+        // A single height applies to every point
+        mModel.imageToGround(mImagePts, std::vector<double>(1, mHeights[3]),
+                             groundPts, numThreads);
+        for (size_t ii = 0; ii < mImagePts.size(); ++ii)
+        {
+            if (!equals(groundPts[ii],
+                        mSinglePoint.imageToGround(mImagePts[ii], mHeights[3])))
+            {
+                std::cerr << "Batch imageToGround() with one height differs "
+                          << "at point " << ii << " with " << numThreads
+                          << " threads\n";
+                testPassed = false;
+            }
+        }
+
+        std::vector<csm::ImageCoord> imagePts;
+        mModel.groundToImage(mGroundPts, imagePts, numThreads);
+        for (size_t ii = 0; ii < mGroundPts.size(); ++ii)
+        {
+            if (!equals(imagePts[ii], mSinglePoint.groundToImage(mGroundPts[ii])))
+            {
+                std::cerr << "Batch groundToImage() differs at point " << ii
+                          << " with " << numThreads << " threads\n";
+                testPassed = false;
+            }
+        }
+
+        std::vector<std::vector<csm::RasterGM::SensorPartials> > partials;
+        mModel.computeAllSensorPartials(mGroundPts, partials, numThreads);
+        for (size_t ii = 0; ii < mGroundPts.size(); ++ii)
+        {
+            if (!equals(partials[ii],
+                        mSinglePoint.computeAllSensorPartials(mGroundPts[ii])))
+            {
+                std::cerr << "Batch computeAllSensorPartials() differs at "
+                          << "point " << ii << " with " << numThreads
+                          << " threads\n";
+                testPassed = false;
+            }
+        }
+
+        return testPassed;
+    }
+
+    bool testFailingPoint(size_t numThreads)
+    {
+        // A point that can't be projected, partway through the batch
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        const csm::EcefCoord badGroundPt(nan, nan, nan);
+        std::vector<csm::EcefCoord> groundPts(mGroundPts);
+        groundPts[7] = badGroundPt;
+
+        csm::Error expected;
+        try
+        {
+            mSinglePoint.groundToImage(badGroundPt);
+            std::cerr << "Single point groundToImage() didn't fail\n";
+            return false;
+        }
+        catch (const csm::Error& ex)
+        {
+            expected = ex;
+        }
+
+        bool testPassed = true;
+        try
+        {
+            std::vector<csm::ImageCoord> imagePts;
+            mModel.groundToImage(groundPts, imagePts, numThreads);
+            std::cerr << "Batch groundToImage() didn't fail with "
+                      << numThreads << " threads\n";
+            testPassed = false;
+        }
+        catch (const csm::Error& ex)
+        {
+            if (!equals(ex, expected))
+            {
+                std::cerr << "Batch groundToImage() threw '"
+                          << ex.getMessage() << "' from '"
+                          << ex.getFunction() << "' rather than '"
+                          << expected.getMessage() << "' from '"
+                          << expected.getFunction() << "' with "
+                          << numThreads << " threads\n";
+                testPassed = false;
+            }
+        }
+
+        try
+        {
+            std::vector<std::vector<csm::RasterGM::SensorPartials> >
+                    partials;
+            mModel.computeAllSensorPartials(groundPts, partials, numThreads);
+            std::cerr << "Batch computeAllSensorPartials() didn't fail with "
+                      << numThreads << " threads\n";
+            testPassed = false;
+        }
+        catch (const csm::Error& ex)
+        {
+            try
+            {
+                mSinglePoint.computeAllSensorPartials(badGroundPt);
+            }
+            catch (const csm::Error& singleEx)
+            {
+                if (!equals(ex, singleEx))
+                {
+                    std::cerr << "Batch computeAllSensorPartials() threw a "
+                              << "different error with " << numThreads
+                              << " threads\n";
+                    testPassed = false;
+                }
+            }
+        }
+
+        return testPassed;
+    }
+
+private:
+    const six::CSM::SIXSensorModel& mModel;
+
+    // The batch overloads hide the single-point ones' default arguments
+    const csm::RasterGM& mSinglePoint;
+
+    std::vector<csm::ImageCoord> mImagePts;
+    std::vector<double> mHeights;
+    std::vector<csm::EcefCoord> mGroundPts;
+};
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        // Parse the command line
+        if (argc != 2)
+        {
+            std::cerr << "Usage: " << sys::Path::basename(argv[0])
+                      << " <SICD pathname>\n\n";
+            return 1;
+        }
+        sys::OS os;
+
+        // Go up two levels from current dir
+        const std::string installPathname =
+                sys::Path::splitPath(sys::Path::splitPath(
+                        os.getCurrentExecutable()).first).first;
+        const std::string confDir =
+                sys::Path::joinPaths(installPathname, "conf");
+        if (!os.exists(confDir))
+        {
+            throw except::Exception(Ctxt("Unable to find conf dir."));
+        }
+
+        const six::CSM::SICDSensorModel model(csm::Isd(argv[1]), confDir);
+
+        Test test(model);
+        const size_t numThreads = 4;
+        const bool testPassed = test.testMatchesSinglePoint(1) &&
+                test.testMatchesSinglePoint(numThreads) &&
+                test.testFailingPoint(1) &&
+                test.testFailingPoint(numThreads);
+        return testPassed ? 0 : 1;
+    }
+    catch (const csm::Error& ex)
+    {
+        std::cerr << ex.getMessage() << std::endl;
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+    }
+    catch (const except::Exception& ex)
+    {
+        std::cerr << ex.toString() << std::endl;
+    }
+    catch (...)
+    {
+        std::cerr << "Unknown exception\n";
+    }
+
+    return 1;
+}
@@ -19,11 +19,13 @@
  * see <http://www.gnu.org/licenses/>.
  *
  */
+#include <cmath>
 #include <iostream>
 #include <sstream>
 
 #include <sys/DLL.h>
 #include <sys/Conf.h>
+#include <sys/OS.h>
 #include <except/Exception.h>
 #include <six/Utilities.h>
 #include <six/sicd/ComplexXMLControl.h>
@@ -70,7 +72,94 @@ public:
                 mComplexData.get(), mXmlRegistry));
     }
 
+    bool testModelState()
+    {
+        const csm::Isd isd(mSicdPathname);
+        std::auto_ptr<csm::RasterGM> model(reinterpret_cast<csm::RasterGM*>(
+                mPlugin.constructModelFromISD(isd, MODEL_NAME)));
+
+        // By default the state is the SICD XML, which is a C string
+        bool testPassed = true;
+        const std::string xmlState = model->getModelState();
+        if (xmlState.find('\0') != std::string::npos ||
+            xmlState.find("<SICD") == std::string::npos)
+        {
+            std::cerr << "Default state isn't the SICD XML\n";
+            testPassed = false;
+        }
+        testPassed = testStateMatches(*model, xmlState) && testPassed;
+
+        // The binary geometry state is opt-in
+        sys::OS os;
+        os.setEnv("SIX_CSM_GEOMETRY_STATE", "1", true);
+        std::auto_ptr<csm::RasterGM> geometryModel(
+                reinterpret_cast<csm::RasterGM*>(
+                        mPlugin.constructModelFromISD(isd, MODEL_NAME)));
+        os.unsetEnv("SIX_CSM_GEOMETRY_STATE");
+        const std::string geometryState = geometryModel->getModelState();
+        if (geometryState == xmlState)
+        {
+            std::cerr << "Geometry state wasn't used\n";
+            testPassed = false;
+        }
+        testPassed = testStateMatches(*model, geometryState) && testPassed;
+        return testPassed;
+    }
+
 private:
+    bool testStateMatches(const csm::RasterGM& model,
+                          const std::string& state)
+    {
+        if (!mPlugin.canModelBeConstructedFromState(MODEL_NAME, state))
+        {
+            std::cerr << "Can't construct model from state\n";
+            return false;
+        }
+
+        // A restored model gives back the state it was restored from
+        std::auto_ptr<csm::RasterGM> restored(reinterpret_cast<csm::RasterGM*>(
+                mPlugin.constructModelFromState(state)));
+
+        if (restored->getModelState() != state ||
+            restored->getImageIdentifier() != model.getImageIdentifier() ||
+            restored->getSensorMode() != model.getSensorMode() ||
+            restored->getImageSize().line != model.getImageSize().line ||
+            restored->getImageSize().samp != model.getImageSize().samp)
+        {
+            std::cerr << "Restored model differs\n";
+            return false;
+        }
+
+        const six::SCP& scp = mComplexData->geoData->scp;
+        const csm::EcefCoord groundPt(scp.ecf[0], scp.ecf[1], scp.ecf[2]);
+        const csm::ImageCoord imagePt = model.groundToImage(groundPt);
+        const csm::ImageCoord restoredImagePt =
+                restored->groundToImage(groundPt);
+        const csm::EcefCoord restoredGroundPt =
+                restored->imageToGround(imagePt, scp.llh.getAlt());
+
+        const double tolerance = 1e-6;
+        if (std::abs(imagePt.line - restoredImagePt.line) > tolerance ||
+            std::abs(imagePt.samp - restoredImagePt.samp) > tolerance ||
+            std::abs(groundPt.x - restoredGroundPt.x) > 1e-3 ||
+            std::abs(groundPt.y - restoredGroundPt.y) > 1e-3 ||
+            std::abs(groundPt.z - restoredGroundPt.z) > 1e-3)
+        {
+            std::cerr << "Restored model projects differently\n";
+            return false;
+        }
+
+        if (restored->getNumParameters() != model.getNumParameters() ||
+            (model.getNumParameters() > 0 &&
+             restored->getParameterCovariance(0, 0) !=
+                     model.getParameterCovariance(0, 0)))
+        {
+            std::cerr << "Restored model has different covariance\n";
+            return false;
+        }
+        return true;
+    }
+
     scene::Vector3 imageToGround(const csm::RasterGM& model,
             const six::RowColInt& scpPixel, double height, double offset)
     {
@@ -246,7 +335,8 @@ int main(int argc, char** argv)
         }
 
         Test test(sicdPathname, confDir, plugin);
-        const bool testPassed = test.testFileISD() && test.testNitfISD();
+        const bool testPassed = test.testFileISD() && test.testNitfISD() &&
+                test.testModelState();
         return testPassed ? 0 : 1;
     }
 